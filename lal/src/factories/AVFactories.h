@@ -84,6 +84,15 @@ extern "C" {
  * The <tt>XLALCreate\<type\>%Vector</tt> functions create vectors of the specified
  * \c length number of objects of type <tt>\<type\></tt>.  The function
  * \c XLALCreateVector() is the same as \c XLALCreateREAL4Vector().
+ * The data of \c REAL4, \c REAL8, \c COMPLEX8 and \c COMPLEX16 vectors
+ * is only guaranteed to be suitably aligned for the SIMD routines of FFTW
+ * if LAL is configured with <tt>--enable-fftw3-memalign</tt>, in which case
+ * it is aligned to #LAL_MEM_ALIGNMENT bytes, also after
+ * <tt>XLALResize\<type\>%Vector</tt>.  Otherwise the data has only the
+ * alignment of the system <tt>malloc()</tt> (16 bytes on x86-64), which
+ * may be less than FFTW requires.  The FFT routines in \ref RealFFT_h check
+ * the alignment of each vector at run time, and transform vectors which
+ * are not suitably aligned through temporary arrays.
  *
  * The <tt>XLALDestroy\<type\>%Vector</tt> functions deallocate the memory allocation
  * pointed to by \c vector including its contents.  The function
@@ -507,6 +516,30 @@ void LALZResizeVector ( LALStatus *, COMPLEX16Vector **, UINT4 );
 void LALZDestroyVector ( LALStatus *, COMPLEX16Vector ** );
 /*@}*/
 
+/**
+ * \name Vector prototypes for memory arenas
+ *
+ * These functions create vectors from the memory arena which is active on
+ * the calling thread (see XLALPushMallocArena()), and fail if there is none.
+ * The vectors must not be destroyed or resized; they are released when the
+ * arena is popped.
+ */
+/*@{*/
+#ifndef SWIG   /* exclude from SWIG interface */
+CHARVector * XLALArenaCreateCHARVector ( UINT4 length );
+INT2Vector * XLALArenaCreateINT2Vector ( UINT4 length );
+UINT2Vector * XLALArenaCreateUINT2Vector ( UINT4 length );
+INT4Vector * XLALArenaCreateINT4Vector ( UINT4 length );
+UINT4Vector * XLALArenaCreateUINT4Vector ( UINT4 length );
+INT8Vector * XLALArenaCreateINT8Vector ( UINT4 length );
+UINT8Vector * XLALArenaCreateUINT8Vector ( UINT4 length );
+REAL4Vector * XLALArenaCreateREAL4Vector ( UINT4 length );
+REAL8Vector * XLALArenaCreateREAL8Vector ( UINT4 length );
+COMPLEX8Vector * XLALArenaCreateCOMPLEX8Vector ( UINT4 length );
+COMPLEX16Vector * XLALArenaCreateCOMPLEX16Vector ( UINT4 length );
+#endif   /* SWIG */
+/*@}*/
+
 /*@}*/
 
 /* ---------- end: VectorFactories_c ---------- */
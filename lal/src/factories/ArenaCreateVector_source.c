@@ -0,0 +1,32 @@
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define CONCAT3x(a,b,c) a##b##c
+#define CONCAT3(a,b,c) CONCAT3x(a,b,c)
+#define STRING(a) #a
+
+#define VTYPE CONCAT2(TYPE,Vector)
+
+#define XFUNC CONCAT2(XLALArenaCreate,VTYPE)
+
+VTYPE * XFUNC ( UINT4 length )
+{
+  VTYPE * vector;
+  if ( XLALGetMallocArenaDepth() == 0 )
+    XLAL_ERROR_NULL( XLAL_EFAILED, "No memory arena is active on this thread" );
+  vector = XLALArenaMalloc( sizeof( *vector ) );
+  if ( ! vector )
+    XLAL_ERROR_NULL( XLAL_ENOMEM );
+  vector->length = length;
+  if ( ! length ) /* zero length: set data pointer to be NULL */
+    vector->data = NULL;
+  else /* non-zero length: allocate memory for data from the arena */
+  {
+    vector->data = XLALArenaMalloc( length * sizeof( *vector->data ) );
+    if ( ! vector->data )
+      XLAL_ERROR_NULL( XLAL_ENOMEM ); /* vector is released with the arena */
+  }
+  return vector;
+}
+
+#undef VTYPE
+#undef XFUNC
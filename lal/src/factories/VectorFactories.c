@@ -15,6 +15,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef USE_ALIGNED_MEMORY_ROUTINES
 #undef TYPECODE
 #undef TYPE
@@ -27,6 +28,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef USE_ALIGNED_MEMORY_ROUTINES
 #undef TYPECODE
 #undef TYPE
@@ -39,6 +41,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef USE_ALIGNED_MEMORY_ROUTINES
 #undef TYPECODE
 #undef TYPE
@@ -51,6 +54,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef USE_ALIGNED_MEMORY_ROUTINES
 #undef TYPECODE
 #undef TYPE
@@ -60,6 +64,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef TYPECODE
 #undef TYPE
 
@@ -68,6 +73,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef TYPECODE
 #undef TYPE
 
@@ -76,6 +82,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef TYPECODE
 #undef TYPE
 
@@ -84,6 +91,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef TYPECODE
 #undef TYPE
 
@@ -92,6 +100,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef TYPECODE
 #undef TYPE
 
@@ -100,6 +109,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef TYPECODE
 #undef TYPE
 
@@ -108,6 +118,7 @@ File Name: VectorFactories.c
 #include "CreateVector_source.c"
 #include "DestroyVector_source.c"
 #include "ResizeVector_source.c"
+#include "ArenaCreateVector_source.c"
 #undef TYPECODE
 #undef TYPE
 
@@ -1899,6 +1899,331 @@ int XLALPSDRegressorSetPSD(LALPSDRegressor *r, const REAL8FrequencySeries *psd,
 }
 
 
+/*
+ * Running median PSD
+ */
+
+
+/*
+ * the samples of each frequency bin in the window are kept in two binary
+ * heaps:  a max-heap holding the lower half of the samples, and a min-heap
+ * holding the upper half.  the heaps store indexes into the history
+ * buffer, and position[] records where in which heap each history slot
+ * lives (>= 0 for the lower heap, < 0 for the upper heap), so that the
+ * oldest sample can be replaced in place and restored to the correct
+ * place in O(log N) operations.  because every bin receives its samples
+ * at the same time, the sizes of the heaps are the same for all bins:
+ * the lower heap holds ceil(n / 2) samples and the upper floor(n / 2).
+ */
+
+struct tagLALPSDRunningMedian {
+  unsigned median_samples;
+  unsigned n_samples;
+  unsigned oldest;
+  REAL8FrequencySeries *psd;
+  LIGOTimeGPS *epoch;
+  REAL8 *value;
+  unsigned *lower;
+  unsigned *upper;
+  int *position;
+};
+
+/* exchange two entries of a heap, keeping the position array in sync */
+static void running_median_swap(unsigned *heap, int *position, int upper, unsigned i, unsigned j)
+{
+  unsigned tmp = heap[i];
+  heap[i] = heap[j];
+  heap[j] = tmp;
+  position[heap[i]] = upper ? -1 - (int) i : (int) i;
+  position[heap[j]] = upper ? -1 - (int) j : (int) j;
+}
+
+/* return non-zero if history slot a belongs above slot b in the heap */
+static int running_median_before(const REAL8 *value, int upper, unsigned a, unsigned b)
+{
+  return upper ? value[a] < value[b] : value[a] > value[b];
+}
+
+/* restore the heap property after the entry at i has changed */
+static void running_median_sift(const REAL8 *value, unsigned *heap, int *position, int upper, unsigned size, unsigned i)
+{
+  /* sift up */
+  while(i > 0 && running_median_before(value, upper, heap[i], heap[(i - 1) / 2]))
+  {
+    running_median_swap(heap, position, upper, i, (i - 1) / 2);
+    i = (i - 1) / 2;
+  }
+
+  /* sift down */
+  while(1)
+  {
+    unsigned child = 2 * i + 1;
+    if(child >= size)
+      break;
+    if(child + 1 < size && running_median_before(value, upper, heap[child + 1], heap[child]))
+      child++;
+    if(!running_median_before(value, upper, heap[child], heap[i]))
+      break;
+    running_median_swap(heap, position, upper, i, child);
+    i = child;
+  }
+}
+
+/* if the largest of the lower samples exceeds the smallest of the upper
+ * samples, exchange them */
+static void running_median_exchange_roots(const REAL8 *value, unsigned *lower, unsigned n_lower, unsigned *upper, unsigned n_upper, int *position)
+{
+  unsigned tmp;
+  if(!n_upper || value[lower[0]] <= value[upper[0]])
+    return;
+  tmp = lower[0];
+  lower[0] = upper[0];
+  upper[0] = tmp;
+  position[lower[0]] = 0;
+  position[upper[0]] = -1;
+  running_median_sift(value, lower, position, 0, n_lower, 0);
+  running_median_sift(value, upper, position, 1, n_upper, 0);
+}
+
+/**
+ * Allocate and initialize a LALPSDRunningMedian object.
+ *
+ * The LALPSDRunningMedian object computes the same estimate of the power
+ * spectral density as XLALREAL8AverageSpectrumMedian() --- the bin-by-bin
+ * median of a set of modified periodograms, corrected by XLALMedianBias()
+ * --- but over a sliding window of the most recent median_samples
+ * periodograms.  Each frequency bin keeps its samples in a pair of heaps
+ * ordered about the median, so that adding a new periodogram and retiring
+ * the oldest one costs O(log median_samples) operations per bin instead of
+ * a sort of every bin's history.  This makes it suitable for tracking the
+ * PSD of a data stream one stride at a time.
+ */
+LALPSDRunningMedian *XLALPSDRunningMedianNew(unsigned median_samples)
+{
+  LALPSDRunningMedian *new;
+
+  /* require the number of periodograms in the window to be positive */
+  if(median_samples < 1)
+    XLAL_ERROR_NULL(XLAL_EINVAL);
+
+  new = XLALCalloc(1, sizeof(*new));
+  if(!new)
+    XLAL_ERROR_NULL(XLAL_ENOMEM);
+  new->median_samples = median_samples;
+
+  return new;
+}
+
+/**
+ * Reset a LALPSDRunningMedian object to the newly-allocated state.  This
+ * discards the periodogram history and the frequency series parameters.
+ */
+void XLALPSDRunningMedianReset(LALPSDRunningMedian *r)
+{
+  XLALDestroyREAL8FrequencySeries(r->psd);
+  XLALFree(r->epoch);
+  XLALFree(r->value);
+  XLALFree(r->lower);
+  XLALFree(r->upper);
+  XLALFree(r->position);
+  r->psd = NULL;
+  r->epoch = NULL;
+  r->value = NULL;
+  r->lower = NULL;
+  r->upper = NULL;
+  r->position = NULL;
+  r->n_samples = 0;
+  r->oldest = 0;
+}
+
+/**
+ * Free all memory associated with a LALPSDRunningMedian object.  The
+ * object must not be used again after calling this function.
+ */
+void XLALPSDRunningMedianFree(LALPSDRunningMedian *r)
+{
+  if(r)
+    XLALPSDRunningMedianReset(r);
+  XLALFree(r);
+}
+
+/**
+ * Return the number of periodograms in a full LALPSDRunningMedian window.
+ */
+unsigned XLALPSDRunningMedianGetMedianSamples(const LALPSDRunningMedian *r)
+{
+  return r->median_samples;
+}
+
+/**
+ * Return the number of periodograms currently in the window of a
+ * LALPSDRunningMedian object.  This counts the number of periodograms
+ * that have been added until it reaches median_samples, and then it stops
+ * increasing.
+ */
+unsigned XLALPSDRunningMedianGetNSamples(const LALPSDRunningMedian *r)
+{
+  return r->n_samples;
+}
+
+/**
+ * Add a periodogram to a LALPSDRunningMedian object.  If the window
+ * already holds median_samples periodograms, the oldest one is retired.
+ * The periodogram would typically have been computed with
+ * XLALREAL8ModifiedPeriodogram().  Its data are copied;  the calling code
+ * retains ownership of it.
+ *
+ * The first periodogram added sets the frequency resolution, number of
+ * bins and units of the PSD.  Once those have been set, the only mechanism
+ * by which they can be changed is to call XLALPSDRunningMedianReset().
+ */
+int XLALPSDRunningMedianAdd(LALPSDRunningMedian *r, const REAL8FrequencySeries *periodogram)
+{
+  const unsigned n = r->median_samples;
+  /* while a sample is being added the lower heap can briefly hold one
+   * more than ceil(n / 2) samples */
+  const unsigned n_lower_max = n / 2 + 1;
+  const unsigned n_upper_max = n / 2;
+  unsigned n_lower, n_upper;
+  unsigned slot;
+  unsigned i;
+
+  if(!periodogram || !periodogram->data)
+    XLAL_ERROR(XLAL_EFAULT);
+
+  /* is this the first periodogram? */
+
+  if(!r->n_samples)
+  {
+    const size_t length = periodogram->data->length;
+    XLALPSDRunningMedianReset(r);
+    r->psd = XLALCutREAL8FrequencySeries(periodogram, 0, length);
+    r->epoch = XLALCalloc(n, sizeof(*r->epoch));
+    r->value = XLALMalloc(length * n * sizeof(*r->value));
+    r->lower = XLALMalloc(length * n_lower_max * sizeof(*r->lower));
+    r->upper = XLALMalloc((length * n_upper_max + 1) * sizeof(*r->upper));
+    r->position = XLALMalloc(length * n * sizeof(*r->position));
+    if(!r->psd || !r->epoch || !r->value || !r->lower || !r->upper || !r->position)
+    {
+      XLALPSDRunningMedianReset(r);
+      XLAL_ERROR(XLAL_ENOMEM);
+    }
+  }
+  else if((periodogram->f0 != r->psd->f0) || (periodogram->deltaF != r->psd->deltaF) || (periodogram->data->length != r->psd->data->length) || XLALUnitCompare(&periodogram->sampleUnits, &r->psd->sampleUnits))
+  {
+    XLALPrintError("%s(): input parameter mismatch", __func__);
+    XLAL_ERROR(XLAL_EDATA);
+  }
+
+  /* the slot in the history buffer for the new periodogram */
+
+  slot = r->n_samples < n ? r->n_samples : r->oldest;
+  r->epoch[slot] = periodogram->epoch;
+
+  /* update each frequency bin */
+
+  n_lower = (r->n_samples + 1) / 2;
+  n_upper = r->n_samples / 2;
+  for(i = 0; i < periodogram->data->length; i++)
+  {
+    REAL8 *value = r->value + (size_t) i * n;
+    unsigned *lower = r->lower + (size_t) i * n_lower_max;
+    unsigned *upper = r->upper + (size_t) i * n_upper_max;
+    int *position = r->position + (size_t) i * n;
+
+    value[slot] = periodogram->data->data[i];
+
+    if(r->n_samples < n)
+    {
+      /* add the new sample to the lower heap, swap it into the upper
+       * heap if it belongs there, and then rebalance the heaps so that the
+       * lower one holds ceil(n / 2) samples */
+      lower[n_lower] = slot;
+      position[slot] = n_lower;
+      running_median_sift(value, lower, position, 0, n_lower + 1, n_lower);
+      running_median_exchange_roots(value, lower, n_lower + 1, upper, n_upper, position);
+      if(n_lower > n_upper)
+      {
+        upper[n_upper] = lower[0];
+        position[upper[n_upper]] = -1 - (int) n_upper;
+        running_median_sift(value, upper, position, 1, n_upper + 1, n_upper);
+        lower[0] = lower[n_lower];
+        position[lower[0]] = 0;
+        running_median_sift(value, lower, position, 0, n_lower, 0);
+      }
+    }
+    else
+    {
+      /* replace the oldest sample in whichever heap it lives */
+      if(position[slot] >= 0)
+        running_median_sift(value, lower, position, 0, n_lower, position[slot]);
+      else
+        running_median_sift(value, upper, position, 1, n_upper, -1 - position[slot]);
+      running_median_exchange_roots(value, lower, n_lower, upper, n_upper, position);
+    }
+  }
+
+  /* advance the history */
+
+  if(r->n_samples < n)
+    r->n_samples++;
+  else
+    r->oldest = (r->oldest + 1) % n;
+
+  return 0;
+}
+
+/**
+ * Retrieve the current PSD estimate from a LALPSDRunningMedian object.
+ * The PSD is the bin-by-bin median of the periodograms in the window,
+ * divided by XLALMedianBias() for the number of periodograms;  if the
+ * window holds an even number of them, the mean of the two middle values
+ * is used.  The epoch of the PSD is that of the oldest periodogram in the
+ * window.  The return value is a newly-allocated frequency series object.
+ * The calling code is responsible for freeing it when it no longer needs
+ * it.
+ */
+REAL8FrequencySeries *XLALPSDRunningMedianGetPSD(const LALPSDRunningMedian *r)
+{
+  const unsigned n = r->median_samples;
+  const unsigned n_lower_max = n / 2 + 1;
+  const unsigned n_upper_max = n / 2;
+  REAL8FrequencySeries *psd;
+  REAL8 normfac;
+  unsigned i;
+
+  /* initialized yet? */
+
+  if(!r->n_samples) {
+    XLALPrintError("%s: not initialized", __func__);
+    XLAL_ERROR_NULL(XLAL_EDATA);
+  }
+
+  psd = XLALCutREAL8FrequencySeries(r->psd, 0, r->psd->data->length);
+  if(!psd)
+    XLAL_ERROR_NULL(XLAL_EFUNC);
+  psd->epoch = r->epoch[r->n_samples < n ? 0 : r->oldest];
+
+  /* normalization takes into account bias */
+
+  normfac = 1.0 / XLALMedianBias(r->n_samples);
+
+  for(i = 0; i < psd->data->length; i++)
+  {
+    const REAL8 *value = r->value + (size_t) i * n;
+    const unsigned *lower = r->lower + (size_t) i * n_lower_max;
+    const unsigned *upper = r->upper + (size_t) i * n_upper_max;
+    if(r->n_samples % 2)
+      psd->data->data[i] = value[lower[0]];
+    else
+      psd->data->data[i] = 0.5 * (value[lower[0]] + value[upper[0]]);
+    psd->data->data[i] *= normfac;
+  }
+
+  return psd;
+}
+
+
 /**
  * Compute the two-point spectral correlation function for a whitened
  * frequency series from the window applied to the original time series.
@@ -124,6 +124,8 @@ tagCOMPLEX8FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the complex data vector for this plan */
   fftwf_plan plan; /**< the FFTW plan */
+  fftwf_plan manyplan; /**< the native FFTW plan for sequences of vectors, if any */
+  UINT4      howmany; /**< number of vectors in sequences transformed by manyplan */
 };
 
 /**
@@ -135,6 +137,8 @@ tagCOMPLEX16FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the complex data vector for this plan */
   fftw_plan  plan; /**< the FFTW plan */
+  fftw_plan  manyplan; /**< the native FFTW plan for sequences of vectors, if any */
+  UINT4      howmany; /**< number of vectors in sequences transformed by manyplan */
 };
 
 /* single- and double-precision routines */
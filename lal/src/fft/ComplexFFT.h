@@ -41,8 +41,8 @@ extern "C" {
  * #include <lal/ComplexFFT.h>
  * \endcode
  *
- * Perform complex-to-complex fast Fourier transforms of vectors using the
- * package FFTW \cite fj_1998 .
+ * Perform complex-to-complex fast Fourier transforms of vectors, and
+ * sequences of vectors, using the package FFTW \cite fj_1998 .
  *
  */
 /*@{*/
@@ -223,6 +223,65 @@ void XLALDestroyCOMPLEX8FFTPlan( COMPLEX8FFTPlan *plan );
  */
 int XLALCOMPLEX8VectorFFT( COMPLEX8Vector * _LAL_RESTRICT_ output, const COMPLEX8Vector * _LAL_RESTRICT_ input, const COMPLEX8FFTPlan *plan );
 
+/**
+ * Returns a new COMPLEX8FFTPlan which can also transform sequences of vectors
+ *
+ * The returned plan can be used with XLALCOMPLEX8VectorFFT().  In addition,
+ * when it is used with XLALCOMPLEX8VectorSequenceFFT() on sequences of
+ * exactly \c howmany vectors, all of the vectors are transformed by a
+ * single call to FFTW.
+ *
+ * @param[in] size The number of points in each complex data vector.
+ * @param[in] howmany The number of vectors to transform at once.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation:
+ * - 0: no measurement, just estimate the plan;
+ * - 1: measure the best plan;
+ * - 2: perform a lengthy measurement of the best plan;
+ * - 3: perform an exhasutive measurement of the best plan.
+ * @param[in] nthreads The number of threads FFTW may use to execute the
+ * sequence transform; this is ignored (i.e. treated as 1) if LAL was not
+ * built against the FFTW threads libraries.
+ * @return A pointer to an allocated \c COMPLEX8FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateCOMPLEX8FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan or \c howmany is 0.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+COMPLEX8FFTPlan * XLALCreateCOMPLEX8FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads );
+
+/**
+ * Perform FFTs of each vector in a COMPLEX8VectorSequence
+ *
+ * This routine is equivalent to calling XLALCOMPLEX8VectorFFT() on each
+ * vector of the input sequence in turn, storing the results in the
+ * corresponding vectors of the output sequence.  If the plan was created
+ * by XLALCreateCOMPLEX8FFTPlanMany() for the number of vectors in the
+ * sequences, the whole sequence is transformed in a single FFTW call.
+ *
+ * @param[out] output The complex output data sequence of vectors of length N
+ * @param[in] input The input complex data sequence of vectors of length N
+ * @param[in] plan The FFT plan to use for the transform
+ * @note
+ * The input and output sequences must be distinct.
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALCOMPLEX8VectorSequenceFFT() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the input and output data
+ * sequences are the same.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan size
+ * are incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALCOMPLEX8VectorSequenceFFT( COMPLEX8VectorSequence * _LAL_RESTRICT_ output, const COMPLEX8VectorSequence * _LAL_RESTRICT_ input, const COMPLEX8FFTPlan *plan );
+
 /*
  *
  * XLAL COMPLEX16 functions
@@ -359,6 +418,65 @@ void XLALDestroyCOMPLEX16FFTPlan( COMPLEX16FFTPlan *plan );
  */
 int XLALCOMPLEX16VectorFFT( COMPLEX16Vector * _LAL_RESTRICT_ output, const COMPLEX16Vector * _LAL_RESTRICT_ input, const COMPLEX16FFTPlan *plan );
 
+/**
+ * Returns a new COMPLEX16FFTPlan which can also transform sequences of vectors
+ *
+ * The returned plan can be used with XLALCOMPLEX16VectorFFT().  In addition,
+ * when it is used with XLALCOMPLEX16VectorSequenceFFT() on sequences of
+ * exactly \c howmany vectors, all of the vectors are transformed by a
+ * single call to FFTW.
+ *
+ * @param[in] size The number of points in each complex data vector.
+ * @param[in] howmany The number of vectors to transform at once.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation:
+ * - 0: no measurement, just estimate the plan;
+ * - 1: measure the best plan;
+ * - 2: perform a lengthy measurement of the best plan;
+ * - 3: perform an exhasutive measurement of the best plan.
+ * @param[in] nthreads The number of threads FFTW may use to execute the
+ * sequence transform; this is ignored (i.e. treated as 1) if LAL was not
+ * built against the FFTW threads libraries.
+ * @return A pointer to an allocated \c COMPLEX16FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateCOMPLEX16FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan or \c howmany is 0.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+COMPLEX16FFTPlan * XLALCreateCOMPLEX16FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads );
+
+/**
+ * Perform FFTs of each vector in a COMPLEX16VectorSequence
+ *
+ * This routine is equivalent to calling XLALCOMPLEX16VectorFFT() on each
+ * vector of the input sequence in turn, storing the results in the
+ * corresponding vectors of the output sequence.  If the plan was created
+ * by XLALCreateCOMPLEX16FFTPlanMany() for the number of vectors in the
+ * sequences, the whole sequence is transformed in a single FFTW call.
+ *
+ * @param[out] output The complex output data sequence of vectors of length N
+ * @param[in] input The input complex data sequence of vectors of length N
+ * @param[in] plan The FFT plan to use for the transform
+ * @note
+ * The input and output sequences must be distinct.
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALCOMPLEX16VectorSequenceFFT() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the input and output data
+ * sequences are the same.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan size
+ * are incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALCOMPLEX16VectorSequenceFFT( COMPLEX16VectorSequence * _LAL_RESTRICT_ output, const COMPLEX16VectorSequence * _LAL_RESTRICT_ input, const COMPLEX16FFTPlan *plan );
+
 /*
  *
  * LAL COMPLEX8 functions
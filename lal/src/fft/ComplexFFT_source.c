@@ -14,18 +14,33 @@
 
 #define PLAN_TYPE			CONCAT2(COMPLEX_TYPE,FFTPlan)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define COMPLEX_SEQUENCE_TYPE		CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
 #define CREATE_REVERSE_PLAN_FUNCTION	CONCAT2(XLALCreateReverse,PLAN_TYPE)
+#define CREATE_PLAN_MANY_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
 #define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,COMPLEX_VECTOR_TYPE,FFT)
+#define SEQUENCE_FFT_FUNCTION		CONCAT3(XLAL,COMPLEX_SEQUENCE_TYPE,FFT)
 
 #define FFTWX				CONCAT2(fftw,TYPESUFFIX)
 #define FFTWX_COMPLEX			CONCAT2(FFTWX,_complex)
 #define FFTWX_PLAN_DFT_1D		CONCAT2(FFTWX,_plan_dft_1d)
 #define FFTWX_DESTROY_PLAN		CONCAT2(FFTWX,_destroy_plan)
 #define FFTWX_EXECUTE_DFT		CONCAT2(FFTWX,_execute_dft)
+#define FFTWX_PLAN_MANY_DFT		CONCAT2(FFTWX,_plan_many_dft)
+#define FFTWX_MALLOC			CONCAT2(FFTWX,_malloc)
+#define FFTWX_FREE			CONCAT2(FFTWX,_free)
+#define FFTWX_ALIGNMENT_OF		CONCAT2(FFTWX,_alignment_of)
+
+/*
+ * Plans for sequences of vectors are created on arrays from fftw_malloc()
+ * and without FFTW_UNALIGNED, so that FFTW is free to choose its SIMD
+ * codelets.  They can then only be executed on arrays with the same
+ * alignment as the planning arrays.
+ */
+#define NATIVE_ALIGNED(ptr)		(FFTWX_ALIGNMENT_OF((void *)(ptr)) == 0)
 
 PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
 {
@@ -68,6 +83,8 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     plan = XLALMalloc(sizeof(*plan));
     if (!plan)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
+    plan->manyplan = NULL;
+    plan->howmany = 0;
 
 #   ifdef LAL_FFTW3_MEMALIGN_ENABLED
     tmp1 = XLALMallocAligned(nbytes);
@@ -137,14 +154,93 @@ PLAN_TYPE *CREATE_REVERSE_PLAN_FUNCTION(UINT4 size, int measurelvl)
     return plan;
 }
 
+PLAN_TYPE *CREATE_PLAN_MANY_FUNCTION(UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads)
+{
+    PLAN_TYPE *plan;
+    FFTWX_COMPLEX *tmp1;
+    FFTWX_COMPLEX *tmp2;
+    size_t nbytes;
+    int n = size;
+    int flags;
+
+    if (!size || !howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+
+    nbytes = (size_t) howmany * size * sizeof(COMPLEX_TYPE);
+
+    /* create the plan for single vectors */
+
+    plan = CREATE_PLAN_FUNCTION(size, fwdflg, measurelvl);
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+
+    /* set fftw3 flags to perform requested degree of measurement; the
+     * native plans require aligned arrays */
+
+    flags = 0;
+
+    switch (measurelvl) {
+    case 0:    /* estimate */
+        flags |= FFTW_ESTIMATE;
+        break;
+    default:   /* exhaustive measurement */
+        flags |= FFTW_EXHAUSTIVE;
+        /* fall-through */
+    case 2:    /* lengthy measurement */
+        flags |= FFTW_PATIENT;
+        /* fall-through */
+    case 1:    /* measure the best plan */
+        flags |= FFTW_MEASURE;
+        break;
+    }
+
+    /* allocate memory for the temporary arrays */
+
+    tmp1 = FFTWX_MALLOC(nbytes);
+    tmp2 = FFTWX_MALLOC(nbytes);
+    if (!tmp1 || !tmp2) {
+        FFTWX_FREE(tmp1);
+        FFTWX_FREE(tmp2);
+        DESTROY_PLAN_FUNCTION(plan);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* establish fftw mutex lock and create plan for sequences of vectors;
+     * consecutive vectors are contiguous in memory */
+
+    LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWPlanWithNThreads(nthreads);
+    plan->manyplan = FFTWX_PLAN_MANY_DFT(1, &n, howmany, tmp1, NULL, 1, size, tmp2, NULL, 1, size,
+        fwdflg ? FFTW_FORWARD : FFTW_BACKWARD, flags);
+    XLALFFTWPlanWithNThreads(1);
+    LAL_FFTW_WISDOM_UNLOCK;
+
+    /* free the temporary arrays */
+
+    FFTWX_FREE(tmp1);
+    FFTWX_FREE(tmp2);
+
+    /* check to see success of plan creation */
+
+    if (!plan->manyplan) {
+        DESTROY_PLAN_FUNCTION(plan);
+        XLAL_ERROR_NULL(XLAL_EFAILED);
+    }
+
+    plan->howmany = howmany;
+
+    return plan;
+}
+
 void DESTROY_PLAN_FUNCTION(PLAN_TYPE * plan)
 {
     if (plan) {
-        if (plan->plan) {
-            LAL_FFTW_WISDOM_LOCK;
+        LAL_FFTW_WISDOM_LOCK;
+        if (plan->plan)
             FFTWX_DESTROY_PLAN(plan->plan);
-            LAL_FFTW_WISDOM_UNLOCK;
-        }
+        if (plan->manyplan)
+            FFTWX_DESTROY_PLAN(plan->manyplan);
+        LAL_FFTW_WISDOM_UNLOCK;
         memset(plan, 0, sizeof(*plan));
         XLALFree(plan);
     }
@@ -209,6 +305,46 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
     return 0;
 }
 
+int SEQUENCE_FFT_FUNCTION(COMPLEX_SEQUENCE_TYPE * _LAL_RESTRICT_ output, const COMPLEX_SEQUENCE_TYPE * _LAL_RESTRICT_ input,
+    const PLAN_TYPE * plan)
+{
+    COMPLEX_VECTOR_TYPE invec;
+    COMPLEX_VECTOR_TYPE outvec;
+    UINT4 i;
+
+    /* sanity check on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data || output->data == input->data)
+        XLAL_ERROR(XLAL_EINVAL);        /* note: must be out-of-place */
+    if (output->vectorLength != plan->size || input->vectorLength != plan->size)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (output->length != input->length)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    /* transform the whole sequence at once if possible */
+
+    if (plan->manyplan && input->length == plan->howmany && NATIVE_ALIGNED(input->data) && NATIVE_ALIGNED(output->data)) {
+        FFTWX_EXECUTE_DFT(plan->manyplan, (FFTWX_COMPLEX *)input->data, (FFTWX_COMPLEX *)output->data);
+        return 0;
+    }
+
+    /* otherwise transform the vectors one at a time */
+
+    invec.length = outvec.length = plan->size;
+    for (i = 0; i < input->length; ++i) {
+        invec.data = input->data + i * plan->size;
+        outvec.data = output->data + i * plan->size;
+        if (VECTOR_FFT_FUNCTION(&outvec, &invec, plan) != 0)
+            XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    return 0;
+}
+
 /*
  * Legacy Routines
  */
@@ -355,15 +491,23 @@ void OLD_VECTOR_FFT_FUNCTION(LALStatus * status, COMPLEX_VECTOR_TYPE * output, C
 
 #undef PLAN_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef COMPLEX_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
+#undef CREATE_PLAN_MANY_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
 #undef CREATE_REVERSE_PLAN_FUNCTION
 #undef DESTROY_PLAN_FUNCTION
 #undef VECTOR_FFT_FUNCTION
+#undef SEQUENCE_FFT_FUNCTION
 
 #undef FFTWX
 #undef FFTWX_COMPLEX
 #undef FFTWX_PLAN_DFT_1D
 #undef FFTWX_DESTROY_PLAN
 #undef FFTWX_EXECUTE_DFT
+#undef FFTWX_PLAN_MANY_DFT
+#undef FFTWX_MALLOC
+#undef FFTWX_FREE
+#undef FFTWX_ALIGNMENT_OF
+#undef NATIVE_ALIGNED
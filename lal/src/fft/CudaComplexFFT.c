@@ -638,3 +638,18 @@ LALCOMPLEX16VectorFFT (
   }
   RETURN( status );
 }
+
+
+/*
+ *
+ * Transforms of sequences of vectors
+ *
+ */
+
+#define COMPLEX_TYPE COMPLEX8
+#include "SequenceFFT_source.c"
+#undef COMPLEX_TYPE
+
+#define COMPLEX_TYPE COMPLEX16
+#include "SequenceFFT_source.c"
+#undef COMPLEX_TYPE
@@ -1373,3 +1373,22 @@ LALREAL8VectorFFT(
   }
   RETURN( status );
 }
+
+
+/*
+ *
+ * Transforms of sequences of vectors
+ *
+ */
+
+#define REAL_TYPE REAL4
+#define COMPLEX_TYPE COMPLEX8
+#include "SequenceFFT_source.c"
+#undef REAL_TYPE
+#undef COMPLEX_TYPE
+
+#define REAL_TYPE REAL8
+#define COMPLEX_TYPE COMPLEX16
+#include "SequenceFFT_source.c"
+#undef REAL_TYPE
+#undef COMPLEX_TYPE
@@ -17,6 +17,28 @@
 *  MA  02111-1307  USA
 */
 
+#include <config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#ifdef HAVE_FCNTL_H
+#include <fcntl.h>
+#endif
+
+#include <lal/LALStdlib.h>
+#include <lal/LALStdio.h>
+#include <lal/LALString.h>
+#include <lal/LALSIMD.h>
+#include <lal/LALHashFunc.h>
 #include <lal/FFTWMutex.h>
 
 #if defined(LAL_PTHREAD_LOCK) && defined(LAL_FFTW3_ENABLED)
@@ -24,11 +46,30 @@
 static pthread_mutex_t lalFFTWMutex = PTHREAD_MUTEX_INITIALIZER;
 #endif
 
+#if defined(LAL_FFTW3_ENABLED)
+#include <fftw3.h>
+static int lalFFTWWisdomInit = 0;		/* wisdom store has been initialised */
+static char *lalFFTWWisdomFile = NULL;		/* file of the wisdom store, if any */
+static char lalFFTWWisdomKey[64];		/* key identifying CPU and FFTW version */
+static int FFTWWisdomSetPath(const char *path);
+static int FFTWWisdomImport(void);
+static int FFTWWisdomExport(void);
+#endif
+
+#if defined(LAL_FFTW3_ENABLED) && defined(HAVE_LIBFFTW3_THREADS) && defined(HAVE_LIBFFTW3F_THREADS)
+#define LAL_FFTW3_THREADS
+#include <fftw3.h>
+static int lalFFTWThreadsInit = 0;
+#endif
+
 
 /**
  * Aquire LAL's FFTW wisdom lock.  This lock must be held when creating or
- * destroying FFTW plans.  This function is a no-op if LAL has been
- * compiled without pthread support or with an FFT backend other than FFTW.
+ * destroying FFTW plans.  The first time the lock is aquired, FFTW wisdom
+ * is loaded from the persistent wisdom store named by the \c LAL_FFTW_WISDOM
+ * environment variable, if it is set; see XLALFFTWWisdomSetPath().  This
+ * function is a no-op if LAL has been compiled with an FFT backend other
+ * than FFTW; the lock itself is a no-op without pthread support.
  *
  * See also:  XLALFFTWWisdomUnlock()
  */
@@ -38,6 +79,18 @@ void XLALFFTWWisdomLock(void)
 #if defined(LAL_PTHREAD_LOCK) && defined(LAL_FFTW3_ENABLED)
     pthread_mutex_lock( &lalFFTWMutex );
 #endif
+#if defined(LAL_FFTW3_ENABLED)
+    if ( ! lalFFTWWisdomInit ) {
+        const char *env = getenv( "LAL_FFTW_WISDOM" );
+        lalFFTWWisdomInit = 1;
+        if ( env != NULL && *env != '\0' ) {
+            int errnum;
+            XLAL_TRY( FFTWWisdomSetPath( env ), errnum );
+            if ( errnum != 0 )
+                XLAL_PRINT_WARNING( "Could not use FFTW wisdom store LAL_FFTW_WISDOM='%s'", env );
+        }
+    }
+#endif
 }
 
 
@@ -55,3 +108,364 @@ void XLALFFTWWisdomUnlock(void)
     pthread_mutex_unlock( &lalFFTWMutex );
 #endif
 }
+
+
+/**
+ * Set the number of threads that FFTW may use to execute plans created
+ * subsequently, in both single and double precision.  The FFTW threads
+ * library is initialised the first time this function is called with
+ * \c nthreads greater than one.  LAL's FFTW wisdom lock must be held
+ * when calling this function; after creating the plans it should be
+ * called again with \c nthreads equal to one.  This function is a no-op
+ * if LAL has not been compiled against the FFTW threads libraries.
+ */
+
+void XLALFFTWPlanWithNThreads(int nthreads)
+{
+#if defined(LAL_FFTW3_THREADS)
+    if ( nthreads < 1 )
+        nthreads = 1;
+    if ( ! lalFFTWThreadsInit ) {
+        if ( nthreads == 1 )
+            return;
+        if ( ! fftwf_init_threads() || ! fftw_init_threads() )
+            return;
+        lalFFTWThreadsInit = 1;
+    }
+    fftwf_plan_with_nthreads( nthreads );
+    fftw_plan_with_nthreads( nthreads );
+#else
+    (void) nthreads;
+#endif
+}
+
+
+/**
+ * Set the file or directory of LAL's persistent FFTW wisdom store, and
+ * load any wisdom it contains.  The same can be achieved by setting the
+ * \c LAL_FFTW_WISDOM environment variable before the first FFT plan is
+ * created.
+ *
+ * If \c path is an existing directory, the wisdom is stored in a file in
+ * that directory whose name contains a hash of the CPU model, the SIMD
+ * instruction set, and the FFTW library version, so that a single
+ * directory can be shared by machines of different types.  Otherwise
+ * \c path is the name of the wisdom file itself; the same key is then
+ * stored in the file, and wisdom from a different machine type is ignored.
+ *
+ * Wisdom accumulated by the process (in both single and double precision)
+ * is merged back into the store when the process exits normally, or when
+ * XLALFFTWWisdomExport() is called.  Concurrent processes may share the
+ * same store: updates are serialised with an advisory file lock, merged
+ * with the current contents of the store, and written atomically by
+ * renaming a temporary file.
+ *
+ * This function fails with #XLAL_EFAILED if LAL has been compiled with
+ * an FFT backend other than FFTW.
+ */
+
+int XLALFFTWWisdomSetPath(const char *path)
+{
+#if defined(LAL_FFTW3_ENABLED)
+    int retn;
+    XLAL_CHECK( path != NULL && *path != '\0', XLAL_EINVAL );
+    XLALFFTWWisdomLock();
+    retn = FFTWWisdomSetPath( path );
+    XLALFFTWWisdomUnlock();
+    XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+#else
+    (void) path;
+    XLAL_ERROR( XLAL_EFAILED, "LAL was not compiled with FFTW" );
+#endif
+}
+
+
+/**
+ * Merge the FFTW wisdom accumulated by the process into LAL's persistent
+ * wisdom store.  This is done automatically when the process exits
+ * normally.  This function is a no-op if no wisdom store has been set.
+ */
+
+int XLALFFTWWisdomExport(void)
+{
+#if defined(LAL_FFTW3_ENABLED)
+    int retn;
+    XLALFFTWWisdomLock();
+    retn = FFTWWisdomExport();
+    XLALFFTWWisdomUnlock();
+    XLAL_CHECK( retn == XLAL_SUCCESS, XLAL_EFUNC );
+#endif
+    return XLAL_SUCCESS;
+}
+
+
+#if defined(LAL_FFTW3_ENABLED)
+
+/*
+ * The functions below must be called with the wisdom lock held.  The
+ * wisdom file contains a header line with the key, followed by the double-
+ * and single-precision wisdom as exported by FFTW.
+ */
+
+#define WISDOM_HEADER "# LAL FFTW wisdom "
+
+/* exit handler which merges the process wisdom into the store; the lock is
+ * not waited for, since exit() may have been called by another thread, or by
+ * this thread, while it was held, in which case the wisdom is not saved */
+static void FFTWWisdomAtExit(void)
+{
+    int errnum;
+#if defined(LAL_PTHREAD_LOCK)
+    if ( pthread_mutex_trylock( &lalFFTWMutex ) != 0 ) {
+        XLAL_PRINT_WARNING( "FFTW wisdom lock held at exit; not saving FFTW wisdom to '%s'", lalFFTWWisdomFile );
+        return;
+    }
+#endif
+    XLAL_TRY( FFTWWisdomExport(), errnum );
+#if defined(LAL_PTHREAD_LOCK)
+    pthread_mutex_unlock( &lalFFTWMutex );
+#endif
+    if ( errnum != 0 )
+        XLAL_PRINT_WARNING( "Could not save FFTW wisdom to '%s'", lalFFTWWisdomFile );
+}
+
+/* compute key identifying the CPU model, SIMD instruction set, and FFTW version */
+static void FFTWWisdomComputeKey(void)
+{
+    char model[256] = "unknown";
+    char *str = NULL;
+    FILE *fp;
+    int i;
+
+    /* CPU model name, where available */
+    if ( ( fp = fopen( "/proc/cpuinfo", "r" ) ) != NULL ) {
+        char line[256];
+        while ( fgets( line, sizeof( line ), fp ) != NULL ) {
+            if ( strncmp( line, "model name", 10 ) == 0 ) {
+                char *colon = strchr( line, ':' );
+                if ( colon != NULL ) {
+                    XLALStringCopy( model, colon + 1, sizeof( model ) );
+                    model[strcspn( model, "\n" )] = '\0';
+                }
+                break;
+            }
+        }
+        fclose( fp );
+    }
+    str = XLALStringAppendFmt( str, "%s;%s;%s;", model, fftw_version, fftwf_version );
+
+    /* best available SIMD instruction set */
+    for ( i = 0; i < LAL_SIMD_ISET_MAX && XLALHaveSIMDInstructionSet( i ); ++i )
+        ;
+    if ( i > 0 )
+        str = XLALStringAppend( str, XLALSIMDInstructionSetName( i - 1 ) );
+
+    snprintf( lalFFTWWisdomKey, sizeof( lalFFTWWisdomKey ), "%016" LAL_INT8_PRIx,
+              str ? XLALCityHash64( str, strlen( str ) ) : 0 );
+    XLALFree( str );
+}
+
+static int FFTWWisdomSetPath(const char *path)
+{
+    struct stat st;
+    char *file = NULL;
+
+    if ( lalFFTWWisdomKey[0] == '\0' )
+        FFTWWisdomComputeKey();
+
+    /* determine the wisdom file name */
+    if ( stat( path, &st ) == 0 && S_ISDIR( st.st_mode ) )
+        file = XLALStringAppendFmt( NULL, "%s/lal-fftw-wisdom-%s.dat", path, lalFFTWWisdomKey );
+    else
+        file = XLALStringDuplicate( path );
+    XLAL_CHECK( file != NULL, XLAL_EFUNC );
+
+    /* the file name must outlive any memory leak checks, so do not use LALMalloc() */
+    free( lalFFTWWisdomFile );
+    lalFFTWWisdomFile = strdup( file );
+    XLALFree( file );
+    XLAL_CHECK( lalFFTWWisdomFile != NULL, XLAL_ENOMEM );
+
+    /* register exit handler the first time a store is set */
+    {
+        static int registered = 0;
+        if ( ! registered ) {
+            XLAL_CHECK( atexit( FFTWWisdomAtExit ) == 0, XLAL_ESYS );
+            registered = 1;
+        }
+    }
+
+    XLAL_CHECK( FFTWWisdomImport() == XLAL_SUCCESS, XLAL_EFUNC );
+    return XLAL_SUCCESS;
+}
+
+/* read the wisdom file; returns 1 if it was read, 0 if it does not exist
+ * or belongs to a different machine type, and -1 on error */
+static int FFTWWisdomRead(char **contents)
+{
+    FILE *fp;
+    long len;
+    size_t hlen = strlen( WISDOM_HEADER );
+
+    *contents = NULL;
+    if ( ( fp = fopen( lalFFTWWisdomFile, "r" ) ) == NULL )
+        return errno == ENOENT ? 0 : -1;
+    if ( fseek( fp, 0, SEEK_END ) != 0 || ( len = ftell( fp ) ) < 0 || fseek( fp, 0, SEEK_SET ) != 0 ) {
+        fclose( fp );
+        return -1;
+    }
+    if ( ( *contents = malloc( len + 1 ) ) == NULL ) {
+        fclose( fp );
+        return -1;
+    }
+    if ( fread( *contents, 1, len, fp ) != (size_t) len ) {
+        fclose( fp );
+        free( *contents );
+        *contents = NULL;
+        return -1;
+    }
+    fclose( fp );
+    (*contents)[len] = '\0';
+    if ( strncmp( *contents, WISDOM_HEADER, hlen ) != 0 || strncmp( *contents + hlen, lalFFTWWisdomKey, strlen( lalFFTWWisdomKey ) ) != 0 ) {
+        free( *contents );
+        *contents = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+/* import double- and single-precision wisdom from the file contents */
+static void FFTWWisdomImportContents(const char *contents)
+{
+    const char *dbl = strstr( contents, " fftw_wisdom" );
+    const char *sgl = strstr( contents, " fftwf_wisdom" );
+    while ( dbl && dbl > contents && *dbl != '(' )
+        --dbl;
+    while ( sgl && sgl > contents && *sgl != '(' )
+        --sgl;
+    if ( dbl && *dbl == '(' && ! fftw_import_wisdom_from_string( dbl ) )
+        XLAL_PRINT_WARNING( "Could not import double-precision FFTW wisdom from '%s'", lalFFTWWisdomFile );
+    if ( sgl && *sgl == '(' && ! fftwf_import_wisdom_from_string( sgl ) )
+        XLAL_PRINT_WARNING( "Could not import single-precision FFTW wisdom from '%s'", lalFFTWWisdomFile );
+}
+
+static int FFTWWisdomImport(void)
+{
+    char *contents = NULL;
+    int retn = FFTWWisdomRead( &contents );
+    XLAL_CHECK( retn >= 0, XLAL_EIO, "Could not read FFTW wisdom from '%s'", lalFFTWWisdomFile );
+    if ( retn > 0 )
+        FFTWWisdomImportContents( contents );
+    free( contents );
+    return XLAL_SUCCESS;
+}
+
+static int FFTWWisdomExport(void)
+{
+    char *contents = NULL;
+    char *tmpfile = NULL;
+    char *dbl = NULL;
+    char *sgl = NULL;
+    FILE *fp = NULL;
+#if defined(HAVE_FCNTL_H) && defined(HAVE_UNISTD_H)
+    char *lockfile = NULL;
+    int lockfd = -1;
+    int locked = 0;
+#endif
+    int retn;
+
+    if ( lalFFTWWisdomFile == NULL )
+        return XLAL_SUCCESS;
+
+#if defined(HAVE_FCNTL_H) && defined(HAVE_UNISTD_H)
+    /* serialise updates between processes with an advisory lock on a lock
+     * file, which is removed by the process holding the lock once it is done;
+     * if the file was removed between opening and locking it, try again */
+    lockfile = XLALStringAppendFmt( NULL, "%s.lock", lalFFTWWisdomFile );
+    XLAL_CHECK( lockfile != NULL, XLAL_EFUNC );
+    while ( ( lockfd = open( lockfile, O_RDWR | O_CREAT, 0666 ) ) >= 0 ) {
+        struct flock fl;
+        struct stat st_fd, st_file;
+        int err;
+        memset( &fl, 0, sizeof( fl ) );
+        fl.l_type = F_WRLCK;
+        fl.l_whence = SEEK_SET;
+        while ( ( err = fcntl( lockfd, F_SETLKW, &fl ) ) < 0 && errno == EINTR )
+            ;
+        if ( err < 0 )
+            break;      /* locking not supported; proceed without a lock */
+        if ( fstat( lockfd, &st_fd ) == 0 && stat( lockfile, &st_file ) == 0 && st_fd.st_dev == st_file.st_dev && st_fd.st_ino == st_file.st_ino ) {
+            locked = 1;
+            break;
+        }
+        close( lockfd );
+    }
+#endif
+
+    /* merge wisdom saved by other processes since it was last read; do not
+     * overwrite a file which holds wisdom for a different machine type */
+    retn = FFTWWisdomRead( &contents );
+    if ( retn < 0 )
+        goto done;
+    if ( retn == 0 && contents == NULL ) {
+        struct stat st;
+        if ( stat( lalFFTWWisdomFile, &st ) == 0 ) {
+            retn = 0;
+            goto done;
+        }
+    }
+    if ( contents != NULL )
+        FFTWWisdomImportContents( contents );
+
+    /* write wisdom to a temporary file, then rename it into place */
+    dbl = fftw_export_wisdom_to_string();
+    sgl = fftwf_export_wisdom_to_string();
+    tmpfile = XLALStringAppendFmt( NULL, "%s.XXXXXX", lalFFTWWisdomFile );
+    retn = -1;
+    if ( dbl == NULL || sgl == NULL || tmpfile == NULL )
+        goto done;
+#if defined(HAVE_UNISTD_H)
+    {
+        int fd = mkstemp( tmpfile );
+        if ( fd < 0 || ( fp = fdopen( fd, "w" ) ) == NULL ) {
+            if ( fd >= 0 ) {
+                close( fd );
+                remove( tmpfile );
+            }
+            goto done;
+        }
+        fchmod( fd, 0644 );
+    }
+#else
+    if ( ( fp = fopen( tmpfile, "w" ) ) == NULL )
+        goto done;
+#endif
+    if ( fprintf( fp, "%s%s\n%s\n%s\n", WISDOM_HEADER, lalFFTWWisdomKey, dbl, sgl ) < 0 ) {
+        fclose( fp );
+        remove( tmpfile );
+        goto done;
+    }
+    if ( fclose( fp ) != 0 || rename( tmpfile, lalFFTWWisdomFile ) != 0 ) {
+        remove( tmpfile );
+        goto done;
+    }
+    retn = 1;
+
+done:
+#if defined(HAVE_FCNTL_H) && defined(HAVE_UNISTD_H)
+    if ( locked )
+        unlink( lockfile );
+    if ( lockfd >= 0 )
+        close( lockfd ); /* releases the lock */
+    XLALFree( lockfile );
+#endif
+    free( contents );
+    free( dbl );
+    free( sgl );
+    XLALFree( tmpfile );
+    XLAL_CHECK( retn >= 0, XLAL_EIO, "Could not write FFTW wisdom to '%s'", lalFFTWWisdomFile );
+    return XLAL_SUCCESS;
+}
+
+#endif /* LAL_FFTW3_ENABLED */
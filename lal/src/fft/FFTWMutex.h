@@ -28,8 +28,11 @@ extern "C" {
 
 void XLALFFTWWisdomLock(void);
 void XLALFFTWWisdomUnlock(void);
+void XLALFFTWPlanWithNThreads(int nthreads);
+int XLALFFTWWisdomSetPath(const char *path);
+int XLALFFTWWisdomExport(void);
 
-#if defined(LAL_PTHREAD_LOCK) && defined(LAL_FFTW3_ENABLED)
+#if defined(LAL_FFTW3_ENABLED)
 # define LAL_FFTW_WISDOM_LOCK XLALFFTWWisdomLock()
 # define LAL_FFTW_WISDOM_UNLOCK XLALFFTWWisdomUnlock()
 #else
@@ -134,6 +134,10 @@ int VECTOR_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * _LAL_RESTRICT_ output, const COMPL
     return 0;
 }
 
+/* transforms of sequences of vectors */
+
+#include "SequenceFFT_source.c"
+
 /*
  * Legacy Routines
  */
@@ -304,6 +304,10 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
     return 0;
 }
 
+/* transforms of sequences of vectors */
+
+#include "SequenceFFT_source.c"
+
 /*
  * Legacy Routines
  */
@@ -152,6 +152,9 @@ tagREAL4FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the real data vector for this plan */
   fftwf_plan plan; /**< the FFTW plan */
+  fftwf_plan rcplan; /**< the native FFTW real-to-complex (forward) or complex-to-real (reverse) plan */
+  fftwf_plan manyplan; /**< the native FFTW plan for sequences of vectors, if any */
+  UINT4      howmany; /**< number of vectors in sequences transformed by manyplan */
 };
 
 /**
@@ -163,6 +166,9 @@ tagREAL8FFTPlan
   INT4       sign; /**< sign in transform exponential, -1 for forward, +1 for reverse */
   UINT4      size; /**< length of the real data vector for this plan */
   fftw_plan  plan; /**< the FFTW plan */
+  fftw_plan  rcplan; /**< the native FFTW real-to-complex (forward) or complex-to-real (reverse) plan */
+  fftw_plan  manyplan; /**< the native FFTW plan for sequences of vectors, if any */
+  UINT4      howmany; /**< number of vectors in sequences transformed by manyplan */
 };
 
 
@@ -61,6 +61,10 @@ extern "C" {
  * int XLALREAL4VectorFFT( REAL4Vector *output, REAL4Vector *input, REAL4FFTPlan *plan );
  * int XLALREAL4PowerSpectrum( REAL4Vector *spec, REAL4Vector *data, REAL4FFTPlan *plan );
  *
+ * REAL4FFTPlan * XLALCreateREAL4FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads );
+ * int XLALREAL4ForwardSequenceFFT( COMPLEX8VectorSequence *output, REAL4VectorSequence *input, REAL4FFTPlan *plan );
+ * int XLALREAL4ReverseSequenceFFT( REAL4VectorSequence *output, COMPLEX8VectorSequence *input, REAL4FFTPlan *plan );
+ *
  * REAL8FFTPlan * XLALCreateREAL8FFTPlan( UINT4 size, int fwdflg, int measurelvl );
  * REAL8FFTPlan * XLALCreateForwardREAL8FFTPlan( UINT4 size, int measurelvl );
  * REAL8FFTPlan * XLALCreateReverseREAL8FFTPlan( UINT4 size, int measurelvl );
@@ -70,6 +74,10 @@ extern "C" {
  * int XLALREAL8ReverseFFT( REAL8Vector *output, COMPLEX16Vector *input, REAL8FFTPlan *plan );
  * int XLALREAL8VectorFFT( REAL8Vector *output, REAL8Vector *input, REAL8FFTPlan *plan );
  * int XLALREAL8PowerSpectrum( REAL8Vector *spec, REAL8Vector *data, REAL8FFTPlan *plan );
+ *
+ * REAL8FFTPlan * XLALCreateREAL8FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads );
+ * int XLALREAL8ForwardSequenceFFT( COMPLEX16VectorSequence *output, REAL8VectorSequence *input, REAL8FFTPlan *plan );
+ * int XLALREAL8ReverseSequenceFFT( REAL8VectorSequence *output, COMPLEX16VectorSequence *input, REAL8FFTPlan *plan );
  * \endcode
  *
  * ### Description ###
@@ -108,6 +116,20 @@ extern "C" {
  * transform.  I.e., XLALREAL4ForwardFFT() cannot be supplied with
  * a plan generated by XLALCreateReverseREAL4FFTPlan().
  *
+ * When the data of both the input and output vectors have the alignment
+ * that FFTW requires for its SIMD routines, XLALREAL4ForwardFFT() and
+ * XLALREAL4ReverseFFT() execute a native real-to-complex (complex-to-real)
+ * FFTW plan directly on the vectors, without any temporary storage or
+ * repacking of the data.  The alignment is checked at run time with
+ * <tt>fftw_alignment_of()</tt>.  Vectors created with the LAL vector
+ * factories (e.g. XLALCreateREAL4Vector() and XLALCreateCOMPLEX8Vector())
+ * are only guaranteed to satisfy this requirement if LAL is configured
+ * with <tt>--enable-fftw3-memalign</tt>; otherwise their data has only
+ * the alignment of the system <tt>malloc()</tt> (16 bytes on x86-64),
+ * which may be less than FFTW requires.  Vectors which are not suitably
+ * aligned, e.g. views into the middle of a larger array, are transformed
+ * through a temporary array instead.
+ *
  * XLALREAL4VectorFFT() is a low-level routine that transforms
  * a real vector to a half-complex real vector (with a forward plan) or
  * a half-complex real vector to a real vector (with a reverse plan).
@@ -117,6 +139,14 @@ extern "C" {
  * XLALREAL4PowerSpectrum() computes a real power spectrum of the
  * input real vector and a forward FFT plan.
  *
+ * XLALREAL4ForwardSequenceFFT() and XLALREAL4ReverseSequenceFFT()
+ * transform each vector of a \c REAL4VectorSequence or
+ * \c COMPLEX8VectorSequence, e.g. the overlapping segments of a time
+ * series used for spectrum estimation.  They accept any plan of the right
+ * size, but are most efficient with a plan from
+ * XLALCreateREAL4FFTPlanMany(), which transforms a sequence of
+ * \c howmany vectors in a single (optionally multi-threaded) FFTW call.
+ *
  * ### Return Values ###
  *
  * Upon success,
@@ -429,6 +459,90 @@ int XLALREAL4VectorFFT( REAL4Vector * _LAL_RESTRICT_ output, const REAL4Vector *
  */
 int XLALREAL4PowerSpectrum( REAL4Vector * _LAL_RESTRICT_ spec, const REAL4Vector * _LAL_RESTRICT_ data, const REAL4FFTPlan *plan );
 
+/**
+ * Returns a new REAL4FFTPlan which can also transform sequences of vectors
+ *
+ * The returned plan can be used with all of the REAL4 FFT routines.  In
+ * addition, when it is used with XLALREAL4ForwardSequenceFFT() or
+ * XLALREAL4ReverseSequenceFFT() on sequences of exactly \c howmany
+ * vectors, all of the vectors are transformed by a single call to FFTW.
+ *
+ * @param[in] size The number of points in each real data vector.
+ * @param[in] howmany The number of vectors to transform at once.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation:
+ * - 0: no measurement, just estimate the plan;
+ * - 1: measure the best plan;
+ * - 2: perform a lengthy measurement of the best plan;
+ * - 3: perform an exhasutive measurement of the best plan.
+ * @param[in] nthreads The number of threads FFTW may use to execute the
+ * sequence transform; this is ignored (i.e. treated as 1) if LAL was not
+ * built against the FFTW threads libraries.
+ * @return A pointer to an allocated \c REAL4FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateREAL4FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan or \c howmany is 0.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+REAL4FFTPlan * XLALCreateREAL4FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads );
+
+/**
+ * Performs forward FFTs of each vector in a REAL4VectorSequence
+ *
+ * This routine is equivalent to calling XLALREAL4ForwardFFT() on each
+ * vector of the input sequence in turn, storing the results in the
+ * corresponding vectors of the output sequence.  If the plan was created
+ * by XLALCreateREAL4FFTPlanMany() for the number of vectors in the
+ * sequences, the whole sequence is transformed in a single FFTW call.
+ *
+ * @param[out] output The complex output sequence of vectors of length N/2+1
+ * @param[in] input The input real data sequence of vectors of length N
+ * @param[in] plan The FFT plan to use for the transform
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALREAL4ForwardSequenceFFT() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a
+ * reverse transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan size
+ * are incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALREAL4ForwardSequenceFFT( COMPLEX8VectorSequence *output, const REAL4VectorSequence *input, const REAL4FFTPlan *plan );
+
+/**
+ * Performs reverse FFTs of each vector in a COMPLEX8VectorSequence
+ *
+ * This routine is equivalent to calling XLALREAL4ReverseFFT() on each
+ * vector of the input sequence in turn, storing the results in the
+ * corresponding vectors of the output sequence.  If the plan was created
+ * by XLALCreateREAL4FFTPlanMany() for the number of vectors in the
+ * sequences, the whole sequence is transformed in a single FFTW call.
+ *
+ * @param[out] output The real output data sequence of vectors of length N
+ * @param[in] input The input complex data sequence of vectors of length N/2+1
+ * @param[in] plan The FFT plan to use for the transform
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALREAL4ReverseSequenceFFT() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a
+ * forward transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan size
+ * are incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EDOM] Domain error if the DC or Nyquist component of any of
+ * the input vectors is not purely real.
+ * .
+ */
+int XLALREAL4ReverseSequenceFFT( REAL4VectorSequence *output, const COMPLEX8VectorSequence *input, const REAL4FFTPlan *plan );
+
 /*
  *
  * XLAL REAL8 functions
@@ -661,6 +775,90 @@ int XLALREAL8VectorFFT( REAL8Vector *output, const REAL8Vector *input,
 int XLALREAL8PowerSpectrum( REAL8Vector *spec, const REAL8Vector *data,
     const REAL8FFTPlan *plan );
 
+/**
+ * Returns a new REAL8FFTPlan which can also transform sequences of vectors
+ *
+ * The returned plan can be used with all of the REAL8 FFT routines.  In
+ * addition, when it is used with XLALREAL8ForwardSequenceFFT() or
+ * XLALREAL8ReverseSequenceFFT() on sequences of exactly \c howmany
+ * vectors, all of the vectors are transformed by a single call to FFTW.
+ *
+ * @param[in] size The number of points in each real data vector.
+ * @param[in] howmany The number of vectors to transform at once.
+ * @param[in] fwdflg Set non-zero for a forward FFT plan;
+ * otherwise create a reverse plan
+ * @param[in] measurelvl Measurement level for plan creation:
+ * - 0: no measurement, just estimate the plan;
+ * - 1: measure the best plan;
+ * - 2: perform a lengthy measurement of the best plan;
+ * - 3: perform an exhasutive measurement of the best plan.
+ * @param[in] nthreads The number of threads FFTW may use to execute the
+ * sequence transform; this is ignored (i.e. treated as 1) if LAL was not
+ * built against the FFTW threads libraries.
+ * @return A pointer to an allocated \c REAL8FFTPlan structure is returned
+ * upon successful completion.  Otherwise, a \c NULL pointer is returned
+ * and \c xlalErrno is set to indicate the error.
+ * @par Errors:
+ * The \c XLALCreateREAL8FFTPlanMany() function shall fail if:
+ * - [\c XLAL_EBADLEN] The size of the requested plan or \c howmany is 0.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EFAILED] The call to the underlying FFTW routine failed.
+ * .
+ */
+REAL8FFTPlan * XLALCreateREAL8FFTPlanMany( UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads );
+
+/**
+ * Performs forward FFTs of each vector in a REAL8VectorSequence
+ *
+ * This routine is equivalent to calling XLALREAL8ForwardFFT() on each
+ * vector of the input sequence in turn, storing the results in the
+ * corresponding vectors of the output sequence.  If the plan was created
+ * by XLALCreateREAL8FFTPlanMany() for the number of vectors in the
+ * sequences, the whole sequence is transformed in a single FFTW call.
+ *
+ * @param[out] output The complex output sequence of vectors of length N/2+1
+ * @param[in] input The input real data sequence of vectors of length N
+ * @param[in] plan The FFT plan to use for the transform
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALREAL8ForwardSequenceFFT() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a
+ * reverse transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan size
+ * are incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * .
+ */
+int XLALREAL8ForwardSequenceFFT( COMPLEX16VectorSequence *output, const REAL8VectorSequence *input, const REAL8FFTPlan *plan );
+
+/**
+ * Performs reverse FFTs of each vector in a COMPLEX16VectorSequence
+ *
+ * This routine is equivalent to calling XLALREAL8ReverseFFT() on each
+ * vector of the input sequence in turn, storing the results in the
+ * corresponding vectors of the output sequence.  If the plan was created
+ * by XLALCreateREAL8FFTPlanMany() for the number of vectors in the
+ * sequences, the whole sequence is transformed in a single FFTW call.
+ *
+ * @param[out] output The real output data sequence of vectors of length N
+ * @param[in] input The input complex data sequence of vectors of length N/2+1
+ * @param[in] plan The FFT plan to use for the transform
+ * @return 0 upon successful completion or non-zero upon failure.
+ * @par Errors:
+ * The \c XLALREAL8ReverseSequenceFFT() function shall fail if:
+ * - [\c XLAL_EFAULT] A \c NULL pointer is provided as one of the arguments.
+ * - [\c XLAL_EINVAL] A argument is invalid or the plan is for a
+ * forward transform.
+ * - [\c XLAL_EBADLEN] The input sequence, output sequence, and plan size
+ * are incompatible.
+ * - [\c XLAL_ENOMEM] Insufficient storage space is available.
+ * - [\c XLAL_EDOM] Domain error if the DC or Nyquist component of any of
+ * the input vectors is not purely real.
+ * .
+ */
+int XLALREAL8ReverseSequenceFFT( REAL8VectorSequence *output, const COMPLEX16VectorSequence *input, const REAL8FFTPlan *plan );
+
 /*
  *
  * LAL REAL4 functions
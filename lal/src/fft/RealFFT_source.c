@@ -17,15 +17,20 @@
 #define PLAN_TYPE			CONCAT2(REAL_TYPE,FFTPlan)
 #define REAL_VECTOR_TYPE		CONCAT2(REAL_TYPE,Vector)
 #define COMPLEX_VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define REAL_SEQUENCE_TYPE		CONCAT2(REAL_TYPE,VectorSequence)
+#define COMPLEX_SEQUENCE_TYPE		CONCAT2(COMPLEX_TYPE,VectorSequence)
 
 #define CREATE_PLAN_FUNCTION		CONCAT2(XLALCreate,PLAN_TYPE)
 #define CREATE_FORWARD_PLAN_FUNCTION	CONCAT2(XLALCreateForward,PLAN_TYPE)
 #define CREATE_REVERSE_PLAN_FUNCTION	CONCAT2(XLALCreateReverse,PLAN_TYPE)
+#define CREATE_PLAN_MANY_FUNCTION	CONCAT3(XLALCreate,PLAN_TYPE,Many)
 #define DESTROY_PLAN_FUNCTION		CONCAT2(XLALDestroy,PLAN_TYPE)
 #define FORWARD_FFT_FUNCTION		CONCAT3(XLAL,REAL_TYPE,ForwardFFT)
 #define REVERSE_FFT_FUNCTION		CONCAT3(XLAL,REAL_TYPE,ReverseFFT)
 #define VECTOR_FFT_FUNCTION		CONCAT3(XLAL,REAL_VECTOR_TYPE,FFT)
 #define POWER_SPECTRUM_FUNCTION		CONCAT3(XLAL,REAL_TYPE,PowerSpectrum)
+#define FORWARD_SEQUENCE_FFT_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ForwardSequenceFFT)
+#define REVERSE_SEQUENCE_FFT_FUNCTION	CONCAT3(XLAL,REAL_TYPE,ReverseSequenceFFT)
 
 #define CREALX				CONCAT2(creal,TYPESUFFIX)
 #define CIMAGX				CONCAT2(cimag,TYPESUFFIX)
@@ -33,14 +38,35 @@
 #define FFTWX_PLAN_R2R_1D		CONCAT2(FFTWX,_plan_r2r_1d)
 #define FFTWX_DESTROY_PLAN		CONCAT2(FFTWX,_destroy_plan)
 #define FFTWX_EXECUTE_R2R		CONCAT2(FFTWX,_execute_r2r)
+#define FFTWX_PLAN_R2C_1D		CONCAT2(FFTWX,_plan_dft_r2c_1d)
+#define FFTWX_PLAN_C2R_1D		CONCAT2(FFTWX,_plan_dft_c2r_1d)
+#define FFTWX_EXECUTE_R2C		CONCAT2(FFTWX,_execute_dft_r2c)
+#define FFTWX_EXECUTE_C2R		CONCAT2(FFTWX,_execute_dft_c2r)
+#define FFTWX_PLAN_MANY_R2C		CONCAT2(FFTWX,_plan_many_dft_r2c)
+#define FFTWX_PLAN_MANY_C2R		CONCAT2(FFTWX,_plan_many_dft_c2r)
+#define FFTWX_MALLOC			CONCAT2(FFTWX,_malloc)
+#define FFTWX_FREE			CONCAT2(FFTWX,_free)
+#define FFTWX_ALIGNMENT_OF		CONCAT2(FFTWX,_alignment_of)
+
+/*
+ * The native real-to-complex and complex-to-real plans are created on
+ * arrays from fftw_malloc() and without FFTW_UNALIGNED, so that FFTW is
+ * free to choose its SIMD codelets.  They can then only be executed on
+ * arrays with the same alignment as the planning arrays; vectors which do
+ * not satisfy this are transformed with the (unaligned) halfcomplex plan.
+ */
+#define NATIVE_ALIGNED(ptr)		(FFTWX_ALIGNMENT_OF((REAL_TYPE *)(ptr)) == 0)
 
 PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
 {
     PLAN_TYPE *plan;
     REAL_TYPE *tmp1;
     REAL_TYPE *tmp2;
+    REAL_TYPE *rtmp;
+    COMPLEX_TYPE *ctmp;
     size_t nbytes;
     int flags;
+    int rcflags;
 
     if (!size)
         XLAL_ERROR_NULL(XLAL_EBADLEN);
@@ -70,11 +96,20 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
         break;
     }
 
+    /* native plans require aligned arrays; reverse plans must not
+     * destroy their (const) input array */
+
+    rcflags = (flags & ~FFTW_UNALIGNED);
+    if (!fwdflg)
+        rcflags |= FFTW_PRESERVE_INPUT;
+
     /* allocate memory for the plan and the temporary arrays */
 
     plan = XLALMalloc(sizeof(*plan));
     if (!plan)
         XLAL_ERROR_NULL(XLAL_ENOMEM);
+    plan->manyplan = NULL;
+    plan->howmany = 0;
 
 #   ifdef LAL_FFTW3_MEMALIGN_ENABLED
     tmp1 = XLALMallocAligned(nbytes);
@@ -94,13 +129,32 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     }
 #   endif
 
-    /* establish fftw mutex lock and create plan */
+    rtmp = FFTWX_MALLOC(nbytes);
+    ctmp = FFTWX_MALLOC((size / 2 + 1) * sizeof(*ctmp));
+    if (!rtmp || !ctmp) {
+        FFTWX_FREE(rtmp);
+        FFTWX_FREE(ctmp);
+#       ifdef LAL_FFTW3_MEMALIGN_ENABLED
+        XLALFreeAligned(tmp1);
+        XLALFreeAligned(tmp2);
+#       else
+        XLALFree(tmp1);
+        XLALFree(tmp2);
+#       endif
+        XLALFree(plan);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* establish fftw mutex lock and create plans */
 
     LAL_FFTW_WISDOM_LOCK;
-    if (fwdflg) /* forward */
+    if (fwdflg) { /* forward */
         plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_R2HC, flags);
-    else        /* reverse */
+        plan->rcplan = FFTWX_PLAN_R2C_1D(size, rtmp, ctmp, rcflags);
+    } else {      /* reverse */
         plan->plan = FFTWX_PLAN_R2R_1D(size, tmp1, tmp2, FFTW_HC2R, flags);
+        plan->rcplan = FFTWX_PLAN_C2R_1D(size, ctmp, rtmp, rcflags);
+    }
     LAL_FFTW_WISDOM_UNLOCK;
 
     /* free the temporary arrays */
@@ -112,11 +166,13 @@ PLAN_TYPE *CREATE_PLAN_FUNCTION(UINT4 size, int fwdflg, int measurelvl)
     XLALFree(tmp1);
     XLALFree(tmp2);
 #   endif
+    FFTWX_FREE(rtmp);
+    FFTWX_FREE(ctmp);
 
     /* check to see success of plan creation */
 
-    if (!plan->plan) {
-        XLALFree(plan);
+    if (!plan->plan || !plan->rcplan) {
+        DESTROY_PLAN_FUNCTION(plan);
         XLAL_ERROR_NULL(XLAL_EFAILED);
     }
 
@@ -146,14 +202,95 @@ PLAN_TYPE *CREATE_REVERSE_PLAN_FUNCTION(UINT4 size, int measurelvl)
     return plan;
 }
 
+PLAN_TYPE *CREATE_PLAN_MANY_FUNCTION(UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads)
+{
+    PLAN_TYPE *plan;
+    REAL_TYPE *rtmp;
+    COMPLEX_TYPE *ctmp;
+    int n = size;
+    int flags;
+
+    if (!size || !howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+
+    /* create the plan for single vectors */
+
+    plan = CREATE_PLAN_FUNCTION(size, fwdflg, measurelvl);
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+
+    /* set fftw3 flags to perform requested degree of measurement; the
+     * native plans require aligned arrays, and reverse plans must not
+     * destroy their (const) input array */
+
+    flags = (fwdflg ? 0 : FFTW_PRESERVE_INPUT);
+
+    switch (measurelvl) {
+    case 0:    /* estimate */
+        flags |= FFTW_ESTIMATE;
+        break;
+    default:   /* exhaustive measurement */
+        flags |= FFTW_EXHAUSTIVE;
+        /* fall-through */
+    case 2:    /* lengthy measurement */
+        flags |= FFTW_PATIENT;
+        /* fall-through */
+    case 1:    /* measure the best plan */
+        flags |= FFTW_MEASURE;
+        break;
+    }
+
+    /* allocate memory for the temporary arrays */
+
+    rtmp = FFTWX_MALLOC((size_t) howmany * size * sizeof(*rtmp));
+    ctmp = FFTWX_MALLOC((size_t) howmany * (size / 2 + 1) * sizeof(*ctmp));
+    if (!rtmp || !ctmp) {
+        FFTWX_FREE(rtmp);
+        FFTWX_FREE(ctmp);
+        DESTROY_PLAN_FUNCTION(plan);
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    }
+
+    /* establish fftw mutex lock and create plan for sequences of vectors;
+     * consecutive vectors are contiguous in memory */
+
+    LAL_FFTW_WISDOM_LOCK;
+    XLALFFTWPlanWithNThreads(nthreads);
+    if (fwdflg) /* forward */
+        plan->manyplan = FFTWX_PLAN_MANY_R2C(1, &n, howmany, rtmp, NULL, 1, size, ctmp, NULL, 1, size / 2 + 1, flags);
+    else        /* reverse */
+        plan->manyplan = FFTWX_PLAN_MANY_C2R(1, &n, howmany, ctmp, NULL, 1, size / 2 + 1, rtmp, NULL, 1, size, flags);
+    XLALFFTWPlanWithNThreads(1);
+    LAL_FFTW_WISDOM_UNLOCK;
+
+    /* free the temporary arrays */
+
+    FFTWX_FREE(rtmp);
+    FFTWX_FREE(ctmp);
+
+    /* check to see success of plan creation */
+
+    if (!plan->manyplan) {
+        DESTROY_PLAN_FUNCTION(plan);
+        XLAL_ERROR_NULL(XLAL_EFAILED);
+    }
+
+    plan->howmany = howmany;
+
+    return plan;
+}
+
 void DESTROY_PLAN_FUNCTION(PLAN_TYPE * plan)
 {
     if (plan) {
-        if (plan->plan) {
-            LAL_FFTW_WISDOM_LOCK;
+        LAL_FFTW_WISDOM_LOCK;
+        if (plan->plan)
             FFTWX_DESTROY_PLAN(plan->plan);
-            LAL_FFTW_WISDOM_UNLOCK;
-        }
+        if (plan->rcplan)
+            FFTWX_DESTROY_PLAN(plan->rcplan);
+        if (plan->manyplan)
+            FFTWX_DESTROY_PLAN(plan->manyplan);
+        LAL_FFTW_WISDOM_UNLOCK;
         memset(plan, 0, sizeof(*plan));
         XLALFree(plan);
     }
@@ -177,6 +314,14 @@ int FORWARD_FFT_FUNCTION(COMPLEX_VECTOR_TYPE * output, const REAL_VECTOR_TYPE *
     if (input->length != plan->size || output->length != plan->size / 2 + 1)
         XLAL_ERROR(XLAL_EBADLEN);
 
+    /* if the vectors are suitably aligned, transform directly into the
+     * output vector with the native plan */
+
+    if (NATIVE_ALIGNED(input->data) && NATIVE_ALIGNED(output->data)) {
+        FFTWX_EXECUTE_R2C(plan->rcplan, input->data, output->data);
+        return 0;
+    }
+
     nbytes = plan->size * sizeof(REAL_TYPE);
     input_data = input->data;
 
@@ -254,6 +399,14 @@ int REVERSE_FFT_FUNCTION(REAL_VECTOR_TYPE * output, const COMPLEX_VECTOR_TYPE *
     if (! plan->size % 2 && CIMAGX(input->data[plan->size / 2]) != 0.0)
         XLAL_ERROR(XLAL_EDOM);  /* imaginary part of Nyquist must be zero */
 
+    /* if the vectors are suitably aligned, transform directly into the
+     * output vector with the native plan; the plan preserves its input */
+
+    if (NATIVE_ALIGNED(input->data) && NATIVE_ALIGNED(output->data)) {
+        FFTWX_EXECUTE_C2R(plan->rcplan, input->data, output->data);
+        return 0;
+    }
+
     output_data = output->data;
     nbytes = plan->size * sizeof(REAL_TYPE);
 
@@ -453,6 +606,93 @@ int POWER_SPECTRUM_FUNCTION(REAL_VECTOR_TYPE * spec, const REAL_VECTOR_TYPE * da
     return 0;
 }
 
+int FORWARD_SEQUENCE_FFT_FUNCTION(COMPLEX_SEQUENCE_TYPE * output, const REAL_SEQUENCE_TYPE * input, const PLAN_TYPE * plan)
+{
+    REAL_VECTOR_TYPE invec;
+    COMPLEX_VECTOR_TYPE outvec;
+    UINT4 i;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || plan->sign != -1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (input->vectorLength != plan->size || output->vectorLength != plan->size / 2 + 1)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (input->length != output->length)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    /* transform the whole sequence at once if possible */
+
+    if (plan->manyplan && input->length == plan->howmany && NATIVE_ALIGNED(input->data) && NATIVE_ALIGNED(output->data)) {
+        FFTWX_EXECUTE_R2C(plan->manyplan, input->data, output->data);
+        return 0;
+    }
+
+    /* otherwise transform the vectors one at a time */
+
+    invec.length = input->vectorLength;
+    outvec.length = output->vectorLength;
+    for (i = 0; i < input->length; ++i) {
+        invec.data = input->data + i * input->vectorLength;
+        outvec.data = output->data + i * output->vectorLength;
+        if (FORWARD_FFT_FUNCTION(&outvec, &invec, plan) != 0)
+            XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    return 0;
+}
+
+int REVERSE_SEQUENCE_FFT_FUNCTION(REAL_SEQUENCE_TYPE * output, const COMPLEX_SEQUENCE_TYPE * input, const PLAN_TYPE * plan)
+{
+    COMPLEX_VECTOR_TYPE invec;
+    REAL_VECTOR_TYPE outvec;
+    UINT4 i;
+
+    /* sanity checks on arguments */
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!plan->plan || !plan->size || plan->sign != 1)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (output->vectorLength != plan->size || input->vectorLength != plan->size / 2 + 1)
+        XLAL_ERROR(XLAL_EBADLEN);
+    if (input->length != output->length)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    /* transform the whole sequence at once if possible */
+
+    if (plan->manyplan && input->length == plan->howmany && NATIVE_ALIGNED(input->data) && NATIVE_ALIGNED(output->data)) {
+        for (i = 0; i < input->length; ++i) {
+            const COMPLEX_TYPE *z = input->data + i * input->vectorLength;
+            if (CIMAGX(z[0]) != 0.0)
+                XLAL_ERROR(XLAL_EDOM);  /* imaginary part of DC must be zero */
+            if (plan->size % 2 == 0 && CIMAGX(z[plan->size / 2]) != 0.0)
+                XLAL_ERROR(XLAL_EDOM);  /* imaginary part of Nyquist must be zero */
+        }
+        FFTWX_EXECUTE_C2R(plan->manyplan, input->data, output->data);
+        return 0;
+    }
+
+    /* otherwise transform the vectors one at a time */
+
+    invec.length = input->vectorLength;
+    outvec.length = output->vectorLength;
+    for (i = 0; i < input->length; ++i) {
+        invec.data = input->data + i * input->vectorLength;
+        outvec.data = output->data + i * output->vectorLength;
+        if (REVERSE_FFT_FUNCTION(&outvec, &invec, plan) != 0)
+            XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    return 0;
+}
+
 /*
  * Legacy Routines
  */
@@ -753,8 +993,11 @@ void OLD_POWER_SPECTRUM_FUNCTION(LALStatus * status, REAL_VECTOR_TYPE * spec, RE
 #undef PLAN_TYPE
 #undef REAL_VECTOR_TYPE
 #undef COMPLEX_VECTOR_TYPE
+#undef REAL_SEQUENCE_TYPE
+#undef COMPLEX_SEQUENCE_TYPE
 
 #undef CREATE_PLAN_FUNCTION
+#undef CREATE_PLAN_MANY_FUNCTION
 #undef CREATE_FORWARD_PLAN_FUNCTION
 #undef CREATE_REVERSE_PLAN_FUNCTION
 #undef DESTROY_PLAN_FUNCTION
@@ -762,6 +1005,8 @@ void OLD_POWER_SPECTRUM_FUNCTION(LALStatus * status, REAL_VECTOR_TYPE * spec, RE
 #undef REVERSE_FFT_FUNCTION
 #undef VECTOR_FFT_FUNCTION
 #undef POWER_SPECTRUM_FUNCTION
+#undef FORWARD_SEQUENCE_FFT_FUNCTION
+#undef REVERSE_SEQUENCE_FFT_FUNCTION
 
 #undef CREALX
 #undef CIMAGX
@@ -769,3 +1014,13 @@ void OLD_POWER_SPECTRUM_FUNCTION(LALStatus * status, REAL_VECTOR_TYPE * spec, RE
 #undef FFTWX_PLAN_R2R_1D
 #undef FFTWX_DESTROY_PLAN
 #undef FFTWX_EXECUTE_R2R
+#undef FFTWX_PLAN_R2C_1D
+#undef FFTWX_PLAN_C2R_1D
+#undef FFTWX_EXECUTE_R2C
+#undef FFTWX_EXECUTE_C2R
+#undef FFTWX_PLAN_MANY_R2C
+#undef FFTWX_PLAN_MANY_C2R
+#undef FFTWX_MALLOC
+#undef FFTWX_FREE
+#undef FFTWX_ALIGNMENT_OF
+#undef NATIVE_ALIGNED
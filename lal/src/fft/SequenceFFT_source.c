@@ -0,0 +1,147 @@
+/*
+ * Generic implementations of the sequence FFT routines, for FFT backends
+ * which cannot transform many vectors with a single plan: the plans
+ * returned by the XLALCreate*FFTPlanMany() functions are ordinary
+ * single-vector plans, and each vector of a sequence is transformed in
+ * turn.
+ *
+ * Define REAL_TYPE and COMPLEX_TYPE to generate the real-to-complex
+ * routines, or only COMPLEX_TYPE to generate the complex-to-complex
+ * routine.
+ */
+
+#define SEQ_CONCAT2x(a,b) a##b
+#define SEQ_CONCAT2(a,b) SEQ_CONCAT2x(a,b)
+#define SEQ_CONCAT3x(a,b,c) a##b##c
+#define SEQ_CONCAT3(a,b,c) SEQ_CONCAT3x(a,b,c)
+
+#ifdef REAL_TYPE
+
+#define SEQ_PLAN_TYPE			SEQ_CONCAT2(REAL_TYPE,FFTPlan)
+#define SEQ_REAL_VECTOR_TYPE		SEQ_CONCAT2(REAL_TYPE,Vector)
+#define SEQ_COMPLEX_VECTOR_TYPE		SEQ_CONCAT2(COMPLEX_TYPE,Vector)
+#define SEQ_REAL_SEQUENCE_TYPE		SEQ_CONCAT2(REAL_TYPE,VectorSequence)
+#define SEQ_COMPLEX_SEQUENCE_TYPE	SEQ_CONCAT2(COMPLEX_TYPE,VectorSequence)
+
+SEQ_PLAN_TYPE *SEQ_CONCAT3(XLALCreate,SEQ_PLAN_TYPE,Many)(UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads)
+{
+    SEQ_PLAN_TYPE *plan;
+    (void) nthreads;
+    if (!size || !howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    plan = SEQ_CONCAT2(XLALCreate,SEQ_PLAN_TYPE)(size, fwdflg, measurelvl);
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    return plan;
+}
+
+int SEQ_CONCAT3(XLAL,REAL_TYPE,ForwardSequenceFFT)(SEQ_COMPLEX_SEQUENCE_TYPE * output, const SEQ_REAL_SEQUENCE_TYPE * input, const SEQ_PLAN_TYPE * plan)
+{
+    SEQ_REAL_VECTOR_TYPE invec;
+    SEQ_COMPLEX_VECTOR_TYPE outvec;
+    UINT4 i;
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (input->length != output->length)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    invec.length = input->vectorLength;
+    outvec.length = output->vectorLength;
+    for (i = 0; i < input->length; ++i) {
+        invec.data = input->data + i * input->vectorLength;
+        outvec.data = output->data + i * output->vectorLength;
+        if (SEQ_CONCAT3(XLAL,REAL_TYPE,ForwardFFT)(&outvec, &invec, plan) != 0)
+            XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    return 0;
+}
+
+int SEQ_CONCAT3(XLAL,REAL_TYPE,ReverseSequenceFFT)(SEQ_REAL_SEQUENCE_TYPE * output, const SEQ_COMPLEX_SEQUENCE_TYPE * input, const SEQ_PLAN_TYPE * plan)
+{
+    SEQ_COMPLEX_VECTOR_TYPE invec;
+    SEQ_REAL_VECTOR_TYPE outvec;
+    UINT4 i;
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!output->data || !input->data)
+        XLAL_ERROR(XLAL_EINVAL);
+    if (input->length != output->length)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    invec.length = input->vectorLength;
+    outvec.length = output->vectorLength;
+    for (i = 0; i < input->length; ++i) {
+        invec.data = input->data + i * input->vectorLength;
+        outvec.data = output->data + i * output->vectorLength;
+        if (SEQ_CONCAT3(XLAL,REAL_TYPE,ReverseFFT)(&outvec, &invec, plan) != 0)
+            XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    return 0;
+}
+
+#undef SEQ_PLAN_TYPE
+#undef SEQ_REAL_VECTOR_TYPE
+#undef SEQ_COMPLEX_VECTOR_TYPE
+#undef SEQ_REAL_SEQUENCE_TYPE
+#undef SEQ_COMPLEX_SEQUENCE_TYPE
+
+#else /* REAL_TYPE */
+
+#define SEQ_PLAN_TYPE			SEQ_CONCAT2(COMPLEX_TYPE,FFTPlan)
+#define SEQ_COMPLEX_VECTOR_TYPE		SEQ_CONCAT2(COMPLEX_TYPE,Vector)
+#define SEQ_COMPLEX_SEQUENCE_TYPE	SEQ_CONCAT2(COMPLEX_TYPE,VectorSequence)
+
+SEQ_PLAN_TYPE *SEQ_CONCAT3(XLALCreate,SEQ_PLAN_TYPE,Many)(UINT4 size, UINT4 howmany, int fwdflg, int measurelvl, int nthreads)
+{
+    SEQ_PLAN_TYPE *plan;
+    (void) nthreads;
+    if (!size || !howmany)
+        XLAL_ERROR_NULL(XLAL_EBADLEN);
+    plan = SEQ_CONCAT2(XLALCreate,SEQ_PLAN_TYPE)(size, fwdflg, measurelvl);
+    if (!plan)
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    return plan;
+}
+
+int SEQ_CONCAT3(XLAL,SEQ_COMPLEX_SEQUENCE_TYPE,FFT)(SEQ_COMPLEX_SEQUENCE_TYPE * _LAL_RESTRICT_ output, const SEQ_COMPLEX_SEQUENCE_TYPE * _LAL_RESTRICT_ input,
+    const SEQ_PLAN_TYPE * plan)
+{
+    SEQ_COMPLEX_VECTOR_TYPE invec;
+    SEQ_COMPLEX_VECTOR_TYPE outvec;
+    UINT4 i;
+
+    if (!output || !input || !plan)
+        XLAL_ERROR(XLAL_EFAULT);
+    if (!output->data || !input->data || output->data == input->data)
+        XLAL_ERROR(XLAL_EINVAL);        /* note: must be out-of-place */
+    if (input->length != output->length)
+        XLAL_ERROR(XLAL_EBADLEN);
+
+    invec.length = input->vectorLength;
+    outvec.length = output->vectorLength;
+    for (i = 0; i < input->length; ++i) {
+        invec.data = input->data + i * input->vectorLength;
+        outvec.data = output->data + i * output->vectorLength;
+        if (SEQ_CONCAT3(XLAL,SEQ_COMPLEX_VECTOR_TYPE,FFT)(&outvec, &invec, plan) != 0)
+            XLAL_ERROR(XLAL_EFUNC);
+    }
+
+    return 0;
+}
+
+#undef SEQ_PLAN_TYPE
+#undef SEQ_COMPLEX_VECTOR_TYPE
+#undef SEQ_COMPLEX_SEQUENCE_TYPE
+
+#endif /* REAL_TYPE */
+
+#undef SEQ_CONCAT2x
+#undef SEQ_CONCAT2
+#undef SEQ_CONCAT3x
+#undef SEQ_CONCAT3
@@ -252,6 +252,12 @@ tagLALPSDRegressor
 }
 LALPSDRegressor;
 
+/**
+ * Incremental median PSD estimator over a sliding window of periodograms;
+ * see XLALPSDRunningMedianNew().
+ */
+typedef struct tagLALPSDRunningMedian LALPSDRunningMedian;
+
 /*
  *
  * XLAL Functions
@@ -523,6 +529,40 @@ XLALPSDRegressorSetPSD(
     unsigned weight
 );
 
+LALPSDRunningMedian *
+XLALPSDRunningMedianNew(
+    unsigned median_samples
+);
+
+void
+XLALPSDRunningMedianFree(
+    LALPSDRunningMedian *r
+);
+
+void
+XLALPSDRunningMedianReset(
+    LALPSDRunningMedian *r
+);
+
+unsigned XLALPSDRunningMedianGetMedianSamples(
+    const LALPSDRunningMedian *r
+);
+
+unsigned XLALPSDRunningMedianGetNSamples(
+    const LALPSDRunningMedian *r
+);
+
+int
+XLALPSDRunningMedianAdd(
+    LALPSDRunningMedian *r,
+    const REAL8FrequencySeries *periodogram
+);
+
+REAL8FrequencySeries *
+XLALPSDRunningMedianGetPSD(
+    const LALPSDRunningMedian *r
+);
+
 
 /*@}*/
 
@@ -91,6 +91,8 @@ static void XLALSetDebugLevel(void)
                 level |= LALMEMDBGBIT | LALMEMPADBIT | LALMEMTRKBIT; /* enable memory debugging tools */
             } else if (XLALStringNCaseCompare("MEMTRACE", token, toklen) == 0) {
                 level |= LALTRACEBIT | LALMEMDBG | LALMEMINFOBIT; /* enable memory tracing tools */
+            } else if (XLALStringNCaseCompare("MEMTHREAD", token, toklen) == 0) {
+                level |= LALMEMDBGBIT | LALMEMPADBIT | LALMEMTHRBIT; /* enable lock-free memory debugging tools */
             } else if (XLALStringNCaseCompare("ALLDBG", token, toklen) == 0) {
                 level |= ~LALNDEBUG; /* enable all debugging */
             } else {
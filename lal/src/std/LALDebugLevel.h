@@ -35,7 +35,8 @@ enum {
     LALMEMDBGBIT = 0020,  /**< enable memory debugging routines */
     LALMEMPADBIT = 0040,  /**< enable memory padding */
     LALMEMTRKBIT = 0100,  /**< enable memory tracking */
-    LALMEMINFOBIT = 0200  /**< enable memory info messages */
+    LALMEMINFOBIT = 0200, /**< enable memory info messages */
+    LALMEMTHRBIT = 0400   /**< use lock-free memory accounting, for multithreaded programs */
 };
 
 /** composite lalDebugLevel values */
@@ -50,6 +51,7 @@ enum {
     LALMSGLVL3 = LALERRORBIT | LALWARNINGBIT | LALINFOBIT,      /**< enable error, warning, and info messages */
     LALMEMDBG = LALMEMDBGBIT | LALMEMPADBIT | LALMEMTRKBIT,     /**< enable memory debugging tools */
     LALMEMTRACE = LALTRACEBIT | LALMEMDBG | LALMEMINFOBIT,      /**< enable memory tracing tools */
+    LALMEMTHREAD = LALMEMDBGBIT | LALMEMPADBIT | LALMEMTHRBIT,  /**< enable lock-free memory debugging tools */
     LALALLDBG = ~LALNDEBUG      /**< enable all debugging */
 };
 
@@ -22,6 +22,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <signal.h>
+#include <stdint.h>
 
 #include <config.h>
 #include <lal/LALMalloc.h>
@@ -207,6 +208,340 @@ void XLALFreeAligned(void *ptr)
 
 #endif /* LAL_FFTW3_MEMALIGN_ENABLED */
 
+/*
+ * Thread-local memory arenas.
+ */
+
+/* Alignment of allocations from memory arenas */
+#define ARENA_ALIGN 32
+
+/* Round up n, or a pointer n, to a multiple of ARENA_ALIGN */
+#define ARENA_ROUND(n) (((n) + (ARENA_ALIGN - 1)) & ~((size_t)(ARENA_ALIGN - 1)))
+#define ARENA_ROUND_PTR(p) ((char *) ARENA_ROUND((uintptr_t)(p)))
+
+/* Default usable size of the blocks of a memory arena */
+#define ARENA_DEFAULT_BLOCKSIZE (((size_t) 1) << 20)
+
+/* Size of the header at the start of each block; the usable memory follows */
+#define ARENA_BLOCK_HEADER ARENA_ROUND(sizeof(ArenaBlock))
+
+/* A block of memory, from which arena allocations are taken */
+typedef struct tagArenaBlock {
+    struct tagArenaBlock *next;	/* next (older) block of the arena */
+    size_t size;		/* total size of the block, including this header */
+    char *top;			/* first unused byte of the block */
+    char *end;			/* end of the block */
+} ArenaBlock;
+
+/* A memory arena; stored at the start of the usable memory of its first block */
+typedef struct tagArena {
+    struct tagArena *parent;	/* enclosing arena on this thread, if any */
+    ArenaBlock *blocks;		/* blocks of this arena, newest first */
+    size_t blocksize;		/* usable size of new blocks */
+    char *last;			/* most recent allocation, if it may be resized in place */
+} Arena;
+
+/* Header stored just before each allocation made by the XLALArena functions */
+typedef struct tagArenaHeader {
+    size_t size;		/* size of the allocation */
+    struct tagArena *owner;	/* arena the allocation was taken from, or NULL if taken from the heap */
+} ArenaHeader;
+#define ARENA_HEADER(p) (((ArenaHeader *)(p)) - 1)
+
+/* Per-thread stack of nested arenas */
+typedef struct tagArenaStack {
+    Arena *top;			/* innermost arena */
+    int depth;			/* number of nested arenas */
+    ArenaBlock *spare;		/* first block of a popped arena, kept for reuse */
+} ArenaStack;
+
+/* Free all blocks of an arena, except for its first block, which is returned */
+static ArenaBlock *ArenaFreeBlocks(Arena *arena)
+{
+    ArenaBlock *b = arena->blocks;
+    while (b->next != NULL) {
+        ArenaBlock *next = b->next;
+        free(b);
+        b = next;
+    }
+    return b;
+}
+
+#ifdef LAL_PTHREAD_LOCK
+
+#include <pthread.h>
+
+static pthread_key_t arenaStackKey;
+static pthread_once_t arenaStackKeyOnce = PTHREAD_ONCE_INIT;
+
+/* Free an arena stack; called when a thread exits */
+static void ArenaStackDestroy(void *ptr)
+{
+    ArenaStack *stack = (ArenaStack *) ptr;
+    while (stack->top != NULL) {
+        Arena *arena = stack->top;
+        stack->top = arena->parent;
+        free(ArenaFreeBlocks(arena));
+    }
+    free(stack->spare);
+    free(stack);
+}
+
+static void ArenaStackCreateKey(void)
+{
+    pthread_key_create(&arenaStackKey, ArenaStackDestroy);
+}
+
+/* Return the arena stack of this thread; create it if required */
+static ArenaStack *ArenaStackGet(int create)
+{
+    pthread_once(&arenaStackKeyOnce, ArenaStackCreateKey);
+    ArenaStack *stack = pthread_getspecific(arenaStackKey);
+    if (stack == NULL && create) {
+        stack = calloc(1, sizeof(*stack));
+        if (stack != NULL && pthread_setspecific(arenaStackKey, stack) != 0) {
+            free(stack);
+            stack = NULL;
+        }
+    }
+    return stack;
+}
+
+#else /* ! LAL_PTHREAD_LOCK */
+
+static ArenaStack arenaStackGlobal;
+
+/* Return the arena stack; there is only one if not thread-safe */
+static ArenaStack *ArenaStackGet(int create)
+{
+    (void) create;
+    return &arenaStackGlobal;
+}
+
+#endif /* LAL_PTHREAD_LOCK */
+
+/* Return whether an arena is active on the thread owning the arena stack */
+static int ArenaIsActive(const ArenaStack *stack, const Arena *arena)
+{
+    if (stack == NULL) {
+        return 0;
+    }
+    for (const Arena *a = stack->top; a != NULL; a = a->parent) {
+        if (a == arena) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* Allocate n bytes from an arena; the size and owner of each allocation are stored just before it */
+static void *ArenaAlloc(Arena *arena, size_t n)
+{
+    ArenaBlock *b = arena->blocks;
+    char *p = ARENA_ROUND_PTR(b->top + sizeof(ArenaHeader));
+    if (p > b->end || n > (size_t)(b->end - p)) {
+
+        /* allocate a new block; allocations larger than the block size get a block to themselves */
+        const size_t usable = ARENA_ALIGN + ARENA_ROUND(n);
+        if (usable < n) {
+            return NULL;
+        }
+        const size_t size = ARENA_BLOCK_HEADER + (usable > arena->blocksize ? usable : arena->blocksize);
+        ArenaBlock *newb = malloc(size);
+        if (newb == NULL) {
+            return NULL;
+        }
+        newb->size = size;
+        newb->top = ((char *) newb) + ARENA_BLOCK_HEADER;
+        newb->end = ((char *) newb) + size;
+        p = ARENA_ROUND_PTR(newb->top + sizeof(ArenaHeader));
+        ARENA_HEADER(p)->size = n;
+        ARENA_HEADER(p)->owner = arena;
+        if (usable > arena->blocksize) {
+            /* keep allocating from the current block */
+            newb->next = b->next;
+            b->next = newb;
+            newb->top = p + n;
+            arena->last = NULL;
+            return p;
+        }
+        newb->next = b;
+        arena->blocks = b = newb;
+
+    }
+    b->top = p + n;
+    ARENA_HEADER(p)->size = n;
+    ARENA_HEADER(p)->owner = arena;
+    arena->last = p;
+    return p;
+}
+
+/* Allocate n bytes from the heap, with a header marking it as not belonging to an arena */
+static void *ArenaHeapAlloc(size_t n, const char *file, int line)
+{
+    if (n > ((size_t) -1) - sizeof(ArenaHeader)) {
+        return NULL;
+    }
+    ArenaHeader *h = XLALMallocLong(sizeof(*h) + n, file, line);
+    if (h == NULL) {
+        return NULL;
+    }
+    h->size = n;
+    h->owner = NULL;
+    return h + 1;
+}
+
+int XLALPushMallocArena(size_t blocksize)
+{
+    ArenaStack *stack = ArenaStackGet(1);
+    if (stack == NULL) {
+        XLAL_ERROR(XLAL_ENOMEM, "Could not create memory arena stack");
+    }
+    if (blocksize == 0) {
+        blocksize = ARENA_DEFAULT_BLOCKSIZE;
+    }
+    blocksize = ARENA_ROUND(blocksize);
+
+    /* the arena is stored in its first block, which may be reused from a previous arena */
+    const size_t size = ARENA_BLOCK_HEADER + ARENA_ROUND(sizeof(Arena)) + blocksize;
+    ArenaBlock *b = stack->spare;
+    if (b != NULL && b->size >= size) {
+        stack->spare = NULL;
+    } else {
+        b = malloc(size);
+        if (b == NULL) {
+            XLAL_ERROR(XLAL_ENOMEM, "Could not allocate memory arena of %zu bytes", size);
+        }
+        b->size = size;
+    }
+    b->next = NULL;
+    b->end = ((char *) b) + b->size;
+    Arena *arena = (Arena *)(((char *) b) + ARENA_BLOCK_HEADER);
+    b->top = ((char *) arena) + ARENA_ROUND(sizeof(Arena));
+    arena->parent = stack->top;
+    arena->blocks = b;
+    arena->blocksize = blocksize;
+    arena->last = NULL;
+
+    stack->top = arena;
+    ++stack->depth;
+    return XLAL_SUCCESS;
+}
+
+int XLALPopMallocArena(void)
+{
+    ArenaStack *stack = ArenaStackGet(0);
+    if (stack == NULL || stack->top == NULL) {
+        XLAL_ERROR(XLAL_EFAILED, "No memory arena is active on this thread");
+    }
+    Arena *arena = stack->top;
+    stack->top = arena->parent;
+    --stack->depth;
+
+    /* keep the largest first block for the next arena */
+    ArenaBlock *b = ArenaFreeBlocks(arena);
+    if (stack->spare == NULL || stack->spare->size < b->size) {
+        free(stack->spare);
+        stack->spare = b;
+    } else {
+        free(b);
+    }
+    return XLAL_SUCCESS;
+}
+
+int XLALGetMallocArenaDepth(void)
+{
+    ArenaStack *stack = ArenaStackGet(0);
+    return stack == NULL ? 0 : stack->depth;
+}
+
+void *(XLALArenaMalloc) (size_t n) {
+    return XLALArenaMallocLong(n, "unknown", -1);
+}
+
+void *XLALArenaMallocLong(size_t n, const char *file, int line)
+{
+    ArenaStack *stack = ArenaStackGet(0);
+    void *p = (stack == NULL || stack->top == NULL) ? ArenaHeapAlloc(n, file, line) : ArenaAlloc(stack->top, n);
+    XLAL_TEST_POINTER_LONG(p, 1, file, line);
+    return p;
+}
+
+void *(XLALArenaCalloc) (size_t m, size_t n) {
+    return XLALArenaCallocLong(m, n, "unknown", -1);
+}
+
+void *XLALArenaCallocLong(size_t m, size_t n, const char *file, int line)
+{
+    void *p = (n > 0 && m > ((size_t) -1) / n) ? NULL : XLALArenaMallocLong(m * n, file, line);
+    XLAL_TEST_POINTER_LONG(p, 1, file, line);
+    return memset(p, 0, m * n);
+}
+
+void *(XLALArenaRealloc) (void *p, size_t n) {
+    return XLALArenaReallocLong(p, n, "unknown", -1);
+}
+
+void *XLALArenaReallocLong(void *p, size_t n, const char *file, int line)
+{
+    if (p == NULL) {
+        return XLALArenaMallocLong(n, file, line);
+    }
+    ArenaHeader *h = ARENA_HEADER(p);
+    Arena *arena = h->owner;
+    if (arena == NULL) {
+        /* resize heap memory, keeping its header */
+        h = (n > ((size_t) -1) - sizeof(*h)) ? NULL : XLALReallocLong(h, sizeof(*h) + n, file, line);
+        XLAL_TEST_POINTER_LONG(h, 1, file, line);
+        h->size = n;
+        return h + 1;
+    }
+    if (!ArenaIsActive(ArenaStackGet(0), arena)) {
+        XLAL_ERROR_NULL(XLAL_EINVAL, "Memory resized in %s:%d was not allocated from a memory arena of this thread", file, line);
+    }
+    if (n == 0) {
+        XLALArenaFree(p);
+        return NULL;
+    }
+    const size_t size = h->size;
+
+    /* resize the most recent allocation in place, if there is room */
+    if ((char *) p == arena->last && n <= (size_t)(arena->blocks->end - (char *) p)) {
+        arena->blocks->top = ((char *) p) + n;
+        h->size = n;
+        return p;
+    }
+
+    /* otherwise copy to a new allocation from the same arena */
+    if (n <= size) {
+        h->size = n;
+        return p;
+    }
+    void *q = ArenaAlloc(arena, n);
+    XLAL_TEST_POINTER_LONG(q, 1, file, line);
+    memcpy(q, p, size);
+    return q;
+}
+
+void XLALArenaFree(void *p)
+{
+    if (p == NULL) {
+        return;
+    }
+    ArenaHeader *h = ARENA_HEADER(p);
+    if (h->owner == NULL) {
+        XLALFree(h);
+        return;
+    }
+
+    /* only the most recent allocation of the innermost arena of this thread can be reused */
+    ArenaStack *stack = ArenaStackGet(0);
+    if (stack != NULL && h->owner == stack->top && (char *) p == stack->top->last) {
+        stack->top->blocks->top = (char *) h;
+        stack->top->last = NULL;
+    }
+}
+
 /*
  *
  * LAL Routines... only if compiled with debugging enabled.
@@ -248,6 +583,54 @@ static const size_t magic = 0xABadCafe;
 
 #define allocsz(n) ((lalDebugLevel & LALMEMPADBIT) ? (padFactor * (n) + prefix) : (n))
 
+/* Use atomic operations, if available, for lock-free memory accounting */
+#if defined(__GNUC__) && defined(__ATOMIC_RELAXED)
+#define LAL_MALLOC_ATOMIC 1
+#endif
+
+/* Add to the total amount of memory allocated, and update the peak */
+static void MallocTotalAdd(size_t n)
+{
+#ifdef LAL_MALLOC_ATOMIC
+    if (lalDebugLevel & LALMEMTHRBIT) {
+        const size_t total = __atomic_add_fetch(&lalMallocTotal, n, __ATOMIC_RELAXED);
+        size_t peak = __atomic_load_n(&lalMallocTotalPeak, __ATOMIC_RELAXED);
+        while (peak < total && !__atomic_compare_exchange_n(&lalMallocTotalPeak, &peak, total, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            /* peak is updated on failure; try again */
+        }
+        return;
+    }
+#endif
+    pthread_mutex_lock(&mut);
+    lalMallocTotal += n;
+    lalMallocTotalPeak = (lalMallocTotalPeak > lalMallocTotal) ? lalMallocTotalPeak : lalMallocTotal;
+    pthread_mutex_unlock(&mut);
+}
+
+/* Subtract from the total amount of memory allocated; returns 0 if the total is too small */
+static int MallocTotalSub(size_t n)
+{
+#ifdef LAL_MALLOC_ATOMIC
+    if (lalDebugLevel & LALMEMTHRBIT) {
+        size_t total = __atomic_load_n(&lalMallocTotal, __ATOMIC_RELAXED);
+        do {
+            if (total < n) {
+                return 0;
+            }
+        } while (!__atomic_compare_exchange_n(&lalMallocTotal, &total, total - n, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+        return 1;
+    }
+#endif
+    int ok;
+    pthread_mutex_lock(&mut);
+    ok = (lalMallocTotal >= n);
+    if (ok) {
+        lalMallocTotal -= n;
+    }
+    pthread_mutex_unlock(&mut);
+    return ok;
+}
+
 /* Hash table implementation taken from src/utilities/LALHashTbl.c */
 
 static struct allocNode {
@@ -428,10 +811,7 @@ static void *PadAlloc(size_t * p, size_t n, int keep, const char *func)
         ((char *) p)[i + prefix] = (char) (i ^ padding);
     }
 
-    pthread_mutex_lock(&mut);
-    lalMallocTotal += n;
-    lalMallocTotalPeak = (lalMallocTotalPeak > lalMallocTotal) ? lalMallocTotalPeak : lalMallocTotal;
-    pthread_mutex_unlock(&mut);
+    MallocTotalAdd(n);
 
     return (void *) (((char *) p) + prefix);
 }
@@ -495,7 +875,7 @@ static void *UnPadAlloc(void *p, int keep, const char *func)
     }
 
     /* see if there is enough allocated memory to be freed */
-    if (lalMallocTotal < n) {
+    if (!MallocTotalSub(n)) {
         lalRaiseHook(SIGSEGV, "%s error: lalMallocTotal too small\n",
                      func);
         return NULL;
@@ -509,10 +889,6 @@ static void *UnPadAlloc(void *p, int keep, const char *func)
     q[0] = -1;  /* set negative to detect duplicate frees */
     q[1] = ~magic;
 
-    pthread_mutex_lock(&mut);
-    lalMallocTotal -= n;
-    pthread_mutex_unlock(&mut);
-
     return q;
 }
 
@@ -535,6 +911,7 @@ static void *PushAlloc(void *p, size_t n, const char *file, int line)
     newnode->file = file;
     newnode->line = line;
     if (!AllocHashTblAdd(newnode)) {
+        pthread_mutex_unlock(&mut);
         free(newnode);
         return NULL;
     }
@@ -587,6 +964,7 @@ static void *ModAlloc(void *p, void *q, size_t n, const char *func,
     node->file = file;
     node->line = line;
     if (!AllocHashTblAdd(node)) {
+        pthread_mutex_unlock(&mut);
         free(node);
         return NULL;
     }
@@ -763,6 +1141,12 @@ void LALCheckMemoryLeaks(void)
         leak = 1;
     }
 
+    /* all memory arenas of this thread should have been popped */
+    if (XLALGetMallocArenaDepth() > 0) {
+        XLALPrintError("LALCheckMemoryLeaks: %d memory arenas not popped\n", XLALGetMallocArenaDepth());
+        leak = 1;
+    }
+
     /* lalMallocTotal and alloc_n should be zero */
     if ((lalDebugLevel & LALMEMPADBIT) && (lalMallocTotal || alloc_n)) {
         XLALPrintError("LALCheckMemoryLeaks: %d allocs, %zd bytes\n", alloc_n, lalMallocTotal);
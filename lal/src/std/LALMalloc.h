@@ -67,6 +67,55 @@ void XLALFreeAligned(void *ptr);
 #endif /* LAL_FFTW3_MEMALIGN_ENABLED */
 /*@}*/
 
+/** \addtogroup LALMalloc_h */ /*@{ */
+/**
+ * \name Thread-local memory arenas
+ *
+ * A memory arena collects many short-lived allocations so that they can be
+ * released together. XLALPushMallocArena() starts a new arena on the calling
+ * thread, nested inside any arena already active on that thread; while it is
+ * active, XLALArenaMalloc(), XLALArenaCalloc() and XLALArenaRealloc() take
+ * memory from it by advancing a pointer through large blocks, and
+ * XLALArenaFree() of memory in an arena does nothing (except to reuse the
+ * most recent allocation). XLALPopMallocArena() then releases all memory
+ * allocated from the arena at once, at a cost independent of the number of
+ * allocations. When no arena is active, these functions allocate from the
+ * heap, and the memory must be released with XLALArenaFree().
+ *
+ * Memory arenas are only used by code which opts into them: the memory
+ * returned by the XLALArena functions must only be resized or freed by
+ * XLALArenaRealloc() and XLALArenaFree(), never by XLALRealloc() or
+ * XLALFree(), and the standard factories such as XLALCreateREAL8Vector()
+ * never allocate from an arena. Vectors and series can be allocated from the
+ * active arena with XLALArenaCreateREAL8Vector(),
+ * XLALArenaCreateREAL8TimeSeries(), XLALArenaCreateCOMPLEX16FrequencySeries()
+ * and so on; these must not be destroyed or resized, but are released when
+ * the arena is popped.
+ *
+ * Memory allocated from an arena must only be resized by the thread that
+ * allocated it; XLALArenaFree() of such memory on another thread does
+ * nothing. It must not be used after the arena is popped, so objects that
+ * should outlive the arena must be created before it is pushed, or after it
+ * is popped. Memory allocated from an arena is not seen by the LAL memory
+ * debugging routines.
+ */
+int XLALPushMallocArena(size_t blocksize);
+int XLALPopMallocArena(void);
+int XLALGetMallocArenaDepth(void);
+void *XLALArenaMalloc(size_t n);
+void *XLALArenaMallocLong(size_t n, const char *file, int line);
+void *XLALArenaCalloc(size_t m, size_t n);
+void *XLALArenaCallocLong(size_t m, size_t n, const char *file, int line);
+void *XLALArenaRealloc(void *p, size_t n);
+void *XLALArenaReallocLong(void *p, size_t n, const char *file, int line);
+void XLALArenaFree(void *p);
+#ifndef SWIG    /* exclude from SWIG interface */
+#define XLALArenaMalloc( n )        XLALArenaMallocLong( n, __FILE__, __LINE__ )
+#define XLALArenaCalloc( m, n )     XLALArenaCallocLong( m, n, __FILE__, __LINE__ )
+#define XLALArenaRealloc( p, n )    XLALArenaReallocLong( p, n, __FILE__, __LINE__ )
+#endif /* SWIG */
+/*@}*/
+
 #if defined NDEBUG
 
 #ifndef SWIG    /* exclude from SWIG interface */
@@ -18,10 +18,12 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 #include <errno.h>
 #include <ctype.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALStdio.h>
+#include <lal/Date.h>
 #include <lal/FileIO.h>
 #include <lal/Segments.h>
 #include <lal/SegmentsIO.h>
@@ -355,3 +357,146 @@ LALSegListWrite( LALStatus *status, LALSegList *seglist, const CHAR *fileName, c
 
   RETURN( status );
 }
+
+
+/* Magic string at the start of a binary segment list file */
+static const char segListBinaryMagic[8] = { 'L', 'A', 'L', 'S', 'E', 'G', 'B', '1' };
+
+/* Number of segments encoded or decoded at once by the binary functions */
+#define SEGLIST_BINARY_CHUNK 4096
+
+/* Size in bytes of one segment in a binary segment list file */
+#define SEGLIST_BINARY_SEGSIZE 20
+
+static void SegListBinaryPut( unsigned char *buf, UINT8 x, int nbytes )
+{
+  for ( int i = 0; i < nbytes; ++i, x >>= 8 ) {
+    buf[i] = ( unsigned char )( x & 0xff );
+  }
+}
+
+static UINT8 SegListBinaryGet( const unsigned char *buf, int nbytes )
+{
+  UINT8 x = 0;
+  for ( int i = nbytes - 1; i >= 0; --i ) {
+    x = ( x << 8 ) | buf[i];
+  }
+  return x;
+}
+
+/**
+ * \brief Writes a segment list to a binary file.
+ * \ingroup SegmentsIO_h
+ *
+ * This function writes a segment list in a compact binary format, which is
+ * much faster to write and read back with XLALSegListReadBinary() than the
+ * text format of LALSegListWrite(), and preserves GPS times and segment ids
+ * exactly. If \a compression is nonzero, the file is gzip-compressed.
+ *
+ * The file consists of the 8-byte string <tt>LALSEGB1</tt>, the number of
+ * segments as an 8-byte unsigned integer, and then for each segment its start
+ * and end times as 8-byte integer nanoseconds and its id as a 4-byte integer.
+ * All integers are stored in little-endian byte order, regardless of the
+ * byte order of the machine.
+ */
+int
+XLALSegListWriteBinary( const LALSegList *seglist, const CHAR *fileName, int compression )
+{
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( fileName != NULL, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure" );
+
+  unsigned char *buf = XLALMalloc( SEGLIST_BINARY_CHUNK * SEGLIST_BINARY_SEGSIZE );
+  XLAL_CHECK( buf != NULL, XLAL_ENOMEM );
+  LALFILE *fp = XLALFileOpenWrite( fileName, compression );
+  if ( fp == NULL ) {
+    XLALFree( buf );
+    XLAL_ERROR( XLAL_EIO, "Could not open segment list file '%s' for writing", fileName );
+  }
+
+  /* write header */
+  memcpy( buf, segListBinaryMagic, sizeof( segListBinaryMagic ) );
+  SegListBinaryPut( buf + 8, seglist->length, 8 );
+  int errnum = ( XLALFileWrite( buf, 1, 16, fp ) == 16 ) ? 0 : XLAL_EIO;
+
+  /* write segments, a chunk at a time */
+  for ( UINT4 i = 0; errnum == 0 && i < seglist->length; i += SEGLIST_BINARY_CHUNK ) {
+    const UINT4 n = ( seglist->length - i < SEGLIST_BINARY_CHUNK ) ? seglist->length - i : SEGLIST_BINARY_CHUNK;
+    for ( UINT4 j = 0; j < n; ++j ) {
+      const LALSeg *seg = &seglist->segs[i + j];
+      unsigned char *b = buf + j * SEGLIST_BINARY_SEGSIZE;
+      SegListBinaryPut( b, ( UINT8 ) XLALGPSToINT8NS( &seg->start ), 8 );
+      SegListBinaryPut( b + 8, ( UINT8 ) XLALGPSToINT8NS( &seg->end ), 8 );
+      SegListBinaryPut( b + 16, ( UINT4 ) seg->id, 4 );
+    }
+    if ( XLALFileWrite( buf, 1, n * SEGLIST_BINARY_SEGSIZE, fp ) != n * SEGLIST_BINARY_SEGSIZE ) {
+      errnum = XLAL_EIO;
+    }
+  }
+
+  XLALFree( buf );
+  if ( XLALFileClose( fp ) != 0 && errnum == 0 ) {
+    errnum = XLAL_EIO;
+  }
+  XLAL_CHECK( errnum == 0, errnum, "Could not write segment list file '%s'", fileName );
+  return XLAL_SUCCESS;
+}
+
+/**
+ * \brief Reads a segment list from a binary file.
+ * \ingroup SegmentsIO_h
+ *
+ * This function reads a segment list written by XLALSegListWriteBinary(),
+ * which may be gzip-compressed, and appends the segments to the specified
+ * segment list, which must previously have been initialized.  If it already
+ * has some segments in it, then they are retained.
+ */
+int
+XLALSegListReadBinary( LALSegList *seglist, const CHAR *fileName )
+{
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( fileName != NULL, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure" );
+
+  unsigned char *buf = XLALMalloc( SEGLIST_BINARY_CHUNK * SEGLIST_BINARY_SEGSIZE );
+  XLAL_CHECK( buf != NULL, XLAL_ENOMEM );
+  LALFILE *fp = XLALFileOpenRead( fileName );
+  if ( fp == NULL ) {
+    XLALFree( buf );
+    XLAL_ERROR( XLAL_EIO, "Could not open segment list file '%s' for reading", fileName );
+  }
+
+  /* read header */
+  int errnum = 0;
+  UINT8 length = 0;
+  if ( XLALFileRead( buf, 1, 16, fp ) != 16 || memcmp( buf, segListBinaryMagic, sizeof( segListBinaryMagic ) ) != 0 ) {
+    errnum = XLAL_EIO;
+  } else {
+    length = SegListBinaryGet( buf + 8, 8 );
+  }
+
+  /* read segments, a chunk at a time */
+  for ( UINT8 i = 0; errnum == 0 && i < length; i += SEGLIST_BINARY_CHUNK ) {
+    const size_t n = ( length - i < SEGLIST_BINARY_CHUNK ) ? length - i : SEGLIST_BINARY_CHUNK;
+    if ( XLALFileRead( buf, 1, n * SEGLIST_BINARY_SEGSIZE, fp ) != n * SEGLIST_BINARY_SEGSIZE ) {
+      errnum = XLAL_EIO;
+      break;
+    }
+    for ( size_t j = 0; j < n; ++j ) {
+      const unsigned char *b = buf + j * SEGLIST_BINARY_SEGSIZE;
+      LALSeg seg;
+      XLALINT8NSToGPS( &seg.start, ( INT8 ) SegListBinaryGet( b, 8 ) );
+      XLALINT8NSToGPS( &seg.end, ( INT8 ) SegListBinaryGet( b + 8, 8 ) );
+      seg.id = ( INT4 )( UINT4 ) SegListBinaryGet( b + 16, 4 );
+      if ( XLALSegListAppend( seglist, &seg ) != XLAL_SUCCESS ) {
+        errnum = XLAL_EFUNC;
+        break;
+      }
+    }
+  }
+
+  XLALFree( buf );
+  XLALFileClose( fp );
+  XLAL_CHECK( errnum == 0, errnum, "Could not read segment list file '%s'", fileName );
+  return XLAL_SUCCESS;
+}
@@ -35,6 +35,9 @@
  *
  * The baseline format of a segment list file is described at
  * <tt>http://www.lsc-group.phys.uwm.edu/daswg/docs/technical/seglist_format.html</tt> .
+ * Segment lists may also be stored in a compact binary format, which is
+ * faster to read and write, with XLALSegListWriteBinary() and
+ * XLALSegListReadBinary().
  */
 /*@{*/
 /**\name Error Codes */ /*@{*/
@@ -81,6 +84,12 @@ LALSegListRead( LALStatus *status, LALSegList *seglist, const CHAR *fileName, co
 void
 LALSegListWrite( LALStatus *status, LALSegList *seglist, const CHAR *fileName, const CHAR *options );
 
+int
+XLALSegListWriteBinary( const LALSegList *seglist, const CHAR *fileName, int compression );
+
+int
+XLALSegListReadBinary( LALSegList *seglist, const CHAR *fileName );
+
 #ifdef __cplusplus
 }
 #endif
@@ -20,17 +20,12 @@
 
 #define SERIESTYPE CONCAT2(DATATYPE,TimeSeries)
 #define VECTORTYPE CONCAT2(DATATYPE,Vector)
-#define FILTERTYPE CONCAT2(DBLDATATYPE,IIRFilter)
 
 #define BFUNC CONCAT2(XLALButterworth,SERIESTYPE)
 #define LFUNC CONCAT2(XLALLowPass,SERIESTYPE)
 #define HFUNC CONCAT2(XLALHighPass,SERIESTYPE)
 
-#define CFUNC CONCAT2(XLALCreate,FILTERTYPE)
-#define DFUNC CONCAT2(XLALDestroy,FILTERTYPE)
-
-#define FFUNC CONCAT2(XLALIIRFilter,VECTORTYPE)
-#define RFUNC CONCAT2(XLALIIRFilterReverse,VECTORTYPE)
+#define FFUNC CONCAT2(XLALSOSFiltFilt,VECTORTYPE)
 
 int BFUNC(SERIESTYPE *series, PassBandParamStruc *params)
 {
@@ -61,7 +56,7 @@ int BFUNC(SERIESTYPE *series, PassBandParamStruc *params)
     REAL8 theta=LAL_PI*(i+0.5)/n;
     REAL8 ar=wc*cos(theta);
     REAL8 ai=wc*sin(theta);
-    FILTERTYPE *iirFilter=NULL;
+    REAL8SOSFilter *sosFilter=NULL;
     COMPLEX16ZPGFilter *zpgFilter=NULL;
 
     /* Generate the filter in the w-plane. */
@@ -89,31 +84,30 @@ int BFUNC(SERIESTYPE *series, PassBandParamStruc *params)
       XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
       XLAL_ERROR( XLAL_EFUNC );
     }
-    iirFilter = CFUNC(zpgFilter);
-    if (!iirFilter)
+    sosFilter = XLALCreateREAL8SOSFilter(zpgFilter,1);
+    if (!sosFilter)
     {
       XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
       XLAL_ERROR( XLAL_EFUNC );
     }
 
     /* Filter the data, once each way. */
-    if (FFUNC(series->data,iirFilter)<0
-        || RFUNC(series->data,iirFilter)<0)
+    if (FFUNC(series->data,sosFilter)<0)
     {
       XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
-      DFUNC(iirFilter);
+      XLALDestroyREAL8SOSFilter(sosFilter);
       XLAL_ERROR( XLAL_EFUNC );
     }
 
     /* Free the filters. */
     XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
-    DFUNC(iirFilter);
+    XLALDestroyREAL8SOSFilter(sosFilter);
   }
 
   /* Next, this conditional applies the possible order 1 filter
      corresponding to an unpaired pole on the imaginary w axis. */
   if(i==j){
-    FILTERTYPE *iirFilter=NULL;
+    REAL8SOSFilter *sosFilter=NULL;
     COMPLEX16ZPGFilter *zpgFilter=NULL;
 
     /* Generate the filter in the w-plane. */
@@ -137,25 +131,24 @@ int BFUNC(SERIESTYPE *series, PassBandParamStruc *params)
       XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
       XLAL_ERROR(XLAL_EFUNC);
     }
-    iirFilter=CFUNC(zpgFilter);
-    if (!iirFilter)
+    sosFilter=XLALCreateREAL8SOSFilter(zpgFilter,1);
+    if (!sosFilter)
     {
       XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
       XLAL_ERROR(XLAL_EFUNC);
     }
 
     /* Filter the data, once each way. */
-    if (FFUNC(series->data,iirFilter)<0
-        || RFUNC(series->data,iirFilter)<0)
+    if (FFUNC(series->data,sosFilter)<0)
     {
       XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
-      DFUNC(iirFilter);
+      XLALDestroyREAL8SOSFilter(sosFilter);
       XLAL_ERROR( XLAL_EFUNC );
     }
 
     /* Free the filters. */
     XLALDestroyCOMPLEX16ZPGFilter(zpgFilter);
-    DFUNC(iirFilter);
+    XLALDestroyREAL8SOSFilter(sosFilter);
   }
 
   return 0;
@@ -190,13 +183,9 @@ int HFUNC(SERIESTYPE *series, REAL8 frequency, REAL8 amplitude, INT4 filtorder)
 #undef BFUNC
 #undef LFUNC
 #undef HFUNC
-#undef CFUNC
-#undef DFUNC
 #undef FFUNC
-#undef RFUNC
 #undef SERIESTYPE
 #undef VECTORTYPE
-#undef FILTERTYPE
 #undef DBLDATATYPE
 #undef DATATYPE
 #undef CONCAT2x
@@ -0,0 +1,390 @@
+/*
+*  This program is free software; you can redistribute it and/or modify
+*  it under the terms of the GNU General Public License as published by
+*  the Free Software Foundation; either version 2 of the License, or
+*  (at your option) any later version.
+*
+*  This program is distributed in the hope that it will be useful,
+*  but WITHOUT ANY WARRANTY; without even the implied warranty of
+*  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*  GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License
+*  along with with program; see the file COPYING. If not, write to the
+*  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+*  MA  02111-1307  USA
+*/
+
+#include <complex.h>
+#include <math.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/IIRFilter.h>
+
+/**
+ * \addtogroup SOSFilter_c
+ *
+ * \brief Creates and applies cascaded second-order-section IIR filters.
+ *
+ * ### Description ###
+ *
+ * A \c REAL8SOSFilter represents the same transfer function as a
+ * \c REAL8IIRFilter, factored into a cascade of second-order sections
+ * (biquads):
+ * \f[
+ * T(z) = \prod_{s} \frac{b_{0,s} + b_{1,s}z^{-1} + b_{2,s}z^{-2}}
+ * {1 + a_{1,s}z^{-1} + a_{2,s}z^{-2}} \; .
+ * \f]
+ * Each section is applied in transposed direct form II, so that its
+ * state consists of just two numbers which are kept in registers while
+ * a block of data is filtered; the data are processed in blocks small
+ * enough to stay in cache while passing through all of the sections.
+ * Unlike the routines in \ref IIRFilterVector_c, no filter history is
+ * shifted and no memory is allocated per sample.  The factored form is
+ * also much better conditioned than the expanded polynomial
+ * coefficients of a high-order \c REAL8IIRFilter.
+ *
+ * <tt>XLALCreateREAL8SOSFilter()</tt> builds a filter from a
+ * \c COMPLEX16ZPGFilter in the \f$z\f$-plane, subject to the same
+ * realizability constraints as <tt>XLALCreateREAL8IIRFilter()</tt>:
+ * zeros and poles must be real or come in complex-conjugate pairs, of
+ * which only the positive-imaginary members are used, and only the real
+ * part of the gain is used.  Complex pole pairs each get their own
+ * section, and are matched with the nearest remaining complex zero pair;
+ * real poles and zeros are grouped two to a section.  Sections are
+ * ordered so that the poles closest to the unit circle are applied
+ * last, and the gain is applied in the first section.
+ *
+ * The filter stores a separate state for each of
+ * <tt>filter->numChannels</tt> data channels.  The routines
+ * <tt>XLALSOSFilter\<datatype\>Vector()</tt> filter a single channel,
+ * continuing from (and updating) the stored state, so that a long data
+ * stream can be filtered in consecutive pieces.  The routines
+ * <tt>XLALSOSFilter\<datatype\>VectorSequence()</tt> filter each vector
+ * of a sequence as a separate channel; the channels are interleaved in
+ * blocks so that the innermost loop runs over channels, allowing the
+ * compiler to filter several channels at once in SIMD lanes.
+ *
+ * The routines <tt>XLALSOSFilterReverse\<datatype\>Vector()</tt> filter
+ * the data backwards in time, and
+ * <tt>XLALSOSFiltFilt\<datatype\>Vector()</tt> and
+ * <tt>XLALSOSFiltFilt\<datatype\>VectorSequence()</tt> filter the data
+ * forwards and then backwards, giving a zero-phase filter with the
+ * squared magnitude response of \f$T\f$.  These routines always start from
+ * zero filter state, and do not modify the filter, in the same way as
+ * <tt>XLALIIRFilterReverse\<datatype\>Vector()</tt>.
+ *
+ * All arithmetic is performed in double precision, regardless of the
+ * precision of the data.
+ *
+ */
+/*@{*/
+
+/** Number of samples filtered as a block through all sections */
+#define SOS_BLOCK_LENGTH 512
+
+/** Number of coefficients stored per section */
+#define SOS_NUM_COEF 5
+
+/* Apply the sections in turn to a block of real data,
+   keeping the state of each section in registers. */
+static void SOSCascadeREAL8( REAL8 *buf, UINT4 length, const REAL8 *coef, UINT4 numSections, REAL8 *state )
+{
+  for ( UINT4 s = 0; s < numSections; ++s, coef += SOS_NUM_COEF, state += 2 ) {
+    const REAL8 b0 = coef[0], b1 = coef[1], b2 = coef[2], a1 = coef[3], a2 = coef[4];
+    REAL8 z1 = state[0], z2 = state[1];
+    for ( UINT4 n = 0; n < length; ++n ) {
+      const REAL8 x = buf[n];
+      const REAL8 y = b0 * x + z1;
+      z1 = b1 * x - a1 * y + z2;
+      z2 = b2 * x - a2 * y;
+      buf[n] = y;
+    }
+    state[0] = z1;
+    state[1] = z2;
+  }
+}
+
+/* Apply the sections in turn to a block of complex data;
+   the coefficients are real, so this is just two real filters. */
+static void SOSCascadeCOMPLEX16( COMPLEX16 *buf, UINT4 length, const REAL8 *coef, UINT4 numSections, COMPLEX16 *state )
+{
+  for ( UINT4 s = 0; s < numSections; ++s, coef += SOS_NUM_COEF, state += 2 ) {
+    const REAL8 b0 = coef[0], b1 = coef[1], b2 = coef[2], a1 = coef[3], a2 = coef[4];
+    COMPLEX16 z1 = state[0], z2 = state[1];
+    for ( UINT4 n = 0; n < length; ++n ) {
+      const COMPLEX16 x = buf[n];
+      const COMPLEX16 y = b0 * x + z1;
+      z1 = b1 * x - a1 * y + z2;
+      z2 = b2 * x - a2 * y;
+      buf[n] = y;
+    }
+    state[0] = z1;
+    state[1] = z2;
+  }
+}
+
+/* Apply the sections in turn to a block of interleaved channels, stored
+   as buf[n*numLanes + c]; the state is stored as
+   state[(2*s + k)*numLanes + c].  The innermost loop runs over
+   channels, and is independent between iterations. */
+static void SOSCascadeLanesREAL8( REAL8 * _LAL_RESTRICT_ buf, UINT4 length, UINT4 numLanes, const REAL8 *coef, UINT4 numSections, REAL8 * _LAL_RESTRICT_ state )
+{
+  for ( UINT4 s = 0; s < numSections; ++s, coef += SOS_NUM_COEF ) {
+    const REAL8 b0 = coef[0], b1 = coef[1], b2 = coef[2], a1 = coef[3], a2 = coef[4];
+    REAL8 * _LAL_RESTRICT_ z1 = state + 2 * s * numLanes;
+    REAL8 * _LAL_RESTRICT_ z2 = z1 + numLanes;
+    for ( UINT4 n = 0; n < length; ++n ) {
+      REAL8 * _LAL_RESTRICT_ row = buf + n * numLanes;
+      for ( UINT4 c = 0; c < numLanes; ++c ) {
+        const REAL8 x = row[c];
+        const REAL8 y = b0 * x + z1[c];
+        z1[c] = b1 * x - a1 * y + z2[c];
+        z2[c] = b2 * x - a2 * y;
+        row[c] = y;
+      }
+    }
+  }
+}
+
+/* Split a list of roots into complex-conjugate pairs, represented by
+   their positive-imaginary member, and real roots sorted by decreasing
+   magnitude.  Fails if the number of roots is inconsistent with every
+   nonreal root being paired. */
+static int SOSSplitRoots( const COMPLEX16 *roots, UINT4 numRoots, COMPLEX16 *cplx, UINT4 *numCplx, REAL8 *real, UINT4 *numReal )
+{
+  *numCplx = *numReal = 0;
+  for ( UINT4 i = 0; i < numRoots; ++i ) {
+    if ( cimag( roots[i] ) == 0.0 ) {
+      UINT4 j = ( *numReal )++;
+      while ( j > 0 && fabs( real[j-1] ) < fabs( creal( roots[i] ) ) ) {
+        real[j] = real[j-1];
+        --j;
+      }
+      real[j] = creal( roots[i] );
+    } else if ( cimag( roots[i] ) > 0.0 ) {
+      cplx[( *numCplx )++] = roots[i];
+    }
+  }
+  XLAL_CHECK( 2 * ( *numCplx ) + ( *numReal ) == numRoots, XLAL_EINVAL, "Input has unpaired nonreal poles or zeros" );
+  return XLAL_SUCCESS;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+REAL8SOSFilter *XLALCreateREAL8SOSFilter( COMPLEX16ZPGFilter *input, UINT4 numChannels )
+{
+  REAL8SOSFilter *output = NULL;
+  COMPLEX16 *cplxZeros = NULL, *cplxPoles = NULL;
+  REAL8 *realZeros = NULL, *realPoles = NULL;
+  COMPLEX16 *secPole = NULL;
+  REAL8 *secRadius = NULL;
+  INT4 *secNumZeros = NULL;
+  UINT4 *order = NULL;
+  REAL8 *coef = NULL;
+  UINT4 numZeros, numPoles, numCplxZeros, numRealZeros, numCplxPoles, numRealPoles;
+  UINT4 numSections;
+
+  /* Make sure all the input structures have been initialized. */
+  XLAL_CHECK_NULL( input != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( input->zeros != NULL && input->poles != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL( input->zeros->length == 0 || input->zeros->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL( input->poles->length == 0 || input->poles->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK_NULL( numChannels > 0, XLAL_EINVAL );
+  numZeros = input->zeros->length;
+  numPoles = input->poles->length;
+
+  /* Separate the zeros and poles into conjugate pairs and real roots. */
+  cplxZeros = XLALCalloc( numZeros + 1, sizeof( *cplxZeros ) );
+  realZeros = XLALCalloc( numZeros + 1, sizeof( *realZeros ) );
+  cplxPoles = XLALCalloc( numPoles + 1, sizeof( *cplxPoles ) );
+  realPoles = XLALCalloc( numPoles + 1, sizeof( *realPoles ) );
+  XLAL_CHECK_FAIL( cplxZeros != NULL && realZeros != NULL && cplxPoles != NULL && realPoles != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL( SOSSplitRoots( input->zeros->data, numZeros, cplxZeros, &numCplxZeros, realZeros, &numRealZeros ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_FAIL( SOSSplitRoots( input->poles->data, numPoles, cplxPoles, &numCplxPoles, realPoles, &numRealPoles ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+#ifndef NDEBUG
+  if ( lalDebugLevel & LALWARNING ) {
+    /* Issue a warning if the gain is nonreal. */
+    if ( fabs( cimag( input->gain ) ) > fabs( LAL_REAL8_EPS * creal( input->gain ) ) ) {
+      XLALPrintWarning( "XLAL Warning - %s: Gain is non-real\n", __func__ );
+      XLALPrintWarning( "\tg = %.8e + i*%.8e\n", creal( input->gain ), cimag( input->gain ) );
+    }
+    /* Issue a warning if any poles are outside |z|=1. */
+    for ( UINT4 i = 0; i < numPoles; ++i ) {
+      if ( cabs( input->poles->data[i] ) > 1.0 ) {
+        XLALPrintWarning( "XLAL Warning - %s: Filter has pole outside of unit circle\n", __func__ );
+        XLALPrintWarning( "\tp_%u = %.8e + i*%.8e, |p_%u| = %.8e\n", i,
+                          creal( input->poles->data[i] ), cimag( input->poles->data[i] ), i,
+                          cabs( input->poles->data[i] ) );
+      }
+    }
+  }
+#endif
+
+  /* Each complex pair of roots needs its own section; real roots are
+     grouped two to a section. */
+  {
+    const UINT4 numZeroSections = numCplxZeros + ( numRealZeros + 1 ) / 2;
+    const UINT4 numPoleSections = numCplxPoles + ( numRealPoles + 1 ) / 2;
+    numSections = ( numZeroSections > numPoleSections ) ? numZeroSections : numPoleSections;
+    if ( numSections == 0 ) {
+      numSections = 1;
+    }
+  }
+
+  /* Assign the poles to sections, recording a representative pole and
+     its distance from the origin. */
+  secPole = XLALCalloc( numSections, sizeof( *secPole ) );
+  secRadius = XLALCalloc( numSections, sizeof( *secRadius ) );
+  secNumZeros = XLALCalloc( numSections, sizeof( *secNumZeros ) );
+  order = XLALCalloc( numSections, sizeof( *order ) );
+  coef = XLALCalloc( numSections * SOS_NUM_COEF, sizeof( *coef ) );
+  XLAL_CHECK_FAIL( secPole != NULL && secRadius != NULL && secNumZeros != NULL && order != NULL && coef != NULL, XLAL_ENOMEM );
+  for ( UINT4 s = 0; s < numSections; ++s ) {
+    REAL8 *c = coef + s * SOS_NUM_COEF;
+    c[0] = 1.0;
+    if ( s < numCplxPoles ) {
+      const COMPLEX16 p = cplxPoles[s];
+      c[3] = -2.0 * creal( p );
+      c[4] = creal( p ) * creal( p ) + cimag( p ) * cimag( p );
+      secPole[s] = p;
+      secRadius[s] = cabs( p );
+    } else {
+      const UINT4 k = 2 * ( s - numCplxPoles );
+      if ( k + 1 < numRealPoles ) {
+        c[3] = -( realPoles[k] + realPoles[k+1] );
+        c[4] = realPoles[k] * realPoles[k+1];
+        secPole[s] = realPoles[k];
+        secRadius[s] = fabs( realPoles[k] );
+      } else if ( k < numRealPoles ) {
+        c[3] = -realPoles[k];
+        secPole[s] = realPoles[k];
+        secRadius[s] = fabs( realPoles[k] );
+      }
+    }
+    order[s] = s;
+  }
+
+  /* Sort the sections by increasing pole radius (insertion sort; the
+     number of sections is small), so that the most resonant sections
+     are applied last. */
+  for ( UINT4 i = 1; i < numSections; ++i ) {
+    const UINT4 t = order[i];
+    UINT4 j = i;
+    while ( j > 0 && secRadius[order[j-1]] > secRadius[t] ) {
+      order[j] = order[j-1];
+      --j;
+    }
+    order[j] = t;
+  }
+
+  /* Match each complex zero pair with the nearest pole, starting with
+     the poles closest to the unit circle. */
+  for ( UINT4 i = numSections; i-- > 0 && numCplxZeros > 0; ) {
+    const UINT4 s = order[i];
+    REAL8 *c = coef + s * SOS_NUM_COEF;
+    UINT4 best = 0;
+    for ( UINT4 k = 1; k < numCplxZeros; ++k ) {
+      if ( cabs( cplxZeros[k] - secPole[s] ) < cabs( cplxZeros[best] - secPole[s] ) ) {
+        best = k;
+      }
+    }
+    c[1] = -2.0 * creal( cplxZeros[best] );
+    c[2] = creal( cplxZeros[best] ) * creal( cplxZeros[best] ) + cimag( cplxZeros[best] ) * cimag( cplxZeros[best] );
+    secNumZeros[s] = 2;
+    cplxZeros[best] = cplxZeros[--numCplxZeros];
+  }
+
+  /* Fill the remaining numerator slots with the real zeros. */
+  for ( UINT4 i = numSections, k = 0; i-- > 0 && k < numRealZeros; ) {
+    const UINT4 s = order[i];
+    REAL8 *c = coef + s * SOS_NUM_COEF;
+    if ( secNumZeros[s] == 0 && k + 1 < numRealZeros ) {
+      c[1] = -( realZeros[k] + realZeros[k+1] );
+      c[2] = realZeros[k] * realZeros[k+1];
+      secNumZeros[s] = 2;
+      k += 2;
+    } else if ( secNumZeros[s] == 0 ) {
+      c[1] = -realZeros[k];
+      secNumZeros[s] = 1;
+      k += 1;
+    }
+  }
+
+  /* Create the output filter, storing the sections in order and
+     applying the gain in the first section. */
+  output = XLALCalloc( 1, sizeof( *output ) );
+  XLAL_CHECK_FAIL( output != NULL, XLAL_ENOMEM );
+  output->deltaT = input->deltaT;
+  output->numSections = numSections;
+  output->numChannels = numChannels;
+  output->coef = XLALCreateREAL8Vector( numSections * SOS_NUM_COEF );
+  XLAL_CHECK_FAIL( output->coef != NULL, XLAL_EFUNC );
+  output->history = XLALCreateREAL8Vector( 2 * numSections * numChannels );
+  XLAL_CHECK_FAIL( output->history != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < numSections; ++i ) {
+    memcpy( output->coef->data + i * SOS_NUM_COEF, coef + order[i] * SOS_NUM_COEF, SOS_NUM_COEF * sizeof( *coef ) );
+  }
+  for ( UINT4 k = 0; k < 3; ++k ) {
+    output->coef->data[k] *= creal( input->gain );
+  }
+  XLALResetREAL8SOSFilter( output );
+
+  XLALFree( cplxZeros );
+  XLALFree( realZeros );
+  XLALFree( cplxPoles );
+  XLALFree( realPoles );
+  XLALFree( secPole );
+  XLALFree( secRadius );
+  XLALFree( secNumZeros );
+  XLALFree( order );
+  XLALFree( coef );
+  return output;
+
+XLAL_FAIL:
+  XLALFree( cplxZeros );
+  XLALFree( realZeros );
+  XLALFree( cplxPoles );
+  XLALFree( realPoles );
+  XLALFree( secPole );
+  XLALFree( secRadius );
+  XLALFree( secNumZeros );
+  XLALFree( order );
+  XLALFree( coef );
+  XLALDestroyREAL8SOSFilter( output );
+  return NULL;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+void XLALDestroyREAL8SOSFilter( REAL8SOSFilter *filter )
+{
+  if ( filter ) {
+    XLALDestroyREAL8Vector( filter->coef );
+    XLALDestroyREAL8Vector( filter->history );
+    XLALFree( filter );
+  }
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+void XLALResetREAL8SOSFilter( REAL8SOSFilter *filter )
+{
+  if ( filter && filter->history && filter->history->data ) {
+    memset( filter->history->data, 0, filter->history->length * sizeof( *filter->history->data ) );
+  }
+}
+
+#define SINGLE_PRECISION
+#include "SOSFilter_source.c"
+#undef SINGLE_PRECISION
+#include "SOSFilter_source.c"
+
+#define COMPLEX_DATA
+#define SINGLE_PRECISION
+#include "SOSFilter_source.c"
+#undef SINGLE_PRECISION
+#include "SOSFilter_source.c"
+#undef COMPLEX_DATA
+
+/*@}*/
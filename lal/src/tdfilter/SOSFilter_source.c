@@ -0,0 +1,184 @@
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define STRING(a) #a
+
+#ifdef COMPLEX_DATA
+#   define DBLDATATYPE COMPLEX16
+#   ifdef SINGLE_PRECISION
+#       define DATATYPE COMPLEX8
+#   else
+#       define DATATYPE COMPLEX16
+#   endif
+#else
+#   define DBLDATATYPE REAL8
+#   ifdef SINGLE_PRECISION
+#       define DATATYPE REAL4
+#   else
+#       define DATATYPE REAL8
+#   endif
+#endif
+
+#define VECTORTYPE CONCAT2(DATATYPE,Vector)
+#define SEQUENCETYPE CONCAT2(DATATYPE,VectorSequence)
+
+#define CASCADE CONCAT2(SOSCascade,DBLDATATYPE)
+#define BLOCKFUNC CONCAT2(SOSFilterBlocks,VECTORTYPE)
+#define LANESFUNC CONCAT2(SOSFilterLanes,SEQUENCETYPE)
+
+#define FFUNC CONCAT2(XLALSOSFilter,VECTORTYPE)
+#define RFUNC CONCAT2(XLALSOSFilterReverse,VECTORTYPE)
+#define FFFUNC CONCAT2(XLALSOSFiltFilt,VECTORTYPE)
+#define SFUNC CONCAT2(XLALSOSFilter,SEQUENCETYPE)
+#define SFFFUNC CONCAT2(XLALSOSFiltFilt,SEQUENCETYPE)
+
+/* Filter data forwards or backwards in blocks, starting from (and
+   updating) the given state. */
+static void BLOCKFUNC(DATATYPE *data, UINT4 length, int reverse, const REAL8SOSFilter *filter, DBLDATATYPE *state)
+{
+  DBLDATATYPE buf[SOS_BLOCK_LENGTH];
+  for ( UINT4 start = 0; start < length; start += SOS_BLOCK_LENGTH ) {
+    const UINT4 n = ( length - start < SOS_BLOCK_LENGTH ) ? length - start : SOS_BLOCK_LENGTH;
+    if ( reverse ) {
+      DATATYPE *p = data + length - 1 - start;
+      for ( UINT4 k = 0; k < n; ++k )
+        buf[k] = *(p--);
+      CASCADE(buf, n, filter->coef->data, filter->numSections, state);
+      p = data + length - 1 - start;
+      for ( UINT4 k = 0; k < n; ++k )
+        *(p--) = buf[k];
+    } else {
+      DATATYPE *p = data + start;
+      for ( UINT4 k = 0; k < n; ++k )
+        buf[k] = p[k];
+      CASCADE(buf, n, filter->coef->data, filter->numSections, state);
+      for ( UINT4 k = 0; k < n; ++k )
+        p[k] = buf[k];
+    }
+  }
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int RFUNC(VECTORTYPE *vector, const REAL8SOSFilter *filter)
+{
+  DBLDATATYPE *state;
+  XLAL_CHECK( vector != NULL && filter != NULL, XLAL_EFAULT );
+  XLAL_CHECK( vector->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK( filter->coef != NULL && filter->coef->data != NULL, XLAL_EINVAL );
+  state = XLALCalloc( 2 * filter->numSections, sizeof( *state ) );
+  XLAL_CHECK( state != NULL, XLAL_ENOMEM );
+  BLOCKFUNC(vector->data, vector->length, 1, filter, state);
+  XLALFree( state );
+  return XLAL_SUCCESS;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int FFFUNC(VECTORTYPE *vector, const REAL8SOSFilter *filter)
+{
+  DBLDATATYPE *state;
+  XLAL_CHECK( vector != NULL && filter != NULL, XLAL_EFAULT );
+  XLAL_CHECK( vector->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK( filter->coef != NULL && filter->coef->data != NULL, XLAL_EINVAL );
+  state = XLALCalloc( 2 * filter->numSections, sizeof( *state ) );
+  XLAL_CHECK( state != NULL, XLAL_ENOMEM );
+  BLOCKFUNC(vector->data, vector->length, 0, filter, state);
+  memset( state, 0, 2 * filter->numSections * sizeof( *state ) );
+  BLOCKFUNC(vector->data, vector->length, 1, filter, state);
+  XLALFree( state );
+  return XLAL_SUCCESS;
+}
+
+#ifndef COMPLEX_DATA
+
+/** \see See \ref SOSFilter_c for documentation */
+int FFUNC(VECTORTYPE *vector, REAL8SOSFilter *filter)
+{
+  XLAL_CHECK( vector != NULL && filter != NULL, XLAL_EFAULT );
+  XLAL_CHECK( vector->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK( filter->coef != NULL && filter->coef->data != NULL
+              && filter->history != NULL && filter->history->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK( filter->numChannels == 1, XLAL_EINVAL, "Filter has %u channels, expected 1", filter->numChannels );
+  BLOCKFUNC(vector->data, vector->length, 0, filter, filter->history->data);
+  return XLAL_SUCCESS;
+}
+
+/* Filter each vector of a sequence forwards or backwards as a separate
+   channel, interleaving the channels in blocks so that the filter loop
+   runs over channels innermost. */
+static int LANESFUNC(SEQUENCETYPE *sequence, int reverse, const REAL8SOSFilter *filter, REAL8 *state)
+{
+  const UINT4 numLanes = sequence->length;
+  const UINT4 length = sequence->vectorLength;
+  const UINT4 blockLength = ( numLanes < SOS_BLOCK_LENGTH ) ? SOS_BLOCK_LENGTH / numLanes : 1;
+  REAL8 *buf = XLALMalloc( blockLength * numLanes * sizeof( *buf ) );
+  XLAL_CHECK( buf != NULL, XLAL_ENOMEM );
+  for ( UINT4 start = 0; start < length; start += blockLength ) {
+    const UINT4 n = ( length - start < blockLength ) ? length - start : blockLength;
+    for ( UINT4 c = 0; c < numLanes; ++c ) {
+      const DATATYPE *p = sequence->data + c * length;
+      for ( UINT4 k = 0; k < n; ++k )
+        buf[k * numLanes + c] = p[reverse ? length - 1 - start - k : start + k];
+    }
+    SOSCascadeLanesREAL8( buf, n, numLanes, filter->coef->data, filter->numSections, state );
+    for ( UINT4 c = 0; c < numLanes; ++c ) {
+      DATATYPE *p = sequence->data + c * length;
+      for ( UINT4 k = 0; k < n; ++k )
+        p[reverse ? length - 1 - start - k : start + k] = buf[k * numLanes + c];
+    }
+  }
+  XLALFree( buf );
+  return XLAL_SUCCESS;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int SFUNC(SEQUENCETYPE *sequence, REAL8SOSFilter *filter)
+{
+  XLAL_CHECK( sequence != NULL && filter != NULL, XLAL_EFAULT );
+  XLAL_CHECK( sequence->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK( filter->coef != NULL && filter->coef->data != NULL
+              && filter->history != NULL && filter->history->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK( filter->numChannels == sequence->length, XLAL_EINVAL, "Filter has %u channels, sequence has %u", filter->numChannels, sequence->length );
+  XLAL_CHECK( LANESFUNC(sequence, 0, filter, filter->history->data) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/** \see See \ref SOSFilter_c for documentation */
+int SFFFUNC(SEQUENCETYPE *sequence, const REAL8SOSFilter *filter)
+{
+  REAL8 *state;
+  XLAL_CHECK( sequence != NULL && filter != NULL, XLAL_EFAULT );
+  XLAL_CHECK( sequence->data != NULL, XLAL_EINVAL );
+  XLAL_CHECK( filter->coef != NULL && filter->coef->data != NULL, XLAL_EINVAL );
+  if ( sequence->length == 0 )
+    return XLAL_SUCCESS;
+  state = XLALCalloc( 2 * filter->numSections * sequence->length, sizeof( *state ) );
+  XLAL_CHECK( state != NULL, XLAL_ENOMEM );
+  if ( LANESFUNC(sequence, 0, filter, state) != XLAL_SUCCESS ) {
+    XLALFree( state );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+  memset( state, 0, 2 * filter->numSections * sequence->length * sizeof( *state ) );
+  if ( LANESFUNC(sequence, 1, filter, state) != XLAL_SUCCESS ) {
+    XLALFree( state );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+  XLALFree( state );
+  return XLAL_SUCCESS;
+}
+
+#endif /* COMPLEX_DATA */
+
+#undef CASCADE
+#undef BLOCKFUNC
+#undef LANESFUNC
+#undef FFUNC
+#undef RFUNC
+#undef FFFUNC
+#undef SFUNC
+#undef SFFFUNC
+#undef SEQUENCETYPE
+#undef VECTORTYPE
+#undef DBLDATATYPE
+#undef DATATYPE
+#undef CONCAT2x
+#undef CONCAT2
+#undef STRING
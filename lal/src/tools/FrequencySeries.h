@@ -84,6 +84,39 @@ UINT4FrequencySeries *XLALCreateUINT4FrequencySeries ( const CHAR *name, const L
 UINT8FrequencySeries *XLALCreateUINT8FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
 /*@}*/
 
+/**
+ * \name Creation Functions for Memory Arenas
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/FrequencySeries.h>
+ *
+ * XLALArenaCreate<frequencyseriestype>()
+ * \endcode
+ *
+ * ### Description ###
+ *
+ * These functions create LAL frequency series from the memory arena which is active on
+ * the calling thread (see XLALPushMallocArena()), and fail if there is none.
+ * The series must not be destroyed, resized or shrunk; they are released when
+ * the arena is popped.
+ */
+/*@{*/
+#ifndef SWIG   /* exclude from SWIG interface */
+COMPLEX8FrequencySeries *XLALArenaCreateCOMPLEX8FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+COMPLEX16FrequencySeries *XLALArenaCreateCOMPLEX16FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+REAL4FrequencySeries *XLALArenaCreateREAL4FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+REAL8FrequencySeries *XLALArenaCreateREAL8FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+INT2FrequencySeries *XLALArenaCreateINT2FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+INT4FrequencySeries *XLALArenaCreateINT4FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+INT8FrequencySeries *XLALArenaCreateINT8FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+UINT2FrequencySeries *XLALArenaCreateUINT2FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+UINT4FrequencySeries *XLALArenaCreateUINT4FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+UINT8FrequencySeries *XLALArenaCreateUINT8FrequencySeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaF, const LALUnit *sampleUnits, size_t length );
+#endif   /* SWIG */
+/*@}*/
+
 /**
  * \name Destruction Functions
  *
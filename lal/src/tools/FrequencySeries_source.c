@@ -1,11 +1,14 @@
 #define CONCAT2x(a,b) a##b
 #define CONCAT2(a,b) CONCAT2x(a,b)
+#define CONCAT3x(a,b,c) a##b##c
+#define CONCAT3(a,b,c) CONCAT3x(a,b,c)
 
 #define SERIESTYPE CONCAT2(DATATYPE,FrequencySeries)
 #define SEQUENCETYPE CONCAT2(DATATYPE,Sequence)
 
 #define DSERIES CONCAT2(XLALDestroy,SERIESTYPE)
 #define CSERIES CONCAT2(XLALCreate,SERIESTYPE)
+#define ACSERIES CONCAT2(XLALArenaCreate,SERIESTYPE)
 #define XSERIES CONCAT2(XLALCut,SERIESTYPE)
 #define RSERIES CONCAT2(XLALResize,SERIESTYPE)
 #define SSERIES CONCAT2(XLALShrink,SERIESTYPE)
@@ -16,6 +19,7 @@
 #define CSEQUENCE CONCAT2(XLALCreate,SEQUENCETYPE)
 #define XSEQUENCE CONCAT2(XLALCut,SEQUENCETYPE)
 #define RSEQUENCE CONCAT2(XLALResize,SEQUENCETYPE)
+#define ACSEQUENCE CONCAT3(XLALArenaCreate,DATATYPE,Vector)
 
 void DSERIES (
 	SERIESTYPE *series
@@ -62,6 +66,42 @@ SERIESTYPE *CSERIES (
 }
 
 
+SERIESTYPE *ACSERIES (
+	const CHAR *name,
+	const LIGOTimeGPS *epoch,
+	REAL8 f0,
+	REAL8 deltaF,
+	const LALUnit *sampleUnits,
+	size_t length
+)
+{
+	SERIESTYPE *new;
+
+	if(XLALGetMallocArenaDepth() == 0)
+		XLAL_ERROR_NULL(XLAL_EFAILED, "No memory arena is active on this thread");
+	if(length > LAL_UINT4_MAX)
+		XLAL_ERROR_NULL(XLAL_EBADLEN);
+	new = XLALArenaMalloc(sizeof(*new));
+	if(!new)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	new->data = ACSEQUENCE (length);
+	if(!new->data)
+		XLAL_ERROR_NULL(XLAL_EFUNC);	/* new is released with the arena */
+
+	if(name) {
+		strncpy(new->name, name, LALNameLength - 1);
+		new->name[LALNameLength - 1] = '\0';
+	} else
+		new->name[0] = '\0';
+	new->epoch = *epoch;
+	new->f0 = f0;
+	new->deltaF = deltaF;
+	new->sampleUnits = *sampleUnits;
+
+	return new;
+}
+
+
 SERIESTYPE *XSERIES (
 	const SERIESTYPE *series,
 	size_t first,
@@ -231,6 +271,7 @@ SERIESTYPE *MSERIES (
 
 #undef DSERIES
 #undef CSERIES
+#undef ACSERIES
 #undef XSERIES
 #undef RSERIES
 #undef SSERIES
@@ -241,3 +282,4 @@ SERIESTYPE *MSERIES (
 #undef CSEQUENCE
 #undef XSEQUENCE
 #undef RSEQUENCE
+#undef ACSEQUENCE
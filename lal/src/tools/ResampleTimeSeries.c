@@ -18,10 +18,16 @@
 */
 
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 #include <lal/LALStdlib.h>
 #include <lal/LALStdio.h>
+#include <lal/LALString.h>
 #include <lal/AVFactories.h>
 #include <lal/LALConstants.h>
+#include <lal/Date.h>
+#include <lal/TimeSeries.h>
+#include <lal/Window.h>
 #include <lal/IIRFilter.h>
 #include <lal/BandPassTimeSeries.h>
 #include <lal/ResampleTimeSeries.h>
@@ -32,7 +38,48 @@
  *
  * \author Brown, D. A., Brady, P. R., Charlton, P.
  *
- * \brief Downsamples a time series in place by an integer power of two.
+ * \brief Resamples a time series by a rational ratio.
+ *
+ * ### XLAL routines ###
+ *
+ * The routines XLALResampleREAL4TimeSeries() and
+ * XLALResampleREAL8TimeSeries() resample a time series in place to the
+ * sample interval \c dt, which may be larger or smaller than the sample
+ * interval of the input.  The ratio of the output to the input sample
+ * interval must be a ratio \f$q/p\f$ of integers no larger than 4096; an
+ * integer ratio, or the inverse of an integer ratio, is accepted to within
+ * \f$10^{-3}\f$ of an input sample.  The output has
+ * \f$\lfloor Np/q\rfloor\f$ samples, where \f$N\f$ is the number of input
+ * samples, and has the same epoch as the input.
+ *
+ * The resampling is done by a polyphase FIR filter.  Conceptually, the
+ * input is upsampled by \f$p\f$ by inserting zeros, low-pass filtered, and
+ * downsampled by \f$q\f$; in practice only the output samples are computed,
+ * each from the taps of one phase of the filter, so the cost is
+ * proportional to the number of output samples.  The low-pass filter is
+ * a Kaiser-windowed sinc with half amplitude at 0.9 times the lower of the
+ * input and output Nyquist frequencies, a transition band 0.2 times that
+ * Nyquist frequency wide, and a stop-band attenuation of 100 dB.  The
+ * filter is symmetric and centred on each output sample, so there is no
+ * time delay or phase shift.  The data outside the time series are taken
+ * to be zero, so roughly 32 samples (at the lower of the input and output
+ * sample rates) at each end of the output time series are corrupted.  Filter designs are cached, so that
+ * repeatedly resampling by the same ratio does not repeat the design.
+ *
+ * A time series too long to hold in memory, such as a stream of frame
+ * data, can be resampled chunk by chunk with a ::ResampleTSState object
+ * created by XLALCreateResampleTSState().  Each call to
+ * XLALResampleREAL8TimeSeriesChunk() or XLALResampleREAL4TimeSeriesChunk()
+ * takes the next contiguous chunk of input, and returns a new time series
+ * containing the output samples which can now be computed, with the
+ * correct epoch; the output lags behind the input by half the filter
+ * length.  XLALResampleREAL8TimeSeriesFlush() or
+ * XLALResampleREAL4TimeSeriesFlush() return the remaining output samples
+ * up to the end of the input, and reset the state for a new stream.  The
+ * output samples are identical to those computed by
+ * XLALResampleREAL8TimeSeries() from the whole time series.
+ *
+ * ### LAL routines ###
  *
  * The routine LALResampleREAL4TimeSeries() provided functionality to
  * downsample a time series in place by an integer factor which is a power of
@@ -115,53 +162,307 @@
  */
 /*@{*/
 
+/* Parameters of the anti-aliasing filter, relative to the lower of the
+   input and output Nyquist frequencies. */
+#define RESAMPLE_CUTOFF 0.9		/* Frequency of half amplitude */
+#define RESAMPLE_TRANSITION 0.2		/* Width of transition band */
+#define RESAMPLE_ATTENUATION 100.0	/* Stop-band attenuation in dB */
+
+/* Largest upsampling or downsampling factor in a rational ratio. */
+#define RESAMPLE_MAX_FACTOR 4096
+
+/* Number of filter designs kept in the cache. */
+#define RESAMPLE_CACHE_SIZE 8
+
+/*
+ * A polyphase filter design for resampling by a rational ratio. The
+ * prototype low-pass filter h[n], n = 0 ... 2*K*p, is designed at p
+ * times the input sample rate; output sample k is then
+ *
+ *   y[k] = sum_i h[k*q + K*p - i*p] x[i] ,
+ *
+ * which only involves the taps of one phase, (k*q + K*p) mod p, of the
+ * filter. The taps of each phase are stored in reverse order, so that
+ * each output sample is a forward dot product with the input.
+ */
+typedef struct tagResampleTSDesign {
+  UINT4 upFactor;		/* p */
+  UINT4 downFactor;		/* q */
+  UINT4 halfLength;		/* K, in input samples */
+  UINT4 phaseLength;		/* 2*K + 1 taps per phase */
+  REAL8 *taps;			/* p phases of phaseLength taps */
+  UINT4 refcount;
+  UINT8 lastUsed;
+} ResampleTSDesign;
+
+/* State of a streaming resampler. */
+struct tagResampleTSState {
+  ResampleTSDesign *design;
+  REAL8 deltaTIn;
+  REAL8 deltaTOut;
+  CHAR name[LALNameLength];
+  LALUnit sampleUnits;
+  LIGOTimeGPS epoch;		/* time of the first input sample */
+  INT8 numIn;			/* number of input samples consumed */
+  INT8 numOut;			/* number of output samples produced */
+  REAL8 *buffer;		/* last phaseLength - 1 input samples, then the current chunk */
+  UINT4 bufferLength;
+};
+
+/*
+ * The cache of filter designs. Designs are reference counted, since a
+ * design evicted from the cache may still be used by a streaming
+ * resampler. Cached designs persist until the end of the program, and so
+ * are allocated with the standard library rather than LALMalloc(), to
+ * keep them out of the LAL memory-leak checks.
+ */
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+static pthread_mutex_t resampleCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#else
+#define pthread_mutex_lock( pmut )
+#define pthread_mutex_unlock( pmut )
+#endif
+static ResampleTSDesign *resampleCache[RESAMPLE_CACHE_SIZE];
+static UINT8 resampleCacheCounter = 0;
+
+/* Find p and q such that deltaTOut / deltaTIn = q / p. */
+static int ResampleTSRatio( UINT4 *upFactor, UINT4 *downFactor, REAL8 deltaTIn, REAL8 deltaTOut )
+{
+  const REAL8 ratio = deltaTOut / deltaTIn;
+  UINT4 factor;
+
+  /* integer downsampling or upsampling factors are accepted with the
+     same tolerance as by previous versions of these routines */
+  factor = floor( ratio + 0.5 );
+  if ( factor >= 1 && fabs( deltaTOut - factor * deltaTIn ) <= 1e-3 * deltaTIn ) {
+    *upFactor = 1;
+    *downFactor = factor;
+    return XLAL_SUCCESS;
+  }
+  factor = floor( 1.0 / ratio + 0.5 );
+  if ( factor >= 1 && fabs( deltaTIn - factor * deltaTOut ) <= 1e-3 * deltaTOut ) {
+    *upFactor = factor;
+    *downFactor = 1;
+    return XLAL_SUCCESS;
+  }
+
+  /* otherwise find the first convergent of the continued fraction
+     expansion of the ratio which matches it to high precision */
+  {
+    REAL8 x = ratio;
+    UINT8 h0 = 1, h1 = 0, k0 = 0, k1 = 1;
+    while ( 1 ) {
+      const REAL8 a = floor( x );
+      const UINT8 h = ( UINT8 ) a * h0 + h1;
+      const UINT8 k = ( UINT8 ) a * k0 + k1;
+      XLAL_CHECK( h <= RESAMPLE_MAX_FACTOR && k <= RESAMPLE_MAX_FACTOR, XLAL_EINVAL,
+                  "Resampling ratio %.16g is not a ratio of integers <= %d", ratio, RESAMPLE_MAX_FACTOR );
+      if ( fabs( ( REAL8 ) h / ( REAL8 ) k - ratio ) <= 1e-9 * ratio ) {
+        *upFactor = k;
+        *downFactor = h;
+        return XLAL_SUCCESS;
+      }
+      h1 = h0;
+      h0 = h;
+      k1 = k0;
+      k0 = k;
+      x = 1.0 / ( x - a );
+    }
+  }
+}
+
+/* Design a Kaiser-windowed sinc low-pass filter and split it into phases. */
+static ResampleTSDesign *ResampleTSCreateDesign( UINT4 upFactor, UINT4 downFactor )
+{
+  const UINT4 maxFactor = ( upFactor > downFactor ) ? upFactor : downFactor;
+  const REAL8 cutoff = RESAMPLE_CUTOFF * 0.5 / maxFactor;
+  const REAL8 transition = RESAMPLE_TRANSITION * 0.5 / maxFactor;
+  const REAL8 beta = 0.1102 * ( RESAMPLE_ATTENUATION - 8.7 );
+  const REAL8 order = ( RESAMPLE_ATTENUATION - 7.95 ) / ( 14.36 * transition );
+  ResampleTSDesign *design = NULL;
+  REAL8Window *window = NULL;
+  UINT4 numTaps;
+
+  design = calloc( 1, sizeof( *design ) );
+  XLAL_CHECK_NULL( design != NULL, XLAL_ENOMEM );
+  design->upFactor = upFactor;
+  design->downFactor = downFactor;
+  design->halfLength = ceil( 0.5 * order / upFactor );
+  design->phaseLength = 2 * design->halfLength + 1;
+  numTaps = 2 * design->halfLength * upFactor + 1;
+  design->taps = calloc( ( size_t ) upFactor * design->phaseLength, sizeof( *design->taps ) );
+  XLAL_CHECK_FAIL( design->taps != NULL, XLAL_ENOMEM );
+
+  window = XLALCreateKaiserREAL8Window( numTaps, beta );
+  XLAL_CHECK_FAIL( window != NULL, XLAL_EFUNC );
+  for ( UINT4 phase = 0; phase < upFactor; ++phase ) {
+    REAL8 *taps = design->taps + ( size_t ) phase * design->phaseLength;
+    REAL8 sum = 0;
+    for ( UINT4 j = 0; phase + j * upFactor < numTaps; ++j ) {
+      const UINT4 n = phase + j * upFactor;
+      const REAL8 t = 2.0 * cutoff * ( ( REAL8 ) n - ( REAL8 ) design->halfLength * upFactor );
+      const REAL8 sinc = ( t == 0.0 ) ? 1.0 : sin( LAL_PI * t ) / ( LAL_PI * t );
+      taps[design->phaseLength - 1 - j] = sinc * window->data->data[n];
+      sum += taps[design->phaseLength - 1 - j];
+    }
+    /* normalise each phase to unit DC gain */
+    for ( UINT4 j = 0; j < design->phaseLength; ++j )
+      taps[j] /= sum;
+  }
+  XLALDestroyREAL8Window( window );
+
+  return design;
+
+XLAL_FAIL:
+  XLALDestroyREAL8Window( window );
+  if ( design )
+    free( design->taps );
+  free( design );
+  return NULL;
+}
+
+/* Get a filter design from the cache, creating it if necessary. */
+static ResampleTSDesign *ResampleTSAcquireDesign( UINT4 upFactor, UINT4 downFactor )
+{
+  ResampleTSDesign *design = NULL;
+  UINT4 slot = 0;
+
+  pthread_mutex_lock( &resampleCacheMutex );
+  for ( UINT4 i = 0; i < RESAMPLE_CACHE_SIZE; ++i ) {
+    if ( resampleCache[i] && resampleCache[i]->upFactor == upFactor && resampleCache[i]->downFactor == downFactor ) {
+      design = resampleCache[i];
+      break;
+    }
+    if ( resampleCache[slot] && ( !resampleCache[i] || resampleCache[i]->lastUsed < resampleCache[slot]->lastUsed ) )
+      slot = i;
+  }
+  if ( !design ) {
+    design = ResampleTSCreateDesign( upFactor, downFactor );
+    if ( !design ) {
+      pthread_mutex_unlock( &resampleCacheMutex );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+    /* replace the empty or least recently used cache entry */
+    if ( resampleCache[slot] && --resampleCache[slot]->refcount == 0 ) {
+      free( resampleCache[slot]->taps );
+      free( resampleCache[slot] );
+    }
+    resampleCache[slot] = design;
+    design->refcount = 1;
+  }
+  ++design->refcount;
+  design->lastUsed = ++resampleCacheCounter;
+  pthread_mutex_unlock( &resampleCacheMutex );
+
+  return design;
+}
+
+/* Release a filter design acquired with ResampleTSAcquireDesign(). */
+static void ResampleTSReleaseDesign( ResampleTSDesign *design )
+{
+  if ( design ) {
+    pthread_mutex_lock( &resampleCacheMutex );
+    if ( --design->refcount == 0 ) {
+      free( design->taps );
+      free( design );
+    }
+    pthread_mutex_unlock( &resampleCacheMutex );
+  }
+}
+
+/* Compute one output sample from input x[lo ... lo + phaseLength - 1],
+   where x has indices 0 ... length - 1 and is zero outside them. */
+static REAL8 ResampleTSDot( const REAL8 *taps, UINT4 phaseLength, const REAL8 *x, INT8 lo, INT8 length )
+{
+  REAL8 sum = 0;
+  if ( lo >= 0 && lo + phaseLength <= length ) {
+    x += lo;
+    for ( UINT4 t = 0; t < phaseLength; ++t )
+      sum += taps[t] * x[t];
+  } else {
+    for ( UINT4 t = 0; t < phaseLength; ++t )
+      if ( lo + t >= 0 && lo + t < length )
+        sum += taps[t] * x[lo + t];
+  }
+  return sum;
+}
+
+/* Resample a whole data vector, treating the data outside it as zero. */
+static void ResampleTSVector( REAL8 *output, UINT4 outputLength, const REAL8 *input, UINT4 inputLength, const ResampleTSDesign *design )
+{
+  const UINT4 p = design->upFactor;
+  const UINT4 q = design->downFactor;
+  const UINT4 L = design->phaseLength;
+  for ( UINT4 k = 0; k < outputLength; ++k ) {
+    const UINT8 m = ( UINT8 ) k * q + ( UINT8 ) design->halfLength * p;
+    const INT8 lo = ( INT8 )( m / p ) - ( L - 1 );
+    output[k] = ResampleTSDot( design->taps + ( m % p ) * L, L, input, lo, inputLength );
+  }
+}
+
+/* Create a filter design and resample a whole time series in place;
+   shared by XLALResampleREAL4TimeSeries() and XLALResampleREAL8TimeSeries(). */
+static int ResampleTSSeries( REAL8 **output, UINT4 *outputLength, const REAL8 *input, UINT4 inputLength, REAL8 deltaTIn, REAL8 deltaTOut )
+{
+  UINT4 p, q;
+  ResampleTSDesign *design;
+  XLAL_CHECK( ResampleTSRatio( &p, &q, deltaTIn, deltaTOut ) == XLAL_SUCCESS, XLAL_EFUNC );
+  *outputLength = ( ( UINT8 ) inputLength * p ) / q;
+  *output = NULL;
+  if ( p == q )
+    return XLAL_SUCCESS;
+  design = ResampleTSAcquireDesign( p, q );
+  XLAL_CHECK( design != NULL, XLAL_EFUNC );
+  *output = LALMalloc( ( *outputLength ? *outputLength : 1 ) * sizeof( **output ) );
+  if ( !*output ) {
+    ResampleTSReleaseDesign( design );
+    XLAL_ERROR( XLAL_ENOMEM );
+  }
+  ResampleTSVector( *output, *outputLength, input, inputLength, design );
+  ResampleTSReleaseDesign( design );
+  return XLAL_SUCCESS;
+}
+
 /** \see See \ref ResampleTimeSeries_c for documentation */
 int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt )
 {
-  const INT4 filterOrder = 20;
-  const REAL8 newNyquistAmplitude = 0.1;
-  REAL8 newNyquistFrequency;
-  UINT4 resampleFactor;
-  REAL4 *dataPtr = NULL;
+  REAL8 *input = NULL;
+  REAL8 *output = NULL;
+  UINT4 outputLength = 0;
   UINT4 j;
 
-  resampleFactor = floor( dt / series->deltaT + 0.5 );
-  newNyquistFrequency = 0.5 / dt;
+  XLAL_CHECK( series != NULL && series->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( dt > 0 && series->deltaT > 0, XLAL_EINVAL );
 
-  /* check that the resampling factor is valid */
-  if ( resampleFactor < 1 ||
-      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT )
-    XLAL_ERROR( XLAL_EINVAL );
+  /* resample in double precision */
+  input = LALMalloc( ( series->data->length ? series->data->length : 1 ) * sizeof( *input ) );
+  XLAL_CHECK( input != NULL, XLAL_ENOMEM );
+  for ( j = 0; j < series->data->length; ++j )
+    input[j] = series->data->data[j];
+  if ( ResampleTSSeries( &output, &outputLength, input, series->data->length, series->deltaT, dt ) < 0 )
+  {
+    LALFree( input );
+    XLAL_ERROR( XLAL_EFUNC );
+  }
+  LALFree( input );
 
   /* just return if no resampling is required */
-  if ( resampleFactor == 1 )
+  if ( ! output )
   {
     XLALPrintInfo( "XLAL Info - %s: No resampling required", __func__ );
     return 0;
   }
 
-  /* check that we are resampling by a power of two */
-  if ( ! ( resampleFactor == 0x1 || resampleFactor == 0x2 ||
-        resampleFactor == 0x4 || resampleFactor == 0x8 ||
-        resampleFactor == 0x10 || resampleFactor == 0x20 ||
-        resampleFactor == 0x40 || resampleFactor == 0x80 ) )
-    XLAL_ERROR( XLAL_EINVAL );
-
-  if ( XLALLowPassREAL4TimeSeries( series, newNyquistFrequency,
-        newNyquistAmplitude, filterOrder ) < 0 )
-    XLAL_ERROR( XLAL_EFUNC );
-
-  /* decimate the time series */
-  series->deltaT = dt;
-  series->data->length /= resampleFactor;
-  dataPtr = series->data->data;
-  for ( j = 0; j < series->data->length; ++j )
+  if ( ! XLALResizeREAL4Vector( series->data, outputLength ) && outputLength > 0 )
   {
-    series->data->data[j] = *dataPtr;
-    dataPtr += resampleFactor;
+    LALFree( output );
+    XLAL_ERROR( XLAL_EFUNC );
   }
-  series->data->data = LALRealloc( series->data->data,
-      series->data->length * sizeof( *series->data->data ) );
+  series->deltaT = dt;
+  for ( j = 0; j < outputLength; ++j )
+    series->data->data[j] = output[j];
+  LALFree( output );
 
   return 0;
 }
@@ -169,54 +470,238 @@ int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt )
 /** \see See \ref ResampleTimeSeries_c for documentation */
 int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt )
 {
-  const INT4 filterOrder = 20;
-  const REAL8 newNyquistAmplitude = 0.1;
-  REAL8 newNyquistFrequency;
-  UINT4 resampleFactor;
-  REAL8 *dataPtr = NULL;
-  UINT4 j;
+  REAL8 *output = NULL;
+  UINT4 outputLength = 0;
 
-  resampleFactor = floor( dt / series->deltaT + 0.5 );
-  newNyquistFrequency = 0.5 / dt;
+  XLAL_CHECK( series != NULL && series->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK( dt > 0 && series->deltaT > 0, XLAL_EINVAL );
 
-  /* check that the resampling factor is valid */
-  if ( resampleFactor < 1 ||
-      fabs( dt - resampleFactor * series->deltaT ) > 1e-3 * series->deltaT )
-    XLAL_ERROR( XLAL_EINVAL );
+  XLAL_CHECK( ResampleTSSeries( &output, &outputLength, series->data->data, series->data->length, series->deltaT, dt ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   /* just return if no resampling is required */
-  if ( resampleFactor == 1 )
+  if ( ! output )
   {
     XLALPrintInfo( "XLAL Info - %s: No resampling required", __func__ );
     return 0;
   }
 
-  /* check that we are resampling by a power of two */
-  if ( ! ( resampleFactor == 0x1 || resampleFactor == 0x2 ||
-        resampleFactor == 0x4 || resampleFactor == 0x8 ||
-        resampleFactor == 0x10 || resampleFactor == 0x20 ||
-        resampleFactor == 0x40 || resampleFactor == 0x80 ) )
-    XLAL_ERROR( XLAL_EINVAL );
-
-  if ( XLALLowPassREAL8TimeSeries( series, newNyquistFrequency,
-        newNyquistAmplitude, filterOrder ) < 0 )
-    XLAL_ERROR( XLAL_EFUNC );
-
-  /* decimate the time series */
-  series->deltaT = dt;
-  series->data->length /= resampleFactor;
-  dataPtr = series->data->data;
-  for ( j = 0; j < series->data->length; ++j )
+  if ( ! XLALResizeREAL8Vector( series->data, outputLength ) && outputLength > 0 )
   {
-    series->data->data[j] = *dataPtr;
-    dataPtr += resampleFactor;
+    LALFree( output );
+    XLAL_ERROR( XLAL_EFUNC );
   }
-  series->data->data = LALRealloc( series->data->data,
-      series->data->length * sizeof( *series->data->data ) );
+  series->deltaT = dt;
+  if ( outputLength > 0 )
+    memcpy( series->data->data, output, outputLength * sizeof( *output ) );
+  LALFree( output );
 
   return 0;
 }
 
+/** \see See \ref ResampleTimeSeries_c for documentation */
+ResampleTSState *XLALCreateResampleTSState( REAL8 deltaTIn, REAL8 deltaTOut )
+{
+  ResampleTSState *state = NULL;
+  UINT4 p, q;
+
+  XLAL_CHECK_NULL( deltaTIn > 0 && deltaTOut > 0, XLAL_EINVAL );
+  XLAL_CHECK_NULL( ResampleTSRatio( &p, &q, deltaTIn, deltaTOut ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  state = XLALCalloc( 1, sizeof( *state ) );
+  XLAL_CHECK_NULL( state != NULL, XLAL_ENOMEM );
+  state->deltaTIn = deltaTIn;
+  state->deltaTOut = deltaTOut;
+  state->design = ResampleTSAcquireDesign( p, q );
+  if ( !state->design ) {
+    XLALFree( state );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  XLALResetResampleTSState( state );
+
+  return state;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+void XLALDestroyResampleTSState( ResampleTSState *state )
+{
+  if ( state ) {
+    ResampleTSReleaseDesign( state->design );
+    XLALFree( state->buffer );
+    XLALFree( state );
+  }
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+void XLALResetResampleTSState( ResampleTSState *state )
+{
+  if ( state ) {
+    state->numIn = 0;
+    state->numOut = 0;
+    if ( state->buffer )
+      memset( state->buffer, 0, state->bufferLength * sizeof( *state->buffer ) );
+  }
+}
+
+/* Append a chunk of input, already copied to the end of the buffer, to
+   the stream, and compute up to maxOutput of the output samples which
+   it completes. */
+static REAL8TimeSeries *ResampleTSStateApply( ResampleTSState *state, UINT4 length, INT8 maxOutput )
+{
+  const ResampleTSDesign *design = state->design;
+  const UINT4 p = design->upFactor;
+  const UINT4 q = design->downFactor;
+  const UINT4 L = design->phaseLength;
+  const INT8 base = state->numIn - ( L - 1 );
+  const INT8 last = ( ( state->numIn + length ) * p - 1 - ( INT8 ) design->halfLength * p );
+  INT8 numOutput = ( last < 0 ) ? 0 : last / q + 1 - state->numOut;
+  REAL8TimeSeries *output;
+  LIGOTimeGPS epoch = state->epoch;
+
+  if ( numOutput > maxOutput )
+    numOutput = maxOutput;
+  if ( numOutput < 0 )
+    numOutput = 0;
+  XLALGPSAdd( &epoch, state->numOut * state->deltaTOut );
+  output = XLALCreateREAL8TimeSeries( state->name, &epoch, 0.0, state->deltaTOut, &state->sampleUnits, numOutput );
+  XLAL_CHECK_NULL( output != NULL, XLAL_EFUNC );
+
+  for ( INT8 k = 0; k < numOutput; ++k ) {
+    const UINT8 m = ( UINT8 )( state->numOut + k ) * q + ( UINT8 ) design->halfLength * p;
+    const INT8 lo = ( INT8 )( m / p ) - ( L - 1 ) - base;
+    output->data->data[k] = ResampleTSDot( design->taps + ( m % p ) * L, L, state->buffer, lo, L - 1 + length );
+  }
+
+  /* keep the last L - 1 input samples for the next chunk */
+  memmove( state->buffer, state->buffer + length, ( L - 1 ) * sizeof( *state->buffer ) );
+  state->numIn += length;
+  state->numOut += numOutput;
+
+  return output;
+}
+
+/* Check a new chunk of input, and make room for it in the buffer. */
+static int ResampleTSStatePrepare( ResampleTSState *state, const CHAR *name, const LIGOTimeGPS *epoch, REAL8 deltaT, const LALUnit *sampleUnits, UINT4 length )
+{
+  const UINT4 L = state->design->phaseLength;
+  XLAL_CHECK( fabs( deltaT - state->deltaTIn ) <= 1e-6 * state->deltaTIn, XLAL_EINVAL,
+              "Chunk sample interval %g differs from resampler input sample interval %g", deltaT, state->deltaTIn );
+  if ( state->numIn == 0 ) {
+    XLALStringCopy( state->name, name, sizeof( state->name ) );
+    state->sampleUnits = *sampleUnits;
+    state->epoch = *epoch;
+  } else {
+    LIGOTimeGPS expected = state->epoch;
+    XLALGPSAdd( &expected, state->numIn * state->deltaTIn );
+    XLAL_CHECK( fabs( XLALGPSDiff( epoch, &expected ) ) <= 0.5 * state->deltaTIn, XLAL_EINVAL,
+                "Chunk does not follow on from the previous chunk" );
+  }
+  if ( state->bufferLength < L - 1 + length ) {
+    REAL8 *buffer = XLALRealloc( state->buffer, ( L - 1 + length ) * sizeof( *buffer ) );
+    XLAL_CHECK( buffer != NULL, XLAL_ENOMEM );
+    if ( state->bufferLength == 0 )
+      memset( buffer, 0, ( L - 1 ) * sizeof( *buffer ) );
+    state->buffer = buffer;
+    state->bufferLength = L - 1 + length;
+  }
+  return XLAL_SUCCESS;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+REAL8TimeSeries *XLALResampleREAL8TimeSeriesChunk( ResampleTSState *state, const REAL8TimeSeries *chunk )
+{
+  REAL8TimeSeries *output;
+  XLAL_CHECK_NULL( state != NULL && chunk != NULL && chunk->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( ResampleTSStatePrepare( state, chunk->name, &chunk->epoch, chunk->deltaT, &chunk->sampleUnits, chunk->data->length ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( chunk->data->length > 0 )
+    memcpy( state->buffer + state->design->phaseLength - 1, chunk->data->data, chunk->data->length * sizeof( *state->buffer ) );
+  output = ResampleTSStateApply( state, chunk->data->length, LAL_INT8_MAX );
+  XLAL_CHECK_NULL( output != NULL, XLAL_EFUNC );
+  return output;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+REAL4TimeSeries *XLALResampleREAL4TimeSeriesChunk( ResampleTSState *state, const REAL4TimeSeries *chunk )
+{
+  REAL8TimeSeries *output;
+  REAL4TimeSeries *output4;
+  XLAL_CHECK_NULL( state != NULL && chunk != NULL && chunk->data != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( ResampleTSStatePrepare( state, chunk->name, &chunk->epoch, chunk->deltaT, &chunk->sampleUnits, chunk->data->length ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 j = 0; j < chunk->data->length; ++j )
+    state->buffer[state->design->phaseLength - 1 + j] = chunk->data->data[j];
+  output = ResampleTSStateApply( state, chunk->data->length, LAL_INT8_MAX );
+  XLAL_CHECK_NULL( output != NULL, XLAL_EFUNC );
+  output4 = XLALCreateREAL4TimeSeries( output->name, &output->epoch, 0.0, output->deltaT, &output->sampleUnits, output->data->length );
+  if ( !output4 ) {
+    XLALDestroyREAL8TimeSeries( output );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  for ( UINT4 j = 0; j < output->data->length; ++j )
+    output4->data->data[j] = output->data->data[j];
+  XLALDestroyREAL8TimeSeries( output );
+  return output4;
+}
+
+/* Complete the output stream up to the end of the input, treating
+   the input after its end as zero. */
+static REAL8TimeSeries *ResampleTSStateFlush( ResampleTSState *state )
+{
+  const ResampleTSDesign *design = state->design;
+  const UINT4 p = design->upFactor;
+  const UINT4 q = design->downFactor;
+  const INT8 endOutput = ( state->numIn * p + q - 1 ) / q;
+  REAL8TimeSeries *output;
+  UINT4 length = 0;
+
+  /* number of zeros needed to complete the last output sample */
+  if ( endOutput > state->numOut ) {
+    const INT8 last = ( ( endOutput - 1 ) * q + ( INT8 ) design->halfLength * p ) / p;
+    if ( last + 1 > state->numIn )
+      length = last + 1 - state->numIn;
+  }
+  if ( state->bufferLength < design->phaseLength - 1 + length ) {
+    REAL8 *buffer = XLALRealloc( state->buffer, ( design->phaseLength - 1 + length ) * sizeof( *buffer ) );
+    XLAL_CHECK_NULL( buffer != NULL, XLAL_ENOMEM );
+    if ( state->bufferLength == 0 )
+      memset( buffer, 0, ( design->phaseLength - 1 ) * sizeof( *buffer ) );
+    state->buffer = buffer;
+    state->bufferLength = design->phaseLength - 1 + length;
+  }
+  memset( state->buffer + design->phaseLength - 1, 0, length * sizeof( *state->buffer ) );
+  output = ResampleTSStateApply( state, length, endOutput - state->numOut );
+  XLAL_CHECK_NULL( output != NULL, XLAL_EFUNC );
+  XLALResetResampleTSState( state );
+  return output;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+REAL8TimeSeries *XLALResampleREAL8TimeSeriesFlush( ResampleTSState *state )
+{
+  REAL8TimeSeries *output;
+  XLAL_CHECK_NULL( state != NULL, XLAL_EFAULT );
+  output = ResampleTSStateFlush( state );
+  XLAL_CHECK_NULL( output != NULL, XLAL_EFUNC );
+  return output;
+}
+
+/** \see See \ref ResampleTimeSeries_c for documentation */
+REAL4TimeSeries *XLALResampleREAL4TimeSeriesFlush( ResampleTSState *state )
+{
+  REAL8TimeSeries *output;
+  REAL4TimeSeries *output4;
+  XLAL_CHECK_NULL( state != NULL, XLAL_EFAULT );
+  output = ResampleTSStateFlush( state );
+  XLAL_CHECK_NULL( output != NULL, XLAL_EFUNC );
+  output4 = XLALCreateREAL4TimeSeries( output->name, &output->epoch, 0.0, output->deltaT, &output->sampleUnits, output->data->length );
+  if ( !output4 ) {
+    XLALDestroyREAL8TimeSeries( output );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  for ( UINT4 j = 0; j < output->data->length; ++j )
+    output4->data->data[j] = output->data->data[j];
+  XLALDestroyREAL8TimeSeries( output );
+  return output4;
+}
+
 
 /**
  * \deprecated Use XLALResampleREAL4TimeSeries() instead.
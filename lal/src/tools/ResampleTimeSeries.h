@@ -36,7 +36,8 @@ extern "C" {
  *
  * \brief Provides routines to resample a time series.
  *
- * At present only integer downsampling of ::REAL4TimeSeries by a power of two is supported.
+ * Time series may be resampled by any ratio of (not too large) integers, either
+ * as a whole or chunk by chunk.
  *
  * ### Synopsis ###
  *
@@ -129,6 +130,12 @@ tagResampleTSParams
 }
 ResampleTSParams;
 
+/**
+ * Opaque structure which holds the state of a resampler, used to resample a
+ * time series chunk by chunk; see \ref ResampleTimeSeries_c.
+ */
+typedef struct tagResampleTSState ResampleTSState;
+
 /*@}*/
 
 /* ---------- Function prototypes ---------- */
@@ -136,6 +143,14 @@ ResampleTSParams;
 int XLALResampleREAL4TimeSeries( REAL4TimeSeries *series, REAL8 dt );
 int XLALResampleREAL8TimeSeries( REAL8TimeSeries *series, REAL8 dt );
 
+ResampleTSState *XLALCreateResampleTSState( REAL8 deltaTIn, REAL8 deltaTOut );
+void XLALDestroyResampleTSState( ResampleTSState *state );
+void XLALResetResampleTSState( ResampleTSState *state );
+REAL4TimeSeries *XLALResampleREAL4TimeSeriesChunk( ResampleTSState *state, const REAL4TimeSeries *chunk );
+REAL8TimeSeries *XLALResampleREAL8TimeSeriesChunk( ResampleTSState *state, const REAL8TimeSeries *chunk );
+REAL4TimeSeries *XLALResampleREAL4TimeSeriesFlush( ResampleTSState *state );
+REAL8TimeSeries *XLALResampleREAL8TimeSeriesFlush( ResampleTSState *state );
+
 void
 LALResampleREAL4TimeSeries(
     LALStatus          *status,
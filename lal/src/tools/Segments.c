@@ -37,7 +37,9 @@
  * The rest of the functions listed deal with <em>segment lists</em>:
  *
  * XLALSegListInit(), XLALSegListClear(), XLALSegListAppend(), XLALSegListSort()
- * XLALSegListCoalesce(), XLALSegListSearch()
+ * XLALSegListCoalesce(), XLALSegListSearch(), XLALSegListSearchMany(),
+ * XLALSegListUnion(), XLALSegListIntersection(), XLALSegListDifference(),
+ * XLALSegListComplement()
  *
  * ### Error codes and return values ###
  *
@@ -1150,3 +1152,341 @@ XLALSegListGet( LALSegList *seglist, UINT4 indx )
         return tmp;
 
 }  /* XLALSegListGet() */
+
+
+/*---------------------------------------------------------------------------*/
+
+/*
+ * Segments as integer nanoseconds, used internally by the set operations
+ * and batch searches below.
+ */
+typedef struct tagSegNS {
+  INT8 start;
+  INT8 end;
+  INT4 id;
+} SegNS;
+
+static int SegNSCmp( const void *p0, const void *p1 )
+{
+  const SegNS *s0 = p0;
+  const SegNS *s1 = p1;
+  if ( s0->start != s1->start )
+    return s0->start < s1->start ? -1 : 1;
+  if ( s0->end != s1->end )
+    return s0->end < s1->end ? -1 : 1;
+  return 0;
+}
+
+/*
+ * Convert a segment list into a sorted array of non-empty segments in which
+ * overlapping or touching segments have been joined. Each joined segment
+ * takes the id of its first segment, as with XLALSegListCoalesce(). The
+ * segment list itself is not modified.
+ */
+static SegNS *SegListToNS( const LALSegList *seglist, size_t *n )
+{
+  XLAL_CHECK_NULL( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure" );
+
+  SegNS *s = XLALMalloc( ( seglist->length > 0 ? seglist->length : 1 ) * sizeof( *s ) );
+  XLAL_CHECK_NULL( s != NULL, XLAL_ENOMEM );
+  for ( size_t i = 0; i < seglist->length; ++i ) {
+    s[i].start = XLALGPSToINT8NS( &seglist->segs[i].start );
+    s[i].end = XLALGPSToINT8NS( &seglist->segs[i].end );
+    s[i].id = seglist->segs[i].id;
+  }
+  if ( ! seglist->sorted ) {
+    qsort( s, seglist->length, sizeof( *s ), SegNSCmp );
+  }
+
+  /* join overlapping or touching segments, and discard empty segments */
+  size_t len = 0;
+  for ( size_t i = 0; i < seglist->length; ++i ) {
+    if ( len > 0 && s[i].start <= s[len - 1].end ) {
+      if ( s[len - 1].end < s[i].end ) {
+        s[len - 1].end = s[i].end;
+      }
+    } else if ( s[i].start < s[i].end ) {
+      s[len++] = s[i];
+    }
+  }
+
+  *n = len;
+  return s;
+}
+
+/* Append a segment in integer nanoseconds to a segment list */
+static int SegListAppendNS( LALSegList *seglist, INT8 start, INT8 end, INT4 id )
+{
+  LALSeg seg;
+  XLALINT8NSToGPS( &seg.start, start );
+  XLALINT8NSToGPS( &seg.end, end );
+  seg.id = id;
+  XLAL_CHECK( XLALSegListAppend( seglist, &seg ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/* Return a new segment list containing the segments of an array in integer nanoseconds */
+static LALSegList *SegListFromNS( const SegNS *s, size_t n )
+{
+  LALSegList *seglist = XLALSegListCreate();
+  XLAL_CHECK_NULL( seglist != NULL, XLAL_EFUNC );
+  for ( size_t i = 0; i < n; ++i ) {
+    if ( SegListAppendNS( seglist, s[i].start, s[i].end, s[i].id ) != XLAL_SUCCESS ) {
+      XLALSegListFree( seglist );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+  }
+  return seglist;
+}
+
+/* Set difference of two arrays of segments, as returned by SegListToNS() */
+static LALSegList *SegNSDifference( const SegNS *a, size_t na, const SegNS *b, size_t nb )
+{
+  LALSegList *seglist = XLALSegListCreate();
+  XLAL_CHECK_NULL( seglist != NULL, XLAL_EFUNC );
+  size_t j = 0;
+  for ( size_t i = 0; i < na; ++i ) {
+
+    /* skip segments of b which end before this segment of a */
+    while ( j < nb && b[j].end <= a[i].start ) {
+      ++j;
+    }
+
+    /* remove the segments of b which overlap this segment of a */
+    INT8 start = a[i].start;
+    for ( size_t k = j; k < nb && b[k].start < a[i].end; ++k ) {
+      if ( start < b[k].start && SegListAppendNS( seglist, start, b[k].start, a[i].id ) != XLAL_SUCCESS ) {
+        XLALSegListFree( seglist );
+        XLAL_ERROR_NULL( XLAL_EFUNC );
+      }
+      if ( start < b[k].end ) {
+        start = b[k].end;
+      }
+    }
+    if ( start < a[i].end && SegListAppendNS( seglist, start, a[i].end, a[i].id ) != XLAL_SUCCESS ) {
+      XLALSegListFree( seglist );
+      XLAL_ERROR_NULL( XLAL_EFUNC );
+    }
+
+  }
+  return seglist;
+}
+
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * \name Set operations on segment lists
+ *
+ * These functions treat a segment list as the set of times contained in
+ * its segments, and return a new segment list, which must be freed with
+ * XLALSegListFree(). The returned list is coalesced, i.e. it is sorted,
+ * disjoint, and has no touching or empty (zero-length) segments. The input
+ * lists need not be sorted or coalesced, and are not modified; the cost of
+ * each operation is linear in the total number of segments if the input
+ * lists are sorted, since the segments are then merged in a single pass.
+ *
+ * Each segment of the result of XLALSegListIntersection() and
+ * XLALSegListDifference() takes the \c id of the segment of the first list
+ * it lies in, after that list has been coalesced; each segment of the
+ * result of XLALSegListUnion() takes the \c id of the first segment joined
+ * to make it, as with XLALSegListCoalesce(); and the \c id of each segment
+ * of the result of XLALSegListComplement() is its index in the result.
+ */
+/*@{*/
+
+/** Return the union of two segment lists */
+LALSegList *
+XLALSegListUnion( const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  size_t na = 0, nb = 0;
+  SegNS *a = SegListToNS( seglist1, &na );
+  XLAL_CHECK_NULL( a != NULL, XLAL_EFUNC );
+  SegNS *b = SegListToNS( seglist2, &nb );
+  if ( b == NULL ) {
+    XLALFree( a );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  /* merge the two arrays into a third, joining segments as we go */
+  SegNS *u = XLALMalloc( ( na + nb > 0 ? na + nb : 1 ) * sizeof( *u ) );
+  size_t nu = 0;
+  if ( u != NULL ) {
+    size_t i = 0, j = 0;
+    while ( i < na || j < nb ) {
+      const SegNS *s = ( j == nb || ( i < na && SegNSCmp( &a[i], &b[j] ) <= 0 ) ) ? &a[i++] : &b[j++];
+      if ( nu > 0 && s->start <= u[nu - 1].end ) {
+        if ( u[nu - 1].end < s->end ) {
+          u[nu - 1].end = s->end;
+        }
+      } else {
+        u[nu++] = *s;
+      }
+    }
+  }
+  XLALFree( a );
+  XLALFree( b );
+  XLAL_CHECK_NULL( u != NULL, XLAL_ENOMEM );
+
+  LALSegList *result = SegListFromNS( u, nu );
+  XLALFree( u );
+  XLAL_CHECK_NULL( result != NULL, XLAL_EFUNC );
+  return result;
+}
+
+/** Return the intersection of two segment lists */
+LALSegList *
+XLALSegListIntersection( const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  size_t na = 0, nb = 0;
+  SegNS *a = SegListToNS( seglist1, &na );
+  XLAL_CHECK_NULL( a != NULL, XLAL_EFUNC );
+  SegNS *b = SegListToNS( seglist2, &nb );
+  if ( b == NULL ) {
+    XLALFree( a );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+
+  LALSegList *result = XLALSegListCreate();
+  if ( result != NULL ) {
+    size_t i = 0, j = 0;
+    while ( i < na && j < nb ) {
+      const INT8 start = ( a[i].start > b[j].start ) ? a[i].start : b[j].start;
+      const INT8 end = ( a[i].end < b[j].end ) ? a[i].end : b[j].end;
+      if ( start < end && SegListAppendNS( result, start, end, a[i].id ) != XLAL_SUCCESS ) {
+        XLALSegListFree( result );
+        result = NULL;
+        break;
+      }
+      /* advance past whichever segment ends first */
+      if ( a[i].end < b[j].end ) {
+        ++i;
+      } else {
+        ++j;
+      }
+    }
+  }
+  XLALFree( a );
+  XLALFree( b );
+  XLAL_CHECK_NULL( result != NULL, XLAL_EFUNC );
+  return result;
+}
+
+/** Return the times in the first segment list which are not in the second segment list */
+LALSegList *
+XLALSegListDifference( const LALSegList *seglist1, const LALSegList *seglist2 )
+{
+  size_t na = 0, nb = 0;
+  SegNS *a = SegListToNS( seglist1, &na );
+  XLAL_CHECK_NULL( a != NULL, XLAL_EFUNC );
+  SegNS *b = SegListToNS( seglist2, &nb );
+  if ( b == NULL ) {
+    XLALFree( a );
+    XLAL_ERROR_NULL( XLAL_EFUNC );
+  }
+  LALSegList *result = SegNSDifference( a, na, b, nb );
+  XLALFree( a );
+  XLALFree( b );
+  XLAL_CHECK_NULL( result != NULL, XLAL_EFUNC );
+  return result;
+}
+
+/** Return the times in the interval [\a start, \a end) which are not in a segment list */
+LALSegList *
+XLALSegListComplement( const LALSegList *seglist, const LIGOTimeGPS *start, const LIGOTimeGPS *end )
+{
+  XLAL_CHECK_NULL( start != NULL && end != NULL, XLAL_EFAULT );
+  XLAL_CHECK_NULL( XLALGPSCmp( start, end ) <= 0, XLAL_EDOM, "Invalid interval (%d.%09d > %d.%09d)",
+                   start->gpsSeconds, start->gpsNanoSeconds, end->gpsSeconds, end->gpsNanoSeconds );
+  size_t nb = 0;
+  SegNS *b = SegListToNS( seglist, &nb );
+  XLAL_CHECK_NULL( b != NULL, XLAL_EFUNC );
+  const SegNS a = { XLALGPSToINT8NS( start ), XLALGPSToINT8NS( end ), 0 };
+  LALSegList *result = SegNSDifference( &a, a.start < a.end ? 1 : 0, b, nb );
+  XLALFree( b );
+  XLAL_CHECK_NULL( result != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < result->length; ++i ) {
+    result->segs[i].id = i;
+  }
+  return result;
+}
+
+/*@}*/
+
+
+/*---------------------------------------------------------------------------*/
+
+/**
+ * The function XLALSegListSearchMany() determines which segment in the
+ * list, if any, contains each of an array of \a n GPS times, which is much
+ * faster than calling XLALSegListSearch() for each time, e.g. to veto many
+ * triggers. On return, <tt>indx[i]</tt> is the index in the segment list of
+ * the segment containing <tt>gps[i]</tt>, or -1 if there is no such segment.
+ * The segment list must be disjoint (e.g. coalesced with
+ * XLALSegListCoalesce()), so that each time is contained in at most one
+ * segment.
+ *
+ * The segment boundaries are converted to integer nanoseconds once, and each
+ * time is then located with a branch-free binary search; if the times are
+ * in ascending order, each search begins at the segment found for the
+ * previous time.
+ */
+int
+XLALSegListSearchMany( const LALSegList *seglist, const LIGOTimeGPS *gps, size_t n, INT4 *indx )
+{
+  XLAL_CHECK( seglist != NULL, XLAL_EFAULT );
+  XLAL_CHECK( seglist->initMagic == SEGMENTSH_INITMAGICVAL, XLAL_EINVAL, "Passed unintialized LALSegList structure" );
+  XLAL_CHECK( seglist->disjoint, XLAL_EINVAL, "Segment list must be disjoint" );
+  XLAL_CHECK( n == 0 || ( gps != NULL && indx != NULL ), XLAL_EFAULT );
+
+  const size_t m = seglist->length;
+  if ( m == 0 ) {
+    for ( size_t i = 0; i < n; ++i ) {
+      indx[i] = -1;
+    }
+    return XLAL_SUCCESS;
+  }
+
+  /* segment start and end times in nanoseconds, stored contiguously */
+  INT8 *starts = XLALMalloc( 2 * m * sizeof( *starts ) );
+  XLAL_CHECK( starts != NULL, XLAL_ENOMEM );
+  INT8 *ends = starts + m;
+  for ( size_t k = 0; k < m; ++k ) {
+    starts[k] = XLALGPSToINT8NS( &seglist->segs[k].start );
+    ends[k] = XLALGPSToINT8NS( &seglist->segs[k].end );
+  }
+
+  size_t first = 0;
+  INT8 tprev = starts[0];
+  for ( size_t i = 0; i < n; ++i ) {
+    const INT8 t = XLALGPSToINT8NS( &gps[i] );
+    if ( t < starts[0] ) {
+      indx[i] = -1;
+      first = 0;
+      tprev = t;
+      continue;
+    }
+
+    /* restart the search if the times are not ascending */
+    if ( t < tprev ) {
+      first = 0;
+    }
+    tprev = t;
+
+    /* find the last segment which starts at or before t */
+    const INT8 *base = starts + first;
+    size_t len = m - first;
+    while ( len > 1 ) {
+      const size_t half = len / 2;
+      base = ( base[half] <= t ) ? base + half : base;
+      len -= half;
+    }
+    first = base - starts;
+
+    indx[i] = ( t < ends[first] ) ? ( INT4 ) first : -1;
+  }
+
+  XLALFree( starts );
+  return XLAL_SUCCESS;
+}
@@ -131,6 +131,11 @@ extern "C" {
  *
  * Also all segments in a segment list can be time-shifted using \c XLALSegListShift().
  *
+ * Segment lists can be combined with the set operations XLALSegListUnion(),
+ * XLALSegListIntersection(), XLALSegListDifference() and
+ * XLALSegListComplement(), and many GPS times can be searched for at once
+ * with XLALSegListSearchMany().
+ *
  */
 /*@{*/
 
@@ -243,6 +248,12 @@ int XLALSegListIsInitialized ( const LALSegList *seglist );
 int XLALSegListInitSimpleSegments ( LALSegList *seglist, LIGOTimeGPS startTime, UINT4 Nseg, REAL8 Tseg );
 char *XLALSegList2String ( const LALSegList *seglist );
 
+LALSegList *XLALSegListUnion( const LALSegList *seglist1, const LALSegList *seglist2 );
+LALSegList *XLALSegListIntersection( const LALSegList *seglist1, const LALSegList *seglist2 );
+LALSegList *XLALSegListDifference( const LALSegList *seglist1, const LALSegList *seglist2 );
+LALSegList *XLALSegListComplement( const LALSegList *seglist, const LIGOTimeGPS *start, const LIGOTimeGPS *end );
+int XLALSegListSearchMany( const LALSegList *seglist, const LIGOTimeGPS *gps, size_t n, INT4 *indx );
+
 /*@}*/
 
 #if 0
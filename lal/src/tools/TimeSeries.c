@@ -21,6 +21,7 @@
 #include <complex.h>
 #include <math.h>
 #include <string.h>
+#include <lal/AVFactories.h>
 #include <lal/Date.h>
 #include <lal/LALDatatypes.h>
 #include <lal/LALStdlib.h>
@@ -83,6 +83,39 @@ UINT4TimeSeries *XLALCreateUINT4TimeSeries ( const CHAR *name, const LIGOTimeGPS
 UINT8TimeSeries *XLALCreateUINT8TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
 /*@}*/
 
+/**
+ * \name Creation Functions for Memory Arenas
+ *
+ * ### Synopsis ###
+ *
+ * \code
+ * #include <lal/TimeSeries.h>
+ *
+ * XLALArenaCreate<timeseriestype>()
+ * \endcode
+ *
+ * ### Description ###
+ *
+ * These functions create LAL time series from the memory arena which is active on
+ * the calling thread (see XLALPushMallocArena()), and fail if there is none.
+ * The series must not be destroyed, resized or shrunk; they are released when
+ * the arena is popped.
+ */
+/*@{*/
+#ifndef SWIG   /* exclude from SWIG interface */
+COMPLEX8TimeSeries *XLALArenaCreateCOMPLEX8TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+COMPLEX16TimeSeries *XLALArenaCreateCOMPLEX16TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+REAL4TimeSeries *XLALArenaCreateREAL4TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+REAL8TimeSeries *XLALArenaCreateREAL8TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+INT2TimeSeries *XLALArenaCreateINT2TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+INT4TimeSeries *XLALArenaCreateINT4TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+INT8TimeSeries *XLALArenaCreateINT8TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+UINT2TimeSeries *XLALArenaCreateUINT2TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+UINT4TimeSeries *XLALArenaCreateUINT4TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+UINT8TimeSeries *XLALArenaCreateUINT8TimeSeries ( const CHAR *name, const LIGOTimeGPS *epoch, REAL8 f0, REAL8 deltaT, const LALUnit *sampleUnits, size_t length );
+#endif   /* SWIG */
+/*@}*/
+
 /**
  * \name Destruction Functions
  *
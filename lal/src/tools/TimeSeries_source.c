@@ -9,6 +9,7 @@
 
 #define DSERIES CONCAT2(XLALDestroy,SERIESTYPE)
 #define CSERIES CONCAT2(XLALCreate,SERIESTYPE)
+#define ACSERIES CONCAT2(XLALArenaCreate,SERIESTYPE)
 #define XSERIES CONCAT2(XLALCut,SERIESTYPE)
 #define RSERIES CONCAT2(XLALResize,SERIESTYPE)
 #define SSERIES CONCAT2(XLALShrink,SERIESTYPE)
@@ -18,6 +19,7 @@
 #define CSEQUENCE CONCAT2(XLALCreate,SEQUENCETYPE)
 #define XSEQUENCE CONCAT2(XLALCut,SEQUENCETYPE)
 #define RSEQUENCE CONCAT2(XLALResize,SEQUENCETYPE)
+#define ACSEQUENCE CONCAT3(XLALArenaCreate,DATATYPE,Vector)
 
 void DSERIES (
 	SERIESTYPE *series
@@ -64,6 +66,42 @@ SERIESTYPE *CSERIES (
 }
 
 
+SERIESTYPE *ACSERIES (
+	const CHAR *name,
+	const LIGOTimeGPS *epoch,
+	REAL8 f0,
+	REAL8 deltaT,
+	const LALUnit *sampleUnits,
+	size_t length
+)
+{
+	SERIESTYPE *new;
+
+	if(XLALGetMallocArenaDepth() == 0)
+		XLAL_ERROR_NULL(XLAL_EFAILED, "No memory arena is active on this thread");
+	if(length > LAL_UINT4_MAX)
+		XLAL_ERROR_NULL(XLAL_EBADLEN);
+	new = XLALArenaMalloc(sizeof(*new));
+	if(!new)
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	new->data = ACSEQUENCE (length);
+	if(!new->data)
+		XLAL_ERROR_NULL(XLAL_EFUNC);	/* new is released with the arena */
+
+	if(name) {
+		strncpy(new->name, name, LALNameLength - 1);
+		new->name[LALNameLength - 1] = '\0';
+	} else
+		new->name[0] = '\0';
+	new->epoch = *epoch;
+	new->f0 = f0;
+	new->deltaT = deltaT;
+	new->sampleUnits = *sampleUnits;
+
+	return new;
+}
+
+
 SERIESTYPE *XSERIES (
 	const SERIESTYPE *series,
 	size_t first,
@@ -168,6 +206,7 @@ SERIESTYPE *ASERIES (
 
 #undef DSERIES
 #undef CSERIES
+#undef ACSERIES
 #undef XSERIES
 #undef RSERIES
 #undef SSERIES
@@ -178,3 +217,4 @@ SERIESTYPE *ASERIES (
 #undef CSEQUENCE
 #undef XSEQUENCE
 #undef RSEQUENCE
+#undef ACSEQUENCE
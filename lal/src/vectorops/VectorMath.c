@@ -201,4 +201,44 @@ EXPORT_VECTORMATH_cC2C(Shift, AVX2, AVX, SSE2, SSE)
   EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out, const REAL8 *in, const UINT4 len), (out, in, len), __VA_ARGS__ )
 
 EXPORT_VECTORMATH_D2D(Round, AVX2, AVX, NONE, NONE)
+EXPORT_VECTORMATH_D2D(Sin, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_D2D(Cos, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_D2D(Exp, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_D2D(Log, AVX2, AVX, SSE2, NONE)
 
+// ---------- define exported vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define EXPORT_VECTORMATH_D2DD(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len), (out1, out2, in, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_D2DD(SinCos, AVX2, AVX, SSE2, NONE)
+
+// ---------- define exported vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define EXPORT_VECTORMATH_ZZ2Z(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_ZZ2Z(Multiply, AVX2, AVX, SSE2, NONE)
+EXPORT_VECTORMATH_ZZ2Z(MultiplyConj, AVX2, AVX, SSE2, NONE)
+
+// ---------- define exported vector math functions with 1 COMPLEX16 scalar and 1 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (zZ2Z) ----------
+#define EXPORT_VECTORMATH_zZ2Z(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *out, COMPLEX16 scalar, const COMPLEX16 *in, const UINT4 len), (out, scalar, in, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_zZ2Z(Scale, AVX2, AVX, SSE2, NONE)
+
+// ---------- define exported vector math functions with 1 REAL8 vector input to 1 REAL8 scalar output (D2d) ----------
+#define EXPORT_VECTORMATH_D2d(NAME, ...)                                     \
+  EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out, const REAL8 *in, const UINT4 len), (out, in, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_D2d(Sum, AVX2, AVX, SSE2, NONE)
+
+// ---------- define exported vector math functions with 2 REAL8 vector inputs to 1 REAL8 scalar output (DD2d) ----------
+#define EXPORT_VECTORMATH_DD2d(NAME, ...)                                    \
+  EXPORT_VECTORMATH_ANY( NAME ## REAL8, (REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len), (out, in1, in2, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_DD2d(Dot, AVX2, AVX, SSE2, NONE)
+
+// ---------- define exported vector math functions with 2 COMPLEX16 vector and 1 REAL8 vector inputs to 1 COMPLEX16 scalar output (ZZD2z) ----------
+#define EXPORT_VECTORMATH_ZZD2z(NAME, ...)                                   \
+  EXPORT_VECTORMATH_ANY( NAME ## COMPLEX16, (COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const REAL8 *weights, const UINT4 len), (out, in1, in2, weights, len), __VA_ARGS__ )
+
+EXPORT_VECTORMATH_ZZD2z(WeightedInnerProduct, AVX2, AVX, SSE2, NONE)
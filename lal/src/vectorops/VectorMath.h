@@ -44,6 +44,12 @@ extern "C" {
  *
  * Neither input nor output vectors are \b required to have any particular memory alignment. Nevertheless, performance
  * \e may be improved if vectors are 16-byte aligned for SSE, and 32-byte aligned for AVX.
+ *
+ * ### Accuracy ###
+ *
+ * The SIMD implementations of the REAL8 transcendental functions agree with the C library functions to within a few
+ * units in the last place. The reduction operations accumulate several partial sums in parallel, and so may differ
+ * from a sequential sum by the usual floating-point rounding error.
  */
 /** @{ */
 
@@ -159,6 +165,21 @@ int XLALVectorSinCosREAL4 ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UIN
 /** Compute \f$\text{out1} = \sin(2\pi \text{in}), \text{out2} = \cos(2\pi \text{in})\f$ over REAL4 vectors \c out1, \c out2, \c in with \c len elements */
 int XLALVectorSinCos2PiREAL4 ( REAL4 *out1, REAL4 *out2, const REAL4 *in, const UINT4 len );
 
+/** Compute \f$\text{out} = \sin(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorSinREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = \cos(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorCosREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = \exp(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorExpREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out} = \log(\text{in})\f$ over REAL8 vectors \c out, \c in with \c len elements */
+int XLALVectorLogREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute \f$\text{out1} = \sin(\text{in}), \text{out2} = \cos(\text{in})\f$ over REAL8 vectors \c out1, \c out2, \c in with \c len elements */
+int XLALVectorSinCosREAL8 ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len );
+
 /** @} */
 
 /** \name Vector by Vector Operations */
@@ -194,6 +215,12 @@ int XLALVectorMultiplyCOMPLEX8 (  COMPLEX8 *out, const COMPLEX8 *in1, const COMP
 /** Compute \f$\text{out} = \text{in1} + \text{in2}\f$ over COMPLEX8 vectors \c in1 and \c in2 with \c len elements */
 int XLALVectorAddCOMPLEX8 ( COMPLEX8 *out, const COMPLEX8 *in1, const COMPLEX8 *in2, const UINT4 len);
 
+/** Compute \f$\text{out} = \text{in1} \times \text{in2}\f$ over COMPLEX16 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorMultiplyCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len );
+
+/** Compute \f$\text{out} = \text{in1} \times \text{in2}^*\f$ over COMPLEX16 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorMultiplyConjCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len );
+
 /** @} */
 
 /** \name Vector by Scalar Operations */
@@ -217,6 +244,23 @@ int XLALVectorScaleCOMPLEX8 ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in
 /** Compute \f$\text{out} = \text{scalar} + \text{in}\f$ over COMPLEX8 vector \c in with \c len elements */
 int XLALVectorShiftCOMPLEX8 ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, const UINT4 len);
 
+/** Compute \f$\text{out} = \text{scalar} \times \text{in}\f$ over COMPLEX16 vector \c in with \c len elements */
+int XLALVectorScaleCOMPLEX16 ( COMPLEX16 *out, COMPLEX16 scalar, const COMPLEX16 *in, const UINT4 len );
+
+/** @} */
+
+/** \name Vector Reduction Operations */
+/** @{ */
+
+/** Compute the scalar \f$\text{out} = \sum_i \text{in}_i\f$ over REAL8 vector \c in with \c len elements */
+int XLALVectorSumREAL8 ( REAL8 *out, const REAL8 *in, const UINT4 len );
+
+/** Compute the scalar \f$\text{out} = \sum_i \text{in1}_i \times \text{in2}_i\f$ over REAL8 vectors \c in1 and \c in2 with \c len elements */
+int XLALVectorDotREAL8 ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len );
+
+/** Compute the scalar \f$\text{out} = \sum_i \text{weights}_i \times \text{in1}_i^* \times \text{in2}_i\f$ over COMPLEX16 vectors \c in1 and \c in2 and REAL8 vector \c weights with \c len elements */
+int XLALVectorWeightedInnerProductCOMPLEX16 ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const REAL8 *weights, const UINT4 len );
+
 /** @} */
 
 /** \name Vector Element Finding Operations */
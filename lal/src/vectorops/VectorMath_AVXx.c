@@ -180,6 +180,230 @@ local_cmul_ps ( __m256 in1, __m256 in2 )
   return _mm256_permute_ps(in2, 0xd8);
 }
 
+// ---------- double-precision math functions ----------
+
+// pi/2 split into 3 parts, each with at most 33 significant bits (from fdlibm)
+#define PIO2_1 1.57079632673412561417e+00
+#define PIO2_2 6.07710050630396597660e-11
+#define PIO2_3 2.02226624871116645580e-21
+
+// ln(2) split into 2 parts, the first with at most 32 significant bits (from fdlibm)
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+
+// arguments of sin() and cos() above this magnitude are passed to the libm functions
+#define SINCOS_PD_MAX 1.0e6
+
+// combine two 128-bit integer vectors into a 256-bit double vector; uses only AVX instructions
+UNUSED static inline __m256d
+local_combine_pd ( __m128i lo, __m128i hi )
+{
+  return _mm256_castsi256_pd ( _mm256_insertf128_si256 ( _mm256_castsi128_si256 ( lo ), hi, 1 ) );
+}
+
+// 2^n for 4 integers -1022 <= n <= 1023
+UNUSED static inline __m256d
+local_pow2_pd ( __m128i n )
+{
+  const __m128i e = _mm_add_epi32 ( n, _mm_set1_epi32 ( 1023 ) );
+  const __m128i lo = _mm_slli_epi64 ( _mm_unpacklo_epi32 ( e, _mm_setzero_si128() ), 52 );
+  const __m128i hi = _mm_slli_epi64 ( _mm_unpackhi_epi32 ( e, _mm_setzero_si128() ), 52 );
+  return local_combine_pd ( lo, hi );
+}
+
+// sign bit set where bit 1 of the 32-bit integers in 'q2' is set; 'q2' must hold each integer twice
+UNUSED static inline __m128i
+local_sign_quadrant ( __m128i q2 )
+{
+  return _mm_slli_epi64 ( _mm_and_si128 ( q2, _mm_set1_epi64x ( 2 ) ), 62 );
+}
+
+UNUSED static inline void
+local_sincos_pd ( __m256d in, __m256d *s, __m256d *c )
+{
+
+  // reduce argument to y = in - q*pi/2, with |y| <= pi/4
+  const __m128i qi = _mm256_cvtpd_epi32 ( _mm256_mul_pd ( in, _mm256_set1_pd ( LAL_2_PI ) ) );
+  const __m256d q = _mm256_cvtepi32_pd ( qi );
+  __m256d y = _mm256_sub_pd ( in, _mm256_mul_pd ( q, _mm256_set1_pd ( PIO2_1 ) ) );
+  y = _mm256_sub_pd ( y, _mm256_mul_pd ( q, _mm256_set1_pd ( PIO2_2 ) ) );
+  y = _mm256_sub_pd ( y, _mm256_mul_pd ( q, _mm256_set1_pd ( PIO2_3 ) ) );
+  const __m256d z = _mm256_mul_pd ( y, y );
+
+  // minimax polynomials for sin(y) and cos(y) over |y| <= pi/4 (from fdlibm)
+  __m256d ps = _mm256_set1_pd ( 1.58969099521155010221e-10 );
+  ps = _mm256_add_pd ( _mm256_mul_pd ( ps, z ), _mm256_set1_pd ( -2.50507602534068634195e-08 ) );
+  ps = _mm256_add_pd ( _mm256_mul_pd ( ps, z ), _mm256_set1_pd ( 2.75573137070700676789e-06 ) );
+  ps = _mm256_add_pd ( _mm256_mul_pd ( ps, z ), _mm256_set1_pd ( -1.98412698298579493134e-04 ) );
+  ps = _mm256_add_pd ( _mm256_mul_pd ( ps, z ), _mm256_set1_pd ( 8.33333333332248946124e-03 ) );
+  ps = _mm256_add_pd ( _mm256_mul_pd ( ps, z ), _mm256_set1_pd ( -1.66666666666666324348e-01 ) );
+  const __m256d sy = _mm256_add_pd ( y, _mm256_mul_pd ( _mm256_mul_pd ( y, z ), ps ) );
+  __m256d pc = _mm256_set1_pd ( -1.13596475577881948265e-11 );
+  pc = _mm256_add_pd ( _mm256_mul_pd ( pc, z ), _mm256_set1_pd ( 2.08757232129817482790e-09 ) );
+  pc = _mm256_add_pd ( _mm256_mul_pd ( pc, z ), _mm256_set1_pd ( -2.75573143513906633035e-07 ) );
+  pc = _mm256_add_pd ( _mm256_mul_pd ( pc, z ), _mm256_set1_pd ( 2.48015872894767294178e-05 ) );
+  pc = _mm256_add_pd ( _mm256_mul_pd ( pc, z ), _mm256_set1_pd ( -1.38888888888741095749e-03 ) );
+  pc = _mm256_add_pd ( _mm256_mul_pd ( pc, z ), _mm256_set1_pd ( 4.16666666666666019037e-02 ) );
+  const __m256d cy = _mm256_add_pd ( _mm256_sub_pd ( _mm256_set1_pd ( 1.0 ), _mm256_mul_pd ( _mm256_set1_pd ( 0.5 ), z ) ), _mm256_mul_pd ( _mm256_mul_pd ( z, z ), pc ) );
+
+  // swap and negate sin(y) and cos(y) depending on the quadrant q mod 4
+  const __m128i one = _mm_set1_epi32 ( 1 );
+  const __m128i q2_lo = _mm_unpacklo_epi32 ( qi, qi );
+  const __m128i q2_hi = _mm_unpackhi_epi32 ( qi, qi );
+  const __m256d swap = local_combine_pd ( _mm_cmpeq_epi32 ( _mm_and_si128 ( q2_lo, one ), one ), _mm_cmpeq_epi32 ( _mm_and_si128 ( q2_hi, one ), one ) );
+  const __m256d sign_s = local_combine_pd ( local_sign_quadrant ( q2_lo ), local_sign_quadrant ( q2_hi ) );
+  const __m256d sign_c = local_combine_pd ( local_sign_quadrant ( _mm_add_epi32 ( q2_lo, one ) ), local_sign_quadrant ( _mm_add_epi32 ( q2_hi, one ) ) );
+  V4SD out_s, out_c;
+  out_s.v = _mm256_xor_pd ( _mm256_blendv_pd ( sy, cy, swap ), sign_s );
+  out_c.v = _mm256_xor_pd ( _mm256_blendv_pd ( cy, sy, swap ), sign_c );
+
+  // the argument reduction is not exact for large arguments
+  const __m256d big = _mm256_cmp_pd ( _mm256_andnot_pd ( _mm256_set1_pd ( -0.0 ), in ), _mm256_set1_pd ( SINCOS_PD_MAX ), _CMP_GT_OQ );
+  if ( _mm256_movemask_pd ( big ) ) {
+    V4SD x = { .v = in };
+    for ( int j = 0; j < 4; ++j ) {
+      if ( fabs ( x.f[j] ) > SINCOS_PD_MAX ) {
+        out_s.f[j] = sin ( x.f[j] );
+        out_c.f[j] = cos ( x.f[j] );
+      }
+    }
+  }
+
+  (*s) = out_s.v;
+  (*c) = out_c.v;
+
+}
+
+UNUSED static inline __m256d
+local_sin_pd ( __m256d in )
+{
+  __m256d s, c;
+  local_sincos_pd ( in, &s, &c );
+  return s;
+}
+
+UNUSED static inline __m256d
+local_cos_pd ( __m256d in )
+{
+  __m256d s, c;
+  local_sincos_pd ( in, &s, &c );
+  return c;
+}
+
+UNUSED static inline __m256d
+local_exp_pd ( __m256d in )
+{
+
+  // clamp argument to a range where 2^n below can be computed; exp() still over/underflows correctly
+  const __m256d x = _mm256_min_pd ( _mm256_max_pd ( in, _mm256_set1_pd ( -746.0 ) ), _mm256_set1_pd ( 710.0 ) );
+
+  // reduce argument to r = x - n*ln(2), with |r| <= ln(2)/2
+  const __m128i ni = _mm256_cvtpd_epi32 ( _mm256_mul_pd ( x, _mm256_set1_pd ( LAL_LOG2E ) ) );
+  const __m256d n = _mm256_cvtepi32_pd ( ni );
+  __m256d r = _mm256_sub_pd ( x, _mm256_mul_pd ( n, _mm256_set1_pd ( LN2_HI ) ) );
+  r = _mm256_sub_pd ( r, _mm256_mul_pd ( n, _mm256_set1_pd ( LN2_LO ) ) );
+
+  // Taylor series of exp(r) to order 13
+  __m256d p = _mm256_set1_pd ( 1.0 / 6227020800.0 );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 479001600.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 39916800.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 3628800.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 362880.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 40320.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 5040.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 720.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 120.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 24.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 / 6.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 0.5 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 ) );
+  p = _mm256_add_pd ( _mm256_mul_pd ( p, r ), _mm256_set1_pd ( 1.0 ) );
+
+  // multiply by 2^n in two steps, so that each factor is a normal number
+  const __m128i n1 = _mm_srai_epi32 ( ni, 1 );
+  const __m128i n2 = _mm_sub_epi32 ( ni, n1 );
+  p = _mm256_mul_pd ( _mm256_mul_pd ( p, local_pow2_pd ( n1 ) ), local_pow2_pd ( n2 ) );
+
+  // propagate NaNs
+  return _mm256_blendv_pd ( p, in, _mm256_cmp_pd ( in, in, _CMP_UNORD_Q ) );
+
+}
+
+UNUSED static inline __m256d
+local_log_pd ( __m256d in )
+{
+
+  // scale subnormal arguments into the normal range
+  const __m256d tiny = _mm256_cmp_pd ( in, _mm256_set1_pd ( LAL_REAL8_MIN ), _CMP_LT_OQ );
+  const __m256d x = _mm256_blendv_pd ( in, _mm256_mul_pd ( in, _mm256_set1_pd ( 18014398509481984.0 ) ), tiny );
+
+  // split argument into x = m * 2^e, with sqrt(1/2) <= m < sqrt(2)
+  const __m256i bits = _mm256_castpd_si256 ( x );
+  const __m128i e_lo = _mm_shuffle_epi32 ( _mm_srli_epi64 ( _mm256_castsi256_si128 ( bits ), 52 ), _MM_SHUFFLE(3,1,2,0) );
+  const __m128i e_hi = _mm_shuffle_epi32 ( _mm_srli_epi64 ( _mm256_extractf128_si256 ( bits, 1 ), 52 ), _MM_SHUFFLE(3,1,2,0) );
+  __m256d e = _mm256_sub_pd ( _mm256_cvtepi32_pd ( _mm_unpacklo_epi64 ( e_lo, e_hi ) ), _mm256_set1_pd ( 1022.0 ) );
+  e = _mm256_sub_pd ( e, _mm256_and_pd ( tiny, _mm256_set1_pd ( 54.0 ) ) );
+  const __m256d m = _mm256_or_pd ( _mm256_and_pd ( x, _mm256_castsi256_pd ( _mm256_set1_epi64x ( 0x000FFFFFFFFFFFFFLL ) ) ), _mm256_set1_pd ( 0.5 ) );
+  const __m256d lower = _mm256_cmp_pd ( m, _mm256_set1_pd ( LAL_SQRT1_2 ), _CMP_LT_OQ );
+  const __m256d f = _mm256_sub_pd ( _mm256_add_pd ( m, _mm256_and_pd ( lower, m ) ), _mm256_set1_pd ( 1.0 ) );
+  e = _mm256_sub_pd ( e, _mm256_and_pd ( lower, _mm256_set1_pd ( 1.0 ) ) );
+
+  // log(1 + f) = f - f^2/2 + s*(f^2/2 + R(s^2)), where s = f/(2 + f) (from fdlibm)
+  const __m256d s = _mm256_div_pd ( f, _mm256_add_pd ( _mm256_set1_pd ( 2.0 ), f ) );
+  const __m256d z = _mm256_mul_pd ( s, s );
+  __m256d R = _mm256_set1_pd ( 1.479819860511658591e-01 );
+  R = _mm256_add_pd ( _mm256_mul_pd ( R, z ), _mm256_set1_pd ( 1.531383769920937332e-01 ) );
+  R = _mm256_add_pd ( _mm256_mul_pd ( R, z ), _mm256_set1_pd ( 1.818357216161805012e-01 ) );
+  R = _mm256_add_pd ( _mm256_mul_pd ( R, z ), _mm256_set1_pd ( 2.222219843214978396e-01 ) );
+  R = _mm256_add_pd ( _mm256_mul_pd ( R, z ), _mm256_set1_pd ( 2.857142874366239149e-01 ) );
+  R = _mm256_add_pd ( _mm256_mul_pd ( R, z ), _mm256_set1_pd ( 3.999999999940941908e-01 ) );
+  R = _mm256_add_pd ( _mm256_mul_pd ( R, z ), _mm256_set1_pd ( 6.666666666666735130e-01 ) );
+  R = _mm256_mul_pd ( R, z );
+  const __m256d hfsq = _mm256_mul_pd ( _mm256_set1_pd ( 0.5 ), _mm256_mul_pd ( f, f ) );
+  __m256d out = _mm256_add_pd ( _mm256_mul_pd ( s, _mm256_add_pd ( hfsq, R ) ), _mm256_mul_pd ( e, _mm256_set1_pd ( LN2_LO ) ) );
+  out = _mm256_sub_pd ( _mm256_mul_pd ( e, _mm256_set1_pd ( LN2_HI ) ), _mm256_sub_pd ( _mm256_sub_pd ( hfsq, out ), f ) );
+
+  // special values: log(+inf) = +inf, log(x < 0) = log(NaN) = NaN, log(0) = -inf
+  out = _mm256_blendv_pd ( out, in, _mm256_cmp_pd ( in, _mm256_set1_pd ( INFINITY ), _CMP_EQ_OQ ) );
+  out = _mm256_blendv_pd ( out, _mm256_set1_pd ( NAN ), _mm256_cmp_pd ( in, _mm256_setzero_pd(), _CMP_NGE_UQ ) );
+  out = _mm256_blendv_pd ( out, _mm256_set1_pd ( -INFINITY ), _mm256_cmp_pd ( in, _mm256_setzero_pd(), _CMP_EQ_OQ ) );
+
+  return out;
+
+}
+
+UNUSED static inline __m256d
+local_identity_pd ( __m256d in )
+{
+  return in;
+}
+
+// in1: a0,b0,a1,b1, in2: c0,d0,c1,d1
+UNUSED static inline __m256d
+local_cmul_pd ( __m256d in1, __m256d in2 )
+{
+  // a0c0, a0d0, a1c1, a1d1
+  const __m256d temp1 = _mm256_mul_pd ( _mm256_movedup_pd ( in1 ), in2 );
+  // b0d0, b0c0, b1d1, b1c1
+  const __m256d temp2 = _mm256_mul_pd ( _mm256_permute_pd ( in1, 0xf ), _mm256_permute_pd ( in2, 0x5 ) );
+  // a0c0-b0d0, a0d0+b0c0, a1c1-b1d1, a1d1+b1c1
+  return _mm256_addsub_pd ( temp1, temp2 );
+}
+
+// in1: a0,b0,a1,b1, in2: c0,d0,c1,d1
+UNUSED static inline __m256d
+local_cmulconj_pd ( __m256d in1, __m256d in2 )
+{
+  return local_cmul_pd ( in1, _mm256_xor_pd ( in2, _mm256_setr_pd ( 0.0, -0.0, 0.0, -0.0 ) ) );
+}
+
+// in1: a0,b0,a1,b1, in2: c0,d0,c1,d1, in3: w0,w0,w1,w1
+UNUSED static inline __m256d
+local_cwdot_pd ( __m256d in1, __m256d in2, __m256d in3 )
+{
+  return _mm256_mul_pd ( in3, local_cmulconj_pd ( in2, in1 ) );
+}
+
 // ========== internal generic AVXx functions ==========
 
 // ---------- generic AVXx operator with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -464,6 +688,221 @@ XLALVectorMath_D2D_AVXx ( REAL8 *out, const REAL8 *in, const UINT4 len, __m256d
 
 } // XLALVectorMath_D2D_AVXx()
 
+// ---------- generic AVXx operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_AVXx ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*f)(__m256d, __m256d*, __m256d*) )
+{
+
+  // walk through vector in blocks of 4
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      __m256d in4p = _mm256_loadu_pd(&in[i4]);
+      __m256d out4p_1, out4p_2;
+      (*f) ( in4p, &out4p_1, &out4p_2 );
+      _mm256_storeu_pd(&out1[i4], out4p_1);
+      _mm256_storeu_pd(&out2[i4], out4p_2);
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V4SD in4 = {.f={0,0,0,0}}, out4_1, out4_2;
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    in4.f[j] = in[i];
+  }
+  (*f) ( in4.v, &out4_1.v, &out4_2.v );
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    out1[i] = out4_1.f[j];
+    out2[i] = out4_2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2DD_AVXx()
+
+// ---------- generic AVXx operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_AVXx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m256d (*op)(__m256d, __m256d) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m256d in4p_1 = _mm256_loadu_pd( (const REAL8*)&in1[i2] );
+      __m256d in4p_2 = _mm256_loadu_pd( (const REAL8*)&in2[i2] );
+      __m256d out4p = (*op) ( in4p_1, in4p_2 );
+      _mm256_storeu_pd( (REAL8*)&out[i2], out4p );
+    }
+
+  // deal with the remaining (<=1) term separately
+  V4SD in4_1 = {.f={0,0,0,0}};
+  V4SD in4_2 = {.f={0,0,0,0}};
+  V4SD out4;
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j+=2 )
+    {
+      in4_1.f[j]   = creal ( in1[i] );
+      in4_1.f[j+1] = cimag ( in1[i] );
+      in4_2.f[j]   = creal ( in2[i] );
+      in4_2.f[j+1] = cimag ( in2[i] );
+    }
+  out4.v = (*op) ( in4_1.v, in4_2.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j+=2 )
+    {
+      out[i] = crect( out4.f[j], out4.f[j+1] );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2Z_AVXx()
+
+// ---------- generic AVXx operator with 1 COMPLEX16 scalar and 1 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (zZ2Z) ----------
+static inline int
+XLALVectorMath_zZ2Z_AVXx ( COMPLEX16 *out, COMPLEX16 scalar, const COMPLEX16 *in, const UINT4 len, __m256d (*op)(__m256d, __m256d) )
+{
+  const V4SD scalar4 = {.f={creal(scalar),cimag(scalar),creal(scalar),cimag(scalar)}};
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m256d in4p = _mm256_loadu_pd( (const REAL8*)&in[i2] );
+      __m256d out4p = (*op) ( scalar4.v, in4p );
+      _mm256_storeu_pd( (REAL8*)&out[i2], out4p );
+    }
+
+  // deal with the remaining (<=1) term separately
+  V4SD in4 = {.f={0,0,0,0}};
+  V4SD out4;
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j+=2 )
+    {
+      in4.f[j]   = creal ( in[i] );
+      in4.f[j+1] = cimag ( in[i] );
+    }
+  out4.v = (*op) ( scalar4.v, in4.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j+=2 )
+    {
+      out[i] = crect( out4.f[j], out4.f[j+1] );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_zZ2Z_AVXx()
+
+// ---------- generic AVXx operator with 1 REAL8 vector input to 1 REAL8 scalar output (D2d) ----------
+static inline int
+XLALVectorMath_D2d_AVXx ( REAL8 *out, const REAL8 *in, const UINT4 len, __m256d (*f)(__m256d) )
+{
+  __m256d sum4p_1 = _mm256_setzero_pd(), sum4p_2 = _mm256_setzero_pd();
+
+  // walk through vector in blocks of 8, using 2 independent partial sums
+  UINT4 i8Max = len - ( len % 8 );
+  for ( UINT4 i8 = 0; i8 < i8Max; i8 += 8 )
+    {
+      sum4p_1 = _mm256_add_pd ( sum4p_1, (*f) ( _mm256_loadu_pd(&in[i8]) ) );
+      sum4p_2 = _mm256_add_pd ( sum4p_2, (*f) ( _mm256_loadu_pd(&in[i8+4]) ) );
+    }
+
+  // deal with the remaining (<=7) terms separately
+  V4SD in4_1 = {.f={0,0,0,0}}, in4_2 = {.f={0,0,0,0}};
+  for ( UINT4 i = i8Max,j=0; i < len; i ++, j++ ) {
+    if ( j < 4 ) {
+      in4_1.f[j] = in[i];
+    } else {
+      in4_2.f[j-4] = in[i];
+    }
+  }
+  sum4p_1 = _mm256_add_pd ( sum4p_1, (*f) ( in4_1.v ) );
+  sum4p_2 = _mm256_add_pd ( sum4p_2, (*f) ( in4_2.v ) );
+
+  // add up partial sums
+  V4SD sum4 = {.v = _mm256_add_pd ( sum4p_1, sum4p_2 )};
+  (*out) = ( sum4.f[0] + sum4.f[1] ) + ( sum4.f[2] + sum4.f[3] );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2d_AVXx()
+
+// ---------- generic AVXx operator with 2 REAL8 vector inputs to 1 REAL8 scalar output (DD2d) ----------
+static inline int
+XLALVectorMath_DD2d_AVXx ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len, __m256d (*op)(__m256d, __m256d) )
+{
+  __m256d sum4p_1 = _mm256_setzero_pd(), sum4p_2 = _mm256_setzero_pd();
+
+  // walk through vector in blocks of 8, using 2 independent partial sums
+  UINT4 i8Max = len - ( len % 8 );
+  for ( UINT4 i8 = 0; i8 < i8Max; i8 += 8 )
+    {
+      sum4p_1 = _mm256_add_pd ( sum4p_1, (*op) ( _mm256_loadu_pd(&in1[i8]), _mm256_loadu_pd(&in2[i8]) ) );
+      sum4p_2 = _mm256_add_pd ( sum4p_2, (*op) ( _mm256_loadu_pd(&in1[i8+4]), _mm256_loadu_pd(&in2[i8+4]) ) );
+    }
+
+  // deal with the remaining (<=7) terms separately
+  V4SD in4_11 = {.f={0,0,0,0}}, in4_12 = {.f={0,0,0,0}};
+  V4SD in4_21 = {.f={0,0,0,0}}, in4_22 = {.f={0,0,0,0}};
+  for ( UINT4 i = i8Max,j=0; i < len; i ++, j++ ) {
+    if ( j < 4 ) {
+      in4_11.f[j] = in1[i];
+      in4_21.f[j] = in2[i];
+    } else {
+      in4_12.f[j-4] = in1[i];
+      in4_22.f[j-4] = in2[i];
+    }
+  }
+  sum4p_1 = _mm256_add_pd ( sum4p_1, (*op) ( in4_11.v, in4_21.v ) );
+  sum4p_2 = _mm256_add_pd ( sum4p_2, (*op) ( in4_12.v, in4_22.v ) );
+
+  // add up partial sums
+  V4SD sum4 = {.v = _mm256_add_pd ( sum4p_1, sum4p_2 )};
+  (*out) = ( sum4.f[0] + sum4.f[1] ) + ( sum4.f[2] + sum4.f[3] );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_DD2d_AVXx()
+
+// ---------- generic AVXx operator with 2 COMPLEX16 vector and 1 REAL8 vector inputs to 1 COMPLEX16 scalar output (ZZD2z) ----------
+static inline int
+XLALVectorMath_ZZD2z_AVXx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const REAL8 *in3, const UINT4 len, __m256d (*op)(__m256d, __m256d, __m256d) )
+{
+  __m256d sum4p_1 = _mm256_setzero_pd(), sum4p_2 = _mm256_setzero_pd();
+
+  // walk through vector in blocks of 4, using 2 independent partial sums
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      const __m128d w2p_1 = _mm_loadu_pd(&in3[i4]);
+      const __m128d w2p_2 = _mm_loadu_pd(&in3[i4+2]);
+      const __m256d w4p_1 = _mm256_insertf128_pd ( _mm256_castpd128_pd256 ( _mm_unpacklo_pd ( w2p_1, w2p_1 ) ), _mm_unpackhi_pd ( w2p_1, w2p_1 ), 1 );
+      const __m256d w4p_2 = _mm256_insertf128_pd ( _mm256_castpd128_pd256 ( _mm_unpacklo_pd ( w2p_2, w2p_2 ) ), _mm_unpackhi_pd ( w2p_2, w2p_2 ), 1 );
+      sum4p_1 = _mm256_add_pd ( sum4p_1, (*op) ( _mm256_loadu_pd( (const REAL8*)&in1[i4] ), _mm256_loadu_pd( (const REAL8*)&in2[i4] ), w4p_1 ) );
+      sum4p_2 = _mm256_add_pd ( sum4p_2, (*op) ( _mm256_loadu_pd( (const REAL8*)&in1[i4+2] ), _mm256_loadu_pd( (const REAL8*)&in2[i4+2] ), w4p_2 ) );
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V4SD in4_11 = {.f={0,0,0,0}}, in4_12 = {.f={0,0,0,0}};
+  V4SD in4_21 = {.f={0,0,0,0}}, in4_22 = {.f={0,0,0,0}};
+  V4SD in4_31 = {.f={0,0,0,0}}, in4_32 = {.f={0,0,0,0}};
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j+=2 ) {
+    V4SD *in4_1 = ( j < 4 ) ? &in4_11 : &in4_12;
+    V4SD *in4_2 = ( j < 4 ) ? &in4_21 : &in4_22;
+    V4SD *in4_3 = ( j < 4 ) ? &in4_31 : &in4_32;
+    in4_1->f[j%4]   = creal ( in1[i] );
+    in4_1->f[j%4+1] = cimag ( in1[i] );
+    in4_2->f[j%4]   = creal ( in2[i] );
+    in4_2->f[j%4+1] = cimag ( in2[i] );
+    in4_3->f[j%4]   = in3[i];
+    in4_3->f[j%4+1] = in3[i];
+  }
+  sum4p_1 = _mm256_add_pd ( sum4p_1, (*op) ( in4_11.v, in4_21.v, in4_31.v ) );
+  sum4p_2 = _mm256_add_pd ( sum4p_2, (*op) ( in4_12.v, in4_22.v, in4_32.v ) );
+
+  // add up partial sums
+  V4SD sum4 = {.v = _mm256_add_pd ( sum4p_1, sum4p_2 )};
+  (*out) = crect( sum4.f[0] + sum4.f[2], sum4.f[1] + sum4.f[3] );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZD2z_AVXx()
+
 // ========== internal AVXx vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -534,3 +973,44 @@ DEFINE_VECTORMATH_cC2C(Shift, local_add_ps)
   DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_AVXx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX_OP ) )
 
 DEFINE_VECTORMATH_D2D(Round, local_round_pd)
+DEFINE_VECTORMATH_D2D(Sin, local_sin_pd)
+DEFINE_VECTORMATH_D2D(Cos, local_cos_pd)
+DEFINE_VECTORMATH_D2D(Exp, local_exp_pd)
+DEFINE_VECTORMATH_D2D(Log, local_log_pd)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_AVXx, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, local_sincos_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_AVXx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul_pd)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj_pd)
+
+// ---------- define vector math functions with 1 COMPLEX16 scalar and 1 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (zZ2Z) ----------
+#define DEFINE_VECTORMATH_zZ2Z(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_zZ2Z_AVXx, NAME ## COMPLEX16, ( COMPLEX16 *out, COMPLEX16 scalar, const COMPLEX16 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_zZ2Z(Scale, local_cmul_pd)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 scalar output (D2d) ----------
+#define DEFINE_VECTORMATH_D2d(NAME, AVX_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2d_AVXx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_D2d(Sum, local_identity_pd)
+
+// ---------- define vector math functions with 2 REAL8 vector inputs to 1 REAL8 scalar output (DD2d) ----------
+#define DEFINE_VECTORMATH_DD2d(NAME, AVX_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_DD2d_AVXx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_DD2d(Dot, local_mul_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector and 1 REAL8 vector inputs to 1 COMPLEX16 scalar output (ZZD2z) ----------
+#define DEFINE_VECTORMATH_ZZD2z(NAME, AVX_OP)                           \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZD2z_AVXx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const REAL8 *weights, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) && (weights != NULL) ), ( out, in1, in2, weights, len, AVX_OP ) )
+
+DEFINE_VECTORMATH_ZZD2z(WeightedInnerProduct, local_cwdot_pd)
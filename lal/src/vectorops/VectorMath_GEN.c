@@ -80,6 +80,30 @@ static inline REAL4 local_fmaxf ( REAL4 x, REAL4 y ) {
   return (x > y) ? x : y;
 }
 
+static inline void local_sincos(REAL8 in, REAL8 *out1, REAL8 *out2) {
+  *out1 = sin ( in );
+  *out2 = cos ( in );
+}
+
+static inline REAL8 local_identity ( REAL8 x ) {
+  return x;
+}
+
+static inline COMPLEX16 local_cmul ( COMPLEX16 x, COMPLEX16 y )
+{
+  return x * y;
+}
+
+static inline COMPLEX16 local_cmulconj ( COMPLEX16 x, COMPLEX16 y )
+{
+  return x * conj ( y );
+}
+
+static inline COMPLEX16 local_cwdot ( COMPLEX16 x, COMPLEX16 y, REAL8 w )
+{
+  return w * ( conj ( x ) * y );
+}
+
 // ========== internal generic functions ==========
 
 // ---------- generic operator with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -181,6 +205,78 @@ XLALVectorMath_D2D_GEN ( REAL8 *out, const REAL8 *in, const UINT4 len, REAL8 (*o
   return XLAL_SUCCESS;
 }
 
+// ---------- generic operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_GEN ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*op)(REAL8, REAL8*, REAL8*) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      (*op) ( in[i], &(out1[i]), &(out2[i]) );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_GEN ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, COMPLEX16 (*op)(COMPLEX16, COMPLEX16) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      out[i] = (*op) ( in1[i], in2[i] );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 1 COMPLEX16 scalar and 1 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (zZ2Z) ----------
+static inline int
+XLALVectorMath_zZ2Z_GEN ( COMPLEX16 *out, COMPLEX16 scalar, const COMPLEX16 *in, const UINT4 len, COMPLEX16 (*op)(COMPLEX16, COMPLEX16) )
+{
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      out[i] = (*op) ( scalar, in[i] );
+    }
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 1 REAL8 vector input to 1 REAL8 scalar output (D2d) ----------
+static inline int
+XLALVectorMath_D2d_GEN ( REAL8 *out, const REAL8 *in, const UINT4 len, REAL8 (*op)(REAL8) )
+{
+  REAL8 sum = 0;
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      sum += (*op) ( in[i] );
+    }
+  (*out) = sum;
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 2 REAL8 vector inputs to 1 REAL8 scalar output (DD2d) ----------
+static inline int
+XLALVectorMath_DD2d_GEN ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len, REAL8 (*op)(REAL8, REAL8) )
+{
+  REAL8 sum = 0;
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      sum += (*op) ( in1[i], in2[i] );
+    }
+  (*out) = sum;
+  return XLAL_SUCCESS;
+}
+
+// ---------- generic operator with 2 COMPLEX16 vector and 1 REAL8 vector inputs to 1 COMPLEX16 scalar output (ZZD2z) ----------
+static inline int
+XLALVectorMath_ZZD2z_GEN ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const REAL8 *in3, const UINT4 len, COMPLEX16 (*op)(COMPLEX16, COMPLEX16, REAL8) )
+{
+  COMPLEX16 sum = 0;
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      sum += (*op) ( in1[i], in2[i], in3[i] );
+    }
+  (*out) = sum;
+  return XLAL_SUCCESS;
+}
+
 // ========== internal vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -251,3 +347,44 @@ DEFINE_VECTORMATH_cC2C(Shift, local_caddf)
   DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_GEN, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, GEN_OP ) )
 
 DEFINE_VECTORMATH_D2D(Round, round)
+DEFINE_VECTORMATH_D2D(Sin, sin)
+DEFINE_VECTORMATH_D2D(Cos, cos)
+DEFINE_VECTORMATH_D2D(Exp, exp)
+DEFINE_VECTORMATH_D2D(Log, log)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_GEN, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, local_sincos)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_GEN, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj)
+
+// ---------- define vector math functions with 1 COMPLEX16 scalar and 1 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (zZ2Z) ----------
+#define DEFINE_VECTORMATH_zZ2Z(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_zZ2Z_GEN, NAME ## COMPLEX16, ( COMPLEX16 *out, COMPLEX16 scalar, const COMPLEX16 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_zZ2Z(Scale, local_cmul)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 scalar output (D2d) ----------
+#define DEFINE_VECTORMATH_D2d(NAME, GEN_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2d_GEN, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_D2d(Sum, local_identity)
+
+// ---------- define vector math functions with 2 REAL8 vector inputs to 1 REAL8 scalar output (DD2d) ----------
+#define DEFINE_VECTORMATH_DD2d(NAME, GEN_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_DD2d_GEN, NAME ## REAL8, ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_DD2d(Dot, local_mul)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector and 1 REAL8 vector inputs to 1 COMPLEX16 scalar output (ZZD2z) ----------
+#define DEFINE_VECTORMATH_ZZD2z(NAME, GEN_OP)                           \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZD2z_GEN, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const REAL8 *weights, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) && (weights != NULL) ), ( out, in1, in2, weights, len, GEN_OP ) )
+
+DEFINE_VECTORMATH_ZZD2z(WeightedInnerProduct, local_cwdot)
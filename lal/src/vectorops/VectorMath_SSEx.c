@@ -111,6 +111,223 @@ local_cmul_ps ( __m128 in1, __m128 in2 )
   return _mm_shuffle_ps(result, result,0b11011000);
 }
 
+#ifdef USE_SSE2
+
+// ---------- double-precision math functions ----------
+
+// pi/2 split into 3 parts, each with at most 33 significant bits (from fdlibm)
+#define PIO2_1 1.57079632673412561417e+00
+#define PIO2_2 6.07710050630396597660e-11
+#define PIO2_3 2.02226624871116645580e-21
+
+// ln(2) split into 2 parts, the first with at most 32 significant bits (from fdlibm)
+#define LN2_HI 6.93147180369123816490e-01
+#define LN2_LO 1.90821492927058770002e-10
+
+// arguments of sin() and cos() above this magnitude are passed to the libm functions
+#define SINCOS_PD_MAX 1.0e6
+
+// select elements of 'in1' where 'mask' is set, otherwise elements of 'in2'
+UNUSED static inline __m128d
+local_select_pd ( __m128d mask, __m128d in1, __m128d in2 )
+{
+  return _mm_or_pd ( _mm_and_pd ( mask, in1 ), _mm_andnot_pd ( mask, in2 ) );
+}
+
+// 2^n for integers -1022 <= n <= 1023 stored in the lower two 32-bit elements of 'n'
+UNUSED static inline __m128d
+local_pow2_pd ( __m128i n )
+{
+  __m128i e = _mm_add_epi32 ( n, _mm_set1_epi32 ( 1023 ) );
+  e = _mm_unpacklo_epi32 ( e, _mm_setzero_si128() );
+  return _mm_castsi128_pd ( _mm_slli_epi64 ( e, 52 ) );
+}
+
+UNUSED static inline void
+local_sincos_pd ( __m128d in, __m128d *s, __m128d *c )
+{
+
+  // reduce argument to y = in - q*pi/2, with |y| <= pi/4
+  const __m128i qi = _mm_cvtpd_epi32 ( _mm_mul_pd ( in, _mm_set1_pd ( LAL_2_PI ) ) );
+  const __m128d q = _mm_cvtepi32_pd ( qi );
+  __m128d y = _mm_sub_pd ( in, _mm_mul_pd ( q, _mm_set1_pd ( PIO2_1 ) ) );
+  y = _mm_sub_pd ( y, _mm_mul_pd ( q, _mm_set1_pd ( PIO2_2 ) ) );
+  y = _mm_sub_pd ( y, _mm_mul_pd ( q, _mm_set1_pd ( PIO2_3 ) ) );
+  const __m128d z = _mm_mul_pd ( y, y );
+
+  // minimax polynomials for sin(y) and cos(y) over |y| <= pi/4 (from fdlibm)
+  __m128d ps = _mm_set1_pd ( 1.58969099521155010221e-10 );
+  ps = _mm_add_pd ( _mm_mul_pd ( ps, z ), _mm_set1_pd ( -2.50507602534068634195e-08 ) );
+  ps = _mm_add_pd ( _mm_mul_pd ( ps, z ), _mm_set1_pd ( 2.75573137070700676789e-06 ) );
+  ps = _mm_add_pd ( _mm_mul_pd ( ps, z ), _mm_set1_pd ( -1.98412698298579493134e-04 ) );
+  ps = _mm_add_pd ( _mm_mul_pd ( ps, z ), _mm_set1_pd ( 8.33333333332248946124e-03 ) );
+  ps = _mm_add_pd ( _mm_mul_pd ( ps, z ), _mm_set1_pd ( -1.66666666666666324348e-01 ) );
+  const __m128d sy = _mm_add_pd ( y, _mm_mul_pd ( _mm_mul_pd ( y, z ), ps ) );
+  __m128d pc = _mm_set1_pd ( -1.13596475577881948265e-11 );
+  pc = _mm_add_pd ( _mm_mul_pd ( pc, z ), _mm_set1_pd ( 2.08757232129817482790e-09 ) );
+  pc = _mm_add_pd ( _mm_mul_pd ( pc, z ), _mm_set1_pd ( -2.75573143513906633035e-07 ) );
+  pc = _mm_add_pd ( _mm_mul_pd ( pc, z ), _mm_set1_pd ( 2.48015872894767294178e-05 ) );
+  pc = _mm_add_pd ( _mm_mul_pd ( pc, z ), _mm_set1_pd ( -1.38888888888741095749e-03 ) );
+  pc = _mm_add_pd ( _mm_mul_pd ( pc, z ), _mm_set1_pd ( 4.16666666666666019037e-02 ) );
+  const __m128d cy = _mm_add_pd ( _mm_sub_pd ( _mm_set1_pd ( 1.0 ), _mm_mul_pd ( _mm_set1_pd ( 0.5 ), z ) ), _mm_mul_pd ( _mm_mul_pd ( z, z ), pc ) );
+
+  // swap and negate sin(y) and cos(y) depending on the quadrant q mod 4
+  const __m128i q2 = _mm_unpacklo_epi32 ( qi, qi );
+  const __m128d swap = _mm_castsi128_pd ( _mm_cmpeq_epi32 ( _mm_and_si128 ( q2, _mm_set1_epi32 ( 1 ) ), _mm_set1_epi32 ( 1 ) ) );
+  const __m128d sign_s = _mm_castsi128_pd ( _mm_slli_epi64 ( _mm_and_si128 ( q2, _mm_set1_epi64x ( 2 ) ), 62 ) );
+  const __m128d sign_c = _mm_castsi128_pd ( _mm_slli_epi64 ( _mm_and_si128 ( _mm_add_epi32 ( q2, _mm_set1_epi32 ( 1 ) ), _mm_set1_epi64x ( 2 ) ), 62 ) );
+  V2SF out_s, out_c;
+  out_s.v = _mm_xor_pd ( local_select_pd ( swap, cy, sy ), sign_s );
+  out_c.v = _mm_xor_pd ( local_select_pd ( swap, sy, cy ), sign_c );
+
+  // the argument reduction is not exact for large arguments
+  const __m128d big = _mm_cmpgt_pd ( _mm_andnot_pd ( _mm_set1_pd ( -0.0 ), in ), _mm_set1_pd ( SINCOS_PD_MAX ) );
+  if ( _mm_movemask_pd ( big ) ) {
+    V2SF x = { .v = in };
+    for ( int j = 0; j < 2; ++j ) {
+      if ( fabs ( x.f[j] ) > SINCOS_PD_MAX ) {
+        out_s.f[j] = sin ( x.f[j] );
+        out_c.f[j] = cos ( x.f[j] );
+      }
+    }
+  }
+
+  (*s) = out_s.v;
+  (*c) = out_c.v;
+
+}
+
+UNUSED static inline __m128d
+local_sin_pd ( __m128d in )
+{
+  __m128d s, c;
+  local_sincos_pd ( in, &s, &c );
+  return s;
+}
+
+UNUSED static inline __m128d
+local_cos_pd ( __m128d in )
+{
+  __m128d s, c;
+  local_sincos_pd ( in, &s, &c );
+  return c;
+}
+
+UNUSED static inline __m128d
+local_exp_pd ( __m128d in )
+{
+
+  // clamp argument to a range where 2^n below can be computed; exp() still over/underflows correctly
+  const __m128d x = _mm_min_pd ( _mm_max_pd ( in, _mm_set1_pd ( -746.0 ) ), _mm_set1_pd ( 710.0 ) );
+
+  // reduce argument to r = x - n*ln(2), with |r| <= ln(2)/2
+  const __m128i ni = _mm_cvtpd_epi32 ( _mm_mul_pd ( x, _mm_set1_pd ( LAL_LOG2E ) ) );
+  const __m128d n = _mm_cvtepi32_pd ( ni );
+  __m128d r = _mm_sub_pd ( x, _mm_mul_pd ( n, _mm_set1_pd ( LN2_HI ) ) );
+  r = _mm_sub_pd ( r, _mm_mul_pd ( n, _mm_set1_pd ( LN2_LO ) ) );
+
+  // Taylor series of exp(r) to order 13
+  __m128d p = _mm_set1_pd ( 1.0 / 6227020800.0 );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 479001600.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 39916800.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 3628800.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 362880.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 40320.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 5040.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 720.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 120.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 24.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 / 6.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 0.5 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 ) );
+  p = _mm_add_pd ( _mm_mul_pd ( p, r ), _mm_set1_pd ( 1.0 ) );
+
+  // multiply by 2^n in two steps, so that each factor is a normal number
+  const __m128i n1 = _mm_srai_epi32 ( ni, 1 );
+  const __m128i n2 = _mm_sub_epi32 ( ni, n1 );
+  p = _mm_mul_pd ( _mm_mul_pd ( p, local_pow2_pd ( n1 ) ), local_pow2_pd ( n2 ) );
+
+  // propagate NaNs
+  return local_select_pd ( _mm_cmpunord_pd ( in, in ), in, p );
+
+}
+
+UNUSED static inline __m128d
+local_log_pd ( __m128d in )
+{
+
+  // scale subnormal arguments into the normal range
+  const __m128d tiny = _mm_cmplt_pd ( in, _mm_set1_pd ( LAL_REAL8_MIN ) );
+  const __m128d x = local_select_pd ( tiny, _mm_mul_pd ( in, _mm_set1_pd ( 18014398509481984.0 ) ), in );
+
+  // split argument into x = m * 2^e, with sqrt(1/2) <= m < sqrt(2)
+  __m128i ei = _mm_srli_epi64 ( _mm_castpd_si128 ( x ), 52 );
+  ei = _mm_shuffle_epi32 ( ei, _MM_SHUFFLE(3,1,2,0) );
+  __m128d e = _mm_sub_pd ( _mm_cvtepi32_pd ( ei ), _mm_set1_pd ( 1022.0 ) );
+  e = _mm_sub_pd ( e, _mm_and_pd ( tiny, _mm_set1_pd ( 54.0 ) ) );
+  const __m128d m = _mm_or_pd ( _mm_and_pd ( x, _mm_castsi128_pd ( _mm_set1_epi64x ( 0x000FFFFFFFFFFFFFLL ) ) ), _mm_set1_pd ( 0.5 ) );
+  const __m128d lower = _mm_cmplt_pd ( m, _mm_set1_pd ( LAL_SQRT1_2 ) );
+  const __m128d f = _mm_sub_pd ( _mm_add_pd ( m, _mm_and_pd ( lower, m ) ), _mm_set1_pd ( 1.0 ) );
+  e = _mm_sub_pd ( e, _mm_and_pd ( lower, _mm_set1_pd ( 1.0 ) ) );
+
+  // log(1 + f) = f - f^2/2 + s*(f^2/2 + R(s^2)), where s = f/(2 + f) (from fdlibm)
+  const __m128d s = _mm_div_pd ( f, _mm_add_pd ( _mm_set1_pd ( 2.0 ), f ) );
+  const __m128d z = _mm_mul_pd ( s, s );
+  __m128d R = _mm_set1_pd ( 1.479819860511658591e-01 );
+  R = _mm_add_pd ( _mm_mul_pd ( R, z ), _mm_set1_pd ( 1.531383769920937332e-01 ) );
+  R = _mm_add_pd ( _mm_mul_pd ( R, z ), _mm_set1_pd ( 1.818357216161805012e-01 ) );
+  R = _mm_add_pd ( _mm_mul_pd ( R, z ), _mm_set1_pd ( 2.222219843214978396e-01 ) );
+  R = _mm_add_pd ( _mm_mul_pd ( R, z ), _mm_set1_pd ( 2.857142874366239149e-01 ) );
+  R = _mm_add_pd ( _mm_mul_pd ( R, z ), _mm_set1_pd ( 3.999999999940941908e-01 ) );
+  R = _mm_add_pd ( _mm_mul_pd ( R, z ), _mm_set1_pd ( 6.666666666666735130e-01 ) );
+  R = _mm_mul_pd ( R, z );
+  const __m128d hfsq = _mm_mul_pd ( _mm_set1_pd ( 0.5 ), _mm_mul_pd ( f, f ) );
+  __m128d out = _mm_add_pd ( _mm_mul_pd ( s, _mm_add_pd ( hfsq, R ) ), _mm_mul_pd ( e, _mm_set1_pd ( LN2_LO ) ) );
+  out = _mm_sub_pd ( _mm_mul_pd ( e, _mm_set1_pd ( LN2_HI ) ), _mm_sub_pd ( _mm_sub_pd ( hfsq, out ), f ) );
+
+  // special values: log(+inf) = +inf, log(x < 0) = log(NaN) = NaN, log(0) = -inf
+  out = local_select_pd ( _mm_cmpeq_pd ( in, _mm_set1_pd ( INFINITY ) ), in, out );
+  out = local_select_pd ( _mm_cmpnge_pd ( in, _mm_setzero_pd() ), _mm_set1_pd ( NAN ), out );
+  out = local_select_pd ( _mm_cmpeq_pd ( in, _mm_setzero_pd() ), _mm_set1_pd ( -INFINITY ), out );
+
+  return out;
+
+}
+
+UNUSED static inline __m128d
+local_identity_pd ( __m128d in )
+{
+  return in;
+}
+
+// in1: a,b, in2: c,d
+UNUSED static inline __m128d
+local_cmul_pd ( __m128d in1, __m128d in2 )
+{
+  // a*c, a*d
+  const __m128d temp1 = _mm_mul_pd ( _mm_unpacklo_pd ( in1, in1 ), in2 );
+  // b*d, b*c
+  const __m128d temp2 = _mm_mul_pd ( _mm_unpackhi_pd ( in1, in1 ), _mm_shuffle_pd ( in2, in2, 0x1 ) );
+  // a*c - b*d, a*d + b*c
+  return _mm_add_pd ( temp1, _mm_xor_pd ( temp2, _mm_setr_pd ( -0.0, 0.0 ) ) );
+}
+
+// in1: a,b, in2: c,d
+UNUSED static inline __m128d
+local_cmulconj_pd ( __m128d in1, __m128d in2 )
+{
+  return local_cmul_pd ( in1, _mm_xor_pd ( in2, _mm_setr_pd ( 0.0, -0.0 ) ) );
+}
+
+// in1: a,b, in2: c,d, in3: w,w
+UNUSED static inline __m128d
+local_cwdot_pd ( __m128d in1, __m128d in2, __m128d in3 )
+{
+  return _mm_mul_pd ( in3, local_cmulconj_pd ( in2, in1 ) );
+}
+
+#endif // USE_SSE2
+
 // ========== internal generic SSEx functions ==========
 
 // ---------- generic SSEx operator with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -366,6 +583,203 @@ XLALVectorMath_cC2C_SSEx ( COMPLEX8 *out, COMPLEX8 scalar, const COMPLEX8 *in, c
 
 } // XLALVectorMath_cC2C_SSEx()
 
+#ifdef USE_SSE2
+
+// ---------- generic SSEx operator with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+static inline int
+XLALVectorMath_D2D_SSEx ( REAL8 *out, const REAL8 *in, const UINT4 len, __m128d (*f)(__m128d) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m128d in2p = _mm_loadu_pd(&in[i2]);
+      __m128d out2p = (*f)( in2p );
+      _mm_storeu_pd(&out[i2], out2p);
+    }
+
+  // deal with the remaining (<=1) terms separately
+  V2SF in2 = {.f={0,0}}, out2;
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    in2.f[j] = in[i];
+  }
+  out2.v = (*f)( in2.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    out[i] = out2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2D_SSEx()
+
+// ---------- generic SSEx operator with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+static inline int
+XLALVectorMath_D2DD_SSEx ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len, void (*f)(__m128d, __m128d*, __m128d*) )
+{
+
+  // walk through vector in blocks of 2
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      __m128d in2p = _mm_loadu_pd(&in[i2]);
+      __m128d out2p_1, out2p_2;
+      (*f) ( in2p, &out2p_1, &out2p_2 );
+      _mm_storeu_pd(&out1[i2], out2p_1);
+      _mm_storeu_pd(&out2[i2], out2p_2);
+    }
+
+  // deal with the remaining (<=1) terms separately
+  V2SF in2 = {.f={0,0}}, out2_1, out2_2;
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    in2.f[j] = in[i];
+  }
+  (*f) ( in2.v, &out2_1.v, &out2_2.v );
+  for ( UINT4 i = i2Max,j=0; i < len; i ++, j++ ) {
+    out1[i] = out2_1.f[j];
+    out2[i] = out2_2.f[j];
+  }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2DD_SSEx()
+
+// ---------- generic SSEx operator with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+static inline int
+XLALVectorMath_ZZ2Z_SSEx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len, __m128d (*op)(__m128d, __m128d) )
+{
+
+  // walk through vector one element at a time
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      __m128d in2p_1 = _mm_loadu_pd( (const REAL8*)&in1[i] );
+      __m128d in2p_2 = _mm_loadu_pd( (const REAL8*)&in2[i] );
+      __m128d out2p = (*op) ( in2p_1, in2p_2 );
+      _mm_storeu_pd( (REAL8*)&out[i], out2p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZ2Z_SSEx()
+
+// ---------- generic SSEx operator with 1 COMPLEX16 scalar and 1 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (zZ2Z) ----------
+static inline int
+XLALVectorMath_zZ2Z_SSEx ( COMPLEX16 *out, COMPLEX16 scalar, const COMPLEX16 *in, const UINT4 len, __m128d (*op)(__m128d, __m128d) )
+{
+  const V2SF scalar2 = {.f={creal(scalar),cimag(scalar)}};
+
+  // walk through vector one element at a time
+  for ( UINT4 i = 0; i < len; i ++ )
+    {
+      __m128d in2p = _mm_loadu_pd( (const REAL8*)&in[i] );
+      __m128d out2p = (*op) ( scalar2.v, in2p );
+      _mm_storeu_pd( (REAL8*)&out[i], out2p );
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_zZ2Z_SSEx()
+
+// ---------- generic SSEx operator with 1 REAL8 vector input to 1 REAL8 scalar output (D2d) ----------
+static inline int
+XLALVectorMath_D2d_SSEx ( REAL8 *out, const REAL8 *in, const UINT4 len, __m128d (*f)(__m128d) )
+{
+  __m128d sum2p_1 = _mm_setzero_pd(), sum2p_2 = _mm_setzero_pd();
+
+  // walk through vector in blocks of 4, using 2 independent partial sums
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      sum2p_1 = _mm_add_pd ( sum2p_1, (*f) ( _mm_loadu_pd(&in[i4]) ) );
+      sum2p_2 = _mm_add_pd ( sum2p_2, (*f) ( _mm_loadu_pd(&in[i4+2]) ) );
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V2SF in2_1 = {.f={0,0}}, in2_2 = {.f={0,0}};
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    if ( j < 2 ) {
+      in2_1.f[j] = in[i];
+    } else {
+      in2_2.f[j-2] = in[i];
+    }
+  }
+  sum2p_1 = _mm_add_pd ( sum2p_1, (*f) ( in2_1.v ) );
+  sum2p_2 = _mm_add_pd ( sum2p_2, (*f) ( in2_2.v ) );
+
+  // add up partial sums
+  V2SF sum2 = {.v = _mm_add_pd ( sum2p_1, sum2p_2 )};
+  (*out) = sum2.f[0] + sum2.f[1];
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_D2d_SSEx()
+
+// ---------- generic SSEx operator with 2 REAL8 vector inputs to 1 REAL8 scalar output (DD2d) ----------
+static inline int
+XLALVectorMath_DD2d_SSEx ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len, __m128d (*op)(__m128d, __m128d) )
+{
+  __m128d sum2p_1 = _mm_setzero_pd(), sum2p_2 = _mm_setzero_pd();
+
+  // walk through vector in blocks of 4, using 2 independent partial sums
+  UINT4 i4Max = len - ( len % 4 );
+  for ( UINT4 i4 = 0; i4 < i4Max; i4 += 4 )
+    {
+      sum2p_1 = _mm_add_pd ( sum2p_1, (*op) ( _mm_loadu_pd(&in1[i4]), _mm_loadu_pd(&in2[i4]) ) );
+      sum2p_2 = _mm_add_pd ( sum2p_2, (*op) ( _mm_loadu_pd(&in1[i4+2]), _mm_loadu_pd(&in2[i4+2]) ) );
+    }
+
+  // deal with the remaining (<=3) terms separately
+  V2SF in2_11 = {.f={0,0}}, in2_12 = {.f={0,0}};
+  V2SF in2_21 = {.f={0,0}}, in2_22 = {.f={0,0}};
+  for ( UINT4 i = i4Max,j=0; i < len; i ++, j++ ) {
+    if ( j < 2 ) {
+      in2_11.f[j] = in1[i];
+      in2_21.f[j] = in2[i];
+    } else {
+      in2_12.f[j-2] = in1[i];
+      in2_22.f[j-2] = in2[i];
+    }
+  }
+  sum2p_1 = _mm_add_pd ( sum2p_1, (*op) ( in2_11.v, in2_21.v ) );
+  sum2p_2 = _mm_add_pd ( sum2p_2, (*op) ( in2_12.v, in2_22.v ) );
+
+  // add up partial sums
+  V2SF sum2 = {.v = _mm_add_pd ( sum2p_1, sum2p_2 )};
+  (*out) = sum2.f[0] + sum2.f[1];
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_DD2d_SSEx()
+
+// ---------- generic SSEx operator with 2 COMPLEX16 vector and 1 REAL8 vector inputs to 1 COMPLEX16 scalar output (ZZD2z) ----------
+static inline int
+XLALVectorMath_ZZD2z_SSEx ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const REAL8 *in3, const UINT4 len, __m128d (*op)(__m128d, __m128d, __m128d) )
+{
+  __m128d sum2p_1 = _mm_setzero_pd(), sum2p_2 = _mm_setzero_pd();
+
+  // walk through vector in blocks of 2, using 2 independent partial sums
+  UINT4 i2Max = len - ( len % 2 );
+  for ( UINT4 i2 = 0; i2 < i2Max; i2 += 2 )
+    {
+      sum2p_1 = _mm_add_pd ( sum2p_1, (*op) ( _mm_loadu_pd( (const REAL8*)&in1[i2] ), _mm_loadu_pd( (const REAL8*)&in2[i2] ), _mm_set1_pd( in3[i2] ) ) );
+      sum2p_2 = _mm_add_pd ( sum2p_2, (*op) ( _mm_loadu_pd( (const REAL8*)&in1[i2+1] ), _mm_loadu_pd( (const REAL8*)&in2[i2+1] ), _mm_set1_pd( in3[i2+1] ) ) );
+    }
+
+  // deal with the remaining (<=1) term separately
+  for ( UINT4 i = i2Max; i < len; i ++ ) {
+    sum2p_1 = _mm_add_pd ( sum2p_1, (*op) ( _mm_loadu_pd( (const REAL8*)&in1[i] ), _mm_loadu_pd( (const REAL8*)&in2[i] ), _mm_set1_pd( in3[i] ) ) );
+  }
+
+  // add up partial sums
+  V2SF sum2 = {.v = _mm_add_pd ( sum2p_1, sum2p_2 )};
+  (*out) = crect( sum2.f[0], sum2.f[1] );
+
+  return XLAL_SUCCESS;
+
+} // XLALVectorMath_ZZD2z_SSEx()
+
+#endif // USE_SSE2
+
 // ========== internal SSEx vector math functions ==========
 
 // ---------- define vector math functions with 1 REAL4 vector input to 1 REAL4 vector output (S2S) ----------
@@ -428,3 +842,53 @@ DEFINE_VECTORMATH_CC2C(Add, local_add_ps)
 
 DEFINE_VECTORMATH_cC2C(Scale, local_cmul_ps)
 DEFINE_VECTORMATH_cC2C(Shift, local_add_ps)
+
+#ifdef USE_SSE2
+
+// ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 vector output (D2D) ----------
+#define DEFINE_VECTORMATH_D2D(NAME, SSE_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2D_SSEx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_D2D(Sin, local_sin_pd)
+DEFINE_VECTORMATH_D2D(Cos, local_cos_pd)
+DEFINE_VECTORMATH_D2D(Exp, local_exp_pd)
+DEFINE_VECTORMATH_D2D(Log, local_log_pd)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 2 REAL8 vector outputs (D2DD) ----------
+#define DEFINE_VECTORMATH_D2DD(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2DD_SSEx, NAME ## REAL8, ( REAL8 *out1, REAL8 *out2, const REAL8 *in, const UINT4 len ), ( (out1 != NULL) && (out2 != NULL) && (in != NULL) ), ( out1, out2, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_D2DD(SinCos, local_sincos_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define DEFINE_VECTORMATH_ZZ2Z(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZ2Z_SSEx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_ZZ2Z(Multiply, local_cmul_pd)
+DEFINE_VECTORMATH_ZZ2Z(MultiplyConj, local_cmulconj_pd)
+
+// ---------- define vector math functions with 1 COMPLEX16 scalar and 1 COMPLEX16 vector inputs to 1 COMPLEX16 vector output (zZ2Z) ----------
+#define DEFINE_VECTORMATH_zZ2Z(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_zZ2Z_SSEx, NAME ## COMPLEX16, ( COMPLEX16 *out, COMPLEX16 scalar, const COMPLEX16 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, scalar, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_zZ2Z(Scale, local_cmul_pd)
+
+// ---------- define vector math functions with 1 REAL8 vector input to 1 REAL8 scalar output (D2d) ----------
+#define DEFINE_VECTORMATH_D2d(NAME, SSE_OP)                             \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_D2d_SSEx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in, const UINT4 len ), ( (out != NULL) && (in != NULL) ), ( out, in, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_D2d(Sum, local_identity_pd)
+
+// ---------- define vector math functions with 2 REAL8 vector inputs to 1 REAL8 scalar output (DD2d) ----------
+#define DEFINE_VECTORMATH_DD2d(NAME, SSE_OP)                            \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_DD2d_SSEx, NAME ## REAL8, ( REAL8 *out, const REAL8 *in1, const REAL8 *in2, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) ), ( out, in1, in2, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_DD2d(Dot, local_mul_pd)
+
+// ---------- define vector math functions with 2 COMPLEX16 vector and 1 REAL8 vector inputs to 1 COMPLEX16 scalar output (ZZD2z) ----------
+#define DEFINE_VECTORMATH_ZZD2z(NAME, SSE_OP)                           \
+  DEFINE_VECTORMATH_ANY( XLALVectorMath_ZZD2z_SSEx, NAME ## COMPLEX16, ( COMPLEX16 *out, const COMPLEX16 *in1, const COMPLEX16 *in2, const REAL8 *weights, const UINT4 len ), ( (out != NULL) && (in1 != NULL) && (in2 != NULL) && (weights != NULL) ), ( out, in1, in2, weights, len, SSE_OP ) )
+
+DEFINE_VECTORMATH_ZZD2z(WeightedInnerProduct, local_cwdot_pd)
+
+#endif // USE_SSE2
@@ -81,6 +81,27 @@ TestStatus( LALStatus *status, const char *expectedCodes, int exitCode );
 static void
 CheckErrorCodes( void );
 
+/* rounds a pointer up to a multiple of TEST_ALIGNMENT bytes, which is more
+ * than the alignment required by any of the SIMD routines of FFTW */
+#define TEST_ALIGNMENT 64
+#define TEST_ALIGN(ptr) ((void *)(((size_t)(ptr) + TEST_ALIGNMENT - 1) & ~(size_t)(TEST_ALIGNMENT - 1)))
+
+#define COMPLEX_TYPE COMPLEX8
+#define REAL_TYPE REAL4
+#define TOLERANCE 1e-4
+#include "ComplexFFTTest_source.c"
+#undef COMPLEX_TYPE
+#undef REAL_TYPE
+#undef TOLERANCE
+
+#define COMPLEX_TYPE COMPLEX16
+#define REAL_TYPE REAL8
+#define TOLERANCE 1e-10
+#include "ComplexFFTTest_source.c"
+#undef COMPLEX_TYPE
+#undef REAL_TYPE
+#undef TOLERANCE
+
 int
 main( int argc, char *argv[] )
 {
@@ -182,6 +203,24 @@ main( int argc, char *argv[] )
   LALCDestroyVector( &status, &avec );
   TestStatus( &status, CODES( 0 ), 1 );
 
+  /*
+   *
+   * Check transforms of sequences of vectors, both aligned and misaligned
+   * by half an element.
+   *
+   */
+  for ( i = 0; i < 2; ++i )
+  {
+    if ( TestCOMPLEX8SequenceFFT( 1, 1, i ) || TestCOMPLEX8SequenceFFT( 15, 3, i ) || TestCOMPLEX8SequenceFFT( 256, 7, i ) )
+    {
+      return 1;
+    }
+    if ( TestCOMPLEX16SequenceFFT( 1, 1, i ) || TestCOMPLEX16SequenceFFT( 15, 3, i ) || TestCOMPLEX16SequenceFFT( 256, 7, i ) )
+    {
+      return 1;
+    }
+  }
+
   fp ? fprintf( fp, "\nChecking error codes:\n\n" ) : 0;
   CheckErrorCodes();
 
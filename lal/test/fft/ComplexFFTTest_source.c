@@ -0,0 +1,145 @@
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define CONCAT3x(a,b,c) a##b##c
+#define CONCAT3(a,b,c) CONCAT3x(a,b,c)
+
+#define PLAN_TYPE		CONCAT2(COMPLEX_TYPE,FFTPlan)
+#define VECTOR_TYPE		CONCAT2(COMPLEX_TYPE,Vector)
+#define SEQUENCE_TYPE		CONCAT2(COMPLEX_TYPE,VectorSequence)
+
+#define CREATE_PLAN_MANY	CONCAT3(XLALCreate,PLAN_TYPE,Many)
+#define DESTROY_PLAN		CONCAT2(XLALDestroy,PLAN_TYPE)
+#define CREATE_VECTOR		CONCAT2(XLALCreate,VECTOR_TYPE)
+#define DESTROY_VECTOR		CONCAT2(XLALDestroy,VECTOR_TYPE)
+#define VECTOR_FFT		CONCAT3(XLAL,VECTOR_TYPE,FFT)
+#define SEQUENCE_FFT		CONCAT3(XLAL,SEQUENCE_TYPE,FFT)
+
+#define FUNC CONCAT3(Test,COMPLEX_TYPE,SequenceFFT)
+
+/*
+ * Compares forward and reverse transforms of a sequence of howmany vectors
+ * of length n, performed with a plan for sequences, with the transforms of
+ * each vector in turn.  The sequences start shift real elements (that is,
+ * half complex elements) past a multiple of TEST_ALIGNMENT bytes: with
+ * shift = 0 the plan for sequences transforms the whole sequence at once,
+ * otherwise the vectors are transformed one at a time.  Returns non-zero on
+ * failure.
+ */
+static int
+FUNC( UINT4 n, UINT4 howmany, UINT4 shift )
+{
+  PLAN_TYPE     *fwd;
+  PLAN_TYPE     *rev;
+  REAL_TYPE     *datbuf;
+  REAL_TYPE     *fftbuf;
+  REAL_TYPE     *ansbuf;
+  SEQUENCE_TYPE  dat;
+  SEQUENCE_TYPE  fft;
+  SEQUENCE_TYPE  ans;
+  VECTOR_TYPE   *vdat;
+  VECTOR_TYPE   *vfft;
+  UINT4          i;
+  UINT4          j;
+
+  fwd    = CREATE_PLAN_MANY( n, howmany, 1, 0, 2 );
+  rev    = CREATE_PLAN_MANY( n, howmany, 0, 0, 2 );
+  datbuf = XLALMalloc( ( 2 * howmany * n + shift ) * sizeof( *datbuf ) + TEST_ALIGNMENT );
+  fftbuf = XLALMalloc( ( 2 * howmany * n + shift ) * sizeof( *fftbuf ) + TEST_ALIGNMENT );
+  ansbuf = XLALMalloc( ( 2 * howmany * n + shift ) * sizeof( *ansbuf ) + TEST_ALIGNMENT );
+  vdat   = CREATE_VECTOR( n );
+  vfft   = CREATE_VECTOR( n );
+  if ( ! fwd || ! rev || ! datbuf || ! fftbuf || ! ansbuf || ! vdat || ! vfft )
+  {
+    fputs( "FAIL: Could not create sequence FFT plans or data\n", stderr );
+    return 1;
+  }
+
+  dat.length = fft.length = ans.length = howmany;
+  dat.vectorLength = fft.vectorLength = ans.vectorLength = n;
+  dat.data = (COMPLEX_TYPE *)( (REAL_TYPE *)TEST_ALIGN( datbuf ) + shift );
+  fft.data = (COMPLEX_TYPE *)( (REAL_TYPE *)TEST_ALIGN( fftbuf ) + shift );
+  ans.data = (COMPLEX_TYPE *)( (REAL_TYPE *)TEST_ALIGN( ansbuf ) + shift );
+
+  srand( n );
+  for ( j = 0; j < howmany * n; ++j )
+  {
+    dat.data[j]  = 20.0 * rand() / (REAL_TYPE)( RAND_MAX + 1.0 ) - 10.0;
+    dat.data[j] += I * ( 20.0 * rand() / (REAL_TYPE)( RAND_MAX + 1.0 ) - 10.0 );
+  }
+
+  if ( SEQUENCE_FFT( &fft, &dat, fwd ) != 0 )
+  {
+    fputs( "FAIL: Forward transform of sequence failed\n", stderr );
+    return 1;
+  }
+  if ( SEQUENCE_FFT( &ans, &fft, rev ) != 0 )
+  {
+    fputs( "FAIL: Reverse transform of sequence failed\n", stderr );
+    return 1;
+  }
+
+  for ( i = 0; i < howmany; ++i )
+  {
+    memcpy( vdat->data, dat.data + i * n, n * sizeof( *vdat->data ) );
+    if ( VECTOR_FFT( vfft, vdat, fwd ) != 0 )
+    {
+      fputs( "FAIL: Forward transform of vector failed\n", stderr );
+      return 1;
+    }
+    for ( j = 0; j < n; ++j )
+    {
+      if ( cabs( vfft->data[j] - fft.data[i * n + j] ) > TOLERANCE * n )
+      {
+        fputs( "FAIL: Incorrect result from forward transform of sequence\n", stderr );
+        return 1;
+      }
+    }
+
+    memcpy( vfft->data, fft.data + i * n, n * sizeof( *vfft->data ) );
+    if ( VECTOR_FFT( vdat, vfft, rev ) != 0 )
+    {
+      fputs( "FAIL: Reverse transform of vector failed\n", stderr );
+      return 1;
+    }
+    for ( j = 0; j < n; ++j )
+    {
+      if ( cabs( vdat->data[j] - ans.data[i * n + j] ) > TOLERANCE * n )
+      {
+        fputs( "FAIL: Incorrect result from reverse transform of sequence\n", stderr );
+        return 1;
+      }
+      if ( cabs( ans.data[i * n + j] / n - dat.data[i * n + j] ) > TOLERANCE )
+      {
+        fputs( "FAIL: Incorrect result after reverse transform of sequence\n", stderr );
+        return 1;
+      }
+    }
+  }
+
+  DESTROY_VECTOR( vfft );
+  DESTROY_VECTOR( vdat );
+  XLALFree( ansbuf );
+  XLALFree( fftbuf );
+  XLALFree( datbuf );
+  DESTROY_PLAN( rev );
+  DESTROY_PLAN( fwd );
+  return 0;
+}
+
+#undef CONCAT2x
+#undef CONCAT2
+#undef CONCAT3x
+#undef CONCAT3
+
+#undef PLAN_TYPE
+#undef VECTOR_TYPE
+#undef SEQUENCE_TYPE
+
+#undef CREATE_PLAN_MANY
+#undef DESTROY_PLAN
+#undef CREATE_VECTOR
+#undef DESTROY_VECTOR
+#undef VECTOR_FFT
+#undef SEQUENCE_FFT
+
+#undef FUNC
@@ -0,0 +1,248 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the persistent FFTW wisdom store: wisdom exported by one process
+ * is imported by another, wisdom exported concurrently by several processes
+ * is merged, no lock or temporary files are left behind, and a process which
+ * exits while holding the FFTW wisdom lock does not deadlock.  Each test runs
+ * in a child process, since wisdom is also exported when a process exits.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALString.h>
+#include <lal/RealFFT.h>
+#include <lal/FFTWMutex.h>
+
+#define TESTDIR "FFTWWisdomTest.d"
+#define NWRITERS 4
+
+/* Remove all files in the test directory */
+static void clean_testdir( void )
+{
+  DIR *dir = opendir( TESTDIR );
+  struct dirent *ent;
+  if ( dir == NULL ) {
+    return;
+  }
+  while ( ( ent = readdir( dir ) ) != NULL ) {
+    if ( ent->d_name[0] != '.' ) {
+      char path[256];
+      snprintf( path, sizeof( path ), "%s/%s", TESTDIR, ent->d_name );
+      unlink( path );
+    }
+  }
+  closedir( dir );
+}
+
+/* Create measured plans in single and double precision, so that FFTW accumulates wisdom */
+static int make_wisdom( UINT4 size )
+{
+  REAL8FFTPlan *plan8 = XLALCreateForwardREAL8FFTPlan( size, 1 );
+  XLAL_CHECK( plan8 != NULL, XLAL_EFUNC );
+  REAL4FFTPlan *plan4 = XLALCreateForwardREAL4FFTPlan( size, 1 );
+  XLAL_CHECK( plan4 != NULL, XLAL_EFUNC );
+  XLALDestroyREAL8FFTPlan( plan8 );
+  XLALDestroyREAL4FFTPlan( plan4 );
+  return XLAL_SUCCESS;
+}
+
+/* Run 'func(path, size)' in a child process, which then exits normally */
+static int run_child( int ( *func )( const char *, UINT4 ), const char *path, UINT4 size, pid_t *pid )
+{
+  *pid = fork();
+  XLAL_CHECK( *pid >= 0, XLAL_ESYS );
+  if ( *pid == 0 ) {
+    alarm( 60 );                /* fail rather than hang if the child deadlocks */
+    const int retn = func( path, size );
+    LALCheckMemoryLeaks();
+    exit( retn == XLAL_SUCCESS ? EXIT_SUCCESS : EXIT_FAILURE );
+  }
+  return XLAL_SUCCESS;
+}
+
+static int wait_child( pid_t pid )
+{
+  int status = 0;
+  XLAL_CHECK( waitpid( pid, &status, 0 ) == pid, XLAL_ESYS );
+  XLAL_CHECK( WIFEXITED( status ) && WEXITSTATUS( status ) == EXIT_SUCCESS, XLAL_EFAILED, "Child process %i failed with status %i", ( int ) pid, status );
+  return XLAL_SUCCESS;
+}
+
+/* Child: accumulate wisdom and export it to 'path' */
+static int child_export( const char *path, UINT4 size )
+{
+  XLAL_CHECK( XLALFFTWWisdomSetPath( path ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( make_wisdom( size ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALFFTWWisdomExport() == XLAL_SUCCESS, XLAL_EFUNC );
+  return XLAL_SUCCESS;
+}
+
+/* Child: import wisdom from 'path', then write it, and only it, to 'path.copy' */
+static int child_import( const char *path, UINT4 size )
+{
+  (void) size;
+  char *copy = XLALStringAppendFmt( NULL, "%s.copy", path );
+  XLAL_CHECK( copy != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALFFTWWisdomSetPath( path ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALFFTWWisdomSetPath( copy ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALFFTWWisdomExport() == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALFree( copy );
+  return XLAL_SUCCESS;
+}
+
+/* Child: export wisdom to a private file 'path/private-<size>.dat', then set the shared
+ * store in the directory 'path', to which wisdom is written when the process exits */
+static int child_writer( const char *path, UINT4 size )
+{
+  char *private = XLALStringAppendFmt( NULL, "%s/private-%u.dat", path, size );
+  XLAL_CHECK( private != NULL, XLAL_EFUNC );
+  XLAL_CHECK( child_export( private, size ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALFFTWWisdomSetPath( path ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALFree( private );
+  return XLAL_SUCCESS;
+}
+
+/* Child: exit while holding the FFTW wisdom lock */
+static int child_exit_locked( const char *path, UINT4 size )
+{
+  XLAL_CHECK( XLALFFTWWisdomSetPath( path ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( make_wisdom( size ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLALFFTWWisdomLock();
+  return XLAL_SUCCESS;
+}
+
+/* Read the contents of a file */
+static char *read_file( const char *path )
+{
+  FILE *fp = fopen( path, "r" );
+  XLAL_CHECK_NULL( fp != NULL, XLAL_EIO, "Could not open '%s'", path );
+  char *contents = NULL;
+  char line[4096];
+  while ( fgets( line, sizeof( line ), fp ) != NULL ) {
+    contents = XLALStringAppend( contents, line );
+    XLAL_CHECK_NULL( contents != NULL, XLAL_EFUNC );
+  }
+  fclose( fp );
+  XLAL_CHECK_NULL( contents != NULL, XLAL_EIO, "File '%s' is empty", path );
+  return contents;
+}
+
+/* Check that the wisdom file 'path' is valid, and that every wisdom entry in 'subpath' is also in 'path' */
+static int check_wisdom( const char *path, const char *subpath )
+{
+  char *contents = read_file( path );
+  XLAL_CHECK( contents != NULL, XLAL_EFUNC );
+  XLAL_CHECK( strncmp( contents, "# LAL FFTW wisdom ", 18 ) == 0, XLAL_EFAILED, "'%s' has no wisdom header", path );
+  XLAL_CHECK( strstr( contents, " fftw_wisdom" ) != NULL, XLAL_EFAILED, "'%s' has no double-precision wisdom", path );
+  XLAL_CHECK( strstr( contents, " fftwf_wisdom" ) != NULL, XLAL_EFAILED, "'%s' has no single-precision wisdom", path );
+  if ( subpath != NULL ) {
+    char *subcontents = read_file( subpath );
+    XLAL_CHECK( subcontents != NULL, XLAL_EFUNC );
+    char *saveptr = NULL;
+    for ( char *line = strtok_r( subcontents, "\n", &saveptr ); line != NULL; line = strtok_r( NULL, "\n", &saveptr ) ) {
+      if ( line[0] != ' ' ) {
+        continue;               /* skip headers; only compare wisdom entries */
+      }
+      XLAL_CHECK( strstr( contents, line ) != NULL, XLAL_EFAILED, "Wisdom '%s' from '%s' is missing from '%s'", line, subpath, path );
+    }
+    XLALFree( subcontents );
+  }
+  XLALFree( contents );
+  return XLAL_SUCCESS;
+}
+
+/* Check that only wisdom files ending in '.dat' or '.copy' remain in the test directory, and return the shared store */
+static int check_testdir( char *store, size_t len )
+{
+  DIR *dir = opendir( TESTDIR );
+  XLAL_CHECK( dir != NULL, XLAL_EIO );
+  struct dirent *ent;
+  store[0] = '\0';
+  while ( ( ent = readdir( dir ) ) != NULL ) {
+    const char *name = ent->d_name;
+    const size_t n = strlen( name );
+    if ( name[0] == '.' ) {
+      continue;
+    }
+    XLAL_CHECK( ( n > 4 && strcmp( name + n - 4, ".dat" ) == 0 ) || ( n > 5 && strcmp( name + n - 5, ".copy" ) == 0 ), XLAL_EFAILED, "Unexpected file '%s' left in '%s'", name, TESTDIR );
+    if ( strncmp( name, "lal-fftw-wisdom-", 16 ) == 0 ) {
+      snprintf( store, len, "%s/%s", TESTDIR, name );
+    }
+  }
+  closedir( dir );
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+#if !defined(LAL_FFTW3_ENABLED)
+  fprintf( stderr, "LAL was not compiled with FFTW; skipping test\n" );
+  return 77;
+#else
+  pid_t pid[NWRITERS];
+  char store[256];
+
+  mkdir( TESTDIR, 0755 );
+  clean_testdir();
+
+  /* wisdom exported by one process is imported by another */
+  XLAL_CHECK_MAIN( run_child( child_export, TESTDIR "/roundtrip.dat", 64, &pid[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( wait_child( pid[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( check_wisdom( TESTDIR "/roundtrip.dat", NULL ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( run_child( child_import, TESTDIR "/roundtrip.dat", 0, &pid[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( wait_child( pid[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( check_wisdom( TESTDIR "/roundtrip.dat.copy", TESTDIR "/roundtrip.dat" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* wisdom written concurrently to a shared store by several processes is merged */
+  for ( UINT4 k = 0; k < NWRITERS; ++k ) {
+    XLAL_CHECK_MAIN( run_child( child_writer, TESTDIR, 48 + 32 * k, &pid[k] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  for ( UINT4 k = 0; k < NWRITERS; ++k ) {
+    XLAL_CHECK_MAIN( wait_child( pid[k] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLAL_CHECK_MAIN( check_testdir( store, sizeof( store ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( store[0] != '\0', XLAL_EFAILED, "No shared wisdom store in '%s'", TESTDIR );
+  for ( UINT4 k = 0; k < NWRITERS; ++k ) {
+    char private[256];
+    snprintf( private, sizeof( private ), "%s/private-%u.dat", TESTDIR, 48 + 32 * k );
+    XLAL_CHECK_MAIN( check_wisdom( store, private ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+
+  /* a process which exits while holding the wisdom lock does not deadlock */
+  XLAL_CHECK_MAIN( run_child( child_exit_locked, TESTDIR "/locked.dat", 96, &pid[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( wait_child( pid[0] ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( check_testdir( store, sizeof( store ) ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  clean_testdir();
+  rmdir( TESTDIR );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+#endif
+}
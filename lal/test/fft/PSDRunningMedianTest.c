@@ -0,0 +1,140 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the incremental median PSD estimator LALPSDRunningMedian against
+ * XLALREAL8AverageSpectrumMedian() applied to the same window of data.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/Date.h>
+#include <lal/Units.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/TimeFreqFFT.h>
+#include <lal/Window.h>
+
+#define SEGLEN 256
+#define STRIDE 128
+#define NUMSTRIDES 40
+
+/* Simple deterministic pseudo-random input in [-1,1) */
+static REAL8 next_sample( UINT4 *seed )
+{
+  *seed = 1664525u * ( *seed ) + 1013904223u;
+  return ( ( REAL8 )( *seed ) / 2147483648.0 ) - 1.0;
+}
+
+static int test_running_median( UINT4 median_samples )
+{
+  const LIGOTimeGPS epoch = { 1000000000, 0 };
+  const UINT4 reclen = ( NUMSTRIDES - 1 ) * STRIDE + SEGLEN;
+  UINT4 seed = 4321 + median_samples;
+
+  REAL8TimeSeries *tseries = XLALCreateREAL8TimeSeries( "noise", &epoch, 0.0, 1.0 / 1024, &lalStrainUnit, reclen );
+  XLAL_CHECK( tseries != NULL, XLAL_EFUNC );
+  for ( UINT4 j = 0; j < reclen; ++j ) {
+    tseries->data->data[j] = next_sample( &seed );
+    /* add an intermittent glitch, which the median should reject */
+    if ( ( j / STRIDE ) % 9 == 4 ) {
+      tseries->data->data[j] *= 100;
+    }
+  }
+
+  REAL8Window *window = XLALCreateHannREAL8Window( SEGLEN );
+  XLAL_CHECK( window != NULL, XLAL_EFUNC );
+  REAL8FFTPlan *plan = XLALCreateForwardREAL8FFTPlan( SEGLEN, 0 );
+  XLAL_CHECK( plan != NULL, XLAL_EFUNC );
+  REAL8FrequencySeries *periodogram = XLALCreateREAL8FrequencySeries( "periodogram", &epoch, 0.0, 0.0, &lalDimensionlessUnit, SEGLEN / 2 + 1 );
+  REAL8FrequencySeries *expected = XLALCreateREAL8FrequencySeries( "expected", &epoch, 0.0, 0.0, &lalDimensionlessUnit, SEGLEN / 2 + 1 );
+  XLAL_CHECK( periodogram != NULL && expected != NULL, XLAL_EFUNC );
+
+  LALPSDRunningMedian *r = XLALPSDRunningMedianNew( median_samples );
+  XLAL_CHECK( r != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALPSDRunningMedianGetMedianSamples( r ) == median_samples, XLAL_EFAILED );
+
+  for ( UINT4 seg = 0; seg < NUMSTRIDES; ++seg ) {
+
+    /* add the periodogram of the next segment */
+    REAL8TimeSeries *segment = XLALCutREAL8TimeSeries( tseries, seg * STRIDE, SEGLEN );
+    XLAL_CHECK( segment != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALREAL8ModifiedPeriodogram( periodogram, segment, window, plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLALDestroyREAL8TimeSeries( segment );
+    XLAL_CHECK( XLALPSDRunningMedianAdd( r, periodogram ) == XLAL_SUCCESS, XLAL_EFUNC );
+    const UINT4 numseg = ( seg + 1 < median_samples ) ? seg + 1 : median_samples;
+    XLAL_CHECK( XLALPSDRunningMedianGetNSamples( r ) == numseg, XLAL_EFAILED );
+
+    /* compute the median PSD of the segments in the window directly */
+    const UINT4 first = seg + 1 - numseg;
+    REAL8TimeSeries *data = XLALCutREAL8TimeSeries( tseries, first * STRIDE, ( numseg - 1 ) * STRIDE + SEGLEN );
+    XLAL_CHECK( data != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALREAL8AverageSpectrumMedian( expected, data, SEGLEN, STRIDE, window, plan ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    REAL8FrequencySeries *psd = XLALPSDRunningMedianGetPSD( r );
+    XLAL_CHECK( psd != NULL, XLAL_EFUNC );
+    XLAL_CHECK( XLALGPSCmp( &psd->epoch, &data->epoch ) == 0, XLAL_EFAILED, "PSD epoch is not that of the oldest segment" );
+    XLAL_CHECK( psd->deltaF == expected->deltaF && psd->data->length == expected->data->length, XLAL_EFAILED );
+    XLAL_CHECK( XLALUnitCompare( &psd->sampleUnits, &expected->sampleUnits ) == 0, XLAL_EFAILED );
+    for ( UINT4 k = 0; k < psd->data->length; ++k ) {
+      XLAL_CHECK( fabs( psd->data->data[k] - expected->data->data[k] ) <= 1e-12 * expected->data->data[k], XLAL_ETOL,
+                  "Running median PSD differs in bin %u after %u segments: %g != %g", k, seg + 1, psd->data->data[k], expected->data->data[k] );
+    }
+    XLALDestroyREAL8FrequencySeries( psd );
+    XLALDestroyREAL8TimeSeries( data );
+
+  }
+
+  /* mismatched periodograms are rejected */
+  {
+    REAL8FrequencySeries *wrong = XLALCutREAL8FrequencySeries( periodogram, 0, periodogram->data->length - 1 );
+    XLAL_CHECK( wrong != NULL, XLAL_EFUNC );
+    int errnum = 0, retn = 0;
+    XLAL_TRY_SILENT( retn = XLALPSDRunningMedianAdd( r, wrong ), errnum );
+    XLAL_CHECK( retn != XLAL_SUCCESS && errnum == XLAL_EDATA, XLAL_EFAILED, "Mismatched periodogram was not detected" );
+    XLALDestroyREAL8FrequencySeries( wrong );
+  }
+
+  /* after a reset the history is empty */
+  XLALPSDRunningMedianReset( r );
+  XLAL_CHECK( XLALPSDRunningMedianGetNSamples( r ) == 0, XLAL_EFAILED );
+
+  XLALPSDRunningMedianFree( r );
+  XLALDestroyREAL8FrequencySeries( expected );
+  XLALDestroyREAL8FrequencySeries( periodogram );
+  XLALDestroyREAL8FFTPlan( plan );
+  XLALDestroyREAL8Window( window );
+  XLALDestroyREAL8TimeSeries( tseries );
+
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  XLAL_CHECK_MAIN( test_running_median( 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_running_median( 2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_running_median( 7 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_running_median( 16 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -61,6 +61,7 @@
 #include <complex.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
 #include <lal/LALStdlib.h>
@@ -87,6 +88,27 @@ ParseOptions( int argc, char *argv[] );
 static void
 TestStatus( LALStatus *status, const char *expectedCodes, int exitCode );
 
+/* rounds a pointer up to a multiple of TEST_ALIGNMENT bytes, which is more
+ * than the alignment required by any of the SIMD routines of FFTW */
+#define TEST_ALIGNMENT 64
+#define TEST_ALIGN(ptr) ((void *)(((size_t)(ptr) + TEST_ALIGNMENT - 1) & ~(size_t)(TEST_ALIGNMENT - 1)))
+
+#define REAL_TYPE REAL4
+#define COMPLEX_TYPE COMPLEX8
+#define TOLERANCE 1e-4
+#include "RealFFTTest_source.c"
+#undef REAL_TYPE
+#undef COMPLEX_TYPE
+#undef TOLERANCE
+
+#define REAL_TYPE REAL8
+#define COMPLEX_TYPE COMPLEX16
+#define TOLERANCE 1e-10
+#include "RealFFTTest_source.c"
+#undef REAL_TYPE
+#undef COMPLEX_TYPE
+#undef TOLERANCE
+
 void LALForwardRealDFT(
     LALStatus      *status,
     COMPLEX8Vector *output,
@@ -102,8 +124,12 @@ int main( int argc, char *argv[] )
   REAL4Vector    *dat = NULL;
   REAL4Vector    *rfft = NULL;
   REAL4Vector    *ans = NULL;
+  REAL4Vector    *mis = NULL;
+  REAL4Vector     misdat;
   COMPLEX8Vector *dft = NULL;
   COMPLEX8Vector *fft = NULL;
+  COMPLEX8Vector *cmis = NULL;
+  COMPLEX8Vector  miscdat;
 #if LAL_CUDA_ENABLED
   /* The test itself should pass at 1e-4, but it might fail at
    * some rare cases where accuracy is bad for some numbers. */
@@ -160,10 +186,14 @@ int main( int argc, char *argv[] )
     TestStatus( &status, CODES( 0 ), 1 );
     LALSCreateVector( &status, &ans, n );
     TestStatus( &status, CODES( 0 ), 1 );
+    LALSCreateVector( &status, &mis, n + 1 );
+    TestStatus( &status, CODES( 0 ), 1 );
     LALCCreateVector( &status, &dft, n / 2 + 1 );
     TestStatus( &status, CODES( 0 ), 1 );
     LALCCreateVector( &status, &fft, n / 2 + 1 );
     TestStatus( &status, CODES( 0 ), 1 );
+    LALCCreateVector( &status, &cmis, n / 2 + 2 );
+    TestStatus( &status, CODES( 0 ), 1 );
     LALCreateForwardRealFFTPlan( &status, &fwd, n, 0 );
     TestStatus( &status, CODES( 0 ), 1 );
     LALCreateReverseRealFFTPlan( &status, &rev, n, 0 );
@@ -217,6 +247,32 @@ int main( int argc, char *argv[] )
         fp ? fprintf( fp, "%e\t%e\t%e\n",
             rfft->data[j], ans->data[j], ans->data[j] / n ) : 0;
       }
+
+      /*
+       *
+       * Repeat forward FFT on misaligned data, which cannot use the
+       * native real-to-complex plan, and check it agrees.
+       *
+       */
+      misdat.length = n;
+      misdat.data = mis->data + 1;
+      memcpy( misdat.data, dat->data, n * sizeof( *dat->data ) );
+      if ( XLALREAL4ForwardFFT( dft, &misdat, fwd ) != 0 )
+      {
+        fputs( "FAIL: Forward transform of misaligned data failed\n", stderr );
+        return 1;
+      }
+      for ( k = 0; k <= n / 2; ++k )
+      {
+        REAL8 err = cabs( dft->data[k] - fft->data[k] );
+        if ( err > tol )
+        {
+          fputs( "FAIL: Incorrect result from misaligned forward transform\n", stderr );
+          fprintf( stderr, "\tdifference = %e\n", err );
+          fprintf( stderr, "\ttolerance  = %e\n", tol );
+          return 1;
+        }
+      }
       if ( n < 128 )
       {
         LALForwardRealDFT( &status, dft, dat );
@@ -291,6 +347,39 @@ int main( int argc, char *argv[] )
           return 1;
         }
       }
+
+      /*
+       *
+       * Repeat reverse FFT from and into misaligned data, which cannot use
+       * the native complex-to-real plan, and check accuracy vs original
+       * data.
+       *
+       */
+      miscdat.length = n / 2 + 1;
+      miscdat.data = cmis->data + 1;
+      memcpy( miscdat.data, fft->data, ( n / 2 + 1 ) * sizeof( *fft->data ) );
+      misdat.length = n;
+      misdat.data = mis->data + 1;
+      if ( XLALREAL4ReverseFFT( &misdat, &miscdat, rev ) != 0 )
+      {
+        fputs( "FAIL: Reverse transform of misaligned data failed\n", stderr );
+        return 1;
+      }
+      for ( j = 0; j < n; ++j )
+      {
+        REAL8 err = fabs( dat->data[j] - misdat.data[j] / n );
+        REAL8 ave = fabs( dat->data[j] + misdat.data[j] / n ) / 2 + eps;
+        REAL8 fer = err / ave;
+        if ( fer > eps && err > tol )
+        {
+          fputs( "FAIL: Incorrect result after misaligned reverse transform\n", stderr );
+          fprintf( stderr, "\tdifference = %e\n", err );
+          fprintf( stderr, "\ttolerance  = %e\n", tol );
+          fprintf( stderr, "\tfrac error = %e\n", fer );
+          fprintf( stderr, "\tprecision  = %e\n", eps );
+          return 1;
+        }
+      }
     }
 
     LALSDestroyVector( &status, &dat );
@@ -299,16 +388,38 @@ int main( int argc, char *argv[] )
     TestStatus( &status, CODES( 0 ), 1 );
     LALSDestroyVector( &status, &ans );
     TestStatus( &status, CODES( 0 ), 1 );
+    LALSDestroyVector( &status, &mis );
+    TestStatus( &status, CODES( 0 ), 1 );
     LALCDestroyVector( &status, &dft );
     TestStatus( &status, CODES( 0 ), 1 );
     LALCDestroyVector( &status, &fft );
     TestStatus( &status, CODES( 0 ), 1 );
+    LALCDestroyVector( &status, &cmis );
+    TestStatus( &status, CODES( 0 ), 1 );
     LALDestroyRealFFTPlan( &status, &fwd );
     TestStatus( &status, CODES( 0 ), 1 );
     LALDestroyRealFFTPlan( &status, &rev );
     TestStatus( &status, CODES( 0 ), 1 );
   }
 
+  /*
+   *
+   * Check transforms of sequences of vectors, both aligned and misaligned
+   * by one element.
+   *
+   */
+  for ( k = 0; k < 2; ++k )
+  {
+    if ( TestREAL4SequenceFFT( 1, 1, k ) || TestREAL4SequenceFFT( 15, 3, k ) || TestREAL4SequenceFFT( 256, 7, k ) )
+    {
+      return 1;
+    }
+    if ( TestREAL8SequenceFFT( 1, 1, k ) || TestREAL8SequenceFFT( 15, 3, k ) || TestREAL8SequenceFFT( 256, 7, k ) )
+    {
+      return 1;
+    }
+  }
+
   LALCheckMemoryLeaks();
   return 0;
 }
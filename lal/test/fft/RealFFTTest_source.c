@@ -0,0 +1,160 @@
+#define CONCAT2x(a,b) a##b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define CONCAT3x(a,b,c) a##b##c
+#define CONCAT3(a,b,c) CONCAT3x(a,b,c)
+
+#define PLAN_TYPE		CONCAT2(REAL_TYPE,FFTPlan)
+#define REAL_VECTOR_TYPE	CONCAT2(REAL_TYPE,Vector)
+#define COMPLEX_VECTOR_TYPE	CONCAT2(COMPLEX_TYPE,Vector)
+#define REAL_SEQUENCE_TYPE	CONCAT2(REAL_TYPE,VectorSequence)
+#define COMPLEX_SEQUENCE_TYPE	CONCAT2(COMPLEX_TYPE,VectorSequence)
+
+#define CREATE_PLAN_MANY	CONCAT3(XLALCreate,PLAN_TYPE,Many)
+#define DESTROY_PLAN		CONCAT2(XLALDestroy,PLAN_TYPE)
+#define CREATE_REAL_VECTOR	CONCAT2(XLALCreate,REAL_VECTOR_TYPE)
+#define DESTROY_REAL_VECTOR	CONCAT2(XLALDestroy,REAL_VECTOR_TYPE)
+#define CREATE_COMPLEX_VECTOR	CONCAT2(XLALCreate,COMPLEX_VECTOR_TYPE)
+#define DESTROY_COMPLEX_VECTOR	CONCAT2(XLALDestroy,COMPLEX_VECTOR_TYPE)
+#define FORWARD_FFT		CONCAT3(XLAL,REAL_TYPE,ForwardFFT)
+#define REVERSE_FFT		CONCAT3(XLAL,REAL_TYPE,ReverseFFT)
+#define FORWARD_SEQUENCE_FFT	CONCAT3(XLAL,REAL_TYPE,ForwardSequenceFFT)
+#define REVERSE_SEQUENCE_FFT	CONCAT3(XLAL,REAL_TYPE,ReverseSequenceFFT)
+
+#define FUNC CONCAT3(Test,REAL_TYPE,SequenceFFT)
+
+/*
+ * Compares forward and reverse transforms of a sequence of howmany vectors
+ * of length n, performed with a plan for sequences, with the transforms of
+ * each vector in turn.  The sequences start shift real elements past a
+ * multiple of TEST_ALIGNMENT bytes: with shift = 0 the plan for sequences
+ * transforms the whole sequence at once, otherwise the vectors are
+ * transformed one at a time.  Returns non-zero on failure.
+ */
+static int
+FUNC( UINT4 n, UINT4 howmany, UINT4 shift )
+{
+  const UINT4            m = n / 2 + 1;
+  PLAN_TYPE             *fwd;
+  PLAN_TYPE             *rev;
+  REAL_TYPE             *datbuf;
+  REAL_TYPE             *ansbuf;
+  REAL_TYPE             *fftbuf;
+  REAL_SEQUENCE_TYPE     dat;
+  REAL_SEQUENCE_TYPE     ans;
+  COMPLEX_SEQUENCE_TYPE  fft;
+  REAL_VECTOR_TYPE      *vdat;
+  REAL_VECTOR_TYPE      *vans;
+  COMPLEX_VECTOR_TYPE   *vfft;
+  UINT4                  i;
+  UINT4                  j;
+
+  fwd    = CREATE_PLAN_MANY( n, howmany, 1, 0, 2 );
+  rev    = CREATE_PLAN_MANY( n, howmany, 0, 0, 2 );
+  datbuf = XLALMalloc( ( howmany * n + shift ) * sizeof( *datbuf ) + TEST_ALIGNMENT );
+  ansbuf = XLALMalloc( ( howmany * n + shift ) * sizeof( *ansbuf ) + TEST_ALIGNMENT );
+  fftbuf = XLALMalloc( ( 2 * howmany * m + shift ) * sizeof( *fftbuf ) + TEST_ALIGNMENT );
+  vdat   = CREATE_REAL_VECTOR( n );
+  vans   = CREATE_REAL_VECTOR( n );
+  vfft   = CREATE_COMPLEX_VECTOR( m );
+  if ( ! fwd || ! rev || ! datbuf || ! ansbuf || ! fftbuf || ! vdat || ! vans || ! vfft )
+  {
+    fputs( "FAIL: Could not create sequence FFT plans or data\n", stderr );
+    return 1;
+  }
+
+  dat.length = ans.length = fft.length = howmany;
+  dat.vectorLength = ans.vectorLength = n;
+  fft.vectorLength = m;
+  dat.data = (REAL_TYPE *)TEST_ALIGN( datbuf ) + shift;
+  ans.data = (REAL_TYPE *)TEST_ALIGN( ansbuf ) + shift;
+  fft.data = (COMPLEX_TYPE *)( (REAL_TYPE *)TEST_ALIGN( fftbuf ) + shift );
+
+  srand( n );
+  for ( j = 0; j < howmany * n; ++j )
+  {
+    dat.data[j] = 20.0 * rand() / (REAL_TYPE)( RAND_MAX + 1.0 ) - 10.0;
+  }
+
+  if ( FORWARD_SEQUENCE_FFT( &fft, &dat, fwd ) != 0 )
+  {
+    fputs( "FAIL: Forward transform of sequence failed\n", stderr );
+    return 1;
+  }
+  if ( REVERSE_SEQUENCE_FFT( &ans, &fft, rev ) != 0 )
+  {
+    fputs( "FAIL: Reverse transform of sequence failed\n", stderr );
+    return 1;
+  }
+
+  for ( i = 0; i < howmany; ++i )
+  {
+    memcpy( vdat->data, dat.data + i * n, n * sizeof( *vdat->data ) );
+    if ( FORWARD_FFT( vfft, vdat, fwd ) != 0 )
+    {
+      fputs( "FAIL: Forward transform of vector failed\n", stderr );
+      return 1;
+    }
+    for ( j = 0; j < m; ++j )
+    {
+      if ( cabs( vfft->data[j] - fft.data[i * m + j] ) > TOLERANCE * n )
+      {
+        fputs( "FAIL: Incorrect result from forward transform of sequence\n", stderr );
+        return 1;
+      }
+    }
+
+    memcpy( vfft->data, fft.data + i * m, m * sizeof( *vfft->data ) );
+    if ( REVERSE_FFT( vans, vfft, rev ) != 0 )
+    {
+      fputs( "FAIL: Reverse transform of vector failed\n", stderr );
+      return 1;
+    }
+    for ( j = 0; j < n; ++j )
+    {
+      if ( fabs( vans->data[j] - ans.data[i * n + j] ) > TOLERANCE * n )
+      {
+        fputs( "FAIL: Incorrect result from reverse transform of sequence\n", stderr );
+        return 1;
+      }
+      if ( fabs( ans.data[i * n + j] / n - dat.data[i * n + j] ) > TOLERANCE )
+      {
+        fputs( "FAIL: Incorrect result after reverse transform of sequence\n", stderr );
+        return 1;
+      }
+    }
+  }
+
+  DESTROY_COMPLEX_VECTOR( vfft );
+  DESTROY_REAL_VECTOR( vans );
+  DESTROY_REAL_VECTOR( vdat );
+  XLALFree( fftbuf );
+  XLALFree( ansbuf );
+  XLALFree( datbuf );
+  DESTROY_PLAN( rev );
+  DESTROY_PLAN( fwd );
+  return 0;
+}
+
+#undef CONCAT2x
+#undef CONCAT2
+#undef CONCAT3x
+#undef CONCAT3
+
+#undef PLAN_TYPE
+#undef REAL_VECTOR_TYPE
+#undef COMPLEX_VECTOR_TYPE
+#undef REAL_SEQUENCE_TYPE
+#undef COMPLEX_SEQUENCE_TYPE
+
+#undef CREATE_PLAN_MANY
+#undef DESTROY_PLAN
+#undef CREATE_REAL_VECTOR
+#undef DESTROY_REAL_VECTOR
+#undef CREATE_COMPLEX_VECTOR
+#undef DESTROY_COMPLEX_VECTOR
+#undef FORWARD_FFT
+#undef REVERSE_FFT
+#undef FORWARD_SEQUENCE_FFT
+#undef REVERSE_SEQUENCE_FFT
+
+#undef FUNC
@@ -0,0 +1,281 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the thread-local memory arenas in LALMalloc.c, the factories which
+ * opt into them, and the lock-free memory accounting mode.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <lal/LALStdlib.h>
+#include <lal/AVFactories.h>
+#include <lal/Date.h>
+#include <lal/Units.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+/* never use this... never! */
+void XLALClobberDebugLevel(int);
+
+#define NALLOC 1000
+#define NTHREADS 4
+
+static int test_arena( void )
+{
+  unsigned char *p[NALLOC];
+  size_t n[NALLOC];
+
+  /* without an arena, arena functions use the heap */
+  XLAL_CHECK( XLALGetMallocArenaDepth() == 0, XLAL_EFAILED );
+  unsigned char *heap = XLALArenaCalloc( 10, 10 );
+  XLAL_CHECK( heap != NULL, XLAL_EFUNC );
+  for ( size_t j = 0; j < 100; ++j ) {
+    XLAL_CHECK( heap[j] == 0, XLAL_EFAILED );
+  }
+  memset( heap, 3, 100 );
+
+  XLAL_CHECK( XLALPushMallocArena( 4096 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALGetMallocArenaDepth() == 1, XLAL_EFAILED );
+
+  /* many allocations, some larger than the block size, must not overlap */
+  for ( size_t i = 0; i < NALLOC; ++i ) {
+    n[i] = ( i % 97 == 0 ) ? 10000 + i : 1 + ( i * 37 ) % 300;
+    p[i] = XLALArenaMalloc( n[i] );
+    XLAL_CHECK( p[i] != NULL, XLAL_EFUNC );
+    XLAL_CHECK( ( ( uintptr_t ) p[i] ) % 16 == 0, XLAL_EFAILED, "Arena allocation %p is not aligned", p[i] );
+    memset( p[i], ( int )( i % 251 ), n[i] );
+  }
+  for ( size_t i = 0; i < NALLOC; ++i ) {
+    for ( size_t j = 0; j < n[i]; ++j ) {
+      XLAL_CHECK( p[i][j] == ( unsigned char )( i % 251 ), XLAL_EFAILED, "Arena allocation %zu was overwritten", i );
+    }
+  }
+
+  /* calloc returns zeroed memory, even if reusing memory */
+  {
+    unsigned char *q = XLALArenaMalloc( 100 );
+    XLAL_CHECK( q != NULL, XLAL_EFUNC );
+    memset( q, 0xff, 100 );
+    XLALArenaFree( q );
+    unsigned char *r = XLALArenaCalloc( 25, 4 );
+    XLAL_CHECK( r == q, XLAL_EFAILED, "Most recent arena allocation was not reused" );
+    for ( size_t j = 0; j < 100; ++j ) {
+      XLAL_CHECK( r[j] == 0, XLAL_EFAILED );
+    }
+  }
+
+  /* the most recent allocation is resized in place, if its block has room; others are copied */
+  {
+    XLAL_CHECK( XLALPushMallocArena( 4096 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    unsigned char *q = XLALArenaMalloc( 10 );
+    XLAL_CHECK( q != NULL, XLAL_EFUNC );
+    memset( q, 7, 10 );
+    unsigned char *r = XLALArenaRealloc( q, 1000 );
+    XLAL_CHECK( r == q, XLAL_EFAILED, "Most recent arena allocation was not resized in place" );
+    for ( size_t j = 0; j < 10; ++j ) {
+      XLAL_CHECK( q[j] == 7, XLAL_EFAILED, "Arena reallocation did not preserve contents" );
+    }
+    /* memory from an enclosing arena is copied within that arena */
+    r = XLALArenaRealloc( p[1], 2 * n[1] );
+    XLAL_CHECK( XLALPopMallocArena() == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( r != NULL && r != p[1], XLAL_EFUNC );
+    for ( size_t j = 0; j < n[1]; ++j ) {
+      XLAL_CHECK( r[j] == 1, XLAL_EFAILED, "Arena reallocation did not preserve contents" );
+    }
+  }
+
+  /* allocations from an enclosing arena survive a nested arena */
+  XLAL_CHECK( XLALPushMallocArena( 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALGetMallocArenaDepth() == 2, XLAL_EFAILED );
+  for ( size_t i = 0; i < NALLOC; ++i ) {
+    XLAL_CHECK( XLALArenaMalloc( 1000 ) != NULL, XLAL_EFUNC );
+  }
+  XLAL_CHECK( XLALPopMallocArena() == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALGetMallocArenaDepth() == 1, XLAL_EFAILED );
+  for ( size_t i = 2; i < NALLOC; ++i ) {
+    XLAL_CHECK( p[i][0] == ( unsigned char )( i % 251 ) && p[i][n[i] - 1] == ( unsigned char )( i % 251 ), XLAL_EFAILED );
+  }
+
+  /* memory allocated from the heap before the arena was pushed stays on the heap */
+  heap = XLALArenaRealloc( heap, 200 );
+  XLAL_CHECK( heap != NULL, XLAL_EFUNC );
+  for ( size_t j = 0; j < 100; ++j ) {
+    XLAL_CHECK( heap[j] == 3, XLAL_EFAILED, "Heap reallocation did not preserve contents" );
+  }
+
+  XLAL_CHECK( XLALPopMallocArena() == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALGetMallocArenaDepth() == 0, XLAL_EFAILED );
+
+  /* heap memory must still be freed explicitly */
+  XLALArenaFree( heap );
+
+  /* popping with no active arena is an error */
+  {
+    int errnum = 0, retn = 0;
+    XLAL_TRY_SILENT( retn = XLALPopMallocArena(), errnum );
+    XLAL_CHECK( retn != XLAL_SUCCESS && errnum == XLAL_EFAILED, XLAL_EFAILED, "Popping a missing arena was not detected" );
+  }
+
+  return XLAL_SUCCESS;
+}
+
+static int test_factories( UINT4 length )
+{
+  const LIGOTimeGPS epoch = { 1000000000, 0 };
+
+  XLAL_CHECK( XLALPushMallocArena( 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* the standard factories never use the arena, so their objects outlive it */
+  REAL8TimeSeries *outer = XLALCreateREAL8TimeSeries( "outer", &epoch, 0.0, 1.0 / 16384, &lalStrainUnit, length );
+  REAL4Vector *outer_vector = XLALCreateREAL4Vector( length );
+  XLAL_CHECK( outer != NULL && outer_vector != NULL, XLAL_EFUNC );
+  for ( UINT4 j = 0; j < length; ++j ) {
+    outer->data->data[j] = outer_vector->data[j] = j;
+  }
+
+  for ( int k = 0; k < 20; ++k ) {
+    REAL8TimeSeries *tseries = XLALArenaCreateREAL8TimeSeries( "tseries", &epoch, 0.0, 1.0 / 16384, &lalStrainUnit, length );
+    COMPLEX16FrequencySeries *fseries = XLALArenaCreateCOMPLEX16FrequencySeries( "fseries", &epoch, 0.0, 1.0, &lalDimensionlessUnit, length / 2 + 1 );
+    REAL4Vector *vector = XLALArenaCreateREAL4Vector( length );
+    XLAL_CHECK( tseries != NULL && fseries != NULL && vector != NULL, XLAL_EFUNC );
+    XLAL_CHECK( strcmp( tseries->name, "tseries" ) == 0 && XLALGPSCmp( &tseries->epoch, &epoch ) == 0, XLAL_EFAILED );
+    XLAL_CHECK( tseries->data->length == length && fseries->data->length == length / 2 + 1 && vector->length == length, XLAL_EFAILED );
+    XLAL_CHECK( ( ( uintptr_t ) tseries->data->data ) % 32 == 0 && ( ( uintptr_t ) fseries->data->data ) % 32 == 0, XLAL_EFAILED, "Arena series data is not aligned" );
+    for ( UINT4 j = 0; j < length; ++j ) {
+      tseries->data->data[j] = vector->data[j] = j;
+    }
+    for ( UINT4 j = 0; j < fseries->data->length; ++j ) {
+      fseries->data->data[j] = crect( j, -( REAL8 ) j );
+    }
+    for ( UINT4 j = 0; j < length; ++j ) {
+      XLAL_CHECK( tseries->data->data[j] == j && vector->data[j] == j, XLAL_EFAILED, "Arena objects overlap" );
+    }
+  }
+  XLAL_CHECK( XLALResizeREAL8TimeSeries( outer, 0, 2 * length ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALPopMallocArena() == XLAL_SUCCESS, XLAL_EFUNC );
+
+  for ( UINT4 j = 0; j < length; ++j ) {
+    XLAL_CHECK( outer->data->data[j] == j && outer_vector->data[j] == j, XLAL_EFAILED, "Objects created by the standard factories were corrupted" );
+  }
+  XLALDestroyREAL8TimeSeries( outer );
+  XLALDestroyREAL4Vector( outer_vector );
+
+  /* arena factories fail if no arena is active */
+  {
+    int errnum = 0;
+    REAL8Vector *vector = NULL;
+    REAL8TimeSeries *tseries = NULL;
+    XLAL_TRY_SILENT( vector = XLALArenaCreateREAL8Vector( length ), errnum );
+    XLAL_CHECK( vector == NULL && errnum == XLAL_EFAILED, XLAL_EFAILED, "Arena vector created without an arena" );
+    XLAL_TRY_SILENT( tseries = XLALArenaCreateREAL8TimeSeries( "tseries", &epoch, 0.0, 1.0 / 16384, &lalStrainUnit, length ), errnum );
+    XLAL_CHECK( tseries == NULL && errnum == XLAL_EFAILED, XLAL_EFAILED, "Arena series created without an arena" );
+  }
+
+  return XLAL_SUCCESS;
+}
+
+#ifdef LAL_PTHREAD_LOCK
+
+/* each thread allocates from its own arenas, and from the heap */
+static void *test_thread( void *arg )
+{
+  int *retn = ( int * ) arg;
+  *retn = XLAL_FAILURE;
+  for ( int k = 0; k < 50; ++k ) {
+    if ( XLALGetMallocArenaDepth() != 0 || test_factories( 1000 + k ) != XLAL_SUCCESS ) {
+      return NULL;
+    }
+    void *p = XLALMalloc( 1000 );
+    if ( p == NULL ) {
+      return NULL;
+    }
+    XLALFree( p );
+  }
+  *retn = XLAL_SUCCESS;
+  return NULL;
+}
+
+/* another thread cannot free or resize memory from this thread's arena */
+static void *test_other_thread( void *arg )
+{
+  void **p = ( void ** ) arg;
+  int errnum = 0;
+  void *q = NULL;
+  XLALArenaFree( p[0] );
+  XLAL_TRY_SILENT( q = XLALArenaRealloc( p[0], 100 ), errnum );
+  p[1] = ( q == NULL && errnum == XLAL_EINVAL ) ? p[0] : NULL;
+  return NULL;
+}
+
+static int test_threads( void )
+{
+  pthread_t threads[NTHREADS];
+  int retn[NTHREADS];
+  for ( int i = 0; i < NTHREADS; ++i ) {
+    XLAL_CHECK( pthread_create( &threads[i], NULL, test_thread, &retn[i] ) == 0, XLAL_ESYS );
+  }
+  for ( int i = 0; i < NTHREADS; ++i ) {
+    XLAL_CHECK( pthread_join( threads[i], NULL ) == 0, XLAL_ESYS );
+    XLAL_CHECK( retn[i] == XLAL_SUCCESS, XLAL_EFAILED, "Thread %d failed", i );
+  }
+
+  XLAL_CHECK( XLALPushMallocArena( 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  void *p[2] = { XLALArenaMalloc( 10 ), NULL };
+  XLAL_CHECK( p[0] != NULL, XLAL_EFUNC );
+  memset( p[0], 5, 10 );
+  XLAL_CHECK( pthread_create( &threads[0], NULL, test_other_thread, p ) == 0, XLAL_ESYS );
+  XLAL_CHECK( pthread_join( threads[0], NULL ) == 0, XLAL_ESYS );
+  XLAL_CHECK( p[1] == p[0], XLAL_EFAILED, "Arena memory was resized by another thread" );
+  void *q = XLALArenaMalloc( 10 );
+  XLAL_CHECK( q != NULL && q != p[0], XLAL_EFAILED, "Arena memory was freed by another thread" );
+  for ( size_t j = 0; j < 10; ++j ) {
+    XLAL_CHECK( ( ( unsigned char * ) p[0] )[j] == 5, XLAL_EFAILED, "Arena memory was freed by another thread" );
+  }
+  XLAL_CHECK( XLALPopMallocArena() == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+}
+
+#endif /* LAL_PTHREAD_LOCK */
+
+int main( void )
+{
+
+  /* use lock-free memory accounting, if memory debugging is enabled */
+  if ( lalDebugLevel & LALMEMDBGBIT ) {
+    XLALClobberDebugLevel( ( lalDebugLevel & ~LALMEMTRKBIT ) | LALMEMTHREAD );
+  }
+
+  XLAL_CHECK_MAIN( test_arena() == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_factories( 16384 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+#ifdef LAL_PTHREAD_LOCK
+  XLAL_CHECK_MAIN( test_threads() == XLAL_SUCCESS, XLAL_EFUNC );
+#endif
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -161,6 +161,56 @@ int main(void)
     XLALPrintInfo( "Wrote segment list file SegmentsOutput1.data\n" );
   }
 
+  /*-------------------------------------------------------------------------*/
+  XLALPrintInfo("\n========== XLALSegListWriteBinary/ReadBinary tests \n");
+  /*-------------------------------------------------------------------------*/
+
+  for ( int compression = 0; compression <= 1; compression++ ) {
+    const char *fname = compression ? "SegmentsOutput2.dat.gz" : "SegmentsOutput2.dat";
+    LALSegList seglist2;
+    XLALSegListInit( &seglist2 );
+    xstatus = XLALSegListWriteBinary( &seglist1, fname, compression );
+    if ( xstatus ) {
+      RETFAIL( "XLALSegListWriteBinary with standard segment list", xstatus );
+      XLALClearErrno();
+    } else if ( ( xstatus = XLALSegListReadBinary( &seglist2, fname ) ) ) {
+      RETFAIL( "XLALSegListReadBinary with standard segment list", xstatus );
+      XLALClearErrno();
+    } else {
+      UINT4 i = 0;
+      if ( seglist2.length == seglist1.length ) {
+        for ( i = 0; i < seglist1.length; i++ ) {
+          if ( XLALSegCmp( &seglist1.segs[i], &seglist2.segs[i] ) != 0 || seglist1.segs[i].id != seglist2.segs[i].id ) {
+            break;
+          }
+        }
+      }
+      if ( seglist2.length != seglist1.length || i < seglist1.length
+           || seglist2.sorted != seglist1.sorted || seglist2.disjoint != seglist1.disjoint
+           || seglist2.dplaces != seglist1.dplaces ) {
+        FUNCFAIL( fname, "Segment list read back differs from segment list written" );
+      } else {
+        FUNCPASS( fname );
+      }
+    }
+    XLALSegListClear( &seglist2 );
+  }
+
+  /* Reading a text segment list file as binary is an error */
+  {
+    LALSegList seglist2;
+    int errnum = 0;
+    XLALSegListInit( &seglist2 );
+    XLAL_TRY_SILENT( xstatus = XLALSegListReadBinary( &seglist2, TEST_DATA_DIR "SegmentsInput1.data" ), errnum );
+    if ( xstatus != XLAL_SUCCESS && errnum == XLAL_EIO ) {
+      RETPASS( "XLALSegListReadBinary with text segment list file", xstatus );
+    } else {
+      RETFAIL( "XLALSegListReadBinary with text segment list file", xstatus );
+    }
+    XLALClearErrno();
+    XLALSegListClear( &seglist2 );
+  }
+
   /*-------------------------------------------------------------------------*/
   /* Clean up leftover seg lists */
   if ( seglist1.segs ) { XLALSegListClear( &seglist1 ); }
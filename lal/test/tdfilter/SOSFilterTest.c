@@ -0,0 +1,201 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the second-order-section filters in SOSFilter.c against the
+ * direct-form filters in IIRFilterVector.c and IIRFilterVectorR.c.
+ */
+
+#include <complex.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/AVFactories.h>
+#include <lal/SeqFactories.h>
+#include <lal/ZPGFilter.h>
+#include <lal/IIRFilter.h>
+
+#define NPTS 5000
+#define NCHAN 5
+
+/* Simple deterministic pseudo-random input in [-1,1) */
+static REAL8 next_sample( UINT4 *seed )
+{
+  *seed = 1664525u * ( *seed ) + 1013904223u;
+  return ( ( REAL8 )( *seed ) / 2147483648.0 ) - 1.0;
+}
+
+/* Create a z-plane Butterworth filter of the given order, with poles in the
+   upper half w-plane; high-pass filters have all their zeros at w = 0. */
+static COMPLEX16ZPGFilter *create_zpg( INT4 order, REAL8 wc, BOOLEAN highpass )
+{
+  COMPLEX16ZPGFilter *zpg = XLALCreateCOMPLEX16ZPGFilter( highpass ? order : 0, order );
+  XLAL_CHECK_NULL( zpg != NULL, XLAL_EFUNC );
+  zpg->gain = 1.0;
+  for ( INT4 i = 0, j = order - 1; i <= j; ++i, --j ) {
+    const REAL8 theta = LAL_PI * ( i + 0.5 ) / order;
+    const REAL8 ar = wc * cos( theta );
+    const REAL8 ai = wc * sin( theta );
+    if ( i == j ) {
+      zpg->poles->data[i] = I * wc;
+    } else {
+      zpg->poles->data[i] = ar + I * ai;
+      zpg->poles->data[j] = -ar + I * ai;
+    }
+  }
+  for ( INT4 k = 0; k < order; ++k ) {
+    if ( highpass ) {
+      zpg->zeros->data[k] = 0.0;
+    } else {
+      zpg->gain *= -zpg->poles->data[k];
+    }
+  }
+  XLAL_CHECK_NULL( XLALWToZCOMPLEX16ZPGFilter( zpg ) == XLAL_SUCCESS, XLAL_EFUNC );
+  return zpg;
+}
+
+static REAL8 max_abs_diff( const REAL8 *x, const REAL8 *y, UINT4 n, REAL8 *scale )
+{
+  REAL8 d = 0, s = 0;
+  for ( UINT4 i = 0; i < n; ++i ) {
+    d = fmax( d, fabs( x[i] - y[i] ) );
+    s = fmax( s, fabs( y[i] ) );
+  }
+  *scale = s;
+  return d;
+}
+
+static int test_filter( INT4 order, REAL8 wc, BOOLEAN highpass )
+{
+  REAL8 scale = 0, err = 0;
+  UINT4 seed = 12345 + order;
+
+  COMPLEX16ZPGFilter *zpg = create_zpg( order, wc, highpass );
+  XLAL_CHECK( zpg != NULL, XLAL_EFUNC );
+  REAL8IIRFilter *iir = XLALCreateREAL8IIRFilter( zpg );
+  XLAL_CHECK( iir != NULL, XLAL_EFUNC );
+  REAL8SOSFilter *sos = XLALCreateREAL8SOSFilter( zpg, 1 );
+  XLAL_CHECK( sos != NULL, XLAL_EFUNC );
+  XLAL_CHECK( sos->numSections == ( UINT4 )( order + 1 ) / 2, XLAL_EFAILED );
+  REAL8SOSFilter *sosMulti = XLALCreateREAL8SOSFilter( zpg, NCHAN );
+  XLAL_CHECK( sosMulti != NULL, XLAL_EFUNC );
+
+  REAL8Vector *x = XLALCreateREAL8Vector( NPTS );
+  REAL8Vector *y = XLALCreateREAL8Vector( NPTS );
+  REAL8Vector *z = XLALCreateREAL8Vector( NPTS );
+  REAL4Vector *s = XLALCreateREAL4Vector( NPTS );
+  REAL8VectorSequence *seq = XLALCreateREAL8VectorSequence( NCHAN, NPTS );
+  XLAL_CHECK( x != NULL && y != NULL && z != NULL && s != NULL && seq != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < NPTS; ++i ) {
+    x->data[i] = next_sample( &seed );
+  }
+
+  /* Forward filtering, in two pieces to check that state is kept */
+  memcpy( y->data, x->data, NPTS * sizeof( REAL8 ) );
+  memcpy( z->data, x->data, NPTS * sizeof( REAL8 ) );
+  XLAL_CHECK( XLALIIRFilterREAL8Vector( y, iir ) == XLAL_SUCCESS, XLAL_EFUNC );
+  {
+    REAL8Vector head = { 1234, z->data };
+    REAL8Vector tail = { NPTS - 1234, z->data + 1234 };
+    XLAL_CHECK( XLALSOSFilterREAL8Vector( &head, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSOSFilterREAL8Vector( &tail, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  err = max_abs_diff( z->data, y->data, NPTS, &scale );
+  printf( "order %d %s: forward    max error %.3e (scale %.3e)\n", order, highpass ? "high-pass" : "low-pass ", err, scale );
+  XLAL_CHECK( err <= 1e-9 * scale, XLAL_ETOL, "Forward SOS filter differs from IIR filter" );
+
+  /* Resetting the filter should reproduce the same output */
+  XLALResetREAL8SOSFilter( sos );
+  memcpy( z->data, x->data, NPTS * sizeof( REAL8 ) );
+  XLAL_CHECK( XLALSOSFilterREAL8Vector( z, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  err = max_abs_diff( z->data, y->data, NPTS, &scale );
+  XLAL_CHECK( err <= 1e-9 * scale, XLAL_ETOL, "Reset SOS filter differs from IIR filter" );
+
+  /* Reverse filtering */
+  XLAL_CHECK( XLALIIRFilterReverseREAL8Vector( y, iir ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( XLALSOSFilterReverseREAL8Vector( z, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  err = max_abs_diff( z->data, y->data, NPTS, &scale );
+  printf( "order %d %s: reverse    max error %.3e (scale %.3e)\n", order, highpass ? "high-pass" : "low-pass ", err, scale );
+  XLAL_CHECK( err <= 1e-9 * scale, XLAL_ETOL, "Reverse SOS filter differs from IIR filter" );
+
+  /* Forward-backward filtering should match the above */
+  memcpy( z->data, x->data, NPTS * sizeof( REAL8 ) );
+  XLAL_CHECK( XLALSOSFiltFiltREAL8Vector( z, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  err = max_abs_diff( z->data, y->data, NPTS, &scale );
+  printf( "order %d %s: filt-filt  max error %.3e (scale %.3e)\n", order, highpass ? "high-pass" : "low-pass ", err, scale );
+  XLAL_CHECK( err <= 1e-9 * scale, XLAL_ETOL, "Forward-backward SOS filter differs from IIR filter" );
+
+  /* Single-precision data are filtered in double precision */
+  for ( UINT4 i = 0; i < NPTS; ++i ) {
+    s->data[i] = x->data[i];
+  }
+  XLAL_CHECK( XLALSOSFiltFiltREAL4Vector( s, sos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < NPTS; ++i ) {
+    z->data[i] = s->data[i];
+  }
+  err = max_abs_diff( z->data, y->data, NPTS, &scale );
+  XLAL_CHECK( err <= 1e-5 * scale, XLAL_ETOL, "Single-precision SOS filter differs from IIR filter" );
+
+  /* Multi-channel filtering: each channel is a scaled copy of the input */
+  for ( UINT4 c = 0; c < NCHAN; ++c ) {
+    for ( UINT4 i = 0; i < NPTS; ++i ) {
+      seq->data[c * NPTS + i] = ( c + 1 ) * x->data[i];
+    }
+  }
+  XLAL_CHECK( XLALSOSFiltFiltREAL8VectorSequence( seq, sosMulti ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 c = 0; c < NCHAN; ++c ) {
+    for ( UINT4 i = 0; i < NPTS; ++i ) {
+      z->data[i] = seq->data[c * NPTS + i] / ( c + 1 );
+    }
+    err = max_abs_diff( z->data, y->data, NPTS, &scale );
+    XLAL_CHECK( err <= 1e-9 * scale, XLAL_ETOL, "Multi-channel SOS filter differs in channel %u", c );
+  }
+  {
+    int errnum = 0, retn = 0;
+    XLAL_TRY_SILENT( retn = XLALSOSFilterREAL8VectorSequence( seq, sos ), errnum );
+    XLAL_CHECK( retn != XLAL_SUCCESS && errnum == XLAL_EINVAL, XLAL_EFAILED, "Mismatched number of channels was not detected" );
+  }
+
+  XLALDestroyREAL8VectorSequence( seq );
+  XLALDestroyREAL4Vector( s );
+  XLALDestroyREAL8Vector( z );
+  XLALDestroyREAL8Vector( y );
+  XLALDestroyREAL8Vector( x );
+  XLALDestroyREAL8SOSFilter( sosMulti );
+  XLALDestroyREAL8SOSFilter( sos );
+  XLALDestroyREAL8IIRFilter( iir );
+  XLALDestroyCOMPLEX16ZPGFilter( zpg );
+
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  XLAL_CHECK_MAIN( test_filter( 1, 0.2, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_filter( 3, 0.1, 0 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_filter( 4, 0.3, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_filter( 5, 0.2, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
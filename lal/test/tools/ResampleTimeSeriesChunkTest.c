@@ -0,0 +1,167 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the polyphase resampling routines XLALResampleREAL{4,8}TimeSeries()
+ * and the chunk-by-chunk resampling routines which use a ResampleTSState.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/Date.h>
+#include <lal/Units.h>
+#include <lal/TimeSeries.h>
+#include <lal/ResampleTimeSeries.h>
+
+#define DURATION 4.0
+
+static REAL8TimeSeries *make_sine( REAL8 rate, REAL8 freq )
+{
+  const LIGOTimeGPS epoch = { 1000000000, 0 };
+  const UINT4 length = DURATION * rate;
+  REAL8TimeSeries *series = XLALCreateREAL8TimeSeries( "sine", &epoch, 0.0, 1.0 / rate, &lalStrainUnit, length );
+  XLAL_CHECK_NULL( series != NULL, XLAL_EFUNC );
+  for ( UINT4 j = 0; j < length; ++j ) {
+    series->data->data[j] = sin( LAL_TWOPI * freq * j * series->deltaT );
+  }
+  return series;
+}
+
+/* Resample a sine wave, and compare to the expected sine wave away from the ends */
+static int test_sine( REAL8 inRate, REAL8 outRate, REAL8 freq, REAL8 amplitude, REAL8 tolerance )
+{
+  REAL8TimeSeries *series = make_sine( inRate, freq );
+  XLAL_CHECK( series != NULL, XLAL_EFUNC );
+  XLAL_CHECK( XLALResampleREAL8TimeSeries( series, 1.0 / outRate ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( series->data->length == ( UINT4 ) floor( DURATION * outRate ), XLAL_EFAILED,
+              "Resampled series has length %u, expected %u", series->data->length, ( UINT4 ) floor( DURATION * outRate ) );
+  XLAL_CHECK( fabs( series->deltaT - 1.0 / outRate ) < 1e-15, XLAL_EFAILED );
+  const REAL8 minRate = ( inRate < outRate ) ? inRate : outRate;
+  const UINT4 skip = 64 * outRate / minRate;
+  REAL8 err = 0;
+  for ( UINT4 j = skip; j + skip < series->data->length; ++j ) {
+    const REAL8 expected = amplitude * sin( LAL_TWOPI * freq * j * series->deltaT );
+    err = fmax( err, fabs( series->data->data[j] - expected ) );
+  }
+  printf( "%g Hz -> %g Hz, sine at %g Hz: max error %.3e\n", inRate, outRate, freq, err );
+  XLAL_CHECK( err <= tolerance, XLAL_ETOL, "Resampled sine wave has error %g > %g", err, tolerance );
+  XLALDestroyREAL8TimeSeries( series );
+  return XLAL_SUCCESS;
+}
+
+/* Resample a series chunk by chunk, and compare to resampling it whole */
+static int test_chunks( REAL8 inRate, REAL8 outRate )
+{
+  REAL8TimeSeries *whole = make_sine( inRate, 37.0 );
+  XLAL_CHECK( whole != NULL, XLAL_EFUNC );
+  REAL8TimeSeries *input = XLALCutREAL8TimeSeries( whole, 0, whole->data->length );
+  XLAL_CHECK( input != NULL, XLAL_EFUNC );
+  for ( UINT4 j = 0; j < input->data->length; ++j ) {
+    whole->data->data[j] = input->data->data[j] += 0.1 * cos( 0.37 * j * j );
+  }
+  XLAL_CHECK( XLALResampleREAL8TimeSeries( whole, 1.0 / outRate ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  ResampleTSState *state = XLALCreateResampleTSState( 1.0 / inRate, 1.0 / outRate );
+  XLAL_CHECK( state != NULL, XLAL_EFUNC );
+  for ( int pass = 0; pass < 2; ++pass ) {
+    UINT4 first = 0, numOut = 0, chunkLength = 1;
+    REAL8 err = 0;
+    BOOLEAN flushed = 0;
+    while ( !flushed ) {
+      REAL8TimeSeries *output;
+      if ( first < input->data->length ) {
+        const UINT4 length = ( first + chunkLength < input->data->length ) ? chunkLength : input->data->length - first;
+        REAL8TimeSeries *chunk = XLALCutREAL8TimeSeries( input, first, length );
+        XLAL_CHECK( chunk != NULL, XLAL_EFUNC );
+        output = XLALResampleREAL8TimeSeriesChunk( state, chunk );
+        XLALDestroyREAL8TimeSeries( chunk );
+        first += length;
+        chunkLength = ( 3 * chunkLength + 7 ) % 5003;
+      } else {
+        output = XLALResampleREAL8TimeSeriesFlush( state );
+        flushed = 1;
+      }
+      XLAL_CHECK( output != NULL, XLAL_EFUNC );
+      XLAL_CHECK( output->deltaT == 1.0 / outRate, XLAL_EFAILED );
+      LIGOTimeGPS epoch = whole->epoch;
+      XLALGPSAdd( &epoch, numOut / outRate );
+      XLAL_CHECK( fabs( XLALGPSDiff( &output->epoch, &epoch ) ) < 1e-9, XLAL_EFAILED, "Chunk output has the wrong epoch" );
+      for ( UINT4 j = 0; j < output->data->length; ++j, ++numOut ) {
+        if ( numOut < whole->data->length ) {
+          err = fmax( err, fabs( output->data->data[j] - whole->data->data[numOut] ) );
+        }
+      }
+      XLALDestroyREAL8TimeSeries( output );
+    }
+    XLAL_CHECK( numOut >= whole->data->length, XLAL_EFAILED, "Chunks returned %u samples, expected at least %u", numOut, whole->data->length );
+    printf( "%g Hz -> %g Hz, %s: chunks differ from whole series by %.3e\n", inRate, outRate, pass ? "after flush" : "fresh state", err );
+    XLAL_CHECK( err <= 1e-12, XLAL_ETOL, "Chunk-by-chunk resampling differs from whole series" );
+  }
+
+  XLALDestroyResampleTSState( state );
+  XLALDestroyREAL8TimeSeries( input );
+  XLALDestroyREAL8TimeSeries( whole );
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  /* Integer downsampling */
+  XLAL_CHECK_MAIN( test_sine( 16384, 4096, 100, 1.0, 1e-4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_sine( 16384, 2048, 731, 1.0, 1e-4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Frequencies above the new Nyquist frequency are removed */
+  XLAL_CHECK_MAIN( test_sine( 16384, 4096, 2500, 0.0, 1e-4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Rational resampling and upsampling */
+  XLAL_CHECK_MAIN( test_sine( 4096, 1000, 50, 1.0, 1e-4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_sine( 2048, 3072, 300, 1.0, 1e-4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_sine( 1024, 4096, 100, 1.0, 1e-4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Chunk-by-chunk resampling */
+  XLAL_CHECK_MAIN( test_chunks( 16384, 4096 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_chunks( 4096, 1000 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_chunks( 1024, 4096 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* Single-precision resampling agrees with double precision */
+  {
+    REAL8TimeSeries *series8 = make_sine( 16384, 100 );
+    XLAL_CHECK_MAIN( series8 != NULL, XLAL_EFUNC );
+    REAL4TimeSeries *series4 = XLALCreateREAL4TimeSeries( series8->name, &series8->epoch, 0.0, series8->deltaT, &series8->sampleUnits, series8->data->length );
+    XLAL_CHECK_MAIN( series4 != NULL, XLAL_EFUNC );
+    for ( UINT4 j = 0; j < series8->data->length; ++j ) {
+      series4->data->data[j] = series8->data->data[j];
+    }
+    XLAL_CHECK_MAIN( XLALResampleREAL8TimeSeries( series8, 1.0 / 4096 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALResampleREAL4TimeSeries( series4, 1.0 / 4096 ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( series4->data->length == series8->data->length, XLAL_EFAILED );
+    for ( UINT4 j = 0; j < series8->data->length; ++j ) {
+      XLAL_CHECK_MAIN( fabs( series4->data->data[j] - series8->data->data[j] ) < 1e-6, XLAL_ETOL );
+    }
+    XLALDestroyREAL4TimeSeries( series4 );
+    XLALDestroyREAL8TimeSeries( series8 );
+  }
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,173 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the segment list set operations XLALSegList{Union,Intersection,
+ * Difference,Complement}() and the batch search XLALSegListSearchMany()
+ * against direct evaluation on a grid of times.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <lal/LALStdlib.h>
+#include <lal/Date.h>
+#include <lal/Segments.h>
+
+/* segments lie on a grid of NGRID times, spaced by DGRID nanoseconds */
+#define T0 ( 1000000000 * XLAL_BILLION_INT8 )
+#define DGRID 250000000
+#define NGRID 400
+
+/* Simple deterministic pseudo-random integers */
+static UINT4 next_random( UINT4 *seed )
+{
+  *seed = 1664525u * ( *seed ) + 1013904223u;
+  return *seed >> 8;
+}
+
+static LIGOTimeGPS grid_time( INT4 k )
+{
+  LIGOTimeGPS t;
+  XLALINT8NSToGPS( &t, T0 + ( INT8 ) k * DGRID );
+  return t;
+}
+
+/* Fill a segment list with random, possibly overlapping and unsorted, segments */
+static int random_seglist( LALSegList *seglist, UINT4 nseg, UINT4 *seed )
+{
+  XLAL_CHECK( XLALSegListInit( seglist ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < nseg; ++i ) {
+    const INT4 start = next_random( seed ) % NGRID;
+    const INT4 end = start + next_random( seed ) % 20;
+    LIGOTimeGPS gpsstart = grid_time( start ), gpsend = grid_time( end );
+    LALSeg seg;
+    XLAL_CHECK( XLALSegSet( &seg, &gpsstart, &gpsend, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK( XLALSegListAppend( seglist, &seg ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  return XLAL_SUCCESS;
+}
+
+/* Return whether a time is in any segment of a list, by linear search */
+static int in_seglist( const LALSegList *seglist, const LIGOTimeGPS *t )
+{
+  for ( UINT4 i = 0; i < seglist->length; ++i ) {
+    if ( XLALGPSInSeg( t, &seglist->segs[i] ) == 0 ) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+/* Check that a segment list is coalesced */
+static int check_coalesced( const LALSegList *seglist )
+{
+  XLAL_CHECK( seglist->sorted && seglist->disjoint, XLAL_EFAILED );
+  for ( UINT4 i = 0; i < seglist->length; ++i ) {
+    XLAL_CHECK( XLALGPSCmp( &seglist->segs[i].start, &seglist->segs[i].end ) < 0, XLAL_EFAILED, "Empty segment in result" );
+    if ( i > 0 ) {
+      XLAL_CHECK( XLALGPSCmp( &seglist->segs[i - 1].end, &seglist->segs[i].start ) < 0, XLAL_EFAILED, "Touching segments in result" );
+    }
+  }
+  return XLAL_SUCCESS;
+}
+
+static int test_set_operations( UINT4 na, UINT4 nb, UINT4 seed )
+{
+  LALSegList a, b;
+  XLAL_CHECK( random_seglist( &a, na, &seed ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( random_seglist( &b, nb, &seed ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  LIGOTimeGPS start = grid_time( 50 ), end = grid_time( 300 );
+  LALSegList *u = XLALSegListUnion( &a, &b );
+  LALSegList *i = XLALSegListIntersection( &a, &b );
+  LALSegList *d = XLALSegListDifference( &a, &b );
+  LALSegList *c = XLALSegListComplement( &a, &start, &end );
+  XLAL_CHECK( u != NULL && i != NULL && d != NULL && c != NULL, XLAL_EFUNC );
+  XLAL_CHECK( check_coalesced( u ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( check_coalesced( i ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( check_coalesced( d ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK( check_coalesced( c ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* compare to direct evaluation, at grid times and between grid times */
+  for ( INT4 k = -1; k <= 2 * NGRID + 40; ++k ) {
+    LIGOTimeGPS t;
+    XLALINT8NSToGPS( &t, T0 + ( INT8 ) k * ( DGRID / 2 ) );
+    const int ina = in_seglist( &a, &t ), inb = in_seglist( &b, &t );
+    const int inrange = XLALGPSCmp( &t, &start ) >= 0 && XLALGPSCmp( &t, &end ) < 0;
+    XLAL_CHECK( in_seglist( u, &t ) == ( ina || inb ), XLAL_EFAILED, "Union is wrong at %" LAL_GPS_FORMAT, LAL_GPS_PRINT( t ) );
+    XLAL_CHECK( in_seglist( i, &t ) == ( ina && inb ), XLAL_EFAILED, "Intersection is wrong at %" LAL_GPS_FORMAT, LAL_GPS_PRINT( t ) );
+    XLAL_CHECK( in_seglist( d, &t ) == ( ina && !inb ), XLAL_EFAILED, "Difference is wrong at %" LAL_GPS_FORMAT, LAL_GPS_PRINT( t ) );
+    XLAL_CHECK( in_seglist( c, &t ) == ( inrange && !ina ), XLAL_EFAILED, "Complement is wrong at %" LAL_GPS_FORMAT, LAL_GPS_PRINT( t ) );
+  }
+
+  /* the inputs are not modified */
+  XLAL_CHECK( a.length == na && b.length == nb, XLAL_EFAILED );
+
+  /* batch search agrees with XLALSegListSearch() */
+  {
+    const size_t n = 3 * NGRID;
+    LIGOTimeGPS *gps = XLALMalloc( n * sizeof( *gps ) );
+    INT4 *indx = XLALMalloc( n * sizeof( *indx ) );
+    XLAL_CHECK( gps != NULL && indx != NULL, XLAL_ENOMEM );
+    for ( size_t k = 0; k < n; ++k ) {
+      /* ascending times, followed by random times */
+      const INT8 dt = ( k < 2 * NGRID ) ? ( INT8 ) k * ( DGRID / 2 ) : ( INT8 )( next_random( &seed ) % ( NGRID + 10 ) ) * DGRID - DGRID;
+      XLALINT8NSToGPS( &gps[k], T0 + dt );
+    }
+    XLAL_CHECK( XLALSegListSearchMany( u, gps, n, indx ) == XLAL_SUCCESS, XLAL_EFUNC );
+    for ( size_t k = 0; k < n; ++k ) {
+      LALSeg *seg = XLALSegListSearch( u, &gps[k] );
+      XLAL_CHECK( indx[k] == ( seg == NULL ? -1 : ( INT4 )( seg - u->segs ) ), XLAL_EFAILED,
+                  "Batch search is wrong at %" LAL_GPS_FORMAT, LAL_GPS_PRINT( gps[k] ) );
+    }
+
+    /* segment lists which are not disjoint are rejected */
+    if ( ! a.disjoint ) {
+      int errnum = 0, retn = 0;
+      XLAL_TRY_SILENT( retn = XLALSegListSearchMany( &a, gps, n, indx ), errnum );
+      XLAL_CHECK( retn != XLAL_SUCCESS && errnum == XLAL_EINVAL, XLAL_EFAILED, "Non-disjoint segment list was not detected" );
+    }
+
+    XLALFree( gps );
+    XLALFree( indx );
+  }
+
+  XLALSegListFree( u );
+  XLALSegListFree( i );
+  XLALSegListFree( d );
+  XLALSegListFree( c );
+  XLALSegListClear( &a );
+  XLALSegListClear( &b );
+
+  return XLAL_SUCCESS;
+}
+
+int main( void )
+{
+
+  XLAL_CHECK_MAIN( test_set_operations( 0, 0, 1 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_set_operations( 10, 0, 2 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_set_operations( 0, 10, 3 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_set_operations( 5, 7, 4 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_set_operations( 30, 20, 5 ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( test_set_operations( 100, 100, 6 ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
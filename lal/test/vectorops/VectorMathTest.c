@@ -38,6 +38,7 @@
 #define Relerr(dx,x) (fabsf(x)>0 ? fabsf((dx)/(x)) : fabsf(dx) )
 #define Relerrd(dx,x) (fabs(x)>0 ? fabs((dx)/(x)) : fabs(dx) )
 #define cRelerr(dx,x) (cabsf(x)>0 ? cabsf((dx)/(x)) : fabsf(dx) )
+#define zRelerr(dx,x) (cabs(x)>0 ? fabs((dx)/cabs(x)) : fabs(dx) )
 
 // ----- test and benchmark operators with 1 REAL4 vector input and 1 REAL4 vector output (S2S) ----------
 #define TESTBENCH_VECTORMATH_S2S(name,in)                               \
@@ -184,8 +185,8 @@
     maxErr = maxRelerr = 0;                                             \
     for ( UINT4 i = 0; i < Ntrials; i ++ )                              \
     {                                                                   \
-      REAL8 err = fabs ( xOut[i] - xOutRef[i] );                      \
-      REAL8 relerr = Relerrd ( err, xOutRef[i] );                       \
+      REAL8 err = fabs ( xOutD[i] - xOutRefD[i] );                      \
+      REAL8 relerr = Relerrd ( err, xOutRefD[i] );                       \
       maxErr    = fmax ( err, maxErr );                                \
       maxRelerr = fmax ( relerr, maxRelerr );                          \
     }                                                                   \
@@ -195,6 +196,106 @@
     XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxRelerr, reltol ); \
   }
 
+// ----- test and benchmark operators with 1 REAL8 vector input and 2 REAL8 vector outputs (D2DD) ----------
+#define TESTBENCH_VECTORMATH_D2DD(name,in)                              \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##REAL8_GEN( xOutRefD, xOutRef2D, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##REAL8( xOutD, xOut2D, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ ) {                            \
+      REAL8 err1 = fabs ( xOutD[i] - xOutRefD[i] );                     \
+      REAL8 err2 = fabs ( xOut2D[i] - xOutRef2D[i] );                   \
+      REAL8 relerr1 = Relerrd ( err1, xOutRefD[i] );                    \
+      REAL8 relerr2 = Relerrd ( err2, xOutRef2D[i] );                   \
+      maxErr    = fmax ( err1, maxErr );                                \
+      maxErr    = fmax ( err2, maxErr );                                \
+      maxRelerr = fmax ( relerr1, maxRelerr );                          \
+      maxRelerr = fmax ( relerr2, maxRelerr );                          \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##REAL8_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark operators with 2 COMPLEX16 inputs and 1 COMPLEX16 vector output (ZZ2Z) ----------
+#define TESTBENCH_VECTORMATH_ZZ2Z(name,in1,in2)                         \
+  {                                                                     \
+    XLAL_CHECK ( XLALVector##name##COMPLEX16_GEN( xOutRefZ, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##COMPLEX16( xOutZ, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = maxRelerr = 0;                                             \
+    for ( UINT4 i = 0; i < Ntrials; i ++ )                              \
+    {                                                                   \
+      REAL8 err = cabs ( xOutZ[i] - xOutRefZ[i] );                      \
+      REAL8 relerr = zRelerr ( err, xOutRefZ[i] );                      \
+      maxErr    = fmax ( err, maxErr );                                 \
+      maxRelerr = fmax ( relerr, maxRelerr );                           \
+    }                                                                   \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxErr = %7.2g (tol=%7.2g), maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##COMPLEX16_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxErr, (abstol), maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxErr <= (abstol)), XLAL_ETOL, "%s: absolute error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxErr, abstol ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark reductions of 1 REAL8 vector input to 1 REAL8 scalar output (D2d) ----------
+#define TESTBENCH_VECTORMATH_D2d(name,in)                               \
+  {                                                                     \
+    REAL8 xSum = 0, xSumRef = 0;                                        \
+    XLAL_CHECK ( XLALVector##name##REAL8_GEN( &xSumRef, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##REAL8( &xSum, in, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = fabs ( xSum - xSumRef );                                   \
+    maxRelerr = Relerrd ( maxErr, xSumRef );                            \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##REAL8_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark reductions of 2 REAL8 vector inputs to 1 REAL8 scalar output (DD2d) ----------
+#define TESTBENCH_VECTORMATH_DD2d(name,in1,in2)                         \
+  {                                                                     \
+    REAL8 xSum = 0, xSumRef = 0;                                        \
+    XLAL_CHECK ( XLALVector##name##REAL8_GEN( &xSumRef, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##REAL8( &xSum, in1, in2, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = fabs ( xSum - xSumRef );                                   \
+    maxRelerr = Relerrd ( maxErr, xSumRef );                            \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##REAL8_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "REAL8", maxRelerr, reltol ); \
+  }
+
+// ----- test and benchmark reductions of 2 COMPLEX16 and 1 REAL8 vector inputs to 1 COMPLEX16 scalar output (ZZD2z) ----------
+#define TESTBENCH_VECTORMATH_ZZD2z(name,in1,in2,in3)                    \
+  {                                                                     \
+    COMPLEX16 xSum = 0, xSumRef = 0;                                    \
+    XLAL_CHECK ( XLALVector##name##COMPLEX16_GEN( &xSumRef, in1, in2, in3, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    tic = XLALGetCPUTime();                                             \
+    for (UINT4 l=0; l < Nruns; l ++ ) {                                 \
+      XLAL_CHECK ( XLALVector##name##COMPLEX16( &xSum, in1, in2, in3, Ntrials ) == XLAL_SUCCESS, XLAL_EFUNC ); \
+    }                                                                   \
+    toc = XLALGetCPUTime();                                             \
+    maxErr = cabs ( xSum - xSumRef );                                   \
+    maxRelerr = zRelerr ( maxErr, xSumRef );                            \
+    XLALPrintInfo ( "%-32s: %4.0f Mops/sec [maxRelerr = %7.2g (tol=%7.2g)]\n", \
+                    XLALVector##name##COMPLEX16_name, (REAL8)Ntrials * Nruns / (toc - tic)/1e6, maxRelerr, (reltol) ); \
+    XLAL_CHECK ( (maxRelerr <= (reltol)), XLAL_ETOL, "%s: relative error (%g) exceeds tolerance (%g)\n", #name "COMPLEX16", maxRelerr, reltol ); \
+  }
+
 // local types
 typedef struct
 {
@@ -254,17 +355,21 @@ main ( int argc, char *argv[] )
   XLAL_CHECK ( ( xOutU4 = XLALCreateUINT4Vector ( Ntrials )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xOutRefU4 = XLALCreateUINT4Vector ( Ntrials )) != NULL, XLAL_EFUNC );
 
-  REAL8VectorAligned *xInD_a, *xIn2D_a, *xOutD_a, *xOutRefD_a;
+  REAL8VectorAligned *xInD_a, *xIn2D_a, *xOutD_a, *xOut2D_a, *xOutRefD_a, *xOutRef2D_a;
   XLAL_CHECK ( ( xInD_a   = XLALCreateREAL8VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xIn2D_a  = XLALCreateREAL8VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( ( xOutD_a  = XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xOut2D_a = XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
   XLAL_CHECK ( (xOutRefD_a= XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( (xOutRef2D_a= XLALCreateREAL8VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
 
   // extract aligned REAL8 vectors from these
   REAL8 *xInD      = xInD_a->data;
   REAL8 *xIn2D     = xIn2D_a->data;
   REAL8 *xOutD     = xOutD_a->data;
+  REAL8 *xOut2D    = xOut2D_a->data;
   REAL8 *xOutRefD  = xOutRefD_a->data;
+  REAL8 *xOutRef2D = xOutRef2D_a->data;
 
   COMPLEX8VectorAligned *xInC_a, *xIn2C_a, *xOutC_a, *xOutRefC_a;
   XLAL_CHECK ( ( xInC_a   = XLALCreateCOMPLEX8VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
@@ -278,6 +383,18 @@ main ( int argc, char *argv[] )
   COMPLEX8 *xOutC     = xOutC_a->data;
   COMPLEX8 *xOutRefC  = xOutRefC_a->data;
 
+  COMPLEX16VectorAligned *xInZ_a, *xIn2Z_a, *xOutZ_a, *xOutRefZ_a;
+  XLAL_CHECK ( ( xInZ_a   = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xIn2Z_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->inAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( ( xOutZ_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( (xOutRefZ_a  = XLALCreateCOMPLEX16VectorAligned ( Ntrials, uvar->outAlign )) != NULL, XLAL_EFUNC );
+
+  // extract aligned COMPLEX16 vectors from these
+  COMPLEX16 *xInZ      = xInZ_a->data;
+  COMPLEX16 *xIn2Z     = xIn2Z_a->data;
+  COMPLEX16 *xOutZ     = xOutZ_a->data;
+  COMPLEX16 *xOutRefZ  = xOutRefZ_a->data;
+
 
   REAL8 tic, toc;
   REAL4 maxErr = 0, maxRelerr = 0;
@@ -356,6 +473,57 @@ main ( int argc, char *argv[] )
   TESTBENCH_VECTORMATH_CC2C(Scale,xInC[0],xIn2C);
   TESTBENCH_VECTORMATH_CC2C(Shift,xInC[0],xIn2C);
 
+  // ==================== REAL8 SIN(),COS(),SINCOS() ====================
+  XLALPrintInfo ("\nTesting double-precision sin(x), cos(x) for x in [-1000, 1000]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i] = 2000 * ( frand() - 0.5 );
+  }
+  abstol = 1e-15, reltol = 1e-12;
+  TESTBENCH_VECTORMATH_D2D(Sin,xInD);
+  TESTBENCH_VECTORMATH_D2D(Cos,xInD);
+  TESTBENCH_VECTORMATH_D2DD(SinCos,xInD);
+
+  // ==================== REAL8 EXP() ====================
+  XLALPrintInfo ("\nTesting double-precision exp(x) for x in [-10, 10]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i] = 20 * ( frand() - 0.5 );
+  }
+  abstol = 1e-10, reltol = 1e-15;
+  TESTBENCH_VECTORMATH_D2D(Exp,xInD);
+
+  // ==================== REAL8 LOG() ====================
+  XLALPrintInfo ("\nTesting double-precision log(x) for x in (0, 10000]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i] = 10000.0 * frand() + 1e-6;
+  }
+  abstol = 1e-14, reltol = 1e-15;
+  TESTBENCH_VECTORMATH_D2D(Log,xInD);
+
+  // ==================== COMPLEX16 MULTIPLY,SCALE ====================
+  XLALPrintInfo ("\nTesting double-precision complex multiply,scale(x,y) for x,y in (-10000, 10000]\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInZ[i] = -10000.0 + 20000.0 * frand() + 1e-6 + ( -10000.0 + 20000.0 * frand() + 1e-6 ) * _Complex_I;
+    xIn2Z[i]= -10000.0 + 20000.0 * frand() + 1e-6 + ( -10000.0 + 20000.0 * frand() + 1e-6 ) * _Complex_I;
+  } // for i < Ntrials
+  abstol = 1e-7, reltol = 1e-15;
+  TESTBENCH_VECTORMATH_ZZ2Z(Multiply,xInZ,xIn2Z);
+  TESTBENCH_VECTORMATH_ZZ2Z(MultiplyConj,xInZ,xIn2Z);
+  TESTBENCH_VECTORMATH_ZZ2Z(Scale,xInZ[0],xIn2Z);
+
+  // ==================== REAL8,COMPLEX16 REDUCTIONS ====================
+  XLALPrintInfo ("\nTesting sum(x), dot(x,y) for x,y in (0, 1], and weighted inner product\n");
+  for ( UINT4 i = 0; i < Ntrials; i ++ ) {
+    xInD[i]  = frand() + 1e-6;
+    xIn2D[i] = frand() + 1e-6;
+    xInZ[i] = frand() - 0.5 + ( frand() - 0.5 ) * _Complex_I;
+    xIn2Z[i]= xInZ[i] + 0.1 * ( frand() - 0.5 + ( frand() - 0.5 ) * _Complex_I );
+  } // for i < Ntrials
+  // reference sums are accumulated sequentially, so differ from vectorised sums by O(Ntrials * epsilon)
+  reltol = 1e-10;
+  TESTBENCH_VECTORMATH_D2d(Sum,xInD);
+  TESTBENCH_VECTORMATH_DD2d(Dot,xInD,xIn2D);
+  TESTBENCH_VECTORMATH_ZZD2z(WeightedInnerProduct,xInZ,xIn2Z,xIn2D);
+
   // ==================== FIND ====================
   for ( UINT4 i = 0; i < Ntrials; i ++ ) {
     xIn[i]  = -10000.0f + 20000.0f * frand() + 1e-6;
@@ -384,13 +552,20 @@ main ( int argc, char *argv[] )
   XLALDestroyREAL8VectorAligned ( xInD_a );
   XLALDestroyREAL8VectorAligned ( xIn2D_a );
   XLALDestroyREAL8VectorAligned ( xOutD_a );
+  XLALDestroyREAL8VectorAligned ( xOut2D_a );
   XLALDestroyREAL8VectorAligned ( xOutRefD_a );
+  XLALDestroyREAL8VectorAligned ( xOutRef2D_a );
 
   XLALDestroyCOMPLEX8VectorAligned ( xInC_a );
   XLALDestroyCOMPLEX8VectorAligned ( xIn2C_a );
   XLALDestroyCOMPLEX8VectorAligned ( xOutC_a );
   XLALDestroyCOMPLEX8VectorAligned ( xOutRefC_a );
 
+  XLALDestroyCOMPLEX16VectorAligned ( xInZ_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xIn2Z_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xOutZ_a );
+  XLALDestroyCOMPLEX16VectorAligned ( xOutRefZ_a );
+
   XLALDestroyUserVars();
 
   LALCheckMemoryLeaks();
@@ -1828,6 +1828,7 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
     char filename[FILENAME_MAX];
     FILE *out;
     UINT4 ui;
+    UINT4 ifo = 0;
 
     snprintf(filename, sizeof(filename), "freqTemplatehPlus.dat");
     out = fopen(filename, "w");
@@ -1855,8 +1856,8 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
         for (ui = 0; ui < model->freqhCross->data->length; ui++) {
             REAL8 f = model->freqhCross->deltaF * ui;
             COMPLEX16 d;
-            d = data->fPlus * model->freqhPlus->data->data[ui] +
-            data->fCross * model->freqhCross->data->data[ui];
+            d = model->ifo_fPlus[ifo] * model->freqhPlus->data->data[ui] +
+            model->ifo_fCross[ifo] * model->freqhCross->data->data[ui];
 
             fprintf(out, "%g %g %g\n", f, creal(d), cimag(d) );
         }
@@ -1866,9 +1867,9 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
         out = fopen(filename, "w");
         for (ui = 0; ui < model->timehCross->data->length; ui++) {
             REAL8 tt = XLALGPSGetREAL8(&(model->timehCross->epoch)) +
-            data->timeshift + ui*model->timehCross->deltaT;
-            REAL8 d = data->fPlus*model->timehPlus->data->data[ui] +
-            data->fCross*model->timehCross->data->data[ui];
+            model->ifo_timeshifts[ifo] + ui*model->timehCross->deltaT;
+            REAL8 d = model->ifo_fPlus[ifo]*model->timehPlus->data->data[ui] +
+            model->ifo_fCross[ifo]*model->timehCross->data->data[ui];
 
             fprintf(out, "%.6f %g\n", tt, d);
         }
@@ -1897,6 +1898,7 @@ void LALInferenceDataDump(LALInferenceIFOData *data, LALInferenceModel *model) {
         fclose(out);
 
         data = data->next;
+        ifo++;
     }
 }
 
@@ -39,6 +39,7 @@ REAL8 XLALGetCurrentHeapUsageMB ( void );
 typedef struct
 {
   int FstatMethod;		//!< select which method/algorithm to use to compute the F-statistic
+  BOOLEAN allMethods;		//!< benchmark all available F-statistic methods
   REAL8Range Alpha;
   REAL8Range Delta;
   REAL8Range Freq;
@@ -130,6 +131,7 @@ main ( int argc, char *argv[] )
   uvar->outputInfo = NULL;
 
   XLAL_CHECK ( XLALRegisterUvarAuxDataMember ( FstatMethod, UserEnum, XLALFstatMethodChoices(), 0, OPTIONAL, "F-statistic method to use" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( allMethods,     BOOLEAN,        0, OPTIONAL,  "Benchmark all available F-statistic methods on the same trials (overrides 'FstatMethod'), and report tauF for each" ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( Alpha,          RAJRange,       0, OPTIONAL,  "Skyposition [drawn isotropically]: Range in 'Alpha' = right ascension)" ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( Delta,          DECJRange,      0, OPTIONAL,  "Skyposition [drawn isotropically]: Range in 'Delta' = declination" ) == XLAL_SUCCESS, XLAL_EFUNC );
   XLAL_CHECK_MAIN ( XLALRegisterUvarMember ( Freq,           REAL8Range,     0, OPTIONAL,  "Search frequency in Hz [range to draw from]" ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -239,6 +241,37 @@ main ( int argc, char *argv[] )
       fprintf ( timingParFILE, "%%%%%8s %20s %20s %20s %20s %20s %20s %20s %20s %12s %20s %20s %20s %20s %20s\n",
                 "Nseg", "Tseg", "Freq", "FreqBand", "dFreq", "f1dot", "f2dot", "Alpha", "Delta", "memUsageMB", "asini", "period", "ecc", "argp", "tp" );
     }
+  // ----- list of F-statistic methods to benchmark
+  FstatMethodType methods[FMETHOD_END];
+  UINT4 numMethods = 0;
+  if ( uvar->allMethods )
+    {
+      for ( FstatMethodType m = FMETHOD_START + 1; m < FMETHOD_END; m ++ )
+        {
+          if ( (m == FMETHOD_DEMOD_BEST) || (m == FMETHOD_RESAMP_BEST) || !XLALFstatMethodIsAvailable ( m ) ) {
+            continue;
+          }
+          // skip hotloop variants which do not support the requested number of Dirichlet terms
+          if ( ( (m == FMETHOD_DEMOD_SSE) || (m == FMETHOD_DEMOD_ALTIVEC) ) && (uvar->Dterms != 8) ) {
+            continue;
+          }
+          if ( (m == FMETHOD_DEMOD_OPTC) && (uvar->Dterms > 20) ) {
+            continue;
+          }
+          methods[numMethods++] = m;
+        }
+    }
+  else
+    {
+      methods[numMethods++] = uvar->FstatMethod;
+    }
+  // per-method timing averaged over segments and trials
+  REAL8 tauF_eff_sum[FMETHOD_END], tauF_core_sum[FMETHOD_END];
+  UINT4 tauF_count[FMETHOD_END];
+  XLAL_INIT_MEM ( tauF_eff_sum );
+  XLAL_INIT_MEM ( tauF_core_sum );
+  XLAL_INIT_MEM ( tauF_count );
+
   FstatInputVector *inputs;
   FstatQuantities whatToCompute = (FSTATQ_2F | FSTATQ_2F_PER_DET);
   FstatResults *results = NULL;
@@ -293,8 +326,6 @@ main ( int argc, char *argv[] )
       REAL8 dFreq_i          = FreqResolution_i / Tseg_i;
       REAL8 FreqBand_i       = numFreqBins_i * dFreq_i;
 
-      XLAL_CHECK_MAIN ( (inputs = XLALCreateFstatInputVector ( uvar->numSegments )) != NULL, XLAL_EFUNC );
-
       fprintf ( stderr, "trial %d/%d: Tseg = %.1f d, numSegments = %d, Alpha = %.2f rad, Delta = %.2f rad, Freq = %.6f Hz, f1dot = %.1e Hz/s, f2dot = %.1e Hz/s^2, R = %.2f, numFreqBins = %d, asini = %.2f, period = %.2f, ecc = %.2f, argp = %.2f, tp=%"LAL_GPS_FORMAT" [dFreq = %.2e Hz, FreqBand = %.2e Hz]\n",
                i+1, uvar->numTrials, Tseg_i / 86400.0, uvar->numSegments, Doppler_i.Alpha, Doppler_i.Delta, Doppler_i.fkdot[0], Doppler_i.fkdot[1], Doppler_i.fkdot[2], FreqResolution_i, numFreqBins_i, Doppler_i.asini, Doppler_i.period, Doppler_i.ecc, Doppler_i.argp,LAL_GPS_PRINT(Doppler_i.tp), dFreq_i, FreqBand_i );
 
@@ -304,54 +335,84 @@ main ( int argc, char *argv[] )
       if ( ! uvar->perSegmentSFTs ) {
         XLAL_CHECK_MAIN ( XLALCWSignalCoveringBand ( &minCoverFreq_il, &maxCoverFreq_il, &startTime_l->data[0], &endTime_l->data[uvar->numSegments-1], &spinRange_i, Doppler_i.asini, Doppler_i.period, Doppler_i.ecc ) == XLAL_SUCCESS, XLAL_EFUNC );
       }
-      // create per-segment input structs
-      for ( INT4 l = 0; l < uvar->numSegments; l ++ )
+
+      // ---------- loop over F-statistic methods to benchmark on this trial ----------
+      for ( UINT4 iMethod = 0; iMethod < numMethods; iMethod ++ )
         {
-          if ( uvar->sharedWorkspace && l > 0 ) {
-            optionalArgs.prevInput = inputs->data[0];
-          } else {
-            optionalArgs.prevInput = NULL;
-          }
-          // Weave convention: determine per-segment SFT frequency band
-          if ( uvar->perSegmentSFTs ) {
-            XLAL_CHECK_MAIN ( XLALCWSignalCoveringBand ( &minCoverFreq_il, &maxCoverFreq_il, &startTime_l->data[l], &endTime_l->data[l], &spinRange_i, Doppler_i.asini, Doppler_i.period, Doppler_i.ecc ) == XLAL_SUCCESS, XLAL_EFUNC );
-            // fprintf ( stderr, "minCoverFreq = %.16g, maxCoverFreq = %.16g: startTime = %d, Tseg = %d, FreqMax = %.16g, f1dot = %.16g, f2dot = %.16g, refTime = %d = %d + %d\n",
-            // minCoverFreq_il, maxCoverFreq_il, startTime_l->data[l].gpsSeconds, Tseg_i, spinRange_i.fkdot[0] + spinRange_i.fkdotBand[0], spinRange_i.fkdot[1], spinRange_i.fkdot[2],
-            // refTime.gpsSeconds, startTime_l->data[l].gpsSeconds, refTime.gpsSeconds - startTime_l->data[l].gpsSeconds );
-          }
-          XLAL_CHECK_MAIN ( (inputs->data[l] = XLALCreateFstatInput ( catalogs[l], minCoverFreq_il, maxCoverFreq_il, dFreq_i, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
-        }
+          optionalArgs.FstatMethod = methods[iMethod];
+          XLAL_CHECK_MAIN ( (inputs = XLALCreateFstatInputVector ( uvar->numSegments )) != NULL, XLAL_EFUNC );
+
+          // create per-segment input structs
+          for ( INT4 l = 0; l < uvar->numSegments; l ++ )
+            {
+              if ( uvar->sharedWorkspace && l > 0 ) {
+                optionalArgs.prevInput = inputs->data[0];
+              } else {
+                optionalArgs.prevInput = NULL;
+              }
+              // Weave convention: determine per-segment SFT frequency band
+              if ( uvar->perSegmentSFTs ) {
+                XLAL_CHECK_MAIN ( XLALCWSignalCoveringBand ( &minCoverFreq_il, &maxCoverFreq_il, &startTime_l->data[l], &endTime_l->data[l], &spinRange_i, Doppler_i.asini, Doppler_i.period, Doppler_i.ecc ) == XLAL_SUCCESS, XLAL_EFUNC );
+              }
+              XLAL_CHECK_MAIN ( (inputs->data[l] = XLALCreateFstatInput ( catalogs[l], minCoverFreq_il, maxCoverFreq_il, dFreq_i, ephem, &optionalArgs )) != NULL, XLAL_EFUNC );
+            }
+
+          // ----- compute Fstatistics over segments
+          REAL8 tauF_eff_i = 0, tauF_core_i = 0;
+          for ( INT4 l = 0; l < uvar->numSegments; l ++ )
+            {
+              XLAL_CHECK_MAIN ( XLALComputeFstat ( &results, inputs->data[l], &Doppler_i, numFreqBins_i, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+              // ----- output timing details to file if requested
+              if ( timingLogFILE != NULL ) {
+                XLAL_CHECK_MAIN ( XLALAppendFstatTiming2File ( inputs->data[l], timingLogFILE, (l == 0) && (i==0) && (iMethod == 0) ) == XLAL_SUCCESS, XLAL_EFUNC );
+              }
+
+              FstatTimingGeneric XLAL_INIT_DECL(timingGeneric);
+              FstatTimingModel XLAL_INIT_DECL(timingModel);
+              XLAL_CHECK_MAIN ( XLALGetFstatTiming ( inputs->data[l], &timingGeneric, &timingModel ) == XLAL_SUCCESS, XLAL_EFUNC );
+              tauF_eff_i  += timingGeneric.tauF_eff;
+              tauF_core_i += timingGeneric.tauF_core;
+            } // for l < numSegments
+          tauF_eff_sum[methods[iMethod]]  += tauF_eff_i;
+          tauF_core_sum[methods[iMethod]] += tauF_core_i;
+          tauF_count[methods[iMethod]]    += uvar->numSegments;
+
+          REAL8 memEnd = XLALGetCurrentHeapUsageMB();
+          REAL8 memUsage = memEnd - memBase;
+          const char *FmethodName = XLALGetFstatInputMethodName ( inputs->data[0] );
+          fprintf (stderr, "%-15s: memoryUsage = %6.1f MB, tauF_eff = %.3e s, tauF_core = %.3e s\n", FmethodName, memUsage,
+                   tauF_eff_i / uvar->numSegments, tauF_core_i / uvar->numSegments );
+
+          if ( timingParFILE != NULL )
+            {
+              fprintf ( timingParFILE, "%10d %20d %20.16g %20.16g %20.16g %20.16g %20.16g %20.16g %20.16g %12g %20.16g %20.16g %20.16g %20.16g %"LAL_GPS_FORMAT"\n",
+                        uvar->numSegments, Tseg_i, Doppler_i.fkdot[0], FreqBand_i, dFreq_i, Doppler_i.fkdot[1], Doppler_i.fkdot[2], Doppler_i.Alpha, Doppler_i.Delta, memUsage,Doppler_i.asini, Doppler_i.period, Doppler_i.ecc, Doppler_i.argp,LAL_GPS_PRINT(Doppler_i.tp)
+                        );
+            }
+
+          XLALDestroyFstatInputVector ( inputs );
+        } // for iMethod < numMethods
+
       for ( INT4 l = 0; l < uvar->numSegments; l ++ ) {
         XLALDestroySFTCatalog ( catalogs[l] );
       }
       XLALFree ( catalogs );
+    } // for i < numTrials
 
-      // ----- compute Fstatistics over segments
-      for ( INT4 l = 0; l < uvar->numSegments; l ++ )
+  // ----- summary of timings per method
+  if ( numMethods > 1 || uvar->numTrials > 1 )
+    {
+      fprintf ( stderr, "%%%% %-13s %15s %15s\n", "FstatMethod", "tauF_eff[s]", "tauF_core[s]" );
+      for ( UINT4 iMethod = 0; iMethod < numMethods; iMethod ++ )
         {
-          XLAL_CHECK_MAIN ( XLALComputeFstat ( &results, inputs->data[l], &Doppler_i, numFreqBins_i, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
-
-          // ----- output timing details to file if requested
-          if ( timingLogFILE != NULL ) {
-            XLAL_CHECK_MAIN ( XLALAppendFstatTiming2File ( inputs->data[l], timingLogFILE, (l == 0) && (i==0)) == XLAL_SUCCESS, XLAL_EFUNC );
+          FstatMethodType m = methods[iMethod];
+          if ( tauF_count[m] == 0 ) {
+            continue;
           }
-        } // for l < numSegments
-
-      REAL8 memEnd = XLALGetCurrentHeapUsageMB();
-      REAL8 memUsage = memEnd - memBase;
-      const char *FmethodName = XLALGetFstatInputMethodName ( inputs->data[0] );
-      fprintf (stderr, "%-15s: memoryUsage = %6.1f MB\n", FmethodName, memUsage );
-
-      if ( timingParFILE != NULL )
-        {
-          fprintf ( timingParFILE, "%10d %20d %20.16g %20.16g %20.16g %20.16g %20.16g %20.16g %20.16g %12g %20.16g %20.16g %20.16g %20.16g %"LAL_GPS_FORMAT"\n",
-                    uvar->numSegments, Tseg_i, Doppler_i.fkdot[0], FreqBand_i, dFreq_i, Doppler_i.fkdot[1], Doppler_i.fkdot[2], Doppler_i.Alpha, Doppler_i.Delta, memUsage,Doppler_i.asini, Doppler_i.period, Doppler_i.ecc, Doppler_i.argp,LAL_GPS_PRINT(Doppler_i.tp)
-                    );
+          fprintf ( stderr, "   %-13s %15.3e %15.3e\n", XLALFstatMethodName ( m ), tauF_eff_sum[m] / tauF_count[m], tauF_core_sum[m] / tauF_count[m] );
         }
-
-      fprintf (stderr, "%-15s: memoryUsage = %6.1f MB\n", FmethodName, memEnd - memBase );
-      XLALDestroyFstatInputVector ( inputs );
-    } // for i < numTrials
+    }
 
   // ----- free memory ----------
   if ( timingLogFILE != NULL ) {
@@ -169,6 +169,7 @@ typedef struct {
   FstatInputVector* Fstat_in_vec_recalc; /**< Recalculate the toplist: Vector of Fstat input data structures for XLALComputeFstat(), one per stack */
   PulsarParamsVector *injectionSources; ///< Source parameters to inject: comma-separated list of file-patterns and/or direct config-strings ('{...}')
   BOOLEAN collectFstatTiming;		///< flag whether to collect and output F-stat timing info
+  BOOLEAN validateSFTs;			///< flag whether to validate the CRC64 checksums of the SFTs
 } UsefulStageVariables;
 
 
@@ -384,6 +385,7 @@ int MAIN( int argc, char *argv[]) {
   BOOLEAN uvar_printFstat1 = FALSE;
   BOOLEAN uvar_loudestTwoFPerSeg = FALSE;	// output loudest per-segment Fstat candidates
   BOOLEAN uvar_semiCohToplist = TRUE; /* if overall first stage candidates are to be output */
+  BOOLEAN uvar_validateSFTs = TRUE; /* validate CRC64 checksums of SFTs before loading them */
 
   LALStringVector* uvar_assumeSqrtSX = NULL;    /* Assume stationary Gaussian noise with detector noise-floors sqrt{SX}" */
   BOOLEAN uvar_SignalOnly = FALSE;              /* DEPRECATED: ALTERNATIVE switch to assume Sh=1 instead of estimating noise-floors from SFTs */
@@ -566,6 +568,8 @@ int MAIN( int argc, char *argv[]) {
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_outputTiming,        "outputTiming",        STRING,       0,   DEVELOPER,  "Append timing information into this file") == XLAL_SUCCESS, XLAL_EFUNC);
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_outputTimingDetails, "outputTimingDetails", STRING,       0,   DEVELOPER,  "Append detailed averaged F-stat timing information to this file") == XLAL_SUCCESS, XLAL_EFUNC);
 
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_validateSFTs,        "validateSFTs",        BOOLEAN,      0, DEVELOPER, "Validate the CRC64 checksums of all SFTs before loading them" ) == XLAL_SUCCESS, XLAL_EFUNC );
+
   XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &uvar_loudestTwoFPerSeg,   "loudestTwoFPerSeg",   BOOLEAN,      0, DEVELOPER, "Output loudest per-segment Fstat values into file '_loudestTwoFPerSeg'" ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   /* inject signals into the data being analyzed */
@@ -729,6 +733,7 @@ int MAIN( int argc, char *argv[]) {
 
   tic_Start = GETTIME();
   usefulParams.collectFstatTiming = ( uvar_outputTimingDetails != NULL );
+  usefulParams.validateSFTs = uvar_validateSFTs;
 
   /* initializations of coarse and fine grids */
   coarsegrid.TwoF=NULL;
@@ -2141,11 +2146,13 @@ void SetUpSFTs( LALStatus *status,			/**< pointer to LALStatus structure */
   constraints.maxStartTime = &(in->maxStartTimeGPS);
   XLAL_CHECK_LAL( status, ( catalog = XLALSFTdataFind( in->sftbasename, &constraints) ) != NULL, XLAL_EFUNC);
 
-  /* check CRC sums of SFTs */
-  XLAL_CHECK_LAL ( status, XLALCheckCRCSFTCatalog ( &crc_check, catalog ) == XLAL_SUCCESS, XLAL_EFUNC );
-  if (!crc_check) {
-    LogPrintf(LOG_CRITICAL,"SFT validity check failed\n");
-    ABORT ( status, HIERARCHICALSEARCH_ESFT, HIERARCHICALSEARCH_MSGESFT );
+  /* check CRC sums of SFTs, if requested */
+  if ( in->validateSFTs ) {
+    XLAL_CHECK_LAL ( status, XLALCheckCRCSFTCatalog ( &crc_check, catalog ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if (!crc_check) {
+      LogPrintf(LOG_CRITICAL,"SFT validity check failed\n");
+      ABORT ( status, HIERARCHICALSEARCH_ESFT, HIERARCHICALSEARCH_MSGESFT );
+    }
   }
 
   /* set some sft parameters */
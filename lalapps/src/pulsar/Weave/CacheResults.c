@@ -446,6 +446,9 @@ int XLALWeaveCacheQueriesInit(
 ///
 /// Query a cache for the results nearest to a given coherent point
 ///
+/// Queries of different caches may be made concurrently from different threads,
+/// provided that each thread uses a different \c query_index.
+///
 int XLALWeaveCacheQuery(
   const WeaveCache *cache,
   WeaveCacheQueries *queries,
@@ -849,6 +852,9 @@ int XLALWeaveCacheClear(
 ///
 /// Retrieve coherent results for a given query, or compute new coherent results if not found
 ///
+/// Retrievals from different caches may be made concurrently from different threads, provided
+/// that each thread uses a different \c query_index and passes a \c NULL search timing \c tim.
+///
 int XLALWeaveCacheRetrieve(
   WeaveCache *cache,
   const WeaveCacheQueries *queries,
@@ -866,7 +872,6 @@ int XLALWeaveCacheRetrieve(
   XLAL_CHECK( query_index < queries->nqueries, XLAL_EINVAL );
   XLAL_CHECK( coh_res != NULL, XLAL_EFAULT );
   XLAL_CHECK( coh_offset != NULL, XLAL_EFAULT );
-  XLAL_CHECK( tim != NULL, XLAL_EFAULT );
 
   // See if coherent results are already cached
   const cache_item find_key = { .generation = cache->generation, .coh_index = queries->coh_index[query_index] };
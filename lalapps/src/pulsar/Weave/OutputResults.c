@@ -28,6 +28,10 @@
 
 #include <lal/UserInputPrint.h>
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 ///
 /// Output results from a search
 ///
@@ -248,18 +252,20 @@ void XLALWeaveOutputResultsDestroy(
 }
 
 ///
-/// Add semicoherent results to output
+/// Add semicoherent results to output, using up to 'nthreads' threads
 ///
 int XLALWeaveOutputResultsAdd(
   WeaveOutputResults *out,
   const WeaveSemiResults *semi_res,
-  const UINT4 semi_nfreqs
+  const UINT4 semi_nfreqs,
+  const int nthreads
   )
 {
 
   // Check input
   XLAL_CHECK( out != NULL, XLAL_EFAULT );
   XLAL_CHECK( semi_res != NULL, XLAL_EFAULT );
+  XLAL_CHECK( nthreads > 0, XLAL_EINVAL );
 
   // Store main-loop parameters relevant for completion-loop statistics calculation
   static BOOLEAN firstTime = 1;
@@ -270,9 +276,17 @@ int XLALWeaveOutputResultsAdd(
   }
 
   // Add results to toplists
+  // - Toplists are independent of each other, so are shared out between threads; each toplist
+  //   sees semicoherent results in the same order, and so is independent of the number of threads
+  int errcode = XLAL_SUCCESS;
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if (nthreads > 1 && out->ntoplists > 1)
   for ( size_t i = 0; i < out->ntoplists; ++i ) {
-    XLAL_CHECK( XLALWeaveResultsToplistAdd( out->toplists[i], semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    if ( XLALWeaveResultsToplistAdd( out->toplists[i], semi_res, semi_nfreqs ) != XLAL_SUCCESS ) {
+      errcode = XLAL_EFUNC;
+#pragma omp flush(errcode)
+    }
   }
+  XLAL_CHECK( errcode == XLAL_SUCCESS, errcode );
 
   return XLAL_SUCCESS;
 
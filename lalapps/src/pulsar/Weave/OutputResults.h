@@ -50,7 +50,8 @@ void XLALWeaveOutputResultsDestroy(
 int XLALWeaveOutputResultsAdd(
   WeaveOutputResults *out,
   const WeaveSemiResults *semi_res,
-  const UINT4 semi_nfreqs
+  const UINT4 semi_nfreqs,
+  const int nthreads
   );
 int XLALWeaveOutputResultsCompletionLoop(
   WeaveOutputResults *out
@@ -0,0 +1,57 @@
+# Perform an interpolating search with one and several threads, and check for identical results
+
+export LAL_FSTAT_FFT_PLAN_MODE=ESTIMATE
+
+echo "=== Create search setup with 4 segments ==="
+set -x
+${builddir}/lalapps_WeaveSetup --first-segment=1122332211/90000 --segment-count=4 --detectors=H1,L1 --output-file=WeaveSetup.fits
+set +x
+echo
+
+echo "=== Restrict timestamps to segment list in WeaveSetup.fits ==="
+set -x
+${fitsdir}/lalapps_fits_table_list 'WeaveSetup.fits[segments][col c1=start_s; col2=end_s]' \
+    | awk 'BEGIN { print "/^#/ { print }" } /^#/ { next } { printf "%i <= $1 && $1 <= %i { print }\n", $1, $2 + 1 }' > timestamp-filter.awk
+awk -f timestamp-filter.awk ${srcdir}/timestamps-1.txt > timestamps-1.txt
+awk -f timestamp-filter.awk ${srcdir}/timestamps-2.txt > timestamps-2.txt
+set +x
+echo
+
+for threads in 1 3; do
+
+    echo "=== Perform interpolating search with ${threads} thread(s) ==="
+    set -x
+    ${builddir}/lalapps_Weave --threads=${threads} --output-file=WeaveOut${threads}.fits \
+        --toplists=all --toplist-limit=2321 --extra-statistics="coh2F,coh2F_det" --segment-info --setup-file=WeaveSetup.fits \
+        --rand-seed=3456 --sft-timebase=1800 --sft-noise-psd=1,1 --sft-timestamps-files=timestamps-1.txt,timestamps-2.txt \
+        --alpha=0.9/1.4 --delta=-1.2/2.3 --freq=50.5/0.01 --f1dot=-1.5e-9,0 --semi-max-mismatch=5 --coh-max-mismatch=0.3
+    set +x
+    echo
+
+done
+
+echo "=== Check that numbers of coherent results and templates are equal ==="
+set -x
+for key in NCOHRES NCOHTPL NSEMITPL; do
+    val_1=`${fitsdir}/lalapps_fits_header_getval "WeaveOut1.fits[0]" "${key}" | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+    val_3=`${fitsdir}/lalapps_fits_header_getval "WeaveOut3.fits[0]" "${key}" | tr '\n\r' '  ' | awk 'NF == 1 {printf "%d", $1}'`
+    expr ${val_1} '=' ${val_3}
+done
+set +x
+echo
+
+echo "=== Check that toplists are identical ==="
+set -x
+for stat in mean2F sum2F log10BSGL log10BSGLtL log10BtSGLtL; do
+    ${fitsdir}/lalapps_fits_table_list "WeaveOut1.fits[${stat}_toplist]" > WeaveOut1_${stat}.txt
+    ${fitsdir}/lalapps_fits_table_list "WeaveOut3.fits[${stat}_toplist]" > WeaveOut3_${stat}.txt
+    diff WeaveOut1_${stat}.txt WeaveOut3_${stat}.txt
+done
+set +x
+echo
+
+echo "=== Compare F-statistics from lalapps_Weave with one and several threads ==="
+set -x
+env LAL_DEBUG_LEVEL="${LAL_DEBUG_LEVEL},info" ${builddir}/lalapps_WeaveCompare --setup-file=WeaveSetup.fits --result-file-1=WeaveOut1.fits --result-file-2=WeaveOut3.fits
+set +x
+echo
@@ -34,6 +34,12 @@
 #include <lal/UserInput.h>
 #include <lal/Random.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#define omp ignore
+#endif
+
 int main( int argc, char *argv[] )
 {
 
@@ -52,7 +58,7 @@ int main( int argc, char *argv[] )
     LALStringVector *sft_timestamps_files, *sft_noise_psd, *injections, *Fstat_assume_psd, *lrs_oLGX;
     REAL8 sft_timebase, semi_max_mismatch, coh_max_mismatch, ckpt_output_period, ckpt_output_exit, lrs_Fstar0sc, nc_2Fth;
     REAL8Range alpha, delta, freq, f1dot, f2dot, f3dot, f4dot;
-    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size;
+    UINT4 sky_patch_count, sky_patch_index, freq_partitions, f1dot_partitions, Fstat_run_med_window, Fstat_Dterms, toplist_limit, rand_seed, cache_max_size, threads;
     int lattice, Fstat_method, Fstat_SSB_precision, toplists, extra_statistics, recalc_statistics;
   } uvar_struct = {
     .Fstat_Dterms = Fstat_opt_args.Dterms,
@@ -70,6 +76,7 @@ int main( int argc, char *argv[] )
     .extra_statistics = WEAVE_STATISTIC_NONE,
     .recalc_statistics = WEAVE_STATISTIC_NONE,
     .nc_2Fth = 5.2,
+    .threads = 1,
   };
   struct uvar_type *const uvar = &uvar_struct;
 
@@ -317,6 +324,13 @@ int main( int argc, char *argv[] )
     "If SFT parameters (i.e. " UVAR_STR( sft_files ) " or " UVAR_STR( sft_timebase ) ") are supplied, simulate search with full memory allocation, i.e. with F-statistic input data, cached coherent results, etc. "
     "Otherwise, perform search with minimal memory allocation, i.e. do not allocate memory for any data or results. "
     );
+  XLALRegisterUvarMember(
+    threads, UINT4, 0, OPTIONAL,
+    "Number of threads used in the main search loop, which compute coherent results for different segments in parallel, "
+    "and add semicoherent results to different toplists in parallel. All threads share the same SFT data, cached coherent results, and ephemerides. "
+    "If zero, use the default number of OpenMP threads. Output results do not depend on the number of threads. "
+    "Ignored if lalapps was not compiled with OpenMP support. "
+    );
   XLALRegisterUvarMember(
     time_search, BOOLEAN, 0, DEVELOPER,
     "Collect and output detailed timing information from various stages of the search pipeline. "
@@ -439,6 +453,17 @@ int main( int argc, char *argv[] )
   }
   LogPrintf( LOG_NORMAL, "Parsed user input successfully\n" );
 
+  // Decide number of threads used in main search loop
+#ifdef _OPENMP
+  const int nthreads = ( uvar->threads > 0 ) ? ( int ) uvar->threads : omp_get_max_threads();
+  LogPrintf( LOG_NORMAL, "Using %i thread(s) in main search loop\n", nthreads );
+#else
+  const int nthreads = 1;
+  if ( uvar->threads != 1 ) {
+    LogPrintf( LOG_NORMAL, "WARNING: lalapps was not compiled with OpenMP support; ignoring " UVAR_STR( threads ) "\n" );
+  }
+#endif
+
   // Allocate random number generator
   RandomParams *rand_par = XLALCreateRandomParams( uvar->rand_seed );
   XLAL_CHECK_MAIN( rand_par != NULL, XLAL_EFUNC );
@@ -935,9 +960,16 @@ int main( int argc, char *argv[] )
     XLAL_CHECK_MAIN( XLALWeaveCacheQueriesInit( queries, semi_index, semi_rssky, semi_left, semi_right, freq_partition_index ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     // Query for coherent results for each segment
+    // - Each segment has its own cache, and writes to its own query index, so segments are shared out between threads
+    int errcode = XLAL_SUCCESS;
+#pragma omp parallel for schedule(static) num_threads(nthreads) if (nthreads > 1)
     for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheQuery( coh_cache[i], queries, i ) == XLAL_SUCCESS, XLAL_EFUNC );
+      if ( XLALWeaveCacheQuery( coh_cache[i], queries, i ) != XLAL_SUCCESS ) {
+        errcode = XLAL_EFUNC;
+#pragma omp flush(errcode)
+      }
     }
+    XLAL_CHECK_MAIN( errcode == XLAL_SUCCESS, errcode );
 
     // Finalise cache queries
     PulsarDopplerParams XLAL_INIT_DECL( semi_phys );
@@ -952,12 +984,30 @@ int main( int argc, char *argv[] )
     XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_QUERY, WEAVE_SEARCH_TIMING_COH ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     // Retrieve coherent results from each segment
+    // - Segments are shared out between threads, as for the cache queries; when using more than
+    //   one thread, the computation of coherent results is timed here as a whole, since the
+    //   search timing structure can only be changed by one thread at a time
     const WeaveCohResults *XLAL_INIT_DECL( coh_res, [nsegments] );
     UINT8 XLAL_INIT_DECL( coh_index, [nsegments] );
     UINT4 XLAL_INIT_DECL( coh_offset, [nsegments] );
+    WeaveSearchTiming *coh_tim = ( nthreads > 1 ) ? NULL : tim;
+    if ( coh_tim == NULL ) {
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingStatistic( tim, WEAVE_STATISTIC_NONE, WEAVE_STATISTIC_COH2F ) == XLAL_SUCCESS, XLAL_EFUNC );
+    }
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads) if (nthreads > 1)
     for ( size_t i = 0; i < nsegments; ++i ) {
-      XLAL_CHECK_MAIN( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], tim ) == XLAL_SUCCESS, XLAL_EFUNC );
-      XLAL_CHECK_MAIN( coh_res[i] != NULL, XLAL_EFUNC );
+#pragma omp flush(errcode)
+      if ( errcode != XLAL_SUCCESS ) {
+        continue;
+      }
+      if ( XLALWeaveCacheRetrieve( coh_cache[i], queries, i, &coh_res[i], &coh_index[i], &coh_offset[i], coh_tim ) != XLAL_SUCCESS || coh_res[i] == NULL ) {
+        errcode = XLAL_EFUNC;
+#pragma omp flush(errcode)
+      }
+    }
+    XLAL_CHECK_MAIN( errcode == XLAL_SUCCESS, errcode );
+    if ( coh_tim == NULL ) {
+      XLAL_CHECK_MAIN( XLALWeaveSearchTimingStatistic( tim, WEAVE_STATISTIC_COH2F, WEAVE_STATISTIC_NONE ) == XLAL_SUCCESS, XLAL_EFUNC );
     }
 
     // Switch timing section
@@ -981,7 +1031,7 @@ int main( int argc, char *argv[] )
     XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_SEMI, WEAVE_SEARCH_TIMING_OUTPUT ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     // Add semicoherent results to output
-    XLAL_CHECK_MAIN( XLALWeaveOutputResultsAdd( out, semi_res, semi_nfreqs ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWeaveOutputResultsAdd( out, semi_res, semi_nfreqs, nthreads ) == XLAL_SUCCESS, XLAL_EFUNC );
 
     // Switch timing section
     XLAL_CHECK_MAIN( XLALWeaveSearchTimingSection( tim, WEAVE_SEARCH_TIMING_OUTPUT, WEAVE_SEARCH_TIMING_OTHER ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -31,385 +31,327 @@
 #include <lal/LIGOLwXMLRead.h>
 #include <lal/SnglBurstUtils.h>
 
-/**
- * Read the sngl_burst table from a LIGO Light Weight XML file into a
- * linked list of SnglBurst structures.
+/*
+ * Copy a string into a fixed-size row member, failing if it is too long.
  */
-SnglBurst *XLALSnglBurstTableFromLIGOLw(
-	const char *filename
-)
-{
-	static const char table_name[] = "sngl_burst";
-	int miostatus;
-	SnglBurst *head = NULL;
-	SnglBurst **next = &head;
-	struct MetaioParseEnvironment env;
-	struct {
-		int process_id;
-		int ifo;
-		int search;
-		int channel;
-		int start_time;
-		int start_time_ns;
-		int peak_time;
-		int peak_time_ns;
-		int duration;
-		int central_freq;
-		int bandwidth;
-		int amplitude;
-		int snr;
-		int confidence;
-		int chisq;
-		int chisq_dof;
-		int event_id;
-	} column_pos;
-
-	/* open the file and find table */
-
-	if(MetaioOpenFile(&env, filename)) {
-		XLALPrintError("%s(): error opening \"%s\": %s\n", __func__, filename, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
-		XLAL_ERROR_NULL(XLAL_EIO);
-	}
-	if(MetaioOpenTableOnly(&env, table_name)) {
-		MetaioAbort(&env);
-		XLALPrintError("%s(): cannot find %s table: %s\n", __func__, table_name, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
-		XLAL_ERROR_NULL(XLAL_EIO);
-	}
 
-	/* find columns */
-
-	XLALClearErrno();
-	column_pos.process_id = XLALLIGOLwFindColumn(&env, "process_id", METAIO_TYPE_ILWD_CHAR, 1);
-	column_pos.ifo = XLALLIGOLwFindColumn(&env, "ifo", METAIO_TYPE_LSTRING, 1);
-	column_pos.search = XLALLIGOLwFindColumn(&env, "search", METAIO_TYPE_LSTRING, 1);
-	column_pos.channel = XLALLIGOLwFindColumn(&env, "channel", METAIO_TYPE_LSTRING, 1);
-	column_pos.start_time = XLALLIGOLwFindColumn(&env, "start_time", METAIO_TYPE_INT_4S, 1);
-	column_pos.start_time_ns = XLALLIGOLwFindColumn(&env, "start_time_ns", METAIO_TYPE_INT_4S, 1);
-	column_pos.peak_time = XLALLIGOLwFindColumn(&env, "peak_time", METAIO_TYPE_INT_4S, 1);
-	column_pos.peak_time_ns = XLALLIGOLwFindColumn(&env, "peak_time_ns", METAIO_TYPE_INT_4S, 1);
-	column_pos.duration = XLALLIGOLwFindColumn(&env, "duration", METAIO_TYPE_REAL_4, 1);
-	column_pos.central_freq = XLALLIGOLwFindColumn(&env, "central_freq", METAIO_TYPE_REAL_4, 1);
-	column_pos.bandwidth = XLALLIGOLwFindColumn(&env, "bandwidth", METAIO_TYPE_REAL_4, 1);
-	column_pos.amplitude = XLALLIGOLwFindColumn(&env, "amplitude", METAIO_TYPE_REAL_4, 1);
-	column_pos.snr = XLALLIGOLwFindColumn(&env, "snr", METAIO_TYPE_REAL_4, 1);
-	column_pos.confidence = XLALLIGOLwFindColumn(&env, "confidence", METAIO_TYPE_REAL_4, 1);
-	column_pos.chisq = XLALLIGOLwFindColumn(&env, "chisq", METAIO_TYPE_REAL_8, 1);
-	column_pos.chisq_dof = XLALLIGOLwFindColumn(&env, "chisq_dof", METAIO_TYPE_REAL_8, 1);
-	column_pos.event_id = XLALLIGOLwFindColumn(&env, "event_id", METAIO_TYPE_ILWD_CHAR, 1);
-
-	/* check for failure (== a required column is missing) */
-
-	if(XLALGetBaseErrno()) {
-		MetaioAbort(&env);
-		XLALPrintError("%s(): failure reading %s table: missing required column\n", __func__, table_name);
-		XLAL_ERROR_NULL(XLAL_EFUNC);
+
+static int copy_string(char *dst, size_t size, const char *src, const char *table_name)
+{
+	if(strlen(src) >= size) {
+		XLALPrintError("%s(): failure reading %s table: string too long\n", __func__, table_name);
+		XLAL_ERROR(XLAL_EIO);
 	}
+	strncpy(dst, src, size - 1);
+	return 0;
+}
 
-	/* loop over the rows in the file */
 
-	while((miostatus = MetaioGetRow(&env)) > 0) {
-		/* create a new row */
+/*
+ * sngl_burst table
+ */
 
-		SnglBurst *row = XLALCreateSnglBurst();
 
-		if(!row) {
-			XLALDestroySnglBurstTable(head);
-			MetaioAbort(&env);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
+enum {
+	SNGL_BURST_PROCESS_ID,
+	SNGL_BURST_IFO,
+	SNGL_BURST_SEARCH,
+	SNGL_BURST_CHANNEL,
+	SNGL_BURST_START_TIME,
+	SNGL_BURST_START_TIME_NS,
+	SNGL_BURST_PEAK_TIME,
+	SNGL_BURST_PEAK_TIME_NS,
+	SNGL_BURST_DURATION,
+	SNGL_BURST_CENTRAL_FREQ,
+	SNGL_BURST_BANDWIDTH,
+	SNGL_BURST_AMPLITUDE,
+	SNGL_BURST_SNR,
+	SNGL_BURST_CONFIDENCE,
+	SNGL_BURST_CHISQ,
+	SNGL_BURST_CHISQ_DOF,
+	SNGL_BURST_EVENT_ID,
+	SNGL_BURST_NUM_COLUMNS
+};
+
+
+static const LIGOLwColumnSpec sngl_burst_columns[SNGL_BURST_NUM_COLUMNS] = {
+	[SNGL_BURST_PROCESS_ID] = {"process_id", METAIO_TYPE_ILWD_CHAR, 1, "process"},
+	[SNGL_BURST_IFO] = {"ifo", METAIO_TYPE_LSTRING, 1, NULL},
+	[SNGL_BURST_SEARCH] = {"search", METAIO_TYPE_LSTRING, 1, NULL},
+	[SNGL_BURST_CHANNEL] = {"channel", METAIO_TYPE_LSTRING, 1, NULL},
+	[SNGL_BURST_START_TIME] = {"start_time", METAIO_TYPE_INT_4S, 1, NULL},
+	[SNGL_BURST_START_TIME_NS] = {"start_time_ns", METAIO_TYPE_INT_4S, 1, NULL},
+	[SNGL_BURST_PEAK_TIME] = {"peak_time", METAIO_TYPE_INT_4S, 1, NULL},
+	[SNGL_BURST_PEAK_TIME_NS] = {"peak_time_ns", METAIO_TYPE_INT_4S, 1, NULL},
+	[SNGL_BURST_DURATION] = {"duration", METAIO_TYPE_REAL_4, 1, NULL},
+	[SNGL_BURST_CENTRAL_FREQ] = {"central_freq", METAIO_TYPE_REAL_4, 1, NULL},
+	[SNGL_BURST_BANDWIDTH] = {"bandwidth", METAIO_TYPE_REAL_4, 1, NULL},
+	[SNGL_BURST_AMPLITUDE] = {"amplitude", METAIO_TYPE_REAL_4, 1, NULL},
+	[SNGL_BURST_SNR] = {"snr", METAIO_TYPE_REAL_4, 1, NULL},
+	[SNGL_BURST_CONFIDENCE] = {"confidence", METAIO_TYPE_REAL_4, 1, NULL},
+	[SNGL_BURST_CHISQ] = {"chisq", METAIO_TYPE_REAL_8, 1, NULL},
+	[SNGL_BURST_CHISQ_DOF] = {"chisq_dof", METAIO_TYPE_REAL_8, 1, NULL},
+	[SNGL_BURST_EVENT_ID] = {"event_id", METAIO_TYPE_ILWD_CHAR, 1, "sngl_burst"},
+};
+
+
+struct sngl_burst_list {
+	SnglBurst *head;
+	SnglBurst **next;
+};
+
+
+static int sngl_burst_append(const LIGOLwColumnBatch *batch, void *data)
+{
+	static const char table_name[] = "sngl_burst";
+	struct sngl_burst_list *list = data;
+	const LIGOLwColumn *col = batch->columns;
+	size_t i;
 
-		/* append to linked list */
+	for(i = 0; i < batch->length; i++) {
+		/* create a new row, and append to linked list */
 
-		*next = row;
-		next = &(*next)->next;
+		SnglBurst *row = XLALCreateSnglBurst();
+		if(!row)
+			XLAL_ERROR(XLAL_EFUNC);
+		*list->next = row;
+		list->next = &row->next;
 
 		/* populate the columns */
 
-		if((row->process_id = XLALLIGOLwParseIlwdChar(&env, column_pos.process_id, "process", "process_id")) < 0) {
-			XLALDestroySnglBurstTable(head);
-			MetaioAbort(&env);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
-		if(strlen(env.ligo_lw.table.elt[column_pos.ifo].data.lstring.data) >= sizeof(row->ifo) ||
-		strlen(env.ligo_lw.table.elt[column_pos.search].data.lstring.data) >= sizeof(row->search) ||
-		strlen(env.ligo_lw.table.elt[column_pos.channel].data.lstring.data) >= sizeof(row->channel)) {
-			XLALDestroySnglBurstTable(head);
-			MetaioAbort(&env);
-			XLALPrintError("%s(): failure reading %s table: string too long\n", __func__, table_name);
-			XLAL_ERROR_NULL(XLAL_EIO);
-		}
-		strncpy(row->ifo, env.ligo_lw.table.elt[column_pos.ifo].data.lstring.data, sizeof(row->ifo) - 1);
-		strncpy(row->search, env.ligo_lw.table.elt[column_pos.search].data.lstring.data, sizeof(row->search) - 1);
-		strncpy(row->channel, env.ligo_lw.table.elt[column_pos.channel].data.lstring.data, sizeof(row->channel) - 1);
-		XLALGPSSet(&row->start_time, env.ligo_lw.table.elt[column_pos.start_time].data.int_4s, env.ligo_lw.table.elt[column_pos.start_time_ns].data.int_4s);
-		XLALGPSSet(&row->peak_time, env.ligo_lw.table.elt[column_pos.peak_time].data.int_4s, env.ligo_lw.table.elt[column_pos.peak_time_ns].data.int_4s);
-		row->duration = env.ligo_lw.table.elt[column_pos.duration].data.real_4;
-		row->central_freq = env.ligo_lw.table.elt[column_pos.central_freq].data.real_4;
-		row->bandwidth = env.ligo_lw.table.elt[column_pos.bandwidth].data.real_4;
-		row->amplitude = env.ligo_lw.table.elt[column_pos.amplitude].data.real_4;
-		row->snr = env.ligo_lw.table.elt[column_pos.snr].data.real_4;
-		row->confidence = env.ligo_lw.table.elt[column_pos.confidence].data.real_4;
-		row->chisq = env.ligo_lw.table.elt[column_pos.chisq].data.real_8;
-		row->chisq_dof = env.ligo_lw.table.elt[column_pos.chisq_dof].data.real_8;
-		if((row->event_id = XLALLIGOLwParseIlwdChar(&env, column_pos.event_id, "sngl_burst", "event_id")) < 0) {
-			XLALDestroySnglBurstTable(head);
-			MetaioAbort(&env);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
+		row->process_id = col[SNGL_BURST_PROCESS_ID].int_8s[i];
+		if(copy_string(row->ifo, sizeof(row->ifo), col[SNGL_BURST_IFO].lstring[i], table_name) < 0 ||
+		copy_string(row->search, sizeof(row->search), col[SNGL_BURST_SEARCH].lstring[i], table_name) < 0 ||
+		copy_string(row->channel, sizeof(row->channel), col[SNGL_BURST_CHANNEL].lstring[i], table_name) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		XLALGPSSet(&row->start_time, col[SNGL_BURST_START_TIME].int_8s[i], col[SNGL_BURST_START_TIME_NS].int_8s[i]);
+		XLALGPSSet(&row->peak_time, col[SNGL_BURST_PEAK_TIME].int_8s[i], col[SNGL_BURST_PEAK_TIME_NS].int_8s[i]);
+		row->duration = col[SNGL_BURST_DURATION].real_8[i];
+		row->central_freq = col[SNGL_BURST_CENTRAL_FREQ].real_8[i];
+		row->bandwidth = col[SNGL_BURST_BANDWIDTH].real_8[i];
+		row->amplitude = col[SNGL_BURST_AMPLITUDE].real_8[i];
+		row->snr = col[SNGL_BURST_SNR].real_8[i];
+		row->confidence = col[SNGL_BURST_CONFIDENCE].real_8[i];
+		row->chisq = col[SNGL_BURST_CHISQ].real_8[i];
+		row->chisq_dof = col[SNGL_BURST_CHISQ_DOF].real_8[i];
+		row->event_id = col[SNGL_BURST_EVENT_ID].int_8s[i];
 	}
-	if(miostatus < 0) {
-		XLALDestroySnglBurstTable(head);
-		MetaioAbort(&env);
-		XLALPrintError("%s(): I/O error parsing %s table: %s\n", __func__, table_name, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
-		XLAL_ERROR_NULL(XLAL_EIO);
-	}
-
-	/* close file */
 
-	if(MetaioClose(&env)) {
-		XLALDestroySnglBurstTable(head);
-		XLALPrintError("%s(): error parsing document after %s table: %s\n", __func__, table_name, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
-		XLAL_ERROR_NULL(XLAL_EIO);
-	}
-
-	/* done */
-
-	return head;
+	return 0;
 }
 
 
 /**
- * Read the sim_burst table from a LIGO Light Weight XML file into a linked
- * list of SimBurst structures.  If start is not NULL, then only rows whose
- * geocentre peak times are \f$\ge\f$ the given GPS time will be loaded, similarly
- * if end is not NULL.
+ * Read the sngl_burst table from a LIGO Light Weight XML file into a
+ * linked list of SnglBurst structures.
  */
-SimBurst *XLALSimBurstTableFromLIGOLw(
-	const char *filename,
-	const LIGOTimeGPS *start,
-	const LIGOTimeGPS *end
+SnglBurst *XLALSnglBurstTableFromLIGOLw(
+	const char *filename
 )
 {
-	static const char table_name[] = "sim_burst";
-	int miostatus;
-	SimBurst *head = NULL;
-	SimBurst **next = &head;
-	struct MetaioParseEnvironment env;
-	struct {
-		int process_id;
-		int waveform;
-		int ra;
-		int dec;
-		int psi;
-		int time_geocent_gps;
-		int time_geocent_gps_ns;
-		int time_geocent_gmst;
-		int duration;
-		int frequency;
-		int bandwidth;
-		int q;
-		int pol_ellipse_angle;
-		int pol_ellipse_e;
-		int amplitude;
-		int hrss;
-		int egw_over_rsquared;
-		int waveform_number;
-		int time_slide_id;
-		int simulation_id;
-	} column_pos;
-
-	/* open the file and find table */
-
-	if(MetaioOpenFile(&env, filename)) {
-		XLALPrintError("%s(): error opening \"%s\": %s\n", __func__, filename, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
-		XLAL_ERROR_NULL(XLAL_EIO);
-	}
-	if(MetaioOpenTableOnly(&env, table_name)) {
-		MetaioAbort(&env);
-		XLALPrintError("%s(): cannot find %s table: %s\n", __func__, table_name, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
-		XLAL_ERROR_NULL(XLAL_EIO);
-	}
+	struct sngl_burst_list list = {NULL, NULL};
+	list.next = &list.head;
 
-	/* find columns */
-
-	XLALClearErrno();
-	column_pos.process_id = XLALLIGOLwFindColumn(&env, "process_id", METAIO_TYPE_ILWD_CHAR, 1);
-	column_pos.waveform = XLALLIGOLwFindColumn(&env, "waveform", METAIO_TYPE_LSTRING, 1);
-	column_pos.ra = XLALLIGOLwFindColumn(&env, "ra", METAIO_TYPE_REAL_8, 0);
-	column_pos.dec = XLALLIGOLwFindColumn(&env, "dec", METAIO_TYPE_REAL_8, 0);
-	column_pos.psi = XLALLIGOLwFindColumn(&env, "psi", METAIO_TYPE_REAL_8, 0);
-	column_pos.time_geocent_gps = XLALLIGOLwFindColumn(&env, "time_geocent_gps", METAIO_TYPE_INT_4S, 1);
-	column_pos.time_geocent_gps_ns = XLALLIGOLwFindColumn(&env, "time_geocent_gps_ns", METAIO_TYPE_INT_4S, 1);
-	column_pos.time_geocent_gmst = XLALLIGOLwFindColumn(&env, "time_geocent_gmst", METAIO_TYPE_REAL_8, 0);
-	column_pos.duration = XLALLIGOLwFindColumn(&env, "duration", METAIO_TYPE_REAL_8, 0);
-	column_pos.frequency = XLALLIGOLwFindColumn(&env, "frequency", METAIO_TYPE_REAL_8, 0);
-	column_pos.bandwidth = XLALLIGOLwFindColumn(&env, "bandwidth", METAIO_TYPE_REAL_8, 0);
-	column_pos.q = XLALLIGOLwFindColumn(&env, "q", METAIO_TYPE_REAL_8, 0);
-	column_pos.pol_ellipse_angle = XLALLIGOLwFindColumn(&env, "pol_ellipse_angle", METAIO_TYPE_REAL_8, 0);
-	column_pos.pol_ellipse_e = XLALLIGOLwFindColumn(&env, "pol_ellipse_e", METAIO_TYPE_REAL_8, 0);
-	column_pos.amplitude = XLALLIGOLwFindColumn(&env, "amplitude", METAIO_TYPE_REAL_8, 0);
-	column_pos.hrss = XLALLIGOLwFindColumn(&env, "hrss", METAIO_TYPE_REAL_8, 0);
-	column_pos.egw_over_rsquared = XLALLIGOLwFindColumn(&env, "egw_over_rsquared", METAIO_TYPE_REAL_8, 0);
-	column_pos.waveform_number = XLALLIGOLwFindColumn(&env, "waveform_number", METAIO_TYPE_INT_8U, 0);
-	column_pos.time_slide_id = XLALLIGOLwFindColumn(&env, "time_slide_id", METAIO_TYPE_ILWD_CHAR, 1);
-	column_pos.simulation_id = XLALLIGOLwFindColumn(&env, "simulation_id", METAIO_TYPE_ILWD_CHAR, 1);
-
-	/* check for failure (== a required column is missing) */
-
-	if(XLALGetBaseErrno()) {
-		MetaioAbort(&env);
-		XLALPrintError("%s(): failure reading %s table: missing required column\n", __func__, table_name);
+	if(XLALLIGOLwReadTableColumns(filename, "sngl_burst", sngl_burst_columns, SNGL_BURST_NUM_COLUMNS, 4096, NULL, NULL, sngl_burst_append, &list) < 0) {
+		XLALDestroySnglBurstTable(list.head);
 		XLAL_ERROR_NULL(XLAL_EFUNC);
 	}
 
-	/* loop over the rows in the file */
+	return list.head;
+}
 
-	while((miostatus = MetaioGetRow(&env)) > 0) {
-		/* create a new row */
 
-		SimBurst *row = XLALCreateSimBurst();
+/*
+ * sim_burst table
+ */
+
+
+enum {
+	SIM_BURST_PROCESS_ID,
+	SIM_BURST_WAVEFORM,
+	SIM_BURST_RA,
+	SIM_BURST_DEC,
+	SIM_BURST_PSI,
+	SIM_BURST_TIME_GEOCENT_GPS,
+	SIM_BURST_TIME_GEOCENT_GPS_NS,
+	SIM_BURST_TIME_GEOCENT_GMST,
+	SIM_BURST_DURATION,
+	SIM_BURST_FREQUENCY,
+	SIM_BURST_BANDWIDTH,
+	SIM_BURST_Q,
+	SIM_BURST_POL_ELLIPSE_ANGLE,
+	SIM_BURST_POL_ELLIPSE_E,
+	SIM_BURST_AMPLITUDE,
+	SIM_BURST_HRSS,
+	SIM_BURST_EGW_OVER_RSQUARED,
+	SIM_BURST_WAVEFORM_NUMBER,
+	SIM_BURST_TIME_SLIDE_ID,
+	SIM_BURST_SIMULATION_ID,
+	SIM_BURST_NUM_COLUMNS
+};
+
+
+static const LIGOLwColumnSpec sim_burst_columns[SIM_BURST_NUM_COLUMNS] = {
+	[SIM_BURST_PROCESS_ID] = {"process_id", METAIO_TYPE_ILWD_CHAR, 1, "process"},
+	[SIM_BURST_WAVEFORM] = {"waveform", METAIO_TYPE_LSTRING, 1, NULL},
+	[SIM_BURST_RA] = {"ra", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_DEC] = {"dec", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_PSI] = {"psi", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_TIME_GEOCENT_GPS] = {"time_geocent_gps", METAIO_TYPE_INT_4S, 1, NULL},
+	[SIM_BURST_TIME_GEOCENT_GPS_NS] = {"time_geocent_gps_ns", METAIO_TYPE_INT_4S, 1, NULL},
+	[SIM_BURST_TIME_GEOCENT_GMST] = {"time_geocent_gmst", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_DURATION] = {"duration", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_FREQUENCY] = {"frequency", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_BANDWIDTH] = {"bandwidth", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_Q] = {"q", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_POL_ELLIPSE_ANGLE] = {"pol_ellipse_angle", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_POL_ELLIPSE_E] = {"pol_ellipse_e", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_AMPLITUDE] = {"amplitude", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_HRSS] = {"hrss", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_EGW_OVER_RSQUARED] = {"egw_over_rsquared", METAIO_TYPE_REAL_8, 0, NULL},
+	[SIM_BURST_WAVEFORM_NUMBER] = {"waveform_number", METAIO_TYPE_INT_8U, 0, NULL},
+	[SIM_BURST_TIME_SLIDE_ID] = {"time_slide_id", METAIO_TYPE_ILWD_CHAR, 1, "time_slide"},
+	[SIM_BURST_SIMULATION_ID] = {"simulation_id", METAIO_TYPE_ILWD_CHAR, 1, "sim_burst"},
+};
+
+
+struct sim_burst_window {
+	const LIGOTimeGPS *start;
+	const LIGOTimeGPS *end;
+};
+
+
+static int sim_burst_in_window(const LIGOLwColumnBatch *batch, size_t i, void *data)
+{
+	const struct sim_burst_window *window = data;
+	LIGOTimeGPS t;
+
+	XLALGPSSet(&t, batch->columns[SIM_BURST_TIME_GEOCENT_GPS].int_8s[i], batch->columns[SIM_BURST_TIME_GEOCENT_GPS_NS].int_8s[i]);
+	return !((window->start && XLALGPSDiff(window->start, &t) > 0) || (window->end && XLALGPSDiff(window->end, &t) < 0));
+}
 
-		if(!row) {
-			XLALDestroySimBurstTable(head);
-			MetaioAbort(&env);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
+
+struct sim_burst_list {
+	SimBurst *head;
+	SimBurst **next;
+};
+
+
+static int sim_burst_append(const LIGOLwColumnBatch *batch, void *data)
+{
+	static const char table_name[] = "sim_burst";
+	struct sim_burst_list *list = data;
+	const LIGOLwColumn *col = batch->columns;
+	size_t i;
+
+	/* whether an optional column is present */
+#define HAVE(column) (col[column].type != LIGOLW_COLUMN_MISSING)
+
+	for(i = 0; i < batch->length; i++) {
+		/* create a new row, and append to linked list */
+
+		SimBurst *row = XLALCreateSimBurst();
+		if(!row)
+			XLAL_ERROR(XLAL_EFUNC);
+		*list->next = row;
+		list->next = &row->next;
 
 		/* populate the columns */
 
-		if((row->process_id = XLALLIGOLwParseIlwdChar(&env, column_pos.process_id, "process", "process_id")) < 0) {
-			XLALDestroySimBurst(row);
-			XLALDestroySimBurstTable(head);
-			MetaioAbort(&env);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
-		if(strlen(env.ligo_lw.table.elt[column_pos.waveform].data.lstring.data) >= sizeof(row->waveform)) {
-			XLALDestroySimBurst(row);
-			XLALDestroySimBurstTable(head);
-			MetaioAbort(&env);
-			XLALPrintError("%s(): failure reading %s table: string too long\n", __func__, table_name);
-			XLAL_ERROR_NULL(XLAL_EIO);
-		}
-		strncpy(row->waveform, env.ligo_lw.table.elt[column_pos.waveform].data.lstring.data, sizeof(row->waveform) - 1);
-		if(column_pos.ra >= 0)
-			row->ra = env.ligo_lw.table.elt[column_pos.ra].data.real_8;
-		if(column_pos.dec >= 0)
-			row->dec = env.ligo_lw.table.elt[column_pos.dec].data.real_8;
-		if(column_pos.psi >= 0)
-			row->psi = env.ligo_lw.table.elt[column_pos.psi].data.real_8;
-		XLALGPSSet(&row->time_geocent_gps, env.ligo_lw.table.elt[column_pos.time_geocent_gps].data.int_4s, env.ligo_lw.table.elt[column_pos.time_geocent_gps_ns].data.int_4s);
-		if(column_pos.time_geocent_gmst >= 0)
-			row->time_geocent_gmst = env.ligo_lw.table.elt[column_pos.time_geocent_gmst].data.real_8;
-		if((row->time_slide_id = XLALLIGOLwParseIlwdChar(&env, column_pos.time_slide_id, "time_slide", "time_slide_id")) < 0) {
-			XLALDestroySimBurst(row);
-			XLALDestroySimBurstTable(head);
-			MetaioAbort(&env);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
-		if((row->simulation_id = XLALLIGOLwParseIlwdChar(&env, column_pos.simulation_id, "sim_burst", "simulation_id")) < 0) {
-			XLALDestroySimBurst(row);
-			XLALDestroySimBurstTable(head);
-			MetaioAbort(&env);
-			XLAL_ERROR_NULL(XLAL_EFUNC);
-		}
+		row->process_id = col[SIM_BURST_PROCESS_ID].int_8s[i];
+		if(copy_string(row->waveform, sizeof(row->waveform), col[SIM_BURST_WAVEFORM].lstring[i], table_name) < 0)
+			XLAL_ERROR(XLAL_EFUNC);
+		if(HAVE(SIM_BURST_RA))
+			row->ra = col[SIM_BURST_RA].real_8[i];
+		if(HAVE(SIM_BURST_DEC))
+			row->dec = col[SIM_BURST_DEC].real_8[i];
+		if(HAVE(SIM_BURST_PSI))
+			row->psi = col[SIM_BURST_PSI].real_8[i];
+		XLALGPSSet(&row->time_geocent_gps, col[SIM_BURST_TIME_GEOCENT_GPS].int_8s[i], col[SIM_BURST_TIME_GEOCENT_GPS_NS].int_8s[i]);
+		if(HAVE(SIM_BURST_TIME_GEOCENT_GMST))
+			row->time_geocent_gmst = col[SIM_BURST_TIME_GEOCENT_GMST].real_8[i];
+		row->time_slide_id = col[SIM_BURST_TIME_SLIDE_ID].int_8s[i];
+		row->simulation_id = col[SIM_BURST_SIMULATION_ID].int_8s[i];
 
 		if(!strcmp(row->waveform, "StringCusp")) {
-			if(column_pos.duration < 0 || column_pos.frequency < 0 || column_pos.amplitude < 0) {
-				XLALDestroySimBurst(row);
-				XLALDestroySimBurstTable(head);
-				MetaioAbort(&env);
+			if(!HAVE(SIM_BURST_DURATION) || !HAVE(SIM_BURST_FREQUENCY) || !HAVE(SIM_BURST_AMPLITUDE)) {
 				XLALPrintError("%s(): failure reading %s table: missing required column\n", __func__, table_name);
-				XLAL_ERROR_NULL(XLAL_EIO);
+				XLAL_ERROR(XLAL_EIO);
 			}
-			row->duration = env.ligo_lw.table.elt[column_pos.duration].data.real_8;
-			row->frequency = env.ligo_lw.table.elt[column_pos.frequency].data.real_8;
-			row->amplitude = env.ligo_lw.table.elt[column_pos.amplitude].data.real_8;
+			row->duration = col[SIM_BURST_DURATION].real_8[i];
+			row->frequency = col[SIM_BURST_FREQUENCY].real_8[i];
+			row->amplitude = col[SIM_BURST_AMPLITUDE].real_8[i];
 		} else if(!strcmp(row->waveform, "SineGaussian")||!strcmp(row->waveform, "SineGaussianF")) {
-			if(column_pos.duration < 0 || column_pos.frequency < 0 || column_pos.bandwidth < 0 || column_pos.q < 0 || column_pos.pol_ellipse_angle < 0 || column_pos.pol_ellipse_e < 0 || column_pos.hrss < 0) {
-				XLALDestroySimBurst(row);
-				XLALDestroySimBurstTable(head);
-				MetaioAbort(&env);
+			if(!HAVE(SIM_BURST_DURATION) || !HAVE(SIM_BURST_FREQUENCY) || !HAVE(SIM_BURST_BANDWIDTH) || !HAVE(SIM_BURST_Q) || !HAVE(SIM_BURST_POL_ELLIPSE_ANGLE) || !HAVE(SIM_BURST_POL_ELLIPSE_E) || !HAVE(SIM_BURST_HRSS)) {
 				XLALPrintError("%s(): failure reading %s table: missing required column\n", __func__, table_name);
-				XLAL_ERROR_NULL(XLAL_EIO);
+				XLAL_ERROR(XLAL_EIO);
 			}
-			row->duration = env.ligo_lw.table.elt[column_pos.duration].data.real_8;
-			row->frequency = env.ligo_lw.table.elt[column_pos.frequency].data.real_8;
-			row->bandwidth = env.ligo_lw.table.elt[column_pos.bandwidth].data.real_8;
-			row->q = env.ligo_lw.table.elt[column_pos.q].data.real_8;
-			row->pol_ellipse_angle = env.ligo_lw.table.elt[column_pos.pol_ellipse_angle].data.real_8;
-			row->pol_ellipse_e = env.ligo_lw.table.elt[column_pos.pol_ellipse_e].data.real_8;
-			row->hrss = env.ligo_lw.table.elt[column_pos.hrss].data.real_8;
+			row->duration = col[SIM_BURST_DURATION].real_8[i];
+			row->frequency = col[SIM_BURST_FREQUENCY].real_8[i];
+			row->bandwidth = col[SIM_BURST_BANDWIDTH].real_8[i];
+			row->q = col[SIM_BURST_Q].real_8[i];
+			row->pol_ellipse_angle = col[SIM_BURST_POL_ELLIPSE_ANGLE].real_8[i];
+			row->pol_ellipse_e = col[SIM_BURST_POL_ELLIPSE_E].real_8[i];
+			row->hrss = col[SIM_BURST_HRSS].real_8[i];
 		} else if(!strcmp(row->waveform, "Gaussian")) {
-			if(column_pos.duration < 0 || column_pos.hrss < 0) {
-				XLALDestroySimBurst(row);
-				XLALDestroySimBurstTable(head);
-				MetaioAbort(&env);
+			if(!HAVE(SIM_BURST_DURATION) || !HAVE(SIM_BURST_HRSS)) {
 				XLALPrintError("%s(): failure reading %s table: missing required column\n", __func__, table_name);
-				XLAL_ERROR_NULL(XLAL_EIO);
+				XLAL_ERROR(XLAL_EIO);
 			}
-			row->duration = env.ligo_lw.table.elt[column_pos.duration].data.real_8;
-			row->hrss = env.ligo_lw.table.elt[column_pos.hrss].data.real_8;
+			row->duration = col[SIM_BURST_DURATION].real_8[i];
+			row->hrss = col[SIM_BURST_HRSS].real_8[i];
 		} else if(!strcmp(row->waveform, "BTLWNB")) {
-			if(column_pos.duration < 0 || column_pos.frequency < 0 || column_pos.bandwidth < 0 || column_pos.pol_ellipse_angle < 0 || column_pos.pol_ellipse_e < 0 || column_pos.egw_over_rsquared < 0 || column_pos.waveform_number < 0) {
-				XLALDestroySimBurst(row);
-				XLALDestroySimBurstTable(head);
-				MetaioAbort(&env);
+			if(!HAVE(SIM_BURST_DURATION) || !HAVE(SIM_BURST_FREQUENCY) || !HAVE(SIM_BURST_BANDWIDTH) || !HAVE(SIM_BURST_POL_ELLIPSE_ANGLE) || !HAVE(SIM_BURST_POL_ELLIPSE_E) || !HAVE(SIM_BURST_EGW_OVER_RSQUARED) || !HAVE(SIM_BURST_WAVEFORM_NUMBER)) {
 				XLALPrintError("%s(): failure reading %s table: missing required column\n", __func__, table_name);
-				XLAL_ERROR_NULL(XLAL_EIO);
+				XLAL_ERROR(XLAL_EIO);
 			}
-			row->duration = env.ligo_lw.table.elt[column_pos.duration].data.real_8;
-			row->frequency = env.ligo_lw.table.elt[column_pos.frequency].data.real_8;
-			row->bandwidth = env.ligo_lw.table.elt[column_pos.bandwidth].data.real_8;
-			row->pol_ellipse_angle = env.ligo_lw.table.elt[column_pos.pol_ellipse_angle].data.real_8;
-			row->pol_ellipse_e = env.ligo_lw.table.elt[column_pos.pol_ellipse_e].data.real_8;
-			row->egw_over_rsquared = env.ligo_lw.table.elt[column_pos.egw_over_rsquared].data.real_8;
-			row->waveform_number = env.ligo_lw.table.elt[column_pos.waveform_number].data.int_8u;
+			row->duration = col[SIM_BURST_DURATION].real_8[i];
+			row->frequency = col[SIM_BURST_FREQUENCY].real_8[i];
+			row->bandwidth = col[SIM_BURST_BANDWIDTH].real_8[i];
+			row->pol_ellipse_angle = col[SIM_BURST_POL_ELLIPSE_ANGLE].real_8[i];
+			row->pol_ellipse_e = col[SIM_BURST_POL_ELLIPSE_E].real_8[i];
+			row->egw_over_rsquared = col[SIM_BURST_EGW_OVER_RSQUARED].real_8[i];
+			row->waveform_number = col[SIM_BURST_WAVEFORM_NUMBER].int_8s[i];
 		} else if(!strcmp(row->waveform, "Impulse")) {
-			if(column_pos.amplitude < 0) {
-				XLALDestroySimBurst(row);
-				XLALDestroySimBurstTable(head);
-				MetaioAbort(&env);
+			if(!HAVE(SIM_BURST_AMPLITUDE)) {
 				XLALPrintError("%s(): failure reading %s table: missing required column\n", __func__, table_name);
-				XLAL_ERROR_NULL(XLAL_EIO);
+				XLAL_ERROR(XLAL_EIO);
 			}
-			row->amplitude = env.ligo_lw.table.elt[column_pos.amplitude].data.real_8;
+			row->amplitude = col[SIM_BURST_AMPLITUDE].real_8[i];
 		} else {
 			/* unrecognized waveform */
-			XLALDestroySimBurst(row);
-			XLALDestroySimBurstTable(head);
-			MetaioAbort(&env);
 			XLALPrintError("%s(): unrecognized waveform \"%s\" in %s table\n", __func__, row->waveform, table_name);
-			XLAL_ERROR_NULL(XLAL_EIO);
+			XLAL_ERROR(XLAL_EIO);
 		}
+	}
 
-		/* if outside accepted time window, discard */
+#undef HAVE
 
-		if((start && XLALGPSDiff(start, &row->time_geocent_gps) > 0) || (end && XLALGPSDiff(end, &row->time_geocent_gps) < 0)) {
-			XLALDestroySimBurst(row);
-			continue;
-		}
+	return 0;
+}
 
-		/* append to linked list */
 
-		*next = row;
-		next = &(*next)->next;
-	}
-	if(miostatus < 0) {
-		XLALDestroySimBurstTable(head);
-		MetaioAbort(&env);
-		XLALPrintError("%s(): I/O error parsing %s table: %s\n", __func__, table_name, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
-		XLAL_ERROR_NULL(XLAL_EIO);
-	}
-
-	/* close file */
+/**
+ * Read the sim_burst table from a LIGO Light Weight XML file into a linked
+ * list of SimBurst structures.  If start is not NULL, then only rows whose
+ * geocentre peak times are \f$\ge\f$ the given GPS time will be loaded, similarly
+ * if end is not NULL.  Rows outside the window are discarded before their
+ * waveform parameters are checked, so they cannot cause errors.
+ */
+SimBurst *XLALSimBurstTableFromLIGOLw(
+	const char *filename,
+	const LIGOTimeGPS *start,
+	const LIGOTimeGPS *end
+)
+{
+	struct sim_burst_window window = {start, end};
+	struct sim_burst_list list = {NULL, NULL};
+	list.next = &list.head;
 
-	if(MetaioClose(&env)) {
-		XLALDestroySimBurstTable(head);
-		XLALPrintError("%s(): error parsing document after %s table: %s\n", __func__, table_name, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
-		XLAL_ERROR_NULL(XLAL_EIO);
+	if(XLALLIGOLwReadTableColumns(filename, "sim_burst", sim_burst_columns, SIM_BURST_NUM_COLUMNS, 4096, (start || end) ? sim_burst_in_window : NULL, &window, sim_burst_append, &list) < 0) {
+		XLALDestroySimBurstTable(list.head);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
 	}
 
-	/* done */
-
-	return head;
+	return list.head;
 }
@@ -127,20 +127,23 @@ static PyObject *sky_map_toa_phoa_snr(
     PyObject *responses_obj;
     PyObject *locations_obj;
     PyObject *horizons_obj;
+    bayestar_refinement_params params = {0, 0, 0};
 
     /* Names of arguments */
     static const char *keywords[] = {"min_distance", "max_distance",
         "prior_distance_power", "cosmology", "gmst", "sample_rate", "epochs",
-        "snrs", "responses", "locations", "horizons", NULL};
+        "snrs", "responses", "locations", "horizons", "max_seconds",
+        "max_pixels", "max_order", NULL};
 
     /* Parse arguments */
     /* FIXME: PyArg_ParseTupleAndKeywords should expect keywords to be const */
     #pragma GCC diagnostic push
     #pragma GCC diagnostic ignored "-Wincompatible-pointer-types"
-    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ddiiddOOOOO",
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "ddiiddOOOOO|dkb",
         keywords, &min_distance, &max_distance, &prior_distance_power,
         &cosmology, &gmst, &sample_rate, &epochs_obj, &snrs_obj,
-        &responses_obj, &locations_obj, &horizons_obj)) return NULL;
+        &responses_obj, &locations_obj, &horizons_obj, &params.max_seconds,
+        &params.max_pixels, &params.max_order)) return NULL;
     #pragma GCC diagnostic pop
 
     /* Determine number of detectors */
@@ -153,6 +156,7 @@ static PyObject *sky_map_toa_phoa_snr(
     /* Return value */
     PyObject *out = NULL;
     double log_bci, log_bsn;
+    bayestar_timing timing;
 
     /* Numpy array objects */
     PyArrayObject *epochs_npy = NULL, *snrs_npy[nifos], *responses_npy[nifos],
@@ -202,10 +206,10 @@ static PyObject *sky_map_toa_phoa_snr(
     size_t len;
     bayestar_pixel *pixels;
     Py_BEGIN_ALLOW_THREADS
-    pixels = bayestar_sky_map_toa_phoa_snr(&len, &log_bci, &log_bsn,
+    pixels = bayestar_sky_map_toa_phoa_snr_budget(&len, &log_bci, &log_bsn,
         min_distance, max_distance, prior_distance_power, cosmology, gmst,
         nifos, nsamples, sample_rate, epochs, snrs, responses, locations,
-        horizons);
+        horizons, &params, &timing);
     Py_END_ALLOW_THREADS
     gsl_set_error_handler(old_handler);
 
@@ -243,7 +247,11 @@ fail: /* Cleanup */
     FREE_INPUT_LIST_OF_ARRAYS(locations)
     Py_XDECREF(horizons_npy);
     if (out) {
-        out = Py_BuildValue("Ndd", out, log_bci, log_bsn);
+        out = Py_BuildValue("Ndd{sdsdsdsdsdsksb}", out, log_bci, log_bsn,
+            "init", timing.init, "coarse", timing.coarse,
+            "refine", timing.refine, "distance", timing.distance,
+            "normalize", timing.normalize, "npix_refine", timing.npix_refine,
+            "max_order", timing.max_order);
     }
     return out;
 };
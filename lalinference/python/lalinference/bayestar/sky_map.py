@@ -141,10 +141,16 @@ def localize(
         event, waveform='o2-uberbank', f_low=30.0,
         min_distance=None, max_distance=None, prior_distance_power=None,
         cosmology=False, method='toa_phoa_snr', nside=-1, chain_dump=None,
-        enable_snr_series=True, f_high_truncate=0.95):
+        enable_snr_series=True, f_high_truncate=0.95,
+        max_seconds=0, max_pixels=0, max_order=0):
     """Convenience function to produce a sky map from LIGO-LW rows. Note that
     min_distance and max_distance should be in Mpc.
 
+    For method='toa_phoa_snr', adaptive refinement stops early if it exceeds
+    max_seconds of wall-clock time, evaluates more than max_pixels pixels, or
+    reaches HEALPix order max_order. A value of zero means no limit (or for
+    max_order, the default of 11).
+
     Returns a 'NESTED' ordering HEALPix image as a Numpy array.
     """
     frame = inspect.currentframe()
@@ -325,9 +331,15 @@ def localize(
     # Time and run sky localization.
     log.debug('starting computationally-intensive section')
     if method == 'toa_phoa_snr':
-        skymap, log_bci, log_bsn = _sky_map.toa_phoa_snr(
+        skymap, log_bci, log_bsn, timing = _sky_map.toa_phoa_snr(
             min_distance, max_distance, prior_distance_power, cosmology, gmst,
-            sample_rate, toas, snr_series, responses, locations, horizons)
+            sample_rate, toas, snr_series, responses, locations, horizons,
+            max_seconds=max_seconds, max_pixels=max_pixels,
+            max_order=max_order)
+        log.debug('stage timing (s): init=%(init).3f coarse=%(coarse).3f '
+                  'refine=%(refine).3f distance=%(distance).3f '
+                  'normalize=%(normalize).3f; refined %(npix_refine)d pixels '
+                  'up to order %(max_order)d', timing)
         skymap = Table(skymap)
         skymap.meta['log_bci'] = log_bci
         skymap.meta['log_bsn'] = log_bsn
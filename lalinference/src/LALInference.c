@@ -41,6 +41,11 @@
 #include <lal/LALHashFunc.h>
 #include <lal/LALSimNeutronStar.h>
 
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -50,36 +55,188 @@
 #define COL_MAX 128
 #define STR_MAX 2048
 
-typedef struct taghash_elem
+/*
+ * Table of interned variable names. Each distinct name is assigned a key,
+ * starting from 1, which indexes the slots array of every
+ * LALInferenceVariables structure. Names are looked up in an open-addressed
+ * hash table. The table lives for the lifetime of the process, so it is
+ * allocated with malloc() rather than XLALMalloc() to keep it out of the
+ * memory leak checks.
+ *
+ * Names are looked up by every likelihood and proposal evaluation, from many
+ * threads at once, so reading the table takes no lock where atomic operations
+ * are available. A name is added in place, storing its key in the hash table
+ * last. When the table is full, a copy twice the size is published in its
+ * place; the old table is kept, since readers may still be using it.
+ * Adding names is serialised by a lock.
+ */
+typedef struct taginterned_name
 {
-  const char *name;
-  LALInferenceVariableItem *itemPtr;
-} hash_elem;
+  UINT8 hash;
+  LALInferenceVariableKey key;
+} interned_name;
 
-static void *new_elem( const char *name, LALInferenceVariableItem *itemPtr )
+typedef struct taginterned_table
 {
-  hash_elem e = { .name=name, .itemPtr=itemPtr };
-  return memcpy( XLALMalloc( sizeof( e ) ), &e, sizeof( e ) );
-};
+  char **names;           /* names indexed by key */
+  UINT4 nnames;           /* number of keys assigned, including key 0 */
+  UINT4 maxnames;         /* allocated length of names */
+  interned_name *entries; /* hash table of keys */
+  UINT4 tablesize;        /* length of entries, a power of two, at least 2*maxnames */
+} interned_table;
+
+static interned_table *interned = NULL;
+
+#if defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+#define INTERNED_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define INTERNED_STORE(x,v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+#define INTERNED_READ_LOCK
+#define INTERNED_READ_UNLOCK
+#else
+#define INTERNED_LOAD(x) (x)
+#define INTERNED_STORE(x,v) ((x)=(v))
+#define INTERNED_READ_LOCK INTERNED_WRITE_LOCK
+#define INTERNED_READ_UNLOCK INTERNED_WRITE_UNLOCK
+#endif
+
+#ifdef LAL_PTHREAD_LOCK
+static pthread_mutex_t interned_lock = PTHREAD_MUTEX_INITIALIZER;
+#define INTERNED_WRITE_LOCK pthread_mutex_lock(&interned_lock)
+#define INTERNED_WRITE_UNLOCK pthread_mutex_unlock(&interned_lock)
+#else
+#define INTERNED_WRITE_LOCK
+#define INTERNED_WRITE_UNLOCK
+#endif
+
+/* Find the key of name in the interned table, or 0 if it is not there */
+static LALInferenceVariableKey interned_find(const char *name, UINT8 hash)
+{
+  const interned_table *t = INTERNED_LOAD(interned);
+  LALInferenceVariableKey key;
+  UINT4 i;
+  if(!t) return 0;
+  for(i=hash&(t->tablesize-1); (key=INTERNED_LOAD(t->entries[i].key)); i=(i+1)&(t->tablesize-1))
+    if(t->entries[i].hash==hash && !strcmp(t->names[key],name))
+      return key;
+  return 0;
+}
+
+/* Return a copy of the interned table t (which may be NULL) with room for
+ * twice as many names, or NULL on error */
+static interned_table *interned_grow(const interned_table *t)
+{
+  UINT4 i;
+  interned_table *newt = calloc(1, sizeof(*newt));
+  if(!newt) return NULL;
+  newt->maxnames = t ? 2*t->maxnames : 128;
+  newt->tablesize = 2*newt->maxnames;
+  newt->nnames = t ? t->nnames : 1;
+  newt->names = calloc(newt->maxnames, sizeof(*newt->names));
+  newt->entries = calloc(newt->tablesize, sizeof(*newt->entries));
+  if(!newt->names || !newt->entries)
+  {
+    free(newt->names);
+    free(newt->entries);
+    free(newt);
+    return NULL;
+  }
+  if(t)
+  {
+    memcpy(newt->names, t->names, t->nnames*sizeof(*newt->names));
+    for(i=0;i<t->tablesize;i++)
+      if(t->entries[i].key)
+      {
+        UINT4 j;
+        for(j=t->entries[i].hash&(newt->tablesize-1); newt->entries[j].key; j=(j+1)&(newt->tablesize-1));
+        newt->entries[j]=t->entries[i];
+      }
+  }
+  return newt;
+}
 
-static void del_elem(void *elem)
+/* Add name to the interned table, returning its key, or 0 on error.
+ * Must be called with the interned lock held. */
+static LALInferenceVariableKey interned_add(const char *name, UINT8 hash)
 {
-  XLALFree(elem);
+  interned_table *t = interned;
+  LALInferenceVariableKey key;
+  UINT4 i;
+  if(!t || t->nnames >= t->maxnames)
+  {
+    /* Publish a larger copy; the old table is left for any readers */
+    interned_table *newt = interned_grow(t);
+    if(!newt) return 0;
+    INTERNED_STORE(interned, newt);
+    t = newt;
+  }
+  key = t->nnames;
+  t->names[key] = strdup(name);
+  if(!t->names[key]) return 0;
+  for(i=hash&(t->tablesize-1); t->entries[i].key; i=(i+1)&(t->tablesize-1));
+  t->entries[i].hash=hash;
+  /* Readers find the name once its key is stored */
+  INTERNED_STORE(t->entries[i].key, key);
+  INTERNED_STORE(t->nnames, key+1);
+  return key;
+}
+
+/* Find the key of name without adding it to the interned table */
+static LALInferenceVariableKey LALInferenceFindVariableKey(const char *name)
+{
+  LALInferenceVariableKey key;
+  UINT8 hash = XLALCityHash64(name, strnlen(name,VARNAME_MAX));
+  INTERNED_READ_LOCK;
+  key = interned_find(name, hash);
+  INTERNED_READ_UNLOCK;
+  return key;
 }
 
-static UINT8 LALInferenceElemHash(const void *elem);
-static UINT8 LALInferenceElemHash(const void *elem)
+LALInferenceVariableKey LALInferenceGetVariableKey(const char *name)
+{
+  LALInferenceVariableKey key;
+  UINT8 hash;
+  if(!name) XLAL_ERROR(XLAL_EFAULT);
+  if(strnlen(name,VARNAME_MAX)>=VARNAME_MAX)
+    XLAL_ERROR(XLAL_EINVAL, "Variable name %s too long. Maximum length %i", name, VARNAME_MAX);
+  hash = XLALCityHash64(name, strlen(name));
+  INTERNED_READ_LOCK;
+  key = interned_find(name, hash);
+  INTERNED_READ_UNLOCK;
+  if(key) return key;
+  INTERNED_WRITE_LOCK;
+  key = interned_find(name, hash);
+  if(!key) key = interned_add(name, hash);
+  INTERNED_WRITE_UNLOCK;
+  if(!key) XLAL_ERROR(XLAL_ENOMEM, "Unable to intern variable name %s", name);
+  return key;
+}
+
+const char *LALInferenceGetVariableKeyName(LALInferenceVariableKey key)
 {
-  if(!elem) XLAL_ERROR(XLAL_EINVAL);
-  size_t len = strnlen(((const hash_elem *)elem)->name,VARNAME_MAX);
-  return(XLALCityHash64(((const hash_elem *)elem)->name, len));
+  const char *name=NULL;
+  const interned_table *t;
+  INTERNED_READ_LOCK;
+  t = INTERNED_LOAD(interned);
+  if(t && key>0 && key<INTERNED_LOAD(t->nnames)) name=t->names[key];
+  INTERNED_READ_UNLOCK;
+  return name;
 }
 
-static int LALInferenceElemCmp(const void *elem1, const void *elem2);
-static int LALInferenceElemCmp(const void *elem1, const void *elem2)
+/* Point the slot for item in vars at item, growing the slots array if necessary */
+static int LALInferenceSetItemSlot(LALInferenceVariables *vars, LALInferenceVariableItem *item)
 {
-  if(!elem1 || !elem2) XLAL_ERROR(XLAL_EINVAL);
-  return(strncmp(((const hash_elem *)elem1)->name,((const hash_elem *)elem2)->name,VARNAME_MAX));
+  if(item->key >= vars->nslots)
+  {
+    UINT4 n = vars->nslots ? vars->nslots : 32;
+    while(n <= item->key) n*=2;
+    LALInferenceVariableItem **slots = XLALRealloc(vars->slots, n*sizeof(*slots));
+    if(!slots) XLAL_ERROR(XLAL_ENOMEM);
+    memset(slots+vars->nslots, 0, (n-vars->nslots)*sizeof(*slots));
+    vars->slots=slots;
+    vars->nslots=n;
+  }
+  vars->slots[item->key]=item;
+  return XLAL_SUCCESS;
 }
 
 
@@ -175,18 +332,18 @@ LALInferenceVariableItem *LALInferenceGetItem(const LALInferenceVariables *vars,
 /* (this function is only to be used internally) */
 /* Returns pointer to item for given item name.  */
 {
-  hash_elem tmp; /* Used for hash table lookup */
-  const hash_elem *match=NULL;
   if(vars==NULL) return NULL;
   if(vars->dimension==0) return NULL;
-  if(!vars->hash_table) return LALInferenceGetItemSlow(vars,name);
-  tmp.name=name;
-  XLALHashTblFind(vars->hash_table,		/**< [in] Pointer to hash table */
-                  &tmp,                 /**< [in] Hash element to match */
-                  (const void **)&match /**< [out] Pointer to matched hash element, or NULL if not found */
-                  );
-  if(!match) return NULL;
-  return match->itemPtr;
+  if(!vars->slots) return LALInferenceGetItemSlow(vars,name);
+  return LALInferenceGetItemByKey(vars,LALInferenceFindVariableKey(name));
+}
+
+LALInferenceVariableItem *LALInferenceGetItemByKey(const LALInferenceVariables *vars, LALInferenceVariableKey key)
+/* Returns pointer to item for given interned key. */
+{
+  if(vars==NULL) return NULL;
+  if(key==0 || key>=vars->nslots) return NULL;
+  return vars->slots[key];
 }
 /* Walk through the list to check for an item */
 LALInferenceVariableItem *LALInferenceGetItemSlow(const LALInferenceVariables *vars,const char *name)
@@ -235,7 +392,7 @@ void LALInferenceSetParamVaryType(LALInferenceVariables *vars, const char *name,
 }
 
 void *LALInferenceGetVariable(const LALInferenceVariables * vars,const char * name)
-/* Return the value of variable name from the vars structure by walking the list */
+/* Return the value of variable name from the vars structure */
 {
   LALInferenceVariableItem *item;
   item=LALInferenceGetItem(vars,name);
@@ -245,6 +402,17 @@ void *LALInferenceGetVariable(const LALInferenceVariables * vars,const char * na
   return(item->value);
 }
 
+void *LALInferenceGetVariableByKey(const LALInferenceVariables * vars, LALInferenceVariableKey key)
+/* Return the value of variable with the given key from the vars structure */
+{
+  LALInferenceVariableItem *item;
+  item=LALInferenceGetItemByKey(vars,key);
+  if(!item) {
+    XLAL_ERROR_NULL(XLAL_EFAILED, "Entry \"%s\" not found.", LALInferenceGetVariableKeyName(key));
+  }
+  return(item->value);
+}
+
 
 INT4 LALInferenceGetVariableDimension(LALInferenceVariables *vars)
 {
@@ -348,6 +516,8 @@ char *LALInferenceGetVariableName(LALInferenceVariables *vars, int idx)
 }
 
 
+static void LALInferenceSetItemValue(LALInferenceVariableItem *item, const void *value);
+
 void LALInferenceSetVariable(LALInferenceVariables * vars, const char * name, const void *value)
 /* Set the value of variable name in the vars structure to value */
 {
@@ -356,6 +526,22 @@ void LALInferenceSetVariable(LALInferenceVariables * vars, const char * name, co
   if(!item) {
     XLAL_ERROR_VOID(XLAL_EINVAL, "Entry \"%s\" not found.", name);
   }
+  LALInferenceSetItemValue(item,value);
+}
+
+void LALInferenceSetVariableByKey(LALInferenceVariables * vars, LALInferenceVariableKey key, const void *value)
+/* Set the value of variable with the given key in the vars structure to value */
+{
+  LALInferenceVariableItem *item;
+  item=LALInferenceGetItemByKey(vars,key);
+  if(!item) {
+    XLAL_ERROR_VOID(XLAL_EINVAL, "Entry \"%s\" not found.", LALInferenceGetVariableKeyName(key));
+  }
+  LALInferenceSetItemValue(item,value);
+}
+
+static void LALInferenceSetItemValue(LALInferenceVariableItem *item, const void *value)
+{
   if (item->vary==LALINFERENCE_PARAM_FIXED)
   {
     XLALPrintWarning("Warning! Attempting to set variable %s which is fixed\n",item->name);
@@ -396,24 +582,30 @@ void LALInferenceAddVariable(LALInferenceVariables * vars, const char * name, co
 /* If variable already exists, it will over-write the current value if type compatible*/
 {
   LALInferenceVariableItem *old=NULL;
-  /* Create the hash table if it does not exist */
-  if(!vars->hash_table) vars->hash_table = XLALHashTblCreate( del_elem, LALInferenceElemHash, LALInferenceElemCmp);
-  
+  LALInferenceVariableKey key;
+
   /* Check input value is accessible */
   if(!value) {
     XLAL_ERROR_VOID(XLAL_EFAULT, "Unable to access value through null pointer; trying to add \"%s\".", name);
   }
 
+  if((VARNAME_MAX <= strnlen(name, VARNAME_MAX)))
+  {
+      fprintf(stderr,"Variable name %s too long. Maximum length %i\n",name,VARNAME_MAX);
+      exit(1);
+  }
+  key=LALInferenceGetVariableKey(name);
+  if(!key) XLAL_ERROR_VOID(XLAL_EFUNC);
+
   /* Check the name doesn't already exist */
-  if(LALInferenceCheckVariable(vars,name)) {
-    old=LALInferenceGetItem(vars,name);
+  if((old=LALInferenceGetItemByKey(vars,key))) {
     if(old->type != type)
     {
       LALInferenceRemoveVariable(vars,name);
       //XLAL_ERROR_VOID(XLAL_EINVAL, "Cannot re-add \"%s\" as previous definition has wrong type.", name);
     }
     else{
-      LALInferenceSetVariable(vars,name,value);
+      LALInferenceSetItemValue(old,value);
       return;
     }
   }
@@ -437,11 +629,15 @@ void LALInferenceAddVariable(LALInferenceVariables * vars, const char * name, co
   }
   new->type = type;
   new->vary = vary;
+  new->key = key;
   memcpy(new->value,value,LALInferenceTypeSize[type]);
+  if(LALInferenceSetItemSlot(vars,new)!=XLAL_SUCCESS) {
+    XLALFree(new->value);
+    XLALFree(new);
+    XLAL_ERROR_VOID(XLAL_EFUNC);
+  }
   new->next = vars->head;
   vars->head = new;
-  hash_elem *elem=new_elem(new->name,new);
-  XLALHashTblAdd(vars->hash_table,(void *)elem);
   vars->dimension++;
   return;
 }
@@ -463,10 +659,8 @@ void LALInferenceRemoveVariable(LALInferenceVariables *vars,const char *name)
   }
   if(!parent) vars->head=this->next;
   else parent->next=this->next;
-  /* Remove from hash table */
-  hash_elem elem;
-  elem.name=this->name;
-  XLALHashTblRemove(vars->hash_table,(void *)&elem);
+  /* Remove from slots */
+  if(this->key<vars->nslots) vars->slots[this->key]=NULL;
   /* We own the memory for these types, so have to free. */
   switch (this->type) {
   case LALINFERENCE_gslMatrix_t:
@@ -528,6 +722,13 @@ int LALInferenceCheckVariable(LALInferenceVariables *vars,const char *name)
   else return 0;
 }
 
+int LALInferenceCheckVariableByKey(const LALInferenceVariables *vars, LALInferenceVariableKey key)
+/* Check for existance of key */
+{
+  if(LALInferenceGetItemByKey(vars,key)) return 1;
+  else return 0;
+}
+
 void LALInferenceClearVariables(LALInferenceVariables *vars)
 /* Free all variables inside the linked list, leaving only the head struct */
 {
@@ -548,9 +749,10 @@ void LALInferenceClearVariables(LALInferenceVariables *vars)
   }
   vars->head=NULL;
   vars->dimension=0;
-  if(vars->hash_table) XLALHashTblDestroy(vars->hash_table);
-  vars->hash_table=NULL;
-  
+  XLALFree(vars->slots);
+  vars->slots=NULL;
+  vars->nslots=0;
+
   return;
 }
 
@@ -571,18 +773,50 @@ void LALInferenceCopyVariables(LALInferenceVariables *origin, LALInferenceVariab
   /* Make sure the structure is initialised */
   if(!target) XLAL_ERROR_VOID(XLAL_EFAULT, "Unable to copy to uninitialised LALInferenceVariables structure.");
 
+  /* If the target holds the same scalar variables in the same order, which
+   * is the usual case when copying between parameter sets of a sampler,
+   * copy the values in place instead of rebuilding the target */
+  if(target->dimension==origin->dimension && target->slots)
+  {
+    LALInferenceVariableItem *tptr=target->head;
+    for(ptr=origin->head; ptr && tptr; ptr=ptr->next, tptr=tptr->next)
+    {
+      if(ptr->key!=tptr->key || ptr->type!=tptr->type || !ptr->value) break;
+      if(ptr->type==LALINFERENCE_gslMatrix_t || ptr->type==LALINFERENCE_INT4Vector_t
+         || ptr->type==LALINFERENCE_UINT4Vector_t || ptr->type==LALINFERENCE_REAL8Vector_t
+         || ptr->type==LALINFERENCE_COMPLEX16Vector_t) break;
+    }
+    if(!ptr && !tptr)
+    {
+      for(ptr=origin->head, tptr=target->head; ptr; ptr=ptr->next, tptr=tptr->next)
+      {
+        memcpy(tptr->value,ptr->value,LALInferenceTypeSize[ptr->type]);
+        tptr->vary=ptr->vary;
+      }
+      return;
+    }
+  }
+
   /* First clear the target */
   LALInferenceClearVariables(target);
 
   /* Now add the variables in reverse order, to preserve the
    * ordering */
   dims = LALInferenceGetVariableDimension( origin );
+  LALInferenceVariableItem *items[dims > 0 ? dims : 1];
+  for ( i = 0, ptr = origin->head; i < dims; i++, ptr = ptr->next ){
+    if(!ptr)
+    {
+      XLAL_ERROR_VOID(XLAL_EFAULT, "Bad LALInferenceVariable structure found while trying to copy.");
+    }
+    items[i] = ptr;
+  }
 
   /* then copy over elements of "origin" - due to how elements are added by
      LALInferenceAddVariable this has to be done in reverse order to preserve
      the ordering of "origin"  */
   for ( i = dims; i > 0; i-- ){
-    ptr = LALInferenceGetItemNr(origin, i);
+    ptr = items[i-1];
 
     if(!ptr)
     {
@@ -2184,6 +2418,7 @@ LALInferenceVariableItem *LALInferencePopVariableItem(LALInferenceVariables *var
   if(!thisPtr) return NULL;
   *prevPtr=thisPtr->next;
   thisPtr->next=NULL;
+  if(thisPtr->key<vars->nslots) vars->slots[thisPtr->key]=NULL;
   vars->dimension--;
   return thisPtr;
 }
@@ -2207,6 +2442,7 @@ void LALInferenceSortVariablesByName(LALInferenceVariables *vars)
     item->next=newHead;
     newHead=item;
 	vars->dimension++; /* Increase the dimension which was decreased by PopVariableItem */
+    vars->slots[item->key]=item; /* Restore the slot cleared by PopVariableItem */
   }
   vars->head=newHead;
   return;
@@ -3705,6 +3941,7 @@ LALInferenceVariables *LALInferenceReadVariablesBinary(FILE *stream)
 		if(item->value) XLALFree(item->value);
 		XLALFree(item);
   }
+  XLALFree(vars->slots);
   XLALFree(vars);
 
   return ret_vars;
@@ -3851,6 +4088,16 @@ void LALInferenceAddREAL8Variable(LALInferenceVariables * vars, const char * nam
   LALInferenceAddVariable(vars,name,(void*)&value,LALINFERENCE_REAL8_t,vary);
 }
 
+REAL8 LALInferenceGetREAL8VariableByKey(const LALInferenceVariables * vars, LALInferenceVariableKey key)
+/* Typed version of LALInferenceGetVariableByKey for REAL8 values.*/
+{
+  LALInferenceVariableItem *item=LALInferenceGetItemByKey(vars,key);
+  if(!item || item->type!=LALINFERENCE_REAL8_t){
+    XLAL_ERROR_REAL8(XLAL_ETYPE, "Entry \"%s\" not found or of wrong type.", LALInferenceGetVariableKeyName(key));
+  }
+  return *(REAL8 *)item->value;
+}
+
 REAL8 LALInferenceGetREAL8Variable(LALInferenceVariables * vars, const char * name)
 /* Typed version of LALInferenceGetVariable for REAL8 values.*/
 {
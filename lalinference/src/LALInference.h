@@ -160,12 +160,25 @@ tagVariableItem
   LALInferenceVariableType		type;
   LALInferenceParamVaryType		vary;
   struct tagVariableItem		*next;
+  UINT4                   key;  /** Interned key of \c name, see LALInferenceGetVariableKey() */
 } LALInferenceVariableItem;
 
 
+/**
+ * Handle for a variable name.  Variable names are interned in a
+ * process-wide table, so the key for a given name is the same in every
+ * LALInferenceVariables structure and stays valid for the lifetime of the
+ * process.  Code which looks up the same variables repeatedly should
+ * resolve their keys once with LALInferenceGetVariableKey(), and then use
+ * the *ByKey() accessors, which index directly into the variables without
+ * hashing or comparing strings.  The key 0 never names a variable.
+ */
+typedef UINT4 LALInferenceVariableKey;
+
 /**
  * The LALInferenceVariables structure to contain a set of parameters
- * Implemented as a linked list of LALInferenceVariableItems.
+ * Implemented as a linked list of LALInferenceVariableItems, together with
+ * an array of the items indexed by their interned keys.
  * Should only be accessed using the accessor functions below
  */
 typedef struct
@@ -173,7 +186,8 @@ tagLALInferenceVariables
 {
   LALInferenceVariableItem	*head;
   INT4 				dimension;
-  LALHashTbl        *hash_table;
+  LALInferenceVariableItem	**slots;  /** Items indexed by key; NULL if not present */
+  UINT4				nslots;   /** Length of \c slots */
 } LALInferenceVariables;
 
 /**
@@ -230,6 +244,39 @@ UINT4 LALInferencePrintNVariableItem(char *out, UINT4 N, const LALInferenceVaria
  */
 void *LALInferenceGetVariable(const LALInferenceVariables * vars, const char * name);
 
+/**
+ * Return the interned key for the variable name \c name, adding \c name to
+ * the table of interned names if necessary.  Returns 0 on error.
+ */
+LALInferenceVariableKey LALInferenceGetVariableKey(const char *name);
+
+/** Return the variable name for the interned key \c key, or NULL if there is none */
+const char *LALInferenceGetVariableKeyName(LALInferenceVariableKey key);
+
+/**
+ * Return the item of \c vars with the interned key \c key, or NULL if
+ * \c vars has no such variable
+ */
+LALInferenceVariableItem *LALInferenceGetItemByKey(const LALInferenceVariables *vars, LALInferenceVariableKey key);
+
+/**
+ * Return a pointer to the memory the variable \c vars is stored in specified by
+ * the interned key \c key; see LALInferenceGetVariable()
+ */
+void *LALInferenceGetVariableByKey(const LALInferenceVariables *vars, LALInferenceVariableKey key);
+
+/**
+ * Set the variable with interned key \c key in \c vars to a value;
+ * see LALInferenceSetVariable()
+ */
+void LALInferenceSetVariableByKey(LALInferenceVariables *vars, LALInferenceVariableKey key, const void *value);
+
+/**
+ * Checks for the variable with interned key \c key being present in \c vars
+ * returns 1(==true) or 0
+ */
+int LALInferenceCheckVariableByKey(const LALInferenceVariables *vars, LALInferenceVariableKey key);
+
 /** Get number of dimensions in variable \c vars */
 INT4 LALInferenceGetVariableDimension(LALInferenceVariables *vars);
 
@@ -450,6 +497,9 @@ typedef struct tagLALInferenceModel
   REAL8                        SNR; /** Network SNR at *params* */
   REAL8*                       ifo_loglikelihoods; /** Array of single-IFO likelihoods at *params* */
   REAL8*                       ifo_SNRs; /** Array of single-IFO SNRs at *params* */
+  REAL8*                       ifo_fPlus; /** Array of single-IFO antenna responses F+ at *params*, filled by the likelihood if not NULL */
+  REAL8*                       ifo_fCross; /** Array of single-IFO antenna responses Fx at *params*, filled by the likelihood if not NULL */
+  REAL8*                       ifo_timeshifts; /** Array of single-IFO template time shifts at *params*, filled by the likelihood if not NULL */
 
   REAL8                        fLow;   /** Start frequency for waveform generation */
   REAL8                        fHigh;   /** End frequency for waveform generation */
@@ -468,6 +518,8 @@ typedef struct tagLALInferenceModel
   REAL8                        padding; /** The padding of the above window */
   struct tagLALInferenceROQModel *roq; /** ROQ data */
   int roq_flag;               /** Is ROQ enabled */
+  struct tagLALInferenceRelBinModel *relbin; /** Relative binning data */
+  int relbin_flag;            /** Is relative binning enabled */
   LALSimNeutronStarFamily     *eos_fam; /** Neutron Star equation of state family */
 
 } LALInferenceModel;
@@ -661,6 +713,7 @@ tagLALInferenceIFOData
   UINT4                     likeli_counter; /** counts how many time the likelihood has been calculated */
   UINT4                     templa_counter; /** counts how many time the template has been calculated */
   struct tagLALInferenceROQData *roq; /** ROQ data */
+  struct tagLALInferenceRelBinData *relbin; /** Relative binning summary data */
 
   struct tagLALInferenceIFOData      *next;     /** A pointer to the next set of data for linked list */
 } LALInferenceIFOData;
@@ -736,6 +789,36 @@ tagLALInferenceROQModel
 
 } LALInferenceROQModel;
 
+/**
+ * Structure to contain data-related relative binning (heterodyned likelihood)
+ * quantities: the summary data of the data against the fiducial waveform, in
+ * each frequency bin between consecutive frequency nodes.
+ */
+typedef struct
+tagLALInferenceRelBinData
+{
+  UINT4 nbins;   /** number of frequency bins */
+  COMPLEX16 *h0; /** fiducial detector waveform at the nbins+1 frequency nodes */
+  COMPLEX16 *A0; /** sum of 4 df d conj(h0) / S over each bin */
+  COMPLEX16 *A1; /** as A0, weighted by the frequency offset from the bin centre */
+  REAL8 *B0;     /** sum of 4 df |h0|^2 / S over each bin */
+  REAL8 *B1;     /** as B0, weighted by the frequency offset from the bin centre */
+} LALInferenceRelBinData;
+
+/**
+ * Structure to contain model-related relative binning quantities
+ */
+typedef struct
+tagLALInferenceRelBinModel
+{
+  COMPLEX16FrequencySeries *hptilde; /** template at the frequency nodes */
+  COMPLEX16FrequencySeries *hctilde;
+
+  COMPLEX16Sequence *calFactor; /** calibration factors at the frequency nodes */
+
+  REAL8Sequence *frequencyNodes; /** edges of the frequency bins, on the frequency grid of the data */
+} LALInferenceRelBinModel;
+
 /**
  * Structure to contain data-related Reduced Order Quadrature quantities
  */
@@ -1109,6 +1192,8 @@ void LALInferenceAddREAL8Variable(LALInferenceVariables * vars, const char * nam
 
 REAL8 LALInferenceGetREAL8Variable(LALInferenceVariables * vars, const char * name);
 
+REAL8 LALInferenceGetREAL8VariableByKey(const LALInferenceVariables * vars, LALInferenceVariableKey key);
+
 void LALInferenceSetREAL8Variable(LALInferenceVariables* vars,const char* name,REAL8 value);
 
 void LALInferenceAddCOMPLEX8Variable(LALInferenceVariables * vars, const char * name, COMPLEX8 value, LALInferenceParamVaryType vary);
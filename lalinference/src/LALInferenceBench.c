@@ -21,6 +21,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include <lal/LALInference.h>
 #include <lal/LALInferenceInit.h>
 #include <lal/LALInferenceReadData.h>
@@ -42,6 +43,8 @@ const char HELPSTR[]=\
     --bench-template   : Only benchmark template function\n\
     --bench-likelihood : Only benchmark likelihood function\n\
                          (defaults to benchmarking both)\n\
+    --bench-variables  : Only benchmark LALInferenceVariables lookups\n\
+                         by name and by key, and copies\n\
  Example (for 1.0-1.0 binary with seglen 8, srate 4096): \n\
  $ ./lalinference_bench --psdlength 1000 --psdstart 1 --seglen 8 --srate 4096 --trigtime 0 --ifo H1 --H1-channel LALSimAdLIGO --H1-cache LALSimAdLIGO --dataseed 1324 --Niter 10000 --fix-chirpmass 1.218 --fix-q 1.0\n\n\n\
 ";
@@ -104,19 +107,68 @@ void bench_template(LALInferenceRunState *runState, UINT4 Niter)
   fprintf_bench(stdout, r_usage_start, r_usage_end, Niter);
 }
 
+void bench_variables(LALInferenceRunState *runState, UINT4 Niter);
+void bench_variables(LALInferenceRunState *runState, UINT4 Niter)
+{
+  UINT4 i=0,j=0;
+  struct rusage r_usage_start,r_usage_end;
+  LALInferenceVariables *params=runState->threads[0]->model->params;
+  LALInferenceVariables copy;
+  LALInferenceVariableItem *item=NULL;
+  UINT4 N=params->dimension;
+  const char *names[N>0?N:1];
+  LALInferenceVariableKey keys[N>0?N:1];
+  volatile void *sink=NULL;
+
+  for(item=params->head,j=0;item;item=item->next,j++)
+  {
+    names[j]=item->name;
+    keys[j]=LALInferenceGetVariableKey(item->name);
+  }
+
+  fprintf(stdout,"Benchmarking %u variable lookups by name:\n",N);
+  getrusage(RUSAGE_SELF, &r_usage_start);
+  for(i=0;i<Niter;i++)
+    for(j=0;j<N;j++)
+      sink=LALInferenceGetVariable(params,names[j]);
+  getrusage(RUSAGE_SELF, &r_usage_end);
+  fprintf_bench(stdout, r_usage_start, r_usage_end, Niter);
+  printf("\n");
+
+  fprintf(stdout,"Benchmarking %u variable lookups by key:\n",N);
+  getrusage(RUSAGE_SELF, &r_usage_start);
+  for(i=0;i<Niter;i++)
+    for(j=0;j<N;j++)
+      sink=LALInferenceGetVariableByKey(params,keys[j]);
+  getrusage(RUSAGE_SELF, &r_usage_end);
+  fprintf_bench(stdout, r_usage_start, r_usage_end, Niter);
+  printf("\n");
+
+  memset(&copy,0,sizeof(copy));
+  fprintf(stdout,"Benchmarking copy of %u variables:\n",N);
+  getrusage(RUSAGE_SELF, &r_usage_start);
+  for(i=0;i<Niter;i++)
+    LALInferenceCopyVariables(params,&copy);
+  getrusage(RUSAGE_SELF, &r_usage_end);
+  fprintf_bench(stdout, r_usage_start, r_usage_end, Niter);
+  LALInferenceClearVariables(&copy);
+  (void)sink;
+}
+
 int main(int argc, char *argv[]){
   ProcessParamsTable *procParams = NULL,*ppt=NULL;
   LALInferenceRunState *runState=NULL;
   UINT4 Niter=1000;
   UINT4 bench_L=1;
   UINT4 bench_T=1;
+  UINT4 bench_V=0;
   
   procParams=LALInferenceParseCommandLine(argc,argv);
 
   if(LALInferenceGetProcParamVal(procParams,"--help"))
   {
     fprintf(stdout,"%s",HELPSTR);
-    bench_T=bench_L=0;
+    bench_T=bench_L=bench_V=0;
   }
   if((ppt=LALInferenceGetProcParamVal(procParams,"--Niter")))
      Niter=atoi(ppt->value);
@@ -128,6 +180,10 @@ int main(int argc, char *argv[]){
   {
     bench_T=0; bench_L=1;
   }
+  if(LALInferenceGetProcParamVal(procParams,"--bench-variables"))
+  {
+    bench_T=0; bench_L=0; bench_V=1;
+  }
 
   
   runState = LALInferenceInitRunState(procParams);
@@ -160,6 +216,11 @@ int main(int argc, char *argv[]){
     bench_likelihood(runState,Niter);
     printf("\n");
   }
+  if(bench_V)
+  {
+    bench_variables(runState,Niter);
+    printf("\n");
+  }
   
   return(0);
 }
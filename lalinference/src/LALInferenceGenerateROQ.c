@@ -20,11 +20,19 @@
  */
 
 #include <lal/LALInferenceGenerateROQ.h>
+#include <lal/LALInferenceHDF5.h>
+#include <lal/LogPrintf.h>
+
+#include <stdio.h>
+#include <unistd.h>
 
 #ifndef _OPENMP
 #define omp ignore
 #endif
 
+/* minimum time (in seconds) between checkpoints of the reduced basis generation from a file */
+#define ROQ_CHECKPOINT_INTERVAL 600.0
+
 
 /* internal function definitions */
 
@@ -87,6 +95,10 @@ COMPLEX16Array *complex_B_matrix(gsl_matrix_complex *V, gsl_matrix_complex *RB);
 /* find the index of the absolute maximum value for a complex vector */
 int complex_vector_maxabs_index( gsl_vector_complex *c );
 
+/* weighted dot products of contiguous rows that neither allocate memory nor call GSL, so are safe to use in threaded loops */
+static REAL8 weighted_dot_rows(const REAL8Vector *delta, const REAL8 *a, const REAL8 *b, size_t n);
+static COMPLEX16 complex_weighted_dot_rows(const REAL8Vector *delta, const COMPLEX16 *a, const COMPLEX16 *b, size_t n);
+
 
 /** \brief Function to project the training set onto a given basis vector
  *
@@ -249,6 +261,71 @@ gsl_complex complex_weighted_dot_product(const gsl_vector *weight, gsl_vector_co
 }
 
 
+/** \brief The weighted dot product of two real arrays
+ *
+ * This is equivalent to \c weighted_dot_product, but works on the rows of a
+ * \c REAL8Array directly, and does not allocate memory or call GSL, so can be
+ * called from within threaded loops.
+ *
+ * @param[in] delta The (set of) scaling factor(s) for the dot product
+ * @param[in] a The first array
+ * @param[in] b The second array
+ * @param[in] n The length of the arrays
+ *
+ * @return The real dot product of the two arrays
+ */
+static REAL8 weighted_dot_rows(const REAL8Vector *delta, const REAL8 *a, const REAL8 *b, size_t n){
+  REAL8 dp = 0.;
+
+  if ( delta->length == 1 ){
+    for ( size_t j = 0; j < n; j++ ){ dp += a[j]*b[j]; }
+    dp *= delta->data[0];
+  }
+  else{
+    for ( size_t j = 0; j < n; j++ ){ dp += delta->data[j]*a[j]*b[j]; }
+  }
+
+  return dp;
+}
+
+
+/** \brief The weighted dot product of two complex arrays
+ *
+ * This is equivalent to \c complex_weighted_dot_product (taking the complex
+ * conjugate of the first array), but works on the rows of a \c COMPLEX16Array
+ * directly, and does not allocate memory or call GSL, so can be called from
+ * within threaded loops.
+ *
+ * @param[in] delta The (set of) real scaling factor(s) for the dot product
+ * @param[in] a The first complex array
+ * @param[in] b The second complex array
+ * @param[in] n The length of the arrays
+ *
+ * @return The complex dot product of the two arrays
+ */
+static COMPLEX16 complex_weighted_dot_rows(const REAL8Vector *delta, const COMPLEX16 *a, const COMPLEX16 *b, size_t n){
+  REAL8 dpre = 0., dpim = 0.;
+
+  /* write out the complex product, so that it is not done with the slow C99 Annex G rules */
+  if ( delta->length == 1 ){
+    for ( size_t j = 0; j < n; j++ ){
+      dpre += creal(a[j])*creal(b[j]) + cimag(a[j])*cimag(b[j]);
+      dpim += creal(a[j])*cimag(b[j]) - cimag(a[j])*creal(b[j]);
+    }
+    dpre *= delta->data[0];
+    dpim *= delta->data[0];
+  }
+  else{
+    for ( size_t j = 0; j < n; j++ ){
+      dpre += delta->data[j]*(creal(a[j])*creal(b[j]) + cimag(a[j])*cimag(b[j]));
+      dpim += delta->data[j]*(creal(a[j])*cimag(b[j]) - cimag(a[j])*creal(b[j]));
+    }
+  }
+
+  return crect(dpre, dpim);
+}
+
+
 /** \brief Normalise a real vector with a given weighting
  *
  * @param[in] weight The weighting(s) in the normalisation (e.g. time of frequency step(s) between points)
@@ -781,13 +858,14 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
 
   REAL8 worst_err;          /* errors in greedy sweep */
   UINT4 worst_app = 0;      /* worst error stored */
-  REAL8 tmpc;               /* worst error temp */
 
-  gsl_vector *ts_el, *last_rb, *ortho_basis, *ru;
-  gsl_matrix *R_matrix;
-  REAL8 A_row_norms2[rows];              // || A(i,:) ||^2
-  REAL8 projection_norms2[rows];
-  REAL8 errors[rows];                    // approximation errors at i^{th} sweep
+  gsl_vector *ts_el, *ortho_basis, *ru;
+
+  /* allocate these on the heap, as training sets can contain ~10^6 waveforms */
+  REAL8 *A_row_norms2 = XLALCalloc(rows, sizeof(REAL8));      // || A(i,:) ||^2
+  REAL8 *projection_norms2 = XLALCalloc(rows, sizeof(REAL8));
+  REAL8 *errors = XLALCalloc(rows, sizeof(REAL8));            // approximation errors at i^{th} sweep
+  XLAL_CHECK_REAL8( A_row_norms2 != NULL && projection_norms2 != NULL && errors != NULL, XLAL_ENOMEM );
 
   REAL8Array *RB = NULL;
   UINT4Vector *dims = NULL;
@@ -795,17 +873,9 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
 
   /* this memory should be freed here */
   ts_el         = gsl_vector_alloc(cols);
-  last_rb       = gsl_vector_alloc(cols);
   ortho_basis   = gsl_vector_alloc(cols);
   ru            = gsl_vector_alloc(max_RB);
 
-  //project_coeff = gsl_matrix_alloc(max_RB,rows);
-  REAL8 projection_coeff;
-  R_matrix = gsl_matrix_alloc(max_RB, max_RB);
-
-  /* initialise projection norms with zeros */
-  for(size_t i=0; i<rows; ++i){ projection_norms2[i] = 0; }
-
   gsl_vector_view deltaview;
   XLAL_CALLGSL( deltaview = gsl_vector_view_array(delta->data, delta->length) );
 
@@ -813,9 +883,10 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
   normalise_training_set(&deltaview.vector, &TSview.matrix);
 
   /* compute norm of each training space element */
+  #pragma omp parallel for schedule(static)
   for(size_t i=0; i<rows; ++i) {
-    gsl_matrix_get_row(ts_el, &TSview.matrix, i);
-    A_row_norms2[i] = normalisation(&deltaview.vector, ts_el);
+    const REAL8 *ts_row = ts->data + i*cols;
+    A_row_norms2[i] = sqrt(fabs(weighted_dot_rows(delta, ts_row, ts_row, cols)));
   }
 
   /* initialize algorithm with first training set value */
@@ -828,8 +899,6 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
   XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, 1, cols) );
   gsl_matrix_get_row(ts_el, &TSview.matrix, 0);
   gsl_matrix_set_row(&RBview.matrix, 0, ts_el);
-  tmpc = 1.;
-  gsl_matrix_set(R_matrix, 0, 0, tmpc);  // assumes normalized solutions
 
   gpts->data[0] = 0;
   UINT4 dim_RB          = 1;
@@ -837,12 +906,12 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
 
   /* loop to find reduced basis */
   while( 1 ){
-    gsl_matrix_get_row(last_rb, &RBview.matrix, dim_RB-1); /* previous basis */
+    const REAL8 *last_rb = RB->data + (dim_RB-1)*cols; /* previous basis */
 
-    /* Compute overlaps of pieces of training set with rb_new */
+    /* Compute overlaps of pieces of training set with rb_new (each row is independent, so share them between threads) */
+    #pragma omp parallel for schedule(static)
     for(size_t i = 0; i < rows; i++){
-      gsl_matrix_get_row(ts_el, &TSview.matrix, i);
-      projection_coeff = weighted_dot_product(&deltaview.vector, last_rb, ts_el);
+      REAL8 projection_coeff = weighted_dot_rows(delta, last_rb, ts->data + i*cols, cols);
       projection_norms2[i] += (projection_coeff*projection_coeff);
       errors[i] = A_row_norms2[i] - projection_norms2[i];
     }
@@ -907,7 +976,6 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
     XLAL_CALLGSL( RBview = gsl_matrix_view_array((double*)RB->data, dim_RB+1, cols) );
 
     gsl_matrix_set_row(&RBview.matrix, dim_RB, ortho_basis);
-    gsl_matrix_set_row(R_matrix, dim_RB, ru);
 
     ++dim_RB;
 
@@ -919,10 +987,11 @@ REAL8 LALInferenceGenerateREAL8OrthonormalBasis(REAL8Array **RBin,
 
   XLALDestroyUINT4Vector(dims);
   gsl_vector_free(ts_el);
-  gsl_vector_free(last_rb);
   gsl_vector_free(ortho_basis);
   gsl_vector_free(ru);
-  gsl_matrix_free(R_matrix);
+  XLALFree(A_row_norms2);
+  XLALFree(projection_norms2);
+  XLALFree(errors);
 
   return worst_err;
 }
@@ -986,13 +1055,14 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
 
   REAL8 worst_err;          /* errors in greedy sweep */
   UINT4 worst_app = 0;      /* worst error stored */
-  gsl_complex tmpc;         /* worst error temp */
 
-  gsl_vector_complex *ts_el, *last_rb, *ortho_basis, *ru;
-  gsl_matrix_complex *R_matrix;
-  REAL8 A_row_norms2[rows];              // || A(i,:) ||^2
-  REAL8 projection_norms2[rows];
-  REAL8 errors[rows];                    // approximation errors at i^{th} sweep
+  gsl_vector_complex *ts_el, *ortho_basis, *ru;
+
+  /* allocate these on the heap, as training sets can contain ~10^6 waveforms */
+  REAL8 *A_row_norms2 = XLALCalloc(rows, sizeof(REAL8));      // || A(i,:) ||^2
+  REAL8 *projection_norms2 = XLALCalloc(rows, sizeof(REAL8));
+  REAL8 *errors = XLALCalloc(rows, sizeof(REAL8));            // approximation errors at i^{th} sweep
+  XLAL_CHECK_REAL8( A_row_norms2 != NULL && projection_norms2 != NULL && errors != NULL, XLAL_ENOMEM );
 
   COMPLEX16Array *RB = NULL;
   UINT4Vector *dims = NULL;
@@ -1000,17 +1070,9 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   
   /* this memory should be freed here */
   ts_el         = gsl_vector_complex_alloc(cols);
-  last_rb       = gsl_vector_complex_alloc(cols);
   ortho_basis   = gsl_vector_complex_alloc(cols);
   ru            = gsl_vector_complex_alloc(max_RB);
 
-  //project_coeff = gsl_matrix_complex_alloc(max_RB,rows);
-  gsl_complex projection_coeff;
-  R_matrix = gsl_matrix_complex_alloc(max_RB, max_RB);
-
-  /* initialise projection norms with zeros */
-  for(size_t i=0; i<rows; ++i){ projection_norms2[i] = 0; }
-
   gsl_vector_view deltaview;
   XLAL_CALLGSL( deltaview = gsl_vector_view_array(delta->data, delta->length) );
   
@@ -1018,9 +1080,10 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   complex_normalise_training_set(&deltaview.vector, &TSview.matrix);
 
   /* compute norm of each training space element */
+  #pragma omp parallel for schedule(static)
   for(size_t i=0; i<rows; ++i) {
-    gsl_matrix_complex_get_row(ts_el, &TSview.matrix, i);
-    A_row_norms2[i] = complex_normalisation(&deltaview.vector, ts_el);
+    const COMPLEX16 *ts_row = ts->data + i*cols;
+    A_row_norms2[i] = sqrt(cabs(complex_weighted_dot_rows(delta, ts_row, ts_row, cols)));
   }
 
   /* initialize algorithm with first training set value */
@@ -1033,21 +1096,19 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
   XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, 1, cols) );
   gsl_matrix_complex_get_row(ts_el, &TSview.matrix, 0);
   gsl_matrix_complex_set_row(&RBview.matrix, 0, ts_el);
-  GSL_SET_COMPLEX(&tmpc, 1.0, 0.0);
-  gsl_matrix_complex_set(R_matrix, 0, 0, tmpc);  // assumes normalized solutions
 
   gpts->data[0] = 0;
   UINT4 dim_RB          = 1;
 
   /* loop to find reduced basis */
   while( 1 ){
-    gsl_matrix_complex_get_row(last_rb, &RBview.matrix, dim_RB-1); /* previous basis */
+    const COMPLEX16 *last_rb = RB->data + (dim_RB-1)*cols; /* previous basis */
 
-    /* Compute overlaps of pieces of training set with rb_new */
+    /* Compute overlaps of pieces of training set with rb_new (each row is independent, so share them between threads) */
+    #pragma omp parallel for schedule(static)
     for(size_t i = 0; i < rows; i++){
-      gsl_matrix_complex_get_row(ts_el, &TSview.matrix, i);
-      projection_coeff = complex_weighted_dot_product(&deltaview.vector, last_rb, ts_el);
-      projection_norms2[i] += (projection_coeff.dat[0]*projection_coeff.dat[0] + projection_coeff.dat[1]*projection_coeff.dat[1]);
+      COMPLEX16 projection_coeff = complex_weighted_dot_rows(delta, last_rb, ts->data + i*cols, cols);
+      projection_norms2[i] += (creal(projection_coeff)*creal(projection_coeff) + cimag(projection_coeff)*cimag(projection_coeff));
       errors[i] = A_row_norms2[i] - projection_norms2[i];
     }
 
@@ -1111,7 +1172,6 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
     XLAL_CALLGSL( RBview = gsl_matrix_complex_view_array((double*)RB->data, dim_RB+1, cols) );
 
     gsl_matrix_complex_set_row(&RBview.matrix, dim_RB, ortho_basis);
-    gsl_matrix_complex_set_row(R_matrix, dim_RB, ru);
 
     ++dim_RB;
 
@@ -1123,10 +1183,617 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RBin,
 
   XLALDestroyUINT4Vector(dims);
   gsl_vector_complex_free(ts_el);
-  gsl_vector_complex_free(last_rb);
   gsl_vector_complex_free(ortho_basis);
   gsl_vector_complex_free(ru);
-  gsl_matrix_complex_free(R_matrix);
+  XLALFree(A_row_norms2);
+  XLALFree(projection_norms2);
+  XLALFree(errors);
+
+  return worst_err;
+}
+
+
+/* functions for generating a reduced basis from a training set that is read from a HDF5 file in chunks */
+
+/** \brief The normalisation of a row of a real, or complex, training set
+ *
+ * @param[in] delta The time/frequency step(s) in the training set
+ * @param[in] a The row, holding \c cols \c REAL8 values, or \c cols \c COMPLEX16 values if \c iscomplex is set
+ * @param[in] cols The number of points in the row
+ * @param[in] iscomplex Set if the row is complex
+ *
+ * @return The normalisation
+ */
+static REAL8 row_normalisation(const REAL8Vector *delta, const REAL8 *a, size_t cols, int iscomplex){
+  if ( iscomplex ){
+    return sqrt(cabs(complex_weighted_dot_rows(delta, (const COMPLEX16 *)a, (const COMPLEX16 *)a, cols)));
+  }
+  return sqrt(fabs(weighted_dot_rows(delta, a, a, cols)));
+}
+
+
+/** \brief The square of the projection of one row of a real, or complex, training set onto another
+ *
+ * @param[in] delta The time/frequency step(s) in the training set
+ * @param[in] a The first row (e.g. a basis vector)
+ * @param[in] b The second row
+ * @param[in] cols The number of points in the rows
+ * @param[in] iscomplex Set if the rows are complex
+ *
+ * @return The squared absolute value of the weighted dot product of the rows
+ */
+static REAL8 row_projection2(const REAL8Vector *delta, const REAL8 *a, const REAL8 *b, size_t cols, int iscomplex){
+  if ( iscomplex ){
+    COMPLEX16 c = complex_weighted_dot_rows(delta, (const COMPLEX16 *)a, (const COMPLEX16 *)b, cols);
+    return creal(c)*creal(c) + cimag(c)*cimag(c);
+  }
+  REAL8 c = weighted_dot_rows(delta, a, b, cols);
+  return c*c;
+}
+
+
+/** \brief Project a training set, read from file in chunks, onto a range of reduced basis vectors
+ *
+ * The chunks are read serially, and the rows within each chunk are shared between threads. The
+ * training set waveforms do not need to be normalised, as the normalisation is applied to the
+ * projections.
+ *
+ * @param[in] reader The training set
+ * @param[in] buffer Space for \c chunksize rows of the training set
+ * @param[in] chunksize The number of rows of the training set to read at once
+ * @param[in] delta The time/frequency step(s) in the training set
+ * @param[in] rb The reduced basis
+ * @param[in] rb0 The first basis vector to project onto
+ * @param[in] rb1 One after the last basis vector to project onto
+ * @param[in,out] rownorms The normalisation of each training set waveform (calculated if \c getnorms is set)
+ * @param[in,out] projection_norms2 The sum of the squared projections of each training set waveform (this is added to)
+ * @param[in] getnorms Set if \c rownorms need to be calculated
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE if the training set could not be read
+ */
+static int project_training_set_chunks(LALInferenceH5RowReader *reader,
+                                       REAL8 *buffer,
+                                       size_t chunksize,
+                                       const REAL8Vector *delta,
+                                       const REAL8 *rb,
+                                       size_t rb0,
+                                       size_t rb1,
+                                       REAL8 *rownorms,
+                                       REAL8 *projection_norms2,
+                                       int getnorms){
+  size_t rows = LALInferenceH5RowReaderQueryNRows(reader), cols = LALInferenceH5RowReaderQueryNColumns(reader);
+  int iscomplex = ( LALInferenceH5RowReaderQueryType(reader) == LAL_Z_TYPE_CODE );
+  size_t rowlen = iscomplex ? 2*cols : cols;
+
+  for ( size_t row0 = 0; row0 < rows; row0 += chunksize ){
+    size_t nrows = ( rows - row0 < chunksize ) ? rows - row0 : chunksize;
+
+    XLAL_CHECK( LALInferenceH5RowReaderRead(reader, buffer, row0, nrows) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* project each row onto all the new basis vectors while it is in cache (each row is independent, so share them between threads) */
+    #pragma omp parallel for schedule(static)
+    for ( size_t i = 0; i < nrows; i++ ){
+      const REAL8 *ts_row = buffer + i*rowlen;
+
+      if ( getnorms ){ rownorms[row0+i] = row_normalisation(delta, ts_row, cols, iscomplex); }
+      REAL8 invnorm2 = ( rownorms[row0+i] > 0. ) ? 1./(rownorms[row0+i]*rownorms[row0+i]) : 0.;
+
+      for ( size_t k = rb0; k < rb1; k++ ){
+        projection_norms2[row0+i] += invnorm2*row_projection2(delta, rb + k*rowlen, ts_row, cols, iscomplex);
+      }
+    }
+  }
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Find the training set waveforms that are worst represented by the current reduced basis
+ *
+ * @param[out] cand The indices of up to \c nblock training set waveforms that are not already in
+ * the basis, in order of decreasing projection error
+ * @param[out] canderr The projection errors of the \c cand waveforms
+ * @param[out] worst_err The maximum projection error of all the training set waveforms
+ * @param[in] nblock The maximum number of waveforms to return
+ * @param[in] rownorms The normalisation of each training set waveform
+ * @param[in] projection_norms2 The sum of the squared projections of each training set waveform
+ * @param[in] used Flags for the training set waveforms that are already in the basis
+ * @param[in] rows The number of training set waveforms
+ *
+ * @return The number of waveforms returned in \c cand
+ */
+static size_t worst_represented_rows(UINT4 *cand,
+                                     REAL8 *canderr,
+                                     REAL8 *worst_err,
+                                     size_t nblock,
+                                     const REAL8 *rownorms,
+                                     const REAL8 *projection_norms2,
+                                     const UCHAR *used,
+                                     size_t rows){
+  size_t ncand = 0;
+
+  *worst_err = 0.;
+  for ( size_t i = 0; i < rows; i++ ){
+    REAL8 err = ( rownorms[i] > 0. ? 1. : 0. ) - projection_norms2[i];
+
+    if ( *worst_err < err ){ *worst_err = err; }
+    if ( used[i] || ( ncand == nblock && err <= canderr[ncand-1] ) ){ continue; }
+
+    /* insertion into the list of candidates, which is kept sorted */
+    size_t j = ( ncand < nblock ) ? ncand++ : ncand-1;
+    while ( j > 0 && canderr[j-1] < err ){
+      cand[j] = cand[j-1];
+      canderr[j] = canderr[j-1];
+      j--;
+    }
+    cand[j] = (UINT4)i;
+    canderr[j] = err;
+  }
+
+  return ncand;
+}
+
+
+/** \brief Write the state of a reduced basis generation to a checkpoint file
+ *
+ * The state is written to a temporary file which then replaces \c checkpoint, so an interrupted
+ * write does not destroy an earlier checkpoint.
+ *
+ * @param[in] checkpoint The name of the checkpoint file
+ * @param[in] reader The training set
+ * @param[in] rb The reduced basis
+ * @param[in] dim_RB The number of reduced basis vectors
+ * @param[in] gpts The greedy points of the reduced basis
+ * @param[in] rownorms The normalisation of each training set waveform
+ * @param[in] projection_norms2 The sum of the squared projections of each training set waveform
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE if the file could not be written
+ */
+static int write_basis_checkpoint(const CHAR *checkpoint,
+                                  const LALInferenceH5RowReader *reader,
+                                  REAL8 *rb,
+                                  UINT4 dim_RB,
+                                  UINT4 *gpts,
+                                  REAL8 *rownorms,
+                                  REAL8 *projection_norms2){
+  UINT4 rows = LALInferenceH5RowReaderQueryNRows(reader), cols = LALInferenceH5RowReaderQueryNColumns(reader);
+  UINT4 type = LALInferenceH5RowReaderQueryType(reader);
+  UINT4 dimdata[2] = { dim_RB, ( type == LAL_Z_TYPE_CODE ) ? 2*cols : cols };
+
+  /* wrap the existing memory rather than copying it (complex bases are written as interleaved REAL8 values) */
+  UINT4Vector dims = { .length = 2, .data = dimdata };
+  REAL8Array basis = { .dimLength = &dims, .data = rb };
+  UINT4Vector gptsvec = { .length = dim_RB, .data = gpts };
+  REAL8Vector normsvec = { .length = rows, .data = rownorms };
+  REAL8Vector projvec = { .length = rows, .data = projection_norms2 };
+
+  CHAR tmpname[FILENAME_MAX];
+  XLAL_CHECK( snprintf(tmpname, sizeof(tmpname), "%s.tmp", checkpoint) < (int)sizeof(tmpname), XLAL_EBADLEN, "Checkpoint file name '%s' is too long", checkpoint );
+
+  LALH5File *file = XLALH5FileOpen(tmpname, "w");
+  XLAL_CHECK( file != NULL, XLAL_EFUNC, "Could not open checkpoint file '%s'", tmpname );
+
+  int status = XLAL_SUCCESS;
+  status |= XLALH5FileAddScalarAttribute(file, "training_set_rows", &rows, LAL_U4_TYPE_CODE);
+  status |= XLALH5FileAddScalarAttribute(file, "training_set_columns", &cols, LAL_U4_TYPE_CODE);
+  status |= XLALH5FileAddScalarAttribute(file, "training_set_type", &type, LAL_U4_TYPE_CODE);
+  status |= XLALH5FileWriteREAL8Array(file, "basis", &basis);
+  status |= XLALH5FileWriteUINT4Vector(file, "greedy_points", &gptsvec);
+  status |= XLALH5FileWriteREAL8Vector(file, "norms", &normsvec);
+  status |= XLALH5FileWriteREAL8Vector(file, "projection_norms2", &projvec);
+  XLALH5FileClose(file);
+  XLAL_CHECK( status == XLAL_SUCCESS, XLAL_EFUNC, "Could not write checkpoint file '%s'", tmpname );
+
+  XLAL_CHECK( rename(tmpname, checkpoint) == 0, XLAL_ESYS, "Could not move '%s' to '%s'", tmpname, checkpoint );
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Read the state of a reduced basis generation from a checkpoint file
+ *
+ * @param[in] checkpoint The name of the checkpoint file
+ * @param[in] reader The training set (which must match the one in the checkpoint)
+ * @param[out] rb The reduced basis (this is reallocated)
+ * @param[out] dim_RB The number of reduced basis vectors
+ * @param[out] gpts The greedy points of the reduced basis
+ * @param[out] rownorms The normalisation of each training set waveform
+ * @param[out] projection_norms2 The sum of the squared projections of each training set waveform
+ *
+ * @return \c XLAL_SUCCESS, or \c XLAL_FAILURE if the file could not be read or does not match the training set
+ */
+static int read_basis_checkpoint(const CHAR *checkpoint,
+                                 const LALInferenceH5RowReader *reader,
+                                 REAL8 **rb,
+                                 UINT4 *dim_RB,
+                                 UINT4 *gpts,
+                                 REAL8 *rownorms,
+                                 REAL8 *projection_norms2){
+  UINT4 rows = LALInferenceH5RowReaderQueryNRows(reader), cols = LALInferenceH5RowReaderQueryNColumns(reader);
+  UINT4 type = LALInferenceH5RowReaderQueryType(reader);
+  UINT4 rowlen = ( type == LAL_Z_TYPE_CODE ) ? 2*cols : cols;
+  UINT4 ckrows = 0, ckcols = 0, cktype = 0;
+
+  LALH5File *file = XLALH5FileOpen(checkpoint, "r");
+  XLAL_CHECK( file != NULL, XLAL_EFUNC, "Could not open checkpoint file '%s'", checkpoint );
+
+  int status = XLAL_SUCCESS;
+  status |= XLALH5FileQueryScalarAttributeValue(&ckrows, file, "training_set_rows");
+  status |= XLALH5FileQueryScalarAttributeValue(&ckcols, file, "training_set_columns");
+  status |= XLALH5FileQueryScalarAttributeValue(&cktype, file, "training_set_type");
+  REAL8Array *basis = XLALH5FileReadREAL8Array(file, "basis");
+  UINT4Vector *gptsvec = XLALH5FileReadUINT4Vector(file, "greedy_points");
+  REAL8Vector *normsvec = XLALH5FileReadREAL8Vector(file, "norms");
+  REAL8Vector *projvec = XLALH5FileReadREAL8Vector(file, "projection_norms2");
+  XLALH5FileClose(file);
+
+  if ( status != XLAL_SUCCESS || basis == NULL || gptsvec == NULL || normsvec == NULL || projvec == NULL ){
+    status = XLAL_FAILURE;
+    XLAL_PRINT_ERROR( "Could not read checkpoint file '%s'", checkpoint );
+  }
+  else if ( ckrows != rows || ckcols != cols || cktype != type || basis->dimLength->length != 2
+            || basis->dimLength->data[0] != gptsvec->length || basis->dimLength->data[1] != rowlen
+            || normsvec->length != rows || projvec->length != rows ){
+    status = XLAL_FAILURE;
+    XLAL_PRINT_ERROR( "Checkpoint file '%s' does not match the training set", checkpoint );
+  }
+  else{
+    *dim_RB = gptsvec->length;
+    *rb = XLALRealloc(*rb, (size_t)(*dim_RB)*rowlen*sizeof(REAL8));
+    if ( *rb == NULL ){ status = XLAL_FAILURE; }
+    else{
+      memcpy(*rb, basis->data, (size_t)(*dim_RB)*rowlen*sizeof(REAL8));
+      memcpy(gpts, gptsvec->data, (*dim_RB)*sizeof(UINT4));
+      memcpy(rownorms, normsvec->data, rows*sizeof(REAL8));
+      memcpy(projection_norms2, projvec->data, rows*sizeof(REAL8));
+    }
+  }
+
+  XLALDestroyREAL8Array(basis);
+  XLALDestroyUINT4Vector(gptsvec);
+  XLALDestroyREAL8Vector(normsvec);
+  XLALDestroyREAL8Vector(projvec);
+
+  XLAL_CHECK( status == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+}
+
+
+/** \brief Create an orthonormal basis from a real or complex training set read from a HDF5 file
+ *
+ * This is used internally by \c LALInferenceGenerateREAL8OrthonormalBasisFromFile and
+ * \c LALInferenceGenerateCOMPLEX16OrthonormalBasisFromFile, which document the algorithm.
+ *
+ * @param[out] rbout The reduced basis, with \c cols \c REAL8 values, or \c cols \c COMPLEX16 values,
+ * per basis vector
+ * @param[out] greedypoints The rows of the training set that formed the reduced basis
+ * @param[out] colsout The number of points in each basis vector
+ * @param[in] type The expected type of the training set
+ * @param[in] delta The time/frequency step(s) in the training set
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation
+ * @param[in] tsfile The HDF5 file containing the training set
+ * @param[in] tsname The name of the training set dataset
+ * @param[in] chunksize The number of rows of the training set to read at once
+ * @param[in] blocksize The maximum number of basis vectors to add after each pass over the training set
+ * @param[in] checkpoint The name of a checkpoint file, or \c NULL
+ *
+ * @return The maximum projection error of the training set onto the final reduced basis
+ */
+static REAL8 generate_basis_from_file(REAL8 **rbout,
+                                      UINT4Vector **greedypoints,
+                                      size_t *colsout,
+                                      LALTYPECODE type,
+                                      const REAL8Vector *delta,
+                                      REAL8 tolerance,
+                                      const CHAR *tsfile,
+                                      const CHAR *tsname,
+                                      UINT4 chunksize,
+                                      UINT4 blocksize,
+                                      const CHAR *checkpoint){
+  XLAL_CHECK_REAL8( delta != NULL, XLAL_EFUNC, "Vector of 'delta' values is NULL!" );
+  XLAL_CHECK_REAL8( tolerance >= 0., XLAL_EFUNC, "Tolerance is less than zero!" );
+  XLAL_CHECK_REAL8( chunksize > 0 && blocksize > 0, XLAL_EFUNC, "Chunk and block sizes must be greater than zero!" );
+
+  LALInferenceH5RowReader *reader = LALInferenceH5RowReaderOpen(tsfile, tsname);
+  XLAL_CHECK_REAL8( reader != NULL, XLAL_EFUNC );
+
+  size_t rows = LALInferenceH5RowReaderQueryNRows(reader), cols = LALInferenceH5RowReaderQueryNColumns(reader);
+  int iscomplex = ( type == LAL_Z_TYPE_CODE );
+  size_t rowlen = iscomplex ? 2*cols : cols;
+
+  if ( LALInferenceH5RowReaderQueryType(reader) != type || rows == 0 || ( delta->length != 1 && delta->length != cols ) ){
+    LALInferenceH5RowReaderClose(reader);
+    XLAL_ERROR_REAL8( XLAL_EFUNC, "Training set '%s' in '%s' has the wrong type or size!", tsname, tsfile );
+  }
+  if ( chunksize > rows ){ chunksize = rows; }
+
+  UINT4Vector *gpts = XLALCreateUINT4Vector(rows); /* selected greedy points (row selection) */
+  REAL8 *rownorms = XLALCalloc(rows, sizeof(REAL8));
+  REAL8 *projection_norms2 = XLALCalloc(rows, sizeof(REAL8));
+  UCHAR *used = XLALCalloc(rows, sizeof(UCHAR));
+  REAL8 *buffer = XLALMalloc((size_t)chunksize*rowlen*sizeof(REAL8));
+  REAL8 *ortho = XLALMalloc(rowlen*sizeof(REAL8));
+  UINT4 *cand = XLALMalloc(blocksize*sizeof(UINT4));
+  REAL8 *canderr = XLALMalloc(blocksize*sizeof(REAL8));
+  REAL8 *rb = NULL;
+  REAL8 worst_err = 0., tstart = 0., tcheckpoint = 0.;
+  UINT4 dim_RB = 0, newstart = 0, nadded = 1;
+  int getnorms = 1, status = XLAL_SUCCESS;
+
+  gsl_vector_view deltaview;
+  XLAL_CALLGSL( deltaview = gsl_vector_view_array(delta->data, delta->length) );
+
+  if ( gpts == NULL || rownorms == NULL || projection_norms2 == NULL || used == NULL || buffer == NULL || ortho == NULL || cand == NULL || canderr == NULL ){
+    status = XLAL_ENOMEM;
+    goto done;
+  }
+
+  if ( checkpoint != NULL && access(checkpoint, F_OK) == 0 ){
+    /* restart from the checkpoint, whose projections already include all its basis vectors */
+    if ( read_basis_checkpoint(checkpoint, reader, &rb, &dim_RB, gpts->data, rownorms, projection_norms2) != XLAL_SUCCESS ){
+      status = XLAL_EFUNC;
+      goto done;
+    }
+    for ( UINT4 k = 0; k < dim_RB; k++ ){ used[gpts->data[k]] = 1; }
+    newstart = dim_RB;
+    getnorms = 0;
+    XLALPrintInfo("%s: restarting from %u basis vectors in checkpoint '%s'\n", __func__, dim_RB, checkpoint);
+  }
+  else{
+    /* initialize algorithm with first training set value */
+    rb = XLALMalloc(rowlen*sizeof(REAL8));
+    if ( rb == NULL || LALInferenceH5RowReaderRead(reader, rb, 0, 1) != XLAL_SUCCESS ){
+      status = XLAL_EFUNC;
+      goto done;
+    }
+    if ( iscomplex ){
+      gsl_vector_complex_view rbview = gsl_vector_complex_view_array(rb, cols);
+      complex_normalise(&deltaview.vector, &rbview.vector);
+    }
+    else{
+      gsl_vector_view rbview = gsl_vector_view_array(rb, cols);
+      normalise(&deltaview.vector, &rbview.vector);
+    }
+    gpts->data[0] = 0;
+    used[0] = 1;
+    dim_RB = 1;
+  }
+
+  tstart = tcheckpoint = XLALGetTimeOfDay();
+
+  /* loop to find reduced basis */
+  while ( 1 ){
+    REAL8 tpass = XLALGetTimeOfDay();
+
+    /* project the training set onto the basis vectors added since the last pass */
+    if ( newstart < dim_RB ){
+      if ( project_training_set_chunks(reader, buffer, chunksize, delta, rb, newstart, dim_RB, rownorms, projection_norms2, getnorms) != XLAL_SUCCESS ){
+        status = XLAL_EFUNC;
+        goto done;
+      }
+      getnorms = 0;
+    }
+
+    size_t ncand = worst_represented_rows(cand, canderr, &worst_err, blocksize, rownorms, projection_norms2, used, rows);
+
+    REAL8 tnow = XLALGetTimeOfDay();
+    XLALPrintInfo("%s: %u basis vectors, maximum projection error %.3e (pass took %.1f s, %.1f s in total)\n", __func__, dim_RB, worst_err, tnow - tpass, tnow - tstart);
+
+    /* decide if another greedy sweep is needed */
+    int finished = ( dim_RB == rows || ncand == 0 || nadded == 0 || ( tolerance > 0. && worst_err < tolerance ) );
+
+    if ( checkpoint != NULL && ( finished || tnow - tcheckpoint > ROQ_CHECKPOINT_INTERVAL ) ){
+      if ( write_basis_checkpoint(checkpoint, reader, rb, dim_RB, gpts->data, rownorms, projection_norms2) != XLAL_SUCCESS ){
+        status = XLAL_EFUNC;
+        goto done;
+      }
+      tcheckpoint = tnow;
+    }
+
+    if ( finished ){ break; }
+
+    /* add the worst approximated solutions to the basis set, in order, each being orthogonalised
+     * against the basis vectors (including those added earlier in the block) with IMGS */
+    newstart = dim_RB;
+    for ( size_t j = 0; j < ncand && dim_RB < rows; j++ ){
+      /* this exists for cases when the reduced basis is being used during enrichment (as in
+       * LALInferenceGenerateREAL8OrthonormalBasis, a zero tolerance adds all new training elements) */
+      if ( tolerance > 0. && canderr[j] < tolerance ){ break; }
+
+      if ( LALInferenceH5RowReaderRead(reader, ortho, cand[j], 1) != XLAL_SUCCESS ){
+        status = XLAL_EFUNC;
+        goto done;
+      }
+
+      /* IMGS expects a normalised waveform (as in the in-memory functions, where the whole training set is normalised) */
+      if ( rownorms[cand[j]] > 0. ){
+        for ( size_t k = 0; k < rowlen; k++ ){ ortho[k] /= rownorms[cand[j]]; }
+      }
+
+      REAL8 nrm;
+      if ( iscomplex ){
+        gsl_matrix_complex_view RBview = gsl_matrix_complex_view_array(rb, dim_RB, cols);
+        gsl_vector_complex_view orthoview = gsl_vector_complex_view_array(ortho, cols);
+        gsl_vector_complex *ru = gsl_vector_complex_alloc(dim_RB+1);
+        iterated_modified_gm_complex(ru, &orthoview.vector, &RBview.matrix, &deltaview.vector, dim_RB); /* use IMGS */
+        nrm = GSL_REAL(gsl_vector_complex_get(ru, dim_RB));
+        gsl_vector_complex_free(ru);
+      }
+      else{
+        gsl_matrix_view RBview = gsl_matrix_view_array(rb, dim_RB, cols);
+        gsl_vector_view orthoview = gsl_vector_view_array(ortho, cols);
+        gsl_vector *ru = gsl_vector_alloc(dim_RB+1);
+        iterated_modified_gm(ru, &orthoview.vector, &RBview.matrix, &deltaview.vector, dim_RB); /* use IMGS */
+        nrm = gsl_vector_get(ru, dim_RB);
+        gsl_vector_free(ru);
+      }
+
+      /* do not add the new basis if its normalisation is NaN (caused by it having zero residual with
+       * the current basis), or if it is already represented by the bases added earlier in this block */
+      if ( gsl_isnan(nrm) || ( tolerance > 0. && dim_RB > newstart && nrm*nrm < tolerance ) ){ continue; }
+
+      rb = XLALRealloc(rb, (size_t)(dim_RB+1)*rowlen*sizeof(REAL8));
+      if ( rb == NULL ){
+        status = XLAL_ENOMEM;
+        goto done;
+      }
+      memcpy(rb + (size_t)dim_RB*rowlen, ortho, rowlen*sizeof(REAL8));
+      gpts->data[dim_RB] = cand[j];
+      used[cand[j]] = 1;
+      dim_RB++;
+    }
+    nadded = dim_RB - newstart;
+  }
+
+  XLALPrintInfo("%s: generated %u basis vectors from %zu training set waveforms in %.1f s\n", __func__, dim_RB, rows, XLALGetTimeOfDay() - tstart);
+
+ done:
+  LALInferenceH5RowReaderClose(reader);
+  XLALFree(rownorms);
+  XLALFree(projection_norms2);
+  XLALFree(used);
+  XLALFree(buffer);
+  XLALFree(ortho);
+  XLALFree(cand);
+  XLALFree(canderr);
+
+  if ( status != XLAL_SUCCESS ){
+    XLALFree(rb);
+    XLALDestroyUINT4Vector(gpts);
+    XLAL_ERROR_REAL8( status );
+  }
+
+  *rbout = rb;
+  *greedypoints = XLALResizeUINT4Vector(gpts, dim_RB);
+  *colsout = cols;
+
+  return worst_err;
+}
+
+
+/**
+ * \brief Create a orthonormal basis set from a training set of real waveforms stored in a HDF5 file
+ *
+ * This produces the same kind of reduced basis as \c LALInferenceGenerateREAL8OrthonormalBasis
+ * (using the greedy Algorithm 1 of \cite FGHKT2014), but without holding the training set in
+ * memory, so it can be used with training sets of ~\f$10^6\f$ waveforms. The training set must be
+ * a two-dimensional \c REAL8 dataset (e.g. written with \c XLALH5FileWriteREAL8Array), with a
+ * waveform in each row; it does not need to be normalised.
+ *
+ * Each greedy sweep reads the training set \c chunksize rows at a time, and the projections of the
+ * rows of each chunk onto the new basis vectors are shared between threads. To reduce the number
+ * of passes over the file, up to \c blocksize of the worst represented waveforms are added to the
+ * basis after each pass. These are orthogonalised in order of decreasing projection error, and a
+ * waveform is skipped if its residual with the bases added before it in the block is within the
+ * tolerance. With a \c blocksize of one this is the standard greedy algorithm; larger values may
+ * give a slightly larger basis that still meets the tolerance.
+ *
+ * If \c checkpoint is not \c NULL, the state of the algorithm is written to that HDF5 file at the
+ * end of a pass at most every \c ROQ_CHECKPOINT_INTERVAL seconds, and when it finishes. If the file
+ * exists when the function is called, the generation will restart from it. Progress and timing
+ * information is printed with \c XLALPrintInfo.
+ *
+ * Unlike \c LALInferenceGenerateREAL8OrthonormalBasis, no basis vector is added once the maximum
+ * projection error is below \c tolerance, and the returned error is that of the final basis. As
+ * in that function, a \c tolerance of zero will add every training set waveform to the basis.
+ *
+ * @param[out] RB A \c REAL8Array to return the reduced basis.
+ * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
+ * This can be a vector containing just one value.
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
+ * @param[in] tsfile The HDF5 file containing the training set.
+ * @param[in] tsname The name of the training set dataset within \c tsfile.
+ * @param[in] chunksize The number of training set waveforms to read from the file at once.
+ * @param[in] blocksize The maximum number of basis vectors to add after each pass over the training set.
+ * @param[in] checkpoint The name of a HDF5 file for checkpointing, or \c NULL for no checkpointing.
+ * @param[out] greedypoints A \c UINT4Vector to return the indices of the training set rows that
+ * have been used to form the reduced basis.
+ *
+ * @return A \c REAL8 with the maximum projection error for the final reduced basis.
+ *
+ * \sa LALInferenceGenerateREAL8OrthonormalBasis
+ */
+REAL8 LALInferenceGenerateREAL8OrthonormalBasisFromFile(REAL8Array **RB,
+                                                        const REAL8Vector *delta,
+                                                        REAL8 tolerance,
+                                                        const CHAR *tsfile,
+                                                        const CHAR *tsname,
+                                                        UINT4 chunksize,
+                                                        UINT4 blocksize,
+                                                        const CHAR *checkpoint,
+                                                        UINT4Vector **greedypoints){
+  REAL8 *rb = NULL;
+  UINT4Vector *gpts = NULL;
+  size_t cols = 0;
+
+  REAL8 worst_err = generate_basis_from_file(&rb, &gpts, &cols, LAL_D_TYPE_CODE, delta, tolerance, tsfile, tsname, chunksize, blocksize, checkpoint);
+  XLAL_CHECK_REAL8( rb != NULL, XLAL_EFUNC );
+
+  UINT4Vector *dims = XLALCreateUINT4Vector( 2 );
+  dims->data[0] = gpts->length;
+  dims->data[1] = cols;
+  *RB = XLALCreateREAL8Array( dims );
+  XLALDestroyUINT4Vector( dims );
+  XLAL_CHECK_REAL8( *RB != NULL, XLAL_EFUNC );
+
+  memcpy((*RB)->data, rb, gpts->length*cols*sizeof(REAL8));
+  XLALFree(rb);
+  *greedypoints = gpts;
+
+  return worst_err;
+}
+
+
+/**
+ * \brief Create a orthonormal basis set from a training set of complex waveforms stored in a HDF5 file
+ *
+ * This is the complex equivalent of \c LALInferenceGenerateREAL8OrthonormalBasisFromFile, which
+ * describes the algorithm. The training set must be a two-dimensional \c COMPLEX16 dataset (e.g.
+ * written with \c XLALH5FileWriteCOMPLEX16Array), with a waveform in each row.
+ *
+ * @param[out] RB A \c COMPLEX16Array to return the reduced basis.
+ * @param[in] delta The time/frequency step(s) in the training set used to normalise the models.
+ * This can be a vector containing just one value.
+ * @param[in] tolerance The tolerance used as a stopping criteria for the basis generation.
+ * @param[in] tsfile The HDF5 file containing the training set.
+ * @param[in] tsname The name of the training set dataset within \c tsfile.
+ * @param[in] chunksize The number of training set waveforms to read from the file at once.
+ * @param[in] blocksize The maximum number of basis vectors to add after each pass over the training set.
+ * @param[in] checkpoint The name of a HDF5 file for checkpointing, or \c NULL for no checkpointing.
+ * @param[out] greedypoints A \c UINT4Vector to return the indices of the training set rows that
+ * have been used to form the reduced basis.
+ *
+ * @return A \c REAL8 with the maximum projection error for the final reduced basis.
+ *
+ * \sa LALInferenceGenerateCOMPLEX16OrthonormalBasis
+ */
+REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasisFromFile(COMPLEX16Array **RB,
+                                                            const REAL8Vector *delta,
+                                                            REAL8 tolerance,
+                                                            const CHAR *tsfile,
+                                                            const CHAR *tsname,
+                                                            UINT4 chunksize,
+                                                            UINT4 blocksize,
+                                                            const CHAR *checkpoint,
+                                                            UINT4Vector **greedypoints){
+  REAL8 *rb = NULL;
+  UINT4Vector *gpts = NULL;
+  size_t cols = 0;
+
+  REAL8 worst_err = generate_basis_from_file(&rb, &gpts, &cols, LAL_Z_TYPE_CODE, delta, tolerance, tsfile, tsname, chunksize, blocksize, checkpoint);
+  XLAL_CHECK_REAL8( rb != NULL, XLAL_EFUNC );
+
+  UINT4Vector *dims = XLALCreateUINT4Vector( 2 );
+  dims->data[0] = gpts->length;
+  dims->data[1] = cols;
+  *RB = XLALCreateCOMPLEX16Array( dims );
+  XLALDestroyUINT4Vector( dims );
+  XLAL_CHECK_REAL8( *RB != NULL, XLAL_EFUNC );
+
+  memcpy((*RB)->data, rb, gpts->length*cols*sizeof(COMPLEX16));
+  XLALFree(rb);
+  *greedypoints = gpts;
 
   return worst_err;
 }
@@ -1165,9 +1832,10 @@ void LALInferenceValidateREAL8OrthonormalBasis(REAL8Vector **projerr,
   REAL8Array *tm = NULL;
   tm = *testmodels;
 
-  size_t dlength = RB->dimLength->data[1], nts = tm->dimLength->data[0];
+  size_t dlength = RB->dimLength->data[1], nts = tm->dimLength->data[0], nRB = RB->dimLength->data[0];
   size_t k = 0;
-  gsl_vector *r_tmp, *testrow;
+
+  XLAL_CHECK_VOID( delta->length == 1 || delta->length == dlength, XLAL_EFUNC, "Vector of weights must either contain a single value, or be the same length as the other input vectors." );
 
   /* normalise the test set */
   gsl_vector_view deltaview;
@@ -1176,46 +1844,28 @@ void LALInferenceValidateREAL8OrthonormalBasis(REAL8Vector **projerr,
   XLAL_CALLGSL( testmodelsview = gsl_matrix_view_array(tm->data, nts, dlength) );
   normalise_training_set(&deltaview.vector, &testmodelsview.matrix);
 
-  gsl_matrix_view RBview;
-  RBview = gsl_matrix_view_array(RB->data, RB->dimLength->data[0], dlength);
-
-  XLAL_CALLGSL( testrow = gsl_vector_alloc(dlength) );
-  XLAL_CALLGSL( r_tmp = gsl_vector_alloc(RB->dimLength->data[0]) );
-
   REAL8Vector *pe = NULL;
   pe = XLALCreateREAL8Vector( nts );
   *projerr = pe;
 
+  /* get projection errors for each test model (each is independent, so share them between threads) */
+  #pragma omp parallel for schedule(static)
   for ( k = 0; k < nts; k++ ){
-    pe->data[k] = 0.;
-    REAL8 r_tmp_nrm = 0.;
-
-    XLAL_CALLGSL( gsl_matrix_get_row(testrow, &testmodelsview.matrix, k) );
+    const REAL8 *testrow = tm->data + k*dlength;
+    REAL8 r_tmp_nrm2 = 0.;
 
-    REAL8 nrm = normalisation(&deltaview.vector, testrow); // normalisation (should be 1 as test models are normalised)
-
-    // un-scale testrow
-    if ( delta->length == 1 ){
-      XLAL_CALLGSL( gsl_vector_scale(testrow, delta->data[0]) );
-    }
-    else if ( testrow->size == deltaview.vector.size ){
-      XLAL_CALLGSL( gsl_vector_mul(testrow, &deltaview.vector) );
-    }
-    else{
-      XLAL_ERROR_VOID(XLAL_EFUNC, "Vector of weights must either contain a single value, or be the same length as the other input vectors.");
-    }
+    REAL8 nrm = sqrt(fabs(weighted_dot_rows(delta, testrow, testrow, dlength))); // normalisation (should be 1 as test models are normalised)
 
     // get projections
-    XLAL_CALLGSL( gsl_blas_dgemv( CblasNoTrans, 1., &RBview.matrix, testrow, 0., r_tmp ) );
+    for ( size_t j = 0; j < nRB; j++ ){
+      REAL8 r_tmp = weighted_dot_rows(delta, RB->data + j*dlength, testrow, dlength);
+      r_tmp_nrm2 += r_tmp*r_tmp;
+    }
 
-    r_tmp_nrm = gsl_blas_dnrm2( r_tmp );
-    pe->data[k] = nrm - r_tmp_nrm*r_tmp_nrm;
+    pe->data[k] = nrm - r_tmp_nrm2;
 
     if ( pe->data[k] < 0. ) { pe->data[k] = 1.0e-16; } // floating point error can trigger this
   }
-
-  XLAL_CALLGSL( gsl_vector_free( testrow ) );
-  XLAL_CALLGSL( gsl_vector_free( r_tmp ) );
 }
 
 
@@ -1422,9 +2072,10 @@ void LALInferenceValidateCOMPLEX16OrthonormalBasis(REAL8Vector **projerr,
   COMPLEX16Array *tm = NULL;
   tm = *testmodels;
 
-  size_t dlength = RB->dimLength->data[1], nts = tm->dimLength->data[0];
-  size_t k = 0, j = 0;
-  gsl_vector_complex *r_tmp, *testrow;
+  size_t dlength = RB->dimLength->data[1], nts = tm->dimLength->data[0], nRB = RB->dimLength->data[0];
+  size_t k = 0;
+
+  XLAL_CHECK_VOID( delta->length == 1 || delta->length == dlength, XLAL_EFUNC, "Vector of weights must either contain a single value, or be the same length as the other input vectors." );
 
   /* normalise the test set */
   gsl_vector_view deltaview;
@@ -1433,57 +2084,28 @@ void LALInferenceValidateCOMPLEX16OrthonormalBasis(REAL8Vector **projerr,
   XLAL_CALLGSL( testmodelsview = gsl_matrix_complex_view_array((double *)tm->data, nts, dlength) );
   complex_normalise_training_set(&deltaview.vector, &testmodelsview.matrix);
 
-  gsl_matrix_complex_view RBview;
-  RBview = gsl_matrix_complex_view_array((double *)RB->data, RB->dimLength->data[0], dlength);
-
-  XLAL_CALLGSL( testrow = gsl_vector_complex_alloc(dlength) );
-  XLAL_CALLGSL( r_tmp = gsl_vector_complex_alloc(RB->dimLength->data[0]) );
-
   REAL8Vector *pe = NULL;
   pe = XLALCreateREAL8Vector( nts );
   *projerr = pe;
 
-  /* get projection errors for each test model */
+  /* get projection errors for each test model (each is independent, so share them between threads) */
+  #pragma omp parallel for schedule(static)
   for ( k = 0; k < nts; k++ ){
-    pe->data[k] = 0.;
-    REAL8 r_tmp_nrm = 0.;
-
-    XLAL_CALLGSL( gsl_matrix_complex_get_row(testrow, &testmodelsview.matrix, k) );
-
-    REAL8 nrm = complex_normalisation(&deltaview.vector, testrow); // normalisation (should be 1 as test models are normalised)
+    const COMPLEX16 *testrow = tm->data + k*dlength;
+    REAL8 r_tmp_nrm2 = 0.;
 
-    // un-scale testrow (gsl_vector_complex_mul doesn't work when delta is a real vector)
-    if ( delta->length == 1 || testrow->size == deltaview.vector.size ){
-      for ( j = 0; j < dlength; j++ ){
-        gsl_complex ctmp;
-        XLAL_CALLGSL( ctmp = gsl_vector_complex_get( testrow, j ) );
-        if ( delta->length == 1 ){
-          XLAL_CALLGSL( ctmp = gsl_complex_mul_real( ctmp, delta->data[0] ) );
-        }
-        else{
-          XLAL_CALLGSL( ctmp = gsl_complex_mul_real( ctmp, delta->data[j] ) );
-        }
-        XLAL_CALLGSL( gsl_vector_complex_set( testrow, j, ctmp ) );
-      }
-    }
-    else{
-      XLAL_ERROR_VOID( XLAL_EFUNC, "Vector of weights must either contain a single value, or be the same length as the other input vectors." );
-    }
-    
-    // get complex conjugate
-    for ( j = 0; j < testrow->size; j++ ){ testrow->data[2*j+1] = -testrow->data[2*j+1]; }
+    REAL8 nrm = sqrt(cabs(complex_weighted_dot_rows(delta, testrow, testrow, dlength))); // normalisation (should be 1 as test models are normalised)
 
     // get projections
-    XLAL_CALLGSL( gsl_blas_zgemv( CblasNoTrans, GSL_COMPLEX_ONE, &RBview.matrix, testrow, GSL_COMPLEX_ZERO, r_tmp ) );
+    for ( size_t j = 0; j < nRB; j++ ){
+      COMPLEX16 r_tmp = complex_weighted_dot_rows(delta, RB->data + j*dlength, testrow, dlength);
+      r_tmp_nrm2 += creal(r_tmp)*creal(r_tmp) + cimag(r_tmp)*cimag(r_tmp);
+    }
 
-    r_tmp_nrm = gsl_blas_dznrm2(r_tmp);
-    pe->data[k] = nrm - r_tmp_nrm*r_tmp_nrm;
+    pe->data[k] = nrm - r_tmp_nrm2;
 
     if ( pe->data[k] < 0. ) { pe->data[k] = 1.0e-16; } // floating point error can trigger this
   }
-
-  XLAL_CALLGSL( gsl_vector_complex_free( testrow ) );
-  XLAL_CALLGSL( gsl_vector_complex_free( r_tmp ) );
 }
 
 
@@ -65,6 +65,27 @@ REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasis(COMPLEX16Array **RB,
                                                     COMPLEX16Array **TS,
                                                     UINT4Vector **greedypoints);
 
+/* functions to create a real or complex orthonormal basis set from a training set read from a HDF5 file in chunks */
+REAL8 LALInferenceGenerateREAL8OrthonormalBasisFromFile(REAL8Array **RB,
+                                                        const REAL8Vector *delta,
+                                                        REAL8 tolerance,
+                                                        const CHAR *tsfile,
+                                                        const CHAR *tsname,
+                                                        UINT4 chunksize,
+                                                        UINT4 blocksize,
+                                                        const CHAR *checkpoint,
+                                                        UINT4Vector **greedypoints);
+
+REAL8 LALInferenceGenerateCOMPLEX16OrthonormalBasisFromFile(COMPLEX16Array **RB,
+                                                            const REAL8Vector *delta,
+                                                            REAL8 tolerance,
+                                                            const CHAR *tsfile,
+                                                            const CHAR *tsname,
+                                                            UINT4 chunksize,
+                                                            UINT4 blocksize,
+                                                            const CHAR *checkpoint,
+                                                            UINT4Vector **greedypoints);
+
 /* functions to test the basis */
 void LALInferenceValidateREAL8OrthonormalBasis(REAL8Vector **projerr,
                                                const REAL8Vector *delta,
@@ -327,3 +327,151 @@ static void LALInferenceH5VariableToAttribute(
     XLALH5AttributeAddScalar(
         gdataset, name, LALInferenceGetVariable(vars,name), laltype);
 }
+
+
+struct tagLALInferenceH5RowReader
+{
+    hid_t file_id;
+    hid_t dataset_id;
+    hid_t dataspace_id;
+    hid_t memtype_id;
+    LALTYPECODE type;
+    hsize_t dims[2];
+};
+
+
+LALInferenceH5RowReader *LALInferenceH5RowReaderOpen(
+    const char *path, const char *name)
+{
+    if (!path || !name)
+        XLAL_ERROR_NULL(XLAL_EFAULT, "Received null path or dataset name");
+
+    LALInferenceH5RowReader *reader = XLALCalloc(1, sizeof(*reader));
+    if (!reader)
+        XLAL_ERROR_NULL(XLAL_ENOMEM);
+    reader->file_id = reader->dataset_id = -1;
+    reader->dataspace_id = reader->memtype_id = -1;
+
+    reader->file_id = H5Fopen(path, H5F_ACC_RDONLY, H5P_DEFAULT);
+    if (reader->file_id < 0)
+    {
+        LALInferenceH5RowReaderClose(reader);
+        XLAL_ERROR_NULL(XLAL_EIO, "Could not open HDF5 file `%s'", path);
+    }
+
+    reader->dataset_id = H5Dopen2(reader->file_id, name, H5P_DEFAULT);
+    if (reader->dataset_id < 0)
+    {
+        LALInferenceH5RowReaderClose(reader);
+        XLAL_ERROR_NULL(XLAL_EIO, "Could not open dataset `%s' in `%s'",
+            name, path);
+    }
+
+    reader->dataspace_id = H5Dget_space(reader->dataset_id);
+    if (reader->dataspace_id < 0
+        || H5Sget_simple_extent_ndims(reader->dataspace_id) != 2)
+    {
+        LALInferenceH5RowReaderClose(reader);
+        XLAL_ERROR_NULL(XLAL_EDIMS, "Dataset `%s' is not two-dimensional",
+            name);
+    }
+    H5Sget_simple_extent_dims(reader->dataspace_id, reader->dims, NULL);
+
+    /* REAL8 arrays are stored as doubles, and COMPLEX16 arrays as a
+     * compound type with double members "r" and "i" */
+    hid_t dtype_id = H5Dget_type(reader->dataset_id);
+    switch (H5Tget_class(dtype_id))
+    {
+        case H5T_FLOAT:
+            reader->type = LAL_D_TYPE_CODE;
+            reader->memtype_id = H5Tcopy(H5T_NATIVE_DOUBLE);
+            break;
+        case H5T_COMPOUND:
+            if (H5Tget_nmembers(dtype_id) == 2)
+            {
+                reader->type = LAL_Z_TYPE_CODE;
+                reader->memtype_id = H5Tcreate(
+                    H5T_COMPOUND, sizeof(COMPLEX16));
+                H5Tinsert(reader->memtype_id, "r", 0, H5T_NATIVE_DOUBLE);
+                H5Tinsert(reader->memtype_id, "i", sizeof(REAL8),
+                    H5T_NATIVE_DOUBLE);
+                break;
+            }
+            /* fall through */
+        default:
+            H5Tclose(dtype_id);
+            LALInferenceH5RowReaderClose(reader);
+            XLAL_ERROR_NULL(XLAL_ETYPE,
+                "Dataset `%s' is neither REAL8 nor COMPLEX16", name);
+    }
+    H5Tclose(dtype_id);
+
+    return reader;
+}
+
+
+void LALInferenceH5RowReaderClose(LALInferenceH5RowReader *reader)
+{
+    if (!reader)
+        return;
+    if (reader->memtype_id >= 0)
+        H5Tclose(reader->memtype_id);
+    if (reader->dataspace_id >= 0)
+        H5Sclose(reader->dataspace_id);
+    if (reader->dataset_id >= 0)
+        H5Dclose(reader->dataset_id);
+    if (reader->file_id >= 0)
+        H5Fclose(reader->file_id);
+    XLALFree(reader);
+}
+
+
+size_t LALInferenceH5RowReaderQueryNRows(
+    const LALInferenceH5RowReader *reader)
+{
+    return reader->dims[0];
+}
+
+
+size_t LALInferenceH5RowReaderQueryNColumns(
+    const LALInferenceH5RowReader *reader)
+{
+    return reader->dims[1];
+}
+
+
+LALTYPECODE LALInferenceH5RowReaderQueryType(
+    const LALInferenceH5RowReader *reader)
+{
+    return reader->type;
+}
+
+
+int LALInferenceH5RowReaderRead(
+    LALInferenceH5RowReader *reader, void *data, size_t row0, size_t nrows)
+{
+    if (!reader || !data)
+        XLAL_ERROR(XLAL_EFAULT, "Received null reader or data pointer");
+    if (row0 + nrows > reader->dims[0])
+        XLAL_ERROR(XLAL_EINVAL, "Rows %zu to %zu are outside the dataset",
+            row0, row0 + nrows);
+    if (nrows == 0)
+        return XLAL_SUCCESS;
+
+    hsize_t start[2] = {row0, 0};
+    hsize_t count[2] = {nrows, reader->dims[1]};
+    if (H5Sselect_hyperslab(reader->dataspace_id, H5S_SELECT_SET, start,
+        NULL, count, NULL) < 0)
+        XLAL_ERROR(XLAL_EIO, "Could not select rows %zu to %zu",
+            row0, row0 + nrows);
+
+    hid_t memspace_id = H5Screate_simple(2, count, NULL);
+    herr_t status = H5Dread(reader->dataset_id, reader->memtype_id,
+        memspace_id, reader->dataspace_id, H5P_DEFAULT, data);
+    H5Sclose(memspace_id);
+    if (status < 0)
+        XLAL_ERROR(XLAL_EIO, "Could not read rows %zu to %zu",
+            row0, row0 + nrows);
+
+    return XLAL_SUCCESS;
+}
@@ -38,6 +38,44 @@ int LALInferenceH5DatasetToVariablesArray(
 LALH5File *LALInferenceH5CreateGroupStructure(
     LALH5File *h5file, const char *codename, const char *runID);
 
+/**
+ * Handle for reading a two-dimensional \c REAL8 or \c COMPLEX16 dataset,
+ * such as a training set written with XLALH5FileWriteREAL8Array() or
+ * XLALH5FileWriteCOMPLEX16Array(), a block of rows at a time without
+ * holding the whole dataset in memory.
+ */
+typedef struct tagLALInferenceH5RowReader LALInferenceH5RowReader;
+
+/**
+ * Open the two-dimensional dataset \c name in the HDF5 file \c path for
+ * reading by rows. Returns NULL on failure.
+ */
+LALInferenceH5RowReader *LALInferenceH5RowReaderOpen(
+    const char *path, const char *name);
+
+/** Close a dataset opened with LALInferenceH5RowReaderOpen(). */
+void LALInferenceH5RowReaderClose(LALInferenceH5RowReader *reader);
+
+/** Number of rows in the dataset. */
+size_t LALInferenceH5RowReaderQueryNRows(
+    const LALInferenceH5RowReader *reader);
+
+/** Number of columns in the dataset. */
+size_t LALInferenceH5RowReaderQueryNColumns(
+    const LALInferenceH5RowReader *reader);
+
+/** Type of the dataset, either \c LAL_D_TYPE_CODE or \c LAL_Z_TYPE_CODE. */
+LALTYPECODE LALInferenceH5RowReaderQueryType(
+    const LALInferenceH5RowReader *reader);
+
+/**
+ * Read rows \c row0 to \c row0 + \c nrows - 1 of the dataset into
+ * \c data, which must have space for \c nrows times the number of
+ * columns values of the dataset type.
+ */
+int LALInferenceH5RowReaderRead(
+    LALInferenceH5RowReader *reader, void *data, size_t row0, size_t nrows);
+
 extern const char LALInferenceHDF5PosteriorSamplesDatasetName[];
 extern const char LALInferenceHDF5NestedSamplesDatasetName[];
 
@@ -459,6 +459,9 @@ LALInferenceModel * LALInferenceInitBurstModel(LALInferenceRunState *state)
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   /* Choose proper template */
   model->templt = LALInferenceInitBurstTemplate(state);
@@ -501,6 +504,9 @@ LALInferenceModel *LALInferenceInitModelReviewBurstEvidence_unimod(LALInferenceR
   }
 
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
@@ -555,6 +561,9 @@ LALInferenceModel *LALInferenceInitModelReviewBurstEvidence_bimod(LALInferenceRu
     nifo++;
   }
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   i=0;
   
@@ -245,6 +245,17 @@ void LALInferenceInitCBCThreads(LALInferenceRunState *run_state, INT4 nthreads)
       thread->model->roq_flag=0;
     }
 
+    /* Setup relative binning, with the fiducial waveform at the starting parameters */
+    if (LALInferenceGetProcParamVal(commandLine, "--relative-binning")){
+        ProcessParamsTable *ppt = LALInferenceGetProcParamVal(commandLine, "--relative-binning-epsilon");
+        REAL8 epsilon = ppt ? atof(ppt->value) : 0.1;
+        if (LALInferenceSetupRelativeBinning(thread->model, run_state->data, thread->model->params, epsilon) != XLAL_SUCCESS) {
+            fprintf(stderr, "ERROR: unable to set up the relative binning likelihood\n");
+            exit(1);
+        }
+        fprintf(stderr, "done LALInferenceSetupRelativeBinning (%u frequency bins)\n", thread->model->relbin->frequencyNodes->length - 1);
+    }
+
     LALInferenceCopyVariables(thread->model->params, thread->currentParams);
     LALInferenceCopyVariables(run_state->proposalArgs, thread->proposalArgs);
 
@@ -303,6 +314,10 @@ LALInferenceTemplateFunction LALInferenceInitCBCTemplate(LALInferenceRunState *r
   templt=&LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence;
         fprintf(stderr, "template is \"LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence\"\n");
   }
+  else if(LALInferenceGetProcParamVal(commandLine,"--relative-binning")){
+    templt=&LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence;
+    fprintf(stderr, "template is \"LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence\"\n");
+  }
   else {
     fprintf(stdout,"Template function called is \"LALInferenceTemplateXLALSimInspiralChooseWaveform\"\n");
   }
@@ -755,6 +770,10 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
     (--no-detector-frame)              model will NOT use detector-centred coordinates and instead RA,dec\n\
     (--grtest-parameters dchi0,..,dxi1,..,dalpha1,..) template will assume deformations in the corresponding phase coefficients.\n\
     (--ppe-parameters aPPE1,....     template will assume the presence of an arbitrary number of PPE parameters. They must be paired correctly.\n\
+    (--relative-binning)            Use the relative binning (heterodyned) likelihood, which computes the template at a few hundred\n\
+                                    frequency nodes only. The fiducial waveform is computed at the starting parameters, which\n\
+                                    should be set near the peak of the likelihood with --parname VALUE (see below).\n\
+    (--relative-binning-epsilon eps) Largest change of the phase bound across a relative binning frequency bin (default 0.1 rad).\n\
 \n\
     ----------------------------------------------\n\
     --- Starting Parameters ----------------------\n\
@@ -900,6 +919,8 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
   memset(model->params, 0, sizeof(LALInferenceVariables));
   model->eos_fam = NULL;
+  model->relbin = NULL;
+  model->relbin_flag = 0;
 
   UINT4 signal_flag=1;
   ppt = LALInferenceGetProcParamVal(commandLine, "--noiseonly");
@@ -1469,6 +1490,9 @@ LALInferenceModel *LALInferenceInitCBCModel(LALInferenceRunState *state) {
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   /* Choose proper template */
   model->templt = LALInferenceInitCBCTemplate(state);
@@ -1517,6 +1541,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence(LALInferenceRunState *sta
     /* Create arrays for holding single-IFO likelihoods, etc. */
     model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
     model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+    model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
 	i=0;
 
@@ -1563,6 +1590,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence_bimod(LALInferenceRunStat
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
 
@@ -1608,6 +1638,9 @@ LALInferenceModel *LALInferenceInitModelReviewEvidence_banana(LALInferenceRunSta
   /* Create arrays for holding single-IFO likelihoods, etc. */
   model->ifo_loglikelihoods = XLALCalloc(nifo, sizeof(REAL8));
   model->ifo_SNRs = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(nifo, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(nifo, sizeof(REAL8));
 
   i=0;
 
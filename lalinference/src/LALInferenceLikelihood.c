@@ -42,6 +42,24 @@
 
 #include "logaddexp.h"
 
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
+/* Request vectorization of the inner product loops, if OpenMP 4.0 is available. */
+#if defined(_OPENMP) && _OPENMP >= 201307
+#define INNER_PRODUCT_PRAGMA_OMP_SIMD _Pragma("omp simd")
+#define INNER_PRODUCT_PRAGMA_OMP_SIMD_REDUCTION _Pragma("omp simd reduction(+:dhre,dhim,hh,dd)")
+#else
+#define INNER_PRODUCT_PRAGMA_OMP_SIMD
+#define INNER_PRODUCT_PRAGMA_OMP_SIMD_REDUCTION
+#endif
+
 typedef enum
 {
   GAUSSIAN,
@@ -65,6 +83,40 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
 static double integrate_interpolated_log(double h, REAL8 *log_ys, size_t n, double *imean, size_t *imax);
 
+/* Interned keys of the parameters read on every likelihood evaluation */
+static struct {
+  LALInferenceVariableKey spcal_active, constantcal_active, psdScaleFlag,
+    glitchFitFlag, signalModelFlag, logmc, loghrss, hrss, SKY_FRAME,
+    rightascension, declination, polarisation, time;
+} likelihood_keys;
+
+static void likelihood_keys_init(void)
+{
+#define INIT_KEY(k) likelihood_keys.k = LALInferenceGetVariableKey(#k)
+  INIT_KEY(spcal_active);
+  INIT_KEY(constantcal_active);
+  INIT_KEY(psdScaleFlag);
+  INIT_KEY(glitchFitFlag);
+  INIT_KEY(signalModelFlag);
+  INIT_KEY(logmc);
+  INIT_KEY(loghrss);
+  INIT_KEY(hrss);
+  INIT_KEY(SKY_FRAME);
+  INIT_KEY(rightascension);
+  INIT_KEY(declination);
+  INIT_KEY(polarisation);
+  INIT_KEY(time);
+#undef INIT_KEY
+}
+
+#ifdef LAL_PTHREAD_LOCK
+static pthread_once_t likelihood_keys_once = PTHREAD_ONCE_INIT;
+#define LIKELIHOOD_KEYS_INIT pthread_once(&likelihood_keys_once, likelihood_keys_init)
+#else
+static int likelihood_keys_done = 0;
+#define LIKELIHOOD_KEYS_INIT do { if (!likelihood_keys_done) { likelihood_keys_init(); likelihood_keys_done = 1; } } while (0)
+#endif
+
 static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases);
 static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, REAL8Vector **logfreqs, REAL8Vector **amps, REAL8Vector **phases)
 {
@@ -92,6 +144,93 @@ static int get_calib_spline(LALInferenceVariables *vars, const char *ifoname, RE
   return(XLAL_SUCCESS);
 }
 
+/* Inner products <d|h> and <h|h> of the relative binning likelihood.  The
+ * ratio r(f) = h(f)/h0(f) of the template to the fiducial waveform is linear
+ * across each frequency bin, so the sums over the frequencies of the bin are
+ * given by the summary data of the fiducial waveform and the values of r(f)
+ * at the frequency nodes. */
+static void relbin_inner_products(const LALInferenceIFOData *dataPtr, const LALInferenceRelBinModel *relbin, REAL8 Fplus, REAL8 Fcross, REAL8 timeshift, UINT4 spcal_active, COMPLEX16 *d_inner_h, REAL8 *h_inner_h);
+static void relbin_inner_products(const LALInferenceIFOData *dataPtr, const LALInferenceRelBinModel *relbin, REAL8 Fplus, REAL8 Fcross, REAL8 timeshift, UINT4 spcal_active, COMPLEX16 *d_inner_h, REAL8 *h_inner_h)
+{
+  const LALInferenceRelBinData *rbdata = dataPtr->relbin;
+  const REAL8 *f = relbin->frequencyNodes->data;
+  const COMPLEX16 *hptilde = relbin->hptilde->data->data;
+  const COMPLEX16 *hctilde = relbin->hctilde->data->data;
+  const REAL8 twopit = LAL_TWOPI * timeshift;
+  COMPLEX16 dh = 0.0, rprev = 0.0;
+  REAL8 hh = 0.0;
+
+  for (UINT4 k = 0; k <= rbdata->nbins; k++) {
+    COMPLEX16 r = 0.0;
+    if (rbdata->h0[k] != 0.0) {
+      COMPLEX16 h = (Fplus*hptilde[k] + Fcross*hctilde[k]) * cexp(-I*twopit*f[k]);
+      if (spcal_active)
+        h *= relbin->calFactor->data[k];
+      r = h / rbdata->h0[k];
+    }
+    if (k > 0) {
+      /* r(f) = r0 + r1 (f - fc) across the bin, with fc the centre of the bin */
+      const UINT4 b = k - 1;
+      const COMPLEX16 r0 = 0.5*(rprev + r);
+      const COMPLEX16 r1 = (r - rprev) / (f[k] - f[b]);
+      dh += rbdata->A0[b]*conj(r0) + rbdata->A1[b]*conj(r1);
+      hh += rbdata->B0[b]*(creal(r0)*creal(r0) + cimag(r0)*cimag(r0)) + 2.0*rbdata->B1[b]*creal(r0*conj(r1));
+    }
+    rprev = r;
+  }
+
+  *d_inner_h = dh;
+  *h_inner_h = hh;
+}
+
+/* Upper bound on the phase difference between two waveforms, up to a
+ * constant, from the post-Newtonian power laws of the phase */
+static REAL8 relbin_phase_bound(REAL8 f, REAL8 fmin, REAL8 fmax);
+static REAL8 relbin_phase_bound(REAL8 f, REAL8 fmin, REAL8 fmax)
+{
+  static const REAL8 gammas[] = {-5.0/3.0, -2.0/3.0, 1.0, 5.0/3.0, 7.0/3.0};
+  REAL8 psi = 0.0;
+  for (UINT4 k = 0; k < XLAL_NUM_ELEM(gammas); k++) {
+    if (gammas[k] < 0)
+      psi -= pow(f / fmin, gammas[k]);
+    else
+      psi += pow(f / fmax, gammas[k]);
+  }
+  return LAL_TWOPI * psi;
+}
+
+/* Frequency nodes of the relative binning likelihood, as indices on the
+ * frequency grid between imin and imax: the phase bound changes by at most
+ * epsilon across each bin (Zackay, Dai & Venumadhav, arXiv:1806.08792). */
+static UINT4Vector *relbin_frequency_nodes(UINT4 imin, UINT4 imax, REAL8 deltaF, REAL8 epsilon);
+static UINT4Vector *relbin_frequency_nodes(UINT4 imin, UINT4 imax, REAL8 deltaF, REAL8 epsilon)
+{
+  const REAL8 fmin = imin*deltaF, fmax = imax*deltaF;
+  const REAL8 psimin = relbin_phase_bound(fmin, fmin, fmax);
+  const REAL8 psimax = relbin_phase_bound(fmax, fmin, fmax);
+
+  UINT4 nbins = (UINT4)ceil((psimax - psimin) / epsilon);
+  if (nbins > imax - imin) nbins = imax - imin;
+  if (nbins < 1) nbins = 1;
+  const REAL8 dpsi = (psimax - psimin) / nbins;
+
+  UINT4Vector *nodes = XLALCreateUINT4Vector(nbins + 1);
+  XLAL_CHECK_NULL(nodes != NULL, XLAL_EFUNC);
+
+  UINT4 n = 0, k = 1;
+  nodes->data[n++] = imin;
+  for (UINT4 i = imin + 1; i < imax && k < nbins; i++) {
+    const REAL8 psi = relbin_phase_bound(i*deltaF, fmin, fmax);
+    if (psi >= psimin + k*dpsi) {
+      nodes->data[n++] = i;
+      while (k < nbins && psi >= psimin + k*dpsi) k++;
+    }
+  }
+  nodes->data[n++] = imax;
+
+  return XLALResizeUINT4Vector(nodes, n);
+}
+
 void LALInferenceInitLikelihood(LALInferenceRunState *runState)
 {
     char help[]="\
@@ -107,6 +246,7 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
     (--margphi)                      Using marginalised phase likelihood\n\
     (--margtime)                     Using marginalised time likelihood\n\
     (--margtimephi)                  Using marginalised in time and phase likelihood\n\
+    (--relative-binning)             Using relative binning in the likelihood (with --margphi or alone)\n\
     \n";
 
     /* Print command line arguments if help requested */
@@ -167,6 +307,10 @@ void LALInferenceInitLikelihood(LALInferenceRunState *runState)
      else if (LALInferenceGetProcParamVal(commandLine, "--roqtime_steps")) {
      fprintf(stderr, "Using ROQ in likelihood.\n");
      runState->likelihood=&LALInferenceUndecomposedFreqDomainLogLikelihood;
+    }
+     else if (LALInferenceGetProcParamVal(commandLine, "--relative-binning")) {
+     fprintf(stderr, "Using relative binning in likelihood.\n");
+     runState->likelihood=&LALInferenceUndecomposedFreqDomainLogLikelihood;
     }
      else if (LALInferenceGetProcParamVal(commandLine, "--fastSineGaussianLikelihood")){
       fprintf(stderr, "WARNING: Using Fast SineGaussian likelihood and WF for LIB.\n");
@@ -235,8 +379,7 @@ LALInferenceVariables LALInferenceGetInstrinsicParams(LALInferenceVariables *cur
     LALInferenceVariables intrinsicParams;
     const char **non_intrinsic_param = non_intrinsic_params;
 
-    intrinsicParams.head      = NULL;
-    intrinsicParams.dimension = 0;
+    memset(&intrinsicParams, 0, sizeof(intrinsicParams));
     LALInferenceCopyVariables(currentParams, &intrinsicParams);
 
     while (*non_intrinsic_param) {
@@ -312,6 +455,246 @@ REAL8 LALInferenceUndecomposedFreqDomainLogLikelihood(LALInferenceVariables *cur
 }
 
 
+/* Number of frequency bins of the template processed for every detector in turn */
+#define INNER_PRODUCT_BLOCK 256
+
+int LALInferenceNetworkInnerProducts(LALInferenceIFOData *data,
+                                     const COMPLEX16FrequencySeries *hplus,
+                                     const COMPLEX16FrequencySeries *hcross,
+                                     const COMPLEX16 *Fplus,
+                                     const COMPLEX16 *Fcross,
+                                     const REAL8 *timeshift,
+                                     COMPLEX16FrequencySeries **calFactor,
+                                     COMPLEX16 *d_inner_h,
+                                     REAL8 *h_inner_h,
+                                     REAL8 *d_inner_d,
+                                     COMPLEX16Vector *dh_tilde,
+                                     int threaded)
+{
+  LALInferenceIFOData *dataPtr;
+  UINT4 ifo, nifo = 0;
+
+  XLAL_CHECK(data != NULL && hplus != NULL && hcross != NULL, XLAL_EFAULT);
+  XLAL_CHECK(Fplus != NULL && Fcross != NULL && timeshift != NULL, XLAL_EFAULT);
+  for (dataPtr = data; dataPtr; dataPtr = dataPtr->next) nifo++;
+
+  const UINT4 length = data->freqData->data->length;
+  const UINT4 N = data->timeData->data->length;
+  const REAL8 deltaT = data->timeData->deltaT;
+  const REAL8 deltaF = 1.0 / (((double)N) * deltaT);
+  XLAL_CHECK(hplus->data->length >= length && hcross->data->length >= length, XLAL_EBADLEN);
+  XLAL_CHECK(dh_tilde == NULL || dh_tilde->length >= length, XLAL_EBADLEN);
+
+  /* Per-detector inputs, as plain arrays; the frequency range is [lower, upper) */
+  const REAL8 *psd[nifo], *dtilde[nifo], *cal[nifo];
+  UINT4 lower[nifo], upper[nifo];
+  REAL8 theta[nifo], blockre[nifo], blockim[nifo];
+  REAL8 stepre[nifo][INNER_PRODUCT_BLOCK], stepim[nifo][INNER_PRODUCT_BLOCK];
+  UINT4 lo = length, hi = 0;
+  for (dataPtr = data, ifo = 0; dataPtr; dataPtr = dataPtr->next, ifo++) {
+    XLAL_CHECK(dataPtr->freqData->data->length == length && dataPtr->timeData->data->length == N
+               && dataPtr->timeData->deltaT == deltaT, XLAL_EINVAL,
+               "All detectors must have the same frequency resolution");
+    XLAL_CHECK(calFactor == NULL || calFactor[ifo] == NULL || calFactor[ifo]->data->length >= length, XLAL_EBADLEN);
+    psd[ifo] = dataPtr->oneSidedNoisePowerSpectrum->data->data;
+    dtilde[ifo] = (const REAL8 *) dataPtr->freqData->data->data;
+    cal[ifo] = (calFactor && calFactor[ifo]) ? (const REAL8 *) calFactor[ifo]->data->data : NULL;
+    lower[ifo] = (UINT4)ceil(dataPtr->fLow / deltaF);
+    upper[ifo] = (UINT4)floor(dataPtr->fHigh / deltaF) + 1;
+    if (upper[ifo] > length) upper[ifo] = length;
+    if (lower[ifo] > upper[ifo]) lower[ifo] = upper[ifo];
+    if (lower[ifo] < lo) lo = lower[ifo];
+    if (upper[ifo] > hi) hi = upper[ifo];
+
+    /* The time shift multiplies bin i by exp(-J*theta*i).  Within a block
+       starting at bin b0 this is exp(-J*theta*b0) * exp(-J*theta*k),
+       where the second factor is tabulated here with the O(sqrt(N))
+       recurrence used by the scalar loops, and the first is carried from
+       one block to the next by multiplying by exp(-J*theta*BLOCK). */
+    theta[ifo] = LAL_TWOPI * timeshift[ifo] * deltaF;
+    const REAL8 dim = -sin(theta[ifo]);
+    const REAL8 dre = -2.0*sin(0.5*theta[ifo])*sin(0.5*theta[ifo]);
+    REAL8 re = 1.0, im = 0.0;
+    for (UINT4 k = 0; k < INNER_PRODUCT_BLOCK; k++) {
+      stepre[ifo][k] = re;
+      stepim[ifo][k] = im;
+      const REAL8 newRe = re + re*dre - im*dim;
+      const REAL8 newIm = im + re*dim + im*dre;
+      re = newRe;
+      im = newIm;
+    }
+    blockre[ifo] = cos(theta[ifo] * INNER_PRODUCT_BLOCK);
+    blockim[ifo] = -sin(theta[ifo] * INNER_PRODUCT_BLOCK);
+  }
+
+  /* Accumulated Re<d|h>, Im<d|h>, <h|h>, <d|d> of each detector */
+  REAL8 sums[4*nifo];
+  memset(sums, 0, sizeof(sums));
+
+  const UINT4 firstblock = lo / INNER_PRODUCT_BLOCK;
+  const UINT4 lastblock = hi > lo ? (hi - 1) / INNER_PRODUCT_BLOCK + 1 : firstblock;
+  const REAL8 norm = 4.0 * deltaF;
+  const REAL8 *hp = (const REAL8 *) hplus->data->data;
+  const REAL8 *hc = (const REAL8 *) hcross->data->data;
+  REAL8 *buf = dh_tilde ? (REAL8 *) dh_tilde->data : NULL;
+
+  /* Each thread handles all detectors for a contiguous range of blocks, so
+     that each block of the template is read once and threads never write
+     to the same bins of dh_tilde */
+#pragma omp parallel if(threaded)
+  {
+    REAL8 part[4*nifo];
+    REAL8 seedre[nifo], seedim[nifo];
+    REAL8 hpr[INNER_PRODUCT_BLOCK], hpi[INNER_PRODUCT_BLOCK];
+    REAL8 hcr[INNER_PRODUCT_BLOCK], hci[INNER_PRODUCT_BLOCK];
+    REAL8 pre[INNER_PRODUCT_BLOCK], pim[INNER_PRODUCT_BLOCK];
+    UINT4 nextblock = firstblock;
+    int seeded = 0;
+    memset(part, 0, sizeof(part));
+
+#pragma omp for schedule(static)
+    for (UINT4 b = firstblock; b < lastblock; b++) {
+      const UINT4 b0 = b * INNER_PRODUCT_BLOCK;
+      const UINT4 j1 = (hi - b0 < INNER_PRODUCT_BLOCK) ? hi - b0 : INNER_PRODUCT_BLOCK;
+      const UINT4 jlo = (lo > b0) ? lo - b0 : 0;
+
+      /* Split the template into real and imaginary parts */
+      INNER_PRODUCT_PRAGMA_OMP_SIMD
+      for (UINT4 j = jlo; j < j1; j++) {
+        hpr[j] = hp[2*(b0+j)];
+        hpi[j] = hp[2*(b0+j)+1];
+        hcr[j] = hc[2*(b0+j)];
+        hci[j] = hc[2*(b0+j)+1];
+      }
+
+      for (ifo = 0; ifo < nifo; ifo++) {
+        /* Time shift at the start of the block */
+        if (seeded && b == nextblock) {
+          const REAL8 re = seedre[ifo]*blockre[ifo] - seedim[ifo]*blockim[ifo];
+          const REAL8 im = seedre[ifo]*blockim[ifo] + seedim[ifo]*blockre[ifo];
+          seedre[ifo] = re;
+          seedim[ifo] = im;
+        } else {
+          seedre[ifo] = cos(theta[ifo] * b0);
+          seedim[ifo] = -sin(theta[ifo] * b0);
+        }
+
+        if (lower[ifo] >= b0 + j1 || upper[ifo] <= b0) continue;
+        const UINT4 k0 = (lower[ifo] > b0) ? lower[ifo] - b0 : 0;
+        const UINT4 k1 = (upper[ifo] < b0 + j1) ? upper[ifo] - b0 : j1;
+
+        const REAL8 sre = seedre[ifo], sim = seedim[ifo];
+        const REAL8 *tre = stepre[ifo], *tim = stepim[ifo];
+        INNER_PRODUCT_PRAGMA_OMP_SIMD
+        for (UINT4 k = k0; k < k1; k++) {
+          pre[k] = sre*tre[k] - sim*tim[k];
+          pim[k] = sre*tim[k] + sim*tre[k];
+        }
+        if (cal[ifo]) {
+          const REAL8 *c = cal[ifo] + 2*b0;
+          INNER_PRODUCT_PRAGMA_OMP_SIMD
+          for (UINT4 k = k0; k < k1; k++) {
+            const REAL8 re = pre[k]*c[2*k] - pim[k]*c[2*k+1];
+            const REAL8 im = pre[k]*c[2*k+1] + pim[k]*c[2*k];
+            pre[k] = re;
+            pim[k] = im;
+          }
+        }
+
+        const REAL8 fpr = creal(Fplus[ifo]), fpi = cimag(Fplus[ifo]);
+        const REAL8 fcr = creal(Fcross[ifo]), fci = cimag(Fcross[ifo]);
+        const REAL8 *S = psd[ifo] + b0;
+        const REAL8 *d = dtilde[ifo] + 2*b0;
+        REAL8 dhre = 0.0, dhim = 0.0, hh = 0.0, dd = 0.0;
+        /* Loop indices are signed here, which GCC needs to vectorise the reductions */
+        const INT4 n0 = k0, n1 = k1;
+        if (buf) {
+          REAL8 *x = buf + 2*b0;
+          INNER_PRODUCT_PRAGMA_OMP_SIMD_REDUCTION
+          for (INT4 k = n0; k < n1; k++) {
+            const REAL8 ar = fpr*hpr[k] - fpi*hpi[k] + fcr*hcr[k] - fci*hci[k];
+            const REAL8 ai = fpr*hpi[k] + fpi*hpr[k] + fcr*hci[k] + fci*hcr[k];
+            const REAL8 tr = ar*pre[k] - ai*pim[k];
+            const REAL8 ti = ar*pim[k] + ai*pre[k];
+            const REAL8 w = norm / S[k];
+            const REAL8 dr = d[2*k], di = d[2*k+1];
+            const REAL8 xr = w*(dr*tr + di*ti);
+            const REAL8 xi = w*(di*tr - dr*ti);
+            x[2*k] += xr;
+            x[2*k+1] += xi;
+            dhre += xr;
+            dhim += xi;
+            hh += w*(tr*tr + ti*ti);
+            dd += w*(dr*dr + di*di);
+          }
+        } else {
+          INNER_PRODUCT_PRAGMA_OMP_SIMD_REDUCTION
+          for (INT4 k = n0; k < n1; k++) {
+            const REAL8 ar = fpr*hpr[k] - fpi*hpi[k] + fcr*hcr[k] - fci*hci[k];
+            const REAL8 ai = fpr*hpi[k] + fpi*hpr[k] + fcr*hci[k] + fci*hcr[k];
+            const REAL8 tr = ar*pre[k] - ai*pim[k];
+            const REAL8 ti = ar*pim[k] + ai*pre[k];
+            const REAL8 w = norm / S[k];
+            const REAL8 dr = d[2*k], di = d[2*k+1];
+            dhre += w*(dr*tr + di*ti);
+            dhim += w*(di*tr - dr*ti);
+            hh += w*(tr*tr + ti*ti);
+            dd += w*(dr*dr + di*di);
+          }
+        }
+        part[4*ifo] += dhre;
+        part[4*ifo+1] += dhim;
+        part[4*ifo+2] += hh;
+        part[4*ifo+3] += dd;
+      }
+      seeded = 1;
+      nextblock = b + 1;
+    }
+
+#pragma omp critical
+    {
+      for (UINT4 k = 0; k < 4*nifo; k++) sums[k] += part[k];
+    }
+  }
+
+  for (ifo = 0; ifo < nifo; ifo++) {
+    if (d_inner_h) d_inner_h[ifo] = crect(sums[4*ifo], sums[4*ifo+1]);
+    if (h_inner_h) h_inner_h[ifo] = sums[4*ifo+2];
+    if (d_inner_d) d_inner_d[ifo] = sums[4*ifo+3];
+  }
+
+  return XLAL_SUCCESS;
+}
+
+/* Record the optimal and complex SNRs of one detector, given half of <h|h>
+   and of <d|h> */
+static void add_ifo_snr_variables(LALInferenceVariables *currentParams, const char *ifoname,
+                                  REAL8 this_ifo_S, COMPLEX16 this_ifo_Rcplx)
+{
+  char varname[VARNAME_MAX];
+  if((VARNAME_MAX <= snprintf(varname,VARNAME_MAX,"%s_optimal_snr",ifoname)))
+  {
+      fprintf(stderr,"variable name too long\n"); exit(1);
+  }
+  LALInferenceAddREAL8Variable(currentParams,varname,sqrt(2.0*this_ifo_S),LALINFERENCE_PARAM_OUTPUT);
+
+  if((VARNAME_MAX <= snprintf(varname,VARNAME_MAX,"%s_cplx_snr_amp",ifoname)))
+  {
+      fprintf(stderr,"variable name too long\n"); exit(1);
+  }
+  REAL8 cplx_snr_amp=0.0;
+  REAL8 cplx_snr_phase=carg(this_ifo_Rcplx);
+  if(this_ifo_S > 0) cplx_snr_amp=2.0*cabs(this_ifo_Rcplx)/sqrt(2.0*this_ifo_S);
+
+  LALInferenceAddREAL8Variable(currentParams,varname,cplx_snr_amp,LALINFERENCE_PARAM_OUTPUT);
+
+  if((VARNAME_MAX <= snprintf(varname,VARNAME_MAX,"%s_cplx_snr_arg",ifoname)))
+  {
+      fprintf(stderr,"variable name too long\n"); exit(1);
+  }
+  LALInferenceAddREAL8Variable(currentParams,varname,cplx_snr_phase,LALINFERENCE_PARAM_OUTPUT);
+}
+
 static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *currentParams,
                                                         LALInferenceIFOData *data,
                                                         LALInferenceModel *model,
@@ -365,10 +748,14 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   REAL8 d_inner_h=0.0;
 
 
-  if (LALInferenceCheckVariable(currentParams, "spcal_active") && (*(UINT4 *)LALInferenceGetVariable(currentParams, "spcal_active"))) {
+  LALInferenceVariableItem *item;
+
+  LIKELIHOOD_KEYS_INIT;
+
+  if ((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.spcal_active)) && (*(UINT4 *)item->value)) {
     spcal_active = 1;
   }
-  if (LALInferenceCheckVariable(currentParams, "constantcal_active") && (*(UINT4 *)LALInferenceGetVariable(currentParams, "constantcal_active"))) {
+  if ((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.constantcal_active)) && (*(UINT4 *)item->value)) {
    constantcal_active = 1;
   }
   if (spcal_active && constantcal_active){
@@ -379,6 +766,10 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     fprintf(stderr,"ERROR: cannot use ROQ likelihood and constant calibration error marginalization together. Exiting...\n");
     exit(1);
   }
+  if (model->relbin_flag && constantcal_active){
+    fprintf(stderr,"ERROR: cannot use relative binning likelihood and constant calibration error marginalization together. Exiting...\n");
+    exit(1);
+  }
 
   REAL8 degreesOfFreedom=2.0;
   REAL8 chisq=0.0;
@@ -395,6 +786,8 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
     margtime=1;
 
   if(model->roq_flag && margtime) XLAL_ERROR_REAL8(XLAL_EINVAL,"ROQ does not support time marginalisation");
+  if(model->relbin_flag && (margtime || marginalisationflags==STUDENTT))
+    XLAL_ERROR_REAL8(XLAL_EINVAL,"Relative binning only supports the Gaussian and phase marginalised likelihoods");
 
   
   LALStatus status;
@@ -423,8 +816,8 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
   //check if psd parameters are included in the model
   psdFlag = 0;
-  if(LALInferenceCheckVariable(currentParams, "psdScaleFlag"))
-    psdFlag = *((INT4 *)LALInferenceGetVariable(currentParams, "psdScaleFlag"));
+  if((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.psdScaleFlag)))
+    psdFlag = *((INT4 *)item->value);
   if(psdFlag)
   {
     //if so, store current noise parameters in easily accessible matrix
@@ -443,15 +836,27 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
   //check if glitch model is being used
   glitchFlag = 0;
-  if(LALInferenceCheckVariable(currentParams,"glitchFitFlag"))
-    glitchFlag = *((INT4 *)LALInferenceGetVariable(currentParams, "glitchFitFlag"));
+  if((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.glitchFitFlag)))
+    glitchFlag = *((INT4 *)item->value);
   if(glitchFlag)
     glitchFD = *((gsl_matrix **)LALInferenceGetVariable(currentParams, "morlet_FD"));
 
+  if(model->relbin_flag && (psdFlag || glitchFlag))
+    XLAL_ERROR_REAL8(XLAL_EINVAL,"Relative binning does not support PSD or glitch fitting");
+
   //check if signal model is being used
   signalFlag=1;
-  if(LALInferenceCheckVariable(currentParams, "signalModelFlag"))
-    signalFlag = *((INT4 *)LALInferenceGetVariable(currentParams, "signalModelFlag"));
+  if((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.signalModelFlag)))
+    signalFlag = *((INT4 *)item->value);
+
+  /* In the common case the inner products of all detectors are computed
+     together by LALInferenceNetworkInnerProducts(), after the loop over
+     detectors has set up their antenna patterns and time shifts */
+  const int networkFlag = signalFlag && !psdFlag && !glitchFlag && marginalisationflags!=STUDENTT
+    && !model->roq_flag && !model->relbin_flag;
+  COMPLEX16 netFplus[Nifos], netFcross[Nifos];
+  REAL8 netTimeshift[Nifos];
+  COMPLEX16FrequencySeries *netCalFactor[Nifos];
 
   int freq_length=0,time_length=0;
   COMPLEX16Vector * dh_S_tilde=NULL;
@@ -471,24 +876,24 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
   if(signalFlag)
   {
-    if(LALInferenceCheckVariable(currentParams,"logmc")){
-      mc=exp(*(REAL8 *)LALInferenceGetVariable(currentParams,"logmc"));
+    if((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.logmc))){
+      mc=exp(*(REAL8 *)item->value);
       LALInferenceAddVariable(currentParams,"chirpmass",&mc,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
     }
-    if(LALInferenceCheckVariable(currentParams, "loghrss")){
-      amp_prefactor = exp(*(REAL8*)LALInferenceGetVariable(currentParams,"loghrss"));
+    if((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.loghrss))){
+      amp_prefactor = exp(*(REAL8*)item->value);
     }
-    else if (LALInferenceCheckVariable(currentParams, "hrss")){
-      amp_prefactor = (*(REAL8*)LALInferenceGetVariable(currentParams,"hrss"));
+    else if ((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.hrss))){
+      amp_prefactor = (*(REAL8*)item->value);
     }
 
     INT4 SKY_FRAME=0;
-    if(LALInferenceCheckVariable(currentParams,"SKY_FRAME"))
-      SKY_FRAME=*(INT4 *)LALInferenceGetVariable(currentParams,"SKY_FRAME");
+    if((item = LALInferenceGetItemByKey(currentParams, likelihood_keys.SKY_FRAME)))
+      SKY_FRAME=*(INT4 *)item->value;
     if(SKY_FRAME==0){
       /* determine source's sky location & orientation parameters: */
-      ra        = *(REAL8*) LALInferenceGetVariable(currentParams, "rightascension"); /* radian      */
-      dec       = *(REAL8*) LALInferenceGetVariable(currentParams, "declination");    /* radian      */
+      ra        = LALInferenceGetREAL8VariableByKey(currentParams, likelihood_keys.rightascension); /* radian      */
+      dec       = LALInferenceGetREAL8VariableByKey(currentParams, likelihood_keys.declination);    /* radian      */
     }
     else
     {
@@ -512,9 +917,9 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       LALInferenceAddVariable(currentParams,"declination",&dec,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
       if(!margtime) LALInferenceAddVariable(currentParams,"time",&GPSdouble,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
     }
-    psi       = *(REAL8*) LALInferenceGetVariable(currentParams, "polarisation");   /* radian      */
+    psi       = LALInferenceGetREAL8VariableByKey(currentParams, likelihood_keys.polarisation);   /* radian      */
     if(!margtime)
-	      GPSdouble = *(REAL8*) LALInferenceGetVariable(currentParams, "time");           /* GPS seconds */
+	      GPSdouble = LALInferenceGetREAL8VariableByKey(currentParams, likelihood_keys.time);           /* GPS seconds */
     else
 	      GPSdouble = XLALGPSGetREAL8(&(data->freqData->epoch));
 
@@ -674,6 +1079,14 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 						&(model->roq->calFactorQuadratic));
 	  }
 
+	  else if (model->relbin_flag) {
+             LALInferenceSplineCalibrationFactorROQ(logfreqs, amps, phases,
+						model->relbin->frequencyNodes,
+						&(model->relbin->calFactor),
+						model->relbin->frequencyNodes,
+						&(model->relbin->calFactor));
+	  }
+
 	  else{
 	    if (calFactor == NULL) {
 	      calFactor = XLALCreateCOMPLEX16FrequencySeries("calibration factors",
@@ -726,9 +1139,11 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
         Fplus*=amp_prefactor;
         Fcross*=amp_prefactor;
 
-        dataPtr->fPlus = Fplus;
-        dataPtr->fCross = Fcross;
-        dataPtr->timeshift = timeshift;
+        /* the data are shared between threads, so the responses are
+           stored in the model */
+        if (model->ifo_fPlus) model->ifo_fPlus[ifo] = Fplus;
+        if (model->ifo_fCross) model->ifo_fCross[ifo] = Fcross;
+        if (model->ifo_timeshifts) model->ifo_timeshifts[ifo] = timeshift;
     }//end signalFlag condition
 
     /* determine frequency range & loop over frequency bins: */
@@ -775,15 +1190,19 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       }
     }
 
-    if (model->roq_flag) {
+    if (model->roq_flag || model->relbin_flag) {
 
 	double complex weight_iii;
 
-	if (spcal_active){
+	if (model->relbin_flag) {
+	    relbin_inner_products(dataPtr, model->relbin, Fplus, Fcross, timeshift, spcal_active, &this_ifo_d_inner_h, &this_ifo_s);
+	}
+
+	else if (spcal_active){
 
 	    for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
 
-			complex double template_EI = model->roq->calFactorLinear->data[iii] * (dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii] );
+			complex double template_EI = model->roq->calFactorLinear->data[iii] * (Fplus*model->roq->hptildeLinear->data->data[iii] + Fcross*model->roq->hctildeLinear->data->data[iii] );
 
 			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
 
@@ -792,7 +1211,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
 		for(unsigned int jjj=0; jjj < model->roq->frequencyNodesQuadratic->length; jjj++){
 
-			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*dataPtr->fPlus + model->roq->hctildeQuadratic->data->data[jjj]*dataPtr->fCross) ) );
+			this_ifo_s += dataPtr->roq->weightsQuadratic[jjj] * creal( conj( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) * ( model->roq->calFactorQuadratic->data[jjj] * (model->roq->hptildeQuadratic->data->data[jjj]*Fplus + model->roq->hctildeQuadratic->data->data[jjj]*Fcross) ) );
 		}
 	}
 
@@ -800,7 +1219,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
 		for(unsigned int iii=0; iii < model->roq->frequencyNodesLinear->length; iii++){
 
-			complex double template_EI = dataPtr->fPlus*model->roq->hptildeLinear->data->data[iii] + dataPtr->fCross*model->roq->hctildeLinear->data->data[iii];
+			complex double template_EI = Fplus*model->roq->hptildeLinear->data->data[iii] + Fcross*model->roq->hctildeLinear->data->data[iii];
 
 			weight_iii = gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_real_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_real_weight_linear) + I*gsl_spline_eval (dataPtr->roq->weights_linear[iii].spline_imag_weight_linear, timeshift, dataPtr->roq->weights_linear[iii].acc_imag_weight_linear);
 
@@ -868,6 +1287,17 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
 
     }
 
+    else if (networkFlag) {
+      /* A constant calibration error is equivalent to scaling the template */
+      COMPLEX16 calScale = 1.0;
+      if (constantcal_active) calScale = (1.0+calamp)*cexp(I*calpha);
+      netFplus[ifo] = calScale*Fplus;
+      netFcross[ifo] = calScale*Fcross;
+      netTimeshift[ifo] = timeshift;
+      netCalFactor[ifo] = calFactor;
+      calFactor = NULL;
+    }
+
     else{
 
     	REAL8 *psd=&(dataPtr->oneSidedNoisePowerSpectrum->data->data[lower]);
@@ -1023,28 +1453,7 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
       break;
     }
     S+=this_ifo_S;
-    char varname[VARNAME_MAX];
-    if((VARNAME_MAX <= snprintf(varname,VARNAME_MAX,"%s_optimal_snr",dataPtr->name)))
-    {
-        fprintf(stderr,"variable name too long\n"); exit(1);
-    }
-    LALInferenceAddREAL8Variable(currentParams,varname,sqrt(2.0*this_ifo_S),LALINFERENCE_PARAM_OUTPUT);
-
-    if((VARNAME_MAX <= snprintf(varname,VARNAME_MAX,"%s_cplx_snr_amp",dataPtr->name)))
-    {
-        fprintf(stderr,"variable name too long\n"); exit(1);
-    }
-    REAL8 cplx_snr_amp=0.0;
-    REAL8 cplx_snr_phase=carg(this_ifo_Rcplx);
-    if(this_ifo_S > 0) cplx_snr_amp=2.0*cabs(this_ifo_Rcplx)/sqrt(2.0*this_ifo_S);
-
-    LALInferenceAddREAL8Variable(currentParams,varname,cplx_snr_amp,LALINFERENCE_PARAM_OUTPUT);
-
-    if((VARNAME_MAX <= snprintf(varname,VARNAME_MAX,"%s_cplx_snr_arg",dataPtr->name)))
-    {
-        fprintf(stderr,"variable name too long\n"); exit(1);
-    }
-    LALInferenceAddREAL8Variable(currentParams,varname,cplx_snr_phase,LALINFERENCE_PARAM_OUTPUT);
+    add_ifo_snr_variables(currentParams,dataPtr->name,this_ifo_S,this_ifo_Rcplx);
 
    /* Clean up calibration if necessary */
     if (!(calFactor == NULL)) {
@@ -1054,6 +1463,54 @@ static REAL8 LALInferenceFusedFreqDomainLogLikelihood(LALInferenceVariables *cur
   } /* end loop over detectors */
 
   }
+
+  if (networkFlag) {
+    COMPLEX16 ifo_d_inner_h[Nifos];
+    REAL8 ifo_h_inner_h[Nifos], ifo_d_inner_d[Nifos];
+    int errnum = LALInferenceNetworkInnerProducts(data, model->freqhPlus, model->freqhCross,
+                                                  netFplus, netFcross, netTimeshift,
+                                                  spcal_active ? netCalFactor : NULL,
+                                                  ifo_d_inner_h, ifo_h_inner_h, ifo_d_inner_d,
+                                                  margtime ? dh_S_tilde : NULL, 0);
+    if (spcal_active)
+      for(ifo=0;ifo<Nifos;ifo++) XLALDestroyCOMPLEX16FrequencySeries(netCalFactor[ifo]);
+    if (errnum != XLAL_SUCCESS) XLAL_ERROR_REAL8(XLAL_EFUNC);
+
+    for(dataPtr=data,ifo=0; dataPtr; dataPtr=dataPtr->next,ifo++) {
+      /* The quantities below are half the inner products, as in the loop above */
+      REAL8 this_ifo_D = 0.5*ifo_d_inner_d[ifo];
+      REAL8 this_ifo_S = 0.5*ifo_h_inner_h[ifo];
+      COMPLEX16 this_ifo_Rcplx = 0.5*ifo_d_inner_h[ifo];
+      D+=this_ifo_D;
+      S+=this_ifo_S;
+      Rcplx+=this_ifo_Rcplx;
+      switch(marginalisationflags)
+      {
+        case GAUSSIAN:
+          model->ifo_loglikelihoods[ifo] = -(this_ifo_D - 2.0*creal(this_ifo_Rcplx) + this_ifo_S);
+          loglikelihood += model->ifo_loglikelihoods[ifo];
+          break;
+        case MARGTIME:
+        case MARGTIMEPHI:
+          loglikelihood -= this_ifo_S + this_ifo_D;
+          model->ifo_loglikelihoods[ifo] = 0.0;
+          break;
+        default:
+          model->ifo_loglikelihoods[ifo] = 0.0;
+          break;
+      }
+      add_ifo_snr_variables(currentParams,dataPtr->name,this_ifo_S,this_ifo_Rcplx);
+    }
+
+    if (margtime) {
+      for (i = 0; i < freq_length; i++) {
+        dh_S_tilde->data[i] *= 0.5;
+        /* This is the other phase quadrature */
+        if (margphi) dh_S_phase_tilde->data[i] = -I*dh_S_tilde->data[i];
+      }
+    }
+  }
+
   if (model->roq_flag){
 
 
@@ -1321,6 +1778,120 @@ REAL8 LALInferenceNullLogLikelihood(LALInferenceIFOData *data)
 	return(loglikelihood);
 }
 
+int LALInferenceSetupRelativeBinning(LALInferenceModel *model, LALInferenceIFOData *data, LALInferenceVariables *fiducial, REAL8 epsilon)
+{
+  LALInferenceIFOData *dataPtr;
+  UINT4 ifo;
+  INT4 errnum=0;
+
+  XLAL_CHECK(model != NULL && data != NULL && fiducial != NULL, XLAL_EFAULT);
+  XLAL_CHECK(epsilon > 0, XLAL_EINVAL, "Relative binning phase tolerance must be positive");
+  XLAL_CHECK(model->domain == LAL_SIM_DOMAIN_FREQUENCY, XLAL_EINVAL, "Relative binning needs a frequency-domain model");
+
+  /* Frequency grid covered by the data */
+  const REAL8 deltaF = 1.0 / (((double)data->timeData->data->length) * data->timeData->deltaT);
+  UINT4 imin = LAL_UINT4_MAX, imax = 0;
+  for (dataPtr = data; dataPtr; dataPtr = dataPtr->next) {
+    const REAL8 ifoDeltaF = 1.0 / (((double)dataPtr->timeData->data->length) * dataPtr->timeData->deltaT);
+    XLAL_CHECK(fabs(ifoDeltaF - deltaF) <= 1e-9 * deltaF, XLAL_EINVAL, "Relative binning needs the same frequency resolution for all detectors");
+    const UINT4 lower = (UINT4)ceil(dataPtr->fLow / deltaF);
+    const UINT4 upper = (UINT4)floor(dataPtr->fHigh / deltaF);
+    if (lower < imin) imin = lower;
+    if (upper > imax) imax = upper;
+  }
+  XLAL_CHECK(imin > 0 && imax > imin && imax < model->freqhPlus->data->length, XLAL_EINVAL, "Invalid frequency range for relative binning");
+
+  UINT4Vector *nodes = relbin_frequency_nodes(imin, imax, deltaF, epsilon);
+  XLAL_CHECK(nodes != NULL, XLAL_EFUNC);
+  const UINT4 nbins = nodes->length - 1;
+
+  model->relbin = XLALCalloc(1, sizeof(LALInferenceRelBinModel));
+  XLAL_CHECK(model->relbin != NULL, XLAL_ENOMEM);
+  model->relbin->frequencyNodes = XLALCreateREAL8Sequence(nodes->length);
+  model->relbin->calFactor = XLALCreateCOMPLEX16Sequence(nodes->length);
+  XLAL_CHECK(model->relbin->frequencyNodes != NULL && model->relbin->calFactor != NULL, XLAL_EFUNC);
+  for (UINT4 k = 0; k < nodes->length; k++)
+    model->relbin->frequencyNodes->data[k] = nodes->data[k] * deltaF;
+
+  model->relbin_flag = 0;
+  model->templt = &LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence;
+
+  if (data->relbin != NULL) {
+    /* Summary data were already computed for another model */
+    XLAL_CHECK(data->relbin->nbins == nbins, XLAL_EINVAL, "Relative binning summary data have %u bins, not %u", data->relbin->nbins, nbins);
+  } else {
+    /* Fiducial waveform on the full frequency grid, with the detector
+     * responses and time shifts at the fiducial parameters; the model's
+     * parameters are restored afterwards */
+    XLAL_CHECK(model->ifo_fPlus != NULL && model->ifo_fCross != NULL && model->ifo_timeshifts != NULL, XLAL_EFAULT, "Relative binning needs the model's single-IFO response arrays");
+    LALInferenceVariables fiducialParams, modelParams;
+    memset(&fiducialParams, 0, sizeof(fiducialParams));
+    memset(&modelParams, 0, sizeof(modelParams));
+    LALInferenceCopyVariables(fiducial, &fiducialParams);
+    LALInferenceCopyVariables(model->params, &modelParams);
+    model->templt = &LALInferenceTemplateXLALSimInspiralChooseWaveform;
+    REAL8 logL = LALInferenceUndecomposedFreqDomainLogLikelihood(&fiducialParams, data, model);
+    model->templt = &LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence;
+    LALInferenceClearVariables(&fiducialParams);
+    XLAL_CHECK(isfinite(logL), XLAL_EFUNC, "Could not compute the likelihood of the fiducial waveform");
+
+    /* Summary data of the data against the fiducial waveform, with the
+     * weights of the full likelihood */
+    for (dataPtr = data, ifo = 0; dataPtr; dataPtr = dataPtr->next, ifo++) {
+      LALInferenceRelBinData *rbdata = XLALCalloc(1, sizeof(LALInferenceRelBinData));
+      XLAL_CHECK(rbdata != NULL, XLAL_ENOMEM);
+      rbdata->nbins = nbins;
+      rbdata->h0 = XLALCalloc(nbins + 1, sizeof(COMPLEX16));
+      rbdata->A0 = XLALCalloc(nbins, sizeof(COMPLEX16));
+      rbdata->A1 = XLALCalloc(nbins, sizeof(COMPLEX16));
+      rbdata->B0 = XLALCalloc(nbins, sizeof(REAL8));
+      rbdata->B1 = XLALCalloc(nbins, sizeof(REAL8));
+      XLAL_CHECK(rbdata->h0 != NULL && rbdata->A0 != NULL && rbdata->A1 != NULL && rbdata->B0 != NULL && rbdata->B1 != NULL, XLAL_ENOMEM);
+
+      const REAL8 deltaT = dataPtr->timeData->deltaT;
+      const REAL8 TwoDeltaToverN = 2.0 * deltaT / ((double) dataPtr->timeData->data->length);
+      const REAL8 twopit = LAL_TWOPI * model->ifo_timeshifts[ifo];
+      const UINT4 lower = (UINT4)ceil(dataPtr->fLow / deltaF);
+      const UINT4 upper = (UINT4)floor(dataPtr->fHigh / deltaF);
+      UINT4 b = 0;
+      for (UINT4 i = lower; i <= upper; i++) {
+        while (b + 1 < nbins && i >= nodes->data[b + 1]) b++;
+        const REAL8 f = i * deltaF;
+        const REAL8 df = f - 0.5 * (model->relbin->frequencyNodes->data[b] + model->relbin->frequencyNodes->data[b + 1]);
+        const COMPLEX16 h0 = (model->ifo_fPlus[ifo]*model->freqhPlus->data->data[i] + model->ifo_fCross[ifo]*model->freqhCross->data->data[i]) * cexp(-I*twopit*f);
+        const REAL8 weight = 2.0 * TwoDeltaToverN / (dataPtr->oneSidedNoisePowerSpectrum->data->data[i] * deltaT * deltaT);
+        const COMPLEX16 dh0 = weight * dataPtr->freqData->data->data[i] * conj(h0);
+        const REAL8 h0sq = weight * (creal(h0)*creal(h0) + cimag(h0)*cimag(h0));
+        rbdata->A0[b] += dh0;
+        rbdata->A1[b] += dh0 * df;
+        rbdata->B0[b] += h0sq;
+        rbdata->B1[b] += h0sq * df;
+      }
+      dataPtr->relbin = rbdata;
+    }
+
+    /* Fiducial waveform at the frequency nodes, computed as the templates
+     * will be so that the ratio to the fiducial waveform is exactly 1 there */
+    XLAL_TRY(model->templt(model), errnum);
+    XLAL_CHECK(errnum == 0, XLAL_EFUNC, "Could not compute the fiducial waveform at the frequency nodes");
+    for (dataPtr = data, ifo = 0; dataPtr; dataPtr = dataPtr->next, ifo++) {
+      const REAL8 twopit = LAL_TWOPI * model->ifo_timeshifts[ifo];
+      for (UINT4 k = 0; k <= nbins; k++) {
+        const REAL8 f = model->relbin->frequencyNodes->data[k];
+        dataPtr->relbin->h0[k] = (model->ifo_fPlus[ifo]*model->relbin->hptilde->data->data[k] + model->ifo_fCross[ifo]*model->relbin->hctilde->data->data[k]) * cexp(-I*twopit*f);
+      }
+    }
+
+    LALInferenceCopyVariables(&modelParams, model->params);
+    LALInferenceClearVariables(&modelParams);
+  }
+
+  model->relbin_flag = 1;
+  XLALDestroyUINT4Vector(nodes);
+
+  return XLAL_SUCCESS;
+}
+
 REAL8 LALInferenceMarginalisedPhaseLogLikelihood(LALInferenceVariables *currentParams,
                                                     LALInferenceIFOData *data,
                                                     LALInferenceModel *model)
@@ -1431,20 +2002,17 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
 /***************************************************************/
 {
   double Fplus, Fcross;
-  int i, lower, upper, ifo;
+  int i, ifo;
   LALInferenceIFOData *dataPtr;
   double ra=0.0, dec=0.0, psi=0.0, gmst=0.0;
   double GPSdouble=0.0;
   LIGOTimeGPS GPSlal;
-  double chisquared;
   double timedelay;  /* time delay b/w iterferometer & geocenter w.r.t. sky location */
   double timeshift=0;  /* time shift (not necessarily same as above)                   */
-  double deltaT, TwoDeltaToverN, deltaF, twopit=0.0, re, im, dre, dim, newRe, newIm;
   double timeTmp;
   /* Burst templates are generated at hrss=1, thus need to rescale amplitude */
   double amp_prefactor=1.0;
 
-  REAL8 chisq=0.0;
   LALStatus status;
   memset(&status,0,sizeof(status));
 
@@ -1454,6 +2022,8 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
   for(dataPtr=data;dataPtr;dataPtr=dataPtr->next) Nifos++;
   void *generatedFreqModels[1+Nifos];
   for(i=0;i<=Nifos;i++) generatedFreqModels[i]=NULL;
+  COMPLEX16 netFplus[Nifos], netFcross[Nifos];
+  REAL8 netTimeshift[Nifos];
 
   if(LALInferenceCheckVariable(currentParams, "loghrss")){
     amp_prefactor = exp(*(REAL8*)LALInferenceGetVariable(currentParams,"loghrss"));
@@ -1490,12 +2060,10 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
     LALInferenceAddVariable(currentParams,"time",&GPSdouble,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
   }
 
-  deltaT = data->timeData->deltaT;
   /* figure out GMST: */
   XLALGPSSetREAL8(&GPSlal, GPSdouble);
   gmst=XLALGreenwichMeanSiderealTime(&GPSlal);
 
-  chisquared = 0.0;
   REAL8 loglikelihood = 0.0;
 
   /* Reset SNR */
@@ -1561,69 +2129,31 @@ REAL8 LALInferenceFastSineGaussianLogLikelihood(LALInferenceVariables *currentPa
       /* (negative timedelay means signal arrives earlier at Ifo than at geocenter, etc.) */
       /* amount by which to time-shift template (not necessarily same as above "timedelay"): */
       timeshift =  (GPSdouble - (*(REAL8*) LALInferenceGetVariable(model->params, "time"))) + timedelay;
-      twopit    = LAL_TWOPI * timeshift;
 
       /* For burst the effect of windowing in amplitude is important. Add it here. */
       Fplus*=amp_prefactor;
       Fcross*=amp_prefactor;
 
-      dataPtr->fPlus = Fplus;
-      dataPtr->fCross = Fcross;
-      dataPtr->timeshift = timeshift;
-
-
-      /* determine frequency range & loop over frequency bins: */
-      deltaF = 1.0 / (((double)dataPtr->timeData->data->length) * deltaT);
-      lower = (UINT4)ceil(dataPtr->fLow / deltaF);
-      upper = (UINT4)floor(dataPtr->fHigh / deltaF);
-      TwoDeltaToverN = 2.0 * deltaT / ((double) dataPtr->timeData->data->length);
+      if (model->ifo_fPlus) model->ifo_fPlus[ifo] = Fplus;
+      if (model->ifo_fCross) model->ifo_fCross[ifo] = Fcross;
+      if (model->ifo_timeshifts) model->ifo_timeshifts[ifo] = timeshift;
 
-    /* Employ a trick here for avoiding cos(...) and sin(...) in time
-       shifting.  We need to multiply each template frequency bin by
-       exp(-J*twopit*deltaF*i) = exp(-J*twopit*deltaF*(i-1)) +
-       exp(-J*twopit*deltaF*(i-1))*(exp(-J*twopit*deltaF) - 1) .  This
-       recurrance relation has the advantage that the error growth is
-       O(sqrt(N)) for N repetitions. */
-
-    /* Incremental values, using cos(theta) - 1 = -2*sin(theta/2)^2*/
-    dim = -sin(twopit*deltaF);
-    dre = -2.0*sin(0.5*twopit*deltaF)*sin(0.5*twopit*deltaF);
-
-    REAL8 *psd=&(dataPtr->oneSidedNoisePowerSpectrum->data->data[lower]);
-    COMPLEX16 *dtilde=&(dataPtr->freqData->data->data[lower]);
-    COMPLEX16 *hptilde=&(model->freqhPlus->data->data[lower]);
-    COMPLEX16 *hctilde=&(model->freqhCross->data->data[lower]);
-    COMPLEX16 diff=0.0;
-    COMPLEX16 template=0.0;
-    INT4 upppone=upper+1;
-    for (i=lower,chisq=0.0,re = cos(twopit*deltaF*i),im = -sin(twopit*deltaF*i);
-         i<upppone;
-         i++, psd++, hptilde++, hctilde++, dtilde++,
-         newRe = re + re*dre - im*dim,
-         newIm = im + re*dim + im*dre,
-         re = newRe, im = newIm)
-    {
-
-      COMPLEX16 d=*dtilde;
-      /* Normalise PSD to our funny standard (see twoDeltaTOverN below). */
-      REAL8 sigmasq=(*psd)*deltaT*deltaT;
-      //subtract GW model from residual
-      /* derive template (involving location/orientation parameters) from given plus/cross waveforms: */
-      COMPLEX16 plainTemplate = Fplus*(*hptilde)+Fcross*(*hctilde);
-
-      /* Do time shifting */
-      template = plainTemplate * (re + I*im);
-      diff = (d - template);
-
-      REAL8 diffsq = creal(diff)*creal(diff)+cimag(diff)*cimag(diff);
-      chisq = TwoDeltaToverN*diffsq/sigmasq;
-      chisquared  += chisq;
-      model->ifo_loglikelihoods[ifo] -= chisq;
-    } /* End loop over freq bins */
+      netFplus[ifo] = Fplus;
+      netFcross[ifo] = Fcross;
+      netTimeshift[ifo] = timeshift;
+  } /* end loop over detectors */
 
+  COMPLEX16 d_inner_h[Nifos];
+  REAL8 h_inner_h[Nifos], d_inner_d[Nifos];
+  if (LALInferenceNetworkInnerProducts(data, model->freqhPlus, model->freqhCross,
+                                       netFplus, netFcross, netTimeshift, NULL,
+                                       d_inner_h, h_inner_h, d_inner_d, NULL, 0) != XLAL_SUCCESS)
+    XLAL_ERROR_REAL8(XLAL_EFUNC);
+  for(ifo=0; ifo<Nifos; ifo++) {
+    /* chi^2 = <d-h|d-h>/2 */
+    model->ifo_loglikelihoods[ifo] = -0.5*(d_inner_d[ifo] - 2.0*creal(d_inner_h[ifo]) + h_inner_h[ifo]);
     loglikelihood += model->ifo_loglikelihoods[ifo];
-
-  } /* end loop over detectors */
+  }
  // printf("%10.10e\n",loglikelihood);
   return(loglikelihood);
 }
@@ -1643,13 +2173,11 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
 /***************************************************************/
 {
   double Fplus, Fcross;
-  REAL8 plainTemplateReal, plainTemplateImag;
-  int i, lower, upper, ifo;
+  int i, ifo;
   LALInferenceIFOData *dataPtr;
   double ra=0.0, dec=0.0, psi=0.0, gmst=0.0;
   double GPSdouble=0.0;
   LIGOTimeGPS GPSlal;
-  double deltaT, TwoOverNDeltaT, deltaF;
   double timeTmp;
   double mc;
   LALStatus status;
@@ -1662,6 +2190,8 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
   for(dataPtr=data;dataPtr;dataPtr=dataPtr->next) Nifos++;
   void *generatedFreqModels[1+Nifos];
   for(i=0;i<=Nifos;i++) generatedFreqModels[i]=NULL;
+  COMPLEX16 netFplus[Nifos], netFcross[Nifos];
+  REAL8 netTimeshift[Nifos];
 
   // If time isn't in current params, remove it at the end
   if(!LALInferenceCheckVariable(currentParams, "time"))
@@ -1794,35 +2324,27 @@ void LALInferenceNetworkSNR(LALInferenceVariables *currentParams,
     /* determine beam pattern response (F_plus and F_cross) for given Ifo: */
     XLALComputeDetAMResponse(&Fplus, &Fcross, (const REAL4(*)[3])dataPtr->detector->response, ra, dec, psi, gmst);
 
-    dataPtr->fPlus = Fplus;
-    dataPtr->fCross = Fcross;
-
-    /* determine frequency range & loop over frequency bins: */
-    deltaT = dataPtr->timeData->deltaT;
-    deltaF = 1.0 / (((double)dataPtr->timeData->data->length) * deltaT);
-    lower = (UINT4)ceil(dataPtr->fLow / deltaF);
-    upper = (UINT4)floor(dataPtr->fHigh / deltaF);
-    TwoOverNDeltaT = 2.0 / (deltaT * ((double) dataPtr->timeData->data->length));
-
-    for (i=lower; i<=upper; ++i){
-      //subtract GW model from residual
-      /* derive template (involving location/orientation parameters) from given plus/cross waveforms: */
-      plainTemplateReal = Fplus * creal(model->freqhPlus->data->data[i])
-                          +  Fcross * creal(model->freqhCross->data->data[i]);
-      plainTemplateImag = Fplus * cimag(model->freqhPlus->data->data[i])
-                          +  Fcross * cimag(model->freqhCross->data->data[i]);
-
-      /* un-do 1/deltaT scaling: */
-      model->ifo_SNRs[ifo] += 2.0 * TwoOverNDeltaT * ( plainTemplateReal*plainTemplateReal + plainTemplateImag*plainTemplateImag ) / dataPtr->oneSidedNoisePowerSpectrum->data->data[i];
-    }
+    if (model->ifo_fPlus) model->ifo_fPlus[ifo] = Fplus;
+    if (model->ifo_fCross) model->ifo_fCross[ifo] = Fcross;
 
-    model->SNR += model->ifo_SNRs[ifo];
-    model->ifo_SNRs[ifo] = sqrt(model->ifo_SNRs[ifo]);
+    netFplus[ifo] = Fplus;
+    netFcross[ifo] = Fcross;
+    netTimeshift[ifo] = 0.0;
 
     ifo++; //increment IFO counter for noise parameters
     dataPtr = dataPtr->next;
   }
 
+  REAL8 h_inner_h[Nifos];
+  if (LALInferenceNetworkInnerProducts(data, model->freqhPlus, model->freqhCross,
+                                       netFplus, netFcross, netTimeshift, NULL,
+                                       NULL, h_inner_h, NULL, NULL, 0) != XLAL_SUCCESS)
+    XLAL_ERROR_VOID(XLAL_EFUNC);
+  for (ifo = 0; ifo < Nifos; ifo++) {
+    model->SNR += h_inner_h[ifo];
+    model->ifo_SNRs[ifo] = sqrt(h_inner_h[ifo]);
+  }
+
   if (remove_time && LALInferenceCheckVariable(currentParams, "time"))
     LALInferenceRemoveVariable(currentParams, "time");
 
@@ -119,12 +119,68 @@ COMPLEX16 LALInferenceComputeFrequencyDomainComplexOverlap(LALInferenceIFOData *
                                                            COMPLEX16Vector * freqData1,
                                                            COMPLEX16Vector * freqData2);
 
+/**
+ * Computes the inner products <d|h>, <h|h> and <d|d> of every detector in
+ * \c data, where d is the detector's data and its template h is
+ * \f$(F_+ \tilde{h}_+ + F_\times \tilde{h}_\times) e^{-2\pi i f \tau}\f$,
+ * multiplied by the spline calibration factor if given.
+ *
+ * \c Fplus, \c Fcross and \c timeshift hold \f$F_+\f$, \f$F_\times\f$ and
+ * \f$\tau\f$ for each detector.  The antenna patterns are complex so that a
+ * constant calibration error can be absorbed into them.  \c calFactor is
+ * either NULL or an array of calibration factors (or NULLs) for each
+ * detector.  The results are stored in \c d_inner_h, \c h_inner_h and
+ * \c d_inner_d, any of which may be NULL.  If \c dh_tilde is not NULL, the
+ * contribution of every frequency bin to <d|h>, summed over detectors, is
+ * added to it.
+ *
+ * All detectors must have the same frequency resolution.  The sums are done
+ * in one pass over blocks of frequency bins, applying every detector to a
+ * block of the template in turn, with loops laid out so that they can be
+ * vectorised.  If \c threaded is non-zero and OpenMP is available, the
+ * blocks are divided among threads.
+ */
+int LALInferenceNetworkInnerProducts(LALInferenceIFOData *data,
+                                     const COMPLEX16FrequencySeries *hplus,
+                                     const COMPLEX16FrequencySeries *hcross,
+                                     const COMPLEX16 *Fplus,
+                                     const COMPLEX16 *Fcross,
+                                     const REAL8 *timeshift,
+                                     COMPLEX16FrequencySeries **calFactor,
+                                     COMPLEX16 *d_inner_h,
+                                     REAL8 *h_inner_h,
+                                     REAL8 *d_inner_d,
+                                     COMPLEX16Vector *dh_tilde,
+                                     int threaded);
+
 /**
  * Identical to LALInferenceFreqDomainNullLogLikelihood, but returns the likelihood of a null template.
  * Used for normalising.
  */
 REAL8 LALInferenceNullLogLikelihood(LALInferenceIFOData *data);
 
+/**
+ * Set up the relative binning (heterodyned) likelihood for \c model.
+ *
+ * The template is computed only at a few hundred frequency nodes, chosen so
+ * that the post-Newtonian bound on the phase difference between waveforms
+ * changes by at most \c epsilon radians across each bin.  The ratio of the
+ * template to a fiducial waveform, computed at the \c fiducial parameters, is
+ * interpolated linearly across each bin, and the sums of the likelihood over
+ * the frequencies of each bin are replaced by summary data of the fiducial
+ * waveform, computed here once.  This is accurate for templates close to
+ * the fiducial waveform, so the fiducial parameters should be near the peak
+ * of the likelihood.
+ *
+ * The summary data are stored in \c data and shared by every model set up
+ * with the same data.  The model's template function is set to
+ * LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence(),
+ * and LALInferenceUndecomposedFreqDomainLogLikelihood() and
+ * LALInferenceMarginalisedPhaseLogLikelihood() then use relative binning
+ * for this model.
+ */
+int LALInferenceSetupRelativeBinning(LALInferenceModel *model, LALInferenceIFOData *data, LALInferenceVariables *fiducial, REAL8 epsilon);
+
 /***********************************************************//**
  * Student-t (log-) likelihood function                        
  * as described in Roever/Meyer/Christensen (2011):            
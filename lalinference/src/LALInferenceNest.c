@@ -124,8 +124,15 @@ int main(int argc, char *argv[]){
 
      }
 
-  /* Set up the threads */
-  LALInferenceInitCBCThreads(state,1);
+  /* Set up the threads, one for each live point replaced at each iteration */
+  INT4 nthreads=1;
+  if (state && LALInferenceGetProcParamVal(state->commandLine,"--nthreads"))
+    nthreads=atoi(LALInferenceGetProcParamVal(state->commandLine,"--nthreads")->value);
+  if (nthreads<1){
+    fprintf(stderr,"Error: --nthreads must be positive\n");
+    exit(1);
+  }
+  LALInferenceInitCBCThreads(state,nthreads);
 
   /* Init the prior */
   LALInferenceInitCBCPrior(state);
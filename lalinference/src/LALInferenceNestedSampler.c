@@ -34,6 +34,10 @@
 #define CVS_DATE "$Date$"
 #define CVS_NAME_STRING "$Name$"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #define MAX_MCMC 5000 /* Maximum chain length, set to be higher than expected from a reasonable run */
 #define ACF_TOLERANCE 0.01 /* Desired maximum correlation of MCMC samples */
 
@@ -325,6 +329,8 @@ static int ReadNSCheckPoint(CHAR *filename, LALInferenceRunState *runState, NSin
 /** Sync the live points to the differential evolution buffer */
 static int syncLivePointsDifferentialPoints(LALInferenceRunState *state, LALInferenceThreadState *thread);
 
+static UINT4 NestedSamplingEvolveThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, const REAL8 *logLikelihoods, const UINT4 *exclude, UINT4 Nexclude, REAL8 logLmin);
+
 /* This is checked by the main loop to determine when to checkpoint */
 static volatile sig_atomic_t __ns_saveStateFlag = 0;
 /* This indicates the main loop should terminate */
@@ -403,6 +409,7 @@ static double logsubexp(double a, double b)
 }
 
 static void SetupEigenProposals(LALInferenceRunState *runState);
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState);
 
 /**
  * Update the internal state of the integrator after receiving the lowest logL
@@ -430,6 +437,20 @@ static REAL8 incrementEvidenceSamples(gsl_rng *GSLrandom, UINT4 Nlive, REAL8 log
   return(mean(s->logZarray->data,s->logZarray->length));
 }
 
+/**
+ * Update the internal state of the integrator after removing the Nbatch live
+ * points batchpos[0], ..., batchpos[Nbatch-1], in increasing order of logL.
+ * Removing them one at a time leaves Nlive-b live points for the b-th.
+ */
+static REAL8 incrementEvidenceBatch(gsl_rng *GSLrandom, UINT4 Nlive, const REAL8 *logLikelihoods, const UINT4 *batchpos, UINT4 Nbatch, NSintegralState *s);
+static REAL8 incrementEvidenceBatch(gsl_rng *GSLrandom, UINT4 Nlive, const REAL8 *logLikelihoods, const UINT4 *batchpos, UINT4 Nbatch, NSintegralState *s)
+{
+  REAL8 logZ=-INFINITY;
+  for(UINT4 b=0;b<Nbatch;b++)
+    logZ=incrementEvidenceSamples(GSLrandom, Nlive-b, logLikelihoods[batchpos[b]], s);
+  return(logZ);
+}
+
 static void printAdaptiveJumpSizes(FILE *file, LALInferenceThreadState *threadState);
 static void printAdaptiveJumpSizes(FILE *file, LALInferenceThreadState *threadState)
 {
@@ -526,9 +547,9 @@ static UINT4 UpdateNMCMC(LALInferenceRunState *runState){
         }
         LALInferenceSetVariable(runState->algorithmParams,"Nmcmc",&max);
     }
-    /* Single threaded here */
     if (LALInferenceGetProcParamVal(runState->commandLine,"--proposal-kde"))
-        LALInferenceSetupClusteredKDEProposalFromDEBuffer(runState->threads[0]);
+        for(INT4 t=0;t<runState->nthreads;t++)
+            LALInferenceSetupClusteredKDEProposalFromDEBuffer(runState->threads[t]);
     return(max);
 }
 
@@ -677,6 +698,8 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
     (--sloppyratio S)                Number of sub-samples of the prior for every sample from the\n\
                                      limited prior\n\
     (--Nruns R)                      Number of parallel samples from logt to use(1)\n\
+    (--nthreads k)                   Replace the k lowest-likelihood live points at each iteration,\n\
+                                     with k MCMC chains evolved in parallel (1)\n\
     (--tolerance dZ)                 Tolerance of nested sampling algorithm (0.1)\n\
     (--randomseed seed)              Random seed of sampling distribution\n\
     (--prior )                       Set the prior to use (InspiralNormalised,SkyLoc,malmquist)\n\
@@ -729,15 +752,13 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState)
   INT4 tmpi=0;
   REAL8 tmp=0;
 
-  /* Single thread only */
-  LALInferenceThreadState *threadState = runState->threads[0];
-
   /* Set up the appropriate functions for the nested sampling algorithm */
   runState->algorithm=&LALInferenceNestedSamplingAlgorithm;
   runState->evolve=&LALInferenceNestedSamplingOneStep;
 
   /* use the ptmcmc proposal to sample prior */
-  threadState->proposal=&LALInferenceCyclicProposal;
+  for(INT4 t=0;t<runState->nthreads;t++)
+    runState->threads[t]->proposal=&LALInferenceCyclicProposal;
   REAL8 temp=1.0;
   LALInferenceAddVariable(runState->proposalArgs,"temperature",&temp,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_FIXED);
 
@@ -834,6 +855,9 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   LALInferenceVariables *currentVars=XLALCalloc(1,sizeof(LALInferenceVariables));
   UINT4 samplePrior=0; //If this flag is set to a positive integer, code will just draw this many samples from the prior
   ProcessParamsTable *ppt=NULL;
+  /* Number of live points replaced at each iteration, one for each thread */
+  UINT4 Nbatch=runState->nthreads>1 ? (UINT4)runState->nthreads : 1;
+  UINT4 *batchpos=NULL,*itercounts=NULL;
 
   if(!runState->logsample) runState->logsample=LALInferenceLogSampleToArray;
 
@@ -915,6 +939,14 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   if(LALInferenceGetProcParamVal(runState->commandLine,"--progress"))
     displayprogress=1;
 
+  if(Nbatch>=Nlive)
+  {
+    fprintf(stderr,"Error: cannot replace %u out of %u live points at each iteration\n",Nbatch,Nlive);
+    exit(1);
+  }
+  batchpos=XLALCalloc(Nbatch,sizeof(UINT4));
+  itercounts=XLALCalloc(Nbatch,sizeof(UINT4));
+
   minpos=0;
 
   logw=log(1.0-exp(-1.0/Nlive));
@@ -927,9 +959,11 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   SetupEigenProposals(runState);
 
   /* Use the live points as differential evolution points */
-  /* Single thread here */
-  syncLivePointsDifferentialPoints(runState,threadState);
-  threadState->differentialPointsSkip=1;
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    syncLivePointsDifferentialPoints(runState,runState->threads[t]);
+    runState->threads[t]->differentialPointsSkip=1;
+  }
 
   if(!LALInferenceCheckVariable(runState->algorithmParams,"Nmcmc")){
     INT4 tmp=MAX_MCMC;
@@ -1023,6 +1057,15 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   minpos=0;
   threadState->currentParams=currentVars;
+  /* Each thread keeps its own statistics of the sampler when evolving in parallel */
+  for(INT4 t=0;t<runState->nthreads;t++)
+  {
+    LALInferenceVariables *stats=runState->threads[t]->algorithmParams;
+    sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    LALInferenceAddVariable(stats,"accept_rate",&zero,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddVariable(stats,"sub_accept_rate",&zero,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+    LALInferenceAddVariable(stats,"sloppyfraction",&sloppyfrac,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+  }
   fprintf(stdout,"Starting nested sampling loop!\n");
   /* Install interrupt handler for resuming */
   if(LALInferenceGetProcParamVal(runState->commandLine,"--resume"))
@@ -1031,41 +1074,102 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
   }
   /* Iterate until termination condition is met */
   do {
-    /* Find minimum likelihood sample to replace */
-    minpos=0;
-    for(i=1;i<Nlive;i++){
-      if(logLikelihoods[i]<logLikelihoods[minpos])
-	minpos=i;
-    }
-    logLmin=logLikelihoods[minpos];
-    if(samplePrior) logLmin=-INFINITY;
-
-    logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive, logLikelihoods[minpos], s);
-    //deltaZ=logZnew-logZ; - set but not used
-    H=mean(Harray,Nruns);
-    logZ=logZnew;
-    if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
     UINT4 itercounter=0;
+    REAL8 logLnew=-INFINITY;
 
-    /* Generate a new live point */
-    do{ /* This loop is here in case it is necessary to find a different sample */
-      /* Clone an old live point and evolve it */
-      while((j=gsl_rng_uniform_int(runState->GSLrandom,Nlive))==minpos){};
-      LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
-      threadState->currentLikelihood = logLikelihoods[j];
+    if(Nbatch==1)
+    {
+      /* Find minimum likelihood sample to replace */
+      minpos=0;
+      for(i=1;i<Nlive;i++){
+        if(logLikelihoods[i]<logLikelihoods[minpos])
+          minpos=i;
+      }
+      logLmin=logLikelihoods[minpos];
+      if(samplePrior) logLmin=-INFINITY;
+
+      logZnew=incrementEvidenceSamples(runState->GSLrandom, Nlive, logLikelihoods[minpos], s);
+      //deltaZ=logZnew-logZ; - set but not used
+      H=mean(Harray,Nruns);
+      logZ=logZnew;
+      if(runState->logsample) runState->logsample(runState->algorithmParams,runState->livePoints[minpos]);
+
+      /* Generate a new live point */
+      do{ /* This loop is here in case it is necessary to find a different sample */
+        /* Clone an old live point and evolve it */
+        while((j=gsl_rng_uniform_int(runState->GSLrandom,Nlive))==minpos){};
+        LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
+        threadState->currentLikelihood = logLikelihoods[j];
+        LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&logLmin);
+        runState->evolve(runState);
+        itercounter++;
+      }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(runState->algorithmParams,"accept_rate")==0.0);
+
+      LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
+      logLikelihoods[minpos]=threadState->currentLikelihood;
+      logLnew=threadState->currentLikelihood;
+      batchpos[0]=minpos;
+    }
+    else
+    {
+      /* Find the Nbatch lowest likelihood samples, in increasing order */
+      for(UINT4 b=0;b<Nbatch;b++){
+        minpos=Nlive;
+        for(i=0;i<Nlive;i++){
+          for(j=0;j<b && batchpos[j]!=i;j++);
+          if(j<b) continue;
+          if(minpos==Nlive || logLikelihoods[i]<logLikelihoods[minpos])
+            minpos=i;
+        }
+        batchpos[b]=minpos;
+      }
+
+      logZnew=incrementEvidenceBatch(runState->GSLrandom, Nlive, logLikelihoods, batchpos, Nbatch, s);
+      if(runState->logsample)
+        for(UINT4 b=0;b<Nbatch;b++)
+          runState->logsample(runState->algorithmParams,runState->livePoints[batchpos[b]]);
+      H=mean(Harray,Nruns);
+      logZ=logZnew;
+
+      /* All of the new points must lie above the highest removed likelihood */
+      logLmin=logLikelihoods[batchpos[Nbatch-1]];
+      if(samplePrior) logLmin=-INFINITY;
       LALInferenceSetVariable(runState->algorithmParams,"logLmin",(void *)&logLmin);
-      runState->evolve(runState);
-      itercounter++;
-    }while( threadState->currentLikelihood<=logLmin ||  *(REAL8*)LALInferenceGetVariable(runState->algorithmParams,"accept_rate")==0.0);
 
-    LALInferenceCopyVariables(threadState->currentParams,runState->livePoints[minpos]);
-    logLikelihoods[minpos]=threadState->currentLikelihood;
+      /* Generate the new live points in parallel, each with the proposals and
+       random numbers of its own thread, so the result does not depend on the
+       scheduling of the threads */
+      #pragma omp parallel for schedule(dynamic,1)
+      for(UINT4 b=0;b<Nbatch;b++)
+        itercounts[b]=NestedSamplingEvolveThread(runState,runState->threads[b],logLikelihoods,batchpos,Nbatch,logLmin);
+
+      REAL8 accept_rate=0.0,sub_accept_rate=0.0;
+      sloppyfrac=0.0;
+      for(UINT4 b=0;b<Nbatch;b++){
+        LALInferenceThreadState *thread=runState->threads[b];
+        LALInferenceCopyVariables(thread->currentParams,runState->livePoints[batchpos[b]]);
+        logLikelihoods[batchpos[b]]=thread->currentLikelihood;
+        if(thread->currentLikelihood>logLnew) logLnew=thread->currentLikelihood;
+        accept_rate+=*(REAL8 *)LALInferenceGetVariable(thread->algorithmParams,"accept_rate")/(REAL8)itercounts[b];
+        sub_accept_rate+=*(REAL8 *)LALInferenceGetVariable(thread->algorithmParams,"sub_accept_rate");
+        sloppyfrac+=*(REAL8 *)LALInferenceGetVariable(thread->algorithmParams,"sloppyfraction");
+      }
+      /* Report the mean over the threads */
+      accept_rate/=(REAL8)Nbatch;
+      sub_accept_rate/=(REAL8)Nbatch;
+      sloppyfrac/=(REAL8)Nbatch;
+      LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
+      LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+      LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfrac);
+      itercounter=1;
+    }
 
-  if (threadState->currentLikelihood>logLmax)
-    logLmax=threadState->currentLikelihood;
+  if (logLnew>logLmax)
+    logLmax=logLnew;
 
   logw=mean(logwarray,Nruns);
-  LALInferenceAddVariable(runState->livePoints[minpos],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
+  for(UINT4 b=0;b<Nbatch;b++)
+    LALInferenceAddVariable(runState->livePoints[batchpos[b]],"logw",&logw,LALINFERENCE_REAL8_t,LALINFERENCE_PARAM_OUTPUT);
   dZ=logaddexp(logZ,logLmax-((double) iter)/((double)Nlive))-logZ;
   sloppyfrac=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
   if(displayprogress) fprintf(stderr,"%i: accpt: %1.3f Nmcmc: %i sub_accpt: %1.3f slpy: %2.1f%% H: %3.2lf nats logL:%.3lf ->%.3lf logZ: %.3lf deltalogLmax: %.2lf dZ: %.3lf Zratio: %.3lf \n",\
@@ -1076,13 +1180,13 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     100.0*sloppyfrac,\
     H,\
     logLmin,\
-    threadState->currentLikelihood,\
+    logLnew,\
     logZ,\
     (logLmax - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise")), \
     dZ,\
     ( logZ - LALInferenceGetREAL8Variable(runState->algorithmParams,"logZnoise"))\
   );
-  iter++;
+  iter+=Nbatch;
 
   /* Save progress */
   if(__ns_saveStateFlag!=0)
@@ -1102,8 +1206,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     exit(0);
   }
 
-  /* Update the proposal */
-  if(!(iter%(Nlive/10))) {
+  /* Update the proposal every Nlive/10 iterations */
+  if(iter/(Nlive/10)!=(iter-Nbatch)/(Nlive/10)) {
     /* Update the covariance matrix */
     //WriteNSCheckPointH5(resumefilename, runState, s);
     if ( LALInferenceCheckVariable( threadState->proposalArgs,"covarianceMatrix" ) ){
@@ -1114,7 +1218,8 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
     UpdateNMCMC(runState);
 
     /* Sync the live points to differential points */
-    syncLivePointsDifferentialPoints(runState,threadState);
+    for(INT4 t=0;t<runState->nthreads;t++)
+      syncLivePointsDifferentialPoints(runState,runState->threads[t]);
 
     /* Output some information */
     if(verbose){
@@ -1242,6 +1347,7 @@ void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState)
 
   /* Free memory */
   XLALFree(logtarray); XLALFree(logwarray); XLALFree(logZarray);
+  XLALFree(batchpos); XLALFree(itercounts);
 }
 
 /* Calculate the autocorrelation function of the sampler (runState->evolve) for each parameter
@@ -1426,11 +1532,10 @@ LALInferenceVariables *LALInferenceComputeAutoCorrelation(LALInferenceRunState *
   return(acls);
 }
 
-/* Perform one MCMC iteration on runState->currentParams. Return 1 if accepted or 0 if not */
-UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
+/* Perform one MCMC iteration on threadState->currentParams, using rng for the
+ * acceptance test. Return 1 if accepted or 0 if not */
+static UINT4 MCMCSamplePriorThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, gsl_rng *rng)
 {
-    /* Single threaded here */
-    LALInferenceThreadState * threadState=runState->threads[0];
     UINT4 outOfBounds=0;
     UINT4 adaptProp=0;
     //LALInferenceVariables tempParams;
@@ -1452,7 +1557,7 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
 
     logProposalRatio = threadState->proposal(threadState,threadState->currentParams,&proposedParams);
     REAL8 logPriorNew=runState->prior(runState, &proposedParams, threadState->model);
-    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(runState->GSLrandom)) > (logPriorNew-logPriorOld) + logProposalRatio)
+    if(isinf(logPriorNew) || isnan(logPriorNew) || log(gsl_rng_uniform(rng)) > (logPriorNew-logPriorOld) + logProposalRatio)
     {
 	/* Reject - don't need to copy new params back to currentParams */
         /*LALInferenceCopyVariables(oldParams,runState->currentParams); */
@@ -1479,6 +1584,13 @@ UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
     return(accepted);
 }
 
+/* Perform one MCMC iteration on runState->currentParams. Return 1 if accepted or 0 if not */
+UINT4 LALInferenceMCMCSamplePrior(LALInferenceRunState *runState)
+{
+    /* Single threaded here */
+    return(MCMCSamplePriorThread(runState,runState->threads[0],runState->GSLrandom));
+}
+
 /* Sample the prior N times, returns number of acceptances */
 UINT4 LALInferenceMCMCSamplePriorNTimes(LALInferenceRunState *runState, UINT4 N)
 {
@@ -1571,14 +1683,13 @@ INT4 LALInferenceNestedSamplingCachedSampler(LALInferenceRunState *runState)
 
 /* Sample the limited prior distribution using the MCMC method as usual, but
    only check the likelihood bound x fraction of the time. Always returns a fulled checked sample.
-   x=LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction")
+   x=LALInferenceGetVariable(stats,"sloppyfraction"), where the acceptance rates are also stored.
+   The single-threaded sampler uses runState->algorithmParams for stats.
    */
 
-INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
+static INT4 NestedSamplingSloppySampleThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, LALInferenceVariables *stats, gsl_rng *rng)
 {
     LALInferenceVariables oldParams;
-    /* Single thread here */
-    LALInferenceThreadState *threadState = runState->threads[0];
     LALInferenceIFOData *data=runState->data;
     REAL8 tmp;
     REAL8 Target=0.3;
@@ -1592,8 +1703,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     REAL8 sloppyfraction=maxsloppyfraction/2.0;
     REAL8 minsloppyfraction=0.;
     if(Nmcmc==1) maxsloppyfraction=minsloppyfraction=0.0;
-    if (LALInferenceCheckVariable(runState->algorithmParams,"sloppyfraction"))
-      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(runState->algorithmParams,"sloppyfraction");
+    if (LALInferenceCheckVariable(stats,"sloppyfraction"))
+      sloppyfraction=*(REAL8 *)LALInferenceGetVariable(stats,"sloppyfraction");
     UINT4 mcmc_iter=0,Naccepted=0,sub_accepted=0;
     UINT4 sloppynumber=(UINT4) (sloppyfraction*(REAL8)Nmcmc);
     UINT4 testnumber=Nmcmc-sloppynumber;
@@ -1619,7 +1730,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         /* Draw an independent sample from the prior */
         do{
 
-            sub_accepted+=LALInferenceMCMCSamplePrior(runState);
+            sub_accepted+=MCMCSamplePriorThread(runState,threadState,rng);
             subchain_length++;
             counter+=(1.-sloppyfraction);
         }while(counter<1);
@@ -1691,8 +1802,8 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     /* Compute some statistics for information */
     REAL8 sub_accept_rate=(REAL8)sub_accepted/(REAL8)sub_iter;
     REAL8 accept_rate=(REAL8)Naccepted/(REAL8)testnumber;
-    LALInferenceSetVariable(runState->algorithmParams,"accept_rate",&accept_rate);
-    LALInferenceSetVariable(runState->algorithmParams,"sub_accept_rate",&sub_accept_rate);
+    LALInferenceSetVariable(stats,"accept_rate",&accept_rate);
+    LALInferenceSetVariable(stats,"sub_accept_rate",&sub_accept_rate);
     /* Adapt the sloppy fraction toward target acceptance of outer chain */
     if(isfinite(logLmin)){
         if((REAL8)accept_rate>Target) { sloppyfraction+=5.0/(REAL8)Nmcmc;}
@@ -1700,7 +1811,7 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
         if(sloppyfraction>maxsloppyfraction) sloppyfraction=maxsloppyfraction;
 	if(sloppyfraction<minsloppyfraction) sloppyfraction=minsloppyfraction;
 
-	LALInferenceSetVariable(runState->algorithmParams,"sloppyfraction",&sloppyfraction);
+	LALInferenceSetVariable(stats,"sloppyfraction",&sloppyfraction);
     }
     /* Cleanup */
     LALInferenceClearVariables(&oldParams);
@@ -1708,6 +1819,34 @@ INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
     return Naccepted;
 }
 
+INT4 LALInferenceNestedSamplingSloppySample(LALInferenceRunState *runState)
+{
+    /* Single thread here */
+    return(NestedSamplingSloppySampleThread(runState,runState->threads[0],runState->algorithmParams,runState->GSLrandom));
+}
+
+/* Evolve threadState->currentParams from a copy of a live point, chosen at
+ random from those not listed in exclude, to a new sample with likelihood above
+ logLmin. Only reads the shared state, so that several threads can do this at
+ once. Returns the number of MCMC chains that were needed. */
+static UINT4 NestedSamplingEvolveThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState, const REAL8 *logLikelihoods, const UINT4 *exclude, UINT4 Nexclude, REAL8 logLmin)
+{
+    UINT4 Nlive=*(UINT4 *)LALInferenceGetVariable(runState->algorithmParams,"Nlive");
+    UINT4 itercounter=0,j,k;
+    do{
+        /* Clone an old live point and evolve it */
+        do{
+            j=gsl_rng_uniform_int(threadState->GSLrandom,Nlive);
+            for(k=0;k<Nexclude && exclude[k]!=j;k++);
+        }while(k<Nexclude);
+        LALInferenceCopyVariables(runState->livePoints[j],threadState->currentParams);
+        threadState->currentLikelihood=logLikelihoods[j];
+        NestedSamplingSloppySampleThread(runState,threadState,threadState->algorithmParams,threadState->GSLrandom);
+        itercounter++;
+    }while(threadState->currentLikelihood<=logLmin || *(REAL8 *)LALInferenceGetVariable(threadState->algorithmParams,"accept_rate")==0.0);
+    return(itercounter);
+}
+
 
 /* Evolve nested sampling algorithm by one step, i.e.
  evolve runState->currentParams to a new point with higher
@@ -1741,6 +1880,7 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 	}
 	threadState->differentialPoints=runState->livePoints;
 	threadState->differentialPointsLength=(size_t) Nlive;
+	threadState->differentialPointsSize=(size_t) Nlive;
 	logLs=XLALCreateREAL8Vector(Nlive);
 
 	LALInferenceAddVariable(runState->algorithmParams,"logLikelihoods",&logLs,LALINFERENCE_REAL8Vector_t,LALINFERENCE_PARAM_FIXED);
@@ -1770,8 +1910,12 @@ void LALInferenceSetupLivePointsArray(LALInferenceRunState *runState){
 
 static void SetupEigenProposals(LALInferenceRunState *runState)
 {
-  /* Single thread here */
-  LALInferenceThreadState *threadState = runState->threads[0];
+  for(INT4 t=0;t<runState->nthreads;t++)
+    SetupEigenProposalsThread(runState,runState->threads[t]);
+}
+
+static void SetupEigenProposalsThread(LALInferenceRunState *runState, LALInferenceThreadState *threadState)
+{
   gsl_matrix *eVectors=NULL;
   gsl_vector *eValues =NULL;
   REAL8Vector *eigenValues=NULL;
@@ -1833,7 +1977,14 @@ static void SetupEigenProposals(LALInferenceRunState *runState)
 static int syncLivePointsDifferentialPoints(LALInferenceRunState *state, LALInferenceThreadState *thread)
 {
     INT4 N = LALInferenceGetINT4Variable(state->algorithmParams,"Nlive");
-    if(!thread->differentialPoints) thread->differentialPoints=XLALCalloc(N,sizeof(LALInferenceVariables *));
+    if(!thread->differentialPoints || thread->differentialPointsSize<(size_t)N)
+    {
+        /* Grow the buffer, which is only one point long for a new thread */
+        size_t oldsize = thread->differentialPoints ? thread->differentialPointsSize : 0;
+        thread->differentialPoints=XLALRealloc(thread->differentialPoints,N*sizeof(LALInferenceVariables *));
+        for(size_t i=oldsize;i<(size_t)N;i++) thread->differentialPoints[i]=NULL;
+        thread->differentialPointsSize=N;
+    }
 
     for(INT4 i=0;i<N;i++)
     {
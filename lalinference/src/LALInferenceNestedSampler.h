@@ -62,6 +62,12 @@ void LALInferenceNestedSamplingAlgorithmInit(LALInferenceRunState *runState);
 /**
  * NestedSamplingAlgorithm implements the nested sampling algorithm,
  * see e.g. Sivia "Data Analysis: A Bayesian Tutorial, 2nd edition
+ *
+ * If runState has k > 1 threads, the k lowest-likelihood live points are
+ * replaced at each iteration, by k MCMC chains which run in parallel with
+ * the proposals and random numbers of their own thread. The evidence
+ * integral then shrinks the prior volume as if the k points were removed
+ * one at a time, with Nlive, Nlive-1, ..., Nlive-k+1 live points.
  */
 void LALInferenceNestedSamplingAlgorithm(LALInferenceRunState *runState);
 
@@ -221,15 +221,24 @@ static void q2masses(double mc, double q, double *m1, double *m2)
   return;
 }
 
-void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
-/*************************************************************************************************************************/
-  Approximant approximant = (Approximant) 0;
+/* Arguments of XLALSimInspiralChooseFDWaveformSequence(), in SI units */
+typedef struct tagFDWaveformSequenceParams
+{
+  Approximant approximant;
+  REAL8 phi0, m1, m2;
+  REAL8 spin1x, spin1y, spin1z, spin2x, spin2y, spin2z;
+  REAL8 f_ref, distance, inclination;
+} FDWaveformSequenceParams;
+
+static int FDWaveformSequenceParamsFromModel(LALInferenceModel *model, FDWaveformSequenceParams *p);
 
+/* Read the waveform parameters from model->params, filling in the
+ * waveform arguments and the waveform flags in model->LALpars. */
+static int FDWaveformSequenceParamsFromModel(LALInferenceModel *model, FDWaveformSequenceParams *p)
+{
   int ret=0;
   INT4 errnum=0;
-
-  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
-  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
+  Approximant approximant = (Approximant) 0;
   REAL8 mc;
   REAL8 phi0, m1, m2, distance, inclination;
 
@@ -239,14 +248,14 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
     approximant = *(Approximant*) LALInferenceGetVariable(model->params, "LAL_APPROXIMANT");
   else {
     XLALPrintError(" ERROR in templateLALGenerateInspiral(): (INT4) \"LAL_APPROXIMANT\" parameter not provided!\n");
-    XLAL_ERROR_VOID(XLAL_EDATA);
+    XLAL_ERROR(XLAL_EDATA);
   }
 
   if (LALInferenceCheckVariable(model->params, "LAL_PNORDER"))
     XLALSimInspiralWaveformParamsInsertPNPhaseOrder(model->LALpars, *(INT4 *) LALInferenceGetVariable(model->params, "LAL_PNORDER"));
   else {
     XLALPrintError(" ERROR in templateLALGenerateInspiral(): (INT4) \"LAL_PNORDER\" parameter not provided!\n");
-    XLAL_ERROR_VOID(XLAL_EDATA);
+    XLAL_ERROR(XLAL_EDATA);
   }
 
   /* Explicitly set the default amplitude order if one is not specified.
@@ -344,7 +353,7 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
       if (ret == XLAL_FAILURE)
       {
         XLALPrintError(" ERROR in XLALSimInspiralTransformPrecessingNewInitialConditions(): error converting angles. errnum=%d\n",errnum );
-        return;
+        XLAL_ERROR(XLAL_EUSR0);
       }
   }
 
@@ -412,12 +421,42 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
     }
   }
 
+  p->approximant = approximant;
+  p->phi0 = phi0;
+  p->m1 = m1*LAL_MSUN_SI;
+  p->m2 = m2*LAL_MSUN_SI;
+  p->spin1x = spin1x;
+  p->spin1y = spin1y;
+  p->spin1z = spin1z;
+  p->spin2x = spin2x;
+  p->spin2y = spin2y;
+  p->spin2z = spin2z;
+  p->f_ref = f_ref;
+  p->distance = distance;
+  p->inclination = inclination;
+
+  return XLAL_SUCCESS;
+}
+
+void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model){
+/*************************************************************************************************************************/
+  FDWaveformSequenceParams p;
+
+  int UNUSED ret=0;
+  INT4 UNUSED errnum=0;
+
+  model->roq->hptildeLinear=NULL, model->roq->hctildeLinear=NULL;
+  model->roq->hptildeQuadratic=NULL, model->roq->hctildeQuadratic=NULL;
+
+  if (FDWaveformSequenceParamsFromModel(model, &p) != XLAL_SUCCESS)
+    XLAL_ERROR_VOID(XLAL_EFUNC);
+
   /* ==== Call the waveform generator ==== */
-    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeLinear), &(model->roq->hctildeLinear), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
-                spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesLinear)), errnum);
+    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeLinear), &(model->roq->hctildeLinear), p.phi0, p.m1, p.m2,
+                p.spin1x, p.spin1y, p.spin1z, p.spin2x, p.spin2y, p.spin2z, p.f_ref, p.distance, p.inclination, model->LALpars, p.approximant, (model->roq->frequencyNodesLinear)), errnum);
 
-    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeQuadratic), &(model->roq->hctildeQuadratic), phi0, m1*LAL_MSUN_SI, m2*LAL_MSUN_SI,
-							spin1x, spin1y, spin1z, spin2x, spin2y, spin2z, f_ref, distance, inclination, model->LALpars, approximant, (model->roq->frequencyNodesQuadratic)), errnum);
+    XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->roq->hptildeQuadratic), &(model->roq->hctildeQuadratic), p.phi0, p.m1, p.m2,
+							p.spin1x, p.spin1y, p.spin1z, p.spin2x, p.spin2y, p.spin2z, p.f_ref, p.distance, p.inclination, model->LALpars, p.approximant, (model->roq->frequencyNodesQuadratic)), errnum);
 
     REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
     LALInferenceSetVariable(model->params, "time", &instant);
@@ -425,6 +464,43 @@ void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferen
         return;
 }
 
+void LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model)
+/*************************************************************************************************************************/
+{
+  FDWaveformSequenceParams p;
+
+  int ret=0;
+  INT4 errnum=0;
+
+  if ( model->relbin->hptilde ) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+  if ( model->relbin->hctilde ) XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+  model->relbin->hptilde=NULL, model->relbin->hctilde=NULL;
+
+  if (FDWaveformSequenceParamsFromModel(model, &p) != XLAL_SUCCESS)
+    XLAL_ERROR_VOID(XLAL_EFUNC);
+
+  /* ==== Call the waveform generator ==== */
+  XLAL_TRY(ret=XLALSimInspiralChooseFDWaveformSequence (&(model->relbin->hptilde), &(model->relbin->hctilde), p.phi0, p.m1, p.m2,
+              p.spin1x, p.spin1y, p.spin1z, p.spin2x, p.spin2y, p.spin2z, p.f_ref, p.distance, p.inclination, model->LALpars, p.approximant, model->relbin->frequencyNodes), errnum);
+  if(ret!=XLAL_SUCCESS){
+    errnum&=~XLAL_EFUNC; /* Mask out the internal function failure bit */
+    switch(errnum)
+    {
+      case XLAL_EDOM:
+        /* The waveform was called outside its domain */
+        XLAL_ERROR_VOID(XLAL_EUSR0);
+      default:
+        XLALSetErrno(errnum);
+        XLAL_ERROR_VOID(errnum,"%s: Template generation failed in XLALSimInspiralChooseFDWaveformSequence",__func__);
+    }
+  }
+
+  REAL8 instant = model->freqhPlus->epoch.gpsSeconds + 1e-9*model->freqhPlus->epoch.gpsNanoSeconds;
+  LALInferenceSetVariable(model->params, "time", &instant);
+
+  return;
+}
+
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model)
 /*****************************************************/
 /* Sine-Gaussian (burst) template.                   */
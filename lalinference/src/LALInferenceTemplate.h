@@ -123,6 +123,16 @@ void LALInferenceTemplateNullTimedomain(LALInferenceModel *model);
 void LALInferenceTemplateSineGaussian(LALInferenceModel *model);
 
 void LALInferenceROQWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
+
+/**
+ * Template for the relative binning likelihood: computes the waveform with
+ * XLALSimInspiralChooseFDWaveformSequence() only at the frequency nodes
+ * \c model->relbin->frequencyNodes, storing it in \c model->relbin->hptilde
+ * and \c model->relbin->hctilde.
+ * Waveforms outside the domain of the approximant give an \c XLAL_EUSR0 error,
+ * as in LALInferenceTemplateXLALSimInspiralChooseWaveform().
+ */
+void LALInferenceRelativeBinningWrapperForXLALSimInspiralChooseFDWaveformSequence(LALInferenceModel *model);
 /**
  * Damped Sinusoid template.
  *
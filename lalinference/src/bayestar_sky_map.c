@@ -77,6 +77,7 @@
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include <pthread.h>
 
 #include <lal/cubic_interp.h>
@@ -102,6 +103,13 @@
 #define omp ignore
 #endif
 
+/* Request vectorization of loops over samples, if OpenMP 4.0 is available. */
+#if defined(_OPENMP) && _OPENMP >= 201307
+#define BAYESTAR_PRAGMA_OMP_SIMD _Pragma("omp simd")
+#else
+#define BAYESTAR_PRAGMA_OMP_SIMD
+#endif
+
 
 /* Compute |z|^2. Hopefully a little faster than gsl_pow_2(cabs(z)), because no
  * square roots are necessary. */
@@ -161,6 +169,57 @@ static double complex eval_snr(
 }
 
 
+/* Evaluate a complex time series using cubic spline interpolation at the
+ * regularly spaced times t0, t0 + 1, ..., t0 + nsamples - 1, storing the real
+ * and imaginary parts separately. This is equivalent to calling eval_snr at
+ * each of those times, but because the fractional part of the time is the
+ * same for all of them, the Catmull-Rom weights are computed only once and
+ * the interpolation reduces to a 4-tap filter. */
+static void interp_snr(
+    double *restrict re,
+    double *restrict im,
+    const float complex *x,
+    size_t nsamples,
+    double t0
+) {
+    const double i0 = floor(t0);
+    const double t = t0 - i0;
+    const double w0 = t*(-0.5 + t*(1. - 0.5*t));
+    const double w1 = 1. + t*t*(-2.5 + 1.5*t);
+    const double w2 = t*(0.5 + t*(2. - 1.5*t));
+    const double w3 = t*t*(-0.5 + 0.5*t);
+
+    /* Range of output samples for which 1 <= i0 + isample < nsamples - 2. */
+    size_t begin = 0, end = 0;
+    {
+        const double lo = 1 - i0, hi = (double) nsamples - 2 - i0;
+        if (lo > 0)
+            begin = lo < (double) nsamples ? (size_t) lo : nsamples;
+        if (hi > 0)
+            end = hi < (double) nsamples ? (size_t) hi : nsamples;
+        if (end < begin)
+            end = begin;
+    }
+    const ssize_t offset = (ssize_t) i0 - 1;
+
+    for (size_t isample = 0; isample < begin; isample ++)
+        re[isample] = im[isample] = 0;
+
+    BAYESTAR_PRAGMA_OMP_SIMD
+    for (size_t isample = begin; isample < end; isample ++)
+    {
+        const float complex *y = &x[(ssize_t) isample + offset];
+        re[isample] = w0 * crealf(y[0]) + w1 * crealf(y[1])
+                    + w2 * crealf(y[2]) + w3 * crealf(y[3]);
+        im[isample] = w0 * cimagf(y[0]) + w1 * cimagf(y[1])
+                    + w2 * cimagf(y[2]) + w3 * cimagf(y[3]);
+    }
+
+    for (size_t isample = end; isample < nsamples; isample ++)
+        re[isample] = im[isample] = 0;
+}
+
+
 typedef struct {
     bicubic_interp *region0;
     cubic_interp *region1;
@@ -487,6 +546,61 @@ static double log_radial_integrator_eval(const log_radial_integrator *integrator
 }
 
 
+/* Evaluate the log radial integral for a single value of p and n values of b.
+ * The result is the same as calling log_radial_integrator_eval for each b[i],
+ * but everything that depends only on p (including the whole result in the
+ * region y >= ymax, where the integral does not depend on b) is computed
+ * once, and the logarithms of b are computed in a separate, vectorizable
+ * loop. */
+static void log_radial_integrator_eval_many(
+    const log_radial_integrator *integrator,
+    double p,
+    double log_p,
+    const double *b,
+    double *result,
+    unsigned long n
+) {
+    if (p == 0)
+    {
+        /* note: p2 == 0 implies b == 0 */
+        const double r = log_radial_integrator_eval(
+            integrator, 0, 0, log_p, -INFINITY);
+        for (unsigned long i = 0; i < n; i ++)
+            result[i] = r;
+        return;
+    }
+
+    const double x = log_p;
+    const double y0 = M_LN2 + 2 * log_p;
+    assert(x <= integrator->xmax);
+    const double region1 = cubic_interp_eval(integrator->region1, x);
+
+    double log_b[n];
+    BAYESTAR_PRAGMA_OMP_SIMD
+    for (unsigned long i = 0; i < n; i ++)
+        log_b[i] = log(b[i]);
+
+    for (unsigned long i = 0; i < n; i ++)
+    {
+        const double y = y0 - log_b[i];
+        double r;
+        if (y >= integrator->ymax) {
+            r = region1;
+        } else {
+            const double v = 0.5 * (x + y);
+            if (v <= integrator->vmax)
+            {
+                const double u = 0.5 * (x - y);
+                r = cubic_interp_eval(integrator->region2, u);
+            } else {
+                r = bicubic_interp_eval(integrator->region0, x, y);
+            }
+        }
+        result[i] = r + gsl_pow_2(0.5 * b[i] / p);
+    }
+}
+
+
 /* Find error in time of arrival. */
 static void toa_errors(
     double *dt,
@@ -742,6 +856,14 @@ static void bayestar_sky_map_toa_phoa_snr_pixel(
         toa_errors(dt, theta, phi, gmst, nifos, locations, epochs);
     }
 
+    /* Interpolate the SNR time series at the arrival times for this sky
+     * location. These do not depend on the polarization or inclination, so
+     * they are computed once per pixel rather than once per (psi, u) node. */
+    double snr_re[nifos][nsamples], snr_im[nifos][nsamples];
+    for (unsigned int iifo = 0; iifo < nifos; iifo ++)
+        interp_snr(snr_re[iifo], snr_im[iifo], snrs[iifo], nsamples,
+            -dt[iifo] * sample_rate - 0.5 * (nsamples - 1));
+
     /* Integrate over 2*psi */
     for (unsigned int itwopsi = 0; itwopsi < ntwopsi; itwopsi++)
     {
@@ -756,7 +878,7 @@ static void bayestar_sky_map_toa_phoa_snr_pixel(
         {
             const double u = u_points_weights[iu][0];
             const double log_weight = u_points_weights[iu][1];
-            double accum2[nsamples][nint];
+            double accum2[nint][nsamples];
 
             const double u2 = gsl_pow_2(u);
             double complex z_times_r[nifos];
@@ -773,33 +895,46 @@ static void bayestar_sky_map_toa_phoa_snr_pixel(
             const double p = sqrt(p2);
             const double log_p = log(p);
 
-            for (unsigned long isample = 0; isample < nsamples; isample++)
+            /* Compute |I0 argument| for all samples at once, one detector
+             * at a time, so that the inner loops are over contiguous
+             * arrays and can be vectorized. */
+            double b[nsamples];
             {
-                double b;
+                double re[nsamples], im[nsamples];
+                for (unsigned long isample = 0; isample < nsamples; isample++)
+                    re[isample] = im[isample] = 0;
+
+                for (unsigned int iifo = 0; iifo < nifos; iifo ++)
                 {
-                    double complex I0arg_complex_times_r = 0;
-                    for (unsigned int iifo = 0; iifo < nifos; iifo ++)
+                    const double zr = creal(z_times_r[iifo]);
+                    const double zi = cimag(z_times_r[iifo]);
+                    const double *restrict sr = snr_re[iifo];
+                    const double *restrict si = snr_im[iifo];
+                    BAYESTAR_PRAGMA_OMP_SIMD
+                    for (unsigned long isample = 0; isample < nsamples; isample++)
                     {
-                        I0arg_complex_times_r += conj(z_times_r[iifo])
-                            * eval_snr(snrs[iifo], nsamples,
-                                isample - dt[iifo] * sample_rate - 0.5 * (nsamples - 1));
+                        /* conj(z) * s */
+                        re[isample] += zr * sr[isample] + zi * si[isample];
+                        im[isample] += zr * si[isample] - zi * sr[isample];
                     }
-                    b = cabs(I0arg_complex_times_r);
-                    b *= gsl_pow_2(FUDGE);
                 }
-                const double log_b = log(b);
 
-                for (unsigned char k = 0; k < nint; k ++)
-                {
-                    accum2[isample][k] = log_radial_integrator_eval(
-                        integrators[k], p, b, log_p, log_b);
-                }
+                BAYESTAR_PRAGMA_OMP_SIMD
+                for (unsigned long isample = 0; isample < nsamples; isample++)
+                    b[isample] = sqrt(gsl_pow_2(re[isample])
+                        + gsl_pow_2(im[isample])) * gsl_pow_2(FUDGE);
             }
 
-            double log_sum_accum2[nint];
-            logsumexp(*accum2, log_weight, log_sum_accum2, nsamples, nint);
             for (unsigned char k = 0; k < nint; k ++)
-                accum1[k] = logaddexp(accum1[k], log_sum_accum2[k]);
+                log_radial_integrator_eval_many(
+                    integrators[k], p, log_p, b, accum2[k], nsamples);
+
+            for (unsigned char k = 0; k < nint; k ++)
+            {
+                double log_sum_accum2;
+                logsumexp(accum2[k], log_weight, &log_sum_accum2, nsamples, 1);
+                accum1[k] = logaddexp(accum1[k], log_sum_accum2);
+            }
         }
 
         for (unsigned char k = 0; k < nint; k ++)
@@ -816,6 +951,21 @@ static void bayestar_sky_map_toa_phoa_snr_pixel(
 }
 
 
+/* Monotonic wall-clock time in seconds, for stage timing and time budgets. */
+static double bayestar_wall_time(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+
+/* Assumed cost of evaluating the distance layers of a pixel, relative to the
+ * measured cost of evaluating its probability during refinement. Used only to
+ * reserve time for the final stage when refining within a time budget. */
+static const double distance_cost_ratio = 1.5;
+
+
 static pthread_once_t bayestar_init_once = PTHREAD_ONCE_INIT;
 static void bayestar_init_func(void)
 {
@@ -829,7 +979,7 @@ static void bayestar_init(void)
 }
 
 
-bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
+bayestar_pixel *bayestar_sky_map_toa_phoa_snr_budget(
     size_t *out_len,                /* Number of returned pixels */
     double *out_log_bci,            /* log Bayes factor: coherent vs. incoherent */
     double *out_log_bsn,            /* log Bayes factor: signal vs. noise */
@@ -847,11 +997,28 @@ bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
     const float complex **snrs,     /* Complex SNR series */
     const float (**responses)[3],   /* Detector responses */
     const double **locations,       /* Barycentered Cartesian geographic detector positions (light seconds) */
-    const double *horizons          /* SNR=1 horizon distances for each detector */
+    const double *horizons,         /* SNR=1 horizon distances for each detector */
+    /* Refinement controls and timing */
+    const bayestar_refinement_params *params, /* Refinement budget, or NULL for defaults */
+    bayestar_timing *timing         /* Per-stage timing output, or NULL */
 ) {
     /* Initialize precalculated tables. */
     bayestar_init();
 
+    const double t_begin = bayestar_wall_time();
+    double t_stage = t_begin;
+    bayestar_timing times = {0, 0, 0, 0, 0, 0, 0};
+
+    static const unsigned char order0 = 4;
+    unsigned char max_order = 11;
+    if (params && params->max_order)
+    {
+        if (params->max_order < order0 || params->max_order > 29)
+            XLAL_ERROR_NULL(XLAL_EINVAL,
+                "max_order must be between %u and 29", (unsigned) order0);
+        max_order = params->max_order;
+    }
+
     if (cosmology && prior_distance_power != 2)
     {
         XLAL_ERROR_NULL(XLAL_EINVAL,
@@ -880,7 +1047,6 @@ bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
         }
     }
 
-    static const unsigned char order0 = 4;
     size_t len;
     bayestar_pixel *pixels = bayestar_pixels_alloc(&len, order0);
     if (!pixels)
@@ -891,6 +1057,9 @@ bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
     }
     const unsigned long npix0 = len;
 
+    times.init = bayestar_wall_time() - t_stage;
+    t_stage += times.init;
+
     OMP_BEGIN_INTERRUPTIBLE
 
     /* At the lowest order, compute both the coherent probability map and the
@@ -927,19 +1096,62 @@ bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
         logsumexp(*accum, log_weight, log_evidence_incoherent, npix0, nifos);
     }
 
+    times.coarse = bayestar_wall_time() - t_stage;
+    t_stage += times.coarse;
+    times.max_order = order0;
+
+    /* Initial estimate of the wall-clock cost of evaluating one pixel. This
+     * is pessimistic, because the coarse stage also computes the incoherent
+     * evidence; it is replaced by a measurement after the first level. */
+    double t_pix = times.coarse / npix0;
+
     /* Sort pixels by ascending posterior probability. */
     bayestar_pixels_sort_prob(pixels, len);
 
-    /* Adaptively refine until order=11 (nside=2048). */
-    for (unsigned char level = order0; level < 11; level ++)
+    /* Adaptively refine until max_order (by default, order=11, nside=2048)
+     * or until the pixel or time budget is exhausted. Because the pixels are
+     * sorted by probability, any budget is spent on the pixels that contain
+     * the most probability first. */
+    for (unsigned char level = order0; level < max_order; level ++)
     {
+        size_t nrefine = npix0 / 4;
+
+        if (params && params->max_pixels)
+        {
+            const unsigned long remaining = params->max_pixels > times.npix_refine
+                ? params->max_pixels - times.npix_refine : 0;
+            if (nrefine > remaining / 4)
+                nrefine = remaining / 4;
+        }
+
+        if (params && params->max_seconds > 0)
+        {
+            /* Reserve time for the distance layers of the pixels that we
+             * already have, and spend the rest on refinement. Each refined
+             * pixel costs four evaluations now and adds three pixels to the
+             * distance stage. */
+            const double t_dist = distance_cost_ratio * t_pix;
+            const double remaining = t_begin + params->max_seconds
+                - bayestar_wall_time() - len * t_dist;
+            const double n = remaining / (4 * t_pix + 3 * t_dist);
+            if (!(n >= 1))
+                nrefine = 0;
+            else if (n < nrefine)
+                nrefine = n;
+        }
+
+        if (nrefine == 0)
+            break;
+
         /* Adaptively refine the pixels that contain the most probability. */
-        pixels = bayestar_pixels_refine(pixels, &len, npix0 / 4);
+        pixels = bayestar_pixels_refine(pixels, &len, nrefine);
         if (!pixels)
             goto done;
 
+        const double t_level = bayestar_wall_time();
+
         #pragma omp parallel for
-        for (unsigned long i = len - npix0; i < len; i ++)
+        for (unsigned long i = len - 4 * nrefine; i < len; i ++)
         {
             if (OMP_WAS_INTERRUPTED)
                 OMP_EXIT_LOOP_EARLY;
@@ -952,10 +1164,22 @@ bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
         if (OMP_WAS_INTERRUPTED)
             goto done;
 
+        t_pix = (bayestar_wall_time() - t_level) / (4 * nrefine);
+        times.npix_refine += 4 * nrefine;
+        for (unsigned long i = len - 4 * nrefine; i < len; i ++)
+        {
+            const int8_t order = uniq2order64(pixels[i].uniq);
+            if (order > times.max_order)
+                times.max_order = order;
+        }
+
         /* Sort pixels by ascending posterior probability. */
         bayestar_pixels_sort_prob(pixels, len);
     }
 
+    times.refine = bayestar_wall_time() - t_stage;
+    t_stage += times.refine;
+
     /* Evaluate distance layers. */
     #pragma omp parallel for
     for (unsigned long i = 0; i < len; i ++)
@@ -968,6 +1192,9 @@ bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
             snrs, responses, locations, horizons);
     }
 
+    times.distance = bayestar_wall_time() - t_stage;
+    t_stage += times.distance;
+
 done:
     for (unsigned char k = 0; k < 3; k ++)
         log_radial_integrator_free(integrators[k]);
@@ -1027,6 +1254,10 @@ done:
 
         /* Done! */
         *out_len = len;
+
+        times.normalize = bayestar_wall_time() - t_stage;
+        if (timing)
+            *timing = times;
     }
 
     OMP_END_INTERRUPTIBLE
@@ -1035,6 +1266,33 @@ done:
 }
 
 
+bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
+    size_t *out_len,                /* Number of returned pixels */
+    double *out_log_bci,            /* log Bayes factor: coherent vs. incoherent */
+    double *out_log_bsn,            /* log Bayes factor: signal vs. noise */
+    /* Prior */
+    double min_distance,            /* Minimum distance */
+    double max_distance,            /* Maximum distance */
+    int prior_distance_power,       /* Power of distance in prior */
+    int cosmology,                  /* Set to nonzero to include comoving volume correction */
+    /* Data */
+    double gmst,                    /* GMST (rad) */
+    unsigned int nifos,             /* Number of detectors */
+    unsigned long nsamples,         /* Length of SNR series */
+    double sample_rate,             /* Sample rate in seconds */
+    const double *epochs,           /* Timestamps of SNR time series */
+    const float complex **snrs,     /* Complex SNR series */
+    const float (**responses)[3],   /* Detector responses */
+    const double **locations,       /* Barycentered Cartesian geographic detector positions (light seconds) */
+    const double *horizons          /* SNR=1 horizon distances for each detector */
+) {
+    return bayestar_sky_map_toa_phoa_snr_budget(out_len, out_log_bci,
+        out_log_bsn, min_distance, max_distance, prior_distance_power,
+        cosmology, gmst, nifos, nsamples, sample_rate, epochs, snrs,
+        responses, locations, horizons, NULL, NULL);
+}
+
+
 double bayestar_log_likelihood_toa_phoa_snr(
     /* Parameters */
     double ra,                      /* Right ascension (rad) */
@@ -1180,6 +1438,75 @@ static void test_eval_snr(void)
 }
 
 
+static void test_interp_snr(void)
+{
+    static const size_t nsamples = 64;
+    float complex x[nsamples];
+    double re[nsamples], im[nsamples];
+
+    /* Populate data with samples of x(t) = t^2 + t j */
+    for (size_t i = 0; i < nsamples; i ++)
+        x[i] = gsl_pow_2(i) + i * 1.0j;
+
+    /* Offsets are chosen to keep away from integers, where the two methods
+     * may legitimately disagree by roundoff about which samples are valid. */
+    for (int j = -8 * (int) nsamples; j <= 8 * (int) nsamples; j ++)
+    {
+        const double t0 = 0.25 * j + 0.1;
+        interp_snr(re, im, x, nsamples, t0);
+        for (size_t i = 0; i < nsamples; i ++)
+        {
+            const double complex expected = eval_snr(x, nsamples, t0 + i);
+            gsl_test_rel(re[i], creal(expected), 1e-12,
+                "testing real part of interp_snr(t0=%g) at sample %zu", t0, i);
+            gsl_test_rel(im[i], cimag(expected), 1e-12,
+                "testing imaginary part of interp_snr(t0=%g) at sample %zu", t0, i);
+        }
+    }
+}
+
+
+static void test_log_radial_integrator_eval_many(void)
+{
+    const double r1 = 0.0, r2 = 0.25, pmax = 1.0;
+    const int k = 2;
+    log_radial_integrator *integrator = log_radial_integrator_init(
+        r1, r2, k, 0, pmax, default_log_radial_integrator_size);
+
+    gsl_test(!integrator, "testing that integrator object is non-NULL");
+    if (integrator)
+    {
+        enum {n = 201};
+        double b[n], result[n];
+        for (unsigned long i = 0; i < n; i ++)
+            b[i] = 0.01 * i;
+
+        for (double p = 0.01; p <= pmax; p += 0.01)
+        {
+            log_radial_integrator_eval_many(integrator, p, log(p), b, result, n);
+            for (unsigned long i = 0; i < n; i ++)
+            {
+                const double expected = log_radial_integrator_eval(
+                    integrator, p, b[i], log(p), log(b[i]));
+                gsl_test_abs(result[i], expected, 0,
+                    "testing log_radial_integrator_eval_many("
+                    "r1=%g, r2=%g, p=%g, b=%g, k=%d)", r1, r2, p, b[i], k);
+            }
+        }
+
+        for (unsigned long i = 0; i < n; i ++)
+            b[i] = 0;
+        log_radial_integrator_eval_many(integrator, 0, -INFINITY, b, result, n);
+        for (unsigned long i = 0; i < n; i ++)
+            gsl_test_abs(result[i],
+                log_radial_integrator_eval(integrator, 0, 0, -INFINITY, -INFINITY),
+                0, "testing log_radial_integrator_eval_many(p=0)");
+
+        log_radial_integrator_free(integrator);
+    }
+}
+
+
 static void test_log_radial_integral(
     double expected, double tol, double r1, double r2, double p2, double b, int k)
 {
@@ -1285,6 +1612,7 @@ int bayestar_test(void)
 
     test_complex_catrom();
     test_eval_snr();
+    test_interp_snr();
 
     /* Tests of radial integrand with p2=0, b=0. */
     test_log_radial_integral(0, 0, 0, 1, 0, 0, 0);
@@ -1339,6 +1667,8 @@ int bayestar_test(void)
         }
     }
 
+    test_log_radial_integrator_eval_many();
+
     for (double mean = 0; mean < 100; mean ++)
         for (double std = 0; std < 100; std ++)
             test_distance_moments_to_parameters_round_trip(mean, std);
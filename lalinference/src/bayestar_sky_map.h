@@ -105,6 +105,58 @@ bayestar_pixel *bayestar_sky_map_toa_phoa_snr(
     const double *horizons          /* SNR=1 horizon distances for each detector */
 );
 
+
+/* Controls for adaptive refinement. Zero for any field means no limit
+ * (or for max_order, the default of 11). */
+typedef struct {
+    double max_seconds;             /* Wall-clock budget for the whole sky map (s) */
+    unsigned long max_pixels;       /* Maximum number of pixels to evaluate during refinement */
+    unsigned char max_order;        /* Maximum HEALPix order, between 4 and 29 */
+} bayestar_refinement_params;
+
+
+/* Wall-clock time spent in each stage of the sky map calculation. */
+typedef struct {
+    double init;                    /* Initializing radial integrators (s) */
+    double coarse;                  /* Coarse map and incoherent evidence (s) */
+    double refine;                  /* Adaptive refinement (s) */
+    double distance;                /* Distance layers (s) */
+    double normalize;               /* Normalizing and sorting the output (s) */
+    unsigned long npix_refine;      /* Number of pixels evaluated during refinement */
+    unsigned char max_order;        /* Highest HEALPix order reached */
+} bayestar_timing;
+
+
+/* Perform sky localization based on TDOAs, PHOAs, and amplitude, with
+ * control over the adaptive refinement. Pixels are refined in order of
+ * decreasing probability until max_order is reached or until either budget
+ * in params is exhausted. The time budget is best effort: the coarse map and
+ * the distance layers are always computed. If timing is not NULL, it is
+ * filled in with the time spent in each stage. */
+bayestar_pixel *bayestar_sky_map_toa_phoa_snr_budget(
+    size_t *out_len,                /* Number of returned pixels */
+    double *out_log_bci,            /* log Bayes factor: coherent vs. incoherent */
+    double *out_log_bsn,            /* log Bayes factor: signal vs. noise */
+    /* Prior */
+    double min_distance,            /* Minimum distance */
+    double max_distance,            /* Maximum distance */
+    int prior_distance_power,       /* Power of distance in prior */
+    int cosmology,                  /* Set to nonzero to include comoving volume correction */
+    /* Data */
+    double gmst,                    /* GMST (rad) */
+    unsigned int nifos,             /* Number of detectors */
+    unsigned long nsamples,         /* Lengths of SNR series */
+    double sample_rate,             /* Sample rate in seconds */
+    const double *epochs,           /* Timestamps of SNR time series */
+    const float complex **snrs,     /* Complex SNR series */
+    const float (**responses)[3],   /* Detector responses */
+    const double **locations,       /* Barycentered Cartesian geographic detector positions (light seconds) */
+    const double *horizons,         /* SNR=1 horizon distances for each detector */
+    /* Refinement controls and timing */
+    const bayestar_refinement_params *params, /* Refinement budget, or NULL for defaults */
+    bayestar_timing *timing         /* Per-stage timing output, or NULL */
+);
+
 double bayestar_log_likelihood_toa_phoa_snr(
     /* Parameters */
     double ra,                      /* Right ascension (rad) */
@@ -1,7 +1,10 @@
 #include <lal/LALInferenceGenerateROQ.h>
 #include <lal/LALConstants.h>
+#include <lal/H5FileIO.h>
 #include <gsl/gsl_randist.h>
 
+#include <stdio.h>
+#include <string.h>
 #include <time.h>
 #include <math.h>
 
@@ -21,6 +24,13 @@
 /* tolerance allow for fractional percentage log likelihood difference */
 #define LTOL 0.1
 
+/* files for generating the reduced basis from a training set on disk */
+#define TSFILE "roq_training_set.hdf5"
+#define CHECKPOINTFILE "roq_checkpoint.hdf5"
+
+/* number of training set waveforms to read from file at once */
+#define CHUNKSIZE 128
+
 /* simple inspiral phase model */
 double calc_phase(double frequency, double Mchirp);
 
@@ -30,6 +40,10 @@ double real_model(double frequency, double Mchirp, double modperiod);
 /* model for a complex frequency domain inspiral-like signal */
 COMPLEX16 imag_model(double frequency, double Mchirp, double modperiod);
 
+/* check the reduced bases generated from a training set in a file */
+int test_real_basis_from_file(REAL8Array *TS, UINT4Vector *gdpts, REAL8Vector *fweights, double tolerance);
+int test_complex_basis_from_file(COMPLEX16Array *cTS, UINT4Vector *gdpts, REAL8Vector *fweights, double tolerance);
+
 double calc_phase(double frequency, double Mchirp){
   return (-0.25*LAL_PI + ( 3./( 128. * pow(Mchirp*LAL_MTSUN_SI*LAL_PI*frequency, 5./3.) ) ) );
 }
@@ -42,10 +56,94 @@ COMPLEX16 imag_model(double frequency, double Mchirp, double modperiod){
   return ( pow(frequency, -7./6.) * pow(Mchirp*LAL_MTSUN_SI,5./6.) * cexp(I*calc_phase(frequency,Mchirp)) )*sin(LAL_TWOPI*frequency/modperiod);
 }
 
+/* Generate the reduced basis from the training set stored in TSFILE, with the standard greedy
+ * algorithm and with blocks of basis vectors, and check that the bases represent the training set,
+ * that the standard greedy algorithm starts with the same points as the in-memory version, and that
+ * restarting from the final checkpoint returns the same basis */
+int test_real_basis_from_file(REAL8Array *TS, UINT4Vector *gdpts, REAL8Vector *fweights, double tolerance){
+  UINT4 blocksizes[2] = { 1, 8 };
+  size_t i = 0, j = 0;
+
+  for ( i = 0; i < 2; i++ ){
+    REAL8Array *RB = NULL, *RBrestart = NULL, *TScopy = NULL;
+    UINT4Vector *gp = NULL, *gprestart = NULL;
+    REAL8 maxprojerr = 0.;
+
+    remove(CHECKPOINTFILE);
+    maxprojerr = LALInferenceGenerateREAL8OrthonormalBasisFromFile(&RB, fweights, tolerance, TSFILE, "TS", CHUNKSIZE, blocksizes[i], CHECKPOINTFILE, &gp);
+    if ( RB == NULL ) { return 1; }
+    fprintf(stderr, "No. linear nodes (real, from file, block size %d) = %d; Maximum projection err. = %le\n", blocksizes[i], RB->dimLength->data[0], maxprojerr);
+
+    if ( blocksizes[i] == 1 ){
+      for ( j = 0; j < 10 && j < gp->length; j++ ){
+        if ( gp->data[j] != gdpts->data[j] ) { return 1; }
+      }
+    }
+
+    TScopy = XLALCreateREAL8Array( TS->dimLength );
+    memcpy(TScopy->data, TS->data, TS->dimLength->data[0]*TS->dimLength->data[1]*sizeof(REAL8));
+    if ( maxprojerr > tolerance || LALInferenceTestREAL8OrthonormalBasis(fweights, tolerance, RB, &TScopy) != XLAL_SUCCESS ) { return 1; }
+    XLALDestroyREAL8Array( TScopy );
+
+    LALInferenceGenerateREAL8OrthonormalBasisFromFile(&RBrestart, fweights, tolerance, TSFILE, "TS", CHUNKSIZE, blocksizes[i], CHECKPOINTFILE, &gprestart);
+    if ( RBrestart == NULL || gprestart->length != gp->length || memcmp(gprestart->data, gp->data, gp->length*sizeof(UINT4)) != 0 ) { return 1; }
+
+    XLALDestroyREAL8Array( RB );
+    XLALDestroyREAL8Array( RBrestart );
+    XLALDestroyUINT4Vector( gp );
+    XLALDestroyUINT4Vector( gprestart );
+  }
+
+  remove(CHECKPOINTFILE);
+
+  return 0;
+}
+
+/* The complex equivalent of test_real_basis_from_file, using the training set "cTS" in TSFILE */
+int test_complex_basis_from_file(COMPLEX16Array *cTS, UINT4Vector *gdpts, REAL8Vector *fweights, double tolerance){
+  UINT4 blocksizes[2] = { 1, 8 };
+  size_t i = 0, j = 0;
+
+  for ( i = 0; i < 2; i++ ){
+    COMPLEX16Array *RB = NULL, *RBrestart = NULL, *TScopy = NULL;
+    UINT4Vector *gp = NULL, *gprestart = NULL;
+    REAL8 maxprojerr = 0.;
+
+    remove(CHECKPOINTFILE);
+    maxprojerr = LALInferenceGenerateCOMPLEX16OrthonormalBasisFromFile(&RB, fweights, tolerance, TSFILE, "cTS", CHUNKSIZE, blocksizes[i], CHECKPOINTFILE, &gp);
+    if ( RB == NULL ) { return 1; }
+    fprintf(stderr, "No. linear nodes (complex, from file, block size %d) = %d; Maximum projection err. = %le\n", blocksizes[i], RB->dimLength->data[0], maxprojerr);
+
+    if ( blocksizes[i] == 1 ){
+      for ( j = 0; j < 10 && j < gp->length; j++ ){
+        if ( gp->data[j] != gdpts->data[j] ) { return 1; }
+      }
+    }
+
+    TScopy = XLALCreateCOMPLEX16Array( cTS->dimLength );
+    memcpy(TScopy->data, cTS->data, cTS->dimLength->data[0]*cTS->dimLength->data[1]*sizeof(COMPLEX16));
+    if ( maxprojerr > tolerance || LALInferenceTestCOMPLEX16OrthonormalBasis(fweights, tolerance, RB, &TScopy) != XLAL_SUCCESS ) { return 1; }
+    XLALDestroyCOMPLEX16Array( TScopy );
+
+    LALInferenceGenerateCOMPLEX16OrthonormalBasisFromFile(&RBrestart, fweights, tolerance, TSFILE, "cTS", CHUNKSIZE, blocksizes[i], CHECKPOINTFILE, &gprestart);
+    if ( RBrestart == NULL || gprestart->length != gp->length || memcmp(gprestart->data, gp->data, gp->length*sizeof(UINT4)) != 0 ) { return 1; }
+
+    XLALDestroyCOMPLEX16Array( RB );
+    XLALDestroyCOMPLEX16Array( RBrestart );
+    XLALDestroyUINT4Vector( gp );
+    XLALDestroyUINT4Vector( gprestart );
+  }
+
+  remove(CHECKPOINTFILE);
+
+  return 0;
+}
+
 int main(void) {
   REAL8Array *TS = NULL, *TSquad = NULL, *cTSquad = NULL;  /* the training set of real waveforms (and quadratic model) */
   COMPLEX16Array *cTS = NULL;              /* the training set of complex waveforms */
   UINT4Vector *gdpts = NULL;               /* the greedy points used for the reduced basis generation */
+  UINT4Vector *lgdpts = NULL, *clgdpts = NULL; /* the greedy points of the linear bases */
 
   size_t TSsize;  /* the size of the training set (number of waveforms) */
   size_t wl;      /* the length of each waveform */
@@ -121,11 +219,9 @@ int main(void) {
 
   /* create reduced orthonormal basis from training set for linear part */
   REAL8 maxprojerr = 0.;
-  maxprojerr = LALInferenceGenerateREAL8OrthonormalBasis(&RBlinear, fweights, tolerance, &TS, &gdpts);
-  XLALDestroyUINT4Vector( gdpts );
+  maxprojerr = LALInferenceGenerateREAL8OrthonormalBasis(&RBlinear, fweights, tolerance, &TS, &lgdpts);
   fprintf(stderr, "No. linear nodes (real) = %d, %d x %d; Maximum projection err. = %le\n", RBlinear->dimLength->data[0], RBlinear->dimLength->data[0], RBlinear->dimLength->data[1], maxprojerr);
-  maxprojerr = LALInferenceGenerateCOMPLEX16OrthonormalBasis(&cRBlinear, fweights, tolerance, &cTS, &gdpts);
-  XLALDestroyUINT4Vector( gdpts );
+  maxprojerr = LALInferenceGenerateCOMPLEX16OrthonormalBasis(&cRBlinear, fweights, tolerance, &cTS, &clgdpts);
   fprintf(stderr, "No. linear nodes (complex) = %d, %d x %d; Maximum projection err. = %le\n", cRBlinear->dimLength->data[0], cRBlinear->dimLength->data[0], cRBlinear->dimLength->data[1], maxprojerr);
   maxprojerr = LALInferenceGenerateREAL8OrthonormalBasis(&RBquad, fweights, tolerance, &TSquad, &gdpts);
   XLALDestroyUINT4Vector( gdpts );
@@ -134,6 +230,20 @@ int main(void) {
   XLALDestroyUINT4Vector( gdpts );
   fprintf(stderr, "No. quadratic nodes (complex)  = %d, %d x %d; Maximum projection err. = %le\n", cRBquad->dimLength->data[0], cRBquad->dimLength->data[0], cRBquad->dimLength->data[1], maxprojerr);
 
+  /* create the linear bases again from the (now normalised) training sets stored in a file */
+  LALH5File *tsfile = XLALH5FileOpen(TSFILE, "w");
+  if ( tsfile == NULL ) { return 1; }
+  if ( XLALH5FileWriteREAL8Array(tsfile, "TS", TS) != XLAL_SUCCESS ) { return 1; }
+  if ( XLALH5FileWriteCOMPLEX16Array(tsfile, "cTS", cTS) != XLAL_SUCCESS ) { return 1; }
+  XLALH5FileClose(tsfile);
+
+  if ( test_real_basis_from_file(TS, lgdpts, fweights, tolerance) ) { return 1; }
+  if ( test_complex_basis_from_file(cTS, clgdpts, fweights, tolerance) ) { return 1; }
+
+  remove(TSFILE);
+  XLALDestroyUINT4Vector( lgdpts );
+  XLALDestroyUINT4Vector( clgdpts );
+
   /* free the training set */
   XLALDestroyREAL8Array( TS );
   XLALDestroyCOMPLEX16Array( cTS );
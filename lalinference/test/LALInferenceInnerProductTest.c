@@ -0,0 +1,180 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests LALInferenceNetworkInnerProducts() against direct evaluation of the
+ * inner products, for three detectors with different frequency ranges,
+ * with and without calibration factors and threading.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Units.h>
+#include <lal/LALInference.h>
+#include <lal/LALInferenceLikelihood.h>
+
+#define NIFO 3
+#define SEGLEN 8.0
+#define SRATE 4096.0
+
+/* relative tolerance on the inner products */
+#define TOL 1e-12
+
+static const REAL8 fLow[NIFO] = { 20.0, 23.3, 10.0 };
+static const REAL8 fHigh[NIFO] = { 2000.0, 1024.0, 2048.0 };
+
+/* Simple deterministic pseudo-random numbers in [-0.5, 0.5) */
+static REAL8 next_random(UINT4 *seed)
+{
+  *seed = 1664525u * (*seed) + 1013904223u;
+  return (*seed >> 8) / 16777216.0 - 0.5;
+}
+
+static int test_inner_products(LALInferenceIFOData *data, const COMPLEX16FrequencySeries *hplus, const COMPLEX16FrequencySeries *hcross,
+                               COMPLEX16FrequencySeries **calFactor, int threaded)
+{
+  const COMPLEX16 Fplus[NIFO] = { 0.3, -0.5 * cexp(0.2 * I), 0.8 };
+  const COMPLEX16 Fcross[NIFO] = { 0.6, 0.1, -0.2 * cexp(-0.4 * I) };
+  const REAL8 timeshift[NIFO] = { 0.0123, -0.017, 3.456 };
+  const UINT4 length = data->freqData->data->length;
+  const REAL8 deltaF = 1.0 / SEGLEN;
+
+  COMPLEX16 d_inner_h[NIFO];
+  REAL8 h_inner_h[NIFO], d_inner_d[NIFO];
+  COMPLEX16Vector *dh_tilde = XLALCreateCOMPLEX16Vector(length);
+  COMPLEX16 *dh_direct = XLALCalloc(length, sizeof(COMPLEX16));
+  XLAL_CHECK(dh_tilde != NULL && dh_direct != NULL, XLAL_ENOMEM);
+  memset(dh_tilde->data, 0, length * sizeof(COMPLEX16));
+
+  XLAL_CHECK(LALInferenceNetworkInnerProducts(data, hplus, hcross, Fplus, Fcross, timeshift, calFactor,
+                                              d_inner_h, h_inner_h, d_inner_d, dh_tilde, threaded) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  LALInferenceIFOData *dataPtr;
+  UINT4 ifo;
+  for (dataPtr = data, ifo = 0; dataPtr; dataPtr = dataPtr->next, ifo++) {
+    const UINT4 lower = (UINT4)ceil(dataPtr->fLow / deltaF);
+    const UINT4 upper = (UINT4)floor(dataPtr->fHigh / deltaF);
+    long double complex dh = 0;
+    long double hh = 0, dd = 0;
+    for (UINT4 i = lower; i <= upper; i++) {
+      long double complex h = (Fplus[ifo] * hplus->data->data[i] + Fcross[ifo] * hcross->data->data[i])
+        * cexpl(-I * LAL_TWOPI * (long double)timeshift[ifo] * deltaF * i);
+      if (calFactor) {
+        h *= calFactor[ifo]->data->data[i];
+      }
+      const COMPLEX16 d = dataPtr->freqData->data->data[i];
+      const long double w = 4.0 * deltaF / dataPtr->oneSidedNoisePowerSpectrum->data->data[i];
+      dh += w * d * conjl(h);
+      hh += w * (creall(h) * creall(h) + cimagl(h) * cimagl(h));
+      dd += w * (creal(d) * creal(d) + cimag(d) * cimag(d));
+      dh_direct[i] += (COMPLEX16)(w * d * conjl(h));
+    }
+    XLAL_CHECK(cabs(d_inner_h[ifo] - (COMPLEX16)dh) < TOL * sqrtl(hh * dd), XLAL_ETOL, "<d|h> of detector %u is %g%+gi, expected %g%+gi",
+               ifo, creal(d_inner_h[ifo]), cimag(d_inner_h[ifo]), (double)creall(dh), (double)cimagl(dh));
+    XLAL_CHECK(fabsl(h_inner_h[ifo] - hh) < TOL * hh, XLAL_ETOL, "<h|h> of detector %u is %g, expected %g", ifo, h_inner_h[ifo], (double)hh);
+    XLAL_CHECK(fabsl(d_inner_d[ifo] - dd) < TOL * dd, XLAL_ETOL, "<d|d> of detector %u is %g, expected %g", ifo, d_inner_d[ifo], (double)dd);
+  }
+
+  REAL8 dhmax = 0;
+  for (UINT4 i = 0; i < length; i++) {
+    dhmax = fmax(dhmax, cabs(dh_direct[i]));
+  }
+  for (UINT4 i = 0; i < length; i++) {
+    XLAL_CHECK(cabs(dh_tilde->data[i] - dh_direct[i]) < TOL * dhmax, XLAL_ETOL, "Contribution of bin %u to <d|h> is wrong", i);
+  }
+
+  XLALDestroyCOMPLEX16Vector(dh_tilde);
+  XLALFree(dh_direct);
+
+  return XLAL_SUCCESS;
+}
+
+int main(void)
+{
+  LIGOTimeGPS epoch = { 1000000000, 0 };
+  const UINT4 N = (UINT4)(SEGLEN * SRATE);
+  const UINT4 length = N / 2 + 1;
+  const REAL8 deltaF = 1.0 / SEGLEN;
+  UINT4 seed = 1;
+
+  /* a chirp-like template */
+  COMPLEX16FrequencySeries *hplus = XLALCreateCOMPLEX16FrequencySeries("hplus", &epoch, 0.0, deltaF, &lalDimensionlessUnit, length);
+  COMPLEX16FrequencySeries *hcross = XLALCreateCOMPLEX16FrequencySeries("hcross", &epoch, 0.0, deltaF, &lalDimensionlessUnit, length);
+  XLAL_CHECK_MAIN(hplus != NULL && hcross != NULL, XLAL_EFUNC);
+  for (UINT4 i = 0; i < length; i++) {
+    const REAL8 f = i * deltaF;
+    const REAL8 amp = (i > 0) ? pow(f, -7.0 / 6.0) : 0.0;
+    const REAL8 phase = 1e3 * pow(f + 1.0, -5.0 / 3.0) + 0.3 * f;
+    hplus->data->data[i] = amp * cexp(-I * phase);
+    hcross->data->data[i] = -0.7 * I * amp * cexp(-I * phase);
+  }
+
+  /* white data, coloured PSDs and calibration factors near one */
+  LALInferenceIFOData *data = NULL;
+  COMPLEX16FrequencySeries *calFactor[NIFO];
+  for (INT4 ifo = NIFO - 1; ifo >= 0; ifo--) {
+    LALInferenceIFOData *dataPtr = XLALCalloc(1, sizeof(LALInferenceIFOData));
+    XLAL_CHECK_MAIN(dataPtr != NULL, XLAL_ENOMEM);
+    dataPtr->fLow = fLow[ifo];
+    dataPtr->fHigh = fHigh[ifo];
+    dataPtr->timeData = XLALCreateREAL8TimeSeries("data", &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, N);
+    dataPtr->freqData = XLALCreateCOMPLEX16FrequencySeries("data", &epoch, 0.0, deltaF, &lalDimensionlessUnit, length);
+    dataPtr->oneSidedNoisePowerSpectrum = XLALCreateREAL8FrequencySeries("psd", &epoch, 0.0, deltaF, &lalDimensionlessUnit, length);
+    calFactor[ifo] = XLALCreateCOMPLEX16FrequencySeries("calibration factors", &epoch, 0.0, deltaF, &lalDimensionlessUnit, length);
+    XLAL_CHECK_MAIN(dataPtr->timeData != NULL && dataPtr->freqData != NULL && dataPtr->oneSidedNoisePowerSpectrum != NULL && calFactor[ifo] != NULL, XLAL_EFUNC);
+    for (UINT4 i = 0; i < length; i++) {
+      const REAL8 f = i * deltaF;
+      dataPtr->oneSidedNoisePowerSpectrum->data->data[i] = 1e-2 * (1.0 + pow((f + 1.0) / 50.0, -4.0) + pow(f / 300.0, 2.0));
+      const REAL8 re = next_random(&seed), im = next_random(&seed);
+      dataPtr->freqData->data->data[i] = crect(re, im);
+      const REAL8 amp = 1.0 + 0.1 * next_random(&seed), phase = 0.1 * next_random(&seed);
+      calFactor[ifo]->data->data[i] = amp * cexp(I * phase);
+    }
+    dataPtr->next = data;
+    data = dataPtr;
+  }
+
+  for (int threaded = 0; threaded < 2; threaded++) {
+    XLAL_CHECK_MAIN(test_inner_products(data, hplus, hcross, NULL, threaded) == XLAL_SUCCESS, XLAL_EFUNC);
+    XLAL_CHECK_MAIN(test_inner_products(data, hplus, hcross, calFactor, threaded) == XLAL_SUCCESS, XLAL_EFUNC);
+  }
+
+  while (data) {
+    LALInferenceIFOData *next = data->next;
+    XLALDestroyREAL8TimeSeries(data->timeData);
+    XLALDestroyCOMPLEX16FrequencySeries(data->freqData);
+    XLALDestroyREAL8FrequencySeries(data->oneSidedNoisePowerSpectrum);
+    XLALFree(data);
+    data = next;
+  }
+  for (UINT4 ifo = 0; ifo < NIFO; ifo++) {
+    XLALDestroyCOMPLEX16FrequencySeries(calFactor[ifo]);
+  }
+  XLALDestroyCOMPLEX16FrequencySeries(hplus);
+  XLALDestroyCOMPLEX16FrequencySeries(hcross);
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,165 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the evidence bookkeeping of the nested sampler when k live points
+ * are replaced at each iteration. Nested sampling is simulated exactly for
+ * the likelihood L(X) = exp(-X/SCALE) of the enclosed prior volume X: the k
+ * lowest-likelihood live points are removed and k new points are drawn
+ * above the highest removed likelihood, as LALInferenceNestedSamplingAlgorithm()
+ * does with k threads. The mean evidence and information over many runs must
+ * agree for k > 1 and k = 1, and with their analytic values.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include <gsl/gsl_rng.h>
+
+#include <lal/LALStdlib.h>
+
+#include "../src/LALInferenceNestedSampler.c" /* Include source directly so we can test the static integrator functions */
+
+#define NLIVE 100
+
+/* number of points removed before the final live points, a multiple of every k */
+#define NREMOVED 2400
+
+/* number of simulated runs for each k */
+#define NREP 400
+
+/* scale of the likelihood in prior volume */
+#define SCALE 0.01
+
+/* allowed difference of the means, in standard errors */
+#define NSIGMA 4.0
+
+/* allowed bias of the integrator's estimates of log Z and H, in nats */
+#define BIAS_TOL 0.1
+
+static const UINT4 nbatch[] = { 1, 2, 4, 8, 16 };
+
+static void destroy_state(NSintegralState *s)
+{
+  XLALDestroyREAL8Vector(s->logZarray);
+  XLALDestroyREAL8Vector(s->oldZarray);
+  XLALDestroyREAL8Vector(s->Harray);
+  XLALDestroyREAL8Vector(s->logwarray);
+  XLALDestroyREAL8Vector(s->logtarray);
+  XLALDestroyREAL8Vector(s->logt2array);
+  XLALFree(s);
+}
+
+/* Find the Nbatch lowest likelihood points, in increasing order */
+static void find_lowest(const REAL8 *logL, UINT4 *batchpos, UINT4 Nbatch)
+{
+  for (UINT4 b = 0; b < Nbatch; b++) {
+    UINT4 minpos = NLIVE;
+    for (UINT4 i = 0; i < NLIVE; i++) {
+      UINT4 j;
+      for (j = 0; j < b && batchpos[j] != i; j++);
+      if (j < b)
+        continue;
+      if (minpos == NLIVE || logL[i] < logL[minpos])
+        minpos = i;
+    }
+    batchpos[b] = minpos;
+  }
+}
+
+/* Simulate one nested sampling run replacing Nbatch points at a time, and
+ * return its evidence and information */
+static void simulate_run(gsl_rng *rng, UINT4 Nbatch, REAL8 *logZ, REAL8 *H)
+{
+  REAL8 X[NLIVE], logL[NLIVE];
+  UINT4 batchpos[NLIVE];
+
+  NSintegralState *s = initNSintegralState(1, NLIVE);
+  for (UINT4 i = 0; i < NLIVE; i++) {
+    X[i] = gsl_rng_uniform_pos(rng);
+    logL[i] = -X[i] / SCALE;
+  }
+
+  for (UINT4 n = 0; n < NREMOVED; n += Nbatch) {
+    find_lowest(logL, batchpos, Nbatch);
+    *logZ = incrementEvidenceBatch(rng, NLIVE, logL, batchpos, Nbatch, s);
+    /* The new points are uniform in the volume of the highest removed likelihood */
+    REAL8 Xmin = X[batchpos[Nbatch - 1]];
+    for (UINT4 b = 0; b < Nbatch; b++) {
+      X[batchpos[b]] = Xmin * gsl_rng_uniform_pos(rng);
+      logL[batchpos[b]] = -X[batchpos[b]] / SCALE;
+    }
+  }
+
+  /* Final corrections from the remaining live points */
+  find_lowest(logL, batchpos, NLIVE);
+  *logZ = incrementEvidenceBatch(rng, NLIVE, logL, batchpos, NLIVE, s);
+  *H = s->Harray->data[0];
+
+  destroy_state(s);
+}
+
+int main(void)
+{
+  const UINT4 nk = sizeof(nbatch) / sizeof(*nbatch);
+  REAL8 meanlogZ[nk], selogZ[nk], meanH[nk], seH[nk];
+
+  /* Analytic evidence and information */
+  const REAL8 Z = SCALE * (1.0 - exp(-1.0 / SCALE));
+  const REAL8 meanX = SCALE - exp(-1.0 / SCALE) / (1.0 - exp(-1.0 / SCALE));
+  const REAL8 trueLogZ = log(Z);
+  const REAL8 trueH = -meanX / SCALE - trueLogZ;
+
+  gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+  XLAL_CHECK_MAIN(rng != NULL, XLAL_ENOMEM);
+  gsl_rng_set(rng, 1234);
+
+  for (UINT4 k = 0; k < nk; k++) {
+    REAL8 sumlogZ = 0, sumlogZ2 = 0, sumH = 0, sumH2 = 0;
+    for (UINT4 r = 0; r < NREP; r++) {
+      REAL8 logZ = -INFINITY, H = 0;
+      simulate_run(rng, nbatch[k], &logZ, &H);
+      XLAL_CHECK_MAIN(isfinite(logZ) && isfinite(H), XLAL_EFAILED, "Non-finite evidence %g or information %g with k=%u", logZ, H, nbatch[k]);
+      sumlogZ += logZ;
+      sumlogZ2 += logZ * logZ;
+      sumH += H;
+      sumH2 += H * H;
+    }
+    meanlogZ[k] = sumlogZ / NREP;
+    selogZ[k] = sqrt((sumlogZ2 / NREP - meanlogZ[k] * meanlogZ[k]) / (NREP - 1));
+    meanH[k] = sumH / NREP;
+    seH[k] = sqrt((sumH2 / NREP - meanH[k] * meanH[k]) / (NREP - 1));
+    printf("k=%u: logZ = %.4f +/- %.4f (true %.4f), H = %.4f +/- %.4f (true %.4f)\n",
+           nbatch[k], meanlogZ[k], selogZ[k], trueLogZ, meanH[k], seH[k], trueH);
+  }
+
+  XLAL_CHECK_MAIN(fabs(meanlogZ[0] - trueLogZ) < NSIGMA * selogZ[0] + BIAS_TOL, XLAL_EFAILED,
+                  "k=1: logZ = %.4f differs from %.4f", meanlogZ[0], trueLogZ);
+  XLAL_CHECK_MAIN(fabs(meanH[0] - trueH) < NSIGMA * seH[0] + BIAS_TOL, XLAL_EFAILED,
+                  "k=1: H = %.4f differs from %.4f", meanH[0], trueH);
+  for (UINT4 k = 1; k < nk; k++) {
+    XLAL_CHECK_MAIN(fabs(meanlogZ[k] - meanlogZ[0]) < NSIGMA * hypot(selogZ[k], selogZ[0]), XLAL_EFAILED,
+                    "k=%u: logZ = %.4f differs from %.4f with k=1", nbatch[k], meanlogZ[k], meanlogZ[0]);
+    XLAL_CHECK_MAIN(fabs(meanH[k] - meanH[0]) < NSIGMA * hypot(seH[k], seH[0]), XLAL_EFAILED,
+                    "k=%u: H = %.4f differs from %.4f with k=1", nbatch[k], meanH[k], meanH[0]);
+  }
+
+  gsl_rng_free(rng);
+  LALCheckMemoryLeaks();
+  return EXIT_SUCCESS;
+}
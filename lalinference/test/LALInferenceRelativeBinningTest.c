@@ -0,0 +1,320 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the relative binning likelihood set up by
+ * LALInferenceSetupRelativeBinning() against the full frequency-domain
+ * likelihood, for a simulated binary black hole signal in Gaussian noise
+ * in two detectors, and reports the speed-up.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/LALConstants.h>
+#include <lal/LALDetectors.h>
+#include <lal/Date.h>
+#include <lal/TimeSeries.h>
+#include <lal/FrequencySeries.h>
+#include <lal/Sequence.h>
+#include <lal/Units.h>
+#include <lal/LogPrintf.h>
+#include <lal/LALSimNoise.h>
+#include <lal/LALSimInspiral.h>
+#include <lal/LALInference.h>
+#include <lal/LALInferenceLikelihood.h>
+#include <lal/LALInferenceTemplate.h>
+
+#define EPOCH 1000000000
+#define SEGLEN 8.0
+#define SRATE 2048.0
+#define FLOW 20.0
+#define FHIGH 1000.0
+
+/* phase tolerance of the relative binning */
+#define EPSILON 0.1
+
+/* number of perturbed parameter points */
+#define NPOINTS 50
+
+/* only compare points within this log likelihood of the fiducial point */
+#define DLOGL_MAX 25.0
+
+/* tolerances on the log likelihood */
+#define FIDUCIAL_TOL 1e-6
+#define LOGL_TOL 0.05
+
+typedef REAL8 (*LikelihoodFunction)(LALInferenceVariables *, LALInferenceIFOData *, LALInferenceModel *);
+
+/* fiducial (injected) parameters, and the scale of their perturbations */
+static const struct {
+  const char *name;
+  REAL8 value;
+  REAL8 scale;
+} injection[] = {
+  { "chirpmass",      28.0,   0.3 },
+  { "q",              0.8,    0.05 },
+  { "a_spin1",        0.3,    0.05 },
+  { "a_spin2",        0.1,    0.05 },
+  { "logdistance",    6.2,    0.05 },
+  { "phase",          1.0,    0.2 },
+  { "costheta_jn",    0.6,    0.05 },
+  { "polarisation",   0.4,    0.1 },
+  { "rightascension", 2.0,    0.01 },
+  { "declination",    -0.5,   0.01 },
+  { "time",           EPOCH + 6.0, 0.0005 },
+};
+
+static LALInferenceIFOData *create_data(const char *name, const LALDetector *detector)
+{
+  LIGOTimeGPS epoch = { EPOCH, 0 };
+  const UINT4 N = (UINT4)(SEGLEN * SRATE);
+
+  LALInferenceIFOData *data = XLALCalloc(1, sizeof(LALInferenceIFOData));
+  XLAL_CHECK_NULL(data != NULL, XLAL_ENOMEM);
+  snprintf(data->name, sizeof(data->name), "%s", name);
+  data->detector = XLALMalloc(sizeof(LALDetector));
+  XLAL_CHECK_NULL(data->detector != NULL, XLAL_ENOMEM);
+  memcpy(data->detector, detector, sizeof(LALDetector));
+  data->fLow = FLOW;
+  data->fHigh = FHIGH;
+
+  data->timeData = XLALCreateREAL8TimeSeries(name, &epoch, 0.0, 1.0 / SRATE, &lalStrainUnit, N);
+  data->freqData = XLALCreateCOMPLEX16FrequencySeries(name, &epoch, 0.0, 1.0 / SEGLEN, &lalDimensionlessUnit, N / 2 + 1);
+  data->oneSidedNoisePowerSpectrum = XLALCreateREAL8FrequencySeries(name, &epoch, 0.0, 1.0 / SEGLEN, &lalDimensionlessUnit, N / 2 + 1);
+  XLAL_CHECK_NULL(data->timeData != NULL && data->freqData != NULL && data->oneSidedNoisePowerSpectrum != NULL, XLAL_EFUNC);
+  memset(data->timeData->data->data, 0, N * sizeof(REAL8));
+  memset(data->freqData->data->data, 0, (N / 2 + 1) * sizeof(COMPLEX16));
+  XLAL_CHECK_NULL(XLALSimNoisePSD(data->oneSidedNoisePowerSpectrum, FLOW, XLALSimNoisePSDaLIGOZeroDetHighPower) == XLAL_SUCCESS, XLAL_EFUNC);
+
+  return data;
+}
+
+static LALInferenceModel *create_model(void)
+{
+  LIGOTimeGPS epoch = { EPOCH, 0 };
+  const UINT4 N = (UINT4)(SEGLEN * SRATE);
+
+  LALInferenceModel *model = XLALCalloc(1, sizeof(LALInferenceModel));
+  XLAL_CHECK_NULL(model != NULL, XLAL_ENOMEM);
+  model->params = XLALCalloc(1, sizeof(LALInferenceVariables));
+  XLAL_CHECK_NULL(model->params != NULL, XLAL_ENOMEM);
+  model->domain = LAL_SIM_DOMAIN_FREQUENCY;
+  model->deltaT = 1.0 / SRATE;
+  model->deltaF = 1.0 / SEGLEN;
+  model->fLow = FLOW;
+  model->fHigh = FHIGH;
+  model->freqhPlus = XLALCreateCOMPLEX16FrequencySeries("freqhPlus", &epoch, 0.0, 1.0 / SEGLEN, &lalDimensionlessUnit, N / 2 + 1);
+  model->freqhCross = XLALCreateCOMPLEX16FrequencySeries("freqhCross", &epoch, 0.0, 1.0 / SEGLEN, &lalDimensionlessUnit, N / 2 + 1);
+  XLAL_CHECK_NULL(model->freqhPlus != NULL && model->freqhCross != NULL, XLAL_EFUNC);
+  model->LALpars = XLALCreateDict();
+  model->ifo_loglikelihoods = XLALCalloc(2, sizeof(REAL8));
+  model->ifo_SNRs = XLALCalloc(2, sizeof(REAL8));
+  model->ifo_fPlus = XLALCalloc(2, sizeof(REAL8));
+  model->ifo_fCross = XLALCalloc(2, sizeof(REAL8));
+  model->ifo_timeshifts = XLALCalloc(2, sizeof(REAL8));
+  XLAL_CHECK_NULL(model->ifo_loglikelihoods != NULL && model->ifo_SNRs != NULL, XLAL_ENOMEM);
+  XLAL_CHECK_NULL(model->ifo_fPlus != NULL && model->ifo_fCross != NULL && model->ifo_timeshifts != NULL, XLAL_ENOMEM);
+  model->templt = &LALInferenceTemplateXLALSimInspiralChooseWaveform;
+  model->relbin = NULL;
+  model->relbin_flag = 0;
+
+  return model;
+}
+
+static void destroy_data(LALInferenceIFOData *data)
+{
+  while (data) {
+    LALInferenceIFOData *next = data->next;
+    if (data->relbin) {
+      XLALFree(data->relbin->h0);
+      XLALFree(data->relbin->A0);
+      XLALFree(data->relbin->A1);
+      XLALFree(data->relbin->B0);
+      XLALFree(data->relbin->B1);
+      XLALFree(data->relbin);
+    }
+    XLALDestroyREAL8TimeSeries(data->timeData);
+    XLALDestroyCOMPLEX16FrequencySeries(data->freqData);
+    XLALDestroyREAL8FrequencySeries(data->oneSidedNoisePowerSpectrum);
+    XLALFree(data->detector);
+    XLALFree(data);
+    data = next;
+  }
+}
+
+static void destroy_model(LALInferenceModel *model)
+{
+  if (model == NULL) {
+    return;
+  }
+  if (model->relbin) {
+    XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hptilde);
+    XLALDestroyCOMPLEX16FrequencySeries(model->relbin->hctilde);
+    XLALDestroyCOMPLEX16Sequence(model->relbin->calFactor);
+    XLALDestroyREAL8Sequence(model->relbin->frequencyNodes);
+    XLALFree(model->relbin);
+  }
+  LALInferenceClearVariables(model->params);
+  XLALFree(model->params);
+  XLALDestroyCOMPLEX16FrequencySeries(model->freqhPlus);
+  XLALDestroyCOMPLEX16FrequencySeries(model->freqhCross);
+  XLALDestroyDict(model->LALpars);
+  XLALFree(model->ifo_loglikelihoods);
+  XLALFree(model->ifo_SNRs);
+  XLALFree(model->ifo_fPlus);
+  XLALFree(model->ifo_fCross);
+  XLALFree(model->ifo_timeshifts);
+  XLALFree(model);
+}
+
+static void set_parameters(LALInferenceVariables *params, gsl_rng *rng, REAL8 scale)
+{
+  UINT4 approximant = IMRPhenomD;
+  INT4 order = LAL_PNORDER_PSEUDO_FOUR;
+  LALInferenceAddVariable(params, "LAL_APPROXIMANT", &approximant, LALINFERENCE_UINT4_t, LALINFERENCE_PARAM_FIXED);
+  LALInferenceAddVariable(params, "LAL_PNORDER", &order, LALINFERENCE_INT4_t, LALINFERENCE_PARAM_FIXED);
+  for (size_t i = 0; i < XLAL_NUM_ELEM(injection); i++) {
+    REAL8 value = injection[i].value;
+    if (rng != NULL) {
+      value += scale * gsl_ran_gaussian(rng, injection[i].scale);
+    }
+    LALInferenceAddREAL8Variable(params, injection[i].name, value, LALINFERENCE_PARAM_LINEAR);
+  }
+}
+
+int main(void)
+{
+  /* two detectors, with zero data for now */
+  LALInferenceIFOData *data = create_data("H1", &lalCachedDetectors[LAL_LHO_4K_DETECTOR]);
+  XLAL_CHECK_MAIN(data != NULL, XLAL_EFUNC);
+  data->next = create_data("L1", &lalCachedDetectors[LAL_LLO_4K_DETECTOR]);
+  XLAL_CHECK_MAIN(data->next != NULL, XLAL_EFUNC);
+
+  LALInferenceModel *model = create_model();
+  LALInferenceModel *rbmodel = create_model();
+  XLAL_CHECK_MAIN(model != NULL && rbmodel != NULL, XLAL_EFUNC);
+
+  gsl_rng *rng = gsl_rng_alloc(gsl_rng_mt19937);
+  XLAL_CHECK_MAIN(rng != NULL, XLAL_ENOMEM);
+  gsl_rng_set(rng, 12345);
+
+  LALInferenceVariables fiducial;
+  memset(&fiducial, 0, sizeof(fiducial));
+  set_parameters(&fiducial, NULL, 0);
+
+  /* inject the fiducial signal, projected onto each detector with the
+   * responses the likelihood leaves in the model, into Gaussian noise */
+  REAL8 logL = LALInferenceUndecomposedFreqDomainLogLikelihood(&fiducial, data, model);
+  XLAL_CHECK_MAIN(isfinite(logL), XLAL_EFUNC);
+  REAL8 snr2 = 0;
+  UINT4 ifo = 0;
+  for (LALInferenceIFOData *dataPtr = data; dataPtr; dataPtr = dataPtr->next, ifo++) {
+    const REAL8 deltaF = dataPtr->freqData->deltaF;
+    const UINT4 lower = (UINT4)ceil(dataPtr->fLow / deltaF);
+    const UINT4 upper = (UINT4)floor(dataPtr->fHigh / deltaF);
+    for (UINT4 i = lower; i <= upper; i++) {
+      const REAL8 f = i * deltaF;
+      const REAL8 S = dataPtr->oneSidedNoisePowerSpectrum->data->data[i];
+      const COMPLEX16 h = (model->ifo_fPlus[ifo]*model->freqhPlus->data->data[i] + model->ifo_fCross[ifo]*model->freqhCross->data->data[i]) * cexp(-I*LAL_TWOPI*model->ifo_timeshifts[ifo]*f);
+      const REAL8 sigma = sqrt(S / (4.0 * deltaF));
+      dataPtr->freqData->data->data[i] = h + gsl_ran_gaussian(rng, sigma) + I*gsl_ran_gaussian(rng, sigma);
+      snr2 += 4.0 * deltaF * (creal(h)*creal(h) + cimag(h)*cimag(h)) / S;
+    }
+  }
+  LALInferenceNullLogLikelihood(data);
+  printf("Injected signal with network SNR %g\n", sqrt(snr2));
+
+  /* set up relative binning about the injection */
+  XLAL_CHECK_MAIN(LALInferenceSetupRelativeBinning(rbmodel, data, &fiducial, EPSILON) == XLAL_SUCCESS, XLAL_EFUNC);
+  XLAL_CHECK_MAIN(rbmodel->relbin_flag && data->relbin != NULL && data->next->relbin != NULL, XLAL_EFAILED);
+  const UINT4 nbins = data->relbin->nbins;
+  const UINT4 nfreq = (UINT4)floor(FHIGH * SEGLEN) - (UINT4)ceil(FLOW * SEGLEN) + 1;
+  printf("Relative binning with %u bins instead of %u frequencies\n", nbins, nfreq);
+  XLAL_CHECK_MAIN(nbins > 0 && nbins < nfreq / 10, XLAL_EFAILED, "Unexpected number of bins %u", nbins);
+
+  const struct {
+    const char *name;
+    LikelihoodFunction func;
+  } likelihoods[] = {
+    { "undecomposed", &LALInferenceUndecomposedFreqDomainLogLikelihood },
+    { "phase marginalised", &LALInferenceMarginalisedPhaseLogLikelihood },
+  };
+
+  for (size_t l = 0; l < XLAL_NUM_ELEM(likelihoods); l++) {
+
+    /* at the fiducial point the two likelihoods agree up to rounding */
+    const REAL8 logL0 = likelihoods[l].func(&fiducial, data, model);
+    const REAL8 rblogL0 = likelihoods[l].func(&fiducial, data, rbmodel);
+    printf("%s likelihood at the fiducial point: full %.6f, relative binning %.6f\n", likelihoods[l].name, logL0, rblogL0);
+    XLAL_CHECK_MAIN(fabs(logL0 - rblogL0) < FIDUCIAL_TOL * fabs(logL0) + FIDUCIAL_TOL, XLAL_EFAILED,
+                    "%s likelihood differs at the fiducial point: |%.9f - %.9f| > %g", likelihoods[l].name, logL0, rblogL0, FIDUCIAL_TOL);
+
+    /* at points near the peak they agree to much better than unity */
+    REAL8 maxerr = 0, tfull = 0, trb = 0;
+    UINT4 ncompared = 0;
+    for (UINT4 n = 0; n < NPOINTS; n++) {
+      REAL8 scale = 1.0, fullLogL = 0, rbLogL = 0;
+      for (UINT4 tries = 0; tries < 10; tries++, scale *= 0.5) {
+        LALInferenceVariables params;
+        memset(&params, 0, sizeof(params));
+        set_parameters(&params, rng, scale);
+        REAL8 t0 = XLALGetTimeOfDay();
+        fullLogL = likelihoods[l].func(&params, data, model);
+        REAL8 t1 = XLALGetTimeOfDay();
+        rbLogL = likelihoods[l].func(&params, data, rbmodel);
+        REAL8 t2 = XLALGetTimeOfDay();
+        LALInferenceClearVariables(&params);
+        tfull += t1 - t0;
+        trb += t2 - t1;
+        if (isfinite(fullLogL) && fullLogL > logL0 - DLOGL_MAX) {
+          break;
+        }
+      }
+      if (!(isfinite(fullLogL) && fullLogL > logL0 - DLOGL_MAX)) {
+        continue;
+      }
+      ncompared++;
+      const REAL8 err = fabs(fullLogL - rbLogL);
+      if (err > maxerr) {
+        maxerr = err;
+      }
+      XLAL_CHECK_MAIN(err < LOGL_TOL, XLAL_EFAILED, "%s likelihood differs by %g > %g: full %.6f, relative binning %.6f",
+                      likelihoods[l].name, err, LOGL_TOL, fullLogL, rbLogL);
+    }
+    XLAL_CHECK_MAIN(ncompared >= NPOINTS / 2, XLAL_EFAILED, "Only %u points were compared", ncompared);
+    printf("%s likelihood: maximum difference %g over %u points; full %g s, relative binning %g s, speed-up %.1f\n",
+           likelihoods[l].name, maxerr, ncompared, tfull, trb, trb > 0 ? tfull / trb : 0.0);
+
+  }
+
+  LALInferenceClearVariables(&fiducial);
+  gsl_rng_free(rng);
+  destroy_model(rbmodel);
+  destroy_model(model);
+  destroy_data(data);
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+}
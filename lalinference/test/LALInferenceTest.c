@@ -21,6 +21,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <lal/LALInference.h>
 #include <lal/Units.h>
 #include <lal/FrequencySeries.h>
@@ -40,6 +41,10 @@
 
 #include "LALInferenceTest.h"
 
+#ifndef _OPENMP
+#define omp ignore
+#endif
+
 #ifdef __GNUC__
 #define UNUSED __attribute__ ((unused))
 #else
@@ -73,6 +78,9 @@ int LALInferenceProcessParamLine_TEST_CHARFILE(void);
 /*  LALInferenceExecuteFT tests */
 int LALInferenceExecuteFTTEST_NULLPLAN(void);
 
+/*  LALInferenceVariables key tests */
+int LALInferenceVariablesTEST_KEYS(void);
+
 int main(void){
     
 	int failureCount = 0;
@@ -91,6 +99,8 @@ int main(void){
 	printf("\n");
 	failureCount += LALInferenceExecuteFTTEST_NULLPLAN();
 	printf("\n");
+	failureCount += LALInferenceVariablesTEST_KEYS();
+	printf("\n");
 	printf("Test results: %i failure(s).\n", failureCount);
 
 	return failureCount;
@@ -370,6 +380,90 @@ int LALInferenceExecuteFTTEST_NULLPLAN(void){
 
 }
 
+/*****************     TEST CODE for LALInferenceVariables keys     *****************/
+/* Test that variables can be accessed by interned key as well as by name. */
+
+int LALInferenceVariablesTEST_KEYS(void){
+
+    TEST_HEADER();
+
+    LALInferenceVariables vars, copy;
+    LALInferenceVariableKey kmass, kdist, kmissing;
+    REAL8 mass = 1.4, dist = 100.0;
+    INT4 n = 3;
+
+    memset(&vars, 0, sizeof(vars));
+    memset(&copy, 0, sizeof(copy));
+
+    kmass = LALInferenceGetVariableKey("mass1");
+    kdist = LALInferenceGetVariableKey("distance");
+    kmissing = LALInferenceGetVariableKey("not_a_variable");
+    if (kmass == 0 || kdist == 0 || kmass == kdist)
+        TEST_FAIL("Invalid keys %u and %u", kmass, kdist);
+    if (LALInferenceGetVariableKey("mass1") != kmass)
+        TEST_FAIL("Key of mass1 is not stable");
+    if (strcmp(LALInferenceGetVariableKeyName(kdist), "distance"))
+        TEST_FAIL("Wrong name for key of distance");
+
+    LALInferenceAddVariable(&vars, "mass1", &mass, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddVariable(&vars, "distance", &dist, LALINFERENCE_REAL8_t, LALINFERENCE_PARAM_LINEAR);
+    LALInferenceAddVariable(&vars, "n", &n, LALINFERENCE_INT4_t, LALINFERENCE_PARAM_FIXED);
+
+    if (LALInferenceGetREAL8VariableByKey(&vars, kmass) != mass)
+        TEST_FAIL("Wrong value of mass1 by key");
+    if (LALInferenceGetVariableByKey(&vars, kdist) != LALInferenceGetVariable(&vars, "distance"))
+        TEST_FAIL("Key and name of distance refer to different variables");
+    if (LALInferenceCheckVariableByKey(&vars, kmissing))
+        TEST_FAIL("Found a variable which was not added");
+
+    dist = 200.0;
+    LALInferenceSetVariableByKey(&vars, kdist, &dist);
+    if (LALInferenceGetREAL8Variable(&vars, "distance") != dist)
+        TEST_FAIL("Wrong value of distance after setting by key");
+
+    /* Copy into an empty structure, then in place into the same layout */
+    LALInferenceCopyVariables(&vars, &copy);
+    if (LALInferenceCompareVariables(&vars, &copy))
+        TEST_FAIL("Copy differs from original");
+    mass = 1.5;
+    LALInferenceSetVariableByKey(&vars, kmass, &mass);
+    LALInferenceCopyVariables(&vars, &copy);
+    if (LALInferenceGetREAL8VariableByKey(&copy, kmass) != mass)
+        TEST_FAIL("Wrong value of mass1 in copy");
+    if (strcmp(LALInferenceGetVariableName(&copy, 1), LALInferenceGetVariableName(&vars, 1)))
+        TEST_FAIL("Copy does not preserve ordering");
+
+    LALInferenceRemoveVariable(&vars, "mass1");
+    if (LALInferenceCheckVariableByKey(&vars, kmass) || LALInferenceCheckVariable(&vars, "mass1"))
+        TEST_FAIL("Found a variable which was removed");
+    if (!LALInferenceCheckVariableByKey(&copy, kmass))
+        TEST_FAIL("Removing a variable from the original removed it from the copy");
+
+    LALInferenceClearVariables(&vars);
+    LALInferenceClearVariables(&copy);
+
+    /* Add enough names to grow the table several times, from several threads
+       at once, while looking up names which are already there */
+    INT4 nbad = 0;
+    #pragma omp parallel for reduction(+:nbad)
+    for (INT4 i = 0; i < 2000; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "key_test_%d", i);
+        LALInferenceVariableKey k = LALInferenceGetVariableKey(name);
+        if (k == 0 || strcmp(LALInferenceGetVariableKeyName(k), name))
+            nbad++;
+        if (LALInferenceGetVariableKey("mass1") != kmass || LALInferenceGetVariableKey(name) != k)
+            nbad++;
+    }
+    if (nbad)
+        TEST_FAIL("%i lookups of interned names failed", nbad);
+    if (strcmp(LALInferenceGetVariableKeyName(kdist), "distance"))
+        TEST_FAIL("Wrong name for key of distance after adding more names");
+
+    TEST_FOOTER();
+
+}
+
 
 /******************************************
  * 
@@ -512,8 +606,7 @@ void BasicMCMCOneStep(LALInferenceRunState *runState)
   logLikelihoodCurrent = thread->currentLikelihood;
 
   // generate proposal:
-  proposedParams.head = NULL;
-  proposedParams.dimension = 0;
+  memset(&proposedParams, 0, sizeof(proposedParams));
   logProposalRatio = thread->proposal(thread, thread->currentParams, &proposedParams);
 
   // compute prior & likelihood:
@@ -640,13 +733,11 @@ void NelderMeadAlgorithm(struct tagLALInferenceRunState *runState, LALInferenceV
 
   printf(" NelderMeadAlgorithm(); current parameter values:\n");
   LALInferencePrintVariables(thread->currentParams);
-  startval.head=NULL;
-  startval.dimension=0;
+  memset(&startval,0,sizeof(startval));
   LALInferenceCopyVariables(thread->currentParams, &startval);
 
   // initialize "param":
-  param.head=NULL;
-  param.dimension=0;
+  memset(&param,0,sizeof(param));
   // "subset" specified? If not, simply gather all REAL8 elements of "currentParams" to optimize over:
   if (subset==NULL) {
     if (thread->currentParams == NULL) {
@@ -826,8 +917,7 @@ void LALVariablesTest(void)
 {
   number = 10.0;
   five=5.0;
-  variables.head=NULL;
-  variables.dimension=0;
+  memset(&variables,0,sizeof(variables));
 	
   memset(&status,0,sizeof(status));
   LALInferenceAddVariable(&variables, "number", &number, LALINFERENCE_REAL4_t,LALINFERENCE_PARAM_FIXED);
@@ -1147,9 +1237,7 @@ void PTMCMCTest(void)
 	//runstate->prior=PTUniformGaussianPrior;
 	//runstate->proposal=PTMCMCLALProposal;
 	//runstate->proposal=PTMCMCGaussianProposal;
-	runstate->proposalArgs = XLALMalloc(sizeof(LALInferenceVariables));
-	runstate->proposalArgs->head=NULL;
-	runstate->proposalArgs->dimension=0;
+	runstate->proposalArgs = XLALCalloc(1, sizeof(LALInferenceVariables));
 	//runstate->likelihood=LALInferenceFreqDomainLogLikelihood;
 	runstate->likelihood=LALInferenceUndecomposedFreqDomainLogLikelihood;
 	//runstate->likelihood=GaussianLikelihood;
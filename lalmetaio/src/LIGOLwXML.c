@@ -52,6 +52,12 @@
  */
 
 
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <lal/LALConfig.h>
 #include <lal/FileIO.h>
 #include <lal/LALMalloc.h>
 #include <lal/LALVCSInfo.h>
@@ -60,6 +66,10 @@
 #include <lal/XLALError.h>
 #include <LIGOLwXMLHeaders.h>
 
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
+
 
 /**
  * Open an XML file for writing.  The return value is a pointer to a new
@@ -135,6 +145,930 @@ XLALCloseLIGOLwXMLFile (
 }
 
 
+/*
+ * ============================================================================
+ *
+ *                          Fast Number Formatting
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * Floating-point numbers are written with the shortest decimal string
+ * that reads back as the same number, found with the Grisu2 algorithm of
+ * F. Loitsch, "Printing Floating-Point Numbers Quickly and Accurately
+ * with Integers", PLDI 2010.  Very occasionally the result is a digit or
+ * two longer than the shortest, but it always reads back exactly.  Unlike
+ * printf() this uses only integer arithmetic.
+ */
+
+
+/* the number f * 2^e */
+typedef struct {
+	uint64_t f;
+	int e;
+} diy_fp;
+
+
+/* 10^(-348 + 8 i), normalized and rounded to 64 bits */
+static const diy_fp cached_powers[] = {
+	{UINT64_C(0xfa8fd5a0081c0288), -1220},
+	{UINT64_C(0xbaaee17fa23ebf76), -1193},
+	{UINT64_C(0x8b16fb203055ac76), -1166},
+	{UINT64_C(0xcf42894a5dce35ea), -1140},
+	{UINT64_C(0x9a6bb0aa55653b2d), -1113},
+	{UINT64_C(0xe61acf033d1a45df), -1087},
+	{UINT64_C(0xab70fe17c79ac6ca), -1060},
+	{UINT64_C(0xff77b1fcbebcdc4f), -1034},
+	{UINT64_C(0xbe5691ef416bd60c), -1007},
+	{UINT64_C(0x8dd01fad907ffc3c), -980},
+	{UINT64_C(0xd3515c2831559a83), -954},
+	{UINT64_C(0x9d71ac8fada6c9b5), -927},
+	{UINT64_C(0xea9c227723ee8bcb), -901},
+	{UINT64_C(0xaecc49914078536d), -874},
+	{UINT64_C(0x823c12795db6ce57), -847},
+	{UINT64_C(0xc21094364dfb5637), -821},
+	{UINT64_C(0x9096ea6f3848984f), -794},
+	{UINT64_C(0xd77485cb25823ac7), -768},
+	{UINT64_C(0xa086cfcd97bf97f4), -741},
+	{UINT64_C(0xef340a98172aace5), -715},
+	{UINT64_C(0xb23867fb2a35b28e), -688},
+	{UINT64_C(0x84c8d4dfd2c63f3b), -661},
+	{UINT64_C(0xc5dd44271ad3cdba), -635},
+	{UINT64_C(0x936b9fcebb25c996), -608},
+	{UINT64_C(0xdbac6c247d62a584), -582},
+	{UINT64_C(0xa3ab66580d5fdaf6), -555},
+	{UINT64_C(0xf3e2f893dec3f126), -529},
+	{UINT64_C(0xb5b5ada8aaff80b8), -502},
+	{UINT64_C(0x87625f056c7c4a8b), -475},
+	{UINT64_C(0xc9bcff6034c13053), -449},
+	{UINT64_C(0x964e858c91ba2655), -422},
+	{UINT64_C(0xdff9772470297ebd), -396},
+	{UINT64_C(0xa6dfbd9fb8e5b88f), -369},
+	{UINT64_C(0xf8a95fcf88747d94), -343},
+	{UINT64_C(0xb94470938fa89bcf), -316},
+	{UINT64_C(0x8a08f0f8bf0f156b), -289},
+	{UINT64_C(0xcdb02555653131b6), -263},
+	{UINT64_C(0x993fe2c6d07b7fac), -236},
+	{UINT64_C(0xe45c10c42a2b3b06), -210},
+	{UINT64_C(0xaa242499697392d3), -183},
+	{UINT64_C(0xfd87b5f28300ca0e), -157},
+	{UINT64_C(0xbce5086492111aeb), -130},
+	{UINT64_C(0x8cbccc096f5088cc), -103},
+	{UINT64_C(0xd1b71758e219652c), -77},
+	{UINT64_C(0x9c40000000000000), -50},
+	{UINT64_C(0xe8d4a51000000000), -24},
+	{UINT64_C(0xad78ebc5ac620000), 3},
+	{UINT64_C(0x813f3978f8940984), 30},
+	{UINT64_C(0xc097ce7bc90715b3), 56},
+	{UINT64_C(0x8f7e32ce7bea5c70), 83},
+	{UINT64_C(0xd5d238a4abe98068), 109},
+	{UINT64_C(0x9f4f2726179a2245), 136},
+	{UINT64_C(0xed63a231d4c4fb27), 162},
+	{UINT64_C(0xb0de65388cc8ada8), 189},
+	{UINT64_C(0x83c7088e1aab65db), 216},
+	{UINT64_C(0xc45d1df942711d9a), 242},
+	{UINT64_C(0x924d692ca61be758), 269},
+	{UINT64_C(0xda01ee641a708dea), 295},
+	{UINT64_C(0xa26da3999aef774a), 322},
+	{UINT64_C(0xf209787bb47d6b85), 348},
+	{UINT64_C(0xb454e4a179dd1877), 375},
+	{UINT64_C(0x865b86925b9bc5c2), 402},
+	{UINT64_C(0xc83553c5c8965d3d), 428},
+	{UINT64_C(0x952ab45cfa97a0b3), 455},
+	{UINT64_C(0xde469fbd99a05fe3), 481},
+	{UINT64_C(0xa59bc234db398c25), 508},
+	{UINT64_C(0xf6c69a72a3989f5c), 534},
+	{UINT64_C(0xb7dcbf5354e9bece), 561},
+	{UINT64_C(0x88fcf317f22241e2), 588},
+	{UINT64_C(0xcc20ce9bd35c78a5), 614},
+	{UINT64_C(0x98165af37b2153df), 641},
+	{UINT64_C(0xe2a0b5dc971f303a), 667},
+	{UINT64_C(0xa8d9d1535ce3b396), 694},
+	{UINT64_C(0xfb9b7cd9a4a7443c), 720},
+	{UINT64_C(0xbb764c4ca7a44410), 747},
+	{UINT64_C(0x8bab8eefb6409c1a), 774},
+	{UINT64_C(0xd01fef10a657842c), 800},
+	{UINT64_C(0x9b10a4e5e9913129), 827},
+	{UINT64_C(0xe7109bfba19c0c9d), 853},
+	{UINT64_C(0xac2820d9623bf429), 880},
+	{UINT64_C(0x80444b5e7aa7cf85), 907},
+	{UINT64_C(0xbf21e44003acdd2d), 933},
+	{UINT64_C(0x8e679c2f5e44ff8f), 960},
+	{UINT64_C(0xd433179d9c8cb841), 986},
+	{UINT64_C(0x9e19db92b4e31ba9), 1013},
+	{UINT64_C(0xeb96bf6ebadf77d9), 1039},
+	{UINT64_C(0xaf87023b9bf0ee6b), 1066},
+};
+
+
+static const uint32_t pow10_32[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+
+static diy_fp diy_fp_multiply(diy_fp x, diy_fp y)
+{
+	const uint64_t m32 = 0xffffffff;
+	const uint64_t a = x.f >> 32, b = x.f & m32, c = y.f >> 32, d = y.f & m32;
+	const uint64_t ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+	/* the middle terms, rounding the discarded low word */
+	const uint64_t mid = (bd >> 32) + (ad & m32) + (bc & m32) + (UINT64_C(1) << 31);
+	diy_fp r;
+	r.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+	r.e = x.e + y.e + 64;
+	return r;
+}
+
+
+static diy_fp diy_fp_normalize(diy_fp x)
+{
+	while(!(x.f & (UINT64_C(1) << 63))) {
+		x.f <<= 1;
+		x.e--;
+	}
+	return x;
+}
+
+
+/*
+ * Move the last digit towards the true value, while it remains in the
+ * interval of numbers that read back correctly.
+ */
+
+
+static void grisu_round(char *digits, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w)
+{
+	while(rest < wp_w && delta - rest >= ten_kappa && (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+		digits[len - 1]--;
+		rest += ten_kappa;
+	}
+}
+
+
+/*
+ * Generate the digits of Mp until they are within delta of it, starting
+ * with the integer part.  Adds the position of the last digit to *K.
+ */
+
+
+static int grisu_digits(diy_fp W, diy_fp Mp, uint64_t delta, char *digits, int *K)
+{
+	const int shift = -Mp.e;
+	const uint64_t one = UINT64_C(1) << shift;
+	const uint64_t wp_w = Mp.f - W.f;
+	uint32_t p1 = Mp.f >> shift;
+	uint64_t p2 = Mp.f & (one - 1);
+	int kappa = 10;
+	int len = 0;
+
+	while(kappa > 0 && p1 < pow10_32[kappa - 1])
+		kappa--;
+
+	while(kappa > 0) {
+		const uint32_t d = p1 / pow10_32[kappa - 1];
+		uint64_t rest;
+		p1 %= pow10_32[kappa - 1];
+		if(d || len)
+			digits[len++] = '0' + d;
+		kappa--;
+		rest = ((uint64_t) p1 << shift) + p2;
+		if(rest <= delta) {
+			*K += kappa;
+			grisu_round(digits, len, delta, rest, (uint64_t) pow10_32[kappa] << shift, wp_w);
+			return len;
+		}
+	}
+
+	while(1) {
+		int d;
+		p2 *= 10;
+		delta *= 10;
+		d = p2 >> shift;
+		if(d || len)
+			digits[len++] = '0' + d;
+		p2 &= one - 1;
+		kappa--;
+		if(p2 < delta) {
+			*K += kappa;
+			grisu_round(digits, len, delta, p2, one, -kappa < 10 ? wp_w * pow10_32[-kappa] : 0);
+			return len;
+		}
+	}
+}
+
+
+/*
+ * Find the shortest digits of the non-zero number f * 2^e, whose
+ * neighbours are 2^e above it and 2^e, or 2^(e-1) if lower_closer, below
+ * it.  Returns the number of digits, and sets *K so that the number is
+ * digits * 10^K.
+ */
+
+
+static int grisu2(uint64_t f, int e, int lower_closer, char *digits, int *K)
+{
+	diy_fp v = {f, e};
+	diy_fp w_plus = {(f << 1) + 1, e - 1};
+	diy_fp w_minus;
+	diy_fp c, W, Wp, Wm;
+	double dk;
+	int k, index;
+
+	/* boundaries of the interval of numbers that round to f * 2^e */
+	if(lower_closer) {
+		w_minus.f = (f << 2) - 1;
+		w_minus.e = e - 2;
+	} else {
+		w_minus.f = (f << 1) - 1;
+		w_minus.e = e - 1;
+	}
+	w_plus = diy_fp_normalize(w_plus);
+	w_minus.f <<= w_minus.e - w_plus.e;
+	w_minus.e = w_plus.e;
+
+	/* scale by a power of ten to bring the binary exponent into [-60, -32] */
+	dk = (-61 - w_plus.e) * 0.30102999566398114 + 347;
+	k = (int) dk;
+	if(dk - k > 0.0)
+		k++;
+	index = (k >> 3) + 1;
+	*K = -(-348 + index * 8);
+	c = cached_powers[index];
+
+	W = diy_fp_multiply(diy_fp_normalize(v), c);
+	Wp = diy_fp_multiply(w_plus, c);
+	Wm = diy_fp_multiply(w_minus, c);
+	/* allow for the error in the products */
+	Wm.f++;
+	Wp.f--;
+
+	return grisu_digits(W, Wp, Wp.f - Wm.f, digits, K);
+}
+
+
+/*
+ * Write digits * 10^K in the style of printf()'s %g, using exponential
+ * notation if the exponent is < -4 or >= max_exp.
+ */
+
+
+static int format_decimal(char *s, const char *digits, int n, int K, int max_exp)
+{
+	const int exp10 = n + K - 1;
+	char *start = s;
+
+	if(exp10 >= -4 && exp10 < max_exp) {
+		if(K >= 0) {
+			memcpy(s, digits, n);
+			memset(s + n, '0', K);
+			s += n + K;
+		} else if(exp10 >= 0) {
+			memcpy(s, digits, exp10 + 1);
+			s[exp10 + 1] = '.';
+			memcpy(s + exp10 + 2, digits + exp10 + 1, n - exp10 - 1);
+			s += n + 1;
+		} else {
+			*s++ = '0';
+			*s++ = '.';
+			memset(s, '0', -exp10 - 1);
+			memcpy(s - exp10 - 1, digits, n);
+			s += n - exp10 - 1;
+		}
+	} else {
+		int a = exp10 < 0 ? -exp10 : exp10;
+		*s++ = digits[0];
+		if(n > 1) {
+			*s++ = '.';
+			memcpy(s, digits + 1, n - 1);
+			s += n - 1;
+		}
+		*s++ = 'e';
+		*s++ = exp10 < 0 ? '-' : '+';
+		if(a >= 100) {
+			*s++ = '0' + a / 100;
+			a %= 100;
+		}
+		*s++ = '0' + a / 10;
+		*s++ = '0' + a % 10;
+	}
+
+	return s - start;
+}
+
+
+static int format_real8(char *s, REAL8 x)
+{
+	union {
+		REAL8 x;
+		uint64_t u;
+	} bits;
+	char digits[24];
+	uint64_t f;
+	int biased_e, n, K;
+	char *start = s;
+
+	if(!isfinite(x))
+		return sprintf(s, "%g", x);
+
+	bits.x = x;
+	if(bits.u >> 63)
+		*s++ = '-';
+	biased_e = (bits.u >> 52) & 0x7ff;
+	f = bits.u & ((UINT64_C(1) << 52) - 1);
+	if(biased_e)
+		n = grisu2(f | (UINT64_C(1) << 52), biased_e - 1075, f == 0 && biased_e > 1, digits, &K);
+	else if(f)
+		n = grisu2(f, -1074, 0, digits, &K);
+	else {
+		*s++ = '0';
+		return s - start;
+	}
+
+	return s - start + format_decimal(s, digits, n, K, 17);
+}
+
+
+static int format_real4(char *s, REAL4 x)
+{
+	union {
+		REAL4 x;
+		uint32_t u;
+	} bits;
+	char digits[24];
+	uint32_t f;
+	int biased_e, n, K;
+	char *start = s;
+
+	if(!isfinite(x))
+		return sprintf(s, "%g", (double) x);
+
+	bits.x = x;
+	if(bits.u >> 31)
+		*s++ = '-';
+	biased_e = (bits.u >> 23) & 0xff;
+	f = bits.u & ((UINT32_C(1) << 23) - 1);
+	if(biased_e)
+		n = grisu2(f | (UINT32_C(1) << 23), biased_e - 150, f == 0 && biased_e > 1, digits, &K);
+	else if(f)
+		n = grisu2(f, -149, 0, digits, &K);
+	else {
+		*s++ = '0';
+		return s - start;
+	}
+
+	return s - start + format_decimal(s, digits, n, K, 9);
+}
+
+
+static int format_uint(char *s, UINT8 x)
+{
+	char tmp[20];
+	int n = 0, i;
+
+	do {
+		tmp[n++] = '0' + x % 10;
+		x /= 10;
+	} while(x);
+	for(i = 0; i < n; i++)
+		s[i] = tmp[n - 1 - i];
+
+	return n;
+}
+
+
+static int format_int(char *s, INT8 x)
+{
+	if(x < 0) {
+		*s = '-';
+		return 1 + format_uint(s + 1, -(UINT8) x);
+	}
+	return format_uint(s, x);
+}
+
+
+/*
+ * ============================================================================
+ *
+ *                          Buffered Table Writer
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * A table is formatted into a large buffer, which is written to the file
+ * when it is full and when the table is complete.  If threads are
+ * available, full buffers are written (and compressed, if writing a .gz
+ * file) by a separate thread, while the next buffer is formatted.
+ */
+
+
+#define LIGOLW_XML_BUFFER_SIZE (1 << 20)
+
+
+struct xml_buffer {
+	LALFILE *fp;
+	char *data;
+	size_t len;
+	size_t size;
+#ifdef LAL_PTHREAD_LOCK
+	/* a full buffer being written by the writer thread */
+	char *pending;
+	size_t pending_len;
+	size_t pending_size;
+	int pending_status;
+	int writing;
+	pthread_t thread;
+#endif
+};
+
+
+static int buffer_init(struct xml_buffer *buf, LALFILE *fp)
+{
+	memset(buf, 0, sizeof(*buf));
+	buf->fp = fp;
+	buf->size = LIGOLW_XML_BUFFER_SIZE;
+	buf->data = XLALMalloc(buf->size);
+	if(!buf->data)
+		XLAL_ERROR(XLAL_ENOMEM);
+	return 0;
+}
+
+
+#ifdef LAL_PTHREAD_LOCK
+static void *buffer_write_thread(void *data)
+{
+	struct xml_buffer *buf = data;
+	buf->pending_status = XLALFileWrite(buf->pending, 1, buf->pending_len, buf->fp) == buf->pending_len ? 0 : -1;
+	return NULL;
+}
+#endif
+
+
+/*
+ * Wait for the writer thread, if any, to finish.
+ */
+
+
+static int buffer_wait(struct xml_buffer *buf)
+{
+#ifdef LAL_PTHREAD_LOCK
+	if(buf->writing) {
+		buf->writing = 0;
+		if(pthread_join(buf->thread, NULL))
+			XLAL_ERROR(XLAL_ESYS);
+		if(buf->pending_status < 0) {
+			XLALPrintError("%s(): failure writing to file\n", __func__);
+			XLAL_ERROR(XLAL_EIO);
+		}
+	}
+#endif
+	return 0;
+}
+
+
+/*
+ * Write the contents of the buffer to the file.  If wait is zero, this
+ * may be done by the writer thread.
+ */
+
+
+static int buffer_flush(struct xml_buffer *buf, int wait)
+{
+	if(buffer_wait(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	if(!buf->len)
+		return 0;
+
+#ifdef LAL_PTHREAD_LOCK
+	if(!wait) {
+		char *data = buf->pending;
+		size_t size = buf->pending_size;
+		if(!data) {
+			size = LIGOLW_XML_BUFFER_SIZE;
+			data = XLALMalloc(size);
+			if(!data)
+				XLAL_ERROR(XLAL_ENOMEM);
+		}
+		buf->pending = buf->data;
+		buf->pending_len = buf->len;
+		buf->pending_size = buf->size;
+		buf->data = data;
+		buf->len = 0;
+		buf->size = size;
+		if(!pthread_create(&buf->thread, NULL, buffer_write_thread, buf)) {
+			buf->writing = 1;
+			return 0;
+		}
+		/* no thread, so write the buffer here */
+		if(XLALFileWrite(buf->pending, 1, buf->pending_len, buf->fp) != buf->pending_len)
+			XLAL_ERROR(XLAL_EFUNC);
+		return 0;
+	}
+#endif
+
+	if(XLALFileWrite(buf->data, 1, buf->len, buf->fp) != buf->len)
+		XLAL_ERROR(XLAL_EFUNC);
+	buf->len = 0;
+	return 0;
+}
+
+
+static void buffer_free(struct xml_buffer *buf)
+{
+	int errnum;
+	XLAL_TRY_SILENT(buffer_wait(buf), errnum);
+	(void) errnum;
+	XLALFree(buf->data);
+#ifdef LAL_PTHREAD_LOCK
+	XLALFree(buf->pending);
+#endif
+	memset(buf, 0, sizeof(*buf));
+}
+
+
+/*
+ * Write out and free the buffer.
+ */
+
+
+static int buffer_close(struct xml_buffer *buf)
+{
+	if(buffer_flush(buf, 1) < 0) {
+		buffer_free(buf);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	buffer_free(buf);
+	return 0;
+}
+
+
+/*
+ * Make room for n more characters in the buffer.
+ */
+
+
+static int buffer_reserve(struct xml_buffer *buf, size_t n)
+{
+	if(buf->len + n <= buf->size)
+		return 0;
+	if(buffer_flush(buf, 0) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	if(n > buf->size) {
+		char *data = XLALRealloc(buf->data, n);
+		if(!data)
+			XLAL_ERROR(XLAL_ENOMEM);
+		buf->data = data;
+		buf->size = n;
+	}
+	return 0;
+}
+
+
+static int buffer_puts(struct xml_buffer *buf, const char *s)
+{
+	const size_t n = strlen(s);
+	if(buffer_reserve(buf, n) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	memcpy(buf->data + buf->len, s, n);
+	buf->len += n;
+	return 0;
+}
+
+
+/*
+ * How a column is stored in memory, and written.
+ */
+
+
+enum column_kind {
+	KIND_INT_4S,	/* INT4 */
+	KIND_INT_4U,	/* UINT4 */
+	KIND_INT_8S,	/* INT8 */
+	KIND_INT_8U,	/* UINT8 */
+	KIND_LONG,	/* long */
+	KIND_ULONG,	/* unsigned long */
+	KIND_REAL_4,	/* REAL4 */
+	KIND_REAL_8,	/* REAL8 */
+	KIND_CHAR_ARRAY,	/* char[] */
+	KIND_CHAR_POINTER	/* char * */
+};
+
+
+struct column_format {
+	const char *name;	/* "table:column" */
+	enum column_kind kind;
+	const char *ilwd_char_prefix;	/* if not NULL, an ilwd:char ID with this prefix */
+	size_t offset;	/* offset of the member in a row structure */
+};
+
+
+static const char *column_type_name(const struct column_format *column)
+{
+	if(column->ilwd_char_prefix)
+		return "ilwd:char";
+	switch(column->kind) {
+	case KIND_INT_4S:
+		return "int_4s";
+	case KIND_INT_4U:
+		return "int_4u";
+	case KIND_INT_8S:
+	case KIND_LONG:
+		return "int_8s";
+	case KIND_INT_8U:
+	case KIND_ULONG:
+		return "int_8u";
+	case KIND_REAL_4:
+		return "real_4";
+	case KIND_REAL_8:
+		return "real_8";
+	default:
+		return "lstring";
+	}
+}
+
+
+/*
+ * Append the value at p to the buffer, preceded by a comma if requested.
+ */
+
+
+static int buffer_put_value(struct xml_buffer *buf, const struct column_format *column, int comma, const void *p)
+{
+	const char *str = NULL;
+	size_t str_len = 0, prefix_len = 0, n = 32;
+	char *s;
+
+	if(column->kind == KIND_CHAR_ARRAY)
+		str = p;
+	else if(column->kind == KIND_CHAR_POINTER)
+		str = *(const char * const *) p ? *(const char * const *) p : "";
+	if(str)
+		n += str_len = strlen(str);
+	if(column->ilwd_char_prefix)
+		n += prefix_len = strlen(column->ilwd_char_prefix);
+	if(buffer_reserve(buf, n) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	s = buf->data + buf->len;
+
+	if(comma)
+		*s++ = ',';
+	if(str || prefix_len)
+		*s++ = '"';
+	if(prefix_len) {
+		memcpy(s, column->ilwd_char_prefix, prefix_len);
+		s += prefix_len;
+	}
+	switch(column->kind) {
+	case KIND_INT_4S:
+		s += format_int(s, *(const INT4 *) p);
+		break;
+	case KIND_INT_4U:
+		s += format_uint(s, *(const UINT4 *) p);
+		break;
+	case KIND_INT_8S:
+		s += format_int(s, *(const INT8 *) p);
+		break;
+	case KIND_INT_8U:
+		s += format_uint(s, *(const UINT8 *) p);
+		break;
+	case KIND_LONG:
+		s += format_int(s, *(const long *) p);
+		break;
+	case KIND_ULONG:
+		s += format_uint(s, *(const unsigned long *) p);
+		break;
+	case KIND_REAL_4:
+		s += format_real4(s, *(const REAL4 *) p);
+		break;
+	case KIND_REAL_8:
+		s += format_real8(s, *(const REAL8 *) p);
+		break;
+	case KIND_CHAR_ARRAY:
+	case KIND_CHAR_POINTER:
+		memcpy(s, str, str_len);
+		s += str_len;
+		break;
+	}
+	if(str || prefix_len)
+		*s++ = '"';
+
+	buf->len = s - buf->data;
+	return 0;
+}
+
+
+/*
+ * Start a table: check that no table is open, set up the buffer, and
+ * write the table header.
+ */
+
+
+static int table_begin(struct xml_buffer *buf, LIGOLwXMLStream *xml, const char *table_name, const struct column_format *columns, size_t num_columns)
+{
+	size_t i;
+
+	if(xml->table != no_table) {
+		XLALPrintError("a table is still open");
+		XLAL_ERROR(XLAL_EFAILED);
+	}
+
+	if(buffer_init(buf, xml->fp) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	if(buffer_puts(buf, "\t<Table Name=\"") < 0 || buffer_puts(buf, table_name) < 0 || buffer_puts(buf, ":table\">\n") < 0)
+		goto error;
+	for(i = 0; i < num_columns; i++)
+		if(buffer_puts(buf, "\t\t<Column Name=\"") < 0 || buffer_puts(buf, columns[i].name) < 0 || buffer_puts(buf, "\" Type=\"") < 0 || buffer_puts(buf, column_type_name(&columns[i])) < 0 || buffer_puts(buf, "\"/>\n") < 0)
+			goto error;
+	if(buffer_puts(buf, "\t\t<Stream Name=\"") < 0 || buffer_puts(buf, table_name) < 0 || buffer_puts(buf, ":table\" Type=\"Local\" Delimiter=\",\">") < 0)
+		goto error;
+
+	return 0;
+
+error:
+	buffer_free(buf);
+	XLAL_ERROR(XLAL_EFUNC);
+}
+
+
+/*
+ * Write the table footer, and write out the buffer.
+ */
+
+
+static int table_end(struct xml_buffer *buf)
+{
+	if(buffer_puts(buf, "\n\t\t</Stream>\n\t</Table>\n") < 0) {
+		buffer_free(buf);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	if(buffer_close(buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/*
+ * Write a table whose rows are a linked list of structures.  next_offset
+ * is the offset of the pointer to the next row in each structure.
+ */
+
+
+static int write_list_table(LIGOLwXMLStream *xml, const char *table_name, const struct column_format *columns, size_t num_columns, const void *row, size_t next_offset)
+{
+	struct xml_buffer buf;
+	const char *row_head = "\n\t\t\t";
+	size_t i;
+
+	if(table_begin(&buf, xml, table_name, columns, num_columns) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+
+	for(; row; row = *(const void * const *) ((const char *) row + next_offset)) {
+		if(buffer_puts(&buf, row_head) < 0)
+			goto error;
+		for(i = 0; i < num_columns; i++)
+			if(buffer_put_value(&buf, &columns[i], i > 0, (const char *) row + columns[i].offset) < 0)
+				goto error;
+		row_head = ",\n\t\t\t";
+	}
+
+	if(table_end(&buf) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+
+error:
+	buffer_free(&buf);
+	XLAL_ERROR(XLAL_EFUNC);
+}
+
+
+/**
+ * Write a table whose columns are stored in separate arrays.  Row i of
+ * column j is found at <tt>(const char *) columns[j].data + i *
+ * columns[j].stride</tt>; a stride of 0 means the elements of the array
+ * are adjacent.  The column names are of the form "table:column", and
+ * IDs in \c LIGOLW_XML_ILWD_CHAR columns are written as
+ * "table:column:ID".
+ */
+
+
+int XLALWriteLIGOLwXMLTableColumns(
+	LIGOLwXMLStream *xml,
+	const char *table_name,
+	const LIGOLwXMLColumn *columns,
+	size_t num_columns,
+	size_t num_rows
+)
+{
+	struct xml_buffer buf;
+	struct column_format *formats;
+	size_t *strides;
+	const char *row_head = "\n\t\t\t";
+	int errnum = 0;
+	size_t i, j;
+
+	if(!xml || !table_name || (num_columns && !columns))
+		XLAL_ERROR(XLAL_EFAULT);
+
+	formats = XLALCalloc(num_columns + 1, sizeof(*formats));
+	strides = XLALCalloc(num_columns + 1, sizeof(*strides));
+	if(!formats || !strides) {
+		errnum = XLAL_ENOMEM;
+		goto done;
+	}
+
+	/* describe the columns */
+
+	for(j = 0; j < num_columns; j++) {
+		size_t size;
+		if(!columns[j].name || (num_rows && !columns[j].data)) {
+			XLALPrintError("%s(): column %zu of %s table has no name or data\n", __func__, j, table_name);
+			errnum = XLAL_EFAULT;
+			goto done;
+		}
+		formats[j].name = columns[j].name;
+		switch(columns[j].type) {
+		case LIGOLW_XML_INT_4S:
+			formats[j].kind = KIND_INT_4S;
+			size = sizeof(INT4);
+			break;
+		case LIGOLW_XML_INT_4U:
+			formats[j].kind = KIND_INT_4U;
+			size = sizeof(UINT4);
+			break;
+		case LIGOLW_XML_INT_8S:
+			formats[j].kind = KIND_INT_8S;
+			size = sizeof(INT8);
+			break;
+		case LIGOLW_XML_INT_8U:
+			formats[j].kind = KIND_INT_8U;
+			size = sizeof(UINT8);
+			break;
+		case LIGOLW_XML_REAL_4:
+			formats[j].kind = KIND_REAL_4;
+			size = sizeof(REAL4);
+			break;
+		case LIGOLW_XML_REAL_8:
+			formats[j].kind = KIND_REAL_8;
+			size = sizeof(REAL8);
+			break;
+		case LIGOLW_XML_LSTRING:
+			formats[j].kind = KIND_CHAR_POINTER;
+			size = sizeof(const char *);
+			break;
+		case LIGOLW_XML_ILWD_CHAR: {
+			char *prefix = XLALMalloc(strlen(columns[j].name) + 2);
+			if(!prefix) {
+				errnum = XLAL_ENOMEM;
+				goto done;
+			}
+			sprintf(prefix, "%s:", columns[j].name);
+			formats[j].kind = KIND_INT_8S;
+			formats[j].ilwd_char_prefix = prefix;
+			size = sizeof(INT8);
+			break;
+		}
+		default:
+			XLALPrintError("%s(): column %s of %s table has invalid type\n", __func__, columns[j].name, table_name);
+			errnum = XLAL_EINVAL;
+			goto done;
+		}
+		strides[j] = columns[j].stride ? columns[j].stride : size;
+	}
+
+	/* write the table */
+
+	if(table_begin(&buf, xml, table_name, formats, num_columns) < 0) {
+		errnum = XLAL_EFUNC;
+		goto done;
+	}
+	for(i = 0; i < num_rows; i++) {
+		int failed = buffer_puts(&buf, row_head) < 0;
+		for(j = 0; j < num_columns && !failed; j++)
+			failed = buffer_put_value(&buf, &formats[j], j > 0, (const char *) columns[j].data + i * strides[j]) < 0;
+		if(failed) {
+			buffer_free(&buf);
+			errnum = XLAL_EFUNC;
+			goto done;
+		}
+		row_head = ",\n\t\t\t";
+	}
+	if(table_end(&buf) < 0)
+		errnum = XLAL_EFUNC;
+
+done:
+	if(formats)
+		for(j = 0; j < num_columns; j++)
+			XLALFree((char *) formats[j].ilwd_char_prefix);
+	XLALFree(formats);
+	XLALFree(strides);
+	if(errnum)
+		XLAL_ERROR(errnum);
+	return 0;
+}
+
+
 /**
  * Write a process table to an XML file.
  */
@@ -343,6 +1277,27 @@ int XLALWriteLIGOLwXMLSearchSummaryTable(
 }
 
 
+static const struct column_format sngl_burst_columns[] = {
+	{"process:process_id", KIND_LONG, "process:process_id:", offsetof(SnglBurst, process_id)},
+	{"sngl_burst:ifo", KIND_CHAR_ARRAY, NULL, offsetof(SnglBurst, ifo)},
+	{"sngl_burst:search", KIND_CHAR_ARRAY, NULL, offsetof(SnglBurst, search)},
+	{"sngl_burst:channel", KIND_CHAR_ARRAY, NULL, offsetof(SnglBurst, channel)},
+	{"sngl_burst:start_time", KIND_INT_4S, NULL, offsetof(SnglBurst, start_time.gpsSeconds)},
+	{"sngl_burst:start_time_ns", KIND_INT_4S, NULL, offsetof(SnglBurst, start_time.gpsNanoSeconds)},
+	{"sngl_burst:peak_time", KIND_INT_4S, NULL, offsetof(SnglBurst, peak_time.gpsSeconds)},
+	{"sngl_burst:peak_time_ns", KIND_INT_4S, NULL, offsetof(SnglBurst, peak_time.gpsNanoSeconds)},
+	{"sngl_burst:duration", KIND_REAL_4, NULL, offsetof(SnglBurst, duration)},
+	{"sngl_burst:central_freq", KIND_REAL_4, NULL, offsetof(SnglBurst, central_freq)},
+	{"sngl_burst:bandwidth", KIND_REAL_4, NULL, offsetof(SnglBurst, bandwidth)},
+	{"sngl_burst:amplitude", KIND_REAL_4, NULL, offsetof(SnglBurst, amplitude)},
+	{"sngl_burst:snr", KIND_REAL_4, NULL, offsetof(SnglBurst, snr)},
+	{"sngl_burst:confidence", KIND_REAL_4, NULL, offsetof(SnglBurst, confidence)},
+	{"sngl_burst:chisq", KIND_REAL_8, NULL, offsetof(SnglBurst, chisq)},
+	{"sngl_burst:chisq_dof", KIND_REAL_8, NULL, offsetof(SnglBurst, chisq_dof)},
+	{"sngl_burst:event_id", KIND_LONG, "sngl_burst:event_id:", offsetof(SnglBurst, event_id)},
+};
+
+
 /**
  * Write a sngl_burst table to an XML file.
  */
@@ -353,243 +1308,116 @@ int XLALWriteLIGOLwXMLSnglBurstTable(
 	const SnglBurst *sngl_burst
 )
 {
-	const char *row_head = "\n\t\t\t";
-
-	if(xml->table != no_table) {
-		XLALPrintError("a table is still open");
-		XLAL_ERROR(XLAL_EFAILED);
-	}
-
-	/* table header */
-
-	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"sngl_burst:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:ifo\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:search\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:channel\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:start_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:peak_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:duration\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:central_freq\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:bandwidth\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:amplitude\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:snr\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:confidence\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:chisq_dof\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_burst:event_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"sngl_burst:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
-	if(XLALGetBaseErrno())
-		XLAL_ERROR(XLAL_EFUNC);
-
-	/* rows */
-
-	for(; sngl_burst; sngl_burst = sngl_burst->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\",%d,%d,%d,%d,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.16g,%.16g,\"sngl_burst:event_id:%ld\"",
-			row_head,
-			sngl_burst->process_id,
-			sngl_burst->ifo,
-			sngl_burst->search,
-			sngl_burst->channel,
-			sngl_burst->start_time.gpsSeconds,
-			sngl_burst->start_time.gpsNanoSeconds,
-			sngl_burst->peak_time.gpsSeconds,
-			sngl_burst->peak_time.gpsNanoSeconds,
-			sngl_burst->duration,
-			sngl_burst->central_freq,
-			sngl_burst->bandwidth,
-			sngl_burst->amplitude,
-			sngl_burst->snr,
-			sngl_burst->confidence,
-			sngl_burst->chisq,
-			sngl_burst->chisq_dof,
-			sngl_burst->event_id
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
-
-	/* table footer */
-
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(write_list_table(xml, "sngl_burst", sngl_burst_columns, XLAL_NUM_ELEM(sngl_burst_columns), sngl_burst, offsetof(SnglBurst, next)) < 0)
 		XLAL_ERROR(XLAL_EFUNC);
-
-	/* done */
-
 	return 0;
 }
 
+static const struct column_format sngl_inspiral_columns[] = {
+	{"process:process_id", KIND_LONG, "process:process_id:", offsetof(SnglInspiralTable, process_id)},
+	{"sngl_inspiral:ifo", KIND_CHAR_ARRAY, NULL, offsetof(SnglInspiralTable, ifo)},
+	{"sngl_inspiral:search", KIND_CHAR_ARRAY, NULL, offsetof(SnglInspiralTable, search)},
+	{"sngl_inspiral:channel", KIND_CHAR_ARRAY, NULL, offsetof(SnglInspiralTable, channel)},
+	{"sngl_inspiral:end_time", KIND_INT_4S, NULL, offsetof(SnglInspiralTable, end.gpsSeconds)},
+	{"sngl_inspiral:end_time_ns", KIND_INT_4S, NULL, offsetof(SnglInspiralTable, end.gpsNanoSeconds)},
+	{"sngl_inspiral:end_time_gmst", KIND_REAL_8, NULL, offsetof(SnglInspiralTable, end_time_gmst)},
+	{"sngl_inspiral:impulse_time", KIND_INT_4S, NULL, offsetof(SnglInspiralTable, impulse_time.gpsSeconds)},
+	{"sngl_inspiral:impulse_time_ns", KIND_INT_4S, NULL, offsetof(SnglInspiralTable, impulse_time.gpsNanoSeconds)},
+	{"sngl_inspiral:template_duration", KIND_REAL_8, NULL, offsetof(SnglInspiralTable, template_duration)},
+	{"sngl_inspiral:event_duration", KIND_REAL_8, NULL, offsetof(SnglInspiralTable, event_duration)},
+	{"sngl_inspiral:amplitude", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, amplitude)},
+	{"sngl_inspiral:eff_distance", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, eff_distance)},
+	{"sngl_inspiral:coa_phase", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, coa_phase)},
+	{"sngl_inspiral:mass1", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, mass1)},
+	{"sngl_inspiral:mass2", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, mass2)},
+	{"sngl_inspiral:mchirp", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, mchirp)},
+	{"sngl_inspiral:mtotal", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, mtotal)},
+	{"sngl_inspiral:eta", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, eta)},
+	{"sngl_inspiral:kappa", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, kappa)},
+	{"sngl_inspiral:chi", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, chi)},
+	{"sngl_inspiral:tau0", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, tau0)},
+	{"sngl_inspiral:tau2", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, tau2)},
+	{"sngl_inspiral:tau3", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, tau3)},
+	{"sngl_inspiral:tau4", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, tau4)},
+	{"sngl_inspiral:tau5", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, tau5)},
+	{"sngl_inspiral:ttotal", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, ttotal)},
+	{"sngl_inspiral:psi0", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, psi0)},
+	{"sngl_inspiral:psi3", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, psi3)},
+	{"sngl_inspiral:alpha", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, alpha)},
+	{"sngl_inspiral:alpha1", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, alpha1)},
+	{"sngl_inspiral:alpha2", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, alpha2)},
+	{"sngl_inspiral:alpha3", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, alpha3)},
+	{"sngl_inspiral:alpha4", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, alpha4)},
+	{"sngl_inspiral:alpha5", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, alpha5)},
+	{"sngl_inspiral:alpha6", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, alpha6)},
+	{"sngl_inspiral:beta", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, beta)},
+	{"sngl_inspiral:f_final", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, f_final)},
+	{"sngl_inspiral:snr", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, snr)},
+	{"sngl_inspiral:chisq", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, chisq)},
+	{"sngl_inspiral:chisq_dof", KIND_INT_4S, NULL, offsetof(SnglInspiralTable, chisq_dof)},
+	{"sngl_inspiral:bank_chisq", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, bank_chisq)},
+	{"sngl_inspiral:bank_chisq_dof", KIND_INT_4S, NULL, offsetof(SnglInspiralTable, bank_chisq_dof)},
+	{"sngl_inspiral:cont_chisq", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, cont_chisq)},
+	{"sngl_inspiral:cont_chisq_dof", KIND_INT_4S, NULL, offsetof(SnglInspiralTable, cont_chisq_dof)},
+	{"sngl_inspiral:sigmasq", KIND_REAL_8, NULL, offsetof(SnglInspiralTable, sigmasq)},
+	{"sngl_inspiral:rsqveto_duration", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, rsqveto_duration)},
+	{"sngl_inspiral:Gamma0", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[0])},
+	{"sngl_inspiral:Gamma1", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[1])},
+	{"sngl_inspiral:Gamma2", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[2])},
+	{"sngl_inspiral:Gamma3", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[3])},
+	{"sngl_inspiral:Gamma4", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[4])},
+	{"sngl_inspiral:Gamma5", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[5])},
+	{"sngl_inspiral:Gamma6", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[6])},
+	{"sngl_inspiral:Gamma7", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[7])},
+	{"sngl_inspiral:Gamma8", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[8])},
+	{"sngl_inspiral:Gamma9", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, Gamma[9])},
+	{"sngl_inspiral:spin1x", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, spin1x)},
+	{"sngl_inspiral:spin1y", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, spin1y)},
+	{"sngl_inspiral:spin1z", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, spin1z)},
+	{"sngl_inspiral:spin2x", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, spin2x)},
+	{"sngl_inspiral:spin2y", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, spin2y)},
+	{"sngl_inspiral:spin2z", KIND_REAL_4, NULL, offsetof(SnglInspiralTable, spin2z)},
+	{"sngl_inspiral:event_id", KIND_LONG, "sngl_inspiral:event_id:", offsetof(SnglInspiralTable, event_id)},
+};
+
+
 int XLALWriteLIGOLwXMLSnglInspiralTable(
 	LIGOLwXMLStream *xml,
 	const SnglInspiralTable *sngl_inspiral
 )
 {
-	const char *row_head = "\n\t\t\t";
-
-	if(xml->table != no_table) {
-		XLALPrintError("a table is still open");
-		XLAL_ERROR(XLAL_EFAILED);
-	}
-
-	/* table header */
-
-	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"sngl_inspiral:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:ifo\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:search\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:channel\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:end_time_gmst\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:impulse_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:impulse_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:template_duration\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:event_duration\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:amplitude\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:eff_distance\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:coa_phase\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mass1\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mass2\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mchirp\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:mtotal\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:eta\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:kappa\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chi\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau0\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau2\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau3\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau4\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:tau5\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:ttotal\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:psi0\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:psi3\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha1\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha2\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha3\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha4\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha5\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:alpha6\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:beta\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:f_final\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:snr\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chisq\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:bank_chisq\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:bank_chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:cont_chisq\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:cont_chisq_dof\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:sigmasq\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:rsqveto_duration\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma0\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma1\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma2\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma3\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma4\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma5\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma6\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma7\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma8\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:Gamma9\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1x\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1y\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin1z\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2x\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2y\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:spin2z\" Type=\"real_4\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sngl_inspiral:event_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"sngl_inspiral:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
-	if(XLALGetBaseErrno())
-		XLAL_ERROR(XLAL_EFUNC);
-
-	/* rows */
-
-	for(; sngl_inspiral; sngl_inspiral = sngl_inspiral->next) {
-		if(XLALFilePrintf(xml->fp,"%s\"process:process_id:%ld\",\"%s\",\"%s\",\"%s\",%d,%d,%.16g,%d,%d,%.16g,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%u,%.8g,%u,%.8g,%u,%.16g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,%.8g,\"sngl_inspiral:event_id:%ld\"",
-			   row_head,
-			   sngl_inspiral->process_id,
-			   sngl_inspiral->ifo,
-			   sngl_inspiral->search,
-			   sngl_inspiral->channel,
-			   sngl_inspiral->end.gpsSeconds,
-			   sngl_inspiral->end.gpsNanoSeconds,
-			   sngl_inspiral->end_time_gmst,
-			   sngl_inspiral->impulse_time.gpsSeconds,
-			   sngl_inspiral->impulse_time.gpsNanoSeconds,
-			   sngl_inspiral->template_duration,
-			   sngl_inspiral->event_duration,
-			   sngl_inspiral->amplitude,
-			   sngl_inspiral->eff_distance,
-			   sngl_inspiral->coa_phase,
-			   sngl_inspiral->mass1,
-			   sngl_inspiral->mass2,
-			   sngl_inspiral->mchirp,
-			   sngl_inspiral->mtotal,
-			   sngl_inspiral->eta,
-			   sngl_inspiral->kappa,
-			   sngl_inspiral->chi,
-			   sngl_inspiral->tau0,
-			   sngl_inspiral->tau2,
-			   sngl_inspiral->tau3,
-			   sngl_inspiral->tau4,
-			   sngl_inspiral->tau5,
-			   sngl_inspiral->ttotal,
-			   sngl_inspiral->psi0,
-			   sngl_inspiral->psi3,
-			   sngl_inspiral->alpha,
-			   sngl_inspiral->alpha1,
-			   sngl_inspiral->alpha2,
-			   sngl_inspiral->alpha3,
-			   sngl_inspiral->alpha4,
-			   sngl_inspiral->alpha5,
-			   sngl_inspiral->alpha6,
-			   sngl_inspiral->beta,
-			   sngl_inspiral->f_final,
-			   sngl_inspiral->snr,
-			   sngl_inspiral->chisq,
-			   sngl_inspiral->chisq_dof,
-			   sngl_inspiral->bank_chisq,
-			   sngl_inspiral->bank_chisq_dof,
-			   sngl_inspiral->cont_chisq,
-			   sngl_inspiral->cont_chisq_dof,
-			   sngl_inspiral->sigmasq,
-			   sngl_inspiral->rsqveto_duration,
-			   sngl_inspiral->Gamma[0],
-			   sngl_inspiral->Gamma[1],
-			   sngl_inspiral->Gamma[2],
-			   sngl_inspiral->Gamma[3],
-			   sngl_inspiral->Gamma[4],
-			   sngl_inspiral->Gamma[5],
-			   sngl_inspiral->Gamma[6],
-			   sngl_inspiral->Gamma[7],
-			   sngl_inspiral->Gamma[8],
-			   sngl_inspiral->Gamma[9],
-			   sngl_inspiral->spin1x,  
-			   sngl_inspiral->spin1y,
-			   sngl_inspiral->spin1z,
-			   sngl_inspiral->spin2x,
-			   sngl_inspiral->spin2y,
-			   sngl_inspiral->spin2z,
-			   sngl_inspiral->event_id ) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
-
-	/* table footer */
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
+	if(write_list_table(xml, "sngl_inspiral", sngl_inspiral_columns, XLAL_NUM_ELEM(sngl_inspiral_columns), sngl_inspiral, offsetof(SnglInspiralTable, next)) < 0)
 		XLAL_ERROR(XLAL_EFUNC);
-
-	/* done */
 	return 0;
 }
 
 
 
 
+static const struct column_format sim_burst_columns[] = {
+	{"process:process_id", KIND_LONG, "process:process_id:", offsetof(SimBurst, process_id)},
+	{"sim_burst:waveform", KIND_CHAR_ARRAY, NULL, offsetof(SimBurst, waveform)},
+	{"sim_burst:ra", KIND_REAL_8, NULL, offsetof(SimBurst, ra)},
+	{"sim_burst:dec", KIND_REAL_8, NULL, offsetof(SimBurst, dec)},
+	{"sim_burst:psi", KIND_REAL_8, NULL, offsetof(SimBurst, psi)},
+	{"sim_burst:time_geocent_gps", KIND_INT_4S, NULL, offsetof(SimBurst, time_geocent_gps.gpsSeconds)},
+	{"sim_burst:time_geocent_gps_ns", KIND_INT_4S, NULL, offsetof(SimBurst, time_geocent_gps.gpsNanoSeconds)},
+	{"sim_burst:time_geocent_gmst", KIND_REAL_8, NULL, offsetof(SimBurst, time_geocent_gmst)},
+	{"sim_burst:duration", KIND_REAL_8, NULL, offsetof(SimBurst, duration)},
+	{"sim_burst:frequency", KIND_REAL_8, NULL, offsetof(SimBurst, frequency)},
+	{"sim_burst:bandwidth", KIND_REAL_8, NULL, offsetof(SimBurst, bandwidth)},
+	{"sim_burst:q", KIND_REAL_8, NULL, offsetof(SimBurst, q)},
+	{"sim_burst:pol_ellipse_angle", KIND_REAL_8, NULL, offsetof(SimBurst, pol_ellipse_angle)},
+	{"sim_burst:pol_ellipse_e", KIND_REAL_8, NULL, offsetof(SimBurst, pol_ellipse_e)},
+	{"sim_burst:amplitude", KIND_REAL_8, NULL, offsetof(SimBurst, amplitude)},
+	{"sim_burst:hrss", KIND_REAL_8, NULL, offsetof(SimBurst, hrss)},
+	{"sim_burst:egw_over_rsquared", KIND_REAL_8, NULL, offsetof(SimBurst, egw_over_rsquared)},
+	{"sim_burst:waveform_number", KIND_ULONG, NULL, offsetof(SimBurst, waveform_number)},
+	{"time_slide:time_slide_id", KIND_LONG, "time_slide:time_slide_id:", offsetof(SimBurst, time_slide_id)},
+	{"sim_burst:simulation_id", KIND_LONG, "sim_burst:simulation_id:", offsetof(SimBurst, simulation_id)},
+};
+
+
 /**
  * Write a sim_burst table to an XML file.
  */
@@ -600,82 +1428,20 @@ int XLALWriteLIGOLwXMLSimBurstTable(
 	const SimBurst *sim_burst
 )
 {
-	const char *row_head = "\n\t\t\t";
-
-	if(xml->table != no_table) {
-		XLALPrintError("a table is still open");
-		XLAL_ERROR(XLAL_EFAILED);
-	}
-
-	/* table header */
-
-	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"sim_burst:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:waveform\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:ra\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:dec\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:psi\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gps\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gps_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:time_geocent_gmst\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:duration\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:frequency\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:bandwidth\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:q\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:pol_ellipse_angle\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:pol_ellipse_e\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:amplitude\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:hrss\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:egw_over_rsquared\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:waveform_number\" Type=\"int_8u\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide:time_slide_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"sim_burst:simulation_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"sim_burst:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
-	if(XLALGetBaseErrno())
+	if(write_list_table(xml, "sim_burst", sim_burst_columns, XLAL_NUM_ELEM(sim_burst_columns), sim_burst, offsetof(SimBurst, next)) < 0)
 		XLAL_ERROR(XLAL_EFUNC);
-
-	/* rows */
-
-	for(; sim_burst; sim_burst = sim_burst->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"%s\",%.16g,%.16g,%.16g,%d,%d,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%.16g,%lu,\"time_slide:time_slide_id:%ld\",\"sim_burst:simulation_id:%ld\"",
-			row_head,
-			sim_burst->process_id,
-			sim_burst->waveform,
-			sim_burst->ra,
-			sim_burst->dec,
-			sim_burst->psi,
-			sim_burst->time_geocent_gps.gpsSeconds,
-			sim_burst->time_geocent_gps.gpsNanoSeconds,
-			sim_burst->time_geocent_gmst,
-			sim_burst->duration,
-			sim_burst->frequency,
-			sim_burst->bandwidth,
-			sim_burst->q,
-			sim_burst->pol_ellipse_angle,
-			sim_burst->pol_ellipse_e,
-			sim_burst->amplitude,
-			sim_burst->hrss,
-			sim_burst->egw_over_rsquared,
-			sim_burst->waveform_number,
-			sim_burst->time_slide_id,
-			sim_burst->simulation_id
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
-
-	/* table footer */
-
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
-		XLAL_ERROR(XLAL_EFUNC);
-
-	/* done */
-
 	return 0;
 }
 
 
+static const struct column_format time_slide_columns[] = {
+	{"process:process_id", KIND_LONG, "process:process_id:", offsetof(TimeSlide, process_id)},
+	{"time_slide:time_slide_id", KIND_LONG, "time_slide:time_slide_id:", offsetof(TimeSlide, time_slide_id)},
+	{"time_slide:instrument", KIND_CHAR_ARRAY, NULL, offsetof(TimeSlide, instrument)},
+	{"time_slide:offset", KIND_REAL_8, NULL, offsetof(TimeSlide, offset)},
+};
+
+
 /**
  * Write a time_slide table to an XML file.
  */
@@ -686,50 +1452,25 @@ int XLALWriteLIGOLwXMLTimeSlideTable(
 	const TimeSlide *time_slide
 )
 {
-	const char *row_head = "\n\t\t\t";
-
-	if(xml->table != no_table) {
-		XLALPrintError("a table is still open");
-		XLAL_ERROR(XLAL_EFAILED);
-	}
-
-	/* table header */
-
-	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"time_slide:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide:time_slide_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide:instrument\" Type=\"lstring\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide:offset\" Type=\"real_8\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"time_slide:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
-	if(XLALGetBaseErrno())
+	if(write_list_table(xml, "time_slide", time_slide_columns, XLAL_NUM_ELEM(time_slide_columns), time_slide, offsetof(TimeSlide, next)) < 0)
 		XLAL_ERROR(XLAL_EFUNC);
-
-	/* rows */
-
-	for(; time_slide; time_slide = time_slide->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"process:process_id:%ld\",\"time_slide:time_slide_id:%ld\",\"%s\",%.16g",
-			row_head,
-			time_slide->process_id,
-			time_slide->time_slide_id,
-			time_slide->instrument,
-			time_slide->offset
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
-
-	/* table footer */
-
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
-		XLAL_ERROR(XLAL_EFUNC);
-
-	/* done */
-
 	return 0;
 }
 
 
+static const struct column_format segment_columns[] = {
+	{"segment:creator_db", KIND_INT_4S, NULL, offsetof(SegmentTable, creator_db)},
+	{"process:process_id", KIND_LONG, "process:process_id:", offsetof(SegmentTable, process_id)},
+	{"segment:segment_id", KIND_LONG, "segment:segment_id:", offsetof(SegmentTable, segment_id)},
+	{"segment:start_time", KIND_INT_4S, NULL, offsetof(SegmentTable, start_time.gpsSeconds)},
+	{"segment:start_time_ns", KIND_INT_4S, NULL, offsetof(SegmentTable, start_time.gpsNanoSeconds)},
+	{"segment:end_time", KIND_INT_4S, NULL, offsetof(SegmentTable, end_time.gpsSeconds)},
+	{"segment:end_time_ns", KIND_INT_4S, NULL, offsetof(SegmentTable, end_time.gpsNanoSeconds)},
+	{"segment_definer:segment_def_id", KIND_LONG, "segment_def:segment_def_id:", offsetof(SegmentTable, segment_def_id)},
+	{"segment:segment_def_cdb", KIND_INT_4S, NULL, offsetof(SegmentTable, segment_def_cdb)},
+};
+
+
 /**
  * Write a segment table to an XML file.
  */
@@ -739,100 +1480,24 @@ int XLALWriteLIGOLwXMLSegmentTable(
 	const SegmentTable *segment_table
 )
 {
-	const char *row_head = "\n\t\t\t";
-
-	if(xml->table != no_table) {
-		XLALPrintError("a table is still open");
-		XLAL_ERROR(XLAL_EFAILED);
-	}
-
-	/* table header */
-
-	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"segment:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:creator_db\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"process:process_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:segment_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:start_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:start_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:end_time\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:end_time_ns\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment_definer:segment_def_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"segment:segment_def_cdb\" Type=\"int_4s\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Stream Name=\"segment:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
-	if(XLALGetBaseErrno())
+	if(write_list_table(xml, "segment", segment_columns, XLAL_NUM_ELEM(segment_columns), segment_table, offsetof(SegmentTable, next)) < 0)
 		XLAL_ERROR(XLAL_EFUNC);
-
-	/* rows */
-
-	for(; segment_table; segment_table = segment_table->next) {
-		if(XLALFilePrintf(xml->fp, "%s%d,\"process:process_id:%ld\",\"segment:segment_id:%ld\",%d,%d,%d,%d,\"segment_def:segment_def_id:%ld\",%d",
-			row_head,
-			segment_table->creator_db,
-			segment_table->process_id,
-			segment_table->segment_id,
-			segment_table->start_time.gpsSeconds,
-			segment_table->start_time.gpsNanoSeconds,
-			segment_table->end_time.gpsSeconds,
-			segment_table->end_time.gpsNanoSeconds,
-			segment_table->segment_def_id,
-			segment_table->segment_def_cdb
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
-
-	/* table footer */
-
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
-		XLAL_ERROR(XLAL_EFUNC);
-
-	/* done */
-
 	return 0;
 }
 
+static const struct column_format time_slide_segment_map_columns[] = {
+	{"time_slide_segment_map:segment_def_id", KIND_LONG, "segment_def:segment_def_id:", offsetof(TimeSlideSegmentMapTable, segment_def_id)},
+	{"time_slide_segment_map:time_slide_id", KIND_LONG, "time_slide:time_slide_id:", offsetof(TimeSlideSegmentMapTable, time_slide_id)},
+};
+
+
 int XLALWriteLIGOLwXMLTimeSlideSegmentMapTable(
 	LIGOLwXMLStream *xml,
 	const TimeSlideSegmentMapTable *time_slide_seg_map
 )
 {
-	const char *row_head = "\n\t\t\t";
-
-	if(xml->table != no_table) {
-		XLALPrintError("a table is still open");
-		XLAL_ERROR(XLAL_EFAILED);
-	}
-
-	/* table header */
-
-	XLALClearErrno();
-	XLALFilePuts("\t<Table Name=\"time_slide_segment_map:table\">\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide_segment_map:segment_def_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-	XLALFilePuts("\t\t<Column Name=\"time_slide_segment_map:time_slide_id\" Type=\"ilwd:char\"/>\n", xml->fp);
-        XLALFilePuts("\t\t<Stream Name=\"time_slide_segment_map:table\" Type=\"Local\" Delimiter=\",\">", xml->fp);
-	if(XLALGetBaseErrno())
+	if(write_list_table(xml, "time_slide_segment_map", time_slide_segment_map_columns, XLAL_NUM_ELEM(time_slide_segment_map_columns), time_slide_seg_map, offsetof(TimeSlideSegmentMapTable, next)) < 0)
 		XLAL_ERROR(XLAL_EFUNC);
-
-	/* rows */
-
-	for(; time_slide_seg_map; time_slide_seg_map = time_slide_seg_map->next) {
-		if(XLALFilePrintf(xml->fp, "%s\"segment_def:segment_def_id:%ld\",\"time_slide:time_slide_id:%ld\"",
-			row_head,
-			time_slide_seg_map->segment_def_id,
-			time_slide_seg_map->time_slide_id
-		) < 0)
-			XLAL_ERROR(XLAL_EFUNC);
-		row_head = ",\n\t\t\t";
-	}
-
-	/* table footer */
-
-	if(XLALFilePuts("\n\t\t</Stream>\n\t</Table>\n", xml->fp) < 0)
-		XLAL_ERROR(XLAL_EFUNC);
-
-	/* done */
-
 	return 0;
 }
 
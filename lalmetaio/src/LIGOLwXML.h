@@ -132,6 +132,41 @@ int XLALWriteLIGOLwXMLTimeSlideSegmentMapTable(
 	const TimeSlideSegmentMapTable *time_slide_seg_map
 );
 
+/**
+ * Types of the columns written by XLALWriteLIGOLwXMLTableColumns(), and
+ * the C types in which they are stored.
+ */
+typedef enum tagLIGOLwXMLColumnType {
+	LIGOLW_XML_INT_4S,	/**< INT4 */
+	LIGOLW_XML_INT_4U,	/**< UINT4 */
+	LIGOLW_XML_INT_8S,	/**< INT8 */
+	LIGOLW_XML_INT_8U,	/**< UINT8 */
+	LIGOLW_XML_REAL_4,	/**< REAL4 */
+	LIGOLW_XML_REAL_8,	/**< REAL8 */
+	LIGOLW_XML_LSTRING,	/**< const char * */
+	LIGOLW_XML_ILWD_CHAR	/**< INT8, written as "table:column:ID" */
+} LIGOLwXMLColumnType;
+
+/**
+ * A column of a table to be written by XLALWriteLIGOLwXMLTableColumns().
+ */
+typedef struct tagLIGOLwXMLColumn {
+	const char *name;	/**< column name, "table:column" */
+	LIGOLwXMLColumnType type;	/**< column type */
+	const void *data;	/**< the value in the first row */
+	size_t stride;	/**< bytes between rows, or 0 if the values are adjacent */
+} LIGOLwXMLColumn;
+
+#ifndef SWIG   // exclude from SWIG interface
+int XLALWriteLIGOLwXMLTableColumns(
+	LIGOLwXMLStream *xml,
+	const char *table_name,
+	const LIGOLwXMLColumn *columns,
+	size_t num_columns,
+	size_t num_rows
+);
+#endif /* SWIG */
+
 int XLALCreateLIGODataFileName(
         char* filename,
         size_t size,
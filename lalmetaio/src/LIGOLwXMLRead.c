@@ -703,3 +703,534 @@ SearchSummaryTable *XLALSearchSummaryTableFromLIGOLw(
 
 	return head;
 }
+
+
+/*
+ * ============================================================================
+ *
+ *                        Streaming Columnar Table Reader
+ *
+ * ============================================================================
+ */
+
+
+/*
+ * Per-column state of a batch, not visible to the user.
+ */
+
+
+struct column_state {
+	int pos;		/* metaio column index, or < 0 if missing */
+	unsigned int metaio_type;	/* metaio type of the column */
+	char *ilwd_prefix;	/* required prefix of ilwd:char IDs, or NULL */
+	char *pool;		/* string data of all rows */
+	size_t pool_len;
+	size_t pool_size;
+	size_t *offsets;	/* offset of each row's string in pool */
+};
+
+
+struct batch_internal {
+	size_t capacity;
+	struct column_state *state;
+};
+
+
+/**
+ * Free a batch of rows returned by XLALLIGOLwTableColumnsFromLIGOLw().
+ */
+void XLALDestroyLIGOLwColumnBatch(LIGOLwColumnBatch *batch)
+{
+	if(batch) {
+		struct batch_internal *internal = batch->internal;
+		size_t i;
+		for(i = 0; i < batch->num_columns; i++) {
+			XLALFree(batch->columns[i].int_8s);
+			XLALFree(batch->columns[i].real_8);
+			XLALFree(batch->columns[i].lstring);
+			if(internal) {
+				XLALFree(internal->state[i].ilwd_prefix);
+				XLALFree(internal->state[i].pool);
+				XLALFree(internal->state[i].offsets);
+			}
+		}
+		if(internal)
+			XLALFree(internal->state);
+		XLALFree(internal);
+		XLALFree(batch->columns);
+		XLALFree(batch);
+	}
+}
+
+
+/*
+ * Resize the column arrays of a batch to hold capacity rows.
+ */
+
+
+static int batch_resize(LIGOLwColumnBatch *batch, size_t capacity)
+{
+	struct batch_internal *internal = batch->internal;
+	size_t i;
+
+	for(i = 0; i < batch->num_columns; i++) {
+		LIGOLwColumn *column = &batch->columns[i];
+		struct column_state *state = &internal->state[i];
+		switch(column->type) {
+		case LIGOLW_COLUMN_INT: {
+			long long *int_8s = XLALRealloc(column->int_8s, capacity * sizeof(*int_8s));
+			if(!int_8s)
+				XLAL_ERROR(XLAL_ENOMEM);
+			column->int_8s = int_8s;
+			break;
+		}
+		case LIGOLW_COLUMN_REAL: {
+			double *real_8 = XLALRealloc(column->real_8, capacity * sizeof(*real_8));
+			if(!real_8)
+				XLAL_ERROR(XLAL_ENOMEM);
+			column->real_8 = real_8;
+			break;
+		}
+		case LIGOLW_COLUMN_STRING: {
+			char **lstring = XLALRealloc(column->lstring, capacity * sizeof(*lstring));
+			if(!lstring)
+				XLAL_ERROR(XLAL_ENOMEM);
+			column->lstring = lstring;
+			size_t *offsets = XLALRealloc(state->offsets, capacity * sizeof(*offsets));
+			if(!offsets)
+				XLAL_ERROR(XLAL_ENOMEM);
+			state->offsets = offsets;
+			break;
+		}
+		default:
+			break;
+		}
+	}
+
+	internal->capacity = capacity;
+	return 0;
+}
+
+
+/*
+ * Create a batch for the requested columns of the table which env has
+ * open.
+ */
+
+
+static LIGOLwColumnBatch *batch_new(struct MetaioParseEnvironment *env, const char *table_name, const LIGOLwColumnSpec *columns, size_t num_columns, size_t capacity)
+{
+	LIGOLwColumnBatch *batch = XLALCalloc(1, sizeof(*batch));
+	struct batch_internal *internal = XLALCalloc(1, sizeof(*internal));
+	size_t i;
+
+	if(batch)
+		batch->internal = internal;
+	if(!batch || !internal) {
+		XLALDestroyLIGOLwColumnBatch(batch);
+		XLALFree(internal);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+	batch->num_columns = num_columns;
+	batch->columns = XLALCalloc(num_columns ? num_columns : 1, sizeof(*batch->columns));
+	internal->state = XLALCalloc(num_columns ? num_columns : 1, sizeof(*internal->state));
+	if(!batch->columns || !internal->state) {
+		batch->num_columns = 0;
+		XLALDestroyLIGOLwColumnBatch(batch);
+		XLAL_ERROR_NULL(XLAL_ENOMEM);
+	}
+
+	for(i = 0; i < num_columns; i++) {
+		LIGOLwColumn *column = &batch->columns[i];
+		struct column_state *state = &internal->state[i];
+
+		column->name = columns[i].name;
+		state->pos = XLALLIGOLwFindColumn(env, columns[i].name, columns[i].type, columns[i].required);
+		if(state->pos < 0) {
+			if(columns[i].required || xlalErrno) {
+				XLALDestroyLIGOLwColumnBatch(batch);
+				XLALPrintError("%s(): failure reading %s table\n", __func__, table_name);
+				XLAL_ERROR_NULL(XLAL_EFUNC);
+			}
+			column->type = LIGOLW_COLUMN_MISSING;
+			continue;
+		}
+
+		state->metaio_type = env->ligo_lw.table.col[state->pos].data_type;
+		switch(state->metaio_type) {
+		case METAIO_TYPE_INT_2S:
+		case METAIO_TYPE_INT_2U:
+		case METAIO_TYPE_INT_4S:
+		case METAIO_TYPE_INT_4U:
+		case METAIO_TYPE_INT_8S:
+		case METAIO_TYPE_INT_8U:
+			column->type = LIGOLW_COLUMN_INT;
+			break;
+		case METAIO_TYPE_ILWD_CHAR:
+			column->type = LIGOLW_COLUMN_INT;
+			if(columns[i].ilwd_char_table_name) {
+				/* IDs must be "table_name:column_name:integer" */
+				state->ilwd_prefix = XLALMalloc(strlen(columns[i].ilwd_char_table_name) + strlen(columns[i].name) + 3);
+				if(!state->ilwd_prefix) {
+					XLALDestroyLIGOLwColumnBatch(batch);
+					XLAL_ERROR_NULL(XLAL_ENOMEM);
+				}
+				sprintf(state->ilwd_prefix, "%s:%s:", columns[i].ilwd_char_table_name, columns[i].name);
+			}
+			break;
+		case METAIO_TYPE_REAL_4:
+		case METAIO_TYPE_REAL_8:
+			column->type = LIGOLW_COLUMN_REAL;
+			break;
+		case METAIO_TYPE_LSTRING:
+		case METAIO_TYPE_CHAR_S:
+		case METAIO_TYPE_CHAR_V:
+			column->type = LIGOLW_COLUMN_STRING;
+			break;
+		default:
+			XLALDestroyLIGOLwColumnBatch(batch);
+			XLALPrintError("%s(): column \"%s\" of %s table has unsupported type\n", __func__, columns[i].name, table_name);
+			XLAL_ERROR_NULL(XLAL_EDATA);
+		}
+	}
+
+	if(batch_resize(batch, capacity) < 0) {
+		XLALDestroyLIGOLwColumnBatch(batch);
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	}
+
+	return batch;
+}
+
+
+/*
+ * Parse the integer part of an ilwd:char ID.
+ */
+
+
+static int parse_ilwd_char(const char *ilwd_char, const char *prefix, const char *column_name, long long *id)
+{
+	const char *s = ilwd_char;
+	char *end;
+
+	if(prefix) {
+		size_t len = strlen(prefix);
+		if(strncmp(s, prefix, len))
+			goto invalid;
+		s += len;
+	} else {
+		/* skip "table_name:column_name:" */
+		if(!(s = strchr(s, ':')) || !(s = strchr(s + 1, ':')))
+			goto invalid;
+		s++;
+	}
+	*id = strtoll(s, &end, 10);
+	if(end == s)
+		goto invalid;
+	return 0;
+
+invalid:
+	XLALPrintError("%s(): invalid %s \"%s\"\n", __func__, column_name, ilwd_char);
+	XLAL_ERROR(XLAL_EDATA);
+}
+
+
+/*
+ * Copy the current row of the table which env has open into row
+ * batch->length of a batch; the row is not added to the batch until
+ * batch->length is incremented.
+ */
+
+
+static int batch_parse_row(LIGOLwColumnBatch *batch, const struct MetaioParseEnvironment *env)
+{
+	struct batch_internal *internal = batch->internal;
+	const size_t row = batch->length;
+	size_t i;
+
+	for(i = 0; i < batch->num_columns; i++) {
+		LIGOLwColumn *column = &batch->columns[i];
+		struct column_state *state = &internal->state[i];
+		const struct MetaioRowElement *elt;
+
+		if(column->type == LIGOLW_COLUMN_MISSING)
+			continue;
+		elt = &env->ligo_lw.table.elt[state->pos];
+
+		switch(state->metaio_type) {
+		case METAIO_TYPE_INT_2S:
+			column->int_8s[row] = elt->data.int_2s;
+			break;
+		case METAIO_TYPE_INT_2U:
+			column->int_8s[row] = elt->data.int_2u;
+			break;
+		case METAIO_TYPE_INT_4S:
+			column->int_8s[row] = elt->data.int_4s;
+			break;
+		case METAIO_TYPE_INT_4U:
+			column->int_8s[row] = elt->data.int_4u;
+			break;
+		case METAIO_TYPE_INT_8S:
+			column->int_8s[row] = elt->data.int_8s;
+			break;
+		case METAIO_TYPE_INT_8U:
+			column->int_8s[row] = elt->data.int_8u;
+			break;
+		case METAIO_TYPE_ILWD_CHAR:
+			if(parse_ilwd_char(elt->data.lstring.data, state->ilwd_prefix, column->name, &column->int_8s[row]) < 0)
+				XLAL_ERROR(XLAL_EFUNC);
+			break;
+		case METAIO_TYPE_REAL_4:
+			column->real_8[row] = elt->data.real_4;
+			break;
+		case METAIO_TYPE_REAL_8:
+			column->real_8[row] = elt->data.real_8;
+			break;
+		default: {
+			/* string:  append to the column's string pool */
+			const char *s = elt->data.lstring.data ? elt->data.lstring.data : "";
+			const size_t len = strlen(s) + 1;
+			if(state->pool_len + len > state->pool_size) {
+				size_t pool_size = 2 * state->pool_size + len + 256;
+				char *pool = XLALRealloc(state->pool, pool_size);
+				if(!pool)
+					XLAL_ERROR(XLAL_ENOMEM);
+				state->pool = pool;
+				state->pool_size = pool_size;
+			}
+			memcpy(state->pool + state->pool_len, s, len);
+			state->offsets[row] = state->pool_len;
+			state->pool_len += len;
+			/* valid until the pool is next resized;  fixed up by
+			 * batch_finish() */
+			column->lstring[row] = state->pool + state->offsets[row];
+			break;
+		}
+		}
+	}
+
+	return 0;
+}
+
+
+/*
+ * Discard row batch->length of a batch, which was parsed but not added.
+ */
+
+
+static void batch_discard_row(LIGOLwColumnBatch *batch)
+{
+	struct batch_internal *internal = batch->internal;
+	size_t i;
+
+	for(i = 0; i < batch->num_columns; i++)
+		if(batch->columns[i].type == LIGOLW_COLUMN_STRING)
+			internal->state[i].pool_len = internal->state[i].offsets[batch->length];
+}
+
+
+/*
+ * Point the string arrays of a batch into the (possibly moved) string
+ * pools.
+ */
+
+
+static void batch_finish(LIGOLwColumnBatch *batch)
+{
+	struct batch_internal *internal = batch->internal;
+	size_t i, j;
+
+	for(i = 0; i < batch->num_columns; i++)
+		if(batch->columns[i].type == LIGOLW_COLUMN_STRING)
+			for(j = 0; j < batch->length; j++)
+				batch->columns[i].lstring[j] = internal->state[i].pool + internal->state[i].offsets[j];
+}
+
+
+/*
+ * Empty a batch so that it can be reused for the next rows.
+ */
+
+
+static void batch_reset(LIGOLwColumnBatch *batch)
+{
+	struct batch_internal *internal = batch->internal;
+	size_t i;
+
+	batch->first_row += batch->length;
+	batch->length = 0;
+	for(i = 0; i < batch->num_columns; i++)
+		internal->state[i].pool_len = 0;
+}
+
+
+/*
+ * Common implementation of XLALLIGOLwReadTableColumns() and
+ * XLALLIGOLwTableColumnsFromLIGOLw().  If result is not NULL, all rows are
+ * read into a single batch which is returned in *result.
+ */
+
+
+static int read_table_columns(const char *filename, const char *table_name, const LIGOLwColumnSpec *columns, size_t num_columns, size_t batch_size, LIGOLwRowPredicate predicate, void *predicate_data, LIGOLwBatchCallback callback, void *callback_data, LIGOLwColumnBatch **result)
+{
+	struct MetaioParseEnvironment env;
+	LIGOLwColumnBatch *batch;
+	int miostatus;
+	int stop = 0;
+
+	/* open the file and find table */
+
+	if(MetaioOpenFile(&env, filename)) {
+		XLALPrintError("%s(): error opening \"%s\": %s\n", __func__, filename, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
+		XLAL_ERROR(XLAL_EIO);
+	}
+	if(MetaioOpenTableOnly(&env, table_name)) {
+		MetaioAbort(&env);
+		XLALPrintError("%s(): cannot find %s table: %s\n", __func__, table_name, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
+		XLAL_ERROR(XLAL_EIO);
+	}
+
+	/* find columns */
+
+	XLALClearErrno();
+	batch = batch_new(&env, table_name, columns, num_columns, batch_size ? batch_size : 1024);
+	if(!batch) {
+		MetaioAbort(&env);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+
+	/* loop over the rows in the file */
+
+	while(!stop && (miostatus = MetaioGetRow(&env)) > 0) {
+		struct batch_internal *internal = batch->internal;
+		int keep = 1;
+
+		/* make room for the row, passing on a full batch or
+		 * growing the batch */
+
+		if(batch->length == internal->capacity) {
+			if(batch_size) {
+				batch_finish(batch);
+				stop = callback(batch, callback_data);
+				if(stop < 0) {
+					XLALDestroyLIGOLwColumnBatch(batch);
+					MetaioAbort(&env);
+					XLAL_ERROR(XLAL_EFUNC);
+				}
+				batch_reset(batch);
+				if(stop)
+					break;
+			} else if(batch_resize(batch, 2 * internal->capacity) < 0) {
+				XLALDestroyLIGOLwColumnBatch(batch);
+				MetaioAbort(&env);
+				XLAL_ERROR(XLAL_EFUNC);
+			}
+		}
+
+		/* parse the row, and keep it if it satisfies the predicate */
+
+		if(batch_parse_row(batch, &env) < 0 || (predicate && (keep = predicate(batch, batch->length, predicate_data)) < 0)) {
+			XLALDestroyLIGOLwColumnBatch(batch);
+			MetaioAbort(&env);
+			XLALPrintError("%s(): failure reading %s table\n", __func__, table_name);
+			XLAL_ERROR(XLAL_EFUNC);
+		}
+		if(keep)
+			batch->length++;
+		else
+			batch_discard_row(batch);
+	}
+	if(!stop && miostatus < 0) {
+		XLALDestroyLIGOLwColumnBatch(batch);
+		MetaioAbort(&env);
+		XLALPrintError("%s(): I/O error parsing %s table: %s\n", __func__, table_name, env.mierrmsg.data ? env.mierrmsg.data : "unknown reason");
+		XLAL_ERROR(XLAL_EIO);
+	}
+
+	/* stop parsing the document;  the remainder of the document after
+	 * the table is not read */
+
+	MetaioAbort(&env);
+
+	/* pass on or return the last batch */
+
+	batch_finish(batch);
+	if(result) {
+		*result = batch;
+		return 0;
+	}
+	if(!stop && batch->length && callback(batch, callback_data) < 0) {
+		XLALDestroyLIGOLwColumnBatch(batch);
+		XLAL_ERROR(XLAL_EFUNC);
+	}
+	XLALDestroyLIGOLwColumnBatch(batch);
+
+	return 0;
+}
+
+
+/**
+ * Read the requested columns of a table from a LIGO Light Weight XML file,
+ * in batches of up to \a batch_size rows stored as one array per column.
+ *
+ * The table's rows are parsed as the file is read, and are never stored as
+ * one structure per row.  Only the \a num_columns columns described by
+ * \a columns are stored, in that order; integer and ilwd:char columns are
+ * stored as integers, floating-point columns as doubles, and string columns
+ * as strings.  If \a predicate is not NULL, it is called for each row after
+ * it is parsed into the batch, and the row is kept only if it returns
+ * non-zero;  the predicate may only examine that row of the batch.
+ *
+ * Each time \a batch_size rows have been kept, and once at the end of the
+ * table if any rows remain, \a callback is called with the batch;  the batch
+ * and its data are only valid until \a callback returns.  If \a callback
+ * returns > 0 then reading stops, and the function succeeds.  The part of
+ * the document after the table is not parsed, and so is not checked for
+ * errors.
+ *
+ * Returns 0 on success, or < 0 on failure.
+ */
+int XLALLIGOLwReadTableColumns(
+	const char *filename,
+	const char *table_name,
+	const LIGOLwColumnSpec *columns,
+	size_t num_columns,
+	size_t batch_size,
+	LIGOLwRowPredicate predicate,
+	void *predicate_data,
+	LIGOLwBatchCallback callback,
+	void *callback_data
+)
+{
+	if(!filename || !table_name || (num_columns && !columns) || !callback)
+		XLAL_ERROR(XLAL_EFAULT);
+	if(!batch_size)
+		XLAL_ERROR(XLAL_EINVAL, "batch size must be positive");
+	if(read_table_columns(filename, table_name, columns, num_columns, batch_size, predicate, predicate_data, callback, callback_data, NULL) < 0)
+		XLAL_ERROR(XLAL_EFUNC);
+	return 0;
+}
+
+
+/**
+ * Read the requested columns of all rows of a table from a LIGO Light
+ * Weight XML file into a single batch, as for XLALLIGOLwReadTableColumns().
+ * The batch must be freed with XLALDestroyLIGOLwColumnBatch().  Returns
+ * NULL on failure.
+ */
+LIGOLwColumnBatch *XLALLIGOLwTableColumnsFromLIGOLw(
+	const char *filename,
+	const char *table_name,
+	const LIGOLwColumnSpec *columns,
+	size_t num_columns,
+	LIGOLwRowPredicate predicate,
+	void *predicate_data
+)
+{
+	LIGOLwColumnBatch *batch = NULL;
+	if(!filename || !table_name || (num_columns && !columns))
+		XLAL_ERROR_NULL(XLAL_EFAULT);
+	if(read_table_columns(filename, table_name, columns, num_columns, 0, predicate, predicate_data, NULL, NULL, &batch) < 0)
+		XLAL_ERROR_NULL(XLAL_EFUNC);
+	return batch;
+}
@@ -76,6 +76,99 @@ XLALLIGOLwHasTable(
     const char *table_name
 );
 
+
+/**
+ * Storage type of a column read by XLALLIGOLwReadTableColumns().
+ */
+typedef enum tagLIGOLwColumnType {
+	LIGOLW_COLUMN_MISSING,	/**< optional column which is not in the table; no data */
+	LIGOLW_COLUMN_INT,	/**< integer column, or integer part of an ilwd:char column; data in \c int_8s */
+	LIGOLW_COLUMN_REAL,	/**< floating-point column; data in \c real_8 */
+	LIGOLW_COLUMN_STRING	/**< string column; data in \c lstring */
+} LIGOLwColumnType;
+
+
+/**
+ * Description of a column to be read by XLALLIGOLwReadTableColumns().
+ */
+typedef struct tagLIGOLwColumnSpec {
+	const char *name;	/**< name of the column */
+	unsigned int type;	/**< required metaio type of the column, or METAIO_TYPE_UNKNOWN for any type */
+	int required;		/**< if non-zero, it is an error for the column to be missing */
+	const char *ilwd_char_table_name;	/**< for ilwd:char columns, if not NULL, the table name which the IDs must have */
+} LIGOLwColumnSpec;
+
+
+/**
+ * The data of one column of a batch of rows, in an array with one element
+ * per row.  Only the array corresponding to the column's type is set.
+ */
+typedef struct tagLIGOLwColumn {
+	const char *name;	/**< name of the column */
+	LIGOLwColumnType type;	/**< storage type of the column */
+	long long *int_8s;	/**< data of an integer or ilwd:char column */
+	double *real_8;		/**< data of a floating-point column */
+	char **lstring;		/**< data of a string column */
+} LIGOLwColumn;
+
+
+/**
+ * A batch of rows of a table, stored as one array per column
+ * (struct-of-arrays), in the order the columns were requested.
+ */
+typedef struct tagLIGOLwColumnBatch {
+	size_t length;		/**< number of rows in the batch */
+	size_t first_row;	/**< index of the first row of the batch among all rows accepted so far */
+	size_t num_columns;	/**< number of columns */
+	LIGOLwColumn *columns;	/**< columns */
+	void *internal;		/**< internal storage */
+} LIGOLwColumnBatch;
+
+
+/**
+ * Row predicate for XLALLIGOLwReadTableColumns(): return non-zero to keep
+ * row \a row of \a batch, zero to discard it, or < 0 on error.
+ */
+typedef int (*LIGOLwRowPredicate)(const LIGOLwColumnBatch *batch, size_t row, void *data);
+
+
+/**
+ * Batch callback for XLALLIGOLwReadTableColumns(): return 0 to continue
+ * reading, > 0 to stop reading without error, or < 0 on error.
+ */
+typedef int (*LIGOLwBatchCallback)(const LIGOLwColumnBatch *batch, void *data);
+
+
+#ifndef SWIG   // exclude from SWIG interface
+int
+XLALLIGOLwReadTableColumns(
+	const char *filename,
+	const char *table_name,
+	const LIGOLwColumnSpec *columns,
+	size_t num_columns,
+	size_t batch_size,
+	LIGOLwRowPredicate predicate,
+	void *predicate_data,
+	LIGOLwBatchCallback callback,
+	void *callback_data
+);
+#endif   // SWIG
+
+LIGOLwColumnBatch *
+XLALLIGOLwTableColumnsFromLIGOLw(
+	const char *filename,
+	const char *table_name,
+	const LIGOLwColumnSpec *columns,
+	size_t num_columns,
+	LIGOLwRowPredicate predicate,
+	void *predicate_data
+);
+
+void
+XLALDestroyLIGOLwColumnBatch(
+	LIGOLwColumnBatch *batch
+);
+
 ProcessTable *
 XLALProcessTableFromLIGOLw (
     const char *filename
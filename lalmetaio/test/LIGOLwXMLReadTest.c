@@ -0,0 +1,308 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests that the columnar table reader in LIGOLwXMLRead.c returns the same
+ * rows as the row-by-row readers, both for whole tables and for windowed
+ * and batched reads.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <metaio.h>
+#include <lal/LALStdlib.h>
+#include <lal/Date.h>
+#include <lal/LIGOMetadataTables.h>
+#include <lal/LIGOMetadataUtils.h>
+#include <lal/LIGOLwXML.h>
+#include <lal/LIGOLwXMLRead.h>
+
+#define FILENAME "LIGOLwXMLReadTest.xml"
+#define NSEARCH 7
+#define NSLIDE 23
+#define BATCH 5
+
+static const LIGOLwColumnSpec search_summary_columns[] = {
+	{"process_id", METAIO_TYPE_ILWD_CHAR, 1, "process"},
+	{"comment", METAIO_TYPE_LSTRING, 1, NULL},
+	{"ifos", METAIO_TYPE_LSTRING, 1, NULL},
+	{"in_start_time", METAIO_TYPE_INT_4S, 1, NULL},
+	{"in_start_time_ns", METAIO_TYPE_INT_4S, 1, NULL},
+	{"in_end_time", METAIO_TYPE_INT_4S, 1, NULL},
+	{"in_end_time_ns", METAIO_TYPE_INT_4S, 1, NULL},
+	{"out_start_time", METAIO_TYPE_INT_4S, 1, NULL},
+	{"out_start_time_ns", METAIO_TYPE_INT_4S, 1, NULL},
+	{"out_end_time", METAIO_TYPE_INT_4S, 1, NULL},
+	{"out_end_time_ns", METAIO_TYPE_INT_4S, 1, NULL},
+	{"nevents", METAIO_TYPE_INT_4S, 1, NULL},
+	{"nnodes", METAIO_TYPE_INT_4S, 1, NULL},
+	{"no_such_column", METAIO_TYPE_UNKNOWN, 0, NULL}
+};
+
+static const LIGOLwColumnSpec time_slide_columns[] = {
+	{"time_slide_id", METAIO_TYPE_ILWD_CHAR, 1, "time_slide"},
+	{"process_id", METAIO_TYPE_ILWD_CHAR, 1, "process"},
+	{"instrument", METAIO_TYPE_LSTRING, 1, NULL},
+	{"offset", METAIO_TYPE_REAL_8, 1, NULL}
+};
+
+#define NCOLUMNS(columns) (sizeof(columns) / sizeof(*(columns)))
+
+
+/*
+ * Write a document containing a search_summary table and a time_slide
+ * table.
+ */
+
+static int write_document(SearchSummaryTable **search_summary, TimeSlide **time_slide)
+{
+	SearchSummaryTable **next_search = search_summary;
+	TimeSlide **next_slide = time_slide;
+	LIGOLwXMLStream *xml;
+	int i;
+
+	for(i = 0; i < NSEARCH; i++) {
+		SearchSummaryTable *row = XLALCreateSearchSummaryTableRow(NULL);
+		XLAL_CHECK(row, XLAL_EFUNC);
+		*next_search = row;
+		next_search = &row->next;
+		row->process_id = 3 * i;
+		snprintf(row->comment, sizeof(row->comment), "search %d", i);
+		snprintf(row->ifos, sizeof(row->ifos), i % 2 ? "H1,L1" : "V1");
+		XLALGPSSet(&row->in_start_time, 1000000000 + 100 * i, 1);
+		XLALGPSSet(&row->in_end_time, 1000000100 + 100 * i, 999999999);
+		XLALGPSSet(&row->out_start_time, 1000000008 + 100 * i, 0);
+		XLALGPSSet(&row->out_end_time, 1000000092 + 100 * i, 500000000);
+		row->nevents = -i;
+		row->nnodes = i + 1;
+	}
+
+	for(i = 0; i < NSLIDE; i++) {
+		TimeSlide *row = XLALCreateTimeSlide();
+		XLAL_CHECK(row, XLAL_EFUNC);
+		*next_slide = row;
+		next_slide = &row->next;
+		row->process_id = i % 3;
+		row->time_slide_id = i / 2;
+		snprintf(row->instrument, sizeof(row->instrument), i % 2 ? "L1" : "H1");
+		row->offset = (i - NSLIDE / 2) * 0.1 / 3.0;
+	}
+
+	xml = XLALOpenLIGOLwXMLFile(FILENAME);
+	XLAL_CHECK(xml, XLAL_EFUNC);
+	XLAL_CHECK(XLALWriteLIGOLwXMLSearchSummaryTable(xml, *search_summary) == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALWriteLIGOLwXMLTimeSlideTable(xml, *time_slide) == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALCloseLIGOLwXMLFile(xml) == 0, XLAL_EFUNC);
+
+	return 0;
+}
+
+
+/*
+ * Check that row j of a time_slide batch matches a row read by
+ * XLALTimeSlideTableFromLIGOLw().
+ */
+
+static int check_time_slide_row(const LIGOLwColumnBatch *batch, size_t j, const TimeSlide *row)
+{
+	XLAL_CHECK(batch->columns[0].int_8s[j] == row->time_slide_id, XLAL_EFAILED, "time_slide_id mismatch in row %zu", j);
+	XLAL_CHECK(batch->columns[1].int_8s[j] == row->process_id, XLAL_EFAILED, "process_id mismatch in row %zu", j);
+	XLAL_CHECK(strcmp(batch->columns[2].lstring[j], row->instrument) == 0, XLAL_EFAILED, "instrument mismatch in row %zu", j);
+	XLAL_CHECK(batch->columns[3].real_8[j] == row->offset, XLAL_EFAILED, "offset mismatch in row %zu", j);
+	return 0;
+}
+
+
+/*
+ * The whole search_summary table, read both ways, must agree with what was
+ * written.
+ */
+
+static int test_search_summary(const SearchSummaryTable *written)
+{
+	SearchSummaryTable *rows = XLALSearchSummaryTableFromLIGOLw(FILENAME);
+	LIGOLwColumnBatch *batch = XLALLIGOLwTableColumnsFromLIGOLw(FILENAME, "search_summary", search_summary_columns, NCOLUMNS(search_summary_columns), NULL, NULL);
+	const SearchSummaryTable *row;
+	size_t j;
+
+	XLAL_CHECK(rows, XLAL_EFUNC);
+	XLAL_CHECK(batch, XLAL_EFUNC);
+	XLAL_CHECK(batch->length == NSEARCH && batch->first_row == 0, XLAL_EFAILED);
+	XLAL_CHECK(batch->num_columns == NCOLUMNS(search_summary_columns), XLAL_EFAILED);
+	XLAL_CHECK(batch->columns[13].type == LIGOLW_COLUMN_MISSING, XLAL_EFAILED);
+
+	for(j = 0, row = rows; row; j++, row = row->next, written = written->next) {
+		XLAL_CHECK(j < batch->length && written, XLAL_EFAILED, "row count mismatch");
+		XLAL_CHECK(row->process_id == written->process_id, XLAL_EFAILED);
+		XLAL_CHECK(strcmp(row->comment, written->comment) == 0, XLAL_EFAILED);
+		XLAL_CHECK(strcmp(row->ifos, written->ifos) == 0, XLAL_EFAILED);
+		XLAL_CHECK(XLALGPSCmp(&row->out_end_time, &written->out_end_time) == 0, XLAL_EFAILED);
+
+		XLAL_CHECK(batch->columns[0].int_8s[j] == row->process_id, XLAL_EFAILED, "process_id mismatch in row %zu", j);
+		XLAL_CHECK(strcmp(batch->columns[1].lstring[j], row->comment) == 0, XLAL_EFAILED, "comment mismatch in row %zu", j);
+		XLAL_CHECK(strcmp(batch->columns[2].lstring[j], row->ifos) == 0, XLAL_EFAILED, "ifos mismatch in row %zu", j);
+		XLAL_CHECK(batch->columns[3].int_8s[j] == row->in_start_time.gpsSeconds, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[4].int_8s[j] == row->in_start_time.gpsNanoSeconds, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[5].int_8s[j] == row->in_end_time.gpsSeconds, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[6].int_8s[j] == row->in_end_time.gpsNanoSeconds, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[7].int_8s[j] == row->out_start_time.gpsSeconds, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[8].int_8s[j] == row->out_start_time.gpsNanoSeconds, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[9].int_8s[j] == row->out_end_time.gpsSeconds, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[10].int_8s[j] == row->out_end_time.gpsNanoSeconds, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[11].int_8s[j] == row->nevents, XLAL_EFAILED);
+		XLAL_CHECK(batch->columns[12].int_8s[j] == row->nnodes, XLAL_EFAILED);
+	}
+	XLAL_CHECK(j == batch->length && !written, XLAL_EFAILED, "row count mismatch");
+
+	XLALDestroySearchSummaryTable(rows);
+	XLALDestroyLIGOLwColumnBatch(batch);
+	return 0;
+}
+
+
+/*
+ * Windowed read:  keep only the rows whose offset is in [lo, hi).
+ */
+
+struct window {
+	double lo, hi;
+};
+
+static int offset_in_window(const LIGOLwColumnBatch *batch, size_t row, void *data)
+{
+	const struct window *window = data;
+	const double offset = batch->columns[3].real_8[row];
+	return window->lo <= offset && offset < window->hi;
+}
+
+static int test_time_slide_window(const TimeSlide *rows)
+{
+	struct window window = {-0.1, 0.15};
+	LIGOLwColumnBatch *batch = XLALLIGOLwTableColumnsFromLIGOLw(FILENAME, "time_slide", time_slide_columns, NCOLUMNS(time_slide_columns), offset_in_window, &window);
+	size_t j = 0;
+
+	XLAL_CHECK(batch, XLAL_EFUNC);
+	for(; rows; rows = rows->next) {
+		if(!(window.lo <= rows->offset && rows->offset < window.hi))
+			continue;
+		XLAL_CHECK(j < batch->length, XLAL_EFAILED, "windowed read lost rows");
+		XLAL_CHECK(check_time_slide_row(batch, j, rows) == 0, XLAL_EFUNC);
+		j++;
+	}
+	XLAL_CHECK(j > 0 && j < NSLIDE, XLAL_EFAILED, "window does not exercise the predicate");
+	XLAL_CHECK(j == batch->length, XLAL_EFAILED, "windowed read kept %zu rows, expected %zu", batch->length, j);
+
+	XLALDestroyLIGOLwColumnBatch(batch);
+	return 0;
+}
+
+
+/*
+ * Batched read:  the batches must be the table's rows in order, split into
+ * batches of BATCH rows.
+ */
+
+struct batches {
+	const TimeSlide *next;
+	size_t rows;
+	size_t batches;
+	size_t stop_after;
+};
+
+static int check_batch(const LIGOLwColumnBatch *batch, void *data)
+{
+	struct batches *batches = data;
+	size_t j;
+
+	XLAL_CHECK(batch->first_row == batches->rows, XLAL_EFAILED, "batch starts at row %zu, expected %zu", batch->first_row, batches->rows);
+	XLAL_CHECK(batch->length > 0 && batch->length <= BATCH, XLAL_EFAILED);
+	for(j = 0; j < batch->length; j++, batches->next = batches->next->next) {
+		XLAL_CHECK(batches->next, XLAL_EFAILED, "batched read returned too many rows");
+		XLAL_CHECK(check_time_slide_row(batch, j, batches->next) == 0, XLAL_EFUNC);
+	}
+	batches->rows += batch->length;
+	batches->batches++;
+
+	return batches->batches == batches->stop_after;
+}
+
+static int test_time_slide_batches(const TimeSlide *rows)
+{
+	struct batches batches = {rows, 0, 0, 0};
+
+	/* all batches */
+	XLAL_CHECK(XLALLIGOLwReadTableColumns(FILENAME, "time_slide", time_slide_columns, NCOLUMNS(time_slide_columns), BATCH, NULL, NULL, check_batch, &batches) == 0, XLAL_EFUNC);
+	XLAL_CHECK(batches.rows == NSLIDE && !batches.next, XLAL_EFAILED, "batched read returned %zu rows", batches.rows);
+	XLAL_CHECK(batches.batches == (NSLIDE + BATCH - 1) / BATCH, XLAL_EFAILED);
+
+	/* stop early */
+	batches.next = rows;
+	batches.rows = batches.batches = 0;
+	batches.stop_after = 2;
+	XLAL_CHECK(XLALLIGOLwReadTableColumns(FILENAME, "time_slide", time_slide_columns, NCOLUMNS(time_slide_columns), BATCH, NULL, NULL, check_batch, &batches) == 0, XLAL_EFUNC);
+	XLAL_CHECK(batches.batches == 2 && batches.rows == 2 * BATCH, XLAL_EFAILED);
+
+	return 0;
+}
+
+
+int main(void)
+{
+	SearchSummaryTable *search_summary = NULL;
+	TimeSlide *time_slide = NULL;
+	TimeSlide *rows;
+	LIGOLwColumnBatch *batch;
+	size_t j;
+
+	XLAL_CHECK_MAIN(write_document(&search_summary, &time_slide) == 0, XLAL_EFUNC);
+
+	/* whole tables */
+	XLAL_CHECK_MAIN(test_search_summary(search_summary) == 0, XLAL_EFUNC);
+	rows = XLALTimeSlideTableFromLIGOLw(FILENAME);
+	XLAL_CHECK_MAIN(rows, XLAL_EFUNC);
+	batch = XLALLIGOLwTableColumnsFromLIGOLw(FILENAME, "time_slide", time_slide_columns, NCOLUMNS(time_slide_columns), NULL, NULL);
+	XLAL_CHECK_MAIN(batch, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(batch->length == NSLIDE, XLAL_EFAILED);
+	for(j = 0; j < batch->length; j++) {
+		const TimeSlide *row = rows;
+		size_t k;
+		for(k = 0; k < j; k++)
+			row = row->next;
+		XLAL_CHECK_MAIN(check_time_slide_row(batch, j, row) == 0, XLAL_EFUNC);
+	}
+	XLALDestroyLIGOLwColumnBatch(batch);
+
+	/* windowed and batched reads */
+	XLAL_CHECK_MAIN(test_time_slide_window(rows) == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_time_slide_batches(rows) == 0, XLAL_EFUNC);
+
+	/* a required column which is not in the table is an error */
+	{
+		static const LIGOLwColumnSpec missing[] = {{"no_such_column", METAIO_TYPE_UNKNOWN, 1, NULL}};
+		int errnum;
+		XLAL_TRY(batch = XLALLIGOLwTableColumnsFromLIGOLw(FILENAME, "time_slide", missing, 1, NULL, NULL), errnum);
+		XLAL_CHECK_MAIN(!batch && errnum, XLAL_EFAILED);
+	}
+
+	XLALDestroyTimeSlideTable(rows);
+	XLALDestroyTimeSlideTable(time_slide);
+	XLALDestroySearchSummaryTable(search_summary);
+	remove(FILENAME);
+
+	LALCheckMemoryLeaks();
+	return 0;
+}
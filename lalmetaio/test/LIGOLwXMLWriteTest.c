@@ -0,0 +1,289 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the number formatting and the buffered table writer in LIGOLwXML.c:
+ * every REAL8 and REAL4 must read back exactly with strtod() and strtof(),
+ * and tables large enough to pass through the writer thread must read back
+ * exactly with the table readers.
+ */
+
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <metaio.h>
+#include <lal/LIGOLwXMLRead.h>
+#include <lal/LIGOMetadataUtils.h>
+
+#include "../src/LIGOLwXML.c" /* Include source directly so we can test the static number formatting functions */
+
+#define FILENAME "LIGOLwXMLWriteTest.xml"
+#define NRANDOM 1000000
+#define NROWS 50000
+
+
+/*
+ * xorshift64 random bit patterns, so that the test is reproducible.
+ */
+
+static uint64_t random_state = UINT64_C(88172645463325252);
+
+static uint64_t random_bits(void)
+{
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 7;
+	random_state ^= random_state << 17;
+	return random_state;
+}
+
+static REAL8 random_real8(void)
+{
+	union {
+		uint64_t u;
+		REAL8 x;
+	} bits;
+	do
+		bits.u = random_bits();
+	while(!isfinite(bits.x));
+	return bits.x;
+}
+
+static REAL4 random_real4(void)
+{
+	union {
+		uint32_t u;
+		REAL4 x;
+	} bits;
+	do
+		bits.u = random_bits() >> 32;
+	while(!isfinite(bits.x));
+	return bits.x;
+}
+
+
+/*
+ * Format x, and check that the string is no longer than the longest %.17g
+ * (%.9g) string and reads back as the same bits.
+ */
+
+static int check_real8(REAL8 x)
+{
+	char s[64];
+	int n = format_real8(s, x);
+	REAL8 y;
+	XLAL_CHECK(n > 0 && n <= 24, XLAL_EFAILED, "%a formatted to %d characters", x, n);
+	s[n] = '\0';
+	y = strtod(s, NULL);
+	XLAL_CHECK(memcmp(&x, &y, sizeof(x)) == 0, XLAL_EFAILED, "%a formatted as \"%s\", which reads back as %a", x, s, y);
+	return 0;
+}
+
+static int check_real4(REAL4 x)
+{
+	char s[64];
+	int n = format_real4(s, x);
+	REAL4 y;
+	XLAL_CHECK(n > 0 && n <= 15, XLAL_EFAILED, "%a formatted to %d characters", (double) x, n);
+	s[n] = '\0';
+	y = strtof(s, NULL);
+	XLAL_CHECK(memcmp(&x, &y, sizeof(x)) == 0, XLAL_EFAILED, "%a formatted as \"%s\", which reads back as %a", (double) x, s, (double) y);
+	return 0;
+}
+
+
+static int test_format(void)
+{
+	const REAL8 special8[] = {0.0, -0.0, 1.0, -1.0, 0.1, 0.3, 1e23, 5e-324, -5e-324, DBL_MIN, -DBL_MIN, DBL_MIN - 5e-324, DBL_MAX, -DBL_MAX, DBL_EPSILON, 9007199254740993.0, 1e-5, 1e-4, 1e16, 1e17, 1e21, 1e22};
+	const REAL4 special4[] = {0.0f, -0.0f, 1.0f, -1.0f, 0.1f, 0.3f, 1e-45f, -1e-45f, FLT_MIN, -FLT_MIN, FLT_MAX, -FLT_MAX, FLT_EPSILON, 16777217.0f, 1e-5f, 1e-4f, 1e8f, 1e9f};
+	char s[64];
+	size_t i;
+	int e;
+
+	for(i = 0; i < sizeof(special8) / sizeof(*special8); i++)
+		XLAL_CHECK(check_real8(special8[i]) == 0, XLAL_EFUNC);
+	for(i = 0; i < sizeof(special4) / sizeof(*special4); i++)
+		XLAL_CHECK(check_real4(special4[i]) == 0, XLAL_EFUNC);
+
+	/* every power of two, including the subnormals */
+	for(e = -1074; e <= 1023; e++) {
+		XLAL_CHECK(check_real8(ldexp(1.0, e)) == 0, XLAL_EFUNC);
+		XLAL_CHECK(check_real8(-ldexp(1.0, e)) == 0, XLAL_EFUNC);
+		XLAL_CHECK(check_real8(nextafter(ldexp(1.0, e), 0.0)) == 0, XLAL_EFUNC);
+	}
+	for(e = -149; e <= 127; e++) {
+		XLAL_CHECK(check_real4(ldexpf(1.0f, e)) == 0, XLAL_EFUNC);
+		XLAL_CHECK(check_real4(-ldexpf(1.0f, e)) == 0, XLAL_EFUNC);
+		XLAL_CHECK(check_real4(nextafterf(ldexpf(1.0f, e), 0.0f)) == 0, XLAL_EFUNC);
+	}
+
+	/* random bit patterns */
+	for(i = 0; i < NRANDOM; i++) {
+		XLAL_CHECK(check_real8(random_real8()) == 0, XLAL_EFUNC);
+		XLAL_CHECK(check_real4(random_real4()) == 0, XLAL_EFUNC);
+	}
+
+	/* the style of %g */
+	s[format_real8(s, 0.0)] = '\0';
+	XLAL_CHECK(strcmp(s, "0") == 0, XLAL_EFAILED, "0 formatted as \"%s\"", s);
+	s[format_real8(s, -0.0)] = '\0';
+	XLAL_CHECK(strcmp(s, "-0") == 0, XLAL_EFAILED, "-0 formatted as \"%s\"", s);
+	s[format_real8(s, 0.5)] = '\0';
+	XLAL_CHECK(strcmp(s, "0.5") == 0, XLAL_EFAILED, "0.5 formatted as \"%s\"", s);
+	s[format_real8(s, 1e-5)] = '\0';
+	XLAL_CHECK(strcmp(s, "1e-05") == 0, XLAL_EFAILED, "1e-5 formatted as \"%s\"", s);
+	s[format_real8(s, 5e-324)] = '\0';
+	XLAL_CHECK(strcmp(s, "5e-324") == 0, XLAL_EFAILED, "5e-324 formatted as \"%s\"", s);
+	s[format_real8(s, DBL_MAX)] = '\0';
+	XLAL_CHECK(strcmp(s, "1.7976931348623157e+308") == 0, XLAL_EFAILED, "DBL_MAX formatted as \"%s\"", s);
+	s[format_real4(s, 0.1f)] = '\0';
+	XLAL_CHECK(strcmp(s, "0.1") == 0, XLAL_EFAILED, "0.1f formatted as \"%s\"", s);
+	s[format_real4(s, FLT_MAX)] = '\0';
+	XLAL_CHECK(strcmp(s, "3.4028235e+38") == 0, XLAL_EFAILED, "FLT_MAX formatted as \"%s\"", s);
+
+	return 0;
+}
+
+
+/*
+ * Write a time_slide table and a table of every column type, each several
+ * times the size of the writer's buffer, and check that the readers return
+ * exactly what was written.
+ */
+
+struct rows {
+	INT8 id[NROWS];
+	INT4 int_4s[NROWS];
+	UINT4 int_4u[NROWS];
+	INT8 int_8s[NROWS];
+	REAL4 real_4[NROWS];
+	REAL8 real_8[NROWS];
+	const char *lstring[NROWS];
+	char names[NROWS][16];
+};
+
+static const LIGOLwColumnSpec read_columns[] = {
+	{"row_id", METAIO_TYPE_ILWD_CHAR, 1, "write_test"},
+	{"int_4s", METAIO_TYPE_INT_4S, 1, NULL},
+	{"int_4u", METAIO_TYPE_INT_4U, 1, NULL},
+	{"int_8s", METAIO_TYPE_INT_8S, 1, NULL},
+	{"real_4", METAIO_TYPE_REAL_4, 1, NULL},
+	{"real_8", METAIO_TYPE_REAL_8, 1, NULL},
+	{"lstring", METAIO_TYPE_LSTRING, 1, NULL}
+};
+
+static int test_write(void)
+{
+	struct rows *rows = XLALCalloc(1, sizeof(*rows));
+	XLAL_CHECK(rows, XLAL_ENOMEM);
+	const LIGOLwXMLColumn write_columns[] = {
+		{"write_test:row_id", LIGOLW_XML_ILWD_CHAR, rows->id, 0},
+		{"write_test:int_4s", LIGOLW_XML_INT_4S, rows->int_4s, 0},
+		{"write_test:int_4u", LIGOLW_XML_INT_4U, rows->int_4u, 0},
+		{"write_test:int_8s", LIGOLW_XML_INT_8S, rows->int_8s, 0},
+		{"write_test:real_4", LIGOLW_XML_REAL_4, rows->real_4, 0},
+		{"write_test:real_8", LIGOLW_XML_REAL_8, rows->real_8, 0},
+		{"write_test:lstring", LIGOLW_XML_LSTRING, rows->lstring, 0}
+	};
+	TimeSlide *time_slide = NULL, **next = &time_slide;
+	TimeSlide *read_back;
+	const TimeSlide *row;
+	LIGOLwColumnBatch *batch;
+	LIGOLwXMLStream *xml;
+	FILE *fp;
+	long size;
+	size_t i;
+
+	for(i = 0; i < NROWS; i++) {
+		TimeSlide *slide = XLALCreateTimeSlide();
+		XLAL_CHECK(slide, XLAL_EFUNC);
+		*next = slide;
+		next = &slide->next;
+		slide->process_id = i % 7;
+		slide->time_slide_id = i;
+		snprintf(slide->instrument, sizeof(slide->instrument), "X%zu", i % 5);
+		slide->offset = random_real8();
+
+		rows->id[i] = i;
+		rows->int_4s[i] = (INT4) random_bits();
+		rows->int_4u[i] = (UINT4) random_bits();
+		rows->int_8s[i] = (INT8) random_bits();
+		rows->real_4[i] = random_real4();
+		rows->real_8[i] = random_real8();
+		snprintf(rows->names[i], sizeof(rows->names[i]), "row %zu", i);
+		rows->lstring[i] = rows->names[i];
+	}
+	rows->int_4s[0] = INT32_MIN;
+	rows->int_4u[0] = UINT32_MAX;
+	rows->int_8s[0] = INT64_MIN;
+	rows->real_8[0] = -0.0;
+
+	xml = XLALOpenLIGOLwXMLFile(FILENAME);
+	XLAL_CHECK(xml, XLAL_EFUNC);
+	XLAL_CHECK(XLALWriteLIGOLwXMLTimeSlideTable(xml, time_slide) == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALWriteLIGOLwXMLTableColumns(xml, "write_test", write_columns, sizeof(write_columns) / sizeof(*write_columns), NROWS) == 0, XLAL_EFUNC);
+	XLAL_CHECK(XLALCloseLIGOLwXMLFile(xml) == 0, XLAL_EFUNC);
+
+	/* both tables must have filled the buffer several times */
+	fp = fopen(FILENAME, "r");
+	XLAL_CHECK(fp, XLAL_EIO);
+	fseek(fp, 0, SEEK_END);
+	size = ftell(fp);
+	fclose(fp);
+	XLAL_CHECK(size > 4 * LIGOLW_XML_BUFFER_SIZE, XLAL_EFAILED, "document is only %ld bytes", size);
+
+	/* time_slide table, through the row reader */
+	read_back = XLALTimeSlideTableFromLIGOLw(FILENAME);
+	XLAL_CHECK(read_back, XLAL_EFUNC);
+	for(i = 0, row = read_back, next = &time_slide; row; i++, row = row->next, next = &(*next)->next) {
+		XLAL_CHECK(*next, XLAL_EFAILED, "too many time_slide rows");
+		XLAL_CHECK(row->process_id == (*next)->process_id && row->time_slide_id == (*next)->time_slide_id, XLAL_EFAILED, "ID mismatch in time_slide row %zu", i);
+		XLAL_CHECK(strcmp(row->instrument, (*next)->instrument) == 0, XLAL_EFAILED, "instrument mismatch in time_slide row %zu", i);
+		XLAL_CHECK(memcmp(&row->offset, &(*next)->offset, sizeof(row->offset)) == 0, XLAL_EFAILED, "offset mismatch in time_slide row %zu", i);
+	}
+	XLAL_CHECK(i == NROWS, XLAL_EFAILED, "read %zu time_slide rows", i);
+	XLALDestroyTimeSlideTable(read_back);
+	XLALDestroyTimeSlideTable(time_slide);
+
+	/* all column types, through the column reader */
+	batch = XLALLIGOLwTableColumnsFromLIGOLw(FILENAME, "write_test", read_columns, sizeof(read_columns) / sizeof(*read_columns), NULL, NULL);
+	XLAL_CHECK(batch, XLAL_EFUNC);
+	XLAL_CHECK(batch->length == NROWS, XLAL_EFAILED, "read %zu rows", batch->length);
+	for(i = 0; i < NROWS; i++) {
+		const REAL4 real_4 = batch->columns[4].real_8[i];
+		XLAL_CHECK(batch->columns[0].int_8s[i] == rows->id[i], XLAL_EFAILED, "row_id mismatch in row %zu", i);
+		XLAL_CHECK(batch->columns[1].int_8s[i] == rows->int_4s[i], XLAL_EFAILED, "int_4s mismatch in row %zu", i);
+		XLAL_CHECK(batch->columns[2].int_8s[i] == rows->int_4u[i], XLAL_EFAILED, "int_4u mismatch in row %zu", i);
+		XLAL_CHECK(batch->columns[3].int_8s[i] == rows->int_8s[i], XLAL_EFAILED, "int_8s mismatch in row %zu", i);
+		XLAL_CHECK(memcmp(&real_4, &rows->real_4[i], sizeof(real_4)) == 0, XLAL_EFAILED, "real_4 mismatch in row %zu", i);
+		XLAL_CHECK(memcmp(&batch->columns[5].real_8[i], &rows->real_8[i], sizeof(REAL8)) == 0, XLAL_EFAILED, "real_8 mismatch in row %zu", i);
+		XLAL_CHECK(strcmp(batch->columns[6].lstring[i], rows->lstring[i]) == 0, XLAL_EFAILED, "lstring mismatch in row %zu", i);
+	}
+	XLALDestroyLIGOLwColumnBatch(batch);
+
+	XLALFree(rows);
+	remove(FILENAME);
+	return 0;
+}
+
+
+int main(void)
+{
+	XLAL_CHECK_MAIN(test_format() == 0, XLAL_EFUNC);
+	XLAL_CHECK_MAIN(test_write() == 0, XLAL_EFUNC);
+	LALCheckMemoryLeaks();
+	return 0;
+}
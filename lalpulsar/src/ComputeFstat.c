@@ -63,6 +63,8 @@ static const char *const FstatMethodNames[FMETHOD_END] = {
   [FMETHOD_DEMOD_OPTC]		= "DemodOptC",
   [FMETHOD_DEMOD_ALTIVEC]	= "DemodAltivec",
   [FMETHOD_DEMOD_SSE]		= "DemodSSE",
+  [FMETHOD_DEMOD_AVX2]		= "DemodAVX2",
+  [FMETHOD_DEMOD_AVX512]	= "DemodAVX512",
   [FMETHOD_DEMOD_BEST]		= "DemodBest",
 
   [FMETHOD_RESAMP_GENERIC]	= "ResampGeneric",
@@ -365,6 +367,13 @@ XLALCreateFstatInput ( const SFTCatalog *SFTcatalog,              ///< [in] Cata
     setupFuncMethod = XLALSetupFstatDemod;
     break;
 
+  case FMETHOD_DEMOD_AVX2:		// Demod: AVX2 hotloop
+  case FMETHOD_DEMOD_AVX512:		// Demod: AVX-512 hotloop
+    XLAL_CHECK_NULL ( optArgs.Dterms > 0, XLAL_EINVAL );
+    extraBinsMethod = optArgs.Dterms;
+    setupFuncMethod = XLALSetupFstatDemod;
+    break;
+
   case FMETHOD_RESAMP_GENERIC:		// Resamp: generic implementation
     extraBinsMethod = 8;   // use 8 extra bins to give better agreement with Demod(w Dterms=8) near the boundaries
     setupFuncMethod = XLALSetupFstatResamp;
@@ -677,6 +686,11 @@ XLALGetFstatInputDetectorStates ( const FstatInput* input       ///< [in] \c Fst
 ///
 /// Compute the \f$\mathcal{F}\f$-statistic over a band of frequencies.
 ///
+/// With the \a Resamp methods, and if LALPulsar was built with OpenMP support, this function may be called
+/// concurrently from several threads for the same \c FstatInput, provided each thread passes its own \c FstatResults.
+/// The resampled timeseries are shared between threads, and are only recomputed when the sky position or binary
+/// parameters change; threads should therefore divide the work between them by frequency and/or spindown.
+///
 int
 XLALComputeFstat ( FstatResults **Fstats,               ///< [in/out] Address of a pointer to a #FstatResults results structure; if \c NULL, allocate here.
                    FstatInput *input,                   ///< [in] Input data structure created by one of the setup functions.
@@ -1078,6 +1092,24 @@ XLALFstatMethodIsAvailable ( FstatMethodType method )
     return 0;
 #endif
 
+  case FMETHOD_DEMOD_AVX2:
+    // This method is available only if compiled with AVX2 support,
+    // and AVX2 is available on the current execution machine
+#ifdef HAVE_AVX2_COMPILER
+    return LAL_HAVE_AVX2_RUNTIME();
+#else
+    return 0;
+#endif
+
+  case FMETHOD_DEMOD_AVX512:
+    // This method is available only if compiled with AVX-512F support,
+    // and AVX-512F is available on the current execution machine
+#ifdef HAVE_AVX512F_COMPILER
+    return LAL_HAVE_AVX512F_RUNTIME();
+#else
+    return 0;
+#endif
+
   default:
     return 0;
 
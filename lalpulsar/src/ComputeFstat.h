@@ -109,6 +109,8 @@ typedef enum tagFstatMethodType {
   FMETHOD_DEMOD_OPTC,		///< \a Demod: gptimized C hotloop using Akos' algorithm, only works for \f$\text{Dterms} \lesssim 20\f$
   FMETHOD_DEMOD_ALTIVEC,	///< \a Demod: Altivec hotloop variant, uses fixed \f$\text{Dterms} = 8\f$
   FMETHOD_DEMOD_SSE,		///< \a Demod: SSE hotloop with precalc divisors, uses fixed \f$\text{Dterms} = 8\f$
+  FMETHOD_DEMOD_AVX2,		///< \a Demod: AVX2 hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
+  FMETHOD_DEMOD_AVX512,		///< \a Demod: AVX-512 hotloop, works for any number of Dirichlet kernel terms \f$\text{Dterms}\f$
   FMETHOD_DEMOD_BEST,		///< \a Demod: best guess of the fastest available hotloop
 
   FMETHOD_RESAMP_GENERIC,	///< \a Resamp: generic implementation
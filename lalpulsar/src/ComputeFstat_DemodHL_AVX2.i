@@ -0,0 +1,71 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+/// [hotloop]
+/* NOTE: sin[ 2pi (Dphi_alpha - k) ] = sin [ 2pi Dphi_alpha ] = sin [ 2pi kappa_star ],
+ * therefore the trig-functions need to be calculated only once!
+ * We choose the value sin[ 2pi kappa_star ] because it is the
+ * closest to zero and will pose no numerical difficulties !
+ * As kappa in [0, 1) we can skip the trimming step.
+ */
+{
+  REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+  XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star);
+  c_alpha -= 1.0f;
+
+  /* sum X_alpha_k / (kappa_star + Dterms - 1 - l) over the 2*Dterms bins, 4 complex bins at a time;
+   * the lanes of the accumulator hold { U_0, V_0, U_1, V_1, U_2, V_2, U_3, V_3 }
+   */
+  const REAL4 *Xa = (const REAL4 *) Xalpha_l;
+  const UINT4 numBins = 2 * Dterms;
+  /* divisors are formed as kappa_star + (Dterms - 1 - l), rather than by counting down
+   * from kappa_max, so that the small divisors around kstar keep full REAL4 precision
+   */
+  const __m256 kappa_s = _mm256_set1_ps ( kappa_star );
+  __m256 offset = _mm256_sub_ps ( _mm256_set1_ps ( Dterms - 1.0f ), _mm256_setr_ps ( 0, 0, 1, 1, 2, 2, 3, 3 ) );
+  const __m256 four = _mm256_set1_ps ( 4.0f );
+  __m256 UV = _mm256_setzero_ps();
+
+  UINT4 l = 0;
+  for ( ; l + 4 <= numBins; l += 4 )
+    {
+      __m256 X = _mm256_loadu_ps ( Xa + 2*l );
+      UV = _mm256_add_ps ( UV, _mm256_div_ps ( X, _mm256_add_ps ( kappa_s, offset ) ) );
+      offset = _mm256_sub_ps ( offset, four );
+    }
+
+  /* horizontal sum of the even (U) and odd (V) lanes */
+  __m128 UV4 = _mm_add_ps ( _mm256_castps256_ps128 ( UV ), _mm256_extractf128_ps ( UV, 1 ) );
+  UV4 = _mm_add_ps ( UV4, _mm_movehl_ps ( UV4, UV4 ) );
+  REAL4 U_alpha = _mm_cvtss_f32 ( UV4 );
+  REAL4 V_alpha = _mm_cvtss_f32 ( _mm_shuffle_ps ( UV4, UV4, _MM_SHUFFLE(1,1,1,1) ) );
+
+  /* remaining bins if 2*Dterms is not a multiple of 4 */
+  for ( ; l < numBins; l ++ )
+    {
+      REAL4 xinv = 1.0f / ( (REAL4) kappa_star + ( 1.0f * Dterms - 1.0f - l ) );
+      U_alpha += Xa[2*l] * xinv;
+      V_alpha += Xa[2*l+1] * xinv;
+    }
+
+  realXP = s_alpha * U_alpha - c_alpha * V_alpha;
+  imagXP = c_alpha * U_alpha + s_alpha * V_alpha;
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
@@ -0,0 +1,70 @@
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with with program; see the file COPYING. If not, write to the
+// Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+// MA  02111-1307  USA
+//
+
+/// [hotloop]
+/* NOTE: sin[ 2pi (Dphi_alpha - k) ] = sin [ 2pi Dphi_alpha ] = sin [ 2pi kappa_star ],
+ * therefore the trig-functions need to be calculated only once!
+ * We choose the value sin[ 2pi kappa_star ] because it is the
+ * closest to zero and will pose no numerical difficulties !
+ * As kappa in [0, 1) we can skip the trimming step.
+ */
+{
+  REAL4 s_alpha, c_alpha;   /* sin(2pi kappa_alpha) and (cos(2pi kappa_alpha)-1) */
+  XLALSinCos2PiLUTtrimmed ( &s_alpha, &c_alpha, kappa_star);
+  c_alpha -= 1.0f;
+
+  /* sum X_alpha_k / (kappa_star + Dterms - 1 - l) over the 2*Dterms bins, 8 complex bins at a time;
+   * even lanes of the accumulator hold partial sums of U, odd lanes of V
+   */
+  const REAL4 *Xa = (const REAL4 *) Xalpha_l;
+  const UINT4 numBins = 2 * Dterms;
+  /* divisors are formed as kappa_star + (Dterms - 1 - l), rather than by counting down
+   * from kappa_max, so that the small divisors around kstar keep full REAL4 precision
+   */
+  const __m512 kappa_s = _mm512_set1_ps ( kappa_star );
+  __m512 offset = _mm512_sub_ps ( _mm512_set1_ps ( Dterms - 1.0f ), _mm512_setr_ps ( 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7 ) );
+  const __m512 eight = _mm512_set1_ps ( 8.0f );
+  __m512 UV = _mm512_setzero_ps();
+
+  UINT4 l = 0;
+  for ( ; l + 8 <= numBins; l += 8 )
+    {
+      __m512 X = _mm512_loadu_ps ( Xa + 2*l );
+      UV = _mm512_add_ps ( UV, _mm512_div_ps ( X, _mm512_add_ps ( kappa_s, offset ) ) );
+      offset = _mm512_sub_ps ( offset, eight );
+    }
+
+  /* remaining bins if 2*Dterms is not a multiple of 8: masked-out lanes load zero,
+   * and the divisors never vanish since kappa_star is not an integer here
+   */
+  if ( l < numBins )
+    {
+      __mmask16 rem = (__mmask16) ( ( 1u << ( 2 * ( numBins - l ) ) ) - 1 );
+      __m512 X = _mm512_maskz_loadu_ps ( rem, Xa + 2*l );
+      UV = _mm512_add_ps ( UV, _mm512_div_ps ( X, _mm512_add_ps ( kappa_s, offset ) ) );
+    }
+
+  REAL4 U_alpha = _mm512_mask_reduce_add_ps ( 0x5555, UV );
+  REAL4 V_alpha = _mm512_mask_reduce_add_ps ( 0xAAAA, UV );
+
+  realXP = s_alpha * U_alpha - c_alpha * V_alpha;
+  imagXP = c_alpha * U_alpha + s_alpha * V_alpha;
+
+  /* real- and imaginary part of e^{i 2 pi lambda_alpha } */
+  XLALSinCos2PiLUT ( &imagQ, &realQ, lambda_alpha );
+}
+/// [hotloop]
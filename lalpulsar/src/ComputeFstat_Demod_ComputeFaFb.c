@@ -101,12 +101,8 @@ FUNC ( COMPLEX8 *Fa,                         /* [out] Fa returned */
     freqIndex1 = freqIndex0 + sfts->data[0].data->length;
   }
 
-  // locally initialize sin/cos lookuptable, as some hotloops use that directly
-  static int firstcall = 1;
-  if ( firstcall ) {
-    XLALSinCosLUTInit();
-    firstcall = 0;
-  }
+  // the sin/cos lookup table, which some hotloops use directly, has already been initialized by XLALSetupFstatDemod(),
+  // since this function may be called from several threads at once by XLALComputeFstatDemod()
 
   /* ----- prepare return of 'FstatAtoms' if requested */
   if ( FstatAtoms != NULL )
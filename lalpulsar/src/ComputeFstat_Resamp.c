@@ -25,6 +25,10 @@
 #include <complex.h>
 #include <fftw3.h>
 
+#ifdef _OPENMP
+#include <pthread.h>
+#endif
+
 #include "ComputeFstat_internal.h"
 
 #include <lal/FFTWMutex.h>
@@ -94,8 +98,6 @@ typedef struct tagFstatTimingResamp
   REAL4 tau0_FFT;       // timing coefficient for FFT-time
   REAL4 tau0_bary;      // timing coefficient for barycentering
 
-  Timings_t Tau;
-
 } FstatTimingResamp;
 
 static char FstatTimingResampHelp[] =
@@ -118,6 +120,8 @@ static char FstatTimingResampHelp[] =
 
 
 // ----- workspace ----------
+// Mutable scratch memory used by a single call to XLALComputeFstatResamp() at a time.
+// Workspaces are kept in a ResampWorkspacePool, from which each concurrent call takes its own.
 typedef struct tagResampWorkspace
 {
   // intermediate quantities to interpolate and operate on SRC-frame timeseries
@@ -137,8 +141,19 @@ typedef struct tagResampWorkspace
   COMPLEX8 *Fb_k;		// properly normalized F_b(f_k) over output bins
   UINT4 numFreqBinsAlloc;	// internal: keep track of allocated length of frequency-arrays
 
+  Timings_t Tau;		// timings collected in the current call to XLALComputeFstatResamp()
+  BOOLEAN usingBuffer;		// whether the current call to XLALComputeFstatResamp() is registered as a user of the resampling buffer
+
+  struct tagResampWorkspace *next;	// next idle workspace in pool
+
 } ResampWorkspace;
 
+// Pool of per-thread workspaces; this is the 'common.workspace' shared between FstatInputs via 'prevInput'
+typedef struct tagResampWorkspacePool
+{
+  ResampWorkspace *idle;	// workspaces not currently in use by any call to XLALComputeFstatResamp()
+} ResampWorkspacePool;
+
 typedef struct
 {
   UINT4 Dterms;						// Number of terms to use (on either side) in Windowed-Sinc interpolation kernel
@@ -156,8 +171,18 @@ typedef struct
   MultiCOMPLEX8TimeSeries *multiTimeSeries_SRC_b;	// multi-detector SRC-frame timeseries, multiplied by AM function b(t)
 
   UINT4 numSamplesFFT;					// length of zero-padded SRC-frame timeseries (related to dFreq)
+  UINT4 numSamplesMax_SRC;				// maximal length of single-detector SRC-frame timeseries [without zero-padding]
   UINT4 decimateFFT;					// output every n-th frequency bin, with n>1 iff (dFreq > 1/Tspan), and was internally decreased by n
-  fftwf_plan fftplan;					// FFT plan
+  fftwf_plan fftplan;					// FFT plan; only executed with fftwf_execute_dft(), which is thread-safe
+
+  // ----- thread-safety -----
+#ifdef _OPENMP
+  pthread_mutex_t bufferLock;				// protects 'numBufferUsers', 'numBufferWaiters' and 'bufferUpdating'
+  pthread_cond_t bufferCond;				// signalled whenever the resampling buffer becomes free or is updated
+#endif
+  UINT4 numBufferUsers;					// number of calls to XLALComputeFstatResamp() currently reading the resampling buffer
+  UINT4 numBufferWaiters;				// number of calls waiting to recompute the resampling buffer for a new Doppler point
+  BOOLEAN bufferUpdating;				// whether a call is currently recomputing the resampling buffer
 
   // ----- timing -----
   BOOLEAN collectTiming;				// flag whether or not to collect timing information
@@ -177,6 +202,13 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
                          void *method_data
                        );
 
+static int
+XLALComputeFstatResampWithWorkspace ( FstatResults* Fstats,
+                                      const FstatCommon *common,
+                                      ResampMethodData *resamp,
+                                      ResampWorkspace *ws
+                                      );
+
 static int
 XLALApplySpindownAndFreqShift ( COMPLEX8 *xOut,
                                 const COMPLEX8TimeSeries *xIn,
@@ -186,10 +218,23 @@ XLALApplySpindownAndFreqShift ( COMPLEX8 *xOut,
 
 static int
 XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,
+                                                 ResampWorkspace *ws,
                                                  const PulsarDopplerParams *thisPoint,
                                                  const FstatCommon *common
                                                  );
 
+static int
+XLALAcquireResampBuffer ( ResampMethodData *resamp,
+                          ResampWorkspace *ws,
+                          const PulsarDopplerParams *thisPoint,
+                          const FstatCommon *common
+                          );
+
+static void
+XLALReleaseResampBuffer ( ResampMethodData *resamp,
+                          ResampWorkspace *ws
+                          );
+
 static int
 XLALComputeFaFb_Resamp ( ResampMethodData *resamp,
                          ResampWorkspace *ws,
@@ -208,9 +253,11 @@ XLALGetFFTPlanHints ( int * planMode,
 // ==================== function definitions ====================
 
 static void
-XLALDestroyResampWorkspace ( void *workspace )
+XLALDestroyResampWorkspace ( ResampWorkspace *ws )
 {
-  ResampWorkspace *ws = (ResampWorkspace*) workspace;
+  if ( ws == NULL ) {
+    return;
+  }
 
   XLALDestroyCOMPLEX8Vector ( ws->TStmp1_SRC );
   XLALDestroyCOMPLEX8Vector ( ws->TStmp2_SRC );
@@ -229,6 +276,150 @@ XLALDestroyResampWorkspace ( void *workspace )
 
 } // XLALDestroyResampWorkspace()
 
+static int
+XLALResizeResampWorkspace ( ResampWorkspace *ws,		//!< [in,out] workspace to enlarge, if necessary
+                            UINT4 numSamplesFFT,		//!< [in] required length of zero-padded SRC-frame timeseries
+                            UINT4 numSamplesMax_SRC		//!< [in] required length of single-detector SRC-frame timeseries
+                            )
+{
+  XLAL_CHECK ( ws != NULL, XLAL_EFAULT );
+
+  if ( numSamplesFFT > ws->numSamplesFFTAlloc )
+    {
+      fftw_free ( ws->FabX_Raw );
+      XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      fftw_free ( ws->TS_FFT );
+      XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+
+      ws->numSamplesFFTAlloc = numSamplesFFT;
+    }
+
+  if ( ws->TStmp1_SRC == NULL )
+    {
+      XLAL_CHECK ( (ws->TStmp1_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (ws->TStmp2_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( (ws->SRCtimes_DET = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
+    }
+  else if ( numSamplesMax_SRC > ws->TStmp1_SRC->length )
+    {
+      // adjust maximal SRC-frame timeseries length, if necessary
+      XLAL_CHECK ( (ws->TStmp1_SRC->data = XLALRealloc ( ws->TStmp1_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      ws->TStmp1_SRC->length = numSamplesMax_SRC;
+      XLAL_CHECK ( (ws->TStmp2_SRC->data = XLALRealloc ( ws->TStmp2_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
+      ws->TStmp2_SRC->length = numSamplesMax_SRC;
+      XLAL_CHECK ( (ws->SRCtimes_DET->data = XLALRealloc ( ws->SRCtimes_DET->data, numSamplesMax_SRC * sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
+      ws->SRCtimes_DET->length = numSamplesMax_SRC;
+    }
+
+  return XLAL_SUCCESS;
+
+} // XLALResizeResampWorkspace()
+
+///
+/// Take a workspace from the pool for the exclusive use of the calling thread, allocating a new
+/// one if all workspaces are in use, and make sure it is large enough for the given sizes.
+/// The workspace must be returned to the pool with XLALReleaseResampWorkspace().
+///
+static ResampWorkspace *
+XLALAcquireResampWorkspace ( ResampWorkspacePool *pool,	//!< [in,out] pool of workspaces
+                             UINT4 numSamplesFFT,		//!< [in] required length of zero-padded SRC-frame timeseries
+                             UINT4 numSamplesMax_SRC		//!< [in] required length of single-detector SRC-frame timeseries
+                             )
+{
+  XLAL_CHECK_NULL ( pool != NULL, XLAL_EFAULT );
+
+  ResampWorkspace *ws = NULL;
+#pragma omp critical (ResampWorkspacePool)
+  {
+    ws = pool->idle;
+    if ( ws != NULL ) {
+      pool->idle = ws->next;
+      ws->next = NULL;
+    }
+  }
+  if ( ws == NULL ) {
+    XLAL_CHECK_NULL ( (ws = XLALCalloc ( 1, sizeof(*ws) )) != NULL, XLAL_ENOMEM );
+  }
+
+  // workspaces are only ever enlarged, so they can be shared by FstatInputs of different sizes (see 'prevInput')
+  if ( XLALResizeResampWorkspace ( ws, numSamplesFFT, numSamplesMax_SRC ) != XLAL_SUCCESS ) {
+    XLALDestroyResampWorkspace ( ws );
+    XLAL_ERROR_NULL ( XLAL_EFUNC );
+  }
+
+  return ws;
+
+} // XLALAcquireResampWorkspace()
+
+static void
+XLALReleaseResampWorkspace ( ResampWorkspacePool *pool, ResampWorkspace *ws )
+{
+#pragma omp critical (ResampWorkspacePool)
+  {
+    ws->next = pool->idle;
+    pool->idle = ws;
+  }
+} // XLALReleaseResampWorkspace()
+
+static void
+XLALDestroyResampWorkspacePool ( void *workspace )
+{
+  ResampWorkspacePool *pool = (ResampWorkspacePool*) workspace;
+
+  while ( pool->idle != NULL )
+    {
+      ResampWorkspace *ws = pool->idle;
+      pool->idle = ws->next;
+      XLALDestroyResampWorkspace ( ws );
+    }
+
+  XLALFree ( pool );
+  return;
+
+} // XLALDestroyResampWorkspacePool()
+
+static inline void
+ResampBufferLock ( ResampMethodData *resamp )
+{
+#ifdef _OPENMP
+  pthread_mutex_lock ( &resamp->bufferLock );
+#else
+  (void) resamp;
+#endif
+}
+
+static inline void
+ResampBufferUnlock ( ResampMethodData *resamp )
+{
+#ifdef _OPENMP
+  pthread_mutex_unlock ( &resamp->bufferLock );
+#else
+  (void) resamp;
+#endif
+}
+
+// wait (with the buffer lock held) until the state of the resampling buffer changes
+static inline void
+ResampBufferWait ( ResampMethodData *resamp )
+{
+#ifdef _OPENMP
+  pthread_cond_wait ( &resamp->bufferCond, &resamp->bufferLock );
+#else
+  (void) resamp;
+#endif
+}
+
+// wake up all calls waiting in ResampBufferWait()
+static inline void
+ResampBufferBroadcast ( ResampMethodData *resamp )
+{
+#ifdef _OPENMP
+  pthread_cond_broadcast ( &resamp->bufferCond );
+#else
+  (void) resamp;
+#endif
+}
+
 // ---------- internal functions ----------
 static void
 XLALDestroyResampMethodData ( void* method_data )
@@ -249,6 +440,11 @@ XLALDestroyResampMethodData ( void* method_data )
   fftwf_destroy_plan ( resamp->fftplan );
   LAL_FFTW_WISDOM_UNLOCK;
 
+#ifdef _OPENMP
+  pthread_cond_destroy ( &resamp->bufferCond );
+  pthread_mutex_destroy ( &resamp->bufferLock );
+#endif
+
   XLALFree ( resamp );
 
 } // XLALDestroyResampMethodData()
@@ -273,11 +469,15 @@ XLALSetupFstatResamp ( void **method_data,
   XLAL_CHECK( resamp != NULL, XLAL_ENOMEM );
 
   resamp->Dterms = optArgs->Dterms;
+#ifdef _OPENMP
+  XLAL_CHECK ( pthread_mutex_init ( &resamp->bufferLock, NULL ) == 0, XLAL_ESYS );
+  XLAL_CHECK ( pthread_cond_init ( &resamp->bufferCond, NULL ) == 0, XLAL_ESYS );
+#endif
 
   // Set method function pointers
   funcs->compute_func = XLALComputeFstatResamp;
   funcs->method_data_destroy_func = XLALDestroyResampMethodData;
-  funcs->workspace_destroy_func = XLALDestroyResampWorkspace;
+  funcs->workspace_destroy_func = XLALDestroyResampWorkspacePool;
 
   // Extra band needed for resampling: Hamming-windowed sinc used for interpolation has a transition bandwith of
   // TB=(4/L)*fSamp, where L=2*Dterms+1 is the window-length, and here fSamp=Band (i.e. the full SFT frequency band)
@@ -367,44 +567,20 @@ XLALSetupFstatResamp ( void **method_data,
 
   XLAL_CHECK ( numSamplesFFT >= numSamplesMax_SRC, XLAL_EFAILED, "[numSamplesFFT = %d] < [numSamplesMax_SRC = %d]\n", numSamplesFFT, numSamplesMax_SRC );
 
-  // ---- re-use shared workspace, or allocate here ----------
-  ResampWorkspace *ws = (ResampWorkspace*) common->workspace;
-  if ( ws != NULL )
-    {
-      if ( numSamplesFFT > ws->numSamplesFFTAlloc )
-        {
-          fftw_free ( ws->FabX_Raw );
-          XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-          fftw_free ( ws->TS_FFT );
-          XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-
-          ws->numSamplesFFTAlloc = numSamplesFFT;
-        }
+  resamp->numSamplesMax_SRC = numSamplesMax_SRC;
 
-      // adjust maximal SRC-frame timeseries length, if necessary
-      if ( numSamplesMax_SRC > ws->TStmp1_SRC->length ) {
-        XLAL_CHECK ( (ws->TStmp1_SRC->data = XLALRealloc ( ws->TStmp1_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-        ws->TStmp1_SRC->length = numSamplesMax_SRC;
-        XLAL_CHECK ( (ws->TStmp2_SRC->data = XLALRealloc ( ws->TStmp2_SRC->data,   numSamplesMax_SRC * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-        ws->TStmp2_SRC->length = numSamplesMax_SRC;
-        XLAL_CHECK ( (ws->SRCtimes_DET->data = XLALRealloc ( ws->SRCtimes_DET->data, numSamplesMax_SRC * sizeof(REAL8) )) != NULL, XLAL_ENOMEM );
-        ws->SRCtimes_DET->length = numSamplesMax_SRC;
-      }
-
-    } // end: if shared workspace given
-  else
+  // ---- re-use shared workspace pool, or allocate here ----------
+  ResampWorkspacePool *pool = (ResampWorkspacePool*) common->workspace;
+  if ( pool == NULL )
     {
-      XLAL_CHECK ( (ws = XLALCalloc ( 1, sizeof(*ws))) != NULL, XLAL_ENOMEM );
-      XLAL_CHECK ( (ws->TStmp1_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (ws->TStmp2_SRC   = XLALCreateCOMPLEX8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-      XLAL_CHECK ( (ws->SRCtimes_DET = XLALCreateREAL8Vector ( numSamplesMax_SRC )) != NULL, XLAL_EFUNC );
-
-      XLAL_CHECK ( (ws->FabX_Raw = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-      XLAL_CHECK ( (ws->TS_FFT   = fftw_malloc ( numSamplesFFT * sizeof(COMPLEX8) )) != NULL, XLAL_ENOMEM );
-      ws->numSamplesFFTAlloc = numSamplesFFT;
+      XLAL_CHECK ( (pool = XLALCalloc ( 1, sizeof(*pool) )) != NULL, XLAL_ENOMEM );
+      common->workspace = pool;
+    }
 
-      common->workspace = ws;
-    } // end: if we create our own workspace
+  // get a workspace (allocating or enlarging it if needed) to plan the FFT with;
+  // the plan is executed on the arrays of whichever workspace is used by each call
+  ResampWorkspace *ws = XLALAcquireResampWorkspace ( pool, numSamplesFFT, numSamplesMax_SRC );
+  XLAL_CHECK ( ws != NULL, XLAL_EFUNC );
 
   // ----- compute and buffer FFT plan ----------
   int fft_plan_flags=FFTW_MEASURE;
@@ -430,8 +606,10 @@ XLALSetupFstatResamp ( void **method_data,
   }
   XLALGetFFTPlanHints (& fft_plan_flags , & fft_plan_timeout);
   fftw_set_timelimit( fft_plan_timeout );
-  XLAL_CHECK ( (resamp->fftplan = fftwf_plan_dft_1d ( resamp->numSamplesFFT, ws->TS_FFT, ws->FabX_Raw, FFTW_FORWARD, fft_plan_flags )) != NULL, XLAL_EFAILED, "fftwf_plan_dft_1d() failed\n");
+  resamp->fftplan = fftwf_plan_dft_1d ( resamp->numSamplesFFT, ws->TS_FFT, ws->FabX_Raw, FFTW_FORWARD, fft_plan_flags );
   LAL_FFTW_WISDOM_UNLOCK;
+  XLALReleaseResampWorkspace ( pool, ws );
+  XLAL_CHECK ( resamp->fftplan != NULL, XLAL_EFAILED, "fftwf_plan_dft_1d() failed\n");
 
   // turn on timing collection if requested
   resamp->collectTiming = optArgs->collectTiming;
@@ -453,6 +631,14 @@ XLALSetupFstatResamp ( void **method_data,
 } // XLALSetupFstatResamp()
 
 
+///
+/// Compute the F-statistic using resampling. This function may be called concurrently from several threads for the
+/// same FstatInput: the resampled timeseries buffer and FFT plan are shared read-only between calls, while each call
+/// takes its own mutable workspace from the pool in 'common.workspace'. Concurrent calls with the same sky-position
+/// and binary parameters (e.g. threads working on different spindowns or frequency bands) run fully in parallel;
+/// a call with different parameters waits until the buffer is no longer in use before recomputing it.
+/// This requires OpenMP support; otherwise calls for the same FstatInput must not overlap.
+///
 static int
 XLALComputeFstatResamp ( FstatResults* Fstats,
                          const FstatCommon *common,
@@ -465,12 +651,33 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
   XLAL_CHECK(method_data != NULL, XLAL_EFAULT);
 
   ResampMethodData *resamp = (ResampMethodData*) method_data;
+  ResampWorkspacePool *pool = (ResampWorkspacePool*) common->workspace;
+
+  ResampWorkspace *ws = XLALAcquireResampWorkspace ( pool, resamp->numSamplesFFT, resamp->numSamplesMax_SRC );
+  XLAL_CHECK ( ws != NULL, XLAL_EFUNC );
+
+  int retn = XLALComputeFstatResampWithWorkspace ( Fstats, common, resamp, ws );
+
+  if ( ws->usingBuffer ) {
+    XLALReleaseResampBuffer ( resamp, ws );
+  }
+  XLALReleaseResampWorkspace ( pool, ws );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
 
+} // XLALComputeFstatResamp()
+
+static int
+XLALComputeFstatResampWithWorkspace ( FstatResults* Fstats,		//!< [in,out] F-statistic results
+                                      const FstatCommon *common,	//!< [in] common input data
+                                      ResampMethodData *resamp,		//!< [in,out] resampling buffer, shared between threads
+                                      ResampWorkspace *ws		//!< [in,out] workspace for exclusive use by this call
+                                      )
+{
   const FstatQuantities whatToCompute = Fstats->whatWasComputed;
   XLAL_CHECK ( !(whatToCompute & FSTATQ_ATOMS_PER_DET), XLAL_EINVAL, "Resampling does not currently support atoms per detector" );
 
-  ResampWorkspace *ws = (ResampWorkspace*) common->workspace;
-
   // ----- handy shortcuts ----------
   PulsarDopplerParams thisPoint = Fstats->doppler;
   const MultiCOMPLEX8TimeSeries *multiTimeSeries_DET = resamp->multiTimeSeries_DET;
@@ -478,7 +685,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
 
   // collect internal timing info
   BOOLEAN collectTiming = resamp->collectTiming;
-  Timings_t *Tau = &(resamp->timingResamp.Tau);
+  Timings_t *Tau = &(ws->Tau);
   XLAL_INIT_MEM ( (*Tau) );	// these need to be initialized to 0 for each call
 
   REAL8 ticStart = 0, tocEnd = 0;
@@ -487,8 +694,8 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
     XLAL_INIT_MEM ( (*Tau) );	// re-set all timings to 0 at beginning of each Fstat-call
     ticStart = XLALGetCPUTime();
   }
-  // Note: all buffering is done within that function
-  XLAL_CHECK ( XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( resamp, &thisPoint, common ) == XLAL_SUCCESS, XLAL_EFUNC );
+  // Note: all buffering is done within that function; the buffer is released by XLALComputeFstatResamp()
+  XLAL_CHECK ( XLALAcquireResampBuffer ( resamp, ws, &thisPoint, common ) == XLAL_SUCCESS, XLAL_EFUNC );
 
   if ( whatToCompute == FSTATQ_NONE ) {
     return XLAL_SUCCESS;
@@ -692,7 +899,9 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
       REAL8 tau0_spin  = Tau->Spin / (tiRS->Resolution * tiRS->NsampFFT );
       REAL8 tau0_FFT   = Tau->FFT / (5.0 * tiRS->NsampFFT * log2(tiRS->NsampFFT));
 
-      // update the averaged timing-model quantities
+      // update the averaged timing-model quantities, which are shared between threads
+#pragma omp critical (ResampTiming)
+      {
       tiGen->NCalls ++;	// keep track of number of Fstat-calls for timing
 #define updateAvgF(q) tiGen->q = ((tiGen->q *(tiGen->NCalls-1) + q)/(tiGen->NCalls))
       updateAvgF(tauF_eff);
@@ -714,6 +923,7 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
           updateAvgF(tauF_buffer);
           updateAvgRS(tau0_bary);
         } // if BufferRecomputed
+      } // omp critical (ResampTiming)
 
     } // if collectTiming
 
@@ -723,8 +933,8 @@ XLALComputeFstatResamp ( FstatResults* Fstats,
 
 
 static int
-XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered resampling data and workspace
-                         ResampWorkspace *ws,					//!< [in,out] resampling workspace (memory-sharing across segments)
+XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in] buffered resampling data
+                         ResampWorkspace *ws,					//!< [in,out] resampling workspace (for exclusive use by this thread)
                          const PulsarDopplerParams thisPoint,			//!< [in] Doppler point to compute {FaX,FbX} for
                          REAL8 dFreq,						//!< [in] output frequency resolution
                          UINT4 numFreqBins,					//!< [in] number of output frequency bins
@@ -750,7 +960,6 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
   UINT4 maxOutputBin = offset_bins + (numFreqBins - 1) * resamp->decimateFFT;
   XLAL_CHECK ( maxOutputBin < resamp->numSamplesFFT, XLAL_EDOM, "Highest output frequency bin outside available band: [maxOutputBin = %d] >= [numSamplesFFT = %d]\n", maxOutputBin, resamp->numSamplesFFT );
 
-  FstatTimingResamp *tiRS = &(resamp->timingResamp);
   BOOLEAN collectTiming = resamp->collectTiming;
   REAL8 tic = 0, toc = 0;
 
@@ -767,7 +976,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
-    tiRS->Tau.Spin += ( toc - tic);
+    ws->Tau.Spin += ( toc - tic);
     tic = toc;
   }
 
@@ -776,7 +985,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
-    tiRS->Tau.FFT += ( toc - tic);
+    ws->Tau.FFT += ( toc - tic);
     tic = toc;
   }
 
@@ -786,7 +995,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
-    tiRS->Tau.Copy += ( toc - tic);
+    ws->Tau.Copy += ( toc - tic);
     tic = toc;
   }
 
@@ -796,7 +1005,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
-    tiRS->Tau.Spin += ( toc - tic);
+    ws->Tau.Spin += ( toc - tic);
     tic = toc;
   }
 
@@ -805,7 +1014,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
-    tiRS->Tau.FFT += ( toc - tic);
+    ws->Tau.FFT += ( toc - tic);
     tic = toc;
   }
 
@@ -815,7 +1024,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
-    tiRS->Tau.Copy += ( toc - tic);
+    ws->Tau.Copy += ( toc - tic);
     tic = toc;
   }
 
@@ -834,7 +1043,7 @@ XLALComputeFaFb_Resamp ( ResampMethodData *resamp,				//!< [in,out] buffered res
 
   if ( collectTiming ) {
     toc = XLALGetCPUTime();
-    tiRS->Tau.Norm += ( toc - tic);
+    ws->Tau.Norm += ( toc - tic);
     tic = toc;
   }
 
@@ -894,6 +1103,106 @@ XLALApplySpindownAndFreqShift ( COMPLEX8 *restrict xOut,      			///< [out] the
 
 } // XLALApplySpindownAndFreqShift()
 
+///
+/// Check whether the resampling buffer holds the resampled timeseries for the Doppler point 'thisPoint',
+/// i.e. whether it was computed for the same sky-position, reference time, and binary parameters
+///
+static BOOLEAN
+XLALResampBufferIsValid ( const ResampMethodData *resamp, const PulsarDopplerParams *thisPoint )
+{
+  BOOLEAN same_skypos = (resamp->prev_doppler.Alpha == thisPoint->Alpha) && (resamp->prev_doppler.Delta == thisPoint->Delta);
+  BOOLEAN same_refTime = ( GPSDIFF ( resamp->prev_doppler.refTime, thisPoint->refTime ) == 0 );
+  BOOLEAN same_binary = \
+    (resamp->prev_doppler.asini == thisPoint->asini) &&
+    (resamp->prev_doppler.period == thisPoint->period) &&
+    (resamp->prev_doppler.ecc == thisPoint->ecc) &&
+    (GPSDIFF( resamp->prev_doppler.tp, thisPoint->tp ) == 0 ) &&
+    (resamp->prev_doppler.argp == thisPoint->argp);
+  return same_skypos && same_refTime && same_binary;
+} // XLALResampBufferIsValid()
+
+///
+/// Make sure the resampling buffer holds the resampled timeseries for 'thisPoint', and register the calling
+/// thread as a user of the buffer until XLALReleaseResampBuffer() is called.
+///
+/// If the buffer needs to be recomputed, the call registers as a waiter and sleeps on 'bufferCond' until all
+/// other users (which are using it for a different Doppler point) are finished. While there are waiters, new
+/// calls do not start using the current buffer contents, so that a waiter cannot be starved by a stream of calls
+/// for the old Doppler point. The buffer is then recomputed *without* holding the lock: 'bufferUpdating' keeps
+/// all other calls out of the buffer meanwhile, and they sleep instead of spinning until it has been updated.
+///
+static int
+XLALAcquireResampBuffer ( ResampMethodData *resamp,		// [in/out] resampling input and buffer
+                          ResampWorkspace *ws,			// [in/out] workspace of the calling thread
+                          const PulsarDopplerParams *thisPoint,	// [in] current skypoint and reftime
+                          const FstatCommon *common		// [in] various input quantities and parameters used here
+                          )
+{
+  BOOLEAN waiting = 0;
+  int retn = XLAL_SUCCESS;
+
+  ResampBufferLock ( resamp );
+  while ( 1 )
+    {
+      if ( !resamp->bufferUpdating )
+        {
+          if ( XLALResampBufferIsValid ( resamp, thisPoint ) )
+            {
+              // join the current users, unless this would hold up calls waiting for a different Doppler point
+              if ( waiting || resamp->numBufferWaiters == 0 ) {
+                break;
+              }
+            }
+          else if ( resamp->numBufferUsers == 0 )
+            {
+              // nobody is using the buffer: recompute it for 'thisPoint' outside of the lock
+              resamp->bufferUpdating = 1;
+              ResampBufferUnlock ( resamp );
+              retn = XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( resamp, ws, thisPoint, common );
+              ResampBufferLock ( resamp );
+              resamp->bufferUpdating = 0;
+              if ( retn != XLAL_SUCCESS ) {
+                resamp->prev_doppler.Alpha = NAN;	// buffer may be partially updated, so make sure it is recomputed next time
+              }
+              ResampBufferBroadcast ( resamp );
+              break;
+            }
+          else if ( !waiting )
+            {
+              waiting = 1;
+              resamp->numBufferWaiters ++;
+            }
+        }
+      ResampBufferWait ( resamp );
+    }
+
+  if ( waiting ) {
+    resamp->numBufferWaiters --;
+  }
+  if ( retn == XLAL_SUCCESS )
+    {
+      resamp->numBufferUsers ++;
+      ws->usingBuffer = 1;
+    }
+  ResampBufferUnlock ( resamp );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} // XLALAcquireResampBuffer()
+
+static void
+XLALReleaseResampBuffer ( ResampMethodData *resamp, ResampWorkspace *ws )
+{
+  ResampBufferLock ( resamp );
+  resamp->numBufferUsers --;
+  ws->usingBuffer = 0;
+  if ( resamp->numBufferUsers == 0 ) {
+    ResampBufferBroadcast ( resamp );
+  }
+  ResampBufferUnlock ( resamp );
+} // XLALReleaseResampBuffer()
+
 ///
 /// Performs barycentric resampling on a multi-detector timeseries, updates resampling buffer with results
 ///
@@ -903,6 +1212,7 @@ XLALApplySpindownAndFreqShift ( COMPLEX8 *restrict xOut,      			///< [out] the
 ///
 static int
 XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [in/out] resampling input and buffer (to store resampling TS)
+                                                 ResampWorkspace *ws,			// [in/out] workspace of the calling thread
                                                  const PulsarDopplerParams *thisPoint,	// [in] current skypoint and reftime
                                                  const FstatCommon *common		// [in] various input quantities and parameters used here
                                                  )
@@ -914,8 +1224,7 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
   XLAL_CHECK ( resamp->multiTimeSeries_DET != NULL, XLAL_EINVAL );
   XLAL_CHECK ( resamp->multiTimeSeries_SRC_a != NULL, XLAL_EINVAL );
   XLAL_CHECK ( resamp->multiTimeSeries_SRC_b != NULL, XLAL_EINVAL );
-
-  ResampWorkspace *ws = (ResampWorkspace*) common->workspace;
+  XLAL_CHECK ( ws != NULL, XLAL_EINVAL );
 
   UINT4 numDetectors = resamp->multiTimeSeries_DET->length;
   XLAL_CHECK ( resamp->multiTimeSeries_SRC_a->length == numDetectors, XLAL_EINVAL, "Inconsistent number of detectors tsDET(%d) != tsSRC(%d)\n", numDetectors, resamp->multiTimeSeries_SRC_a->length );
@@ -924,19 +1233,13 @@ XLALBarycentricResampleMultiCOMPLEX8TimeSeries ( ResampMethodData *resamp,		// [
   // ============================== BEGIN: handle buffering =============================
   BOOLEAN same_skypos = (resamp->prev_doppler.Alpha == thisPoint->Alpha) && (resamp->prev_doppler.Delta == thisPoint->Delta);
   BOOLEAN same_refTime = ( GPSDIFF ( resamp->prev_doppler.refTime, thisPoint->refTime ) == 0 );
-  BOOLEAN same_binary = \
-    (resamp->prev_doppler.asini == thisPoint->asini) &&
-    (resamp->prev_doppler.period == thisPoint->period) &&
-    (resamp->prev_doppler.ecc == thisPoint->ecc) &&
-    (GPSDIFF( resamp->prev_doppler.tp, thisPoint->tp ) == 0 ) &&
-    (resamp->prev_doppler.argp == thisPoint->argp);
 
-  Timings_t *Tau = &(resamp->timingResamp.Tau);
+  Timings_t *Tau = &(ws->Tau);
   REAL8 tic = 0, toc = 0;
   BOOLEAN collectTiming = resamp->collectTiming;
 
   // if same sky-position *and* same binary, we can simply return as there's nothing to be done here
-  if ( same_skypos && same_refTime && same_binary ) {
+  if ( XLALResampBufferIsValid ( resamp, thisPoint ) ) {
     Tau->BufferRecomputed = 0;
     return XLAL_SUCCESS;
   }
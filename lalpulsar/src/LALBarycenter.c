@@ -19,6 +19,7 @@
 */
 
 #include <lal/Date.h>
+#include <lal/VectorMath.h>
 #include <lal/LALBarycenter.h>
 
 #define OBLQ 0.40909280422232891e0; /* obliquity of ecliptic at JD 245145.0* in radians */;
@@ -53,10 +54,15 @@ struct tagBarycenterBuffer
   LALDetector site;		/// buffered detector site
   fixed_site_t fixed_site;	/// fixed-site buffered quantities
 
-  BOOLEAN active;		/// switch set on TRUE of buffer has been filled
+  BOOLEAN sky_active;		/// switch set on TRUE if sky-location quantities have been buffered
+  BOOLEAN site_active;		/// switch set on TRUE if detector-site quantities have been buffered
 }; // struct tagBarycenterBuffer
 
+/// number of sky-locations processed together by XLALBarycenterOptBatch()
+#define BARYCENTER_BATCH_BLOCK 128
+
 /* Internal functions */
+static const fixed_site_t *get_fixed_site( BarycenterBuffer *myBuffer, const LALDetector *site );
 static void precessionMatrix( REAL8 prn[3][3], REAL8 mjd, REAL8 dpsi, REAL8 deps );
 static void observatoryEarth( REAL8 obsearth[3], const LALDetector det, const LIGOTimeGPS *tgps, REAL8 gmst, REAL8 dpsi, REAL8 deps );
 
@@ -1174,7 +1180,7 @@ XLALBarycenterOpt ( EmissionTime *emit, 		/**< [out] emission-time information *
   // now we're (basically) guaranteed to have a valid buffer in 'myBuffer'
 
   // use buffered sky-quantities if same sky-position as stored in buffer
-  if ( myBuffer->active && (alpha == myBuffer->alpha) && (delta == myBuffer->delta ) )
+  if ( myBuffer->sky_active && (alpha == myBuffer->alpha) && (delta == myBuffer->delta ) )
     {
       sinDelta = myBuffer->fixed_sky.sinDelta;
       cosDelta = myBuffer->fixed_sky.cosDelta;
@@ -1209,54 +1215,14 @@ XLALBarycenterOpt ( EmissionTime *emit, 		/**< [out] emission-time information *
       myBuffer->fixed_sky.n[0] 	 = n[0];
       myBuffer->fixed_sky.n[1] 	 = n[1];
       myBuffer->fixed_sky.n[2] 	 = n[2];
-      myBuffer->active = 1;
+      myBuffer->sky_active = 1;
     } // if not re-using sky-buffered quantities
 
   // ---------- detector site-position dependent quantities: compute or re-use from buffer is applicable
-  REAL8 rd;   /* distance 'rd' of detector from center of Earth, in light seconds */
-  REAL8 longitude, latitude; 	/* geocentric (not geodetic!!) longitude and latitude of detector vertex */
-  REAL8 sinLat, cosLat;
-  REAL8 rd_sinLat, rd_cosLat;	// shortcuts for 'rd * sin(latitude)' and 'rd * cos(latitude)' respectively
-
-  // use buffered site-quantities if same site as stored in myBuffer
-  if ( myBuffer->active && (memcmp ( &baryinput->site, &myBuffer->site, sizeof(myBuffer->site) ) == 0) )
-    {
-      rd	= myBuffer->fixed_site.rd;
-      longitude	= myBuffer->fixed_site.longitude;
-      latitude	= myBuffer->fixed_site.latitude;
-      sinLat	= myBuffer->fixed_site.sinLat;
-      cosLat	= myBuffer->fixed_site.cosLat;
-      rd_sinLat	= myBuffer->fixed_site.rd_sinLat;
-      rd_cosLat	= myBuffer->fixed_site.rd_cosLat;
-    }
-  else
-    {
-      rd = sqrt( + baryinput->site.location[0]*baryinput->site.location[0]
-                 + baryinput->site.location[1]*baryinput->site.location[1]
-                 + baryinput->site.location[2]*baryinput->site.location[2] );
-
-      longitude = atan2 ( baryinput->site.location[1], baryinput->site.location[0] );
-      if ( rd == 0.0 )
-        latitude = LAL_PI_2;	// avoid division by 0, for detector at center of earth
-      else
-        latitude = LAL_PI_2 - acos ( baryinput->site.location[2] / rd );
-
-      sinLat = sin ( latitude );
-      cosLat = cos ( latitude );
-      rd_sinLat = rd * sinLat;
-      rd_cosLat = rd * cosLat;
-
-      // ... and store them in the myBuffer
-      memcpy ( &myBuffer->site, &baryinput->site , sizeof(myBuffer->site) );
-      myBuffer->fixed_site.rd 		= rd;
-      myBuffer->fixed_site.longitude 	= longitude;
-      myBuffer->fixed_site.latitude 	= latitude;
-      myBuffer->fixed_site.sinLat 	= sinLat;
-      myBuffer->fixed_site.cosLat 	= cosLat;
-      myBuffer->fixed_site.rd_sinLat 	= rd_sinLat;
-      myBuffer->fixed_site.rd_cosLat 	= rd_cosLat;
-      myBuffer->active = 1;
-    } // if not re-using site-buffered quantities
+  const fixed_site_t *fixed_site = get_fixed_site ( myBuffer, &baryinput->site );
+  const REAL8 longitude = fixed_site->longitude; 	/* geocentric (not geodetic!!) longitude of detector vertex */
+  const REAL8 rd_sinLat = fixed_site->rd_sinLat;	// shortcut for 'rd * sin(latitude)'
+  const REAL8 rd_cosLat = fixed_site->rd_cosLat;	// shortcut for 'rd * cos(latitude)'
 
   /*---------------------------------------------------------------------
    * Calucate Roemer delay for detector at center of Earth.
@@ -1461,6 +1427,214 @@ XLALBarycenterOpt ( EmissionTime *emit, 		/**< [out] emission-time information *
 
 } /* XLALBarycenterOpt() */
 
+/**
+ * \brief Batched version of XLALBarycenterOpt(), which computes the emission-time offset \f$t_e - t_a\f$ and its
+ * derivative for many sky-locations at the same arrival time \f$t_a\f$.
+ *
+ * The sky-locations are given as Cartesian unit vectors <tt>(nx,ny,nz)</tt> pointing from the SSB to the sources,
+ * in ICRS J2000 coordinates, i.e. \f$n = (\cos\delta\cos\alpha, \cos\delta\sin\alpha, \sin\delta)\f$;
+ * the sky-location in \c baryinput is ignored, and its \c dInv is used for all sky-locations.
+ *
+ * The Roemer, Earth-rotation and nutation delays are linear in \f$n\f$: their coefficients are computed once per
+ * arrival time, after which the delays for each sky-location reduce to dot products. The Shapiro delay is computed
+ * over blocks of sky-locations using XLALVectorLogREAL8(). The resulting loops over sky-locations contain no
+ * trigonometric functions or branches, and can be vectorized by the compiler.
+ *
+ * The results agree with <tt>emit->deltaT</tt> and <tt>emit->tDot</tt> returned by XLALBarycenterOpt() to within
+ * rounding errors. The detector-site quantities are buffered in \c buffer, as for XLALBarycenterOpt().
+ */
+int
+XLALBarycenterOptBatch ( REAL8 *deltaT,			/**< [out] emission-time offset \f$t_e - t_a\f$ for each sky-location */
+                         REAL8 *tDot,			/**< [out] \f$dt_e/dt_a\f$ for each sky-location */
+                         const REAL8 *nx,		/**< [in] x-components of the sky-location unit vectors */
+                         const REAL8 *ny,		/**< [in] y-components of the sky-location unit vectors */
+                         const REAL8 *nz,		/**< [in] z-components of the sky-location unit vectors */
+                         const UINT4 numSky,		/**< [in] number of sky-locations */
+                         const BarycenterInput *baryinput,	/**< [in] info about detector and arrival time; sky-location is ignored */
+                         const EarthState *earth,	/**< [in] earth-state (from XLALBarycenterEarth()) */
+                         BarycenterBuffer **buffer	/**< [in/out] internal buffer for speed optimization */
+                         )
+{
+  /* ---------- check input sanity ---------- */
+  XLAL_CHECK ( deltaT != NULL && tDot != NULL, XLAL_EINVAL, "Invalid input: deltaT == NULL or tDot == NULL");
+  XLAL_CHECK ( numSky == 0 || ( nx != NULL && ny != NULL && nz != NULL ), XLAL_EINVAL, "Invalid input: nx, ny or nz == NULL");
+  XLAL_CHECK ( baryinput != NULL, XLAL_EINVAL, "Invalid input: baryinput == NULL");
+  XLAL_CHECK ( earth != NULL, XLAL_EINVAL, "Invalid input: earth == NULL");
+
+  // physical constants, as used in XLALBarycenterOpt()
+  const REAL8 OMEGA = 7.29211510e-5;  /* ang. vel. of Earth (rad/sec)*/
+  const REAL8 sinEps0 = 0.397777155931914; 	// sin ( eps0 );
+  const REAL8 cosEps0 = 0.917482062069182;	// cos ( eps0 );
+  const REAL8 rsun = 2.322; /*radius of sun in sec */
+  const REAL8 AUc = LAL_AU_SI / LAL_C_SI;
+
+  // ---------- handle buffering of recurring computed quantities, as in XLALBarycenterOpt()
+  BarycenterBuffer *myBuffer = NULL;
+  if ( (buffer) && (*buffer) ) // caller gave as an allocated buffer
+    myBuffer = (*buffer);
+  else	// we need to create a buffer
+    XLAL_CHECK ( (myBuffer = XLALCalloc(1,sizeof(*myBuffer))) != NULL, XLAL_ENOMEM, "Failed to XLALCalloc(1,sizeof(*myBuffer))\n" );
+
+  const fixed_site_t *fixed_site = get_fixed_site ( myBuffer, &baryinput->site );
+  const REAL8 rd_sinLat = fixed_site->rd_sinLat;
+  const REAL8 rd_cosLat = fixed_site->rd_cosLat;
+
+  /* get the observatory term (if in TDB), which is independent of sky-location */
+  REAL8 obsTerm = 0;
+  if ( earth->ttype != TIMECORRECTION_ORIGINAL )
+    {
+      REAL8 obsEarth[3];
+      observatoryEarth( obsEarth, baryinput->site, &baryinput->tgps, earth->gmstRad, earth->delpsi, earth->deleps );
+
+      for ( UINT4 j = 0; j < 3; j++ )
+        obsTerm += obsEarth[j] * earth->velNow[j];
+
+      obsTerm /= (1.0-IFTE_LC)*(REAL8)IFTE_K;
+    }
+
+  /* luni-solar precession and nutation quantities, see XLALBarycenterOpt() */
+  const REAL8 cosZA = cos ( earth->tzeA );
+  const REAL8 sinZA = sin ( earth->tzeA );
+  const REAL8 cosThetaA = cos ( earth->thetaA );
+  const REAL8 sinThetaA = sin ( earth->thetaA );
+  const REAL8 cosGastZA = cos ( earth->gastRad + fixed_site->longitude - earth->zA );
+  const REAL8 sinGastZA = sin ( earth->gastRad + fixed_site->longitude - earth->zA );
+  const REAL8 cosGastLong = cos ( earth->gastRad + fixed_site->longitude );
+  const REAL8 sinGastLong = sin ( earth->gastRad + fixed_site->longitude );
+
+  /* coefficients c, dc of the Roemer and Earth-rotation delays and their derivatives, such that
+     roemer + erot = c . n and droemer + derot = dc . n; found by evaluating the expressions of
+     XLALBarycenterOpt() for each Cartesian basis vector e */
+  REAL8 c[3], dc[3];
+  for ( UINT4 j = 0; j < 3; j++ )
+    {
+      const REAL8 e[3] = { j == 0, j == 1, j == 2 };
+
+      /* cos(delta)*cos(alpha+zA) and cos(delta)*sin(alpha+zA) */
+      const REAL8 cosDeltaCosAlphaZA = e[0] * cosZA - e[1] * sinZA;
+      const REAL8 cosDeltaSinAlphaMinusZA = e[1] * cosZA + e[0] * sinZA;
+      const REAL8 cosDeltaCosAlphaMinusZA = cosDeltaCosAlphaZA * cosThetaA - sinThetaA * e[2];
+      const REAL8 sinDeltaCurt = cosDeltaCosAlphaZA * sinThetaA + cosThetaA * e[2];
+
+      REAL8 erot  = rd_sinLat * sinDeltaCurt + rd_cosLat * ( cosGastZA * cosDeltaCosAlphaMinusZA + sinGastZA * cosDeltaSinAlphaMinusZA );
+      REAL8 derot = OMEGA * rd_cosLat * ( - sinGastZA * cosDeltaCosAlphaMinusZA + cosGastZA * cosDeltaSinAlphaMinusZA );
+
+      const REAL8 delXNut = - earth->delpsi * ( e[1] * cosEps0 + e[2] * sinEps0 );
+      const REAL8 delYNut = e[0] * cosEps0 * earth->delpsi - e[2] * earth->deleps;
+      const REAL8 delZNut = e[0] * sinEps0 * earth->delpsi + e[1] * earth->deleps;
+
+      erot  += rd_sinLat * delZNut + rd_cosLat * cosGastLong * delXNut + rd_cosLat * sinGastLong * delYNut;
+      derot += OMEGA * ( - rd_cosLat * sinGastLong * delXNut + rd_cosLat * cosGastLong * delYNut );
+
+      c[j]  = earth->posNow[j] + erot;
+      dc[j] = earth->velNow[j] + derot;
+    }
+
+  /* quantities for the finite-distance correction to the Roemer delay */
+  const REAL8 dInv = ( baryinput->dInv > 1.0e-11 ) ? baryinput->dInv : 0;	/* implement if corr.  > 1 microsec */
+  REAL8 r2 = 0, dr2 = 0;
+  for ( UINT4 j = 0; j < 3; j++ )
+    {
+      r2  += earth->posNow[j] * earth->posNow[j];
+      dr2 += 2.0 * earth->posNow[j] * earth->velNow[j];
+    }
+
+  const REAL8 rse = earth->rse, drse = earth->drse;
+  const REAL8 deltaT0 = earth->einstein + obsTerm;
+  const REAL8 tDot0 = 1.0 + earth->deinstein;
+
+  /* loop over blocks of sky-locations */
+  for ( UINT4 k0 = 0; k0 < numSky; k0 += BARYCENTER_BATCH_BLOCK )
+    {
+      const UINT4 nk = ( numSky - k0 < BARYCENTER_BATCH_BLOCK ) ? numSky - k0 : BARYCENTER_BATCH_BLOCK;
+      const REAL8 *bnx = nx + k0, *bny = ny + k0, *bnz = nz + k0;
+      REAL8 seDotN[BARYCENTER_BATCH_BLOCK], dseDotN[BARYCENTER_BATCH_BLOCK], logArg[BARYCENTER_BATCH_BLOCK];
+
+      /* argument of the logarithm in the Shapiro delay, for rays outside and through the interior of the Sun */
+      for ( UINT4 k = 0; k < nk; k++ )
+        {
+          seDotN[k]  = earth->se[0]  * bnx[k] + earth->se[1]  * bny[k] + earth->se[2]  * bnz[k];
+          dseDotN[k] = earth->dse[0] * bnx[k] + earth->dse[1] * bny[k] + earth->dse[2] * bnz[k];
+          const int interior = ( rse * rse - seDotN[k] * seDotN[k] < rsun * rsun ) && ( seDotN[k] < 0 );
+          logArg[k] = AUc / ( interior ? seDotN[k] + sqrt ( rsun*rsun + seDotN[k]*seDotN[k] ) : rse + seDotN[k] );
+        }
+      XLAL_CHECK ( XLALVectorLogREAL8 ( logArg, logArg, nk ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+      for ( UINT4 k = 0; k < nk; k++ )
+        {
+          const REAL8 roemer  = earth->posNow[0] * bnx[k] + earth->posNow[1] * bny[k] + earth->posNow[2] * bnz[k];
+          const REAL8 droemer = earth->velNow[0] * bnx[k] + earth->velNow[1] * bny[k] + earth->velNow[2] * bnz[k];
+          const REAL8 delay   = c[0] * bnx[k] + c[1] * bny[k] + c[2] * bnz[k];
+          const REAL8 ddelay  = dc[0] * bnx[k] + dc[1] * bny[k] + dc[2] * bnz[k];
+
+          /* Shapiro delay */
+          const REAL8 b2 = rse * rse - seDotN[k] * seDotN[k];
+          const REAL8 b = sqrt ( fmax ( b2, 0 ) );
+          const int interior = ( b2 < rsun * rsun ) && ( seDotN[k] < 0 );
+          const REAL8 shapiro  = 9.852e-6 * logArg[k] + ( interior ? 19.704e-6 * ( 1.0 - b / rsun ) : 0 );
+          const REAL8 dshapiro = interior
+            ? - 19.704e-6 * ( rse * drse - seDotN[k] * dseDotN[k] ) / ( b * rsun )
+            : - 9.852e-6 * ( drse + dseDotN[k] ) / ( rse + seDotN[k] );
+
+          /* finite-distance correction to the Roemer delay */
+          const REAL8 finiteDistCorr  = - 0.5 * ( r2 - roemer * roemer ) * dInv;
+          const REAL8 dfiniteDistCorr = - ( 0.5 * dr2 - roemer * droemer ) * dInv;
+
+          deltaT[k0 + k] = delay + deltaT0 - shapiro + finiteDistCorr;
+          tDot[k0 + k]   = tDot0 + ddelay - dshapiro + dfiniteDistCorr;
+        }
+
+    } // for k0 < numSky
+
+  // finish buffer handling, as in XLALBarycenterOpt()
+  if ( buffer && (*buffer == NULL ) )
+    (*buffer) = myBuffer;
+  if ( buffer == NULL )
+    XLALFree ( myBuffer );
+
+  return XLAL_SUCCESS;
+
+} /* XLALBarycenterOptBatch() */
+
+/**
+ * Return the detector-site quantities used by XLALBarycenterOpt() and XLALBarycenterOptBatch(),
+ * re-using the values stored in \c myBuffer if the detector site is unchanged.
+ */
+static const fixed_site_t *
+get_fixed_site ( BarycenterBuffer *myBuffer, const LALDetector *site )
+{
+  // use buffered site-quantities if same site as stored in myBuffer
+  if ( myBuffer->site_active && (memcmp ( site, &myBuffer->site, sizeof(myBuffer->site) ) == 0) )
+    return &myBuffer->fixed_site;
+
+  REAL8 rd;   /* distance 'rd' of detector from center of Earth, in light seconds */
+  REAL8 longitude, latitude; 	/* geocentric (not geodetic!!) longitude and latitude of detector vertex */
+
+  rd = sqrt( + site->location[0]*site->location[0]
+             + site->location[1]*site->location[1]
+             + site->location[2]*site->location[2] );
+
+  longitude = atan2 ( site->location[1], site->location[0] );
+  if ( rd == 0.0 )
+    latitude = LAL_PI_2;	// avoid division by 0, for detector at center of earth
+  else
+    latitude = LAL_PI_2 - acos ( site->location[2] / rd );
+
+  // ... and store them in the myBuffer
+  memcpy ( &myBuffer->site, site, sizeof(myBuffer->site) );
+  myBuffer->fixed_site.rd 		= rd;
+  myBuffer->fixed_site.longitude 	= longitude;
+  myBuffer->fixed_site.latitude 	= latitude;
+  myBuffer->fixed_site.sinLat 		= sin ( latitude );
+  myBuffer->fixed_site.cosLat 		= cos ( latitude );
+  myBuffer->fixed_site.rd_sinLat 	= rd * myBuffer->fixed_site.sinLat;
+  myBuffer->fixed_site.rd_cosLat 	= rd * myBuffer->fixed_site.cosLat;
+  myBuffer->site_active = 1;
+
+  return &myBuffer->fixed_site;
+
+} /* get_fixed_site() */
+
 /**
  * Function to calculate the precession matrix give Earth nutation values
  * depsilon and dpsi for a given MJD time.
@@ -125,6 +125,9 @@ PosVelAcc;
  * center-of-mass positions of the Earth and Sun, listed at regular
  * time intervals.
  */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IGNORE_MEMBERS(tagEphemerisData, storage));
+#endif /* SWIG */
 typedef struct tagEphemerisData
 {
   CHAR *filenameE;      /**< File containing Earth's position.  */
@@ -145,6 +148,10 @@ typedef struct tagEphemerisData
   PosVelAcc *ephemS;    /**< Array with pos, vel and acc for the sun (see ephemE) */
 
   EphemerisType etype;  /**< The ephemeris type e.g. DE405 */
+
+  struct tagEphemerisStorage *storage; /**< Memory holding the ephemeris tables, which may be memory-mapped from
+                                        * a binary ephemeris file; NULL if \a ephemE and \a ephemS were allocated
+                                        * with XLALMalloc() */
 }
 EphemerisData;
 
@@ -153,6 +160,9 @@ EphemerisData;
  * This structure will contain a vector of time corrections
  * used during conversion from TT to TDB/TCB/Teph
  */
+#ifdef SWIG /* SWIG interface directives */
+SWIGLAL(IGNORE_MEMBERS(tagTimeCorrectionData, storage));
+#endif /* SWIG */
 typedef struct tagTimeCorrectionData{
   CHAR *timeEphemeris;   /**< File containing the time ephemeris */
 
@@ -160,6 +170,8 @@ typedef struct tagTimeCorrectionData{
   REAL8 dtTtable;        /**< The spacing in sec between consecutive instants in Time ephemeris table.*/
   REAL8 *timeCorrs;      /**< Array of time delays for converting TT to TDB/TCB from the Time table (seconds).*/
   REAL8 timeCorrStart;   /**< The initial GPS time of the time delay table. */
+
+  struct tagEphemerisStorage *storage; /**< Memory holding the time delay table (see EphemerisData) */
 } TimeCorrectionData;
 
 
@@ -269,6 +281,10 @@ typedef struct tagBarycenterBuffer BarycenterBuffer;
 int XLALBarycenterEarth ( EarthState *earth, const LIGOTimeGPS *tGPS, const EphemerisData *edat);
 int XLALBarycenter ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth);
 int XLALBarycenterOpt ( EmissionTime *emit, const BarycenterInput *baryinput, const EarthState *earth, BarycenterBuffer **buffer);
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALBarycenterOptBatch ( REAL8 *deltaT, REAL8 *tDot, const REAL8 *nx, const REAL8 *ny, const REAL8 *nz, const UINT4 numSky,
+                             const BarycenterInput *baryinput, const EarthState *earth, BarycenterBuffer **buffer );
+#endif /* SWIG */
 
 /* Function that uses time delay look-up tables to calculate time delays */
 int XLALBarycenterEarthNew ( EarthState *earth,
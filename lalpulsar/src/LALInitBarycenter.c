@@ -18,6 +18,18 @@
 *  MA  02111-1307  USA
 */
 
+#include <config.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <errno.h>
+#include <string.h>
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#include <lal/LALStdio.h>
 #include <lal/FileIO.h>
 #include <lal/LALBarycenter.h>
 #include <lal/LALInitBarycenter.h>
@@ -32,10 +44,60 @@
 #define NORM3D(x) ( SQ( (x)[0]) + SQ( (x)[1] ) + SQ ( (x)[2] ) )
 #define LENGTH3D(x) ( sqrt( NORM3D ( (x) ) ) )
 
+/** magic string at the start of a binary ephemeris file */
+#define EPHEM_BINARY_MAGIC "LALEPHEM"
+/** version of the binary ephemeris file format */
+#define EPHEM_BINARY_VERSION 1
+/** value of the 'byteOrder' header field, as written in the native byte order */
+#define EPHEM_BINARY_BYTE_ORDER 0x01020304
+
 /** \endcond */
 
 /* ----- local type definitions ---------- */
 
+/* A binary ephemeris file holds one table: the header, followed directly by 'length' entries of
+ * 'entrySize' bytes each; all numbers are stored in the native byte order. The checksum is taken
+ * over the header (with 'checksum' set to zero) and the table */
+typedef struct
+{
+  CHAR magic[8];
+  UINT4 version;
+  UINT4 byteOrder;
+  UINT4 kind;
+  UINT4 entrySize;
+  UINT8 length;
+  REAL8 dt;
+  REAL8 start;
+  UINT8 checksum;
+  UINT8 padding;
+} _ephem_binary_header_t;
+
+/** kinds of table stored in binary ephemeris files */
+enum {
+  EPHEM_BINARY_POSVELACC = 1,	/**< table of PosVelAcc, as in an Earth or Sun ephemeris file */
+  EPHEM_BINARY_TIMECORR = 2	/**< table of REAL8 time delays, as in a time correction file */
+};
+
+/**
+ * Memory holding one ephemeris table: either a memory-mapped binary ephemeris file if
+ * 'maplen' > 0, or memory allocated with XLALMalloc() otherwise
+ */
+typedef struct
+{
+  void *base;		/**< start of the memory */
+  size_t maplen;	/**< length of the memory mapping, or 0 */
+}
+EphemerisMemory;
+
+/**
+ * Memory holding the tables of an \a EphemerisData or \a TimeCorrectionData struct; the
+ * tables themselves may point anywhere inside this memory.
+ */
+struct tagEphemerisStorage
+{
+  EphemerisMemory table[2];
+};
+
 /**
  * Generic ephemeris-vector type, holding one timeseries of pos, vel, acceleration.
  * This is used for the generic ephemeris-reader XLAL-function, at the end the resulting
@@ -46,6 +108,7 @@ typedef struct
   UINT4 length;      	/**< number of ephemeris-data entries */
   REAL8 dt;      	/**< spacing in seconds between consecutive instants in ephemeris table.*/
   PosVelAcc *data;    	/**< array containing pos,vel,acc as extracted from ephem file. Units are sec, 1, 1/sec respectively */
+  EphemerisMemory memory;	/**< memory holding 'data' */
 }
 EphemerisVector;
 
@@ -53,6 +116,12 @@ EphemerisVector;
 EphemerisVector *XLALCreateEphemerisVector ( UINT4 length );
 void XLALDestroyEphemerisVector ( EphemerisVector *ephemV );
 
+static void free_ephemeris_memory ( EphemerisMemory *memory );
+static UINT8 ephemeris_checksum ( const _ephem_binary_header_t *header, const void *data, size_t size );
+static BOOLEAN is_binary_ephemeris_file ( const CHAR *fname );
+static int read_binary_ephemeris_file ( EphemerisMemory *memory, _ephem_binary_header_t *header, const CHAR *fname, UINT4 kind );
+static int write_binary_ephemeris_file ( const CHAR *fname, UINT4 kind, const void *data, UINT4 length, REAL8 dt, REAL8 start );
+
 EphemerisVector * XLALReadEphemerisFile ( const CHAR *fname);
 int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3], REAL8 range[3] );
 
@@ -78,6 +147,9 @@ int XLALCheckEphemerisRanges ( const EphemerisVector *ephemEarth, REAL8 avg[3],
  * Chebychev polynomials in these files using the conversion in the lalapps code
  * lalapps_create_time_correction_ephemeris
  *
+ * The file may also be a binary ephemeris file written by XLALWriteBinaryTimeCorrectionFile(),
+ * which is memory-mapped where supported instead of being parsed.
+ *
  * \ingroup LALBarycenter_h
  */
 TimeCorrectionData *
@@ -96,6 +168,31 @@ XLALInitTimeCorrections ( const CHAR *timeCorrectionFile /**< File containing Ea
   char *fname_path;
   XLAL_CHECK_NULL ( (fname_path = XLALPulsarFileResolvePath ( timeCorrectionFile )) != NULL, XLAL_EINVAL );
 
+  /* map binary ephemeris files directly into the output struct */
+  if ( is_binary_ephemeris_file ( fname_path ) )
+    {
+      TimeCorrectionData *tdat;
+      _ephem_binary_header_t header;
+      if ( ( tdat = XLALCalloc ( 1, sizeof(*tdat) ) ) == NULL || ( tdat->storage = XLALCalloc ( 1, sizeof(*tdat->storage) ) ) == NULL )
+        {
+          XLALFree ( fname_path );
+          XLALDestroyTimeCorrectionData ( tdat );
+          XLAL_ERROR_NULL ( XLAL_ENOMEM );
+        }
+      if ( read_binary_ephemeris_file ( &tdat->storage->table[0], &header, fname_path, EPHEM_BINARY_TIMECORR ) != XLAL_SUCCESS )
+        {
+          XLALFree ( fname_path );
+          XLALDestroyTimeCorrectionData ( tdat );
+          XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to read binary time correction file '%s'\n", timeCorrectionFile );
+        }
+      XLALFree ( fname_path );
+      tdat->nentriesT     = header.length;
+      tdat->dtTtable      = header.dt;
+      tdat->timeCorrStart = header.start;
+      tdat->timeCorrs     = (REAL8 *) ( (CHAR *) tdat->storage->table[0].base + sizeof(header) );
+      return tdat;
+    }
+
   /* read in file with XLALParseDataFile to ignore comment header lines */
   if ( XLALParseDataFile ( &flines, fname_path ) != XLAL_SUCCESS ) {
     XLALFree ( fname_path );
@@ -165,7 +262,12 @@ XLALDestroyTimeCorrectionData ( TimeCorrectionData *tcd )
   if ( !tcd )
     return;
 
-  if ( tcd->timeCorrs )
+  if ( tcd->storage )
+    {
+      free_ephemeris_memory ( &tcd->storage->table[0] );
+      XLALFree ( tcd->storage );
+    }
+  else if ( tcd->timeCorrs )
     XLALFree ( tcd->timeCorrs );
 
   XLALFree ( tcd );
@@ -192,6 +294,12 @@ XLALDestroyTimeCorrectionData ( TimeCorrectionData *tcd )
  * at that instant.  All in units of seconds; e.g. positions have
  * units of seconds, and accelerations have units 1/sec.
  *
+ * Either file may also be a binary ephemeris file written by XLALWriteBinaryEphemerisFile().
+ * Binary files are memory-mapped where supported, so that processes on the same machine
+ * loading the same ephemeris share its memory; the tables then point directly into the
+ * mapping. The ephemeris type is still determined from the file names, which should
+ * therefore keep the "DEnnn" tag of the original files.
+ *
  * \ingroup LALBarycenter_h
  */
 EphemerisData *
@@ -257,14 +365,19 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
 
   /* prepare output ephemeris struct for returning */
   EphemerisData *edat;
-  if ( ( edat = XLALCalloc ( 1, sizeof(*edat) ) ) == NULL )
-    XLAL_ERROR_NULL ( XLAL_ENOMEM, "XLALCalloc ( 1, %zu ) failed.\n", sizeof(*edat) );
+  if ( ( edat = XLALCalloc ( 1, sizeof(*edat) ) ) == NULL || ( edat->storage = XLALCalloc ( 1, sizeof(*edat->storage) ) ) == NULL )
+    {
+      XLALDestroyEphemerisVector ( ephemV );
+      XLALDestroyEphemerisData ( edat );
+      XLAL_ERROR_NULL ( XLAL_ENOMEM, "XLALCalloc ( 1, %zu ) failed.\n", sizeof(*edat) );
+    }
 
   /* store in ephemeris-struct */
   edat->nentriesE = ephemV->length;
   edat->dtEtable  = ephemV->dt;
   edat->ephemE    = ephemV->data;
   edat->etype     = etype;
+  edat->storage->table[0] = ephemV->memory;
   XLALFree ( ephemV );	/* don't use 'destroy', as we linked the data into edat! */
   ephemV = NULL;
 
@@ -290,6 +403,7 @@ XLALInitBarycenter ( const CHAR *earthEphemerisFile,         /**< File containin
   edat->nentriesS = ephemV->length;
   edat->dtStable  = ephemV->dt;
   edat->ephemS    = ephemV->data;
+  edat->storage->table[1] = ephemV->memory;
   XLALFree ( ephemV );	/* don't use 'destroy', as we linked the data into edat! */
   ephemV = NULL;
 
@@ -319,11 +433,20 @@ XLALDestroyEphemerisData ( EphemerisData *edat )
   if ( edat->filenameS )
     XLALFree ( edat->filenameS );
 
-  if ( edat->ephemE )
-    XLALFree ( edat->ephemE );
+  if ( edat->storage )
+    {
+      free_ephemeris_memory ( &edat->storage->table[0] );
+      free_ephemeris_memory ( &edat->storage->table[1] );
+      XLALFree ( edat->storage );
+    }
+  else
+    {
+      if ( edat->ephemE )
+        XLALFree ( edat->ephemE );
 
-  if ( edat->ephemS )
-    XLALFree ( edat->ephemS );
+      if ( edat->ephemS )
+        XLALFree ( edat->ephemS );
+    }
 
   XLALFree ( edat );
 
@@ -336,6 +459,9 @@ XLALDestroyEphemerisData ( EphemerisData *edat )
  * Restrict the EphemerisData 'edat' to the smallest number of entries
  * required to cover the GPS time range ['startGPS', 'endGPS']
  *
+ * If 'edat' was loaded by XLALInitBarycenter(), the restricted tables are views into the
+ * tables as loaded, and no memory is copied; otherwise the tables are reallocated.
+ *
  * \ingroup LALBarycenter_h
  */
 int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS, const LIGOTimeGPS *endGPS ) {
@@ -362,12 +488,14 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
     }
   } while(1);
 
-  // Reallocate 'ephemE' to new table size, and free old table
-  PosVelAcc *const new_ephemE = XLALMalloc(edat->nentriesE * sizeof(*new_ephemE));
-  XLAL_CHECK(new_ephemE != NULL, XLAL_ENOMEM);
-  memcpy(new_ephemE, edat->ephemE, edat->nentriesE * sizeof(*new_ephemE));
-  edat->ephemE = new_ephemE;
-  XLALFree(old_ephemE);
+  // Reallocate 'ephemE' to new table size, and free old table, unless it is a view into 'storage'
+  if (edat->storage == NULL) {
+    PosVelAcc *const new_ephemE = XLALMalloc(edat->nentriesE * sizeof(*new_ephemE));
+    XLAL_CHECK(new_ephemE != NULL, XLAL_ENOMEM);
+    memcpy(new_ephemE, edat->ephemE, edat->nentriesE * sizeof(*new_ephemE));
+    edat->ephemE = new_ephemE;
+    XLALFree(old_ephemE);
+  }
 
   // Increase 'ephemS' and decrease 'nentriesS' to fit the range ['start', 'end']
   PosVelAcc *const old_ephemS = edat->ephemS;
@@ -382,18 +510,74 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
     }
   } while(1);
 
-  // Reallocate 'ephemS' to new table size, and free old table
-  PosVelAcc *const new_ephemS = XLALMalloc(edat->nentriesS * sizeof(*new_ephemS));
-  XLAL_CHECK(new_ephemS != NULL, XLAL_ENOMEM);
-  memcpy(new_ephemS, edat->ephemS, edat->nentriesS * sizeof(*new_ephemS));
-  edat->ephemS = new_ephemS;
-  XLALFree(old_ephemS);
+  // Reallocate 'ephemS' to new table size, and free old table, unless it is a view into 'storage'
+  if (edat->storage == NULL) {
+    PosVelAcc *const new_ephemS = XLALMalloc(edat->nentriesS * sizeof(*new_ephemS));
+    XLAL_CHECK(new_ephemS != NULL, XLAL_ENOMEM);
+    memcpy(new_ephemS, edat->ephemS, edat->nentriesS * sizeof(*new_ephemS));
+    edat->ephemS = new_ephemS;
+    XLALFree(old_ephemS);
+  }
 
   return XLAL_SUCCESS;
 
 } /* XLALRestrictEphemerisData() */
 
 
+/**
+ * Convert an Earth or Sun ephemeris file, as read by XLALInitBarycenter(), into a binary
+ * ephemeris file. Binary ephemeris files are read by XLALInitBarycenter() without parsing,
+ * and are memory-mapped where supported; they carry a checksum, and must be read on a
+ * machine with the same byte order as the one which wrote them.
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALWriteBinaryEphemerisFile ( const CHAR *binaryFile,		/**< [in] Binary ephemeris file to write */
+                               const CHAR *ephemerisFile	/**< [in] Earth or Sun ephemeris file to convert */
+                               )
+{
+  XLAL_CHECK ( binaryFile != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( ephemerisFile != NULL, XLAL_EFAULT );
+
+  EphemerisVector *ephemV;
+  XLAL_CHECK ( (ephemV = XLALReadEphemerisFile ( ephemerisFile )) != NULL, XLAL_EFUNC, "XLALReadEphemerisFile('%s') failed\n", ephemerisFile );
+
+  int retn = write_binary_ephemeris_file ( binaryFile, EPHEM_BINARY_POSVELACC, ephemV->data, ephemV->length, ephemV->dt, ephemV->data[0].gps );
+  XLALDestroyEphemerisVector ( ephemV );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteBinaryEphemerisFile() */
+
+
+/**
+ * Convert a time correction file, as read by XLALInitTimeCorrections(), into a binary
+ * ephemeris file; see XLALWriteBinaryEphemerisFile().
+ *
+ * \ingroup LALBarycenter_h
+ */
+int
+XLALWriteBinaryTimeCorrectionFile ( const CHAR *binaryFile,		/**< [in] Binary ephemeris file to write */
+                                    const CHAR *timeCorrectionFile	/**< [in] Time correction file to convert */
+                                    )
+{
+  XLAL_CHECK ( binaryFile != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( timeCorrectionFile != NULL, XLAL_EFAULT );
+
+  TimeCorrectionData *tdat;
+  XLAL_CHECK ( (tdat = XLALInitTimeCorrections ( timeCorrectionFile )) != NULL, XLAL_EFUNC, "XLALInitTimeCorrections('%s') failed\n", timeCorrectionFile );
+
+  int retn = write_binary_ephemeris_file ( binaryFile, EPHEM_BINARY_TIMECORR, tdat->timeCorrs, tdat->nentriesT, tdat->dtTtable, tdat->timeCorrStart );
+  XLALDestroyTimeCorrectionData ( tdat );
+  XLAL_CHECK ( retn == XLAL_SUCCESS, XLAL_EFUNC );
+
+  return XLAL_SUCCESS;
+
+} /* XLALWriteBinaryTimeCorrectionFile() */
+
+
 /* ========== internal function definitions ========== */
 
 /** simple creator function for EphemerisVector type */
@@ -411,6 +595,7 @@ XLALCreateEphemerisVector ( UINT4 length )
     }
 
   ret->length = length;
+  ret->memory.base = ret->data;
 
   return ret;
 
@@ -425,8 +610,7 @@ XLALDestroyEphemerisVector ( EphemerisVector *ephemV )
   if ( !ephemV )
     return;
 
-  if ( ephemV->data )
-    XLALFree ( ephemV->data );
+  free_ephemeris_memory ( &ephemV->memory );
 
   XLALFree ( ephemV );
 
@@ -454,6 +638,9 @@ XLALPulsarFileResolvePath ( const char *fname	  //!< [in] filename or file-path
  *
  * NOTE2: files are searches first locally, then in LAL_DATA_PATH, and finally in PKG_DATA_DIR
  * using XLALPulsarFileResolvePath()
+ *
+ * NOTE3: binary ephemeris files written by XLALWriteBinaryEphemerisFile() are read without parsing,
+ * and the returned data points into the (memory-mapped) file
  */
 EphemerisVector *
 XLALReadEphemerisFile ( const CHAR *fname )
@@ -480,6 +667,29 @@ XLALReadEphemerisFile ( const CHAR *fname )
 
   // if we're here, it means we found it
 
+  // binary ephemeris files need no parsing
+  if ( is_binary_ephemeris_file ( fname_path ) )
+    {
+      EphemerisVector *ephemV;
+      _ephem_binary_header_t header;
+      if ( (ephemV = XLALCalloc ( 1, sizeof(*ephemV) )) == NULL )
+        {
+          XLALFree ( fname_path );
+          XLAL_ERROR_NULL ( XLAL_ENOMEM );
+        }
+      if ( read_binary_ephemeris_file ( &ephemV->memory, &header, fname_path, EPHEM_BINARY_POSVELACC ) != XLAL_SUCCESS )
+        {
+          XLALFree ( ephemV );
+          XLALFree ( fname_path );
+          XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to read binary ephemeris file '%s'\n", fname );
+        }
+      XLALFree ( fname_path );
+      ephemV->length = header.length;
+      ephemV->dt     = header.dt;
+      ephemV->data   = (PosVelAcc *) ( (CHAR *) ephemV->memory.base + sizeof(header) );
+      return ephemV;
+    }
+
   // read in whole file (compressed or not) with XLALParseDataFile(), which ignores comment header lines
   LALParsedDataFile *flines = NULL;
   XLAL_CHECK_NULL ( XLALParseDataFile ( &flines, fname_path ) == XLAL_SUCCESS, XLAL_EFUNC );
@@ -648,3 +858,155 @@ XLALCheckEphemerisRanges ( const EphemerisVector *ephemV, REAL8 avg[3], REAL8 ra
   return XLAL_SUCCESS;
 
 } /* XLALCheckEphemerisRanges() */
+
+
+/** Free the memory holding an ephemeris table, and reset 'memory' */
+static void
+free_ephemeris_memory ( EphemerisMemory *memory )
+{
+#ifdef HAVE_SYS_MMAN_H
+  if ( memory->maplen > 0 )
+    munmap ( memory->base, memory->maplen );
+  else
+#endif
+    XLALFree ( memory->base );
+  memory->base = NULL;
+  memory->maplen = 0;
+} /* free_ephemeris_memory() */
+
+
+/**
+ * Checksum of a binary ephemeris file: 64-bit FNV-1a over the header, with 'checksum' set to zero,
+ * followed by the table, taken over 8-byte words; tables are always a multiple of 8 bytes long
+ */
+static UINT8
+ephemeris_checksum ( const _ephem_binary_header_t *header, const void *data, size_t size )
+{
+  _ephem_binary_header_t hdr = *header;
+  hdr.checksum = 0;
+  UINT8 hash = 0xcbf29ce484222325ULL;
+  for ( size_t k = 0; k < 2; ++k )
+    {
+      const CHAR *bytes = ( k == 0 ) ? (const CHAR *) &hdr : (const CHAR *) data;
+      const size_t n = ( ( k == 0 ) ? sizeof(hdr) : size ) / sizeof(UINT8);
+      for ( size_t i = 0; i < n; ++i )
+        {
+          UINT8 word;
+          memcpy ( &word, bytes + i * sizeof(word), sizeof(word) );
+          hash ^= word;
+          hash *= 0x100000001b3ULL;
+        }
+    }
+  return hash;
+} /* ephemeris_checksum() */
+
+
+/** Return whether 'fname' is a binary ephemeris file, by looking for the magic string */
+static BOOLEAN
+is_binary_ephemeris_file ( const CHAR *fname )
+{
+  FILE *fp = fopen ( fname, "rb" );
+  if ( fp == NULL )
+    return 0;
+
+  CHAR magic[8];
+  BOOLEAN ret = ( fread ( magic, sizeof(magic), 1, fp ) == 1 ) && ( memcmp ( magic, EPHEM_BINARY_MAGIC, sizeof(magic) ) == 0 );
+  fclose ( fp );
+
+  return ret;
+} /* is_binary_ephemeris_file() */
+
+
+/**
+ * Read the binary ephemeris file 'fname' holding a table of the given 'kind' into 'memory'; the
+ * table follows the header in 'memory'. Where supported the file is memory-mapped privately, so
+ * that its pages are shared between processes until they are written to; otherwise it is read
+ * into memory allocated with XLALMalloc().
+ */
+static int
+read_binary_ephemeris_file ( EphemerisMemory *memory, _ephem_binary_header_t *header, const CHAR *fname, UINT4 kind )
+{
+  const UINT4 entrySize = ( kind == EPHEM_BINARY_POSVELACC ) ? sizeof(PosVelAcc) : sizeof(REAL8);
+  FILE *fp = NULL;
+  memory->base = NULL;
+  memory->maplen = 0;
+
+  /* read and check the header */
+  XLAL_CHECK_FAIL ( (fp = fopen ( fname, "rb" )) != NULL, XLAL_EIO, "Failed to open '%s' for reading: %s\n", fname, strerror(errno) );
+  XLAL_CHECK_FAIL ( fread ( header, sizeof(*header), 1, fp ) == 1, XLAL_EIO, "Failed to read header of '%s'\n", fname );
+  XLAL_CHECK_FAIL ( memcmp ( header->magic, EPHEM_BINARY_MAGIC, sizeof(header->magic) ) == 0, XLAL_EIO, "'%s' is not a binary ephemeris file\n", fname );
+  XLAL_CHECK_FAIL ( header->version == EPHEM_BINARY_VERSION, XLAL_EIO, "'%s' has unsupported version %u\n", fname, header->version );
+  XLAL_CHECK_FAIL ( header->byteOrder == EPHEM_BINARY_BYTE_ORDER, XLAL_EIO, "'%s' was written on a machine with a different byte order\n", fname );
+  XLAL_CHECK_FAIL ( header->kind == kind, XLAL_EIO, "'%s' holds the wrong kind (%u) of ephemeris table, expected %u\n", fname, header->kind, kind );
+  XLAL_CHECK_FAIL ( header->entrySize == entrySize, XLAL_EIO, "'%s' has entries of %u bytes, expected %u\n", fname, header->entrySize, entrySize );
+  XLAL_CHECK_FAIL ( 0 < header->length && header->length <= LAL_INT4_MAX, XLAL_EIO, "'%s' has invalid number of entries %" LAL_UINT8_FORMAT "\n", fname, header->length );
+
+  /* check the file length */
+  const size_t size = header->length * entrySize;
+  const size_t filelen = sizeof(*header) + size;
+  {
+    struct stat st;
+    XLAL_CHECK_FAIL ( fstat ( fileno ( fp ), &st ) == 0, XLAL_EIO, "Failed to stat '%s': %s\n", fname, strerror(errno) );
+    XLAL_CHECK_FAIL ( (size_t)st.st_size == filelen, XLAL_EIO, "'%s' has length %zu, expected %zu\n", fname, (size_t)st.st_size, filelen );
+  }
+
+  /* map or read the file */
+#ifdef HAVE_SYS_MMAN_H
+  {
+    void *map = mmap ( NULL, filelen, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno ( fp ), 0 );
+    if ( map != MAP_FAILED ) {
+      memory->base = map;
+      memory->maplen = filelen;
+    }
+  }
+#endif
+  if ( memory->base == NULL )
+    {
+      XLAL_CHECK_FAIL ( (memory->base = XLALMalloc ( filelen )) != NULL, XLAL_ENOMEM );
+      XLAL_CHECK_FAIL ( fseek ( fp, 0, SEEK_SET ) == 0 && fread ( memory->base, filelen, 1, fp ) == 1, XLAL_EIO, "Failed to read '%s'\n", fname );
+    }
+  fclose ( fp );
+  fp = NULL;
+
+  /* verify the checksum */
+  const UINT8 checksum = ephemeris_checksum ( header, (const CHAR *) memory->base + sizeof(*header), size );
+  XLAL_CHECK_FAIL ( checksum == header->checksum, XLAL_EIO, "'%s' has invalid checksum\n", fname );
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  if ( fp != NULL )
+    fclose ( fp );
+  free_ephemeris_memory ( memory );
+  return XLAL_FAILURE;
+
+} /* read_binary_ephemeris_file() */
+
+
+/** Write a table of the given 'kind' to the binary ephemeris file 'fname' */
+static int
+write_binary_ephemeris_file ( const CHAR *fname, UINT4 kind, const void *data, UINT4 length, REAL8 dt, REAL8 start )
+{
+  const UINT4 entrySize = ( kind == EPHEM_BINARY_POSVELACC ) ? sizeof(PosVelAcc) : sizeof(REAL8);
+  const size_t size = (size_t)length * entrySize;
+
+  _ephem_binary_header_t XLAL_INIT_DECL(header);
+  memcpy ( header.magic, EPHEM_BINARY_MAGIC, sizeof(header.magic) );
+  header.version = EPHEM_BINARY_VERSION;
+  header.byteOrder = EPHEM_BINARY_BYTE_ORDER;
+  header.kind = kind;
+  header.entrySize = entrySize;
+  header.length = length;
+  header.dt = dt;
+  header.start = start;
+  header.checksum = ephemeris_checksum ( &header, data, size );
+
+  FILE *fp = fopen ( fname, "wb" );
+  XLAL_CHECK ( fp != NULL, XLAL_EIO, "Failed to open '%s' for writing: %s\n", fname, strerror(errno) );
+  int ok = ( fwrite ( &header, sizeof(header), 1, fp ) == 1 ) && ( fwrite ( data, size, 1, fp ) == 1 );
+  ok = ( fclose ( fp ) == 0 ) && ok;
+  XLAL_CHECK ( ok, XLAL_EIO, "Failed to write '%s'\n", fname );
+
+  return XLAL_SUCCESS;
+
+} /* write_binary_ephemeris_file() */
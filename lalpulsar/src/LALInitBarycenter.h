@@ -37,6 +37,9 @@ int XLALRestrictEphemerisData ( EphemerisData *edat, const LIGOTimeGPS *startGPS
 TimeCorrectionData *XLALInitTimeCorrections ( const CHAR *timeCorrectionFile );
 void XLALDestroyTimeCorrectionData( TimeCorrectionData *tcd );
 
+int XLALWriteBinaryEphemerisFile ( const CHAR *binaryFile, const CHAR *ephemerisFile );
+int XLALWriteBinaryTimeCorrectionFile ( const CHAR *binaryFile, const CHAR *timeCorrectionFile );
+
 char *XLALPulsarFileResolvePath ( const char *fname );
 
 /** \endcond */
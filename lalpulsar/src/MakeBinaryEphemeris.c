@@ -0,0 +1,71 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup LALBarycenter_h
+ * \brief Convert an Earth or Sun ephemeris file, or a time correction file, into a binary ephemeris file.
+ *
+ * The binary ephemeris file can be passed to XLALInitBarycenter() or XLALInitTimeCorrections()
+ * (and hence to any program accepting ephemeris files) in place of the original file; it is then
+ * memory-mapped instead of being parsed. The ephemeris type is determined from the file name, so
+ * the name of the binary file should keep the "DEnnn" tag of the original file.
+ */
+
+#include <config.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/UserInput.h>
+#include <lal/LogPrintf.h>
+#include <lal/LALInitBarycenter.h>
+
+#include "LALPulsarVCSInfo.h"
+
+int main( int argc, char *argv[] )
+{
+
+  // Register user input variables
+  CHAR *input_file = NULL;
+  CHAR *output_file = NULL;
+  BOOLEAN time_corrections = 0;
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &input_file, "input-file", STRING, 'i', REQUIRED, "Earth or Sun ephemeris file, or time correction file, to convert." ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &output_file, "output-file", STRING, 'o', REQUIRED, "Name of the binary ephemeris file to write." ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &time_corrections, "time-corrections", BOOLEAN, 't', OPTIONAL, "Input file is a time correction file, instead of an Earth or Sun ephemeris file." ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Parse user input
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN( XLALUserVarReadAllInput( &should_exit, argc, argv, lalPulsarVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    return EXIT_FAILURE;
+  }
+
+  // Convert file
+  LogPrintf( LOG_NORMAL, "Converting %s file '%s' ...\n", time_corrections ? "time correction" : "ephemeris", input_file );
+  if ( time_corrections ) {
+    XLAL_CHECK_MAIN( XLALWriteBinaryTimeCorrectionFile( output_file, input_file ) == XLAL_SUCCESS, XLAL_EFUNC );
+  } else {
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile( output_file, input_file ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  LogPrintf( LOG_NORMAL, "Wrote binary ephemeris file '%s'\n", output_file );
+
+  // Cleanup
+  XLALDestroyUserVars();
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
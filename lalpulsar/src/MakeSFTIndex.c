@@ -0,0 +1,82 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/**
+ * \file
+ * \ingroup SFTfileIO_h
+ * \brief Write a binary index of the SFTs matching a file pattern.
+ *
+ * The index file can be passed to XLALSFTdataFind() (and hence to any program accepting
+ * an SFT file pattern) in place of the file pattern; the SFTs are then looked up in the
+ * index by detector and timestamp, without opening any SFT file.
+ */
+
+#include <config.h>
+
+#include <lal/LALStdlib.h>
+#include <lal/UserInput.h>
+#include <lal/LogPrintf.h>
+#include <lal/SFTfileIO.h>
+
+#include "LALPulsarVCSInfo.h"
+
+int main( int argc, char *argv[] )
+{
+
+  // Register user input variables
+  CHAR *sft_files = NULL;
+  CHAR *output_file = NULL;
+  BOOLEAN validate_sft_files = 0;
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &sft_files, "sft-files", STRING, 'I', REQUIRED, "Pattern matching the SFT files to index. Use absolute paths if the index is to be used from other directories." ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &output_file, "output-file", STRING, 'o', REQUIRED, "Name of the SFT catalog index file to write." ) == XLAL_SUCCESS, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( XLALRegisterNamedUvar( &validate_sft_files, "validate-sft-files", BOOLEAN, 'V', OPTIONAL, "Validate the CRC64 checksums of the SFTs before indexing them." ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  // Parse user input
+  BOOLEAN should_exit = 0;
+  XLAL_CHECK_MAIN( XLALUserVarReadAllInput( &should_exit, argc, argv, lalPulsarVCSInfoList ) == XLAL_SUCCESS, XLAL_EFUNC );
+  if ( should_exit ) {
+    return EXIT_FAILURE;
+  }
+
+  // Find SFTs matching the file pattern
+  LogPrintf( LOG_NORMAL, "Loading SFTs matching '%s' into catalog ...\n", sft_files );
+  SFTCatalog *catalog = XLALSFTdataFind( sft_files, NULL );
+  XLAL_CHECK_MAIN( catalog != NULL, XLAL_EFUNC );
+  XLAL_CHECK_MAIN( catalog->length > 0, XLAL_EINVAL, "No SFTs found matching '%s'", sft_files );
+  LogPrintf( LOG_NORMAL, "Found %u SFTs matching '%s'\n", catalog->length, sft_files );
+
+  // Validate checksums of SFTs, if requested
+  if ( validate_sft_files ) {
+    LogPrintf( LOG_NORMAL, "Validating SFTs ...\n" );
+    BOOLEAN crc_check = 0;
+    XLAL_CHECK_MAIN( XLALCheckCRCSFTCatalog( &crc_check, catalog ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( crc_check, XLAL_EFUNC, "Failed to validate checksums of SFTs" );
+    LogPrintf( LOG_NORMAL, "Finished validating SFTs\n" );
+  }
+
+  // Write SFT catalog index
+  XLAL_CHECK_MAIN( XLALWriteSFTCatalogIndex( catalog, output_file ) == XLAL_SUCCESS, XLAL_EFUNC );
+  LogPrintf( LOG_NORMAL, "Wrote SFT catalog index '%s'\n", output_file );
+
+  // Cleanup
+  XLALDestroySFTCatalog( catalog );
+  XLALDestroyUserVars();
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+}
@@ -35,6 +35,8 @@
  */
 
 /*---------- INCLUDES ----------*/
+#include <config.h>
+
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <errno.h>
@@ -48,6 +50,14 @@
 #include <io.h>
 #endif
 
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <lal/LALStdio.h>
 #include <lal/LALString.h>
 #include <lal/FileIO.h>
@@ -119,6 +129,43 @@ typedef struct
   INT4 comment_length;
 } _SFT_header_v2_t;
 
+/** magic string at the start of an SFT catalog index file */
+#define SFT_INDEX_MAGIC "LALSFTIX"
+/** version of the SFT catalog index file format */
+#define SFT_INDEX_VERSION 1
+
+/* An SFT catalog index file consists of the header, followed by 'numEntries' entries sorted by
+ * detector and timestamp, followed by the 'numFiles' NUL-terminated SFT file names, followed by
+ * the NUL-terminated SFT comments; all numbers are stored in the native byte order */
+typedef struct
+{
+  CHAR magic[8];
+  UINT4 version;
+  UINT4 numFiles;
+  UINT4 numEntries;
+  UINT4 padding;
+  UINT8 namesLength;
+  UINT8 commentsLength;
+} _SFT_index_header_t;
+
+typedef struct
+{
+  CHAR detector[2];
+  CHAR padding[2];
+  UINT4 file;
+  INT4 gps_sec;
+  INT4 gps_nsec;
+  INT8 offset;
+  REAL8 f0;
+  REAL8 deltaF;
+  UINT4 numBins;
+  UINT4 version;
+  UINT8 crc64;
+  UINT8 comment_offset;
+  UINT4 comment_length;
+  UINT4 padding2;
+} _SFT_index_entry_t;
+
 /** segments read so far from one SFT */
 typedef struct {
   UINT4 first;                     /**< first bin in this segment */
@@ -127,6 +174,22 @@ typedef struct {
   struct tagSFTLocator *lastfrom;  /**< last bin read from this locator */
 } SFTReadSegment;
 
+/** bins read from one segment of an SFT */
+typedef struct {
+  UINT4 first;                     /**< first bin read */
+  UINT4 last;                      /**< last bin read, 0 if no bins were needed from this segment */
+  LIGOTimeGPS epoch;               /**< timestamp of the segment */
+  REAL8 deltaF;                    /**< frequency spacing of the segment */
+} SFTBinsRead;
+
+/** an SFT file opened for reading; the file is memory-mapped where supported */
+typedef struct {
+  const CHAR *fname;               /**< name of the open file, NULL if no file is open */
+  FILE *fp;                        /**< file pointer, used for reading the SFT headers */
+  const CHAR *map;                 /**< read-only mapping of the whole file, NULL if not mapped */
+  size_t maplen;                   /**< length of the mapping in bytes */
+} SFTFileView;
+
 /*---------- Global variables ----------*/
 static REAL8 fudge_up   = 1 + 10 * LAL_REAL8_EPS;	// about ~1 + 2e-15
 static REAL8 fudge_down = 1 - 10 * LAL_REAL8_EPS;	// about ~1 - 2e-15
@@ -140,11 +203,23 @@ static BOOLEAN is_pattern(const char*c); /* filename string is a glob-style patt
 static BOOLEAN is_valid_detector (const char *channel);
 static BOOLEAN consistent_mSFT_header ( SFTtype header1, UINT4 version1, UINT4 nsamples1, SFTtype header2, UINT4 version2, UINT4 nsamples2 );
 static BOOLEAN timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list );
+static BOOLEAN SFT_block_wanted ( SFTtype *header, const SFTConstraints *constraints );
+static BOOLEAN is_SFT_catalog_index ( const CHAR *fname );
+static int read_SFT_catalog_index ( SFTCatalog *ret, UINT4 *numSFTs, const CHAR *fname, const SFTConstraints *constraints );
+static int compareSFTindex ( const void *ptr1, const void *ptr2 );
+static int compareStringPtrs ( const void *ptr1, const void *ptr2 );
 static long get_file_len ( FILE *fp );
 
 static FILE * fopen_SFTLocator ( const struct tagSFTLocator *locator );
 
-static UINT4 read_sft_bins_from_fp ( SFTtype *ret, UINT4 *firstBinRead, UINT4 firstBin2read, UINT4 lastBin2read , FILE *fp );
+static int open_SFTFileView ( SFTFileView *view, const CHAR *fname );
+static void close_SFTFileView ( SFTFileView *view );
+static UINT4 catalog_SFT_bins ( const SFTDescriptor *desc, UINT4 firstbin, UINT4 lastbin, UINT4 *first );
+static int check_SFT_segments_overlap ( const SFTDescriptor *descs, const UINT4 *order, UINT4 numSegments, UINT4 isft, UINT4 firstbin, UINT4 lastbin );
+static int read_SFT_file_segments ( SFTVector *sfts, SFTBinsRead *reads, SFTtype *thisSFT, SFTFileView *view, const SFTDescriptor *descs, UINT4 numSegments, UINT4 firstbin, UINT4 lastbin, REAL8 deltaF );
+static int check_SFT_segments ( SFTtype *sft, SFTReadSegment *segment, const SFTDescriptor *descs, const SFTBinsRead *reads, const UINT4 *order, UINT4 numSegments, UINT4 isft, UINT4 firstbin, REAL8 deltaF );
+
+static UINT4 read_sft_bins_from_fp ( SFTtype *ret, UINT4 *firstBinRead, UINT4 firstBin2read, UINT4 lastBin2read , FILE *fp, const CHAR *map, size_t maplen );
 static int read_sft_header_from_fp (FILE *fp, SFTtype  *header, UINT4 *version, UINT8 *crc64, BOOLEAN *swapEndian, CHAR **SFTcomment, UINT4 *numBins );
 static int read_v2_header_from_fp ( FILE *fp, SFTtype *header, UINT4 *nsamples, UINT8 *header_crc64, UINT8 *ref_crc64, CHAR **SFTcomment, BOOLEAN swapEndian);
 static int read_v1_header_from_fp ( FILE *fp, SFTtype *header, UINT4 *nsamples, BOOLEAN swapEndian);
@@ -206,6 +281,9 @@ int XLALCWGPSinRange( const LIGOTimeGPS gps, const LIGOTimeGPS* minGPS, const LI
  *
  * The returned SFTs in the catalogue are sorted by increasing GPS-epochs !
  *
+ * If \a file_pattern is the name of an SFT catalog index written by XLALWriteSFTCatalogIndex(),
+ * the SFTs are looked up in the index instead, without opening any SFT-file.
+ *
  */
 SFTCatalog *
 XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
@@ -227,12 +305,25 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
   SFTCatalog *ret;
   XLAL_CHECK_NULL ( (ret = LALCalloc ( 1, sizeof (*ret) )) != NULL, XLAL_ENOMEM );
 
-  /* find matching filenames */
-  LALStringVector *fnames;
-  XLAL_CHECK_NULL ( (fnames = XLALFindFiles (file_pattern)) != NULL, XLAL_EFUNC, "Failed to find filelist matching pattern '%s'.\n\n", file_pattern );
-  UINT4 numFiles = fnames->length;
-
   UINT4 numSFTs = 0;
+  LALStringVector *fnames = NULL;
+  UINT4 numFiles = 0;
+  if ( is_SFT_catalog_index ( file_pattern ) )
+    {
+      /* query the SFT catalog index directly, without touching any SFT files */
+      if ( read_SFT_catalog_index ( ret, &numSFTs, file_pattern, constraints ) != XLAL_SUCCESS )
+        {
+          XLALDestroySFTCatalog ( ret );
+          XLAL_ERROR_NULL ( XLAL_EFUNC, "Failed to read SFT catalog index '%s'.\n\n", file_pattern );
+        }
+    }
+  else
+    {
+      /* find matching filenames */
+      XLAL_CHECK_NULL ( (fnames = XLALFindFiles (file_pattern)) != NULL, XLAL_EFUNC, "Failed to find filelist matching pattern '%s'.\n\n", file_pattern );
+      numFiles = fnames->length;
+    }
+
   /* ----- main loop: parse all matching files */
   for ( UINT4 i = 0; i < numFiles; i ++ )
     {
@@ -312,30 +403,8 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
 	  mprev_version = this_version;
 	  mprev_nsamples = this_nsamples;
 
-	  want_this_block = TRUE;	/* default */
-	  /* but does this SFT-block satisfy the user-constraints ? */
-	  if ( constraints )
-	    {
-	      if ( constraints->detector && strncmp(constraints->detector, "??", 2) )
-		{
-		  /* v1-SFTs have '??' as detector-name */
-		  if ( ! strncmp (this_header.name, "??", 2 ) ) {
-		    strncpy ( this_header.name, constraints->detector, 2 );	/* SET to constraint! */
-                  }
-		  else if ( strncmp( constraints->detector, this_header.name, 2) ) {
-		    want_this_block = FALSE;
-                  }
-		}
-
-	      if ( XLALCWGPSinRange(this_header.epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
-		want_this_block = FALSE;
-              }
-
-	      if ( constraints->timestamps && !timestamp_in_list(this_header.epoch, constraints->timestamps) ) {
-		want_this_block = FALSE;
-              }
-
-	    } /* if constraints */
+	  /* does this SFT-block satisfy the user-constraints ? */
+	  want_this_block = SFT_block_wanted ( &this_header, constraints );
 
 	  if ( want_this_block )
 	    {
@@ -497,6 +566,120 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
 } /* XLALSFTdataFind() */
 
 
+/**
+ * Write an index of the SFTs in \a catalog to the binary file \a fname.
+ *
+ * The index stores the complete SFT descriptors (detector, timestamp, frequency band,
+ * file name and offset, version, CRC64 checksum and comment) sorted by detector and
+ * timestamp. Passing the name of an index file to XLALSFTdataFind() then returns the
+ * SFTs in the index satisfying the given constraints, without opening any SFT file.
+ *
+ * \note The SFT file names are stored as found in \a catalog; relative names are only
+ * valid from the same working directory. The index is not updated if SFT files are
+ * changed, added or removed after it was written.
+ */
+int
+XLALWriteSFTCatalogIndex ( const SFTCatalog *catalog,	/**< catalog of SFTs to index */
+                           const CHAR *fname		/**< name of the index file to write */
+                           )
+{
+  XLAL_CHECK ( catalog != NULL, XLAL_EFAULT );
+  XLAL_CHECK ( fname != NULL, XLAL_EFAULT );
+
+  const UINT4 N = catalog->length;
+  FILE *fp = NULL;
+  const SFTDescriptor **bydesc = NULL;
+  const CHAR **byname = NULL;
+  _SFT_index_entry_t *entries = NULL;
+
+  XLAL_CHECK_FAIL ( (bydesc = XLALCalloc ( N + 1, sizeof(bydesc[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (byname = XLALCalloc ( N + 1, sizeof(byname[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( (entries = XLALCalloc ( N + 1, sizeof(entries[0]) )) != NULL, XLAL_ENOMEM );
+
+  /* sort descriptors by detector, then timestamp and frequency */
+  for ( UINT4 i = 0; i < N; i ++ ) {
+    XLAL_CHECK_FAIL ( catalog->data[i].locator != NULL, XLAL_EINVAL, "SFT descriptor %u has no locator\n", i );
+    bydesc[i] = &catalog->data[i];
+  }
+  qsort ( bydesc, N, sizeof(bydesc[0]), compareSFTindex );
+
+  /* build the table of unique file names */
+  for ( UINT4 i = 0; i < N; i ++ ) {
+    byname[i] = bydesc[i]->locator->fname;
+  }
+  qsort ( byname, N, sizeof(byname[0]), compareStringPtrs );
+  UINT4 numFiles = 0;
+  UINT8 namesLength = 0;
+  for ( UINT4 i = 0; i < N; i ++ ) {
+    if ( numFiles == 0 || strcmp ( byname[numFiles - 1], byname[i] ) != 0 ) {
+      byname[numFiles ++] = byname[i];
+      namesLength += strlen ( byname[i] ) + 1;
+    }
+  }
+
+  /* fill index entries */
+  UINT8 commentsLength = 0;
+  for ( UINT4 i = 0; i < N; i ++ ) {
+    const SFTDescriptor *desc = bydesc[i];
+    _SFT_index_entry_t *entry = &entries[i];
+    const CHAR **fptr = bsearch ( &desc->locator->fname, byname, numFiles, sizeof(byname[0]), compareStringPtrs );
+    XLAL_CHECK_FAIL ( fptr != NULL, XLAL_EERR );
+    entry->detector[0] = desc->header.name[0];
+    entry->detector[1] = desc->header.name[1];
+    entry->file = fptr - byname;
+    entry->gps_sec = desc->header.epoch.gpsSeconds;
+    entry->gps_nsec = desc->header.epoch.gpsNanoSeconds;
+    entry->offset = desc->locator->offset;
+    entry->f0 = desc->header.f0;
+    entry->deltaF = desc->header.deltaF;
+    entry->numBins = desc->numBins;
+    entry->version = desc->version;
+    entry->crc64 = desc->crc64;
+    entry->comment_offset = commentsLength;
+    entry->comment_length = ( desc->comment != NULL ) ? strlen ( desc->comment ) + 1 : 0;
+    commentsLength += entry->comment_length;
+  }
+
+  /* write index file: header, entries, file names, comments */
+  _SFT_index_header_t XLAL_INIT_DECL(header);
+  memcpy ( header.magic, SFT_INDEX_MAGIC, sizeof(header.magic) );
+  header.version = SFT_INDEX_VERSION;
+  header.numFiles = numFiles;
+  header.numEntries = N;
+  header.namesLength = namesLength;
+  header.commentsLength = commentsLength;
+  XLAL_CHECK_FAIL ( (fp = LALFopen ( fname, "wb" )) != NULL, XLAL_EIO, "Failed to open SFT catalog index '%s' for writing: %s\n", fname, strerror(errno) );
+  XLAL_CHECK_FAIL ( fwrite ( &header, sizeof(header), 1, fp ) == 1, XLAL_EIO, "Failed to write SFT catalog index '%s'\n", fname );
+  XLAL_CHECK_FAIL ( fwrite ( entries, sizeof(entries[0]), N, fp ) == N, XLAL_EIO, "Failed to write SFT catalog index '%s'\n", fname );
+  for ( UINT4 k = 0; k < numFiles; k ++ ) {
+    const size_t len = strlen ( byname[k] ) + 1;
+    XLAL_CHECK_FAIL ( fwrite ( byname[k], 1, len, fp ) == len, XLAL_EIO, "Failed to write SFT catalog index '%s'\n", fname );
+  }
+  for ( UINT4 i = 0; i < N; i ++ ) {
+    const size_t len = entries[i].comment_length;
+    XLAL_CHECK_FAIL ( fwrite ( bydesc[i]->comment, 1, len, fp ) == len, XLAL_EIO, "Failed to write SFT catalog index '%s'\n", fname );
+  }
+  XLAL_CHECK_FAIL ( fclose ( fp ) == 0, XLAL_EIO, "Failed to close SFT catalog index '%s': %s\n", fname, strerror(errno) );
+  fp = NULL;
+
+  XLALFree ( bydesc );
+  XLALFree ( byname );
+  XLALFree ( entries );
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  if ( fp != NULL ) {
+    fclose ( fp );
+  }
+  XLALFree ( bydesc );
+  XLALFree ( byname );
+  XLALFree ( entries );
+  return XLAL_FAILURE;
+
+} /* XLALWriteSFTCatalogIndex() */
+
+
 /*
    This function reads an SFT (segment) from an open file pointer into a buffer.
    firstBin2read specifies the first bin to read from the SFT, lastBin2read is the last bin.
@@ -504,9 +687,12 @@ XLALSFTdataFind ( const CHAR *file_pattern,		/**< which SFT-files */
    The function returns the last bin actually read, firstBinRead
    is set to the first bin actually read. In case of an error, 0 is returned
    and firstBinRead is set to a code further decribing the error condition.
+   If 'map' is not NULL, it must be a mapping of the complete file opened as 'fp':
+   the header is still parsed from 'fp', but the frequency bins are then copied
+   directly out of the mapping instead of being fread() from the file.
 */
 static UINT4
-read_sft_bins_from_fp ( SFTtype *ret, UINT4 *firstBinRead, UINT4 firstBin2read, UINT4 lastBin2read , FILE *fp )
+read_sft_bins_from_fp ( SFTtype *ret, UINT4 *firstBinRead, UINT4 firstBin2read, UINT4 lastBin2read , FILE *fp, const CHAR *map, size_t maplen )
 {
   UINT4 version;
   UINT8 crc64;
@@ -591,21 +777,44 @@ read_sft_bins_from_fp ( SFTtype *ret, UINT4 *firstBinRead, UINT4 firstBin2read,
       return(0);
     }
 
-  /* seek to the desired bins */
-  if ( fseek ( fp, offsetBytes, SEEK_CUR ) != 0 )
+  if ( map != NULL )
     {
-      XLALPrintError ( "read_sft_bins_from_fp(): Failed to fseek() to first frequency-bin %d: %s\n",
-		       firstBin2read, strerror(errno) );
-      *firstBinRead = 3;
-      return(0);
+      /* copy the desired bins straight out of the file mapping */
+      long datapos = ftell ( fp );
+      if ( datapos < 0 )
+	{
+	  XLALPrintError ( "read_sft_bins_from_fp(): Failed to ftell() SFT data position: %s\n", strerror(errno) );
+	  *firstBinRead = 3;
+	  return(0);
+	}
+      size_t start = (size_t)datapos + (size_t)offsetBytes;
+      size_t nbytes = (size_t)numBins2read * sizeof( COMPLEX8 );
+      if ( start > maplen || nbytes > maplen - start )
+	{
+	  XLALPrintError ("read_sft_bins_from_fp(): Failed to read %d bins from SFT!\n", numBins2read );
+	  *firstBinRead = 4;
+	  return(0);
+	}
+      memcpy ( ret->data->data, map + start, nbytes );
     }
-
-  /* actually read the data */
-  if ( numBins2read != fread ( ret->data->data, sizeof( COMPLEX8 ), numBins2read, fp ) )
+  else
     {
-      XLALPrintError ("read_sft_bins_from_fp(): Failed to read %d bins from SFT!\n", numBins2read );
-      *firstBinRead = 4;
-      return(0);
+      /* seek to the desired bins */
+      if ( fseek ( fp, offsetBytes, SEEK_CUR ) != 0 )
+	{
+	  XLALPrintError ( "read_sft_bins_from_fp(): Failed to fseek() to first frequency-bin %d: %s\n",
+			   firstBin2read, strerror(errno) );
+	  *firstBinRead = 3;
+	  return(0);
+	}
+
+      /* actually read the data */
+      if ( numBins2read != fread ( ret->data->data, sizeof( COMPLEX8 ), numBins2read, fp ) )
+	{
+	  XLALPrintError ("read_sft_bins_from_fp(): Failed to read %d bins from SFT!\n", numBins2read );
+	  *firstBinRead = 4;
+	  return(0);
+	}
     }
 
   /* update the start-frequency entry in the SFT-header to the new value */
@@ -682,21 +891,26 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
   SFTCatalog locatalog;            /**< local copy of the catalog to be sorted by 'locator' */
   SFTVector* sftVector = NULL;     /**< the vector of SFTs to be returned */
   SFTReadSegment*segments = NULL;  /**< array of segments already read of an SFT */
-  char empty = '\0';               /**< empty string */
-  char* fname = &empty;            /**< name of currently open file, initially "" */
-  FILE* fp = NULL;                 /**< open file */
-  SFTtype* thisSFT = NULL;         /**< SFT to read from file */
+  SFTBinsRead* reads = NULL;       /**< bins read from each segment, in the order of locatalog */
+  UINT4* sftStart = NULL;          /**< index into sftOrder of the first segment of each SFT */
+  UINT4* sftOrder = NULL;          /**< positions in locatalog of the segments, grouped by SFT */
+  UINT4* runStart = NULL;          /**< index into locatalog of the first segment of each piece of a file */
+  UINT4 nRuns = 0;                 /**< number of pieces of files to read */
 
   /* error handler: free memory and return with error */
 #define XLALLOADSFTSERROR(eno)	{		\
-    if(fp)					\
-      fclose(fp);				\
     if(segments) 				\
       XLALFree(segments);			\
+    if(reads)					\
+      XLALFree(reads);				\
+    if(sftStart)				\
+      XLALFree(sftStart);			\
+    if(sftOrder)				\
+      XLALFree(sftOrder);			\
+    if(runStart)				\
+      XLALFree(runStart);			\
     if(locatalog.data)				\
       XLALFree(locatalog.data);			\
-    if(thisSFT)					\
-      XLALDestroySFT(thisSFT);			\
     if(sftVector)				\
       XLALDestroySFTVector(sftVector);		\
     XLAL_ERROR_NULL(eno);	                \
@@ -758,12 +972,6 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
     XLALLOADSFTSERROR(XLAL_ENOMEM);
   }
 
-  /* allocate an additional single SFT where SFTs are read in */
-  if(!(thisSFT = XLALCreateSFT (lastbin + 1 - firstbin))) {
-    XLALPrintError("ERROR: Couldn't create thisSFT\n");
-    XLALLOADSFTSERROR(XLAL_ENOMEM);
-  }
-
   /* make a copy of the catalog that gets sorted by locator.
      Eases maintaing a correctly (epoch-)sorted catalog, particulary in case of errors
      note: only the pointers to the SFTdescriptors are copied & sorted, not the descriptors */
@@ -786,194 +994,411 @@ XLALLoadSFTs (const SFTCatalog *catalog,   /**< The 'catalogue' of SFTs to load
     XLALLOADSFTSERROR(XLAL_ENOMEM);
   }
 
-  /* loop over all files (actually locators) in the catalog */
-  for(catPos = 0; catPos < catalog->length; catPos++) {
+  /* allocate the record of the bins read from each segment */
+  if(!(reads = XLALCalloc(locatalog.length, sizeof(SFTBinsRead)))) {
+    XLALPrintError("ERROR: Couldn't allocate segment records\n");
+    XLALLOADSFTSERROR(XLAL_ENOMEM);
+  }
+
+  /* group the (sorted) locators by the SFT they belong to, keeping their order
+     within each SFT: the segments of SFT 'isft' are then
+     locatalog.data[sftOrder[sftStart[isft]]] ... locatalog.data[sftOrder[sftStart[isft+1]-1]] */
+  if(!(sftStart = XLALCalloc(nSFTs + 1, sizeof(sftStart[0]))) ||
+     !(sftOrder = XLALMalloc(locatalog.length * sizeof(sftOrder[0])))) {
+    XLALPrintError("ERROR: Couldn't allocate SFT segment index\n");
+    XLALLOADSFTSERROR(XLAL_ENOMEM);
+  }
+  for(catPos = 0; catPos < locatalog.length; catPos++)
+    sftStart[locatalog.data[catPos].locator->isft + 1]++;
+  for(UINT4 isft = 0; isft < nSFTs; isft++)
+    sftStart[isft + 1] += sftStart[isft];
+  for(catPos = 0; catPos < locatalog.length; catPos++)
+    sftOrder[sftStart[locatalog.data[catPos].locator->isft]++] = catPos;
+  for(UINT4 isft = nSFTs; isft > 0; isft--)
+    sftStart[isft] = sftStart[isft - 1];
+  sftStart[0] = 0;
+
+  /* the segments of an SFT may be copied into it concurrently below,
+     so first make sure from the catalog that they don't overlap */
+  for(UINT4 isft = 0; isft < nSFTs; isft++)
+    if(check_SFT_segments_overlap(locatalog.data, sftOrder + sftStart[isft], sftStart[isft + 1] - sftStart[isft],
+				  isft, firstbin, lastbin) != XLAL_SUCCESS)
+      XLALLOADSFTSERROR(XLAL_EIO);
+
+  /* the (sorted) locators come in runs of segments from the same file, which are read in
+     pieces: piece 'irun' is locatalog.data[runStart[irun]] ... locatalog.data[runStart[irun+1]-1].
+     Runs longer than 'maxRun' segments, e.g. of a single file holding all SFTs, are split so
+     that every thread gets a share; the files are then opened once each, plus at most once more per thread */
+  if(!(runStart = XLALMalloc((locatalog.length + 1) * sizeof(runStart[0])))) {
+    XLALPrintError("ERROR: Couldn't allocate SFT file index\n");
+    XLALLOADSFTSERROR(XLAL_ENOMEM);
+  }
+  UINT4 maxRun = locatalog.length;
+#ifdef _OPENMP
+  maxRun = (locatalog.length + omp_get_max_threads() - 1) / omp_get_max_threads();
+#endif
+  for(catPos = 0; catPos < locatalog.length; catPos++)
+    if(catPos == 0 || catPos - runStart[nRuns - 1] == maxRun ||
+       strcmp(locatalog.data[catPos].locator->fname, locatalog.data[catPos - 1].locator->fname) != 0)
+      runStart[nRuns++] = catPos;
+  runStart[nRuns] = locatalog.length;
+
+  /* the pieces are shared out between OpenMP threads (if enabled), so that each file is opened
+     and memory-mapped once for all the segments of a piece, by the thread that reads them */
+  int errcode = XLAL_SUCCESS;
+#pragma omp parallel if (nRuns > 1)
+  {
+    SFTFileView view = { NULL, NULL, NULL, 0 };
+    SFTtype *thisSFT = XLALCreateSFT (lastbin + 1 - firstbin);
+    if(!thisSFT) {
+      XLALPrintError("ERROR: Couldn't create thisSFT\n");
+      errcode = XLAL_ENOMEM;
+#pragma omp flush(errcode)
+    }
+#pragma omp for schedule(dynamic)
+    for(UINT4 irun = 0; irun < nRuns; irun++) {
+#pragma omp flush(errcode)
+      if(errcode != XLAL_SUCCESS)
+	continue;
+      if(read_SFT_file_segments(sftVector, reads + runStart[irun], thisSFT, &view,
+				locatalog.data + runStart[irun], runStart[irun + 1] - runStart[irun],
+				firstbin, lastbin, deltaF) != XLAL_SUCCESS) {
+	errcode = XLAL_EIO;
+#pragma omp flush(errcode)
+      }
+    }
+    close_SFTFileView(&view);
+    XLALDestroySFT(thisSFT);
+  }
+  if(errcode != XLAL_SUCCESS)
+    XLALLOADSFTSERROR(errcode);
+
+  /* check that the segments of each SFT fit together */
+  for(UINT4 isft = 0; isft < nSFTs; isft++)
+    if(check_SFT_segments(&sftVector->data[isft], &segments[isft], locatalog.data, reads,
+			  sftOrder + sftStart[isft], sftStart[isft + 1] - sftStart[isft], isft, firstbin, deltaF) != XLAL_SUCCESS)
+      XLALLOADSFTSERROR(XLAL_EIO);
+
+  /* check that all SFTs are complete */
+  for(UINT4 isft = 0; isft < nSFTs; isft++) {
+    if(segments[isft].last == lastbin) {
+      sftVector->data[isft].f0 = 1.0 * firstbin * deltaF;
+      sftVector->data[isft].epoch = segments[isft].epoch;
+      sftVector->data[isft].deltaF = deltaF;
+    } else {
+      if (segments[isft].last)
+	XLALPrintError("ERROR: data missing at end of SFT#%u (GPS %lf)"
+		       " expected bin %u, bin %u read from file '%s'\n",
+		       isft, GPS2REAL8(segments[isft].epoch),
+		       lastbin, segments[isft].last,
+		       segments[isft].lastfrom->fname);
+      else
+	XLALPrintError("ERROR: no data could be read for SFT#%u (GPS %lf)\n",
+		       isft, GPS2REAL8(segments[isft].epoch));
+      XLALLOADSFTSERROR(XLAL_EIO);
+    }
+  }
+
+  /* cleanup  */
+  XLALFree(segments);
+  XLALFree(reads);
+  XLALFree(sftStart);
+  XLALFree(sftOrder);
+  XLALFree(runStart);
+  XLALFree(locatalog.data);
+
+  return(sftVector);
+
+} /* XLALLoadSFTs() */
+
+
+/*
+   Bins of the segment 'desc' within [firstbin, lastbin], according to its catalog entry:
+   returns the last bin and sets *first to the first bin, or returns 0 if there are none.
+*/
+static UINT4
+catalog_SFT_bins ( const SFTDescriptor *desc, UINT4 firstbin, UINT4 lastbin, UINT4 *first )
+{
+  volatile REAL8 tmp = desc->header.f0 / desc->header.deltaF;
+  UINT4 firstSFTbin = lround ( tmp );
+  UINT4 lastSFTbin = firstSFTbin + desc->numBins - 1;
+  UINT4 last = ( lastbin < lastSFTbin ) ? lastbin : lastSFTbin;
+
+  *first = ( firstbin > firstSFTbin ) ? firstbin : firstSFTbin;
+  if ( *first > last ) {
+    *first = 0;
+    return 0;
+  }
+  return last;
+
+} /* catalog_SFT_bins() */
+
+
+/*
+   Check from the catalog that the 'numSegments' segments descs[order[0]], descs[order[1]], ...
+   of SFT number 'isft', in order of increasing frequency, don't overlap within [firstbin, lastbin].
+   Returns XLAL_SUCCESS, or XLAL_FAILURE after printing an error message.
+*/
+static int
+check_SFT_segments_overlap ( const SFTDescriptor *descs, const UINT4 *order, UINT4 numSegments,
+			     UINT4 isft, UINT4 firstbin, UINT4 lastbin )
+{
+  const SFTDescriptor *prev = NULL;
+  UINT4 prevLast = 0;
+
+  for(UINT4 iseg = 0; iseg < numSegments; iseg++) {
+    const SFTDescriptor *desc = &descs[order[iseg]];
+    UINT4 first;
+    UINT4 last = catalog_SFT_bins ( desc, firstbin, lastbin, &first );
+    if(!last)
+      continue;
+    if(prev && first <= prevLast) {
+      XLALPrintError("ERROR: data overlap in SFT#%u (GPS %lf)"
+		     " between bin %u in file '%s' and bin %u in file '%s'\n",
+		     isft, GPS2REAL8(desc->header.epoch),
+		     prevLast, prev->locator->fname, first, desc->locator->fname);
+      XLAL_ERROR(XLAL_EIO);
+    }
+    prev = desc;
+    prevLast = last;
+  }
+
+  return XLAL_SUCCESS;
 
-    struct tagSFTLocator*locator = locatalog.data[catPos].locator;
-    UINT4 isft = locator->isft;;
+} /* check_SFT_segments_overlap() */
+
+
+/*
+   Read the 'numSegments' segments descs[0], descs[1], ..., which all lie in the same file, and
+   copy their bins within [firstbin, lastbin] into the SFTs of 'sfts' they belong to; what was
+   read from descs[i] is recorded in reads[i]. 'thisSFT' is a buffer for reading a single segment,
+   and 'view' is the file currently opened by the calling thread.
+   Returns XLAL_SUCCESS, or XLAL_FAILURE after printing an error message.
+*/
+static int
+read_SFT_file_segments ( SFTVector *sfts, SFTBinsRead *reads, SFTtype *thisSFT, SFTFileView *view,
+			 const SFTDescriptor *descs, UINT4 numSegments,
+			 UINT4 firstbin, UINT4 lastbin, REAL8 deltaF )
+{
+  for(UINT4 iseg = 0; iseg < numSegments; iseg++) {
+
+    const SFTDescriptor *desc = &descs[iseg];
+    struct tagSFTLocator*locator = desc->locator;
+    const char *fname = locator->fname;
+    SFTBinsRead *read = &reads[iseg];
+    const COMPLEX8 *bins;
     UINT4 firstBinRead;
     UINT4 lastBinRead;
 
-    if (locatalog.data[catPos].header.data) {
-      /* the SFT data has already been read into the catalog,
-	 copy the relevant part to thisSFT */
+    if (desc->header.data) {
+      /* the SFT data has already been read into the catalog */
 
-      volatile REAL8 tmp = locatalog.data[catPos].header.f0 / deltaF;
+      volatile REAL8 tmp = desc->header.f0 / deltaF;
       UINT4 firstSFTbin = lround ( tmp );
-      UINT4 lastSFTbin = firstSFTbin + locatalog.data[catPos].numBins - 1;
-      UINT4 firstBin2read = firstbin;
-      UINT4 lastBin2read = lastbin;
-      UINT4 numBins2read, offsetBins;
-
-      /* limit the interval to be read to what's actually in the SFT */
-      if ( firstBin2read < firstSFTbin )
-	firstBin2read = firstSFTbin;
-      if ( lastBin2read > lastSFTbin )
-	lastBin2read = lastSFTbin;
-
-      /* check that requested interval is found in SFT */
-      if ( firstBin2read <= lastBin2read ) {
-
-	 /* keep a copy of the data pointer */
-	COMPLEX8Sequence*data = thisSFT->data;
-
-	firstBinRead = firstBin2read;
-	lastBinRead = lastBin2read;
-	offsetBins = firstBin2read - firstSFTbin;
-	numBins2read = lastBin2read - firstBin2read + 1;
-
-	/* copy the header */
-	*thisSFT = locatalog.data[catPos].header;
-	/* restore data pointer */
-	thisSFT->data = data;
-	/* copy the data */
-	memcpy(thisSFT->data->data,
-	       locatalog.data[catPos].header.data + offsetBins,
-	       numBins2read * sizeof(COMPLEX8));
-
-	/* update the start-frequency entry in the SFT-header to the new value */
-	thisSFT->f0 = 1.0 * firstBin2read * thisSFT->deltaF;
+      UINT4 lastSFTbin = firstSFTbin + desc->numBins - 1;
+
+      /* limit the interval to what's actually in the SFT */
+      firstBinRead = ( firstbin > firstSFTbin ) ? firstbin : firstSFTbin;
+      lastBinRead = ( lastbin < lastSFTbin ) ? lastbin : lastSFTbin;
 
+      if ( firstBinRead <= lastBinRead ) {
+	bins = desc->header.data->data + ( firstBinRead - firstSFTbin );
       } else {
 	/* no data was needed from this SFT (segment) */
 	firstBinRead = 0;
 	lastBinRead = 0;
+	bins = NULL;
       }
+      read->epoch = desc->header.epoch;
+      read->deltaF = desc->header.deltaF;
 
     } else {
       /* SFT data had not yet been read - read it */
 
       /* open and close a file only when necessary, i.e. reading a different file */
-      if(strcmp(fname, locator->fname)) {
-	if(fp) {
-	  fclose(fp);
-	  fp = NULL;
-	}
-	fname = locator->fname;
-	fp = fopen(fname,"rb");
-	XLALPrintInfo("%s: Opening file '%s'\n", __func__, fname);
-	if(!fp) {
-	  XLALPrintError("ERROR: Couldn't open file '%s'\n", fname);
-	  XLALLOADSFTSERROR(XLAL_EIO);
-	}
+      if ( open_SFTFileView ( view, fname ) != XLAL_SUCCESS ) {
+	XLALPrintError("ERROR: Couldn't open file '%s'\n", fname);
+	XLAL_ERROR(XLAL_EIO);
       }
 
-      /* seek to the position of the SFT in the file (if necessary) */
-      if ( locator->offset )
-	if ( fseek( fp, locator->offset, SEEK_SET ) == -1 ) {
-	  XLALPrintError("ERROR: Couldn't seek to position %ld in file '%s'\n",
-			 locator->offset, fname);
-	  XLALLOADSFTSERROR(XLAL_EIO);
-	}
+      /* seek to the position of the SFT in the file */
+      if ( fseek( view->fp, locator->offset, SEEK_SET ) == -1 ) {
+	XLALPrintError("ERROR: Couldn't seek to position %ld in file '%s'\n",
+		       locator->offset, fname);
+	XLAL_ERROR(XLAL_EIO);
+      }
 
       /* read SFT data */
-      lastBinRead = read_sft_bins_from_fp ( thisSFT, &firstBinRead, firstbin, lastbin, fp );
+      lastBinRead = read_sft_bins_from_fp ( thisSFT, &firstBinRead, firstbin, lastbin, view->fp, view->map, view->maplen );
       XLALPrintInfo ("%s: Read data from %s:%lu: %u - %u\n", __func__, locator->fname, locator->offset, firstBinRead, lastBinRead);
+
+      if ( !lastBinRead && firstBinRead ) {
+	/* failed to read data */
+	XLALPrintError("ERROR: Error (%u) reading SFT from file '%s'\n", firstBinRead, fname);
+	XLAL_ERROR(XLAL_EIO);
+      }
+      bins = thisSFT->data->data;
+      read->epoch = thisSFT->epoch;
+      read->deltaF = thisSFT->deltaF;
     }
     /* SFT data has been read from file or taken from catalog */
 
-    if(lastBinRead) {
+    /* only the bins checked by check_SFT_segments_overlap() may be copied into the SFT */
+    {
+      UINT4 firstCatBin;
+      UINT4 lastCatBin = catalog_SFT_bins ( desc, firstbin, lastbin, &firstCatBin );
+      if ( lastBinRead != lastCatBin || firstBinRead != firstCatBin ) {
+	XLALPrintError("ERROR: bins %u - %u read from file '%s' differ from its catalog entry (bins %u - %u)\n",
+		       firstBinRead, lastBinRead, fname, firstCatBin, lastCatBin);
+	XLAL_ERROR(XLAL_EIO);
+      }
+    }
+
+    read->first = firstBinRead;
+    read->last = lastBinRead;
+    if ( lastBinRead )
+      memcpy ( sfts->data[locator->isft].data->data + ( firstBinRead - firstbin ), bins,
+	       ( lastBinRead - firstBinRead + 1 ) * sizeof(COMPLEX8) );
+  }
+
+  return XLAL_SUCCESS;
+
+} /* read_SFT_file_segments() */
+
+
+/*
+   Check that the bins read from the 'numSegments' segments descs[order[0]], descs[order[1]], ...
+   of SFT number 'isft', in order of increasing frequency, fit together; the bins read from
+   descs[i] are described by reads[i], and have already been copied into 'sft'.
+   Returns XLAL_SUCCESS, or XLAL_FAILURE after printing an error message.
+*/
+static int
+check_SFT_segments ( SFTtype *sft, SFTReadSegment *segment, const SFTDescriptor *descs, const SFTBinsRead *reads,
+		     const UINT4 *order, UINT4 numSegments, UINT4 isft, UINT4 firstbin, REAL8 deltaF )
+{
+  for(UINT4 iseg = 0; iseg < numSegments; iseg++) {
+
+    const SFTDescriptor *desc = &descs[order[iseg]];
+    const SFTBinsRead *read = &reads[order[iseg]];
+    struct tagSFTLocator*locator = desc->locator;
+    const char *fname = locator->fname;
+
+    if(read->last) {
 	/* data was actually read */
 
-	if(segments[isft].last == 0) {
+	if(segment->last == 0) {
 
 	  /* no data was read for this SFT yet: must be first segment */
-	  if(firstBinRead != firstbin) {
+	  if(read->first != firstbin) {
 	    XLALPrintError("ERROR: data gap or overlap at first bin of SFT#%u (GPS %lf)"
 			   " expected bin %u, bin %u read from file '%s'\n",
-			   isft, GPS2REAL8(thisSFT->epoch),
-			   firstbin, firstBinRead, fname);
-	    XLALLOADSFTSERROR(XLAL_EIO);
+			   isft, GPS2REAL8(read->epoch),
+			   firstbin, read->first, fname);
+	    XLAL_ERROR(XLAL_EIO);
 	  }
-	  segments[isft].first = firstBinRead;
-	  segments[isft].epoch = thisSFT->epoch;
+	  segment->first = read->first;
+	  segment->epoch = read->epoch;
 
 	/* if not first segment, segment must fit at the end of previous data */
-	} else if(firstBinRead != segments[isft].last + 1) {
+	} else if(read->first != segment->last + 1) {
 	  XLALPrintError("ERROR: data gap or overlap in SFT#%u (GPS %lf)"
 			 " between bin %u read from file '%s' and bin %u read from file '%s'\n",
-			 isft, GPS2REAL8(thisSFT->epoch),
-			 segments[isft].last, segments[isft].lastfrom->fname,
-			 firstBinRead, fname);
-	  XLALLOADSFTSERROR(XLAL_EIO);
+			 isft, GPS2REAL8(read->epoch),
+			 segment->last, segment->lastfrom->fname,
+			 read->first, fname);
+	  XLAL_ERROR(XLAL_EIO);
 	}
 
 	/* consistency checks */
-	if(deltaF != thisSFT->deltaF) {
+	if(deltaF != read->deltaF) {
 	  XLALPrintError("ERROR: deltaF mismatch (%f/%f) in SFT read from file '%s'\n",
-			 thisSFT->deltaF, deltaF, fname);
-	  XLALLOADSFTSERROR(XLAL_EIO);
+			 read->deltaF, deltaF, fname);
+	  XLAL_ERROR(XLAL_EIO);
 	}
-	if(!GPSEQUAL(segments[isft].epoch, thisSFT->epoch)) {
+	if(!GPSEQUAL(segment->epoch, read->epoch)) {
 	  XLALPrintError("ERROR: GPS epoch mismatch (%f/%f) in SFT read from file '%s'\n",
-			 GPS2REAL8(segments[isft].epoch), GPS2REAL8(thisSFT->epoch), fname);
-	  XLALLOADSFTSERROR(XLAL_EIO);
+			 GPS2REAL8(segment->epoch), GPS2REAL8(read->epoch), fname);
+	  XLAL_ERROR(XLAL_EIO);
 	}
 
-	/* data is ok, add to SFT */
-	segments[isft].last               = lastBinRead;
-	segments[isft].lastfrom           = locator;
-        memcpy( sftVector->data[isft].name, locatalog.data[catPos].header.name, sizeof(sftVector->data[isft].name));
-	sftVector->data[isft].sampleUnits = locatalog.data[catPos].header.sampleUnits;
-	memcpy(sftVector->data[isft].data->data + (firstBinRead - firstbin),
-	       thisSFT->data->data,
-	       (lastBinRead - firstBinRead + 1) * sizeof(COMPLEX8));
+	/* data is ok, it has already been copied into the SFT */
+	segment->last               = read->last;
+	segment->lastfrom           = locator;
+        memcpy( sft->name, desc->header.name, sizeof(sft->name));
+	sft->sampleUnits = desc->header.sampleUnits;
 
-      } else if(!firstBinRead) {
+      } else {
 	/* no needed data had been in this segment */
         XLALPrintInfo ( "%s: No data read from %s:%lu\n", __func__, locator->fname, locator->offset);
 
 	/* set epoch if not yet set, if already set, check it */
-	if(GPSZERO(segments[isft].epoch))
-	  segments[isft].epoch = thisSFT->epoch;
-	else if (!GPSEQUAL(segments[isft].epoch, thisSFT->epoch)) {
+	if(GPSZERO(segment->epoch))
+	  segment->epoch = read->epoch;
+	else if (!GPSEQUAL(segment->epoch, read->epoch)) {
 	  XLALPrintError("ERROR: GPS epoch mismatch (%f/%f) in SFT read from file '%s'\n",
-			 GPS2REAL8(segments[isft].epoch), GPS2REAL8(thisSFT->epoch), fname);
-	  XLALLOADSFTSERROR(XLAL_EIO);
+			 GPS2REAL8(segment->epoch), GPS2REAL8(read->epoch), fname);
+	  XLAL_ERROR(XLAL_EIO);
 	}
-
-      } else {
-	/* failed to read data */
-
-	XLALPrintError("ERROR: Error (%u) reading SFT from file '%s'\n", firstBinRead, fname);
-	XLALLOADSFTSERROR(XLAL_EIO);
       }
   }
 
-  /* close the last file */
-  if(fp) {
-    fclose(fp);
-    fp = NULL;
-  }
+  return XLAL_SUCCESS;
 
-  /* check that all SFTs are complete */
-  for(UINT4 isft = 0; isft < nSFTs; isft++) {
-    if(segments[isft].last == lastbin) {
-      sftVector->data[isft].f0 = 1.0 * firstbin * deltaF;
-      sftVector->data[isft].epoch = segments[isft].epoch;
-      sftVector->data[isft].deltaF = deltaF;
-    } else {
-      if (segments[isft].last)
-	XLALPrintError("ERROR: data missing at end of SFT#%u (GPS %lf)"
-		       " expected bin %u, bin %u read from file '%s'\n",
-		       isft, GPS2REAL8(segments[isft].epoch),
-		       lastbin, segments[isft].last,
-		       segments[isft].lastfrom->fname);
-      else
-	XLALPrintError("ERROR: no data could be read for SFT#%u (GPS %lf)\n",
-		       isft, GPS2REAL8(segments[isft].epoch));
-      XLALLOADSFTSERROR(XLAL_EIO);
+} /* check_SFT_segments() */
+
+
+/*
+   Make 'view' refer to the file 'fname': if a different file is currently open, it is closed first.
+   Where supported, the whole file is mapped read-only into memory, so that frequency bins can be
+   copied out of the mapping without further system calls; if mapping fails, reading falls back to
+   fseek()/fread() on the file pointer.
+*/
+static int
+open_SFTFileView ( SFTFileView *view, const CHAR *fname )
+{
+  if ( view->fname != NULL && strcmp ( view->fname, fname ) == 0 )
+    return XLAL_SUCCESS;
+
+  close_SFTFileView ( view );
+
+  XLALPrintInfo("%s: Opening file '%s'\n", __func__, fname);
+  if ( (view->fp = fopen ( fname, "rb" )) == NULL )
+    XLAL_ERROR ( XLAL_EIO, "Failed to open SFT '%s' for reading: %s\n", fname, strerror(errno) );
+  view->fname = fname;
+
+#ifdef HAVE_SYS_MMAN_H
+  {
+    struct stat st;
+    if ( fstat ( fileno ( view->fp ), &st ) == 0 && st.st_size > 0 ) {
+      void *map = mmap ( NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fileno ( view->fp ), 0 );
+      if ( map != MAP_FAILED ) {
+	view->map = map;
+	view->maplen = (size_t)st.st_size;
+      }
     }
   }
+#endif
 
-  /* cleanup  */
-  XLALFree(segments);
-  XLALFree(locatalog.data);
-  XLALDestroySFT(thisSFT);
+  return XLAL_SUCCESS;
 
-  return(sftVector);
+} /* open_SFTFileView() */
 
-} /* XLALLoadSFTs() */
+
+/* close the file referred to by 'view', if any */
+static void
+close_SFTFileView ( SFTFileView *view )
+{
+#ifdef HAVE_SYS_MMAN_H
+  if ( view->map != NULL )
+    munmap ( (void*)view->map, view->maplen );
+#endif
+  if ( view->fp != NULL )
+    fclose ( view->fp );
+  view->fname = NULL;
+  view->fp = NULL;
+  view->map = NULL;
+  view->maplen = 0;
+} /* close_SFTFileView() */
 
 
 /**
@@ -1023,6 +1448,9 @@ XLALLoadMultiSFTs (const SFTCatalog *inputCatalog,   /**< The 'catalogue' of SFT
  * actual work.
  *
  * Note2: we keep the IFO sort-order of the input multiCatalogView
+ *
+ * Note3: the detectors are loaded one after the other, since XLALLoadSFTs() already
+ * shares out the SFTs of each detector between OpenMP threads (if enabled)
  */
 MultiSFTVector *
 XLALLoadMultiSFTsFromView ( const MultiSFTCatalogView *multiCatalogView,/**< The multi-SFT catalogue view of SFTs to load */
@@ -1145,7 +1573,8 @@ XLALReadTimestampsFileConstrained ( const CHAR *fname, const LIGOTimeGPS *minGPS
  * and XLAL_FAILURE otherwise.
  *
  * \note: because this function has to read the complete SFT data into memory it is
- * potentially slow and memory-intensive.
+ * potentially slow and memory-intensive. The SFTs are checked in parallel if OpenMP is
+ * enabled; since the check is not needed for loading SFTs, callers should make it optional.
  */
 int
 XLALCheckCRCSFTCatalog(
@@ -1160,11 +1589,19 @@ XLALCheckCRCSFTCatalog(
   /* CRC checks are assumed to pass until one fails */
   *crc_check = 1;
 
-  /* step through SFTs and check CRC64 */
+  /* step through SFTs and check CRC64; SFTs are independent of each other,
+     and are shared out between OpenMP threads (if enabled) */
+  int errcode = XLAL_SUCCESS;
+  BOOLEAN crc_failed = 0;
+#pragma omp parallel for schedule(dynamic) if (catalog->length > 1)
   for ( UINT4 i=0; i < catalog->length; i ++ )
     {
       FILE *fp;
 
+#pragma omp flush(errcode, crc_failed)
+      if ( errcode != XLAL_SUCCESS || crc_failed )
+        continue;
+
       switch ( catalog->data[i].version  )
 	{
 	case 1:	/* version 1 had no CRC  */
@@ -1172,29 +1609,36 @@ XLALCheckCRCSFTCatalog(
 	case 2:
 	  if ( (fp = fopen_SFTLocator ( catalog->data[i].locator )) == NULL )
 	    {
-	      XLALPrintError ( "Failed to open locator '%s'\n",
-			      XLALshowSFTLocator ( catalog->data[i].locator ) );
-              return XLAL_FAILURE;
+	      XLALPrintError ( "Failed to open locator '%s : %ld'\n",
+			      catalog->data[i].locator->fname, catalog->data[i].locator->offset );
+              errcode = XLAL_EIO;
+#pragma omp flush(errcode)
+              continue;
 	    }
 	  if ( !(has_valid_v2_crc64 ( fp ) != 0) )
 	    {
-	      XLALPrintError ( "CRC64 checksum failure for SFT '%s'\n",
-			      XLALshowSFTLocator ( catalog->data[i].locator ) );
-              *crc_check = 0;
-	      fclose(fp);
-              return XLAL_SUCCESS;
+	      XLALPrintError ( "CRC64 checksum failure for SFT '%s : %ld'\n",
+			      catalog->data[i].locator->fname, catalog->data[i].locator->offset );
+              crc_failed = 1;
+#pragma omp flush(crc_failed)
 	    }
 	  fclose(fp);
 	  break;
 
 	default:
 	  XLALPrintError ( "Illegal SFT-version encountered : %d\n", catalog->data[i].version );
-          return XLAL_FAILURE;
+          errcode = XLAL_EIO;
+#pragma omp flush(errcode)
 	  break;
 	} /* switch (version ) */
 
     } /* for i < numSFTs */
 
+  if ( errcode != XLAL_SUCCESS )
+    return XLAL_FAILURE;
+
+  *crc_check = !crc_failed;
+
   return XLAL_SUCCESS;
 
 } /* XLALCheckCRCSFTCatalog() */
@@ -1986,6 +2430,207 @@ fopen_SFTLocator ( const struct tagSFTLocator *locator )
  ***********************************************************************/
 
 
+/*
+   Return true if an SFT with the given header satisfies the user-constraints.
+   v1-SFTs have '??' as detector-name, which is set to the detector-constraint (if given).
+*/
+static BOOLEAN
+SFT_block_wanted ( SFTtype *header, const SFTConstraints *constraints )
+{
+  if ( constraints == NULL )
+    return TRUE;
+
+  if ( constraints->detector && strncmp(constraints->detector, "??", 2) )
+    {
+      /* v1-SFTs have '??' as detector-name */
+      if ( ! strncmp (header->name, "??", 2 ) ) {
+	strncpy ( header->name, constraints->detector, 2 );	/* SET to constraint! */
+      }
+      else if ( strncmp( constraints->detector, header->name, 2) ) {
+	return FALSE;
+      }
+    }
+
+  if ( XLALCWGPSinRange(header->epoch, constraints->minStartTime, constraints->maxStartTime) != 0 ) {
+    return FALSE;
+  }
+
+  if ( constraints->timestamps && !timestamp_in_list(header->epoch, constraints->timestamps) ) {
+    return FALSE;
+  }
+
+  return TRUE;
+
+} /* SFT_block_wanted() */
+
+
+/* return true if 'fname' names a single file starting with the SFT catalog index magic string */
+static BOOLEAN
+is_SFT_catalog_index ( const CHAR *fname )
+{
+  if ( is_pattern ( fname ) || strchr ( fname, ';' ) != NULL )
+    return FALSE;
+
+  FILE *fp = LALFopen ( fname, "rb" );
+  if ( fp == NULL )
+    return FALSE;
+
+  CHAR magic[8];
+  BOOLEAN ret = ( fread ( magic, sizeof(magic), 1, fp ) == 1 ) && ( memcmp ( magic, SFT_INDEX_MAGIC, sizeof(magic) ) == 0 );
+  fclose ( fp );
+
+  return ret;
+
+} /* is_SFT_catalog_index() */
+
+
+/*
+   Append the SFTs in the catalog index 'fname' that satisfy the user-constraints to 'ret',
+   which holds '*numSFTs' SFTs (and is allocated blockwise, as in XLALSFTdataFind()).
+   Since the index is sorted by detector and timestamp, only the entries of the wanted
+   detectors and within [minStartTime, maxStartTime) are visited.
+*/
+static int
+read_SFT_catalog_index ( SFTCatalog *ret, UINT4 *numSFTs, const CHAR *fname, const SFTConstraints *constraints )
+{
+  FILE *fp = NULL;
+  _SFT_index_entry_t *entries = NULL;
+  CHAR *names = NULL;
+  const CHAR **fnames = NULL;
+
+  /* read header, entries and file names */
+  _SFT_index_header_t header;
+  XLAL_CHECK_FAIL ( (fp = LALFopen ( fname, "rb" )) != NULL, XLAL_EIO, "Failed to open SFT catalog index '%s': %s\n", fname, strerror(errno) );
+  XLAL_CHECK_FAIL ( fread ( &header, sizeof(header), 1, fp ) == 1, XLAL_EIO, "Failed to read header of SFT catalog index '%s'\n", fname );
+  XLAL_CHECK_FAIL ( memcmp ( header.magic, SFT_INDEX_MAGIC, sizeof(header.magic) ) == 0, XLAL_EDATA, "'%s' is not an SFT catalog index\n", fname );
+  XLAL_CHECK_FAIL ( header.version == SFT_INDEX_VERSION, XLAL_EDATA,
+                    "SFT catalog index '%s' has format version %u != %u, or was written with a different byte order\n", fname, header.version, SFT_INDEX_VERSION );
+  const UINT4 N = header.numEntries;
+  XLAL_CHECK_FAIL ( (entries = XLALMalloc ( (N + 1) * sizeof(entries[0]) )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( fread ( entries, sizeof(entries[0]), N, fp ) == N, XLAL_EIO, "Failed to read entries of SFT catalog index '%s'\n", fname );
+  XLAL_CHECK_FAIL ( (names = XLALMalloc ( header.namesLength + 1 )) != NULL, XLAL_ENOMEM );
+  XLAL_CHECK_FAIL ( fread ( names, 1, header.namesLength, fp ) == header.namesLength, XLAL_EIO, "Failed to read file names of SFT catalog index '%s'\n", fname );
+  names[header.namesLength] = '\0';
+  XLAL_CHECK_FAIL ( (fnames = XLALMalloc ( (header.numFiles + 1) * sizeof(fnames[0]) )) != NULL, XLAL_ENOMEM );
+  {
+    const CHAR *ptr = names;
+    for ( UINT4 k = 0; k < header.numFiles; k ++ ) {
+      XLAL_CHECK_FAIL ( ptr < names + header.namesLength, XLAL_EDATA, "SFT catalog index '%s' is truncated\n", fname );
+      fnames[k] = ptr;
+      ptr += strlen ( ptr ) + 1;
+    }
+  }
+  const long comments_start = sizeof(header) + N * sizeof(entries[0]) + header.namesLength;
+
+  const BOOLEAN any_detector = ( constraints == NULL || constraints->detector == NULL || strncmp ( constraints->detector, "??", 2 ) == 0 );
+  UINT4 i = 0;
+  while ( i < N )
+    {
+      /* find the entries [i, iend) of this detector */
+      const CHAR *det = entries[i].detector;
+      UINT4 lo = i, hi = N;
+      while ( lo < hi ) {
+        UINT4 mid = lo + ( hi - lo ) / 2;
+        if ( strncmp ( entries[mid].detector, det, 2 ) <= 0 ) {
+          lo = mid + 1;
+        } else {
+          hi = mid;
+        }
+      }
+      const UINT4 iend = lo;
+
+      /* v1-SFTs have '??' as detector-name, and match any detector-constraint */
+      if ( !( any_detector || strncmp ( det, "??", 2 ) == 0 || strncmp ( det, constraints->detector, 2 ) == 0 ) ) {
+        i = iend;
+        continue;
+      }
+
+      /* skip to the first entry with timestamp >= minStartTime */
+      lo = i;
+      hi = iend;
+      if ( constraints != NULL && constraints->minStartTime != NULL ) {
+        while ( lo < hi ) {
+          UINT4 mid = lo + ( hi - lo ) / 2;
+          LIGOTimeGPS epoch = { entries[mid].gps_sec, entries[mid].gps_nsec };
+          if ( XLALGPSCmp ( &epoch, constraints->minStartTime ) < 0 ) {
+            lo = mid + 1;
+          } else {
+            hi = mid;
+          }
+        }
+      }
+
+      for ( UINT4 j = lo; j < iend; j ++ )
+        {
+          const _SFT_index_entry_t *entry = &entries[j];
+          SFTtype XLAL_INIT_DECL(this_header);
+          this_header.name[0] = entry->detector[0];
+          this_header.name[1] = entry->detector[1];
+          this_header.epoch.gpsSeconds = entry->gps_sec;
+          this_header.epoch.gpsNanoSeconds = entry->gps_nsec;
+          this_header.f0 = entry->f0;
+          this_header.deltaF = entry->deltaF;
+
+          /* entries are sorted by timestamp: stop at maxStartTime */
+          if ( constraints != NULL && constraints->maxStartTime != NULL && XLALGPSCmp ( &this_header.epoch, constraints->maxStartTime ) >= 0 ) {
+            break;
+          }
+          if ( !SFT_block_wanted ( &this_header, constraints ) ) {
+            continue;
+          }
+          XLAL_CHECK_FAIL ( entry->file < header.numFiles, XLAL_EDATA, "SFT catalog index '%s' is corrupted\n", fname );
+
+          /* do we need to alloc more memory for the SFTs? */
+          if ( *numSFTs + 1 > ret->length ) {
+            XLAL_CHECK_FAIL ( (ret->data = LALRealloc ( ret->data, (ret->length + SFTFILEIO_REALLOC_BLOCKSIZE) * sizeof(ret->data[0]) )) != NULL, XLAL_ENOMEM );
+            memset ( &(ret->data[ret->length]), 0, SFTFILEIO_REALLOC_BLOCKSIZE * sizeof(ret->data[0]) );
+            ret->length += SFTFILEIO_REALLOC_BLOCKSIZE;
+          }
+
+          SFTDescriptor *desc = &(ret->data[*numSFTs]);
+          (*numSFTs) ++;
+
+          XLAL_CHECK_FAIL ( (desc->locator = XLALCalloc ( 1, sizeof(*(desc->locator)) )) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK_FAIL ( (desc->locator->fname = XLALStringDuplicate ( fnames[entry->file] )) != NULL, XLAL_EFUNC );
+          desc->locator->offset = entry->offset;
+
+          if ( entry->comment_length > 0 ) {
+            XLAL_CHECK_FAIL ( (desc->comment = XLALMalloc ( entry->comment_length )) != NULL, XLAL_ENOMEM );
+            XLAL_CHECK_FAIL ( fseek ( fp, comments_start + (long)entry->comment_offset, SEEK_SET ) == 0, XLAL_EIO, "Failed to seek in SFT catalog index '%s'\n", fname );
+            XLAL_CHECK_FAIL ( fread ( desc->comment, 1, entry->comment_length, fp ) == entry->comment_length, XLAL_EIO, "Failed to read comment from SFT catalog index '%s'\n", fname );
+            XLAL_CHECK_FAIL ( desc->comment[entry->comment_length - 1] == '\0', XLAL_EDATA, "SFT catalog index '%s' is corrupted\n", fname );
+          }
+
+          desc->header  = this_header;
+          desc->numBins = entry->numBins;
+          desc->version = entry->version;
+          desc->crc64   = entry->crc64;
+
+        } /* for j < iend */
+
+      i = iend;
+
+    } /* while i < N */
+
+  fclose ( fp );
+  XLALFree ( entries );
+  XLALFree ( names );
+  XLALFree ( fnames );
+
+  return XLAL_SUCCESS;
+
+XLAL_FAIL:
+  if ( fp != NULL ) {
+    fclose ( fp );
+  }
+  XLALFree ( entries );
+  XLALFree ( names );
+  XLALFree ( fnames );
+  return XLAL_FAILURE;
+
+} /* read_SFT_catalog_index() */
+
+
 static BOOLEAN
 timestamp_in_list( LIGOTimeGPS timestamp, LIGOTimeGPSVector *list )
 {
@@ -3052,6 +3697,27 @@ compareSFTloc(const void *ptr1, const void *ptr2)
 } /* compareSFTloc() */
 
 
+/* compare two pointers to SFT-descriptors by detector, GPS-epoch, then starting frequency */
+static int
+compareSFTindex ( const void *ptr1, const void *ptr2 )
+{
+  const SFTDescriptor *desc1 = *(const SFTDescriptor * const *)ptr1;
+  const SFTDescriptor *desc2 = *(const SFTDescriptor * const *)ptr2;
+  int s = strncmp ( desc1->header.name, desc2->header.name, 2 );
+  if ( s != 0 )
+    return s;
+  return compareSFTdesc ( desc1, desc2 );
+} /* compareSFTindex() */
+
+
+/* compare two pointers to strings */
+static int
+compareStringPtrs ( const void *ptr1, const void *ptr2 )
+{
+  return strcmp ( *(const CHAR * const *)ptr1, *(const CHAR * const *)ptr2 );
+} /* compareStringPtrs() */
+
+
 /* compare two SFT-catalog by detector name in alphabetic order */
 static int
 compareDetNameCatalogs ( const void *ptr1, const void *ptr2 )
@@ -102,6 +102,10 @@ extern "C" {
  * constraints->detector==NULL, except that it allows v1-SFTs to be returned with
  * detector-name set to "??"'.
  *
+ * <b>Note 5:</b> Instead of a file-pattern, XLALSFTdataFind() also accepts the name of an SFT
+ * catalog index written by XLALWriteSFTCatalogIndex() (e.g.\ using \c lalpulsar_MakeSFTIndex).
+ * The SFTs satisfying the constraints are then looked up in the index, without opening any SFT-file.
+ *
  * The returned SFTCatalog is a vector of 'SFTDescriptor's describing one SFT, with the fields
  * - \c locator:  an opaque data-type describing where to read this SFT from.
  * - \c header:	the SFts header
@@ -289,6 +293,7 @@ int XLALCWGPSinRange( const LIGOTimeGPS gps, const LIGOTimeGPS* minGPS, const LI
 LALStringVector *XLALFindFiles (const CHAR *globstring);
 
 SFTCatalog *XLALSFTdataFind ( const CHAR *file_pattern, const SFTConstraints *constraints );
+int XLALWriteSFTCatalogIndex ( const SFTCatalog *catalog, const CHAR *fname );
 
 int XLALWriteSFTVector2Dir  ( const SFTVector *sftVect, const CHAR *dirname, const CHAR *SFTcomment, const CHAR *Misc );
 int XLALWriteSFTVector2File ( const SFTVector *sftVect, const CHAR *dirname, const CHAR *SFTcomment, const CHAR *Misc );
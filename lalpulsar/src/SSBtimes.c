@@ -21,6 +21,7 @@
 
 /*---------- INCLUDES ----------*/
 #include <math.h>
+#include <string.h>
 
 #include <lal/SSBtimes.h>
 #include <lal/AVFactories.h>
@@ -30,6 +31,8 @@
 #include <gsl/gsl_roots.h>
 
 /*---------- local DEFINES ----------*/
+/** number of sky-locations computed together by XLALGetSSBtimesBatch() */
+#define SSB_BATCH_BLOCK 64
 
 /*----- Macros ----- */
 
@@ -699,6 +702,254 @@ XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, /**< [in]
 
 } /* XLALGetMultiSSBtimes() */
 
+/**
+ * Compute the SSB-timings of the sky-locations <tt>skypos[k0 ... k0+nk-1]</tt>, with <tt>nk <= SSB_BATCH_BLOCK</tt>,
+ * for all timestamps of \c DetectorStates; used by XLALGetSSBtimesBatch()
+ */
+static int
+get_SSBtimes_block ( SSBtimes **tSSB, const DetectorStateSeries *DetectorStates, const REAL8 *tRel,
+                     const SkyPosition *skypos, const UINT4 k0, const UINT4 nk, SSBprecision precision, BarycenterBuffer **bBuffer )
+{
+  const UINT4 numSteps = DetectorStates->length;
+  REAL8 vn[3][SSB_BATCH_BLOCK];		/* unit-vectors pointing to sources in Cart. coord. */
+  REAL8 DeltaT[SSB_BATCH_BLOCK], Tdot[SSB_BATCH_BLOCK];
+
+  switch (precision)
+    {
+    case SSBPREC_NEWTONIAN:	/* use simple vr.vn to calculate time-delay */
+
+      for ( UINT4 k = 0; k < nk; k++ )
+        {
+          const REAL8 alpha = skypos[k0 + k].longitude;
+          const REAL8 delta = skypos[k0 + k].latitude;
+          vn[0][k] = cos(alpha) * cos(delta);
+          vn[1][k] = sin(alpha) * cos(delta);
+          vn[2][k] = sin(delta);
+        }
+
+      for ( UINT4 i = 0; i < numSteps; i++ )
+        {
+          const REAL8 *rDetector = DetectorStates->data[i].rDetector;
+          const REAL8 *vDetector = DetectorStates->data[i].vDetector;
+          for ( UINT4 k = 0; k < nk; k++ )
+            {
+              tSSB[k0 + k]->DeltaT->data[i] = tRel[i] + rDetector[0] * vn[0][k] + rDetector[1] * vn[1][k] + rDetector[2] * vn[2][k];
+              tSSB[k0 + k]->Tdot->data[i] = 1.0 + vDetector[0] * vn[0][k] + vDetector[1] * vn[1][k] + vDetector[2] * vn[2][k];
+            }
+        } /* for i < numSteps */
+
+      break;
+
+    case SSBPREC_RELATIVISTIC:
+    case SSBPREC_RELATIVISTICOPT:	/* use batched version XLALBarycenterOptBatch() */
+
+      for ( UINT4 k = 0; k < nk; k++ )
+        {
+          const REAL8 alpha = skypos[k0 + k].longitude;
+          const REAL8 delta = skypos[k0 + k].latitude;
+          /* check that alpha and delta are in reasonable range, as in XLALBarycenterOpt() */
+          XLAL_CHECK ( fabs(alpha) <= LAL_TWOPI, XLAL_EDOM, "alpha = %f outside of allowed range [-2pi,2pi]\n", alpha );
+          XLAL_CHECK ( fabs(delta) <= LAL_PI_2,  XLAL_EDOM, "delta = %f outside of allowed range [-pi/2,pi/2]\n", delta );
+          /* compute the unit vector as XLALBarycenterOpt() does */
+          const REAL8 sinDelta = cos ( LAL_PI/2.0 - delta );
+          const REAL8 cosDelta = sin ( LAL_PI/2.0 - delta );
+          vn[0][k] = cosDelta * cos ( alpha );
+          vn[1][k] = cosDelta * sin ( alpha );
+          vn[2][k] = sinDelta;
+        }
+
+      {
+        BarycenterInput XLAL_INIT_DECL(baryinput);
+        baryinput.site = DetectorStates->detector;
+        baryinput.site.location[0] /= LAL_C_SI;
+        baryinput.site.location[1] /= LAL_C_SI;
+        baryinput.site.location[2] /= LAL_C_SI;
+        baryinput.dInv = 0;
+
+        for ( UINT4 i = 0; i < numSteps; i++ )
+          {
+            const DetectorState *state = &(DetectorStates->data[i]);
+            baryinput.tgps = state->tGPS;
+
+            XLAL_CHECK ( XLALBarycenterOptBatch ( DeltaT, Tdot, vn[0], vn[1], vn[2], nk, &baryinput, &(state->earthState), bBuffer ) == XLAL_SUCCESS,
+                         XLAL_EFUNC, "XLALBarycenterOptBatch() failed with xlalErrno = %d\n", xlalErrno );
+
+            for ( UINT4 k = 0; k < nk; k++ )
+              {
+                tSSB[k0 + k]->DeltaT->data[i] = tRel[i] + DeltaT[k];
+                tSSB[k0 + k]->Tdot->data[i] = Tdot[k];
+              }
+          } /* for i < numSteps */
+      }
+
+      break;
+
+    case SSBPREC_DMOFF:	/* switch off all demodulation terms */
+
+      for ( UINT4 k = 0; k < nk; k++ )
+        {
+          memcpy ( tSSB[k0 + k]->DeltaT->data, tRel, numSteps * sizeof(tRel[0]) );
+          for ( UINT4 i = 0; i < numSteps; i++ )
+            tSSB[k0 + k]->Tdot->data[i] = 1.0;
+        }
+      break;
+
+    default:
+      XLAL_ERROR (XLAL_EFAILED, "\n?? Something went wrong.. this should never be called!\n\n" );
+      break;
+    } /* switch precision */
+
+  return XLAL_SUCCESS;
+
+} /* get_SSBtimes_block() */
+
+/**
+ * Batched version of XLALGetSSBtimes(), which computes the SSB-timings of many sky-locations at once.
+ *
+ * The sky-locations are processed in blocks of up to #SSB_BATCH_BLOCK, which are shared out between OpenMP
+ * threads (if enabled). The relativistic timings (#SSBPREC_RELATIVISTIC and #SSBPREC_RELATIVISTICOPT) are
+ * computed with XLALBarycenterOptBatch(), which handles all sky-locations of a block at each timestamp in
+ * vectorizable loops, while re-using the detector-site quantities buffered in a per-thread BarycenterBuffer.
+ *
+ * The output array \c tSSB must hold \c numSky pointers: an entry which is \c NULL is allocated here (and must
+ * be freed with XLALDestroySSBtimes()), otherwise it must have the same length as \c DetectorStates and is re-used.
+ *
+ * \note The relativistic timings differ from those of XLALGetSSBtimes() by up to a few times \f$10^{-7}\f$ s,
+ * since they are not rounded to an emission time in nanoseconds, and the time offsets from \c refTime are
+ * computed without first converting GPS times to REAL8.
+ */
+int
+XLALGetSSBtimesBatch ( SSBtimes **tSSB,				/**< [in/out] SSB-timings for each sky-location */
+                       const DetectorStateSeries *DetectorStates,	/**< [in] detector-states at timestamps t_i */
+                       const SkyPosition *skypos,			/**< [in] source sky-locations */
+                       const UINT4 numSky,				/**< [in] number of sky-locations */
+                       LIGOTimeGPS refTime,				/**< SSB reference-time T_0 of pulsar-parameters */
+                       SSBprecision precision				/**< relativistic or Newtonian SSB transformation? */
+                       )
+{
+  XLAL_CHECK ( tSSB != NULL, XLAL_EINVAL, "Invalid NULL input 'tSSB'\n" );
+  XLAL_CHECK ( DetectorStates != NULL, XLAL_EINVAL, "Invalid NULL input 'DetectorStates'\n" );
+  XLAL_CHECK ( numSky == 0 || skypos != NULL, XLAL_EINVAL, "Invalid NULL input 'skypos'\n" );
+  XLAL_CHECK ( precision < SSBPREC_LAST, XLAL_EDOM, "Invalid value precision=%d, allowed are [0, %d]\n", precision, SSBPREC_LAST -1 );
+
+  const UINT4 numSteps = DetectorStates->length;		/* number of timestamps */
+
+  // prepare output SSBtimes structs
+  for ( UINT4 k = 0; k < numSky; k++ )
+    {
+      XLAL_CHECK ( skypos[k].system == COORDINATESYSTEM_EQUATORIAL, XLAL_EDOM, "Only equatorial coordinate system (=%d) allowed, got %d\n", COORDINATESYSTEM_EQUATORIAL, skypos[k].system );
+      if ( tSSB[k] == NULL )
+        {
+          XLAL_CHECK ( (tSSB[k] = XLALCalloc ( 1, sizeof(*tSSB[k]) )) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK ( (tSSB[k]->DeltaT = XLALCreateREAL8Vector ( numSteps )) != NULL, XLAL_EFUNC );
+          XLAL_CHECK ( (tSSB[k]->Tdot = XLALCreateREAL8Vector ( numSteps )) != NULL, XLAL_EFUNC );
+        }
+      else
+        {
+          XLAL_CHECK ( tSSB[k]->DeltaT != NULL && tSSB[k]->Tdot != NULL, XLAL_EINVAL, "Invalid NULL input 'tSSB[%d]->DeltaT' or 'tSSB[%d]->Tdot'\n", k, k );
+          XLAL_CHECK ( tSSB[k]->DeltaT->length == numSteps && tSSB[k]->Tdot->length == numSteps, XLAL_EINVAL,
+                       "Length of 'tSSB[%d]' (%d) differs from number of timestamps (%d)\n", k, tSSB[k]->DeltaT->length, numSteps );
+        }
+      /* store the reference-time used into the output-structure */
+      tSSB[k]->refTime = refTime;
+    }
+
+  /* time offsets of the timestamps from the reference-time */
+  REAL8 *tRel = XLALMalloc ( numSteps * sizeof(tRel[0]) + 1 );
+  XLAL_CHECK ( tRel != NULL, XLAL_ENOMEM );
+  for ( UINT4 i = 0; i < numSteps; i++ )
+    tRel[i] = XLALGPSDiff ( &DetectorStates->data[i].tGPS, &refTime );
+
+  /* blocks of sky-locations are independent of each other, and are shared out between OpenMP threads (if enabled) */
+  const UINT4 numBlocks = ( numSky + SSB_BATCH_BLOCK - 1 ) / SSB_BATCH_BLOCK;
+  int errcode = XLAL_SUCCESS;
+#pragma omp parallel if (numBlocks > 1)
+  {
+    BarycenterBuffer *bBuffer = NULL;
+#pragma omp for schedule(dynamic)
+    for ( UINT4 b = 0; b < numBlocks; b++ )
+      {
+#pragma omp flush(errcode)
+        if ( errcode != XLAL_SUCCESS )
+          continue;
+        const UINT4 k0 = b * SSB_BATCH_BLOCK;
+        const UINT4 nk = ( numSky - k0 < SSB_BATCH_BLOCK ) ? numSky - k0 : SSB_BATCH_BLOCK;
+        if ( get_SSBtimes_block ( tSSB, DetectorStates, tRel, skypos, k0, nk, precision, &bBuffer ) != XLAL_SUCCESS )
+          {
+            errcode = XLAL_EFUNC;
+#pragma omp flush(errcode)
+          }
+      }
+    // free buffer memory
+    XLALFree ( bBuffer );
+  }
+  XLALFree ( tRel );
+  XLAL_CHECK ( errcode == XLAL_SUCCESS, errcode, "Failed to compute SSB-timings\n" );
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetSSBtimesBatch() */
+
+/**
+ * Multi-IFO version of XLALGetSSBtimesBatch().
+ *
+ * The output array \c multiSSB must hold \c numSky pointers: an entry which is \c NULL is allocated here (and must
+ * be freed with XLALDestroyMultiSSBtimes()), otherwise it must match \c multiDetStates and is re-used.
+ */
+int
+XLALGetMultiSSBtimesBatch ( MultiSSBtimes **multiSSB,			/**< [in/out] multi-IFO SSB-timings for each sky-location */
+                            const MultiDetectorStateSeries *multiDetStates,	/**< [in] detector-states at timestamps t_i */
+                            const SkyPosition *skypos,			/**< [in] source sky-locations [in equatorial coords!] */
+                            const UINT4 numSky,				/**< [in] number of sky-locations */
+                            LIGOTimeGPS refTime,			/**< SSB reference-time T_0 for SSB-timing */
+                            SSBprecision precision			/**< use relativistic or Newtonian SSB timing?  */
+                            )
+{
+  /* check input */
+  XLAL_CHECK ( multiSSB != NULL, XLAL_EINVAL, "Invalid NULL input 'multiSSB'\n");
+  XLAL_CHECK ( multiDetStates != NULL, XLAL_EINVAL, "Invalid NULL input 'multiDetStates'\n");
+  XLAL_CHECK ( multiDetStates->length > 0, XLAL_EINVAL, "Invalid zero-length 'multiDetStates'\n");
+
+  const UINT4 numDetectors = multiDetStates->length;
+
+  // prepare output MultiSSBtimes structs
+  for ( UINT4 k = 0; k < numSky; k++ )
+    {
+      if ( multiSSB[k] == NULL )
+        {
+          XLAL_CHECK ( (multiSSB[k] = XLALCalloc ( 1, sizeof(*multiSSB[k]) )) != NULL, XLAL_ENOMEM );
+          XLAL_CHECK ( (multiSSB[k]->data = XLALCalloc ( numDetectors, sizeof(multiSSB[k]->data[0]) )) != NULL, XLAL_ENOMEM );
+          multiSSB[k]->length = numDetectors;
+        }
+      else
+        {
+          XLAL_CHECK ( multiSSB[k]->length == numDetectors, XLAL_EINVAL,
+                       "Number of detectors in 'multiSSB[%d]' (%d) differs from 'multiDetStates' (%d)\n", k, multiSSB[k]->length, numDetectors );
+        }
+    }
+
+  // loop over detectors, computing all sky-locations at once
+  SSBtimes **tSSB = XLALMalloc ( numSky * sizeof(tSSB[0]) + 1 );
+  XLAL_CHECK ( tSSB != NULL, XLAL_ENOMEM );
+  for ( UINT4 X = 0; X < numDetectors; X ++ )
+    {
+      for ( UINT4 k = 0; k < numSky; k++ )
+        tSSB[k] = multiSSB[k]->data[X];
+      const int retn = XLALGetSSBtimesBatch ( tSSB, multiDetStates->data[X], skypos, numSky, refTime, precision );
+      for ( UINT4 k = 0; k < numSky; k++ )
+        multiSSB[k]->data[X] = tSSB[k];
+      if ( retn != XLAL_SUCCESS )
+        {
+          XLALFree ( tSSB );
+          XLAL_ERROR ( XLAL_EFUNC, "XLALGetSSBtimesBatch() failed for detector %d with xlalErrno = %d\n", X, xlalErrno );
+        }
+    } /* for X < numDet */
+  XLALFree ( tSSB );
+
+  return XLAL_SUCCESS;
+
+} /* XLALGetMultiSSBtimesBatch() */
+
 /** Find the earliest timestamp in a multi-SSB data structure
  *
 */
@@ -79,6 +79,12 @@ MultiSSBtimes *XLALDuplicateMultiSSBtimes ( const MultiSSBtimes *multiSSB );
 
 SSBtimes *XLALGetSSBtimes ( const DetectorStateSeries *DetectorStates, SkyPosition pos, LIGOTimeGPS refTime, SSBprecision precision );
 MultiSSBtimes *XLALGetMultiSSBtimes ( const MultiDetectorStateSeries *multiDetStates, SkyPosition skypos, LIGOTimeGPS refTime, SSBprecision precision);
+#ifndef SWIG /* exclude from SWIG interface */
+int XLALGetSSBtimesBatch ( SSBtimes **tSSB, const DetectorStateSeries *DetectorStates, const SkyPosition *skypos, const UINT4 numSky,
+                           LIGOTimeGPS refTime, SSBprecision precision );
+int XLALGetMultiSSBtimesBatch ( MultiSSBtimes **multiSSB, const MultiDetectorStateSeries *multiDetStates, const SkyPosition *skypos, const UINT4 numSky,
+                                LIGOTimeGPS refTime, SSBprecision precision );
+#endif /* SWIG */
 
 int XLALEarliestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB, const REAL8 Tsft );
 int XLALLatestMultiSSBtime ( LIGOTimeGPS *out, const MultiSSBtimes *multiSSB,  const REAL8 Tsft );
@@ -230,6 +230,48 @@ main ( int argc, char *argv[] )
 
     } // for iSky < numSkyPoints
 
+  // ----- test concurrent calls to XLALComputeFstat() sharing the same Resamp FstatInput
+  if ( XLALFstatMethodIsAvailable ( FMETHOD_RESAMP_BEST ) )
+    {
+      enum { numThreadPoints = 8 };
+      PulsarDopplerParams threadDoppler[numThreadPoints];
+      FstatResults *results_serial[numThreadPoints], *results_threaded[numThreadPoints];
+      for ( UINT4 i = 0; i < numThreadPoints; i ++ )
+        {
+          // cycle through sky positions and spindowns, so that concurrent calls need different resampling buffers
+          threadDoppler[i] = injectSources->data[0].Doppler;
+          threadDoppler[i].fkdot[0] -= 0.4 * spinRange.fkdotBand[0];
+          threadDoppler[i].fkdot[1] += (i % numf1dotPoints) * df1dot;
+          threadDoppler[i].Alpha += ((i / numf1dotPoints) % numSkyPoints) * dSky;
+          results_serial[i] = results_threaded[i] = NULL;
+          XLAL_CHECK ( XLALComputeFstat ( &results_serial[i], input_seg1[FMETHOD_RESAMP_BEST], &threadDoppler[i], numFreqBins, whatToCompute ) == XLAL_SUCCESS, XLAL_EFUNC );
+        }
+
+      int errnum = 0;
+#pragma omp parallel for schedule(static,1)
+      for ( int i = 0; i < numThreadPoints; i ++ )
+        {
+          if ( XLALComputeFstat ( &results_threaded[i], input_seg1[FMETHOD_RESAMP_BEST], &threadDoppler[i], numFreqBins, whatToCompute ) != XLAL_SUCCESS )
+            {
+#pragma omp critical (ComputeFstatTest)
+              errnum = xlalErrno;
+            }
+        }
+      XLAL_CHECK ( errnum == 0, XLAL_EFUNC, "Concurrent calls to XLALComputeFstat() failed" );
+
+      XLALPrintInfo ( "Comparing results between serial and concurrent calls to XLALComputeFstat() with method '%s'\n", XLALGetFstatInputMethodName ( input_seg1[FMETHOD_RESAMP_BEST] ) );
+      for ( UINT4 i = 0; i < numThreadPoints; i ++ )
+        {
+          if ( compareFstatResults ( results_serial[i], results_threaded[i] ) != XLAL_SUCCESS )
+            {
+              XLALPrintError ( "Comparison between serial and concurrent calls to XLALComputeFstat() failed for point %u\n", i );
+              XLAL_ERROR ( XLAL_EFUNC );
+            }
+          XLALDestroyFstatResults ( results_serial[i] );
+          XLALDestroyFstatResults ( results_threaded[i] );
+        }
+    }
+
   // ----- test XLALFstatInputTimeslice()
   // setup optional Fstat arguments
   optionalArgs.FstatMethod = FMETHOD_DEMOD_BEST; // only use demod best
@@ -293,6 +293,47 @@ main( void )
 
   XLALDestroyEphemerisData(edat);
 
+  /* ===== test binary ephemeris files ===== */
+  XLALPrintInfo("\n\nTesting binary ephemeris files ... ");
+  {
+    const char eBinFile[] = "LALBarycenterTest-earth98.bin";
+    const char sBinFile[] = "LALBarycenterTest-sun98.bin";
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile( eBinFile, eEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALWriteBinaryEphemerisFile( sBinFile, sEphFile ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* binary files load the same ephemeris as the original files */
+    EphemerisData *edat_txt = XLALInitBarycenter( eEphFile, sEphFile );
+    XLAL_CHECK_MAIN( edat_txt != NULL, XLAL_EFUNC );
+    EphemerisData *edat_bin = XLALInitBarycenter( eBinFile, sBinFile );
+    XLAL_CHECK_MAIN( edat_bin != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( compare_ephemeris( edat_txt, edat_bin ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    /* restricting loaded ephemeris data returns a view into the loaded tables */
+    const PosVelAcc *ephemE = edat_bin->ephemE, *ephemS = edat_bin->ephemS;
+    LIGOTimeGPS startGPS, endGPS;
+    XLAL_CHECK_MAIN( XLALGPSSetREAL8( &startGPS, ephemS[3].gps ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALGPSSetREAL8( &endGPS, ephemS[edat_bin->nentriesS - 4].gps ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALRestrictEphemerisData( edat_bin, &startGPS, &endGPS ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( XLALRestrictEphemerisData( edat_txt, &startGPS, &endGPS ) == XLAL_SUCCESS, XLAL_EFUNC );
+    XLAL_CHECK_MAIN( edat_bin->ephemS == ephemS + 3 && edat_bin->ephemE > ephemE, XLAL_EFAILED, "\nRestricted ephemeris is not a view into the loaded tables\n" );
+    XLAL_CHECK_MAIN( compare_ephemeris( edat_txt, edat_bin ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+    XLALDestroyEphemerisData( edat_txt );
+    XLALDestroyEphemerisData( edat_bin );
+
+    /* corrupted binary files are detected */
+    FILE *fp = fopen( sBinFile, "r+b" );
+    XLAL_CHECK_MAIN( fp != NULL, XLAL_EIO );
+    XLAL_CHECK_MAIN( fseek( fp, -1, SEEK_END ) == 0, XLAL_EIO );
+    const int c = fgetc( fp );
+    XLAL_CHECK_MAIN( c != EOF && fseek( fp, -1, SEEK_END ) == 0 && fputc( c ^ 0x10, fp ) != EOF, XLAL_EIO );
+    XLAL_CHECK_MAIN( fclose( fp ) == 0, XLAL_EIO );
+    edat_bin = XLALInitBarycenter( eBinFile, sBinFile );
+    XLAL_CHECK_MAIN( edat_bin == NULL, XLAL_EFAILED, "Expected XLALInitBarycenter( '%s', '%s' ) to fail!", eBinFile, sBinFile );
+    XLALClearErrno();
+  }
+  XLALPrintInfo("PASSED\n\n");
+
   LALCheckMemoryLeaks();
 
   XLALPrintError ("==> OK. All tests successful!\n\n");
@@ -26,6 +26,10 @@
 #include <lal/SFTutils.h>
 #include <lal/Units.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 /*---------- DEFINES ----------*/
 /**
  * \file
@@ -100,6 +104,140 @@ static int CompareSFTVectors(SFTVector *sft_vect, SFTVector *sft_vect2)
   return(0);
 }
 
+static int CompareSFTDescriptors(const SFTDescriptor *desc1, const SFTDescriptor *desc2);
+static int CompareSFTDescriptors(const SFTDescriptor *desc1, const SFTDescriptor *desc2)
+{
+  CHAR loc1[512];
+  /* XLALshowSFTLocator() returns a static string, so copy the first one */
+  strncpy ( loc1, XLALshowSFTLocator ( desc1->locator ), sizeof(loc1) - 1 );
+  loc1[sizeof(loc1) - 1] = '\0';
+  if ( strcmp ( loc1, XLALshowSFTLocator ( desc2->locator ) ) ) {
+    XLALPrintError ( "CompareSFTDescriptors(): locators differ (%s/%s)!\n", loc1, XLALshowSFTLocator ( desc2->locator ) );
+    return(-1);
+  }
+  if ( strncmp ( desc1->header.name, desc2->header.name, 2 ) ) {
+    XLALPrintError ( "CompareSFTDescriptors(): names differ!\n" );
+    return(-1);
+  }
+  if ( XLALGPSCmp ( &desc1->header.epoch, &desc2->header.epoch ) ) {
+    XLALPrintError ( "CompareSFTDescriptors(): epochs differ (%f/%f)!\n",
+                     GPS2REAL8(desc1->header.epoch), GPS2REAL8(desc2->header.epoch) );
+    return(-1);
+  }
+  if ( desc1->header.f0 != desc2->header.f0 ) {
+    XLALPrintError ( "CompareSFTDescriptors(): f0 differ (%f/%f)!\n", desc1->header.f0, desc2->header.f0 );
+    return(-1);
+  }
+  if ( desc1->header.deltaF != desc2->header.deltaF ) {
+    XLALPrintError ( "CompareSFTDescriptors(): deltaF differ (%f/%f)!\n", desc1->header.deltaF, desc2->header.deltaF );
+    return(-1);
+  }
+  if ( ( desc1->comment == NULL ) != ( desc2->comment == NULL ) || ( desc1->comment != NULL && strcmp ( desc1->comment, desc2->comment ) ) ) {
+    XLALPrintError ( "CompareSFTDescriptors(): comments differ!\n" );
+    return(-1);
+  }
+  if ( desc1->numBins != desc2->numBins ) {
+    XLALPrintError ( "CompareSFTDescriptors(): numBins differ (%u/%u)!\n", desc1->numBins, desc2->numBins );
+    return(-1);
+  }
+  if ( desc1->version != desc2->version ) {
+    XLALPrintError ( "CompareSFTDescriptors(): versions differ (%u/%u)!\n", desc1->version, desc2->version );
+    return(-1);
+  }
+  if ( desc1->crc64 != desc2->crc64 ) {
+    XLALPrintError ( "CompareSFTDescriptors(): crc64 checksums differ!\n" );
+    return(-1);
+  }
+  return(0);
+}
+
+/* Write NUM_SFTS SFTs split into NUM_BANDS frequency bands, with the band of all SFTs
+   in one multi-SFT file, and check that they load back correctly, in parallel and
+   (if OpenMP is enabled) on a single thread */
+#define NUM_SFTS 40
+#define NUM_BANDS 5
+#define BAND_BINS 37
+#define FIRST_BIN 1000
+static int test_band_files(void);
+static int test_band_files(void)
+{
+  const REAL8 deltaF = 1.0 / 1800;
+  SFTVector *sfts, *band, *loaded;
+  SFTCatalog *catalog;
+
+  /* the SFTs to write */
+  XLAL_CHECK ( ( sfts = XLALCreateSFTVector ( NUM_SFTS, NUM_BANDS * BAND_BINS ) ) != NULL, XLAL_EFUNC );
+  for ( UINT4 i = 0; i < NUM_SFTS; i ++ ) {
+    SFTtype *sft = &sfts->data[i];
+    strcpy ( sft->name, "H1" );
+    sft->epoch.gpsSeconds = 800000000 + 1800 * i;
+    sft->f0 = FIRST_BIN * deltaF;
+    sft->deltaF = deltaF;
+    for ( UINT4 k = 0; k < sft->data->length; k ++ )
+      sft->data->data[k] = crectf ( i + 1e-3 * k, -1.0 * k );
+  }
+
+  /* write one file per band */
+  XLAL_CHECK ( ( band = XLALCreateSFTVector ( NUM_SFTS, BAND_BINS ) ) != NULL, XLAL_EFUNC );
+  for ( UINT4 b = 0; b < NUM_BANDS; b ++ ) {
+    char fname[64];
+    for ( UINT4 i = 0; i < NUM_SFTS; i ++ ) {
+      COMPLEX8Sequence *data = band->data[i].data;
+      band->data[i] = sfts->data[i];
+      band->data[i].data = data;
+      band->data[i].f0 = ( FIRST_BIN + b * BAND_BINS ) * deltaF;
+      memcpy ( data->data, sfts->data[i].data->data + b * BAND_BINS, BAND_BINS * sizeof(data->data[0]) );
+    }
+    snprintf ( fname, sizeof(fname), "SFTfileIOTest_band%u.sft", b );
+    XLAL_CHECK ( XLALWriteSFTVector2NamedFile ( band, fname, "A v2-SFT band file for testing!" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  }
+  XLALDestroySFTVector ( band );
+
+  XLAL_CHECK ( ( catalog = XLALSFTdataFind ( "SFTfileIOTest_band?.sft", NULL ) ) != NULL, XLAL_EFUNC );
+  XLAL_CHECK ( catalog->length == NUM_SFTS * NUM_BANDS, XLAL_EFAILED, "Found %u SFT segments, expected %u\n", catalog->length, NUM_SFTS * NUM_BANDS );
+
+  /* load all bands, and a band spanning parts of the first and last files */
+  for ( int full = 1; full >= 0; full -- ) {
+    const UINT4 offset = full ? 0 : BAND_BINS / 2;
+    const UINT4 numBins = full ? NUM_BANDS * BAND_BINS : ( NUM_BANDS - 1 ) * BAND_BINS + 1;
+    const REAL8 fMin = full ? -1 : ( FIRST_BIN + offset ) * deltaF;
+    const REAL8 fMax = full ? -1 : ( FIRST_BIN + offset + numBins - 1 ) * deltaF;
+
+    XLAL_CHECK ( ( loaded = XLALLoadSFTs ( catalog, fMin, fMax ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK ( loaded->length == NUM_SFTS, XLAL_EFAILED, "Loaded %u SFTs, expected %u\n", loaded->length, NUM_SFTS );
+    for ( UINT4 i = 0; i < NUM_SFTS; i ++ ) {
+      const SFTtype *sft = &loaded->data[i];
+      XLAL_CHECK ( XLALGPSCmp ( &sft->epoch, &sfts->data[i].epoch ) == 0, XLAL_EFAILED, "SFT#%u has the wrong epoch\n", i );
+      XLAL_CHECK ( sft->data->length == numBins, XLAL_EFAILED, "SFT#%u has %u bins, expected %u\n", i, sft->data->length, numBins );
+      XLAL_CHECK ( lround ( sft->f0 / deltaF ) == FIRST_BIN + offset, XLAL_EFAILED, "SFT#%u starts at the wrong frequency %g\n", i, sft->f0 );
+      for ( UINT4 k = 0; k < numBins; k ++ )
+        XLAL_CHECK ( sft->data->data[k] == sfts->data[i].data->data[offset + k], XLAL_EFAILED, "Bin %u of SFT#%u differs\n", k, i );
+    }
+
+#ifdef _OPENMP
+    /* compare with loading on a single thread */
+    {
+      SFTVector *serial;
+      int nthreads = omp_get_max_threads();
+      omp_set_num_threads(1);
+      serial = XLALLoadSFTs ( catalog, fMin, fMax );
+      omp_set_num_threads(nthreads);
+      XLAL_CHECK ( serial != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( CompareSFTVectors ( loaded, serial ) == 0, XLAL_EFAILED, "SFTs loaded in parallel and on a single thread differ\n" );
+      XLALDestroySFTVector ( serial );
+    }
+#endif
+
+    XLALDestroySFTVector ( loaded );
+  }
+
+  XLALDestroySFTCatalog ( catalog );
+  XLALDestroySFTVector ( sfts );
+
+  return XLAL_SUCCESS;
+
+}
+
 int main( void )
 {
   const char *fn = __func__;
@@ -199,6 +337,43 @@ int main( void )
     XLALPrintError ("%s: XLALLoadMultiSFTs (cat, -1, -1) failed with xlalErrno = %d\n", fn, xlalErrno );
     return EXIT_FAILURE;
   }
+
+  /* write an SFT catalog index, and check that querying it returns the same SFTs */
+  XLAL_CHECK_MAIN ( XLALWriteSFTCatalogIndex ( catalog, "SFTfileIOTest.sftidx" ) == XLAL_SUCCESS, XLAL_EFUNC );
+  {
+    SFTCatalog *index_catalog = NULL;
+    MultiSFTVector *index_multsft_vect = NULL;
+    XLAL_CHECK_MAIN ( ( index_catalog = XLALSFTdataFind ( "SFTfileIOTest.sftidx", NULL ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( index_catalog->length == catalog->length, XLAL_EFAILED, "SFT catalog index returned %u SFTs, expected %u\n", index_catalog->length, catalog->length );
+    for ( UINT4 i = 0; i < catalog->length; i ++ )
+      {
+        XLAL_CHECK_MAIN ( CompareSFTDescriptors ( &index_catalog->data[i], &catalog->data[i] ) == 0, XLAL_EFAILED, "SFT catalog index entry %u differs\n", i );
+      }
+    XLAL_CHECK_MAIN ( ( index_multsft_vect = XLALLoadMultiSFTs ( index_catalog, -1, -1 ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( index_multsft_vect->length == multsft_vect->length, XLAL_EFAILED );
+    for ( UINT4 X = 0; X < multsft_vect->length; X ++ )
+      {
+        XLAL_CHECK_MAIN ( CompareSFTVectors ( multsft_vect->data[X], index_multsft_vect->data[X] ) == 0, XLAL_EFAILED, "SFTs loaded through SFT catalog index differ for X=%u\n", X );
+      }
+    XLALDestroyMultiSFTVector ( index_multsft_vect );
+    XLALDestroySFTCatalog ( index_catalog );
+
+    /* query the index with constraints on detector and time-span */
+    SFTConstraints XLAL_INIT_DECL(index_constraints);
+    LIGOTimeGPS minStartTime = catalog->data[0].header.epoch;
+    index_constraints.detector = multsft_vect->data[0]->data[0].name;
+    index_constraints.minStartTime = &minStartTime;
+    index_constraints.maxStartTime = &multsft_vect->data[0]->data[multsft_vect->data[0]->length - 1].epoch;
+    XLAL_CHECK_MAIN ( ( index_catalog = XLALSFTdataFind ( "SFTfileIOTest.sftidx", &index_constraints ) ) != NULL, XLAL_EFUNC );
+    XLAL_CHECK_MAIN ( index_catalog->length > 0 && index_catalog->length < catalog->length, XLAL_EFAILED, "Constrained query of SFT catalog index returned %u SFTs\n", index_catalog->length );
+    for ( UINT4 i = 0; i < index_catalog->length; i ++ )
+      {
+        XLAL_CHECK_MAIN ( strncmp ( index_catalog->data[i].header.name, index_constraints.detector, 2 ) == 0, XLAL_EFAILED );
+        XLAL_CHECK_MAIN ( XLALCWGPSinRange ( index_catalog->data[i].header.epoch, index_constraints.minStartTime, index_constraints.maxStartTime ) == 0, XLAL_EFAILED );
+      }
+    XLALDestroySFTCatalog ( index_catalog );
+  }
+
   XLALDestroySFTCatalog(catalog);
 
   /* 6 SFTs from 2 IFOs should have been read */
@@ -407,6 +582,9 @@ int main( void )
     XLALDestroyTimestampVector ( ts3 );
   }
 
+  /* ---------- test loading SFTs split across several band files ---------- */
+  XLAL_CHECK_MAIN ( test_band_files() == XLAL_SUCCESS, XLAL_EFUNC );
+
   /* ------------------------------ */
   LALCheckMemoryLeaks();
 
@@ -0,0 +1,216 @@
+/*
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with with program; see the file COPYING. If not, write to the
+ *  Free Software Foundation, Inc., 59 Temple Place, Suite 330, Boston,
+ *  MA  02111-1307  USA
+ */
+
+/*
+ * Tests the batched barycentering functions XLALBarycenterOptBatch() and
+ * XLALGet[Multi]SSBtimesBatch() against their scalar counterparts, and
+ * compares their timings.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <lal/LALBarycenter.h>
+#include <lal/LALInitBarycenter.h>
+#include <lal/DetectorStates.h>
+#include <lal/SSBtimes.h>
+#include <lal/SFTutils.h>
+#include <lal/Date.h>
+#include <lal/LogPrintf.h>
+
+#define NUM_SKY 200
+
+const INT4 t1998 = 630720013-730*86400-1;	/* gps at Jan 1,1998 00:00:00 UTC*/
+
+/* Simple deterministic pseudo-random numbers in [0,1] */
+static REAL8 next_random ( UINT4 *seed )
+{
+  *seed = 1664525u * ( *seed ) + 1013904223u;
+  return ( *seed >> 8 ) / ( 1.0 * ( 1u << 24 ) );
+}
+
+/* Compare XLALBarycenterOptBatch() to XLALBarycenterOpt() */
+static int
+test_BarycenterOptBatch ( const DetectorStateSeries *detStates, const SkyPosition *skypos )
+{
+  BarycenterInput XLAL_INIT_DECL(baryinput);
+  baryinput.site = detStates->detector;
+  for ( UINT4 j = 0; j < 3; j++ )
+    baryinput.site.location[j] /= LAL_C_SI;
+  baryinput.dInv = 1e-10;		/* exercise the finite-distance correction */
+
+  REAL8 nx[NUM_SKY], ny[NUM_SKY], nz[NUM_SKY], deltaT[NUM_SKY], tDot[NUM_SKY];
+  for ( UINT4 k = 0; k < NUM_SKY; k++ )
+    {
+      nx[k] = cos ( skypos[k].latitude ) * cos ( skypos[k].longitude );
+      ny[k] = cos ( skypos[k].latitude ) * sin ( skypos[k].longitude );
+      nz[k] = sin ( skypos[k].latitude );
+    }
+
+  REAL8 maxErrDeltaT = 0, maxErrTdot = 0;
+  BarycenterBuffer *bBuffer = NULL, *bBufferBatch = NULL;
+  for ( UINT4 i = 0; i < detStates->length; i += 97 )
+    {
+      const EarthState *earth = &detStates->data[i].earthState;
+      baryinput.tgps = detStates->data[i].tGPS;
+      XLAL_CHECK ( XLALBarycenterOptBatch ( deltaT, tDot, nx, ny, nz, NUM_SKY, &baryinput, earth, &bBufferBatch ) == XLAL_SUCCESS, XLAL_EFUNC );
+      for ( UINT4 k = 0; k < NUM_SKY; k++ )
+        {
+          EmissionTime emit;
+          baryinput.alpha = skypos[k].longitude;
+          baryinput.delta = skypos[k].latitude;
+          XLAL_CHECK ( XLALBarycenterOpt ( &emit, &baryinput, earth, &bBuffer ) == XLAL_SUCCESS, XLAL_EFUNC );
+          maxErrDeltaT = fmax ( maxErrDeltaT, fabs ( deltaT[k] - emit.deltaT ) );
+          maxErrTdot = fmax ( maxErrTdot, fabs ( tDot[k] - emit.tDot ) );
+        }
+    }
+  XLALFree ( bBuffer );
+  XLALFree ( bBufferBatch );
+
+  XLALPrintInfo ( "Max error between XLALBarycenterOpt() and XLALBarycenterOptBatch(): deltaT = %g s, tDot = %g\n", maxErrDeltaT, maxErrTdot );
+  XLAL_CHECK ( maxErrDeltaT < 1e-10 && maxErrTdot < 1e-14, XLAL_EFAILED,
+               "Max error between XLALBarycenterOpt() and XLALBarycenterOptBatch() too large: deltaT = %g s, tDot = %g\n", maxErrDeltaT, maxErrTdot );
+
+  return XLAL_SUCCESS;
+
+} /* test_BarycenterOptBatch() */
+
+/* Compare XLALGetMultiSSBtimesBatch() to XLALGetSSBtimes(), and compare timings */
+static int
+test_GetSSBtimesBatch ( const MultiDetectorStateSeries *multiDetStates, const SkyPosition *skypos, SSBprecision precision )
+{
+  const LIGOTimeGPS refTime = multiDetStates->data[0]->data[0].tGPS;
+  const REAL8 tolDeltaT = 5e-7;	// in seconds: scalar version rounds to nanoseconds, and converts GPS times to REAL8
+  const REAL8 tolTdot = 1e-12;
+
+  /* batched version */
+  MultiSSBtimes *multiSSB[NUM_SKY];
+  for ( UINT4 k = 0; k < NUM_SKY; k++ )
+    multiSSB[k] = NULL;
+  REAL8 tic = XLALGetTimeOfDay();
+  XLAL_CHECK ( XLALGetMultiSSBtimesBatch ( multiSSB, multiDetStates, skypos, NUM_SKY, refTime, precision ) == XLAL_SUCCESS, XLAL_EFUNC );
+  REAL8 tau_batch = XLALGetTimeOfDay() - tic;
+
+  /* re-using the output gives the same results */
+  SSBtimes *tSSB[NUM_SKY];
+  for ( UINT4 k = 0; k < NUM_SKY; k++ )
+    tSSB[k] = XLALDuplicateSSBtimes ( multiSSB[k]->data[0] );
+  XLAL_CHECK ( XLALGetSSBtimesBatch ( tSSB, multiDetStates->data[0], skypos, NUM_SKY, refTime, precision ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( UINT4 k = 0; k < NUM_SKY; k++ )
+    {
+      for ( UINT4 i = 0; i < tSSB[k]->DeltaT->length; i++ )
+        XLAL_CHECK ( tSSB[k]->DeltaT->data[i] == multiSSB[k]->data[0]->DeltaT->data[i] && tSSB[k]->Tdot->data[i] == multiSSB[k]->data[0]->Tdot->data[i],
+                     XLAL_EFAILED, "Re-used output of XLALGetSSBtimesBatch() differs at sky-location %d, timestamp %d\n", k, i );
+      XLALDestroySSBtimes ( tSSB[k] );
+    }
+
+  /* scalar version */
+  REAL8 maxErrDeltaT = 0, maxErrTdot = 0;
+  REAL8 tau_scalar = 0;
+  for ( UINT4 k = 0; k < NUM_SKY; k++ )
+    {
+      tic = XLALGetTimeOfDay();
+      MultiSSBtimes *scalar = XLALGetMultiSSBtimes ( multiDetStates, skypos[k], refTime, precision );
+      tau_scalar += XLALGetTimeOfDay() - tic;
+      XLAL_CHECK ( scalar != NULL, XLAL_EFUNC );
+      XLAL_CHECK ( scalar->length == multiSSB[k]->length, XLAL_EFAILED );
+      for ( UINT4 X = 0; X < scalar->length; X++ )
+        {
+          const SSBtimes *s = scalar->data[X], *b = multiSSB[k]->data[X];
+          XLAL_CHECK ( XLALGPSCmp ( &s->refTime, &b->refTime ) == 0, XLAL_EFAILED );
+          XLAL_CHECK ( s->DeltaT->length == b->DeltaT->length && s->Tdot->length == b->Tdot->length, XLAL_EFAILED );
+          for ( UINT4 i = 0; i < s->DeltaT->length; i++ )
+            {
+              maxErrDeltaT = fmax ( maxErrDeltaT, fabs ( s->DeltaT->data[i] - b->DeltaT->data[i] ) );
+              maxErrTdot = fmax ( maxErrTdot, fabs ( s->Tdot->data[i] - b->Tdot->data[i] ) );
+            }
+        }
+      XLALDestroyMultiSSBtimes ( scalar );
+      XLALDestroyMultiSSBtimes ( multiSSB[k] );
+    }
+
+  XLALPrintInfo ( "SSB precision %d: max error between XLALGetMultiSSBtimes() and XLALGetMultiSSBtimesBatch(): DeltaT = %g s, Tdot = %g\n",
+                  precision, maxErrDeltaT, maxErrTdot );
+  XLALPrintInfo ( "SSB precision %d: %d sky-locations took %g s with XLALGetMultiSSBtimes(), %g s with XLALGetMultiSSBtimesBatch() (speedup %.1f)\n",
+                  precision, NUM_SKY, tau_scalar, tau_batch, tau_scalar / tau_batch );
+  XLAL_CHECK ( maxErrDeltaT < tolDeltaT && maxErrTdot < tolTdot, XLAL_EFAILED,
+               "SSB precision %d: max error between XLALGetMultiSSBtimes() and XLALGetMultiSSBtimesBatch() too large: DeltaT = %g s, Tdot = %g\n",
+               precision, maxErrDeltaT, maxErrTdot );
+
+  return XLAL_SUCCESS;
+
+} /* test_GetSSBtimesBatch() */
+
+int
+main ( void )
+{
+  char eEphFile[] = TEST_DATA_DIR "earth98.dat";
+  char sEphFile[] = TEST_DATA_DIR "sun98.dat";
+  EphemerisData *edat = XLALInitBarycenter ( eEphFile, sEphFile );
+  XLAL_CHECK_MAIN ( edat != NULL, XLAL_EFUNC );
+
+  /* detector states of two detectors for 100 days */
+  LIGOTimeGPS tStart = { t1998 + 86400, 0 };
+  LIGOTimeGPSVector *timestamps = XLALMakeTimestamps ( tStart, 100 * 86400, 1800, 0 );
+  XLAL_CHECK_MAIN ( timestamps != NULL, XLAL_EFUNC );
+  DetectorStateSeries *detStates[2];
+  detStates[0] = XLALGetDetectorStates ( timestamps, &lalCachedDetectors[LAL_LHO_4K_DETECTOR], edat, 900 );
+  detStates[1] = XLALGetDetectorStates ( timestamps, &lalCachedDetectors[LAL_VIRGO_DETECTOR], edat, 900 );
+  XLAL_CHECK_MAIN ( detStates[0] != NULL && detStates[1] != NULL, XLAL_EFUNC );
+  MultiDetectorStateSeries multiDetStates = { .length = 2, .data = detStates };
+
+  /* random sky-locations, plus the poles and one sky-location behind the Sun */
+  UINT4 seed = 1;
+  SkyPosition skypos[NUM_SKY];
+  for ( UINT4 k = 0; k < NUM_SKY; k++ )
+    {
+      skypos[k].system = COORDINATESYSTEM_EQUATORIAL;
+      skypos[k].longitude = next_random ( &seed ) * LAL_TWOPI;
+      skypos[k].latitude = asin ( 2 * next_random ( &seed ) - 1 );
+    }
+  skypos[0].latitude = LAL_PI_2;
+  skypos[1].latitude = -LAL_PI_2;
+  {
+    const EarthState *earth = &detStates[0]->data[detStates[0]->length / 2].earthState;
+    skypos[2].longitude = atan2 ( -earth->se[1], -earth->se[0] );
+    skypos[2].latitude = asin ( -earth->se[2] / earth->rse );
+  }
+
+  XLAL_CHECK_MAIN ( test_BarycenterOptBatch ( detStates[0], skypos ) == XLAL_SUCCESS, XLAL_EFUNC );
+  for ( SSBprecision precision = 0; precision < SSBPREC_LAST; precision++ )
+    XLAL_CHECK_MAIN ( test_GetSSBtimesBatch ( &multiDetStates, skypos, precision ) == XLAL_SUCCESS, XLAL_EFUNC );
+
+  /* invalid inputs are rejected */
+  {
+    SSBtimes *tSSB[1] = { NULL };
+    SkyPosition badpos = { .system = COORDINATESYSTEM_ECLIPTIC };
+    int errnum = 0, retn = 0;
+    XLAL_TRY_SILENT( retn = XLALGetSSBtimesBatch ( tSSB, detStates[0], &badpos, 1, tStart, SSBPREC_RELATIVISTICOPT ), errnum );
+    XLAL_CHECK_MAIN ( retn != XLAL_SUCCESS && errnum == XLAL_EDOM, XLAL_EFAILED, "Non-equatorial sky-location was not detected" );
+    XLAL_CHECK_MAIN ( tSSB[0] == NULL, XLAL_EFAILED );
+  }
+
+  XLALDestroyDetectorStateSeries ( detStates[0] );
+  XLALDestroyDetectorStateSeries ( detStates[1] );
+  XLALDestroyTimestampVector ( timestamps );
+  XLALDestroyEphemerisData ( edat );
+
+  LALCheckMemoryLeaks();
+
+  return EXIT_SUCCESS;
+
+} /* main() */
@@ -24,10 +24,26 @@
 #include <lal/FrequencySeries.h>
 #include <lal/Sequence.h>
 #include <lal/LALConstants.h>
+#include <lal/LALDict.h>
+#include <lal/LALValue.h>
+#include <lal/LALHashFunc.h>
+
+#include <lal/LALConfig.h>
+#ifdef LAL_PTHREAD_LOCK
+#include <pthread.h>
+#endif
 
 #include "check_waveform_macros.h"
 #include "LALSimInspiralPNCoefficients.c"
 
+#ifdef LAL_PTHREAD_LOCK
+#define CACHE_LOCK(cache) pthread_mutex_lock(&(cache)->mutex)
+#define CACHE_UNLOCK(cache) pthread_mutex_unlock(&(cache)->mutex)
+#else
+#define CACHE_LOCK(cache)
+#define CACHE_UNLOCK(cache)
+#endif
+
 /**
  * Bitmask enumerating which parameters have changed, to determine
  * if the requested waveform can be transformed from a cached waveform
@@ -41,53 +57,105 @@ typedef enum {
     INCLINATION = 8
 } CacheVariableDiffersBitmask;
 
-static CacheVariableDiffersBitmask CacheArgsDifferenceBitmask(
-        LALSimInspiralWaveformCache *cache,
+/**
+ * A single cached waveform, with the parameters used to generate it.
+ * Entries are kept in a doubly-linked list, in order from the most to the
+ * least recently used.
+ */
+typedef struct
+tagLALSimInspiralWaveformCacheEntry {
+    struct tagLALSimInspiralWaveformCacheEntry *prev;
+    struct tagLALSimInspiralWaveformCacheEntry *next;
+    UINT8 key;          /* hash of the intrinsic parameters */
+    UINT8 bytes;        /* size of the cached waveform data */
+    REAL8TimeSeries *hplus;
+    REAL8TimeSeries *hcross;
+    COMPLEX16FrequencySeries *hptilde;
+    COMPLEX16FrequencySeries *hctilde;
+    REAL8 phiRef;
+    REAL8 deltaTF;
+    REAL8 m1;
+    REAL8 m2;
+    REAL8 S1x;
+    REAL8 S1y;
+    REAL8 S1z;
+    REAL8 S2x;
+    REAL8 S2y;
+    REAL8 S2z;
+    REAL8 f_min;
+    REAL8 f_ref;
+    REAL8 f_max;
+    REAL8 r;
+    REAL8 i;
+    LALDict *LALpars;   /* private copy of the non-mandatory parameters */
+    Approximant approximant;
+    REAL8Sequence *frequencies;
+} LALSimInspiralWaveformCacheEntry;
+
+struct
+tagLALSimInspiralWaveformCache {
+    LALSimInspiralWaveformCacheEntry *head;     /* most recently used entry */
+    LALSimInspiralWaveformCacheEntry *tail;     /* least recently used entry */
+    LALSimInspiralWaveformCacheStats stats;
+#ifdef LAL_PTHREAD_LOCK
+    pthread_mutex_t mutex;
+#endif
+};
+
+static LALSimInspiralWaveformCacheEntry *CreateCacheEntry(
         REAL8 phiRef,
         REAL8 deltaTF,
-        REAL8 m1,
-        REAL8 m2,
+        REAL8 m1, REAL8 m2,
         REAL8 S1x, REAL8 S1y, REAL8 S1z,
         REAL8 S2x, REAL8 S2y, REAL8 S2z,
         REAL8 f_min, REAL8 f_ref, REAL8 f_max,
         REAL8 r,
         REAL8 i,
-	LALDict *LALpars,
+        LALDict *LALpars,
         Approximant approximant,
         REAL8Sequence *frequencies);
 
+static void DestroyCacheEntry(LALSimInspiralWaveformCacheEntry *entry);
+
+static LALSimInspiralWaveformCacheEntry *FindCacheEntry(
+        LALSimInspiralWaveformCache *cache,
+        const LALSimInspiralWaveformCacheEntry *request,
+        int fdomain);
+
+static void InsertCacheEntry(
+        LALSimInspiralWaveformCache *cache,
+        LALSimInspiralWaveformCacheEntry *entry,
+        int fdomain);
+
+static CacheVariableDiffersBitmask CacheArgsDifferenceBitmask(
+        const LALSimInspiralWaveformCacheEntry *cached,
+        const LALSimInspiralWaveformCacheEntry *request);
+
 static int FrequenciesAreDifferent(
         REAL8Sequence *newFrequencies,
         REAL8Sequence *cachedFrequencies);
 
+static int DictsAreDifferent(LALDict *dict1, LALDict *dict2);
+
+static int LookupTDHCache(LALSimInspiralWaveformCache *cache,
+        REAL8TimeSeries **hplus,
+        REAL8TimeSeries **hcross,
+        const LALSimInspiralWaveformCacheEntry *request);
+
+static int LookupFDHCache(LALSimInspiralWaveformCache *cache,
+        COMPLEX16FrequencySeries **hptilde,
+        COMPLEX16FrequencySeries **hctilde,
+        const LALSimInspiralWaveformCacheEntry *request);
+
 static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
         REAL8TimeSeries *hplus,
         REAL8TimeSeries *hcross,
-        REAL8 phiRef,
-        REAL8 deltaT,
-        REAL8 m1, REAL8 m2,
-        REAL8 S1x, REAL8 S1y, REAL8 S1z,
-        REAL8 S2x, REAL8 S2y, REAL8 S2z,
-        REAL8 f_min, REAL8 f_ref,
-        REAL8 r,
-        REAL8 i,
-        LALDict *LALpars,
-        Approximant approximant);
+        LALSimInspiralWaveformCacheEntry *request);
 
 static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
         COMPLEX16FrequencySeries *hptilde,
         COMPLEX16FrequencySeries *hctilde,
-        REAL8 phiRef,
-        REAL8 deltaT,
-        REAL8 m1, REAL8 m2,
-        REAL8 S1x, REAL8 S1y, REAL8 S1z,
-        REAL8 S2x, REAL8 S2y, REAL8 S2z,
-        REAL8 f_min, REAL8 f_ref, REAL8 f_max,
-        REAL8 r,
-        REAL8 i,
-        LALDict *LALpars,
-        Approximant approximant,
-        REAL8Sequence *frequencies);
+        LALSimInspiralWaveformCacheEntry *request);
 
 
 /**
@@ -100,10 +168,11 @@ static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
  * Returns the waveform in the time domain.
  * The parameters passed must be in SI units.
  *
- * This version allows caching of waveforms. The most recently generated
- * waveform and its parameters are stored. If the next call requests a waveform
- * that can be obtained by a simple transformation, then it is done.
- * This bypasses the waveform generation and speeds up the code.
+ * This version allows caching of waveforms. Recently generated waveforms
+ * and their parameters are stored. If the next call requests a waveform
+ * with the same intrinsic parameters as a stored waveform, and it can be
+ * obtained from the stored waveform by a simple transformation, then it
+ * is done. This bypasses the waveform generation and speeds up the code.
  */
 int XLALSimInspiralChooseTDWaveformFromCache(
         REAL8TimeSeries **hplus,                /**< +-polarization waveform */
@@ -128,10 +197,7 @@ int XLALSimInspiralChooseTDWaveformFromCache(
         )
 {
     int status;
-    size_t j;
-    REAL8 phasediff, dist_ratio, incl_ratio_plus, incl_ratio_cross;
-    REAL8 cosrot, sinrot;
-    CacheVariableDiffersBitmask changedParams;
+    LALSimInspiralWaveformCacheEntry *request;
 
     // If nonGRparams are not NULL, don't even try to cache.
     if ( !XLALSimInspiralWaveformParamsNonGRAreDefault(LALpars) || (!cache) )
@@ -140,274 +206,29 @@ int XLALSimInspiralChooseTDWaveformFromCache(
 					     r, i, phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars,
 					     approximant);
 
-    // Check which parameters have changed
-    changedParams = CacheArgsDifferenceBitmask(cache, phiRef, deltaT,
-            m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, 0., r, i,
-            LALpars, approximant, NULL);
-
-    // No parameters have changed! Copy the cached polarizations
-    if( changedParams == NO_DIFFERENCE ) {
-        *hplus = XLALCutREAL8TimeSeries(cache->hplus, 0,
-                cache->hplus->data->length);
-        if (*hplus == NULL) return XLAL_ENOMEM;
-        *hcross = XLALCutREAL8TimeSeries(cache->hcross, 0,
-                cache->hcross->data->length);
-        if (*hcross == NULL) {
-            XLALDestroyREAL8TimeSeries(*hplus);
-            *hplus = NULL;
-            return XLAL_ENOMEM;
-        }
-
-        return XLAL_SUCCESS;
-    }
-
-    // Intrinsic parameters have changed. We must generate a new waveform
-    if( (changedParams & INTRINSIC) != 0 ) {
-
-        status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z,
-						 r, i, phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars,
-						 approximant);
-        if (status == XLAL_FAILURE) return status;
-
-        // FIXME: Need to add hlms, dynamic variables, etc. in cache
-        return StoreTDHCache(cache, *hplus, *hcross, phiRef, deltaT, m1, m2,
-			     S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, r, i, LALpars, approximant);
-    }
-
-    INT4 ampO=XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(LALpars);
-    // case 1: Precessing waveforms
-    if( approximant == SpinTaylorT4 || approximant == SpinTaylorT2 ) {
-        // If polarizations are not cached we must generate a fresh waveform
-        // FIXME: Will need to check hlms and/or dynamical variables as well
-        if( cache->hplus == NULL || cache->hcross == NULL) {
-            status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2,
-						     S1x, S1y, S1z, S2x, S2y, S2z, r, i,
-						     phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars,
-						     approximant);
-            if (status == XLAL_FAILURE) return status;
-
-            // FIXME: Need to add hlms, dynamic variables, etc. in cache
-            return StoreTDHCache(cache, *hplus, *hcross, phiRef, deltaT, m1, m2,
-                    S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, r, i,
-		    LALpars, approximant);
-        }
-
-        if( changedParams & INCLINATION ) {
-            // FIXME: For now just treat as intrinsic parameter.
-            // Will come back and put in transformation
-            status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2,
-						     S1x, S1y, S1z, S2x, S2y, S2z, r, i,
-						     phiRef, 0., 0., 0., deltaT, f_min, f_ref,
-						     LALpars, approximant);
-            if (status == XLAL_FAILURE) return status;
-
-            // FIXME: Need to add hlms, dynamic variables, etc. in cache
-            return StoreTDHCache(cache, *hplus, *hcross, phiRef, deltaT, m1, m2,
-                    S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, r, i,
-                    LALpars, approximant);
-        }
-        if( changedParams & PHI_REF ) {
-            // FIXME: For now just treat as intrinsic parameter.
-            // Will come back and put in transformation
-            status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2,
-						     S1x, S1y, S1z, S2x, S2y, S2z, r, i,
-						     phiRef, 0., 0., 0., deltaT, f_min, f_ref,
-						     LALpars, approximant);
-            if (status == XLAL_FAILURE) return status;
-
-            // FIXME: Need to add hlms, dynamic variables, etc. in cache
-            return StoreTDHCache(cache, *hplus, *hcross, phiRef, deltaT, m1, m2,
-                    S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, r, i,
-		    LALpars, approximant);
-        }
-        if( (changedParams & DISTANCE) != 0 ) {
-            // Return rescaled copy of cached polarizations
-            dist_ratio = cache->r / r;
-            *hplus = XLALCreateREAL8TimeSeries(cache->hplus->name,
-                    &(cache->hplus->epoch), cache->hplus->f0,
-                    cache->hplus->deltaT, &(cache->hplus->sampleUnits),
-                    cache->hplus->data->length);
-            if (*hplus == NULL) return XLAL_ENOMEM;
-
-            *hcross = XLALCreateREAL8TimeSeries(cache->hcross->name,
-                    &(cache->hcross->epoch), cache->hcross->f0,
-                    cache->hcross->deltaT, &(cache->hcross->sampleUnits),
-                    cache->hcross->data->length);
-            if (*hcross == NULL) {
-                XLALDestroyREAL8TimeSeries(*hplus);
-                *hplus = NULL;
-                return XLAL_ENOMEM;
-            }
-
-            for (j = 0; j < cache->hplus->data->length; j++) {
-                (*hplus)->data->data[j] = cache->hplus->data->data[j]
-                        * dist_ratio;
-                (*hcross)->data->data[j] = cache->hcross->data->data[j]
-                        * dist_ratio;
-            }
-        }
+    request = CreateCacheEntry(phiRef, deltaT, m1, m2, S1x, S1y, S1z,
+            S2x, S2y, S2z, f_min, f_ref, 0., r, i, LALpars, approximant, NULL);
+    if (request == NULL) XLAL_ERROR(XLAL_EFUNC);
 
+    // Try to copy or transform a cached waveform
+    status = LookupTDHCache(cache, hplus, hcross, request);
+    if (status != 0) {
+        DestroyCacheEntry(request);
+        if (status < 0) XLAL_ERROR(XLAL_EFUNC);
         return XLAL_SUCCESS;
     }
 
-    // case 2: Non-precessing, ampO = 0
-    else if( ampO==0 && (approximant==TaylorT1 || approximant==TaylorT2
-                || approximant==TaylorT3 || approximant==TaylorT4
-                || approximant==EOBNRv2 || approximant==SEOBNRv1) ) {
-        // If polarizations are not cached we must generate a fresh waveform
-        if( cache->hplus == NULL || cache->hcross == NULL) {
-            status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2,
-						     S1x, S1y, S1z, S2x, S2y, S2z, r, i,
-						     phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars, approximant);
-            if (status == XLAL_FAILURE) return status;
-
-            // FIXME: Need to add hlms, dynamic variables, etc. in cache
-            return StoreTDHCache(cache, *hplus, *hcross, phiRef, deltaT, m1, m2,
-                    S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, r, i,
-                    LALpars, approximant);
-        }
-
-        // Set transformation coefficients for identity transformation.
-        // We'll adjust them depending on which extrinsic parameters changed.
-        dist_ratio = incl_ratio_plus = incl_ratio_cross = cosrot = 1.;
-        phasediff = sinrot = 0.;
-
-        if( changedParams & PHI_REF ) {
-            // Only 2nd harmonic present, so {h+,hx} rotates by 2*deltaphiRef
-            phasediff = 2.*(phiRef - cache->phiRef);
-            cosrot = cos(phasediff);
-            sinrot = sin(phasediff);
-        }
-        if( changedParams & INCLINATION) {
-            // Rescale h+, hx by ratio of new/old inclination dependence
-            incl_ratio_plus = (1.0 + cos(i)*cos(i))
-                    / (1.0 + cos(cache->i)*cos(cache->i));
-            incl_ratio_cross = cos(i) / cos(cache->i);
-        }
-        if( changedParams & DISTANCE ) {
-            // Rescale h+, hx by ratio of (1/new_dist)/(1/old_dist) = old/new
-            dist_ratio = cache->r / r;
-        }
-
-        // Create the output polarizations
-        *hplus = XLALCreateREAL8TimeSeries(cache->hplus->name,
-                &(cache->hplus->epoch), cache->hplus->f0,
-                cache->hplus->deltaT, &(cache->hplus->sampleUnits),
-                cache->hplus->data->length);
-        if (*hplus == NULL) return XLAL_ENOMEM;
-        *hcross = XLALCreateREAL8TimeSeries(cache->hcross->name,
-                &(cache->hcross->epoch), cache->hcross->f0,
-                cache->hcross->deltaT, &(cache->hcross->sampleUnits),
-                cache->hcross->data->length);
-        if (*hcross == NULL) {
-            XLALDestroyREAL8TimeSeries(*hplus);
-            *hplus = NULL;
-            return XLAL_ENOMEM;
-        }
-
-        // Get new polarizations by transforming the old
-        incl_ratio_plus *= dist_ratio;
-        incl_ratio_cross *= dist_ratio;
-        // FIXME: Do changing phiRef and inclination commute?!?!
-        for (j = 0; j < cache->hplus->data->length; j++) {
-            (*hplus)->data->data[j] = incl_ratio_plus
-                    * (cosrot*cache->hplus->data->data[j]
-                    - sinrot*cache->hcross->data->data[j]);
-            (*hcross)->data->data[j] = incl_ratio_cross
-                    * (sinrot*cache->hplus->data->data[j]
-                    + cosrot*cache->hcross->data->data[j]);
-        }
-
-        return XLAL_SUCCESS;
-    }
-    // case 3: Non-precessing, ampO > 0
-    // FIXME: EOBNRv2HM actually ignores ampO. If it's given with ampO==0,
-    // it will fall to the catch-all and not be cached.
-    else if( (ampO==-1 || ampO>0) && (approximant==TaylorT1
-                || approximant==TaylorT2 || approximant==TaylorT3
-                || approximant==TaylorT4 || approximant==EOBNRv2HM) ) {
-        // If polarizations are not cached we must generate a fresh waveform
-        // FIXME: Add in check that hlms non-NULL
-        if( cache->hplus == NULL || cache->hcross == NULL) {
-            // FIXME: This will change to a code-path: inputs->hlms->{h+,hx}
-            status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2,
-						     S1x, S1y, S1z, S2x, S2y, S2z, r, i,
-						     phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars, approximant);
-            if (status == XLAL_FAILURE) return status;
-
-            // FIXME: Need to add hlms, dynamic variables, etc. in cache
-            return StoreTDHCache(cache, *hplus, *hcross, phiRef, deltaT, m1, m2,
-                    S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, r, i,
-                    LALpars, approximant);
-        }
-
-        if( changedParams & INCLINATION) {
-            // FIXME: For now just treat as intrinsic parameter.
-            // Will come back and put in transformation
-            status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2,
-						     S1x, S1y, S1z, S2x, S2y, S2z, r, i,
-						     phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars, approximant);
-            if (status == XLAL_FAILURE) return status;
-
-            // FIXME: Need to add hlms, dynamic variables, etc. in cache
-            return StoreTDHCache(cache, *hplus, *hcross, phiRef, deltaT, m1, m2,
-                    S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, r, i,
-                    LALpars, approximant);
-
-        }
-        if( changedParams & PHI_REF ) {
-            // FIXME: For now just treat as intrinsic parameter.
-            // Will come back and put in transformation
-            status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2,
-						     S1x, S1y, S1z, S2x, S2y, S2z, r, i,
-						     phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars,
-						     approximant);
-            if (status == XLAL_FAILURE) return status;
-
-            // FIXME: Need to add hlms, dynamic variables, etc. in cache
-            return StoreTDHCache(cache, *hplus, *hcross, phiRef, deltaT, m1, m2,
-                    S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, r, i,
-                    LALpars, approximant);
-
-        }
-        if( changedParams & DISTANCE ) {
-            // Return rescaled copy of cached polarizations
-            dist_ratio = cache->r / r;
-            *hplus = XLALCreateREAL8TimeSeries(cache->hplus->name,
-                    &(cache->hplus->epoch), cache->hplus->f0,
-                    cache->hplus->deltaT, &(cache->hplus->sampleUnits),
-                    cache->hplus->data->length);
-            if (*hplus == NULL) return XLAL_ENOMEM;
-
-            *hcross = XLALCreateREAL8TimeSeries(cache->hcross->name,
-                    &(cache->hcross->epoch), cache->hcross->f0,
-                    cache->hcross->deltaT, &(cache->hcross->sampleUnits),
-                    cache->hcross->data->length);
-            if (*hcross == NULL) {
-                XLALDestroyREAL8TimeSeries(*hplus);
-                *hplus = NULL;
-                return XLAL_ENOMEM;
-            }
-
-            for (j = 0; j < cache->hplus->data->length; j++) {
-                (*hplus)->data->data[j] = cache->hplus->data->data[j]
-                        * dist_ratio;
-                (*hcross)->data->data[j] = cache->hcross->data->data[j]
-                        * dist_ratio;
-            }
-        }
-
-        return XLAL_SUCCESS;
+    // No suitable waveform is cached. We must generate a new waveform
+    status = XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2, S1x, S1y, S1z, S2x, S2y, S2z,
+					     r, i, phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars,
+					     approximant);
+    if (status == XLAL_FAILURE) {
+        DestroyCacheEntry(request);
+        return status;
     }
 
-    // Catch-all. Unsure what to do, don't try to cache.
-    // Basically, you requested a waveform type which is not setup for caching
-    // b/c of lack of interest or it's unclear what/how to cache for that model
-    else {
-        return XLALSimInspiralChooseTDWaveform(hplus, hcross, m1, m2,
-					       S1x, S1y, S1z, S2x, S2y, S2z, r, i,
-					       phiRef, 0., 0., 0., deltaT, f_min, f_ref, LALpars, approximant);
-    }
+    // FIXME: Need to add hlms, dynamic variables, etc. in cache
+    return StoreTDHCache(cache, *hplus, *hcross, request);
 }
 
 /**
@@ -415,10 +236,11 @@ int XLALSimInspiralChooseTDWaveformFromCache(
  * Returns the waveform in the frequency domain.
  * The parameters passed must be in SI units.
  *
- * This version allows caching of waveforms. The most recently generated
- * waveform and its parameters are stored. If the next call requests a waveform
- * that can be obtained by a simple transformation, then it is done.
- * This bypasses the waveform generation and speeds up the code.
+ * This version allows caching of waveforms. Recently generated waveforms
+ * and their parameters are stored. If the next call requests a waveform
+ * with the same intrinsic parameters as a stored waveform, and it can be
+ * obtained from the stored waveform by a simple transformation, then it
+ * is done. This bypasses the waveform generation and speeds up the code.
  */
 int XLALSimInspiralChooseFDWaveformFromCache(
         COMPLEX16FrequencySeries **hptilde,     /**< +-polarization waveform */
@@ -445,11 +267,7 @@ int XLALSimInspiralChooseFDWaveformFromCache(
         )
 {
     int status;
-    size_t j;
-    REAL8 dist_ratio, incl_ratio_plus, incl_ratio_cross, phase_diff;
-    COMPLEX16 exp_dphi;
-    CacheVariableDiffersBitmask changedParams;
-
+    LALSimInspiralWaveformCacheEntry *request;
 
     // If nonGRparams are not NULL, don't even try to cache.
     if ( !XLALSimInspiralWaveformParamsNonGRAreDefault(LALpars) || (!cache) ) {
@@ -466,159 +284,80 @@ int XLALSimInspiralChooseFDWaveformFromCache(
 				approximant);
     }
 
-    // Check which parameters have changed
-    changedParams = CacheArgsDifferenceBitmask(cache, phiRef, deltaF,
-            m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i,
-	    LALpars, approximant, frequencies);
-
-    // No parameters have changed! Copy the cached polarizations
-    if( changedParams == NO_DIFFERENCE ) {
-        *hptilde = XLALCutCOMPLEX16FrequencySeries(cache->hptilde, 0,
-                cache->hptilde->data->length);
-        if (*hptilde == NULL) return XLAL_ENOMEM;
-        *hctilde = XLALCutCOMPLEX16FrequencySeries(cache->hctilde, 0,
-                cache->hctilde->data->length);
-        if (*hctilde == NULL) {
-            XLALDestroyCOMPLEX16FrequencySeries(*hptilde);
-            *hptilde = NULL;
-            return XLAL_ENOMEM;
-        }
+    request = CreateCacheEntry(phiRef, deltaF, m1, m2, S1x, S1y, S1z,
+            S2x, S2y, S2z, f_min, f_ref, f_max, r, i, LALpars, approximant,
+            frequencies);
+    if (request == NULL) XLAL_ERROR(XLAL_EFUNC);
 
+    // Try to copy or transform a cached waveform
+    status = LookupFDHCache(cache, hptilde, hctilde, request);
+    if (status != 0) {
+        DestroyCacheEntry(request);
+        if (status < 0) XLAL_ERROR(XLAL_EFUNC);
         return XLAL_SUCCESS;
     }
 
-    // Intrinsic parameters have changed. We must generate a new waveform
-    if( (changedParams & INTRINSIC) != 0 ) {
-        if ( frequencies != NULL ){
-            status =  XLALSimInspiralChooseFDWaveformSequence(hptilde, hctilde, phiRef,
-                m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref,
-	        r, i, LALpars, approximant, frequencies);
-        }
-        else {
-	  status = XLALSimInspiralChooseFDWaveform(hptilde, hctilde, m1, m2,
-						   S1x, S1y, S1z, S2x, S2y, S2z,
-						   r, i, phiRef, 0., 0., 0.,
-						   deltaF, f_min, f_max, f_ref,
-						   LALpars, approximant);
-        }
-        if (status == XLAL_FAILURE) return status;
-
-        return StoreFDHCache(cache, *hptilde, *hctilde, phiRef, deltaF, m1, m2,
-			     S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i, LALpars, approximant, frequencies);
+    // No suitable waveform is cached. We must generate a new waveform
+    if ( frequencies != NULL ){
+        status =  XLALSimInspiralChooseFDWaveformSequence(hptilde, hctilde, phiRef,
+            m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref,
+            r, i, LALpars, approximant, frequencies);
     }
-
-    // case 1: Non-precessing, 2nd harmonic only
-    if( approximant == TaylorF2 || approximant == TaylorF2RedSpin
-                || approximant == TaylorF2RedSpinTidal
-                || approximant == IMRPhenomA || approximant == IMRPhenomB
-                || approximant == IMRPhenomC ) {
-        // If polarizations are not cached we must generate a fresh waveform
-        // FIXME: Will need to check hlms and/or dynamical variables as well
-        if( cache->hptilde == NULL || cache->hctilde == NULL) {
-            if ( frequencies != NULL ){
-                status =  XLALSimInspiralChooseFDWaveformSequence(hptilde, hctilde, phiRef,
-                    m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref,
-		    r, i, LALpars, approximant,frequencies);
-            }
-            else {
-	      status = XLALSimInspiralChooseFDWaveform(hptilde, hctilde, m1, m2,
-						       S1x, S1y, S1z, S2x, S2y, S2z, r, i, phiRef,
-						       0., 0., 0., deltaF, f_min, f_max, f_ref,
-						       LALpars, approximant);
-            }
-            if (status == XLAL_FAILURE) return status;
-
-            return StoreFDHCache(cache, *hptilde, *hctilde, phiRef, deltaF,
-                    m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_min, f_ref, f_max, r, i,
-                    LALpars, approximant, frequencies);
-        }
-
-        // Set transformation coefficients for identity transformation.
-        // We'll adjust them depending on which extrinsic parameters changed.
-        dist_ratio = incl_ratio_plus = incl_ratio_cross = 1.;
-        phase_diff = 0.;
-        exp_dphi = 1.;
-
-        if( changedParams & PHI_REF ) {
-            // Only 2nd harmonic present, so {h+,hx} \propto e^(2 i phiRef)
-            phase_diff = 2.*(phiRef - cache->phiRef);
-            exp_dphi = cpolar(1., phase_diff);
-        }
-        if( changedParams & INCLINATION) {
-            // Rescale h+, hx by ratio of new/old inclination dependence
-            incl_ratio_plus = (1.0 + cos(i)*cos(i))
-                    / (1.0 + cos(cache->i)*cos(cache->i));
-            incl_ratio_cross = cos(i) / cos(cache->i);
-        }
-        if( changedParams & DISTANCE ) {
-            // Rescale h+, hx by ratio of (1/new_dist)/(1/old_dist) = old/new
-            dist_ratio = cache->r / r;
-        }
-
-        // Create the output polarizations
-        *hptilde = XLALCreateCOMPLEX16FrequencySeries(cache->hptilde->name,
-                &(cache->hptilde->epoch), cache->hptilde->f0,
-                cache->hptilde->deltaF, &(cache->hptilde->sampleUnits),
-                cache->hptilde->data->length);
-        if (*hptilde == NULL) return XLAL_ENOMEM;
-
-        *hctilde = XLALCreateCOMPLEX16FrequencySeries(cache->hctilde->name,
-                &(cache->hctilde->epoch), cache->hctilde->f0,
-                cache->hctilde->deltaF, &(cache->hctilde->sampleUnits),
-                cache->hctilde->data->length);
-        if (*hctilde == NULL) {
-            XLALDestroyCOMPLEX16FrequencySeries(*hptilde);
-            *hptilde = NULL;
-            return XLAL_ENOMEM;
-        }
-
-        // Get new polarizations by transforming the old
-        incl_ratio_plus *= dist_ratio;
-        incl_ratio_cross *= dist_ratio;
-        for (j = 0; j < cache->hptilde->data->length; j++) {
-            (*hptilde)->data->data[j] = exp_dphi * incl_ratio_plus
-                    * cache->hptilde->data->data[j];
-            (*hctilde)->data->data[j] = exp_dphi * incl_ratio_cross
-                    * cache->hctilde->data->data[j];
-        }
-
-        return XLAL_SUCCESS;
-    }
-
-    // case 2: Precessing
-    /*else if( approximant == SpinTaylorF2 ) {
-
-    }*/
-
-    // Catch-all. Unsure what to do, don't try to cache.
-    // Basically, you requested a waveform type which is not setup for caching
-    // b/c of lack of interest or it's unclear what/how to cache for that model
     else {
-        if ( frequencies != NULL ){
-            return XLALSimInspiralChooseFDWaveformSequence(hptilde, hctilde, phiRef,
-                    m1, m2, S1x, S1y, S1z, S2x, S2y, S2z, f_ref,
-                    r, i, LALpars, approximant,frequencies);
-        }
-        else {
-	  return XLALSimInspiralChooseFDWaveform(hptilde, hctilde, m1, m2,
-						 S1x, S1y, S1z, S2x, S2y, S2z,
-						 r, i, phiRef, 0., 0., 0.,
-						 deltaF, f_min, f_max, f_ref,
-						 NULL, approximant);
-        }
+        status = XLALSimInspiralChooseFDWaveform(hptilde, hctilde, m1, m2,
+                                                 S1x, S1y, S1z, S2x, S2y, S2z,
+                                                 r, i, phiRef, 0., 0., 0.,
+                                                 deltaF, f_min, f_max, f_ref,
+                                                 LALpars, approximant);
+    }
+    if (status == XLAL_FAILURE) {
+        DestroyCacheEntry(request);
+        return status;
     }
 
+    return StoreFDHCache(cache, *hptilde, *hctilde, request);
 }
 
 /**
- * Construct and initialize a waveform cache.  Caches are used to
- * avoid re-computation of waveforms that differ only by simple
- * scaling relations in extrinsic parameters.
+ * Construct and initialize a waveform cache with the default limits
+ * #LAL_SIM_INSPIRAL_WAVEFORM_CACHE_DEFAULT_ENTRIES and
+ * #LAL_SIM_INSPIRAL_WAVEFORM_CACHE_DEFAULT_BYTES.  Caches are used to
+ * avoid re-computation of waveforms that have been computed before, or
+ * that differ only by simple scaling relations in extrinsic parameters.
  */
 LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCache()
 {
-    LALSimInspiralWaveformCache *cache = XLALCalloc(1,
-            sizeof(LALSimInspiralWaveformCache));
+    LALSimInspiralWaveformCache *cache;
+    cache = XLALCreateSimInspiralWaveformCacheWithLimits(
+            LAL_SIM_INSPIRAL_WAVEFORM_CACHE_DEFAULT_ENTRIES,
+            LAL_SIM_INSPIRAL_WAVEFORM_CACHE_DEFAULT_BYTES);
+    if (cache == NULL) XLAL_ERROR_NULL(XLAL_EFUNC);
+    return cache;
+}
+
+/**
+ * Construct and initialize a waveform cache which holds at most
+ * \c maxEntries waveforms, with at most \c maxBytes of waveform data.
+ * A waveform larger than \c maxBytes is never cached.
+ */
+LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCacheWithLimits(
+        UINT4 maxEntries,       /**< maximum number of cached waveforms */
+        UINT8 maxBytes          /**< maximum size of cached waveform data (bytes) */
+        )
+{
+    LALSimInspiralWaveformCache *cache;
+    if (maxEntries == 0) XLAL_ERROR_NULL(XLAL_EINVAL, "Cache must hold at least one waveform");
+
+    cache = XLALCalloc(1, sizeof(LALSimInspiralWaveformCache));
+    if (cache == NULL) XLAL_ERROR_NULL(XLAL_ENOMEM);
+    cache->stats.maxEntries = maxEntries;
+    cache->stats.maxBytes = maxBytes;
+#ifdef LAL_PTHREAD_LOCK
+    if (pthread_mutex_init(&cache->mutex, NULL) != 0) {
+        XLALFree(cache);
+        XLAL_ERROR_NULL(XLAL_ESYS);
+    }
+#endif
 
     return cache;
 }
@@ -629,67 +368,266 @@ LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCache()
 void XLALDestroySimInspiralWaveformCache(LALSimInspiralWaveformCache *cache)
 {
     if (cache != NULL) {
-        XLALDestroyREAL8TimeSeries(cache->hplus);
-        XLALDestroyREAL8TimeSeries(cache->hcross);
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hptilde);
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hctilde);
+        while (cache->head != NULL) {
+            LALSimInspiralWaveformCacheEntry *next = cache->head->next;
+            DestroyCacheEntry(cache->head);
+            cache->head = next;
+        }
+#ifdef LAL_PTHREAD_LOCK
+        pthread_mutex_destroy(&cache->mutex);
+#endif
 
         XLALFree(cache);
     }
 }
 
+/**
+ * Return the hit, miss, and eviction counters, and the current and
+ * maximum occupancy, of a waveform cache.
+ */
+int XLALSimInspiralWaveformCacheGetStats(
+        LALSimInspiralWaveformCacheStats *stats,        /**< [out] cache statistics */
+        LALSimInspiralWaveformCache *cache              /**< waveform cache structure */
+        )
+{
+    if (stats == NULL || cache == NULL) XLAL_ERROR(XLAL_EFAULT);
+    CACHE_LOCK(cache);
+    *stats = cache->stats;
+    CACHE_UNLOCK(cache);
+    return XLAL_SUCCESS;
+}
+
 /** @} */
 
 /**
- * Function to compare the requested arguments to those stored in the cache,
- * returns a bitmask which determines if a cached waveform can be recycled.
+ * Create a cache entry holding a copy of the waveform parameters, without
+ * any waveform data.  The entry key is a hash of all the parameters which
+ * must match exactly for a cached waveform to be reused.
  */
-static CacheVariableDiffersBitmask CacheArgsDifferenceBitmask(
-        LALSimInspiralWaveformCache *cache,
+static LALSimInspiralWaveformCacheEntry *CreateCacheEntry(
         REAL8 phiRef,
         REAL8 deltaTF,
-        REAL8 m1,
-        REAL8 m2,
+        REAL8 m1, REAL8 m2,
         REAL8 S1x, REAL8 S1y, REAL8 S1z,
         REAL8 S2x, REAL8 S2y, REAL8 S2z,
         REAL8 f_min, REAL8 f_ref, REAL8 f_max,
         REAL8 r,
         REAL8 i,
-	LALDict *LALpars,
+        LALDict *LALpars,
         Approximant approximant,
         REAL8Sequence *frequencies
         )
+{
+    LALSimInspiralWaveformCacheEntry *entry;
+    REAL8 intrinsic[12];
+
+    entry = XLALCalloc(1, sizeof(LALSimInspiralWaveformCacheEntry));
+    if (entry == NULL) XLAL_ERROR_NULL(XLAL_ENOMEM);
+
+    entry->phiRef = phiRef;
+    entry->deltaTF = deltaTF;
+    entry->m1 = m1;
+    entry->m2 = m2;
+    entry->S1x = S1x;
+    entry->S1y = S1y;
+    entry->S1z = S1z;
+    entry->S2x = S2x;
+    entry->S2y = S2y;
+    entry->S2z = S2z;
+    entry->f_min = f_min;
+    entry->f_ref = f_ref;
+    entry->f_max = f_max;
+    entry->r = r;
+    entry->i = i;
+    entry->approximant = approximant;
+
+    /* Copy the non-mandatory parameters, so that the caller may change them */
+    entry->LALpars = XLALCreateDict();
+    if (entry->LALpars == NULL) {
+        DestroyCacheEntry(entry);
+        XLAL_ERROR_NULL(XLAL_EFUNC);
+    }
+    if (LALpars != NULL) {
+        LALDictIter iter;
+        LALDictEntry *item;
+        XLALDictIterInit(&iter, LALpars);
+        while ((item = XLALDictIterNext(&iter)) != NULL) {
+            if (XLALDictInsertValue(entry->LALpars, XLALDictEntryGetKey(item), XLALDictEntryGetValue(item)) != XLAL_SUCCESS) {
+                DestroyCacheEntry(entry);
+                XLAL_ERROR_NULL(XLAL_EFUNC);
+            }
+        }
+    }
+
+    if (frequencies != NULL) {
+        entry->frequencies = XLALCopyREAL8Sequence(frequencies);
+        if (entry->frequencies == NULL) {
+            DestroyCacheEntry(entry);
+            XLAL_ERROR_NULL(XLAL_EFUNC);
+        }
+    }
+
+    /* Hash the intrinsic parameters */
+    intrinsic[0] = deltaTF;
+    intrinsic[1] = m1;
+    intrinsic[2] = m2;
+    intrinsic[3] = S1x;
+    intrinsic[4] = S1y;
+    intrinsic[5] = S1z;
+    intrinsic[6] = S2x;
+    intrinsic[7] = S2y;
+    intrinsic[8] = S2z;
+    intrinsic[9] = f_min;
+    intrinsic[10] = f_ref;
+    intrinsic[11] = f_max;
+    entry->key = XLALCityHash64((const char *) intrinsic, sizeof(intrinsic));
+    entry->key ^= (UINT8) approximant * 0x9E3779B97F4A7C15ULL;
+    if (frequencies != NULL && frequencies->length > 0)
+        entry->key ^= XLALCityHash64((const char *) frequencies->data, frequencies->length * sizeof(REAL8));
+
+    return entry;
+}
+
+/** Destroy a cache entry and its waveform data. */
+static void DestroyCacheEntry(LALSimInspiralWaveformCacheEntry *entry)
+{
+    if (entry != NULL) {
+        XLALDestroyREAL8TimeSeries(entry->hplus);
+        XLALDestroyREAL8TimeSeries(entry->hcross);
+        XLALDestroyCOMPLEX16FrequencySeries(entry->hptilde);
+        XLALDestroyCOMPLEX16FrequencySeries(entry->hctilde);
+        XLALDestroyREAL8Sequence(entry->frequencies);
+        XLALDestroyDict(entry->LALpars);
+        XLALFree(entry);
+    }
+}
+
+/** Remove an entry from the list of cache entries. Must be called with the cache locked. */
+static void UnlinkCacheEntry(
+        LALSimInspiralWaveformCache *cache,
+        LALSimInspiralWaveformCacheEntry *entry
+        )
+{
+    if (entry->prev != NULL)
+        entry->prev->next = entry->next;
+    else
+        cache->head = entry->next;
+    if (entry->next != NULL)
+        entry->next->prev = entry->prev;
+    else
+        cache->tail = entry->prev;
+    entry->prev = entry->next = NULL;
+    cache->stats.entries -= 1;
+    cache->stats.bytes -= entry->bytes;
+}
+
+/** Add an entry at the head of the list of cache entries. Must be called with the cache locked. */
+static void LinkCacheEntry(
+        LALSimInspiralWaveformCache *cache,
+        LALSimInspiralWaveformCacheEntry *entry
+        )
+{
+    entry->prev = NULL;
+    entry->next = cache->head;
+    if (cache->head != NULL)
+        cache->head->prev = entry;
+    else
+        cache->tail = entry;
+    cache->head = entry;
+    cache->stats.entries += 1;
+    cache->stats.bytes += entry->bytes;
+}
+
+/**
+ * Find the cached waveform in the time (fdomain = 0) or frequency
+ * (fdomain = 1) domain whose intrinsic parameters match those of the
+ * request, or NULL if there is none. Must be called with the cache locked.
+ */
+static LALSimInspiralWaveformCacheEntry *FindCacheEntry(
+        LALSimInspiralWaveformCache *cache,
+        const LALSimInspiralWaveformCacheEntry *request,
+        int fdomain
+        )
+{
+    LALSimInspiralWaveformCacheEntry *entry;
+    for (entry = cache->head; entry != NULL; entry = entry->next) {
+        if (entry->key != request->key) continue;
+        if (fdomain ? (entry->hptilde == NULL) : (entry->hplus == NULL)) continue;
+        if (CacheArgsDifferenceBitmask(entry, request) & INTRINSIC) continue;
+        return entry;
+    }
+    return NULL;
+}
+
+/**
+ * Insert a new entry into the cache, replacing any entry with the same
+ * intrinsic parameters, then evict the least recently used entries until
+ * the cache is within its limits. The cache takes ownership of the entry.
+ */
+static void InsertCacheEntry(
+        LALSimInspiralWaveformCache *cache,
+        LALSimInspiralWaveformCacheEntry *entry,
+        int fdomain
+        )
+{
+    LALSimInspiralWaveformCacheEntry *old;
+
+    /* Waveforms which cannot fit are not cached */
+    if (entry->bytes > cache->stats.maxBytes) {
+        DestroyCacheEntry(entry);
+        return;
+    }
+
+    CACHE_LOCK(cache);
+    old = FindCacheEntry(cache, entry, fdomain);
+    if (old != NULL) {
+        UnlinkCacheEntry(cache, old);
+        DestroyCacheEntry(old);
+    }
+    LinkCacheEntry(cache, entry);
+    while (cache->stats.entries > cache->stats.maxEntries || cache->stats.bytes > cache->stats.maxBytes) {
+        old = cache->tail;
+        UnlinkCacheEntry(cache, old);
+        DestroyCacheEntry(old);
+        cache->stats.evictions += 1;
+    }
+    CACHE_UNLOCK(cache);
+}
+
+/**
+ * Function to compare the requested arguments to those stored in the cache,
+ * returns a bitmask which determines if a cached waveform can be recycled.
+ */
+static CacheVariableDiffersBitmask CacheArgsDifferenceBitmask(
+        const LALSimInspiralWaveformCacheEntry *cached,
+        const LALSimInspiralWaveformCacheEntry *request
+        )
 {
     CacheVariableDiffersBitmask difference = NO_DIFFERENCE;
-    if (cache == NULL) return INTRINSIC;
-
-    if ( !XLALSimInspiralWaveformFlagsEqual(LALpars, cache->LALpars) )
-        return INTRINSIC;
-
-    if ( deltaTF != cache->deltaTF) return INTRINSIC;
-    if ( m1 != cache->m1) return INTRINSIC;
-    if ( m2 != cache->m2) return INTRINSIC;
-    if ( S1x != cache->S1x) return INTRINSIC;
-    if ( S1y != cache->S1y) return INTRINSIC;
-    if ( S1z != cache->S1z) return INTRINSIC;
-    if ( S2x != cache->S2x) return INTRINSIC;
-    if ( S2y != cache->S2y) return INTRINSIC;
-    if ( S2z != cache->S2z) return INTRINSIC;
-    if ( f_min != cache->f_min) return INTRINSIC;
-    if ( f_ref != cache->f_ref) return INTRINSIC;
-    if ( f_max != cache->f_max) return INTRINSIC;
-    if ( XLALSimInspiralWaveformParamsLookupTidalLambda1(LALpars) != XLALSimInspiralWaveformParamsLookupTidalLambda1(cache->LALpars)) return INTRINSIC;
-    if ( XLALSimInspiralWaveformParamsLookupTidalLambda2(LALpars) != XLALSimInspiralWaveformParamsLookupTidalLambda2(cache->LALpars)) return INTRINSIC;
-    if ( XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(LALpars) != XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(cache->LALpars)) return INTRINSIC;
-    if ( XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(LALpars) != XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(cache->LALpars)) return INTRINSIC;
-
-    if ( approximant != cache->approximant) return INTRINSIC;
-
-    if (r != cache->r) difference = difference | DISTANCE;
-    if (phiRef != cache->phiRef) difference = difference | PHI_REF;
-    if (i != cache->i) difference = difference | INCLINATION;
-
-    if (FrequenciesAreDifferent(frequencies,cache->frequencies)) return INTRINSIC;
+    if (cached == NULL) return INTRINSIC;
+
+    if ( request->deltaTF != cached->deltaTF) return INTRINSIC;
+    if ( request->m1 != cached->m1) return INTRINSIC;
+    if ( request->m2 != cached->m2) return INTRINSIC;
+    if ( request->S1x != cached->S1x) return INTRINSIC;
+    if ( request->S1y != cached->S1y) return INTRINSIC;
+    if ( request->S1z != cached->S1z) return INTRINSIC;
+    if ( request->S2x != cached->S2x) return INTRINSIC;
+    if ( request->S2y != cached->S2y) return INTRINSIC;
+    if ( request->S2z != cached->S2z) return INTRINSIC;
+    if ( request->f_min != cached->f_min) return INTRINSIC;
+    if ( request->f_ref != cached->f_ref) return INTRINSIC;
+    if ( request->f_max != cached->f_max) return INTRINSIC;
+    if ( request->approximant != cached->approximant) return INTRINSIC;
+
+    if (FrequenciesAreDifferent(request->frequencies, cached->frequencies)) return INTRINSIC;
+
+    // All flags, tidal parameters, PN orders, etc. must be the same
+    if (DictsAreDifferent(request->LALpars, cached->LALpars)) return INTRINSIC;
+
+    if (request->r != cached->r) difference = difference | DISTANCE;
+    if (request->phiRef != cached->phiRef) difference = difference | PHI_REF;
+    if (request->i != cached->i) difference = difference | INCLINATION;
 
     return difference;
 }
@@ -714,142 +652,332 @@ static int FrequenciesAreDifferent(
     return 0;
 }
 
-/** Store the output TD hplus and hcross in the cache. */
-static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
-        REAL8TimeSeries *hplus,
-        REAL8TimeSeries *hcross,
-        REAL8 phiRef,
-        REAL8 deltaT,
-        REAL8 m1, REAL8 m2,
-        REAL8 S1x, REAL8 S1y, REAL8 S1z,
-        REAL8 S2x, REAL8 S2y, REAL8 S2z,
-        REAL8 f_min, REAL8 f_ref,
-        REAL8 r,
-        REAL8 i,
-        LALDict *LALpars,
-        Approximant approximant
+/**
+ * Function to compare the contents of two dictionaries.
+ * Returns 1 if different, 0 if they hold the same keys and values.
+ */
+static int DictsAreDifferent(LALDict *dict1, LALDict *dict2)
+{
+    LALDictIter iter;
+    LALDictEntry *item;
+    if ( XLALDictSize(dict1) != XLALDictSize(dict2) ) return 1;
+    XLALDictIterInit(&iter, dict1);
+    while ((item = XLALDictIterNext(&iter)) != NULL) {
+        LALDictEntry *other = XLALDictLookup(dict2, XLALDictEntryGetKey(item));
+        if ( other == NULL ) return 1;
+        if ( !XLALValueEqual(XLALDictEntryGetValue(item), XLALDictEntryGetValue(other)) ) return 1;
+    }
+    return 0;
+}
+
+/**
+ * Copy or transform a cached TD waveform to satisfy the request.
+ * Returns 1 if the waveform was obtained from the cache, 0 if it must be
+ * generated, or XLAL_FAILURE on error.
+ */
+static int LookupTDHCache(LALSimInspiralWaveformCache *cache,
+        REAL8TimeSeries **hplus,
+        REAL8TimeSeries **hcross,
+        const LALSimInspiralWaveformCacheEntry *request
         )
 {
-    /* Clear any frequency-domain data. */
-    if (cache->hptilde != NULL) {
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hptilde);
-        cache->hptilde = NULL;
+    size_t j;
+    int usable;
+    REAL8 phasediff, dist_ratio, incl_ratio_plus, incl_ratio_cross;
+    REAL8 cosrot, sinrot;
+    CacheVariableDiffersBitmask changedParams;
+    LALSimInspiralWaveformCacheEntry *cached;
+    Approximant approximant = request->approximant;
+
+    CACHE_LOCK(cache);
+    cached = FindCacheEntry(cache, request, 0);
+    if (cached == NULL) {
+        cache->stats.misses += 1;
+        CACHE_UNLOCK(cache);
+        return 0;
     }
 
-    if (cache->hctilde != NULL) {
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hctilde);
-        cache->hctilde = NULL;
+    // Check which parameters have changed
+    changedParams = CacheArgsDifferenceBitmask(cached, request);
+
+    INT4 ampO=XLALSimInspiralWaveformParamsLookupPNAmplitudeOrder(request->LALpars);
+    if( changedParams == NO_DIFFERENCE ) {
+        // No parameters have changed! Copy the cached polarizations
+        usable = 1;
+    }
+    // case 1: Precessing waveforms
+    // FIXME: For now treat phiRef and inclination as intrinsic parameters.
+    // Will come back and put in transformation
+    else if( approximant == SpinTaylorT4 || approximant == SpinTaylorT2 ) {
+        usable = (changedParams == DISTANCE);
+    }
+    // case 2: Non-precessing, ampO = 0
+    else if( ampO==0 && (approximant==TaylorT1 || approximant==TaylorT2
+                || approximant==TaylorT3 || approximant==TaylorT4
+                || approximant==EOBNRv2 || approximant==SEOBNRv1) ) {
+        usable = 1;
+    }
+    // case 3: Non-precessing, ampO > 0
+    // FIXME: EOBNRv2HM actually ignores ampO. If it's given with ampO==0,
+    // it will fall to the catch-all and not be transformed.
+    // FIXME: For now treat phiRef and inclination as intrinsic parameters.
+    // Will come back and put in transformation
+    else if( (ampO==-1 || ampO>0) && (approximant==TaylorT1
+                || approximant==TaylorT2 || approximant==TaylorT3
+                || approximant==TaylorT4 || approximant==EOBNRv2HM) ) {
+        usable = (changedParams == DISTANCE);
+    }
+    // Catch-all. Only an identical waveform can be reused.
+    // Basically, you requested a waveform type which is not setup for
+    // transformation b/c of lack of interest or it's unclear how to do it
+    else {
+        usable = 0;
     }
 
-    /* Store params in cache */
-    cache->phiRef = phiRef;
-    cache->deltaTF = deltaT;
-    cache->m1 = m1;
-    cache->m2 = m2;
-    cache->S1x = S1x;
-    cache->S1y = S1y;
-    cache->S1z = S1z;
-    cache->S2x = S2x;
-    cache->S2y = S2y;
-    cache->S2z = S2z;
-    cache->f_min = f_min;
-    cache->f_ref = f_ref;
-    cache->r = r;
-    cache->i = i;
-    cache->LALpars = LALpars;
-    cache->approximant = approximant;
-    cache->frequencies = NULL;
+    if (!usable) {
+        cache->stats.misses += 1;
+        CACHE_UNLOCK(cache);
+        return 0;
+    }
 
-    // Copy over the waveforms
+    // Set transformation coefficients for identity transformation.
+    // We'll adjust them depending on which extrinsic parameters changed.
+    dist_ratio = incl_ratio_plus = incl_ratio_cross = cosrot = 1.;
+    phasediff = sinrot = 0.;
+
+    if( changedParams & PHI_REF ) {
+        // Only 2nd harmonic present, so {h+,hx} rotates by 2*deltaphiRef
+        phasediff = 2.*(request->phiRef - cached->phiRef);
+        cosrot = cos(phasediff);
+        sinrot = sin(phasediff);
+    }
+    if( changedParams & INCLINATION) {
+        // Rescale h+, hx by ratio of new/old inclination dependence
+        incl_ratio_plus = (1.0 + cos(request->i)*cos(request->i))
+                / (1.0 + cos(cached->i)*cos(cached->i));
+        incl_ratio_cross = cos(request->i) / cos(cached->i);
+    }
+    if( changedParams & DISTANCE ) {
+        // Rescale h+, hx by ratio of (1/new_dist)/(1/old_dist) = old/new
+        dist_ratio = cached->r / request->r;
+    }
+
+    // Create the output polarizations
     // NB: XLALCut... creates a new Series object and copies data and metadata
-    XLALDestroyREAL8TimeSeries(cache->hplus);
-    XLALDestroyREAL8TimeSeries(cache->hcross);
+    *hplus = XLALCutREAL8TimeSeries(cached->hplus, 0,
+            cached->hplus->data->length);
+    *hcross = XLALCutREAL8TimeSeries(cached->hcross, 0,
+            cached->hcross->data->length);
+    if (*hplus == NULL || *hcross == NULL) {
+        CACHE_UNLOCK(cache);
+        XLALDestroyREAL8TimeSeries(*hplus);
+        XLALDestroyREAL8TimeSeries(*hcross);
+        *hplus = *hcross = NULL;
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+
+    // Get new polarizations by transforming the old
+    if( changedParams != NO_DIFFERENCE ) {
+        incl_ratio_plus *= dist_ratio;
+        incl_ratio_cross *= dist_ratio;
+        // FIXME: Do changing phiRef and inclination commute?!?!
+        for (j = 0; j < cached->hplus->data->length; j++) {
+            (*hplus)->data->data[j] = incl_ratio_plus
+                    * (cosrot*cached->hplus->data->data[j]
+                    - sinrot*cached->hcross->data->data[j]);
+            (*hcross)->data->data[j] = incl_ratio_cross
+                    * (sinrot*cached->hplus->data->data[j]
+                    + cosrot*cached->hcross->data->data[j]);
+        }
+    }
+
+    // Mark the cached waveform as most recently used
+    UnlinkCacheEntry(cache, cached);
+    LinkCacheEntry(cache, cached);
+    cache->stats.hits += 1;
+    CACHE_UNLOCK(cache);
+
+    return 1;
+}
+
+/**
+ * Copy or transform a cached FD waveform to satisfy the request.
+ * Returns 1 if the waveform was obtained from the cache, 0 if it must be
+ * generated, or XLAL_FAILURE on error.
+ */
+static int LookupFDHCache(LALSimInspiralWaveformCache *cache,
+        COMPLEX16FrequencySeries **hptilde,
+        COMPLEX16FrequencySeries **hctilde,
+        const LALSimInspiralWaveformCacheEntry *request
+        )
+{
+    size_t j;
+    int usable;
+    REAL8 dist_ratio, incl_ratio_plus, incl_ratio_cross, phase_diff;
+    COMPLEX16 exp_dphi;
+    CacheVariableDiffersBitmask changedParams;
+    LALSimInspiralWaveformCacheEntry *cached;
+    Approximant approximant = request->approximant;
+
+    CACHE_LOCK(cache);
+    cached = FindCacheEntry(cache, request, 1);
+    if (cached == NULL) {
+        cache->stats.misses += 1;
+        CACHE_UNLOCK(cache);
+        return 0;
+    }
+
+    // Check which parameters have changed
+    changedParams = CacheArgsDifferenceBitmask(cached, request);
+
+    if( changedParams == NO_DIFFERENCE ) {
+        // No parameters have changed! Copy the cached polarizations
+        usable = 1;
+    }
+    // case 1: Non-precessing, 2nd harmonic only
+    else if( approximant == TaylorF2 || approximant == TaylorF2RedSpin
+                || approximant == TaylorF2RedSpinTidal
+                || approximant == IMRPhenomA || approximant == IMRPhenomB
+                || approximant == IMRPhenomC ) {
+        usable = 1;
+    }
+    // case 2: Precessing
+    /*else if( approximant == SpinTaylorF2 ) {
+
+    }*/
+    // Catch-all. Only an identical waveform can be reused.
+    // Basically, you requested a waveform type which is not setup for
+    // transformation b/c of lack of interest or it's unclear how to do it
+    else {
+        usable = 0;
+    }
+
+    if (!usable) {
+        cache->stats.misses += 1;
+        CACHE_UNLOCK(cache);
+        return 0;
+    }
+
+    // Set transformation coefficients for identity transformation.
+    // We'll adjust them depending on which extrinsic parameters changed.
+    dist_ratio = incl_ratio_plus = incl_ratio_cross = 1.;
+    phase_diff = 0.;
+    exp_dphi = 1.;
+
+    if( changedParams & PHI_REF ) {
+        // Only 2nd harmonic present, so {h+,hx} \propto e^(2 i phiRef)
+        phase_diff = 2.*(request->phiRef - cached->phiRef);
+        exp_dphi = cpolar(1., phase_diff);
+    }
+    if( changedParams & INCLINATION) {
+        // Rescale h+, hx by ratio of new/old inclination dependence
+        incl_ratio_plus = (1.0 + cos(request->i)*cos(request->i))
+                / (1.0 + cos(cached->i)*cos(cached->i));
+        incl_ratio_cross = cos(request->i) / cos(cached->i);
+    }
+    if( changedParams & DISTANCE ) {
+        // Rescale h+, hx by ratio of (1/new_dist)/(1/old_dist) = old/new
+        dist_ratio = cached->r / request->r;
+    }
+
+    // Create the output polarizations
+    // NB: XLALCut... creates a new Series object and copies data and metadata
+    *hptilde = XLALCutCOMPLEX16FrequencySeries(cached->hptilde, 0,
+            cached->hptilde->data->length);
+    *hctilde = XLALCutCOMPLEX16FrequencySeries(cached->hctilde, 0,
+            cached->hctilde->data->length);
+    if (*hptilde == NULL || *hctilde == NULL) {
+        CACHE_UNLOCK(cache);
+        XLALDestroyCOMPLEX16FrequencySeries(*hptilde);
+        XLALDestroyCOMPLEX16FrequencySeries(*hctilde);
+        *hptilde = *hctilde = NULL;
+        XLAL_ERROR(XLAL_ENOMEM);
+    }
+
+    // Get new polarizations by transforming the old
+    if( changedParams != NO_DIFFERENCE ) {
+        incl_ratio_plus *= dist_ratio;
+        incl_ratio_cross *= dist_ratio;
+        for (j = 0; j < cached->hptilde->data->length; j++) {
+            (*hptilde)->data->data[j] = exp_dphi * incl_ratio_plus
+                    * cached->hptilde->data->data[j];
+            (*hctilde)->data->data[j] = exp_dphi * incl_ratio_cross
+                    * cached->hctilde->data->data[j];
+        }
+    }
+
+    // Mark the cached waveform as most recently used
+    UnlinkCacheEntry(cache, cached);
+    LinkCacheEntry(cache, cached);
+    cache->stats.hits += 1;
+    CACHE_UNLOCK(cache);
+
+    return 1;
+}
+
+/**
+ * Store the output TD hplus and hcross in the cache. The cache takes
+ * ownership of the request entry, which holds the waveform parameters.
+ */
+static int StoreTDHCache(LALSimInspiralWaveformCache *cache,
+        REAL8TimeSeries *hplus,
+        REAL8TimeSeries *hcross,
+        LALSimInspiralWaveformCacheEntry *request
+        )
+{
     if (hplus == NULL || hcross == NULL || hplus->data == NULL || hcross->data == NULL){
         XLALPrintError("We have null pointers for h+, hx in StoreTDHCache \n");
         XLALPrintError("Houston-S, we've got a problem SOS, SOS, SOS, the waveform generator returns NULL!!!... m1 = %.18e, m2 = %.18e, fMin = %.18e, spin1 = {%.18e, %.18e, %.18e},   spin2 = {%.18e, %.18e, %.18e} \n",
-                   m1, m2, (double)f_min, S1x, S1y, S1z, S2x, S2y, S2z);
-        return XLAL_ENOMEM;
+                   request->m1, request->m2, (double)request->f_min, request->S1x, request->S1y, request->S1z, request->S2x, request->S2y, request->S2z);
+        DestroyCacheEntry(request);
+        XLAL_ERROR(XLAL_EFAULT);
     }
-    cache->hplus = XLALCutREAL8TimeSeries(hplus, 0, hplus->data->length);
-    if (cache->hplus == NULL) return XLAL_ENOMEM;
-    cache->hcross = XLALCutREAL8TimeSeries(hcross, 0, hcross->data->length);
-    if (cache->hcross == NULL) {
-        XLALDestroyREAL8TimeSeries(cache->hplus);
-        cache->hplus = NULL;
-        return XLAL_ENOMEM;
+
+    // Copy over the waveforms
+    // NB: XLALCut... creates a new Series object and copies data and metadata
+    request->hplus = XLALCutREAL8TimeSeries(hplus, 0, hplus->data->length);
+    request->hcross = XLALCutREAL8TimeSeries(hcross, 0, hcross->data->length);
+    if (request->hplus == NULL || request->hcross == NULL) {
+        DestroyCacheEntry(request);
+        XLAL_ERROR(XLAL_ENOMEM);
     }
+    request->bytes = sizeof(*request)
+            + (hplus->data->length + hcross->data->length) * sizeof(REAL8);
 
+    InsertCacheEntry(cache, request, 0);
     return XLAL_SUCCESS;
 }
 
-/** Store the output FD hptilde and hctilde in cache. */
+/**
+ * Store the output FD hptilde and hctilde in cache. The cache takes
+ * ownership of the request entry, which holds the waveform parameters.
+ */
 static int StoreFDHCache(LALSimInspiralWaveformCache *cache,
         COMPLEX16FrequencySeries *hptilde,
         COMPLEX16FrequencySeries *hctilde,
-        REAL8 phiRef,
-        REAL8 deltaT,
-        REAL8 m1, REAL8 m2,
-        REAL8 S1x, REAL8 S1y, REAL8 S1z,
-        REAL8 S2x, REAL8 S2y, REAL8 S2z,
-        REAL8 f_min, REAL8 f_ref, REAL8 f_max,
-        REAL8 r,
-        REAL8 i,
-	LALDict *LALpars,
-        Approximant approximant,
-        REAL8Sequence *frequencies
+        LALSimInspiralWaveformCacheEntry *request
         )
 {
-    /* Clear any time-domain data. */
-    if (cache->hplus != NULL) {
-        XLALDestroyREAL8TimeSeries(cache->hplus);
-        cache->hplus = NULL;
-    }
-
-    if (cache->hcross != NULL) {
-        XLALDestroyREAL8TimeSeries(cache->hcross);
-        cache->hcross = NULL;
-    }
-
-    /* Store params in cache */
-    cache->phiRef = phiRef;
-    cache->deltaTF = deltaT;
-    cache->m1 = m1;
-    cache->m2 = m2;
-    cache->S1x = S1x;
-    cache->S1y = S1y;
-    cache->S1z = S1z;
-    cache->S2x = S2x;
-    cache->S2y = S2y;
-    cache->S2z = S2z;
-    cache->f_min = f_min;
-    cache->f_ref = f_ref;
-    cache->f_max = f_max;
-    cache->r = r;
-    cache->i = i;
-    cache->LALpars = LALpars;
-    cache->approximant = approximant;
-
-    XLALDestroyREAL8Sequence(cache->frequencies);
-    cache->frequencies = NULL;
-    if (frequencies != NULL){
-        cache->frequencies = XLALCopyREAL8Sequence(frequencies);
+    if (hptilde == NULL || hctilde == NULL || hptilde->data == NULL || hctilde->data == NULL) {
+        DestroyCacheEntry(request);
+        XLAL_ERROR(XLAL_EFAULT, "We have null pointers for h+, hx in StoreFDHCache");
     }
 
     // Copy over the waveforms
     // NB: XLALCut... creates a new Series object and copies data and metadata
-    XLALDestroyCOMPLEX16FrequencySeries(cache->hptilde);
-    XLALDestroyCOMPLEX16FrequencySeries(cache->hctilde);
-    cache->hptilde = XLALCutCOMPLEX16FrequencySeries(hptilde, 0,
+    request->hptilde = XLALCutCOMPLEX16FrequencySeries(hptilde, 0,
             hptilde->data->length);
-    if (cache->hptilde == NULL) return XLAL_ENOMEM;
-    cache->hctilde = XLALCutCOMPLEX16FrequencySeries(hctilde, 0,
+    request->hctilde = XLALCutCOMPLEX16FrequencySeries(hctilde, 0,
             hctilde->data->length);
-    if (cache->hctilde == NULL) {
-        XLALDestroyCOMPLEX16FrequencySeries(cache->hptilde);
-        cache->hptilde = NULL;
-        return XLAL_ENOMEM;
+    if (request->hptilde == NULL || request->hctilde == NULL) {
+        DestroyCacheEntry(request);
+        XLAL_ERROR(XLAL_ENOMEM);
     }
+    request->bytes = sizeof(*request)
+            + (hptilde->data->length + hctilde->data->length) * sizeof(COMPLEX16)
+            + (request->frequencies ? request->frequencies->length * sizeof(REAL8) : 0);
 
+    InsertCacheEntry(cache, request, 1);
     return XLAL_SUCCESS;
 }
 
@@ -73,38 +73,49 @@ tagLALSimInspiralWaveformCacheOld {
     REAL8Sequence *frequencies;
 } LALSimInspiralWaveformCacheOld;
 
+/**
+ * Multi-entry cache of previously-computed waveforms.
+ *
+ * The cache holds up to a fixed number of waveforms, and up to a fixed
+ * total amount of waveform data, each keyed on the full set of intrinsic
+ * parameters, the approximant, the sampling interval or frequency grid, and
+ * the contents of the LALDict of non-mandatory parameters.  When the cache
+ * is full the least recently used waveform is evicted.  All operations on a
+ * cache are serialised internally, so a single cache may be shared between
+ * threads.
+ */
+typedef struct tagLALSimInspiralWaveformCache LALSimInspiralWaveformCache;
+
+/**
+ * Counters describing the use of a waveform cache.
+ */
 typedef struct
-tagLALSimInspiralWaveformCache {
-    REAL8TimeSeries *hplus;
-    REAL8TimeSeries *hcross;
-    COMPLEX16FrequencySeries *hptilde;
-    COMPLEX16FrequencySeries *hctilde;
-    REAL8 phiRef;
-    REAL8 deltaTF;
-    REAL8 m1;
-    REAL8 m2;
-    REAL8 S1x;
-    REAL8 S1y;
-    REAL8 S1z;
-    REAL8 S2x;
-    REAL8 S2y;
-    REAL8 S2z;
-    REAL8 f_min;
-    REAL8 f_ref;
-    REAL8 f_max;
-    REAL8 r;
-    REAL8 i;
-    LALDict *LALpars;
-    Approximant approximant;
-    REAL8Sequence *frequencies;
-} LALSimInspiralWaveformCache;
+tagLALSimInspiralWaveformCacheStats {
+    UINT8 hits;         /**< number of waveforms obtained from the cache, either copied or transformed */
+    UINT8 misses;       /**< number of waveforms which had to be generated */
+    UINT8 evictions;    /**< number of waveforms evicted from the cache to make room for others */
+    UINT4 entries;      /**< number of waveforms currently in the cache */
+    UINT4 maxEntries;   /**< maximum number of waveforms held in the cache */
+    UINT8 bytes;        /**< size of the waveform data currently in the cache */
+    UINT8 maxBytes;     /**< maximum size of the waveform data held in the cache */
+} LALSimInspiralWaveformCacheStats;
+
+/** Default maximum number of waveforms held in a waveform cache */
+#define LAL_SIM_INSPIRAL_WAVEFORM_CACHE_DEFAULT_ENTRIES 16
+
+/** Default maximum size of the waveform data held in a waveform cache (bytes) */
+#define LAL_SIM_INSPIRAL_WAVEFORM_CACHE_DEFAULT_BYTES (128 * 1024 * 1024)
 
 /** @} */
 
 LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCache(void);
 
+LALSimInspiralWaveformCache *XLALCreateSimInspiralWaveformCacheWithLimits(UINT4 maxEntries, UINT8 maxBytes);
+
 void XLALDestroySimInspiralWaveformCache(LALSimInspiralWaveformCache *cache);
 
+int XLALSimInspiralWaveformCacheGetStats(LALSimInspiralWaveformCacheStats *stats, LALSimInspiralWaveformCache *cache);
+
 int XLALSimInspiralChooseTDWaveformFromCache(REAL8TimeSeries **hplus, REAL8TimeSeries **hcross, REAL8 phiRef, REAL8 deltaT, REAL8 m1, REAL8 m2, REAL8 s1x, REAL8 s1y, REAL8 s1z, REAL8 s2x, REAL8 s2y, REAL8 s2z, REAL8 f_min, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, LALSimInspiralWaveformCache *cache);
 
 int XLALSimInspiralChooseFDWaveformFromCache(COMPLEX16FrequencySeries **hptilde, COMPLEX16FrequencySeries **hctilde, REAL8 phiRef, REAL8 deltaF, REAL8 m1, REAL8 m2, REAL8 S1x, REAL8 S1y, REAL8 S1z, REAL8 S2x, REAL8 S2y, REAL8 S2z, REAL8 f_min, REAL8 f_max, REAL8 f_ref, REAL8 r, REAL8 i, LALDict *LALpars, Approximant approximant, LALSimInspiralWaveformCache *cache, REAL8Sequence *frequencies);
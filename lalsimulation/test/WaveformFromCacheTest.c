@@ -30,6 +30,7 @@
 #include <lal/FrequencySeries.h>
 #include <time.h>
 #include <lal/LALConstants.h>
+#include <lal/LALStdio.h>
 
 int main(void) {
     clock_t s1, e1, s2, e2;
@@ -249,6 +250,70 @@ int main(void) {
     XLALDestroyCOMPLEX16FrequencySeries(hctildeC);
     hptilde = hctilde = hptildeC = hctildeC = NULL;
 
+    //
+    // Test multiple entries, counters and eviction with TaylorF2
+    //
+
+    LALSimInspiralWaveformCacheStats stats;
+    REAL8 m1b = 12. * LAL_MSUN_SI;
+    XLALSimInspiralWaveformCacheGetStats(&stats, cache);
+    if( stats.hits != 2 || stats.misses != 2 || stats.entries != 2 ) {
+        printf("Unexpected cache counters: hits=%" LAL_UINT8_FORMAT " misses=%" LAL_UINT8_FORMAT " entries=%u\n",
+                stats.hits, stats.misses, stats.entries);
+        XLAL_ERROR(XLAL_EFAILED);
+    }
+    XLALDestroySimInspiralWaveformCache(cache);
+
+    // A cache holding two waveforms: alternating between two intrinsic
+    // points only generates each waveform once
+    cache = XLALCreateSimInspiralWaveformCacheWithLimits(2, LAL_SIM_INSPIRAL_WAVEFORM_CACHE_DEFAULT_BYTES);
+    LALpars=XLALCreateDict();
+    XLALSimInspiralWaveformParamsInsertPNPhaseOrder(LALpars,phaseO);
+    for(i=0; i < 6; i++)
+    {
+        ret = XLALSimInspiralChooseFDWaveformFromCache(&hptildeC, &hctildeC,
+                phiref1, df, i % 2 ? m1b : m1, m2, s1x, s1y, s1z, s2x, s2y, s2z,
+                f_min, f_max, f_ref, dist1 * (i + 1), inc1, LALpars, approxFD, cache, NULL);
+        if( ret == XLAL_FAILURE )
+            XLAL_ERROR(XLAL_EFUNC);
+        XLALDestroyCOMPLEX16FrequencySeries(hptildeC);
+        XLALDestroyCOMPLEX16FrequencySeries(hctildeC);
+        hptildeC = hctildeC = NULL;
+    }
+    XLALSimInspiralWaveformCacheGetStats(&stats, cache);
+    printf("Alternating between two waveforms: hits=%" LAL_UINT8_FORMAT " misses=%" LAL_UINT8_FORMAT " evictions=%" LAL_UINT8_FORMAT "\n",
+            stats.hits, stats.misses, stats.evictions);
+    if( stats.hits != 4 || stats.misses != 2 || stats.evictions != 0 )
+        XLAL_ERROR(XLAL_EFAILED);
+
+    // A third intrinsic point evicts the least recently used waveform
+    ret = XLALSimInspiralChooseFDWaveformFromCache(&hptildeC, &hctildeC,
+            phiref1, df, m1, m1b, s1x, s1y, s1z, s2x, s2y, s2z,
+            f_min, f_max, f_ref, dist1, inc1, LALpars, approxFD, cache, NULL);
+    if( ret == XLAL_FAILURE )
+        XLAL_ERROR(XLAL_EFUNC);
+    XLALDestroyCOMPLEX16FrequencySeries(hptildeC);
+    XLALDestroyCOMPLEX16FrequencySeries(hctildeC);
+    hptildeC = hctildeC = NULL;
+
+    // Changing a non-mandatory parameter must not reuse a cached waveform
+    XLALSimInspiralWaveformParamsInsertPNPhaseOrder(LALpars,phaseO - 1);
+    ret = XLALSimInspiralChooseFDWaveformFromCache(&hptildeC, &hctildeC,
+            phiref1, df, m1, m1b, s1x, s1y, s1z, s2x, s2y, s2z,
+            f_min, f_max, f_ref, dist1, inc1, LALpars, approxFD, cache, NULL);
+    if( ret == XLAL_FAILURE )
+        XLAL_ERROR(XLAL_EFUNC);
+    XLALDestroyCOMPLEX16FrequencySeries(hptildeC);
+    XLALDestroyCOMPLEX16FrequencySeries(hctildeC);
+    hptildeC = hctildeC = NULL;
+    XLALDestroyDict(LALpars);
+
+    XLALSimInspiralWaveformCacheGetStats(&stats, cache);
+    printf("After two new waveforms: hits=%" LAL_UINT8_FORMAT " misses=%" LAL_UINT8_FORMAT " evictions=%" LAL_UINT8_FORMAT " entries=%u\n\n",
+            stats.hits, stats.misses, stats.evictions, stats.entries);
+    if( stats.hits != 4 || stats.misses != 4 || stats.evictions != 2 || stats.entries != 2 )
+        XLAL_ERROR(XLAL_EFAILED);
+
     XLALDestroySimInspiralWaveformCache(cache);
     LALCheckMemoryLeaks();
 